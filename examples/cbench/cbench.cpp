@@ -0,0 +1,640 @@
+#include <getopt.h>
+#include <iomanip>
+#include <iostream>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cbench.hpp"
+
+using namespace rofl::examples;
+
+static bool keep_on_running = true;
+
+static void signal_handler(int signal) {
+  switch (signal) {
+  case SIGINT: {
+    keep_on_running = false;
+  } break;
+  }
+}
+
+cbench::~cbench() {}
+
+cbench::cbench()
+    : mirror(false), window(1), batch(100), rate(0), flow_removed_rate(0),
+      port_status_rate(0), timeout_nsec(5000000000ULL),
+      dpid_base(0x0000000000010000ULL), duration(10), total_sent(0),
+      total_responses(0), total_lost(0), total_churn(0), total_latency_sum(0),
+      total_samples(0), total_latency_max(0) {
+  /* 64 bytes IPv4/UDP frame, source MAC varied per Packet-In */
+  const uint8_t tmpl[] = {
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x08, 0x00, 0x45, 0x00, 0x00, 0x32, 0x00, 0x00, 0x00, 0x00,
+      0x40, 0x11, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x02, 0x0a, 0x00, 0x00,
+      0x01, 0x04, 0x00, 0x04, 0x01, 0x00, 0x1e, 0x00, 0x00};
+  frame.assign(tmpl, tmpl + sizeof(tmpl));
+  frame.resize(64, 0);
+}
+
+void cbench::usage(const char *progname) const {
+  std::cerr
+      << "usage: " << progname
+      << " [-M] [-c host:port] [-l port] [-s switches] [-r rate] [-w window]"
+      << std::endl
+      << "       [-f rate] [-p rate] [-b batch] [-d seconds] [-T seconds]"
+      << std::endl
+      << "  -M          mirror mode: emulate a controller sending Flow-Mods "
+         "and Barrier-Requests"
+      << std::endl
+      << "  -c host:port controller to connect to (default 127.0.0.1:6653), "
+         "datapath in mirror mode"
+      << std::endl
+      << "  -l port     port to accept datapaths on in mirror mode "
+         "(default 6653)"
+      << std::endl
+      << "  -s switches number of emulated datapaths (default 16)"
+      << std::endl
+      << "  -r rate     Packet-Ins per second, 0 sends whenever the window "
+         "permits (default)"
+      << std::endl
+      << "  -w window   Packet-Ins resp. Barrier-Requests in flight per "
+         "peer, 0 is unlimited (default 1)"
+      << std::endl
+      << "  -f rate     Flow-Removed messages per second (default 0)"
+      << std::endl
+      << "  -p rate     Port-Status messages per second (default 0)"
+      << std::endl
+      << "  -b batch    Flow-Mods per Barrier-Request in mirror mode, 0 "
+         "only answers Packet-Ins (default 100)"
+      << std::endl
+      << "  -d seconds  duration of the measurement, 0 runs until SIGINT "
+         "(default 10)"
+      << std::endl
+      << "  -T seconds  outstanding requests are counted as lost after "
+         "(default 5)"
+      << std::endl;
+}
+
+uint64_t cbench::now_nsec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+void cbench::record_latency(uint64_t nsec) {
+  counters.latency_sum += nsec;
+  counters.samples++;
+  uint64_t max = counters.latency_max.load();
+  while ((nsec > max) &&
+         (not counters.latency_max.compare_exchange_weak(max, nsec)))
+    ;
+}
+
+void cbench::report(unsigned int second, uint64_t nsec) {
+  uint64_t sent = counters.sent.exchange(0);
+  uint64_t responses = counters.responses.exchange(0);
+  uint64_t lost = counters.lost.exchange(0);
+  uint64_t churn = counters.churn.exchange(0);
+  uint64_t latency_sum = counters.latency_sum.exchange(0);
+  uint64_t samples = counters.samples.exchange(0);
+  uint64_t latency_max = counters.latency_max.exchange(0);
+
+  total_sent += sent;
+  total_responses += responses;
+  total_lost += lost;
+  total_churn += churn;
+  total_latency_sum += latency_sum;
+  total_samples += samples;
+  total_latency_max = std::max(total_latency_max, latency_max);
+
+  double secs = (double)nsec / 1e9;
+  std::cout << std::setw(6) << second << std::setw(12)
+            << (uint64_t)(sent / secs) << std::setw(12)
+            << (uint64_t)(responses / secs) << std::setw(8) << lost
+            << std::setw(10) << (uint64_t)(churn / secs) << std::setw(12)
+            << (samples ? latency_sum / samples / 1000 : 0) << std::setw(12)
+            << latency_max / 1000 << std::endl;
+}
+
+void cbench::summary(uint64_t nsec) {
+  double secs = (double)nsec / 1e9;
+  std::cout << "total: " << total_sent << " sent, " << total_responses
+            << " responses, " << total_lost << " lost, " << total_churn
+            << " churn messages in " << std::fixed << std::setprecision(3)
+            << secs << " s" << std::endl;
+  std::cout << "throughput: " << (uint64_t)(total_responses / secs)
+            << " responses/s, latency avg: "
+            << (total_samples ? total_latency_sum / total_samples / 1000 : 0)
+            << " usec max: " << total_latency_max / 1000 << " usec"
+            << std::endl;
+}
+
+int cbench::run(int argc, char **argv) {
+  std::string raddr("127.0.0.1:6653");
+  bool connect = false;
+  unsigned int lport = 6653;
+  unsigned int num_switches = 16;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "Mc:l:s:r:w:f:p:b:d:T:")) != -1) {
+    switch (opt) {
+    case 'M': {
+      mirror = true;
+    } break;
+    case 'c': {
+      raddr = optarg;
+      connect = true;
+    } break;
+    case 'l': {
+      lport = strtoul(optarg, NULL, 0);
+    } break;
+    case 's': {
+      num_switches = strtoul(optarg, NULL, 0);
+    } break;
+    case 'r': {
+      rate = strtod(optarg, NULL);
+    } break;
+    case 'w': {
+      window = strtoul(optarg, NULL, 0);
+    } break;
+    case 'f': {
+      flow_removed_rate = strtod(optarg, NULL);
+    } break;
+    case 'p': {
+      port_status_rate = strtod(optarg, NULL);
+    } break;
+    case 'b': {
+      batch = strtoul(optarg, NULL, 0);
+    } break;
+    case 'd': {
+      duration = strtoul(optarg, NULL, 0);
+    } break;
+    case 'T': {
+      timeout_nsec = strtoull(optarg, NULL, 0) * 1000000000ULL;
+    } break;
+    default: {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+    }
+  }
+  size_t colon = raddr.rfind(':');
+  if ((optind != argc) || (num_switches == 0) ||
+      (colon == std::string::npos) || ((rate <= 0) && (window == 0)) ||
+      (mirror && (window == 0))) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  signal(SIGINT, signal_handler);
+
+  rofl::openflow::cofhello_elem_versionbitmap vbitmap;
+  vbitmap.add_ofp_version(rofl::openflow10::OFP_VERSION);
+  vbitmap.add_ofp_version(rofl::openflow12::OFP_VERSION);
+  vbitmap.add_ofp_version(rofl::openflow13::OFP_VERSION);
+  crofbase::set_versionbitmap(vbitmap);
+
+  try {
+    rofl::csockaddr addr(AF_INET, raddr.substr(0, colon),
+                         strtoul(raddr.substr(colon + 1).c_str(), NULL, 0));
+
+    if (mirror) {
+      if (connect) {
+        crofbase::add_dpt()
+            .add_conn(rofl::cauxid(0))
+            .set_raddr(addr)
+            .tcp_connect(vbitmap, rofl::crofconn::MODE_CONTROLLER, true);
+      } else {
+        crofbase::dpt_sock_listen(rofl::csockaddr(AF_INET, "0.0.0.0", lport));
+      }
+    } else {
+      for (unsigned int i = 0; i < num_switches; i++) {
+        switches.emplace_back(new cswitch());
+        crofbase::add_ctl(rofl::cctlid(i))
+            .add_conn(rofl::cauxid(0))
+            .set_laddr(rofl::csockaddr(AF_INET, "0.0.0.0", 0))
+            .set_raddr(addr)
+            .tcp_connect(vbitmap, rofl::crofconn::MODE_DATAPATH, true);
+      }
+    }
+
+  } catch (rofl::exception &e) {
+    std::cerr << "cbench failed: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << std::setw(6) << "sec" << std::setw(12)
+            << (mirror ? "flowmods/s" : "pktins/s") << std::setw(12)
+            << (mirror ? "acked/s" : "responses/s") << std::setw(8) << "lost"
+            << std::setw(10) << "churn/s" << std::setw(12) << "avg usec"
+            << std::setw(12) << "max usec" << std::endl;
+
+  uint64_t start = now_nsec();
+  uint64_t last_tick = start;
+  uint64_t last_report = start;
+  unsigned int second = 0;
+  unsigned int rr_pkt_in = 0;
+  unsigned int rr_churn = 0;
+  double pkt_in_tokens = 0.0;
+  double flow_removed_tokens = 0.0;
+  double port_status_tokens = 0.0;
+
+  while (keep_on_running) {
+    struct timespec ts;
+    ts.tv_sec = 0;
+    ts.tv_nsec = 1000000;
+    nanosleep(&ts, NULL);
+
+    uint64_t now = now_nsec();
+    double dt = (double)(now - last_tick) / 1e9;
+    last_tick = now;
+
+    if (not mirror) {
+      /* Packet-Ins, bursts are limited to 10ms worth of tokens */
+      pkt_in_tokens = std::min(pkt_in_tokens + rate * dt, rate / 100 + 1);
+      unsigned int failures = 0;
+      while ((failures < switches.size()) &&
+             ((rate <= 0) || (pkt_in_tokens >= 1.0))) {
+        if (send_packet_in(rr_pkt_in++ % switches.size())) {
+          failures = 0;
+          pkt_in_tokens -= 1.0;
+        } else {
+          failures++;
+        }
+      }
+
+      /* Flow-Removed and Port-Status churn */
+      flow_removed_tokens += flow_removed_rate * dt;
+      for (; flow_removed_tokens >= 1.0; flow_removed_tokens -= 1.0) {
+        send_churn(rr_churn++ % switches.size(), false);
+      }
+      port_status_tokens += port_status_rate * dt;
+      for (; port_status_tokens >= 1.0; port_status_tokens -= 1.0) {
+        send_churn(rr_churn++ % switches.size(), true);
+      }
+    }
+
+    if (now - last_report >= 1000000000ULL) {
+      expire(now);
+      report(++second, now - last_report);
+      last_report = now;
+      if (duration && (second >= duration))
+        break;
+    }
+  }
+
+  summary(last_report - start);
+
+  keep_on_running = false;
+  if (mirror) {
+    crofbase::drop_dpts();
+  } else {
+    crofbase::drop_ctls();
+  }
+
+  return EXIT_SUCCESS;
+}
+
+bool cbench::send_packet_in(unsigned int index) {
+  cswitch &sw = *(switches[index]);
+  if (not sw.ready)
+    return false;
+
+  uint32_t buffer_id;
+  {
+    std::lock_guard<std::mutex> lock(sw.lock);
+    if (window && (sw.pending.size() >= window))
+      return false;
+    buffer_id = sw.next_buffer_id++ & 0x7fffffff;
+    sw.pending[buffer_id] = now_nsec();
+  }
+
+  /* distinct source MAC address per switch and Packet-In */
+  uint8_t data[64];
+  memcpy(data, frame.data(), sizeof(data));
+  data[6] = (index >> 8) & 0xff;
+  data[7] = index & 0xff;
+  data[8] = (buffer_id >> 24) & 0xff;
+  data[9] = (buffer_id >> 16) & 0xff;
+  data[10] = (buffer_id >> 8) & 0xff;
+  data[11] = buffer_id & 0xff;
+
+  rofl::crofsock::msg_result_t result =
+      rofl::crofsock::MSG_QUEUEING_FAILED_NOT_ESTABLISHED;
+  try {
+    rofl::crofctl &ctl = crofbase::set_ctl(rofl::cctlid(index));
+    rofl::openflow::cofmatch match(ctl.get_version());
+    match.set_in_port(1);
+    result = ctl.send_packet_in_message(
+        rofl::cauxid(0), buffer_id, sizeof(data),
+        rofl::openflow13::OFPR_NO_MATCH, 0, 0, 1, match, data, sizeof(data));
+  } catch (rofl::exception &e) {
+  }
+
+  switch (result) {
+  case rofl::crofsock::MSG_QUEUED:
+  case rofl::crofsock::MSG_QUEUED_CONGESTION: {
+    counters.sent++;
+    return true;
+  } break;
+  default: {
+    std::lock_guard<std::mutex> lock(sw.lock);
+    sw.pending.erase(buffer_id);
+    return false;
+  };
+  }
+}
+
+void cbench::send_churn(unsigned int index, bool port_status) {
+  if (not switches[index]->ready)
+    return;
+
+  try {
+    rofl::crofctl &ctl = crofbase::set_ctl(rofl::cctlid(index));
+    rofl::crofsock::msg_result_t result;
+    if (port_status) {
+      rofl::openflow::cofport port(ctl.get_version());
+      port.set_port_no(1);
+      port.set_hwaddr(rofl::caddress_ll("00:00:00:00:01:01"));
+      port.set_name("port#1");
+      port.set_state(counters.churn % 2);
+      result = ctl.send_port_status_message(
+          rofl::cauxid(0), rofl::openflow13::OFPPR_MODIFY, port);
+    } else {
+      rofl::openflow::cofmatch match(ctl.get_version());
+      match.set_in_port(1);
+      match.set_eth_type(0x0800);
+      result = ctl.send_flow_removed_message(
+          rofl::cauxid(0), match, index, 100,
+          rofl::openflow13::OFPRR_IDLE_TIMEOUT, 0, 10, 0, 10, 0, 1, 64);
+    }
+    if ((rofl::crofsock::MSG_QUEUED == result) ||
+        (rofl::crofsock::MSG_QUEUED_CONGESTION == result))
+      counters.churn++;
+  } catch (rofl::exception &e) {
+  }
+}
+
+void cbench::handle_response(rofl::crofctl &ctl, uint32_t buffer_id) {
+  uint64_t index = ctl.get_ctlid().get_ctlid();
+  if ((rofl::openflow::OFP_NO_BUFFER == buffer_id) ||
+      (index >= switches.size()))
+    return;
+
+  cswitch &sw = *(switches[index]);
+  uint64_t sent;
+  {
+    std::lock_guard<std::mutex> lock(sw.lock);
+    auto it = sw.pending.find(buffer_id);
+    if (it == sw.pending.end())
+      return;
+    sent = it->second;
+    sw.pending.erase(it);
+  }
+  record_latency(now_nsec() - sent);
+  counters.responses++;
+
+  /* keep the window filled without waiting for the next tick */
+  if ((rate <= 0) && keep_on_running)
+    send_packet_in(index);
+}
+
+bool cbench::send_batch(const rofl::cdptid &dptid) {
+  std::shared_ptr<cpeer> ppeer;
+  {
+    std::lock_guard<std::mutex> guard(peers_lock);
+    auto it = peers.find(dptid);
+    if (it == peers.end())
+      return false;
+    ppeer = it->second;
+  }
+  cpeer &peer = *ppeer;
+  if (batch == 0)
+    return false;
+
+  try {
+    rofl::crofdpt &dpt = crofbase::set_dpt(dptid);
+    std::lock_guard<std::mutex> lock(peer.lock);
+    if (peer.pending.size() >= window)
+      return false;
+
+    std::vector<rofl::openflow::cofflowmod> flowmods;
+    for (unsigned int i = 0; i < batch; i++) {
+      flowmods.emplace_back(dpt.get_version());
+      rofl::openflow::cofflowmod &fe = flowmods.back();
+      fe.set_command(rofl::openflow::OFPFC_ADD);
+      fe.set_table_id(0);
+      fe.set_priority(100);
+      fe.set_match().set_eth_type(0x0800);
+      rofl::caddress_in4 dst;
+      dst.set_addr_hbo(0x0a000000 | (peer.next_flow++ & 0x00ffffff));
+      fe.set_match().set_ipv4_dst(dst);
+      if (rofl::openflow10::OFP_VERSION == dpt.get_version()) {
+        fe.set_actions()
+            .add_action_output(rofl::cindex(0))
+            .set_port_no(1);
+      } else {
+        fe.set_instructions()
+            .set_inst_apply_actions()
+            .set_actions()
+            .add_action_output(rofl::cindex(0))
+            .set_port_no(1);
+      }
+    }
+
+    size_t num_queued = 0;
+    dpt.send_flow_mod_messages(rofl::cauxid(0), flowmods, &num_queued);
+    if (num_queued == 0)
+      return false;
+    counters.sent += num_queued;
+
+    uint32_t xid = 0;
+    rofl::crofsock::msg_result_t result = dpt.send_barrier_request(
+        rofl::cauxid(0), timeout_nsec / 1000000000ULL + 1, &xid);
+    if ((rofl::crofsock::MSG_QUEUED != result) &&
+        (rofl::crofsock::MSG_QUEUED_CONGESTION != result))
+      return false;
+    peer.pending[xid] = std::make_pair(now_nsec(), num_queued);
+    return true;
+
+  } catch (rofl::exception &e) {
+    return false;
+  }
+}
+
+void cbench::expire(uint64_t now) {
+  for (auto &sw : switches) {
+    std::lock_guard<std::mutex> lock(sw->lock);
+    for (auto it = sw->pending.begin(); it != sw->pending.end();) {
+      if (it->second + timeout_nsec < now) {
+        it = sw->pending.erase(it);
+        counters.lost++;
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  /* Barrier-Requests expire via handle_barrier_reply_timeout(), resume
+   * peers whose window was drained by failed transmissions */
+  std::vector<std::pair<rofl::cdptid, std::shared_ptr<cpeer>>> peers_copy;
+  {
+    std::lock_guard<std::mutex> guard(peers_lock);
+    peers_copy.assign(peers.begin(), peers.end());
+  }
+  std::vector<rofl::cdptid> idle;
+  for (auto &it : peers_copy) {
+    std::lock_guard<std::mutex> lock(it.second->lock);
+    if (it.second->pending.empty())
+      idle.push_back(it.first);
+  }
+  for (auto &dptid : idle) {
+    for (unsigned int i = 0; (i < window) && send_batch(dptid); i++)
+      ;
+  }
+}
+
+void cbench::handle_ctl_close(const rofl::cctlid &ctlid) {
+  if (ctlid.get_ctlid() >= switches.size())
+    return;
+  cswitch &sw = *(switches[ctlid.get_ctlid()]);
+  sw.ready = false;
+  std::lock_guard<std::mutex> lock(sw.lock);
+  sw.pending.clear();
+}
+
+void cbench::handle_features_request(
+    rofl::crofctl &ctl, const rofl::cauxid &auxid,
+    rofl::openflow::cofmsg_features_request &msg) {
+  ctl.send_features_reply(auxid, msg.get_xid(),
+                          dpid_base + ctl.get_ctlid().get_ctlid(), 0xffff, 1,
+                          0, auxid.get_id());
+  if (ctl.get_ctlid().get_ctlid() < switches.size())
+    switches[ctl.get_ctlid().get_ctlid()]->ready = true;
+}
+
+void cbench::handle_get_config_request(
+    rofl::crofctl &ctl, const rofl::cauxid &auxid,
+    rofl::openflow::cofmsg_get_config_request &msg) {
+  ctl.send_get_config_reply(auxid, msg.get_xid(), 0, 128);
+}
+
+void cbench::handle_port_desc_stats_request(
+    rofl::crofctl &ctl, const rofl::cauxid &auxid,
+    rofl::openflow::cofmsg_port_desc_stats_request &msg) {
+  rofl::openflow::cofports ports(ctl.get_version());
+  for (uint32_t portno = 1; portno <= 4; portno++) {
+    ports.add_port(portno).set_hwaddr(
+        rofl::caddress_ll("00:00:00:00:01:0" + std::to_string(portno)));
+    ports.set_port(portno).set_name("port#" + std::to_string(portno));
+  }
+  ctl.send_port_desc_stats_reply(auxid, msg.get_xid(), ports);
+}
+
+void cbench::handle_barrier_request(
+    rofl::crofctl &ctl, const rofl::cauxid &auxid,
+    rofl::openflow::cofmsg_barrier_request &msg) {
+  ctl.send_barrier_reply(auxid, msg.get_xid());
+}
+
+void cbench::handle_flow_mod(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                             rofl::openflow::cofmsg_flow_mod &msg) {
+  handle_response(ctl, msg.get_flowmod().get_buffer_id());
+}
+
+void cbench::handle_packet_out(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                               rofl::openflow::cofmsg_packet_out &msg) {
+  handle_response(ctl, msg.get_buffer_id());
+}
+
+void cbench::handle_dpt_open(rofl::crofdpt &dpt) {
+  {
+    std::lock_guard<std::mutex> guard(peers_lock);
+    peers[dpt.get_dptid()].reset(new cpeer());
+  }
+  for (unsigned int i = 0; (i < window) && send_batch(dpt.get_dptid()); i++)
+    ;
+}
+
+void cbench::handle_packet_in(rofl::crofdpt &dpt, const rofl::cauxid &auxid,
+                              rofl::openflow::cofmsg_packet_in &msg) {
+  /* reactive forwarding, install a flow and release the buffered packet */
+  rofl::openflow::cofflowmod fe(dpt.get_version());
+  fe.set_command(rofl::openflow::OFPFC_ADD);
+  fe.set_table_id(0);
+  fe.set_priority(200);
+  fe.set_idle_timeout(10);
+  fe.set_buffer_id(msg.get_buffer_id());
+  if (msg.get_packet().length() >= 12) {
+    fe.set_match().set_eth_src(
+        rofl::caddress_ll(msg.get_packet().soframe() + 6, 6));
+  }
+  if (rofl::openflow10::OFP_VERSION == dpt.get_version()) {
+    fe.set_actions().add_action_output(rofl::cindex(0)).set_port_no(2);
+  } else {
+    fe.set_instructions()
+        .set_inst_apply_actions()
+        .set_actions()
+        .add_action_output(rofl::cindex(0))
+        .set_port_no(2);
+  }
+
+  try {
+    dpt.send_flow_mod_message(auxid, fe);
+    counters.responses++;
+  } catch (rofl::exception &e) {
+  }
+}
+
+void cbench::handle_dpt_close(const rofl::cdptid &dptid) {
+  std::lock_guard<std::mutex> guard(peers_lock);
+  peers.erase(dptid);
+}
+
+void cbench::handle_barrier_reply(rofl::crofdpt &dpt,
+                                  const rofl::cauxid &auxid,
+                                  rofl::openflow::cofmsg_barrier_reply &msg) {
+  std::shared_ptr<cpeer> peer;
+  {
+    std::lock_guard<std::mutex> guard(peers_lock);
+    auto it = peers.find(dpt.get_dptid());
+    if (it == peers.end())
+      return;
+    peer = it->second;
+  }
+  std::pair<uint64_t, size_t> sent;
+  {
+    std::lock_guard<std::mutex> lock(peer->lock);
+    auto it = peer->pending.find(msg.get_xid());
+    if (it == peer->pending.end())
+      return;
+    sent = it->second;
+    peer->pending.erase(it);
+  }
+  record_latency(now_nsec() - sent.first);
+  counters.responses += sent.second;
+
+  if (keep_on_running)
+    send_batch(dpt.get_dptid());
+}
+
+void cbench::handle_barrier_reply_timeout(rofl::crofdpt &dpt, uint32_t xid) {
+  std::shared_ptr<cpeer> peer;
+  {
+    std::lock_guard<std::mutex> guard(peers_lock);
+    auto it = peers.find(dpt.get_dptid());
+    if (it == peers.end())
+      return;
+    peer = it->second;
+  }
+  {
+    std::lock_guard<std::mutex> lock(peer->lock);
+    if (peer->pending.erase(xid) == 0)
+      return;
+  }
+  counters.lost++;
+
+  if (keep_on_running)
+    send_batch(dpt.get_dptid());
+}
@@ -0,0 +1,228 @@
+#ifndef ROFL_EXAMPLES_CBENCH_H
+#define ROFL_EXAMPLES_CBENCH_H 1
+
+#include <atomic>
+#include <inttypes.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <signal.h>
+#include <unordered_map>
+#include <vector>
+
+#include <rofl/common/rofcommon.h>
+
+namespace rofl {
+namespace examples {
+
+/**
+ * @ingroup common_howto_cbench
+ *
+ * @brief	Load generator for OpenFlow controllers and datapaths
+ *
+ * In its default mode, cbench emulates a number of datapath elements,
+ * each represented by a rofl::crofctl instance sharing the thread pool
+ * of a single rofl::crofbase. The emulated datapaths send Packet-In
+ * messages at a configurable rate and with a limited number of messages
+ * in flight, optionally mixed with Flow-Removed and Port-Status
+ * messages. Each Flow-Mod or Packet-Out carrying the buffer_id of an
+ * outstanding Packet-In counts as a response and yields the controller's
+ * response latency.
+ *
+ * In mirror mode, cbench emulates a controller instead. It sends
+ * batches of Flow-Mods, each followed by a Barrier-Request, to all
+ * attached datapath elements and measures Flow-Mod throughput and
+ * barrier latency. Packet-Ins are answered with a Flow-Mod for the
+ * frame's source address and buffer_id, so pointing a cbench instance in
+ * default mode at a mirror instance measures rofl-common on both ends.
+ */
+class cbench : public rofl::crofbase {
+public:
+  /**
+   * @brief	cbench destructor
+   */
+  virtual ~cbench();
+
+  /**
+   * @brief	cbench constructor
+   */
+  cbench();
+
+  /** @cond EXAMPLES */
+
+public:
+  /**
+   *
+   */
+  int run(int argc, char **argv);
+
+private:
+  /* emulated datapath element */
+  struct cswitch {
+    cswitch() : ready(false), next_buffer_id(0){};
+    std::atomic_bool ready;
+    std::mutex lock;
+    // buffer_id => timestamp of outstanding Packet-Ins
+    std::unordered_map<uint32_t, uint64_t> pending;
+    uint32_t next_buffer_id;
+  };
+
+  /* attached datapath element in mirror mode */
+  struct cpeer {
+    cpeer() : next_flow(0){};
+    std::mutex lock;
+    // xid => timestamp and number of Flow-Mods of outstanding barriers
+    std::unordered_map<uint32_t, std::pair<uint64_t, size_t>> pending;
+    uint32_t next_flow;
+  };
+
+  /* counters for a measurement interval */
+  struct ccounters {
+    ccounters()
+        : sent(0), responses(0), lost(0), churn(0), latency_sum(0),
+          samples(0), latency_max(0){};
+    std::atomic<uint64_t> sent;
+    std::atomic<uint64_t> responses;
+    std::atomic<uint64_t> lost;
+    std::atomic<uint64_t> churn;
+    std::atomic<uint64_t> latency_sum;
+    std::atomic<uint64_t> samples;
+    std::atomic<uint64_t> latency_max;
+  };
+
+  /**
+   *
+   */
+  void usage(const char *progname) const;
+
+  /**
+   *
+   */
+  static uint64_t now_nsec();
+
+  /**
+   *
+   */
+  void record_latency(uint64_t nsec);
+
+  /**
+   *
+   */
+  void report(unsigned int second, uint64_t nsec);
+
+  /**
+   *
+   */
+  void summary(uint64_t nsec);
+
+  /**
+   *
+   */
+  bool send_packet_in(unsigned int index);
+
+  /**
+   *
+   */
+  void send_churn(unsigned int index, bool port_status);
+
+  /**
+   *
+   */
+  void handle_response(rofl::crofctl &ctl, uint32_t buffer_id);
+
+  /**
+   *
+   */
+  bool send_batch(const rofl::cdptid &dptid);
+
+  /**
+   *
+   */
+  void expire(uint64_t now);
+
+private:
+  virtual void handle_ctl_close(const rofl::cctlid &ctlid);
+
+  virtual void
+  handle_features_request(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                          rofl::openflow::cofmsg_features_request &msg);
+
+  virtual void
+  handle_get_config_request(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                            rofl::openflow::cofmsg_get_config_request &msg);
+
+  virtual void handle_port_desc_stats_request(
+      rofl::crofctl &ctl, const rofl::cauxid &auxid,
+      rofl::openflow::cofmsg_port_desc_stats_request &msg);
+
+  virtual void
+  handle_barrier_request(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                         rofl::openflow::cofmsg_barrier_request &msg);
+
+  virtual void handle_flow_mod(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                               rofl::openflow::cofmsg_flow_mod &msg);
+
+  virtual void handle_packet_out(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                                 rofl::openflow::cofmsg_packet_out &msg);
+
+  virtual void handle_dpt_open(rofl::crofdpt &dpt);
+
+  virtual void handle_dpt_close(const rofl::cdptid &dptid);
+
+  virtual void handle_packet_in(rofl::crofdpt &dpt, const rofl::cauxid &auxid,
+                                rofl::openflow::cofmsg_packet_in &msg);
+
+  virtual void
+  handle_barrier_reply(rofl::crofdpt &dpt, const rofl::cauxid &auxid,
+                       rofl::openflow::cofmsg_barrier_reply &msg);
+
+  virtual void handle_barrier_reply_timeout(rofl::crofdpt &dpt, uint32_t xid);
+
+  /** @endcond */
+
+private:
+  // emulate a controller instead of datapath elements
+  bool mirror;
+
+  // Packet-Ins resp. Barrier-Requests in flight per peer, 0: unlimited
+  unsigned int window;
+
+  // Flow-Mods per Barrier-Request in mirror mode
+  unsigned int batch;
+
+  // messages per second, Packet-Ins are limited by window only if 0
+  double rate;
+  double flow_removed_rate;
+  double port_status_rate;
+
+  // outstanding requests older than this are counted as lost
+  uint64_t timeout_nsec;
+
+  uint64_t dpid_base;
+
+  // seconds, 0: until SIGINT
+  unsigned int duration;
+
+  std::vector<std::unique_ptr<cswitch>> switches;
+
+  std::mutex peers_lock;
+  std::map<rofl::cdptid, std::shared_ptr<cpeer>> peers;
+
+  ccounters counters;
+
+  uint64_t total_sent;
+  uint64_t total_responses;
+  uint64_t total_lost;
+  uint64_t total_churn;
+  uint64_t total_latency_sum;
+  uint64_t total_samples;
+  uint64_t total_latency_max;
+
+  // Ethernet frame sent in Packet-Ins
+  std::vector<uint8_t> frame;
+};
+
+}; // namespace examples
+}; // namespace rofl
+
+#endif /* ROFL_EXAMPLES_CBENCH_H */
@@ -0,0 +1,7 @@
+#include "cbench.hpp"
+
+int main(int argc, char **argv) {
+  rofl::examples::cbench bench;
+
+  return bench.run(argc, argv);
+}
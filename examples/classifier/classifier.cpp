@@ -0,0 +1,229 @@
+#include <getopt.h>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdlib.h>
+#include <time.h>
+
+#include "classifier.hpp"
+
+using namespace rofl::examples;
+
+namespace {
+
+/* deterministic pseudo random numbers, identical for rules and packets */
+uint32_t mix(uint32_t x) {
+  x ^= x >> 16;
+  x *= 0x7feb352d;
+  x ^= x >> 15;
+  x *= 0x846ca68b;
+  x ^= x >> 16;
+  return x;
+}
+
+/* rule shapes: IPv4 /8, /16, /24, /32 prefixes and /32 plus TCP port */
+const unsigned int NUM_SHAPES = 5;
+
+uint32_t prefix_mask(unsigned int shape) {
+  switch (shape) {
+  case 0:
+    return 0xff000000;
+  case 1:
+    return 0xffff0000;
+  case 2:
+    return 0xffffff00;
+  default:
+    return 0xffffffff;
+  }
+}
+
+/* IPv4 destination and TCP port of a rule, distinct for every index */
+struct crulekey {
+  unsigned int shape;
+  uint32_t addr;
+  uint16_t port;
+};
+
+crulekey rule_key(unsigned int index) {
+  crulekey key;
+  key.shape = index % NUM_SHAPES;
+  key.port = 0;
+
+  /* a shape's own counter enumerates its prefixes, multiplying with an odd
+   * number scatters them */
+  unsigned int count = index / NUM_SHAPES;
+  unsigned int bits = 8 * (key.shape + 1);
+  if (bits < 32) {
+    if (count < (1U << bits)) {
+      key.addr = ((count * 0x9e3779b1U) & ((1U << bits) - 1)) << (32 - bits);
+      return key;
+    }
+    /* all prefixes of this length in use, continue with a /32 */
+    key.shape = NUM_SHAPES - 2;
+  }
+
+  /* mix() is a bijection, so distinct indices yield distinct addresses */
+  key.addr = mix(index);
+  if (key.shape == NUM_SHAPES - 1) {
+    key.port = mix(index + 1) & 0xffff;
+  }
+  return key;
+}
+
+uint64_t now_nsec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+}; // end of anonymous namespace
+
+classifier::~classifier() {}
+
+classifier::classifier() {}
+
+void classifier::usage(const char *progname) const {
+  std::cerr << "usage: " << progname << " [-n rules[,rules...]] [-l lookups]"
+            << std::endl
+            << "  -n rules   comma separated table sizes, default is "
+               "10000,100000,1000000"
+            << std::endl
+            << "  -l lookups number of lookups per measurement, default is "
+               "1000000"
+            << std::endl;
+}
+
+rofl::openflow::cofflowmod classifier::rule(unsigned int index) const {
+  crulekey key = rule_key(index);
+
+  rofl::openflow::cofflowmod fe(rofl::openflow13::OFP_VERSION);
+  fe.set_command(rofl::openflow::OFPFC_ADD);
+  fe.set_table_id(0);
+  fe.set_priority(8 * (key.shape + 1));
+  fe.set_cookie(index);
+  fe.set_match().set_eth_type(0x0800);
+
+  rofl::caddress_in4 addr, addrmask;
+  addr.set_addr_hbo(key.addr);
+  addrmask.set_addr_hbo(prefix_mask(key.shape));
+  fe.set_match().set_ipv4_dst(addr, addrmask);
+  if (key.shape == NUM_SHAPES - 1) {
+    fe.set_match().set_ip_proto(6);
+    fe.set_match().set_tcp_dst(key.port);
+  }
+  return fe;
+}
+
+rofl::openflow::cofclassifier::ckey classifier::packet(unsigned int seed,
+                                                       size_t rules) const {
+  uint32_t addr;
+  uint16_t port;
+  if (seed % 2) {
+    /* every other packet is destined to a rule's address */
+    crulekey key = rule_key(mix(seed) % rules);
+    addr = key.addr | (mix(seed) & ~prefix_mask(key.shape));
+    port = (key.shape == NUM_SHAPES - 1) ? key.port : (mix(seed + 1) & 0xffff);
+  } else {
+    addr = mix(0x80000000 | seed);
+    port = mix((0x80000000 | seed) + 1) & 0xffff;
+  }
+
+  rofl::openflow::cofmatch match(rofl::openflow13::OFP_VERSION);
+  rofl::caddress_in4 ipv4_dst;
+  ipv4_dst.set_addr_hbo(addr);
+  match.set_in_port(1);
+  match.set_eth_type(0x0800);
+  match.set_ip_proto(6);
+  match.set_ipv4_dst(ipv4_dst);
+  match.set_tcp_src(1024 + (seed % 60000));
+  match.set_tcp_dst(port);
+  return rofl::openflow::cofclassifier::ckey(match);
+}
+
+double classifier::measure(
+    const rofl::openflow::cofclassifier &cls,
+    const std::vector<rofl::openflow::cofclassifier::ckey> &keys,
+    size_t lookups, size_t &hits) const {
+  hits = 0;
+  uint64_t start = now_nsec();
+  for (size_t i = 0; i < lookups; i++) {
+    if (cls.lookup(0, keys[i % keys.size()]))
+      hits++;
+  }
+  uint64_t nsec = now_nsec() - start;
+  return (nsec == 0) ? 0.0 : (double)lookups * 1e9 / nsec;
+}
+
+int classifier::run(int argc, char **argv) {
+  std::vector<size_t> sizes = {10000, 100000, 1000000};
+  size_t lookups = 1000000;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "n:l:")) != -1) {
+    switch (opt) {
+    case 'n': {
+      sizes.clear();
+      std::istringstream ss(optarg);
+      std::string item;
+      while (std::getline(ss, item, ',')) {
+        sizes.push_back(strtoul(item.c_str(), NULL, 0));
+      }
+    } break;
+    case 'l': {
+      lookups = strtoul(optarg, NULL, 0);
+    } break;
+    default: {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+    }
+  }
+  if ((optind != argc) || sizes.empty() || (lookups == 0)) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  std::cout << std::setw(10) << "rules" << std::setw(12) << "subtables"
+            << std::setw(10) << "hits" << std::setw(16) << "lookups/s"
+            << std::setw(16) << "staged/s" << std::endl;
+
+  try {
+    for (auto rules : sizes) {
+      if (rules == 0)
+        continue;
+
+      rofl::openflow::cofclassifier cls(rofl::openflow13::OFP_VERSION);
+      for (unsigned int i = 0; i < rules; i++) {
+        cls.flow_mod(rule(i));
+      }
+      if (cls.size() != rules) {
+        std::cerr << "classifier holds " << cls.size() << " of " << rules
+                  << " rules" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      std::vector<rofl::openflow::cofclassifier::ckey> keys;
+      for (unsigned int i = 0; i < 65536; i++) {
+        keys.push_back(packet(i, rules));
+      }
+
+      size_t hits = 0;
+      cls.set_staged_lookup(false);
+      double rate = measure(cls, keys, lookups, hits);
+      cls.set_staged_lookup(true);
+      double staged = measure(cls, keys, lookups, hits);
+
+      std::cout << std::setw(10) << cls.size() << std::setw(12)
+                << cls.get_num_of_subtables(0) << std::setw(9)
+                << (100 * hits / lookups) << "%" << std::setw(16)
+                << (uint64_t)rate << std::setw(16) << (uint64_t)staged
+                << std::endl;
+    }
+
+  } catch (rofl::exception &e) {
+    std::cerr << "classifier failed: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,72 @@
+#ifndef ROFL_EXAMPLES_CLASSIFIER_H
+#define ROFL_EXAMPLES_CLASSIFIER_H 1
+
+#include <inttypes.h>
+#include <vector>
+
+#include <rofl/common/openflow/cofclassifier.h>
+
+namespace rofl {
+namespace examples {
+
+/**
+ * @ingroup common_howto_classifier
+ *
+ * @brief	Measures lookup rates of rofl::openflow::cofclassifier
+ *
+ * Fills a classifier with distinct IPv4 destination prefixes and TCP
+ * flows of varying masks and priorities and prints the achieved
+ * lookups per second for each table size, with and without staged
+ * lookup.
+ */
+class classifier {
+public:
+  /**
+   * @brief	classifier destructor
+   */
+  virtual ~classifier();
+
+  /**
+   * @brief	classifier constructor
+   */
+  classifier();
+
+  /** @cond EXAMPLES */
+
+public:
+  /**
+   *
+   */
+  int run(int argc, char **argv);
+
+private:
+  /**
+   *
+   */
+  void usage(const char *progname) const;
+
+  /**
+   *
+   */
+  rofl::openflow::cofflowmod rule(unsigned int index) const;
+
+  /**
+   *
+   */
+  rofl::openflow::cofclassifier::ckey packet(unsigned int seed,
+                                             size_t rules) const;
+
+  /**
+   *
+   */
+  double measure(const rofl::openflow::cofclassifier &cls,
+                 const std::vector<rofl::openflow::cofclassifier::ckey> &keys,
+                 size_t lookups, size_t &hits) const;
+
+  /** @endcond */
+};
+
+}; // end of namespace examples
+}; // end of namespace rofl
+
+#endif /* ROFL_EXAMPLES_CLASSIFIER_H */
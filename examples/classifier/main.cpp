@@ -0,0 +1,7 @@
+#include "classifier.hpp"
+
+int main(int argc, char **argv) {
+  rofl::examples::classifier cls;
+
+  return cls.run(argc, argv);
+}
@@ -0,0 +1,7 @@
+#include "replay.hpp"
+
+int main(int argc, char **argv) {
+  rofl::examples::replay rpl;
+
+  return rpl.run(argc, argv);
+}
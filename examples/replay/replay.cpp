@@ -0,0 +1,100 @@
+#include <getopt.h>
+#include <iomanip>
+#include <iostream>
+#include <stdlib.h>
+
+#include "replay.hpp"
+
+using namespace rofl::examples;
+
+replay::~replay() {}
+
+replay::replay() {}
+
+void replay::usage(const char *progname) const {
+  std::cerr << "usage: " << progname
+            << " [-d] [-s speed] [-i connid] [-r] file" << std::endl
+            << "  -d         replay a controller towards a datapath, default "
+               "is a datapath towards a controller"
+            << std::endl
+            << "  -s speed   multiplier for recorded pacing, 0 replays as "
+               "fast as possible (default)"
+            << std::endl
+            << "  -i connid  connection identifier within trace file, 0 "
+               "selects the first one (default)"
+            << std::endl
+            << "  -r         file contains raw OpenFlow messages instead of "
+               "a trace"
+            << std::endl;
+}
+
+int replay::run(int argc, char **argv) {
+  enum rofl::crofconn::crofconn_mode_t mode = rofl::crofconn::MODE_CONTROLLER;
+  double speed = 0.0;
+  uint64_t connid = 0;
+  bool raw = false;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "ds:i:r")) != -1) {
+    switch (opt) {
+    case 'd': {
+      mode = rofl::crofconn::MODE_DATAPATH;
+    } break;
+    case 's': {
+      speed = strtod(optarg, NULL);
+    } break;
+    case 'i': {
+      connid = strtoull(optarg, NULL, 0);
+    } break;
+    case 'r': {
+      raw = true;
+    } break;
+    default: {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+    }
+  }
+  if (optind != argc - 1) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  /* accept all versions supported by rofl-common */
+  rofl::openflow::cofhello_elem_versionbitmap vbitmap;
+  vbitmap.add_ofp_version(rofl::openflow10::OFP_VERSION);
+  vbitmap.add_ofp_version(rofl::openflow12::OFP_VERSION);
+  vbitmap.add_ofp_version(rofl::openflow13::OFP_VERSION);
+  crofbase::set_versionbitmap(vbitmap);
+
+  try {
+    rofl::cmsgreplay rpl;
+    size_t num = raw ? rpl.load_stream(argv[optind])
+                     : rpl.load_trace(argv[optind], connid);
+    std::cerr << "messages loaded: " << num << std::endl;
+
+    rofl::cmsgreplay::cresult result = rpl.run(*this, mode, speed);
+
+    std::cout << "messages sent: " << result.msgs_sent
+              << " expected: " << result.msgs_expected
+              << " dispatched: " << result.msgs_dispatched << std::endl;
+    std::cout << "wall time: " << result.wall_nsec / 1000 << " usec"
+              << std::endl;
+    std::cout << std::setw(6) << "type" << std::setw(12) << "msgs"
+              << std::setw(14) << "avg nsec" << std::setw(14) << "max nsec"
+              << std::endl;
+    for (auto &it : result.profiles) {
+      const rofl::crofconn::rxprofile_t &profile = it.second;
+      std::cout << std::setw(6) << (unsigned int)it.first << std::setw(12)
+                << profile.rx_msgs << std::setw(14)
+                << profile.nsec_sum / profile.rx_msgs << std::setw(14)
+                << profile.nsec_max << std::endl;
+    }
+
+  } catch (rofl::exception &e) {
+    std::cerr << "replay failed: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
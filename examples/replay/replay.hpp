@@ -0,0 +1,54 @@
+#ifndef ROFL_EXAMPLES_REPLAY_H
+#define ROFL_EXAMPLES_REPLAY_H 1
+
+#include <inttypes.h>
+
+#include <rofl/common/cmsgreplay.hpp>
+#include <rofl/common/rofcommon.h>
+
+namespace rofl {
+namespace examples {
+
+/**
+ * @ingroup common_howto_replay
+ *
+ * @brief	Replays recorded OpenFlow traffic through the full stack
+ *
+ * Loads the messages received on a single connection from a trace file
+ * written by rofl::cmsgtrace or a file of raw OpenFlow messages, replays
+ * them into an otherwise idle rofl::crofbase instance and prints the
+ * processing time per message type.
+ */
+class replay : public rofl::crofbase {
+public:
+  /**
+   * @brief	replay destructor
+   */
+  virtual ~replay();
+
+  /**
+   * @brief	replay constructor
+   */
+  replay();
+
+  /** @cond EXAMPLES */
+
+public:
+  /**
+   *
+   */
+  int run(int argc, char **argv);
+
+private:
+  /**
+   *
+   */
+  void usage(const char *progname) const;
+
+  /** @endcond */
+};
+
+}; // end of namespace examples
+}; // end of namespace rofl
+
+#endif /* ROFL_EXAMPLES_REPLAY_H */
@@ -10,6 +10,13 @@
 using namespace rofl;
 
 void caddrinfos::resolve() {
+  int rc = try_resolve();
+  if (rc != 0) {
+    throw eSysCall("getaddrinfo() " + std::string(gai_strerror(rc)));
+  }
+}
+
+int caddrinfos::try_resolve() {
   struct addrinfo ai_hints;
   memset(&ai_hints, 0, sizeof(struct addrinfo));
   ai_hints.ai_family = hints.get_ai_family();
@@ -25,23 +32,7 @@ void caddrinfos::resolve() {
                        (service.empty()) ? NULL : service.c_str(), &ai_hints,
                        &result);
   if (rc != 0) {
-    switch (rc) {
-    case EAI_ADDRFAMILY:
-    case EAI_AGAIN:
-    case EAI_BADFLAGS:
-    case EAI_FAIL:
-    case EAI_FAMILY:
-    case EAI_MEMORY:
-    case EAI_NODATA:
-    case EAI_NONAME:
-    case EAI_SERVICE:
-    case EAI_SOCKTYPE: {
-
-    } break;
-    case EAI_SYSTEM:
-    default: {};
-    }
-    throw eSysCall("getaddrinfo() " + std::string(gai_strerror(rc)));
+    return rc;
   }
 
   clear();
@@ -53,6 +44,8 @@ void caddrinfos::resolve() {
   }
 
   freeaddrinfo(result);
+
+  return 0;
 }
 
 caddrinfo &caddrinfos::add_addr_info(unsigned int index) {
@@ -82,10 +82,19 @@ public:
 
 public:
   /**
+   * @brief	Resolves node and service, blocks until getaddrinfo() returns
    *
+   * @throws eSysCall if getaddrinfo() fails
    */
   void resolve();
 
+  /**
+   * @brief	Non-throwing variant of resolve()
+   *
+   * @return 0 on success, getaddrinfo() error code otherwise
+   */
+  int try_resolve();
+
   /**
    *
    */
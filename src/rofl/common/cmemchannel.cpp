@@ -0,0 +1,162 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cmemchannel.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#include <algorithm>
+#include <errno.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "rofl/common/cmemchannel.hpp"
+
+using namespace rofl;
+
+cmemchannel::cmemchannel(size_t ring_size) : ring_size(ring_size) {
+  if ((0 == ring_size) || (ring_size & (ring_size - 1))) {
+    throw eMemChannelInvalid("cmemchannel::cmemchannel() ring_size must be a "
+                             "power of two",
+                             __FILE__, __FUNCTION__, __LINE__);
+  }
+
+  for (unsigned int side = 0; side < SIDE_MAX; side++) {
+    rings[side].head = 0;
+    rings[side].tail = 0;
+    rings[side].data_fd = -1;
+    rings[side].space_fd = -1;
+    closed[side] = false;
+  }
+
+  for (unsigned int side = 0; side < SIDE_MAX; side++) {
+    if (((rings[side].data_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) <
+         0) ||
+        ((rings[side].space_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) <
+         0)) {
+      int errnum = errno;
+      close_fds();
+      errno = errnum;
+      throw eSysCall("eSysCall", "eventfd", __FILE__, __FUNCTION__, __LINE__);
+    }
+    rings[side].buf.resize(ring_size);
+  }
+}
+
+cmemchannel::~cmemchannel() { close_fds(); }
+
+void cmemchannel::close_fds() {
+  for (unsigned int side = 0; side < SIDE_MAX; side++) {
+    if (rings[side].data_fd >= 0) {
+      ::close(rings[side].data_fd);
+      rings[side].data_fd = -1;
+    }
+    if (rings[side].space_fd >= 0) {
+      ::close(rings[side].space_fd);
+      rings[side].space_fd = -1;
+    }
+  }
+}
+
+ssize_t cmemchannel::send(side_t side, const uint8_t *buf, size_t len) {
+  if (closed[SIDE_A] || closed[SIDE_B]) {
+    errno = EPIPE;
+    return -1;
+  }
+  if (0 == len) {
+    return 0;
+  }
+
+  cring &ring = rings[side];
+  uint64_t head = ring.head.load(std::memory_order_relaxed);
+  uint64_t tail = ring.tail.load(std::memory_order_acquire);
+
+  if ((head - tail) == ring_size) {
+    /* rearm eventfd before checking again, the consumer signals after
+     * updating tail */
+    reset(ring.space_fd);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    tail = ring.tail.load(std::memory_order_acquire);
+    if ((head - tail) == ring_size) {
+      errno = EAGAIN;
+      return -1;
+    }
+  }
+
+  size_t nbytes = std::min(len, (size_t)(ring_size - (head - tail)));
+  size_t offset = head & (ring_size - 1);
+  size_t first = std::min(nbytes, ring_size - offset);
+  memcpy(&ring.buf[offset], buf, first);
+  memcpy(&ring.buf[0], buf + first, nbytes - first);
+
+  ring.head.store(head + nbytes, std::memory_order_release);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  /* consumer may have found the ring empty and wait for the eventfd */
+  if (ring.tail.load(std::memory_order_acquire) == head) {
+    signal(ring.data_fd);
+  }
+
+  return nbytes;
+}
+
+ssize_t cmemchannel::recv(side_t side, uint8_t *buf, size_t len) {
+  if (0 == len) {
+    return 0;
+  }
+
+  cring &ring = rings[peer(side)];
+  uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+  uint64_t head = ring.head.load(std::memory_order_acquire);
+
+  if (head == tail) {
+    /* rearm eventfd before checking again, the producer signals after
+     * updating head */
+    reset(ring.data_fd);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    head = ring.head.load(std::memory_order_acquire);
+    if (head == tail) {
+      if (closed[SIDE_A] || closed[SIDE_B]) {
+        return 0;
+      }
+      errno = EAGAIN;
+      return -1;
+    }
+  }
+
+  size_t nbytes = std::min(len, (size_t)(head - tail));
+  size_t offset = tail & (ring_size - 1);
+  size_t first = std::min(nbytes, ring_size - offset);
+  memcpy(buf, &ring.buf[offset], first);
+  memcpy(buf + first, &ring.buf[0], nbytes - first);
+
+  ring.tail.store(tail + nbytes, std::memory_order_release);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  /* producer may have found the ring full and wait for the eventfd */
+  if ((ring.head.load(std::memory_order_acquire) - tail) == ring_size) {
+    signal(ring.space_fd);
+  }
+
+  return nbytes;
+}
+
+void cmemchannel::shutdown(side_t side) {
+  closed[side] = true;
+
+  /* wake up peer's receiving and sending thread */
+  signal(rings[side].data_fd);
+  signal(rings[peer(side)].space_fd);
+}
+
+/*static*/ void cmemchannel::signal(int fd) { ::eventfd_write(fd, 1); }
+
+/*static*/ void cmemchannel::reset(int fd) {
+  eventfd_t value;
+  ::eventfd_read(fd, &value);
+}
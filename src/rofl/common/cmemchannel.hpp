@@ -0,0 +1,161 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cmemchannel.hpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#ifndef SRC_ROFL_COMMON_CMEMCHANNEL_HPP_
+#define SRC_ROFL_COMMON_CMEMCHANNEL_HPP_
+
+#include <atomic>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <vector>
+
+#include "rofl/common/exception.hpp"
+
+namespace rofl {
+
+class eMemChannelBase : public exception {
+public:
+  eMemChannelBase(const std::string &__arg,
+                  const std::string &__file = std::string(""),
+                  const std::string &__func = std::string(""), int __line = 0)
+      : exception(__arg, __file, __func, __line) {
+    set_exception("eMemChannelBase");
+  };
+};
+class eMemChannelInvalid : public eMemChannelBase {
+public:
+  eMemChannelInvalid(const std::string &__arg,
+                     const std::string &__file = std::string(""),
+                     const std::string &__func = std::string(""),
+                     int __line = 0)
+      : eMemChannelBase(__arg, __file, __func, __line) {
+    set_exception("eMemChannelInvalid");
+  };
+};
+
+/**
+ * @brief	Bidirectional in-process byte stream between two sides.
+ *
+ * Each direction is a single-producer/single-consumer ring buffer, so
+ * side A and side B may each be served by one sending and one receiving
+ * thread without any locks. Readiness is signalled via eventfds, which
+ * can be registered with a cthread instance like a socket descriptor:
+ * get_rx_fd() becomes readable when data has arrived and get_tx_fd()
+ * when space has become available after send() failed with EAGAIN.
+ * Both eventfds are signalled only on these transitions.
+ *
+ * send() and recv() follow the semantics of their non-blocking socket
+ * counterparts. A channel carries a single connection; once a side has
+ * called shutdown(), the peer drains the remaining data, recv() returns
+ * 0 afterwards and send() fails with EPIPE.
+ */
+class cmemchannel {
+public:
+  enum side_t {
+    SIDE_A = 0,
+    SIDE_B = 1,
+    SIDE_MAX = 2,
+  };
+
+  enum cmemchannel_defaults_t {
+    DEFAULT_RING_SIZE = 262144,
+  };
+
+  /**
+   * @brief	cmemchannel constructor
+   *
+   * @param ring_size capacity of each direction in bytes, power of two
+   * @exception rofl::eMemChannelInvalid ring_size is not a power of two
+   * @exception rofl::eSysCall eventfd could not be created
+   */
+  cmemchannel(size_t ring_size = DEFAULT_RING_SIZE);
+
+  /**
+   * @brief	cmemchannel destructor
+   */
+  ~cmemchannel();
+
+  /**
+   * @brief	Returns capacity of each direction in bytes
+   */
+  size_t get_ring_size() const { return ring_size; };
+
+  /**
+   * @brief	Returns eventfd signalling data available for side
+   */
+  int get_rx_fd(side_t side) const { return rings[peer(side)].data_fd; };
+
+  /**
+   * @brief	Returns eventfd signalling space available for side
+   */
+  int get_tx_fd(side_t side) const { return rings[side].space_fd; };
+
+  /**
+   * @brief	Copies up to len bytes into the ring towards the peer
+   *
+   * @return number of bytes copied or -1 with errno set to EAGAIN (ring
+   * full) or EPIPE (channel shut down)
+   */
+  ssize_t send(side_t side, const uint8_t *buf, size_t len);
+
+  /**
+   * @brief	Copies up to len bytes received from the peer into buf
+   *
+   * @return number of bytes copied, 0 if the peer has shut down and all
+   * data has been read or -1 with errno set to EAGAIN (ring empty)
+   */
+  ssize_t recv(side_t side, uint8_t *buf, size_t len);
+
+  /**
+   * @brief	Shuts down the channel on behalf of side and wakes up the peer
+   */
+  void shutdown(side_t side);
+
+private:
+  cmemchannel(const cmemchannel &);
+
+  cmemchannel &operator=(const cmemchannel &);
+
+  static side_t peer(side_t side) {
+    return (SIDE_A == side) ? SIDE_B : SIDE_A;
+  };
+
+  void close_fds();
+
+  static void signal(int fd);
+
+  static void reset(int fd);
+
+private:
+  /* ring written by a single side, read by its peer */
+  struct cring {
+    // bytes written so far, owned by producer
+    std::atomic<uint64_t> head;
+    // keep producer and consumer counters on separate cache lines
+    uint8_t pad[64 - sizeof(std::atomic<uint64_t>)];
+    // bytes read so far, owned by consumer
+    std::atomic<uint64_t> tail;
+    // signals consumer that data is available
+    int data_fd;
+    // signals producer that space is available
+    int space_fd;
+    // ring memory
+    std::vector<uint8_t> buf;
+  };
+
+  size_t ring_size;
+  cring rings[SIDE_MAX];
+  std::atomic_bool closed[SIDE_MAX];
+};
+
+}; // end of namespace rofl
+
+#endif /* SRC_ROFL_COMMON_CMEMCHANNEL_HPP_ */
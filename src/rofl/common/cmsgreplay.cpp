@@ -0,0 +1,363 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cmsgreplay.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#include <algorithm>
+#include <endian.h>
+#include <errno.h>
+#include <fstream>
+#include <iterator>
+#include <poll.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "rofl/common/cmsgreplay.hpp"
+#include "rofl/common/cmsgtrace.hpp"
+
+using namespace rofl;
+
+namespace {
+
+uint64_t now_nsec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+uint64_t sum_dispatched() {
+  uint64_t sum = 0;
+  for (unsigned int type = 0; type < 256; type++) {
+    sum += crofconn::get_rx_profile(type).rx_msgs;
+  }
+  return sum;
+}
+
+}; // end of anonymous namespace
+
+cmsgreplay::cmsgreplay() : sockfd(-1), running(false) {
+  pthread_mutex_init(&write_mutex, NULL);
+}
+
+cmsgreplay::~cmsgreplay() { pthread_mutex_destroy(&write_mutex); }
+
+void cmsgreplay::add_message(const uint8_t *buf, size_t buflen,
+                             uint64_t tstamp_nsec) {
+  if ((nullptr == buf) ||
+      (buflen < sizeof(struct rofl::openflow::ofp_header))) {
+    throw eMsgReplayInvalid("cmsgreplay::add_message() message too short",
+                            __FILE__, __FUNCTION__, __LINE__);
+  }
+  const struct rofl::openflow::ofp_header *hdr =
+      (const struct rofl::openflow::ofp_header *)buf;
+  if (be16toh(hdr->length) != buflen) {
+    throw eMsgReplayInvalid("cmsgreplay::add_message() invalid length",
+                            __FILE__, __FUNCTION__, __LINE__);
+  }
+  cmessage msg;
+  msg.tstamp_nsec = tstamp_nsec;
+  msg.data.assign(buf, buf + buflen);
+  messages.push_back(msg);
+}
+
+size_t cmsgreplay::load_trace(const std::string &tracefile, uint64_t connid) {
+  size_t num = 0;
+  cmsgtrace::read_records(tracefile, [&](const cmsgtrace::crecord &rec) {
+    if (rec.dir != cmsgtrace::DIR_RX)
+      return;
+    if (0 == connid)
+      connid = rec.connid;
+    if (rec.connid != connid)
+      return;
+    /* truncated by snaplen, cannot be replayed */
+    if (rec.caplen != rec.origlen)
+      return;
+    add_message(rec.data, rec.caplen, rec.tstamp_nsec);
+    num++;
+  });
+  return num;
+}
+
+size_t cmsgreplay::load_stream(const std::string &file) {
+  std::ifstream ifs(file.c_str(), std::ios::in | std::ios::binary);
+  if (not ifs.is_open()) {
+    throw eSysCall("eSysCall", "open", __FILE__, __FUNCTION__, __LINE__);
+  }
+  std::vector<uint8_t> buf((std::istreambuf_iterator<char>(ifs)),
+                           std::istreambuf_iterator<char>());
+  if (ifs.bad()) {
+    throw eSysCall("eSysCall", "read", __FILE__, __FUNCTION__, __LINE__);
+  }
+
+  size_t num = 0;
+  size_t offset = 0;
+  while (offset < buf.size()) {
+    if (buf.size() - offset < sizeof(struct rofl::openflow::ofp_header)) {
+      throw eMsgReplayInvalid("cmsgreplay::load_stream() truncated message",
+                              __FILE__, __FUNCTION__, __LINE__);
+    }
+    const struct rofl::openflow::ofp_header *hdr =
+        (const struct rofl::openflow::ofp_header *)(buf.data() + offset);
+    size_t msglen = be16toh(hdr->length);
+    if ((msglen < sizeof(struct rofl::openflow::ofp_header)) ||
+        (msglen > buf.size() - offset)) {
+      throw eMsgReplayInvalid("cmsgreplay::load_stream() invalid length",
+                              __FILE__, __FUNCTION__, __LINE__);
+    }
+    add_message(buf.data() + offset, msglen);
+    offset += msglen;
+    num++;
+  }
+  return num;
+}
+
+cmsgreplay::cresult cmsgreplay::run(crofbase &base,
+                                    enum crofconn::crofconn_mode_t mode,
+                                    double speed, unsigned int idle_msec) {
+  if (messages.empty()) {
+    throw eMsgReplayInvalid("cmsgreplay::run() no messages", __FILE__,
+                            __FUNCTION__, __LINE__);
+  }
+
+  const struct rofl::openflow::ofp_header *first =
+      (const struct rofl::openflow::ofp_header *)messages.front().data.data();
+  uint8_t version = first->version;
+
+  /* synthesize the peer's handshake if it has not been recorded */
+  std::vector<cmessage> handshake;
+  if (first->type != rofl::openflow::OFPT_HELLO) {
+    rofl::openflow::cofmsg_hello hello(version);
+    cmessage msg;
+    msg.tstamp_nsec = messages.front().tstamp_nsec;
+    msg.data.resize(hello.length());
+    hello.pack(msg.data.data(), msg.data.size());
+    handshake.push_back(msg);
+  }
+
+  bool features = (crofconn::MODE_CONTROLLER == mode) &&
+                  (version >= rofl::openflow13::OFP_VERSION);
+  if (features) {
+    bool found = false;
+    for (auto &msg : messages) {
+      if (msg.data[1] == rofl::openflow::OFPT_FEATURES_REPLY) {
+        found = true;
+        break;
+      }
+    }
+    if (not found) {
+      rofl::openflow::cofmsg_features_reply reply(version, 0, /*dpid=*/1);
+      cmessage msg;
+      msg.tstamp_nsec = messages.front().tstamp_nsec;
+      msg.data.resize(reply.length());
+      reply.pack(msg.data.data(), msg.data.size());
+      handshake.push_back(msg);
+    }
+  }
+
+  /* messages consumed by crofconn are never dispatched */
+  cresult result;
+  result.msgs_sent = 0;
+  result.msgs_expected = 0;
+  result.msgs_dispatched = 0;
+  for (auto &msg : messages) {
+    switch (msg.data[1]) {
+    case rofl::openflow::OFPT_HELLO:
+    case rofl::openflow::OFPT_ECHO_REQUEST:
+    case rofl::openflow::OFPT_ECHO_REPLY:
+      break;
+    case rofl::openflow::OFPT_FEATURES_REPLY:
+      if (features) {
+        features = false;
+        break;
+      }
+    /* fall through */
+    default:
+      result.msgs_expected++;
+    }
+  }
+
+  int sv[2];
+  if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sv) < 0) {
+    throw eSysCall("eSysCall", "socketpair", __FILE__, __FUNCTION__, __LINE__);
+  }
+  sockfd = sv[1];
+
+  /* the rx profile is shared by all connections, so the replay's share is
+   * the difference to a snapshot taken before */
+  std::vector<crofconn::rxprofile_t> baseline(256);
+  for (unsigned int type = 0; type < 256; type++) {
+    baseline[type] = crofconn::get_rx_profile(type);
+  }
+  uint64_t baseline_dispatched = sum_dispatched();
+
+  bool profiling = crofconn::get_rx_profiling();
+  crofconn::set_rx_profiling(true);
+
+  running = true;
+  pthread_t tid;
+  if (pthread_create(&tid, NULL, &(cmsgreplay::start_reader), this) != 0) {
+    running = false;
+    crofconn::set_rx_profiling(profiling);
+    ::close(sv[0]);
+    ::close(sv[1]);
+    sockfd = -1;
+    throw eSysCall("eSysCall", "pthread_create", __FILE__, __FUNCTION__,
+                   __LINE__);
+  }
+  pthread_setname_np(tid, "rofl-replay");
+
+  /* ownership of sv[0] moves to base */
+  if (crofconn::MODE_CONTROLLER == mode) {
+    base.dpt_sock_accept(sv[0]);
+  } else {
+    base.ctl_sock_accept(sv[0]);
+  }
+
+  uint64_t tstart = now_nsec();
+
+  try {
+    for (auto &msg : handshake) {
+      write_message(msg.data.data(), msg.data.size());
+      result.msgs_sent++;
+    }
+
+    uint64_t tfirst = messages.front().tstamp_nsec;
+    for (auto &msg : messages) {
+      if (msg.data[1] == rofl::openflow::OFPT_ECHO_REPLY)
+        continue;
+
+      if ((speed > 0.0) && (msg.tstamp_nsec > tfirst)) {
+        uint64_t tnext =
+            tstart + (uint64_t)((msg.tstamp_nsec - tfirst) / speed);
+        struct timespec ts;
+        ts.tv_sec = tnext / 1000000000;
+        ts.tv_nsec = tnext % 1000000000;
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) ==
+               EINTR) {
+        }
+      }
+
+      write_message(msg.data.data(), msg.data.size());
+      result.msgs_sent++;
+    }
+
+    /* wait for the stack to drain its rxqueues */
+    uint64_t dispatched = 0;
+    uint64_t tprogress = now_nsec();
+    while (dispatched < result.msgs_expected) {
+      usleep(1000);
+      uint64_t current = sum_dispatched() - baseline_dispatched;
+      if (current != dispatched) {
+        dispatched = current;
+        tprogress = now_nsec();
+      } else if (now_nsec() - tprogress > (uint64_t)idle_msec * 1000000) {
+        break;
+      }
+    }
+    result.msgs_dispatched = dispatched;
+    result.wall_nsec = now_nsec() - tstart;
+
+  } catch (...) {
+    running = false;
+    pthread_join(tid, NULL);
+    crofconn::set_rx_profiling(profiling);
+    ::close(sockfd);
+    sockfd = -1;
+    throw;
+  }
+
+  for (unsigned int type = 0; type < 256; type++) {
+    crofconn::rxprofile_t profile = crofconn::get_rx_profile(type);
+    if (profile.rx_msgs == baseline[type].rx_msgs) {
+      continue;
+    }
+    profile.rx_msgs -= baseline[type].rx_msgs;
+    profile.nsec_sum -= baseline[type].nsec_sum;
+    /* a maximum not raised during the replay is an upper bound only */
+    if (profile.nsec_max == baseline[type].nsec_max) {
+      profile.nsec_max = std::min(profile.nsec_max, profile.nsec_sum);
+    }
+    result.profiles[type] = profile;
+  }
+
+  running = false;
+  pthread_join(tid, NULL);
+  crofconn::set_rx_profiling(profiling);
+  /* peer closes the connection on end of file */
+  ::close(sockfd);
+  sockfd = -1;
+
+  return result;
+}
+
+void *cmsgreplay::start_reader(void *arg) {
+  static_cast<cmsgreplay *>(arg)->read_messages();
+  return NULL;
+}
+
+void cmsgreplay::read_messages() {
+  std::vector<uint8_t> buf;
+  uint8_t chunk[4096];
+
+  while (running) {
+    struct pollfd pfd;
+    pfd.fd = sockfd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if (::poll(&pfd, 1, 10) <= 0)
+      continue;
+
+    ssize_t rc = ::read(sockfd, chunk, sizeof(chunk));
+    if (rc <= 0) {
+      if ((rc < 0) && ((errno == EINTR) || (errno == EAGAIN)))
+        continue;
+      return;
+    }
+    buf.insert(buf.end(), chunk, chunk + rc);
+
+    /* answer Echo-Requests, discard everything else */
+    size_t offset = 0;
+    while (buf.size() - offset >= sizeof(struct rofl::openflow::ofp_header)) {
+      struct rofl::openflow::ofp_header *hdr =
+          (struct rofl::openflow::ofp_header *)(buf.data() + offset);
+      size_t msglen = be16toh(hdr->length);
+      if (msglen < sizeof(struct rofl::openflow::ofp_header))
+        return;
+      if (buf.size() - offset < msglen)
+        break;
+      if (hdr->type == rofl::openflow::OFPT_ECHO_REQUEST) {
+        hdr->type = rofl::openflow::OFPT_ECHO_REPLY;
+        try {
+          write_message(buf.data() + offset, msglen);
+        } catch (eSysCall &e) {
+          return;
+        }
+      }
+      offset += msglen;
+    }
+    buf.erase(buf.begin(), buf.begin() + offset);
+  }
+}
+
+void cmsgreplay::write_message(const uint8_t *buf, size_t buflen) {
+  pthread_mutex_lock(&write_mutex);
+  size_t offset = 0;
+  while (offset < buflen) {
+    ssize_t rc = ::send(sockfd, buf + offset, buflen - offset, MSG_NOSIGNAL);
+    if (rc < 0) {
+      if (errno == EINTR)
+        continue;
+      pthread_mutex_unlock(&write_mutex);
+      throw eSysCall("eSysCall", "send", __FILE__, __FUNCTION__, __LINE__);
+    }
+    offset += rc;
+  }
+  pthread_mutex_unlock(&write_mutex);
+}
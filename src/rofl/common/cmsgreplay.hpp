@@ -0,0 +1,174 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cmsgreplay.hpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#ifndef SRC_ROFL_COMMON_CMSGREPLAY_HPP_
+#define SRC_ROFL_COMMON_CMSGREPLAY_HPP_
+
+#include <atomic>
+#include <inttypes.h>
+#include <map>
+#include <pthread.h>
+#include <string>
+#include <vector>
+
+#include "rofl/common/crofbase.h"
+#include "rofl/common/crofconn.h"
+#include "rofl/common/exception.hpp"
+
+namespace rofl {
+
+class eMsgReplayBase : public exception {
+public:
+  eMsgReplayBase(const std::string &__arg,
+                 const std::string &__file = std::string(""),
+                 const std::string &__func = std::string(""), int __line = 0)
+      : exception(__arg, __file, __func, __line) {
+    set_exception("eMsgReplayBase");
+  };
+};
+class eMsgReplayInvalid : public eMsgReplayBase {
+public:
+  eMsgReplayInvalid(const std::string &__arg,
+                    const std::string &__file = std::string(""),
+                    const std::string &__func = std::string(""),
+                    int __line = 0)
+      : eMsgReplayBase(__arg, __file, __func, __line) {
+    set_exception("eMsgReplayInvalid");
+  };
+};
+
+/**
+ * @brief	Replays recorded OpenFlow traffic into a rofl::crofbase instance.
+ *
+ * Messages are loaded from a cmsgtrace file, from a file containing raw
+ * OpenFlow messages back to back or added one by one. run() creates a
+ * socketpair, hands one end to the rofl::crofbase instance and writes all
+ * messages into the other end, so they pass the full stack including
+ * crofsock's parser, crofconn's rxqueues and the application's handlers.
+ * Messages are written as fast as possible or paced by their recorded
+ * timestamps. Echo-Requests sent by the stack are answered, all other
+ * messages sent by the stack are discarded.
+ *
+ * A Hello is synthesized if the recorded stream does not start with one,
+ * likewise a Features-Reply when replaying towards a controller speaking
+ * OpenFlow 1.3 or above. Recorded Echo-Replies are not replayed.
+ *
+ * Processing time per message type is the growth of crofconn's rx profile
+ * during the replay, counters of other connections are left untouched. As
+ * the profile covers all connections, replay into an instance without any
+ * other traffic for meaningful numbers. A maximum processing time not
+ * exceeding the one recorded before the replay is reported as an upper
+ * bound.
+ */
+class cmsgreplay {
+public:
+  enum cmsgreplay_defaults_t {
+    DEFAULT_IDLE_MSEC = 1000,
+  };
+
+  /* per message type processing time */
+  struct cresult {
+    size_t msgs_sent;
+    size_t msgs_expected;
+    size_t msgs_dispatched;
+    uint64_t wall_nsec;
+    std::map<uint8_t, crofconn::rxprofile_t> profiles;
+  };
+
+  cmsgreplay();
+
+  ~cmsgreplay();
+
+  /**
+   * @brief	Removes all messages
+   */
+  void clear() { messages.clear(); };
+
+  /**
+   * @brief	Returns number of messages
+   */
+  size_t size() const { return messages.size(); };
+
+  /**
+   * @brief	Appends a single OpenFlow message
+   *
+   * @param buf start of message
+   * @param buflen length of message, must match the message header
+   * @param tstamp_nsec recorded timestamp, used for pacing only
+   * @exception rofl::eMsgReplayInvalid message is malformed
+   */
+  void add_message(const uint8_t *buf, size_t buflen,
+                   uint64_t tstamp_nsec = 0);
+
+  /**
+   * @brief	Appends all messages received on a connection from a trace
+   *
+   * Records truncated by the trace's snaplen are skipped.
+   *
+   * @param tracefile trace file written by rofl::cmsgtrace
+   * @param connid connection identifier, 0 selects the connection of the
+   * first received message
+   * @return number of messages added
+   * @exception rofl::eMsgTraceInvalid tracefile has an invalid format
+   */
+  size_t load_trace(const std::string &tracefile, uint64_t connid = 0);
+
+  /**
+   * @brief	Appends all messages from a file of raw OpenFlow messages
+   *
+   * @param file messages stored back to back
+   * @return number of messages added
+   * @exception rofl::eSysCall file could not be read
+   * @exception rofl::eMsgReplayInvalid file contains a malformed message
+   */
+  size_t load_stream(const std::string &file);
+
+  /**
+   * @brief	Replays all messages and waits for the stack to process them
+   *
+   * Returns when all messages have been dispatched to the higher layers
+   * or no further message has been dispatched for idle_msec milliseconds.
+   *
+   * @param base instance receiving the messages
+   * @param mode crofconn::MODE_CONTROLLER replays a datapath towards a
+   * controller, crofconn::MODE_DATAPATH replays a controller
+   * @param speed 0 replays as fast as possible, otherwise multiplier for
+   * the recorded pacing, e.g., 2.0 for twice the recorded rate
+   * @param idle_msec stop waiting after this time without progress
+   * @exception rofl::eMsgReplayInvalid no messages available
+   * @exception rofl::eSysCall socketpair could not be created
+   */
+  cresult run(crofbase &base, enum crofconn::crofconn_mode_t mode,
+              double speed = 0.0,
+              unsigned int idle_msec = DEFAULT_IDLE_MSEC);
+
+private:
+  struct cmessage {
+    uint64_t tstamp_nsec;
+    std::vector<uint8_t> data;
+  };
+
+  static void *start_reader(void *arg);
+
+  void read_messages();
+
+  void write_message(const uint8_t *buf, size_t buflen);
+
+private:
+  std::vector<cmessage> messages;
+  int sockfd;
+  std::atomic_bool running;
+  pthread_mutex_t write_mutex;
+};
+
+}; // end of namespace rofl
+
+#endif /* SRC_ROFL_COMMON_CMSGREPLAY_HPP_ */
@@ -0,0 +1,521 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cmsgtrace.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#include <algorithm>
+#include <endian.h>
+#include <fcntl.h>
+#include <fstream>
+#include <map>
+#include <sched.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+#include "rofl/common/cmsgtrace.hpp"
+
+using namespace rofl;
+
+/*static*/ std::atomic_bool cmsgtrace::enabled(false);
+/*static*/ std::atomic_uint cmsgtrace::active(0);
+/*static*/ std::atomic_uint cmsgtrace::generation(0);
+/*static*/ pthread_mutex_t cmsgtrace::trace_mutex = PTHREAD_MUTEX_INITIALIZER;
+/*static*/ uint8_t *cmsgtrace::area = nullptr;
+/*static*/ size_t cmsgtrace::area_size = 0;
+/*static*/ size_t cmsgtrace::ring_size = 0;
+/*static*/ size_t cmsgtrace::snaplen = 0;
+
+/* ring claimed by this thread and the trace file generation it belongs to */
+static thread_local uint8_t *local_ring = nullptr;
+static thread_local unsigned int local_generation = 0;
+
+static const char TRACE_MAGIC[8] = {'R', 'O', 'F', 'L', 'T', 'R', 'C', 'E'};
+
+void cmsgtrace::initialize(const std::string &path, size_t ring_size,
+                           unsigned int num_of_rings, size_t snaplen) {
+  static_assert(sizeof(struct ctracefile) == 64, "ctracefile");
+  static_assert(sizeof(struct ctracering) == 64, "ctracering");
+  static_assert(sizeof(struct ctracerecord) == 32, "ctracerecord");
+
+  cmsgtrace::terminate();
+
+  /* a single record must never occupy more than a quarter of a ring */
+  ring_size = (std::max(ring_size, (size_t)4096) + 7) & ~((size_t)7);
+  snaplen = std::min(snaplen, ring_size / 4 - sizeof(struct ctracerecord));
+  if (num_of_rings == 0)
+    num_of_rings = 1;
+
+  size_t size =
+      sizeof(struct ctracefile) +
+      (size_t)num_of_rings * (sizeof(struct ctracering) + ring_size);
+
+  pthread_mutex_lock(&trace_mutex);
+
+  int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    pthread_mutex_unlock(&trace_mutex);
+    throw eSysCall("eSysCall", "open", __FILE__, __FUNCTION__, __LINE__);
+  }
+
+  /* reserve all blocks, writing to a sparse mapping may raise SIGBUS */
+  if (::posix_fallocate(fd, 0, size) != 0) {
+    ::close(fd);
+    pthread_mutex_unlock(&trace_mutex);
+    throw eSysCall("eSysCall", "posix_fallocate", __FILE__, __FUNCTION__,
+                   __LINE__);
+  }
+
+  void *addr =
+      ::mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, /*offset=*/0);
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    pthread_mutex_unlock(&trace_mutex);
+    throw eSysCall("eSysCall", "mmap", __FILE__, __FUNCTION__, __LINE__);
+  }
+
+  memset(addr, 0, size);
+  struct ctracefile *file = (struct ctracefile *)addr;
+  memcpy(file->magic, TRACE_MAGIC, sizeof(file->magic));
+  file->version = TRACE_VERSION;
+  file->num_of_rings = num_of_rings;
+  file->ring_size = ring_size;
+  file->snaplen = snaplen;
+
+  area = (uint8_t *)addr;
+  area_size = size;
+  cmsgtrace::ring_size = ring_size;
+  cmsgtrace::snaplen = snaplen;
+
+  /* invalidate rings claimed by threads for a previous trace file */
+  generation++;
+  enabled = true;
+
+  pthread_mutex_unlock(&trace_mutex);
+}
+
+void cmsgtrace::terminate() {
+  pthread_mutex_lock(&trace_mutex);
+  enabled = false;
+
+  /* wait for writers still copying into the mapping */
+  while (active.load() != 0) {
+    sched_yield();
+  }
+
+  if (area != nullptr) {
+    ::msync(area, area_size, MS_ASYNC);
+    ::munmap(area, area_size);
+    area = nullptr;
+    area_size = 0;
+  }
+  pthread_mutex_unlock(&trace_mutex);
+}
+
+uint64_t cmsgtrace::get_drops() {
+  pthread_mutex_lock(&trace_mutex);
+  uint64_t drops = 0;
+  if (area != nullptr) {
+    drops = __atomic_load_n(&((struct ctracefile *)area)->drops,
+                            __ATOMIC_RELAXED);
+  }
+  pthread_mutex_unlock(&trace_mutex);
+  return drops;
+}
+
+uint8_t *cmsgtrace::get_ring() {
+  unsigned int current = generation.load();
+  if (local_generation == current) {
+    return local_ring;
+  }
+
+  struct ctracefile *file = (struct ctracefile *)area;
+  uint32_t index = __atomic_fetch_add(&file->rings_used, 1, __ATOMIC_RELAXED);
+
+  local_generation = current;
+  if (index >= file->num_of_rings) {
+    local_ring = nullptr;
+  } else {
+    local_ring = area + sizeof(struct ctracefile) +
+                 index * (sizeof(struct ctracering) + ring_size);
+    ((struct ctracering *)local_ring)->tid = syscall(SYS_gettid);
+  }
+  return local_ring;
+}
+
+void cmsgtrace::record_slow(direction_t dir, uint64_t connid, uint8_t auxid,
+                            const uint8_t *buf, size_t buflen) {
+  active++;
+  if (not enabled.load()) {
+    active--;
+    return;
+  }
+
+  uint8_t *ring = get_ring();
+  if (ring == nullptr) {
+    __atomic_fetch_add(&((struct ctracefile *)area)->drops, 1,
+                       __ATOMIC_RELAXED);
+    active--;
+    return;
+  }
+
+  struct ctracering *hdr = (struct ctracering *)ring;
+  uint8_t *data = ring + sizeof(struct ctracering);
+
+  size_t caplen = std::min(buflen, snaplen);
+  size_t reclen = (sizeof(struct ctracerecord) + caplen + 7) & ~((size_t)7);
+
+  /* this thread is the only writer, no need for atomic read-modify-write */
+  uint64_t head = hdr->head;
+  uint64_t tail = hdr->tail;
+  size_t room = ring_size - (head % ring_size);
+  size_t need = (room < reclen) ? room + reclen : reclen;
+
+  /* release oldest records before overwriting them */
+  while ((head + need - tail) > ring_size) {
+    tail += ((struct ctracerecord *)(data + (tail % ring_size)))->reclen;
+  }
+  __atomic_store_n(&hdr->tail, tail, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+  /* record does not fit into the ring's end */
+  if (room < reclen) {
+    struct ctracerecord *pad =
+        (struct ctracerecord *)(data + (head % ring_size));
+    pad->reclen = room;
+    pad->caplen = PAD_RECORD;
+    head += room;
+  }
+
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+
+  struct ctracerecord *rec = (struct ctracerecord *)(data + (head % ring_size));
+  rec->reclen = reclen;
+  rec->caplen = caplen;
+  rec->tstamp_nsec = (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+  rec->connid = connid;
+  rec->origlen = buflen;
+  rec->dir = dir;
+  rec->auxid = auxid;
+  memcpy(rec->data, buf, caplen);
+
+  __atomic_store_n(&hdr->head, head + reclen, __ATOMIC_RELEASE);
+
+  active--;
+}
+
+namespace {
+
+struct cexportrecord {
+  uint64_t tstamp_nsec;
+  uint64_t connid;
+  uint32_t origlen;
+  uint32_t caplen;
+  uint8_t dir;
+  uint8_t auxid;
+  size_t ring;
+  size_t offset;
+
+  bool operator<(const cexportrecord &rec) const {
+    return tstamp_nsec < rec.tstamp_nsec;
+  };
+};
+
+void append(std::string &out, const void *buf, size_t buflen) {
+  out.append((const char *)buf, buflen);
+}
+
+template <typename T> void append(std::string &out, T value) {
+  out.append((const char *)&value, sizeof(value));
+}
+
+void append_padding(std::string &out) {
+  while (out.length() % 4) {
+    out.push_back('\0');
+  }
+}
+
+uint16_t ipv4_checksum(const uint8_t *buf, size_t buflen) {
+  uint32_t sum = 0;
+  for (size_t i = 0; i + 1 < buflen; i += 2) {
+    sum += (buf[i] << 8) | buf[i + 1];
+  }
+  while (sum >> 16) {
+    sum = (sum & 0xffff) + (sum >> 16);
+  }
+  return ~sum;
+}
+
+}; // end of anonymous namespace
+
+size_t cmsgtrace::read_records(const std::string &tracefile,
+                               const std::function<void(const crecord &)> &fn,
+                               unsigned int max_age_sec) {
+  int fd = ::open(tracefile.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw eSysCall("eSysCall", "open", __FILE__, __FUNCTION__, __LINE__);
+  }
+
+  struct stat st;
+  if (::fstat(fd, &st) < 0) {
+    ::close(fd);
+    throw eSysCall("eSysCall", "fstat", __FILE__, __FUNCTION__, __LINE__);
+  }
+
+  size_t size = st.st_size;
+  if (size < sizeof(struct ctracefile)) {
+    ::close(fd);
+    throw eMsgTraceInvalid("cmsgtrace::read_records() file too short",
+                           __FILE__, __FUNCTION__, __LINE__);
+  }
+
+  void *addr = ::mmap(NULL, size, PROT_READ, MAP_SHARED, fd, /*offset=*/0);
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    throw eSysCall("eSysCall", "mmap", __FILE__, __FUNCTION__, __LINE__);
+  }
+
+  std::vector<std::vector<uint8_t>> rings;
+  std::vector<cexportrecord> records;
+
+  try {
+    const struct ctracefile *file = (const struct ctracefile *)addr;
+    if ((memcmp(file->magic, TRACE_MAGIC, sizeof(file->magic)) != 0) ||
+        (file->version != TRACE_VERSION) || (file->ring_size == 0) ||
+        (file->ring_size % 8) ||
+        (size < sizeof(struct ctracefile) +
+                    file->num_of_rings *
+                        (sizeof(struct ctracering) + file->ring_size))) {
+      throw eMsgTraceInvalid("cmsgtrace::read_records() invalid file header",
+                             __FILE__, __FUNCTION__, __LINE__);
+    }
+
+    size_t rsize = file->ring_size;
+    unsigned int num_of_rings =
+        std::min(__atomic_load_n(&file->rings_used, __ATOMIC_RELAXED),
+                 file->num_of_rings);
+
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    uint64_t since = 0;
+    if (max_age_sec > 0) {
+      since = (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec -
+              (uint64_t)max_age_sec * 1000000000;
+    }
+
+    for (unsigned int i = 0; i < num_of_rings; i++) {
+      const uint8_t *ring = (const uint8_t *)addr + sizeof(struct ctracefile) +
+                            i * (sizeof(struct ctracering) + rsize);
+      const struct ctracering *hdr = (const struct ctracering *)ring;
+      const uint8_t *data = ring + sizeof(struct ctracering);
+
+      /* copy the ring first, the writer may still be running */
+      uint64_t tail = __atomic_load_n(&hdr->tail, __ATOMIC_ACQUIRE);
+      uint64_t head = __atomic_load_n(&hdr->head, __ATOMIC_ACQUIRE);
+      if ((head < tail) || (head - tail > rsize)) {
+        throw eMsgTraceInvalid("cmsgtrace::read_records() invalid ring",
+                               __FILE__, __FUNCTION__, __LINE__);
+      }
+
+      rings.push_back(std::vector<uint8_t>(head - tail));
+      std::vector<uint8_t> &copy = rings.back();
+      size_t first = std::min((size_t)(head - tail), rsize - (tail % rsize));
+      memcpy(copy.data(), data + (tail % rsize), first);
+      memcpy(copy.data() + first, data, copy.size() - first);
+
+      /* skip all records overwritten while copying */
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+      uint64_t pos = std::max(tail, __atomic_load_n(&hdr->tail,
+                                                    __ATOMIC_RELAXED));
+
+      while (pos < head) {
+        const struct ctracerecord *rec =
+            (const struct ctracerecord *)(copy.data() + (pos - tail));
+        if ((head - pos < 8) || (rec->reclen < 8) || (rec->reclen % 8) ||
+            (rec->reclen > head - pos)) {
+          throw eMsgTraceInvalid("cmsgtrace::read_records() invalid record",
+                                 __FILE__, __FUNCTION__, __LINE__);
+        }
+        if (rec->caplen != PAD_RECORD) {
+          if ((rec->reclen < sizeof(struct ctracerecord) + rec->caplen) ||
+              (rec->caplen > rec->origlen)) {
+            throw eMsgTraceInvalid("cmsgtrace::read_records() invalid record",
+                                   __FILE__, __FUNCTION__, __LINE__);
+          }
+          if (rec->tstamp_nsec >= since) {
+            cexportrecord entry;
+            entry.tstamp_nsec = rec->tstamp_nsec;
+            entry.connid = rec->connid;
+            entry.origlen = rec->origlen;
+            entry.caplen = rec->caplen;
+            entry.dir = rec->dir;
+            entry.auxid = rec->auxid;
+            entry.ring = rings.size() - 1;
+            entry.offset = (pos - tail) + sizeof(struct ctracerecord);
+            records.push_back(entry);
+          }
+        }
+        pos += rec->reclen;
+      }
+    }
+
+  } catch (...) {
+    ::munmap(addr, size);
+    throw;
+  }
+  ::munmap(addr, size);
+
+  std::stable_sort(records.begin(), records.end());
+
+  for (auto &entry : records) {
+    crecord rec;
+    rec.tstamp_nsec = entry.tstamp_nsec;
+    rec.connid = entry.connid;
+    rec.origlen = entry.origlen;
+    rec.caplen = entry.caplen;
+    rec.dir = (entry.dir == DIR_RX) ? DIR_RX : DIR_TX;
+    rec.auxid = entry.auxid;
+    rec.data = rings[entry.ring].data() + entry.offset;
+    fn(rec);
+  }
+
+  return records.size();
+}
+
+size_t cmsgtrace::export_pcapng(const std::string &tracefile,
+                                const std::string &pcapfile,
+                                unsigned int max_age_sec) {
+  std::string out;
+
+  /* section header block */
+  append<uint32_t>(out, 0x0a0d0d0a);
+  append<uint32_t>(out, 28);
+  append<uint32_t>(out, 0x1a2b3c4d);
+  append<uint16_t>(out, 1);
+  append<uint16_t>(out, 0);
+  append<int64_t>(out, -1);
+  append<uint32_t>(out, 28);
+
+  /* interface description block, Ethernet with nanosecond resolution */
+  append<uint32_t>(out, 1);
+  append<uint32_t>(out, 32);
+  append<uint16_t>(out, 1);
+  append<uint16_t>(out, 0);
+  append<uint32_t>(out, 0);
+  append<uint16_t>(out, 9);
+  append<uint16_t>(out, 1);
+  append<uint32_t>(out, 9);
+  append<uint32_t>(out, 0);
+  append<uint32_t>(out, 32);
+
+  const size_t hdrlen = 14 + 20 + 20;
+  const size_t mss = 65535 - 20 - 20;
+  /* next TCP sequence number per connection and direction */
+  std::map<uint64_t, std::pair<uint32_t, uint32_t>> seqnos;
+
+  auto write_record = [&](const crecord &rec) {
+    const uint8_t *payload = rec.data;
+
+    uint32_t local_ip = 0x7f000001;
+    uint32_t remote_ip = 0x7f800000 | (rec.connid & 0x007fffff);
+    uint16_t local_port = 6653;
+    uint16_t remote_port = 49152 + rec.auxid;
+
+    std::pair<uint32_t, uint32_t> &seqno =
+        seqnos.insert(std::make_pair(rec.connid, std::make_pair(1, 1)))
+            .first->second;
+    bool rx = (rec.dir == DIR_RX);
+    uint32_t &seq = rx ? seqno.first : seqno.second;
+    uint32_t ack = rx ? seqno.second : seqno.first;
+
+    std::string comment = "connid=" + std::to_string(rec.connid) +
+                          " auxid=" + std::to_string(rec.auxid);
+
+    /* split messages exceeding the maximum IPv4 packet size */
+    for (size_t offset = 0; (offset < rec.origlen) || (offset == 0);
+         offset += mss) {
+      size_t seglen = std::min((size_t)rec.origlen - offset, mss);
+      size_t caplen =
+          (offset < rec.caplen) ? std::min((size_t)rec.caplen - offset, seglen)
+                                : 0;
+
+      uint8_t pkt[hdrlen];
+      memset(pkt, 0, sizeof(pkt));
+
+      /* ethernet */
+      uint8_t local_mac[6] = {0x02, 0, 0, 0, 0, 0x01};
+      uint8_t remote_mac[6] = {0x02, 0, 0, 0, 0, 0x02};
+      memcpy(pkt + 0, rx ? local_mac : remote_mac, 6);
+      memcpy(pkt + 6, rx ? remote_mac : local_mac, 6);
+      pkt[12] = 0x08;
+      pkt[13] = 0x00;
+
+      /* IPv4 */
+      uint8_t *ip = pkt + 14;
+      ip[0] = 0x45;
+      *(uint16_t *)(ip + 2) = htobe16(20 + 20 + seglen);
+      *(uint16_t *)(ip + 6) = htobe16(0x4000);
+      ip[8] = 64;
+      ip[9] = 6;
+      *(uint32_t *)(ip + 12) = htobe32(rx ? remote_ip : local_ip);
+      *(uint32_t *)(ip + 16) = htobe32(rx ? local_ip : remote_ip);
+      *(uint16_t *)(ip + 10) = htobe16(ipv4_checksum(ip, 20));
+
+      /* TCP, checksum is left empty */
+      uint8_t *tcp = ip + 20;
+      *(uint16_t *)(tcp + 0) = htobe16(rx ? remote_port : local_port);
+      *(uint16_t *)(tcp + 2) = htobe16(rx ? local_port : remote_port);
+      *(uint32_t *)(tcp + 4) = htobe32(seq);
+      *(uint32_t *)(tcp + 8) = htobe32(ack);
+      tcp[12] = 5 << 4;
+      tcp[13] = 0x18; /* PSH, ACK */
+      *(uint16_t *)(tcp + 14) = htobe16(0xffff);
+
+      seq += seglen;
+
+      size_t blocklen = 28 + ((hdrlen + caplen + 3) & ~((size_t)3)) + 4 +
+                        ((comment.length() + 3) & ~((size_t)3)) + 4 + 4;
+
+      /* enhanced packet block */
+      append<uint32_t>(out, 6);
+      append<uint32_t>(out, blocklen);
+      append<uint32_t>(out, 0);
+      append<uint32_t>(out, rec.tstamp_nsec >> 32);
+      append<uint32_t>(out, rec.tstamp_nsec & 0xffffffff);
+      append<uint32_t>(out, hdrlen + caplen);
+      append<uint32_t>(out, hdrlen + seglen);
+      append(out, pkt, hdrlen);
+      append(out, payload + offset, caplen);
+      append_padding(out);
+      append<uint16_t>(out, 1);
+      append<uint16_t>(out, comment.length());
+      append(out, comment.data(), comment.length());
+      append_padding(out);
+      append<uint32_t>(out, 0);
+      append<uint32_t>(out, blocklen);
+    }
+  };
+
+  size_t num_of_records = read_records(tracefile, write_record, max_age_sec);
+
+  std::ofstream ofs(pcapfile.c_str(), std::ios::out | std::ios::binary |
+                                          std::ios::trunc);
+  ofs.write(out.data(), out.length());
+  ofs.close();
+  if (ofs.fail()) {
+    throw eSysCall("eSysCall", "write", __FILE__, __FUNCTION__, __LINE__);
+  }
+
+  return num_of_records;
+}
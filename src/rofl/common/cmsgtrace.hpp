@@ -0,0 +1,228 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cmsgtrace.hpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#ifndef SRC_ROFL_COMMON_CMSGTRACE_HPP_
+#define SRC_ROFL_COMMON_CMSGTRACE_HPP_
+
+#include <atomic>
+#include <functional>
+#include <inttypes.h>
+#include <pthread.h>
+#include <string>
+
+#include "rofl/common/exception.hpp"
+
+namespace rofl {
+
+class eMsgTraceBase : public exception {
+public:
+  eMsgTraceBase(const std::string &__arg,
+                const std::string &__file = std::string(""),
+                const std::string &__func = std::string(""), int __line = 0)
+      : exception(__arg, __file, __func, __line) {
+    set_exception("eMsgTraceBase");
+  };
+};
+class eMsgTraceInvalid : public eMsgTraceBase {
+public:
+  eMsgTraceInvalid(const std::string &__arg,
+                   const std::string &__file = std::string(""),
+                   const std::string &__func = std::string(""), int __line = 0)
+      : eMsgTraceBase(__arg, __file, __func, __line) {
+    set_exception("eMsgTraceInvalid");
+  };
+};
+
+/**
+ * @brief	Flight recorder for raw OpenFlow messages.
+ *
+ * Tracing is disabled by default. When enabled, crofsock copies each
+ * message received or sent along with a timestamp, direction, connection
+ * identifier and auxiliary id into a ring owned by the calling thread.
+ * All rings live in a single memory-mapped file, so writers never share
+ * state except for a short-lived activity counter and the file survives
+ * a crash of the process. Old records are overwritten, i.e., the file
+ * always holds the most recent traffic per thread.
+ *
+ * export_pcapng() converts a trace file into pcapng format. Each message
+ * is wrapped into a synthetic Ethernet/IPv4/TCP header with TCP port 6653
+ * on the local side, so that common dissectors decode OpenFlow. The local
+ * address is 127.0.0.1, the remote address within 127.128.0.0/9 is derived
+ * from the connection identifier and the remote port is 49152 + auxid.
+ */
+class cmsgtrace {
+public:
+  enum cmsgtrace_defaults_t {
+    DEFAULT_RING_SIZE = 4 * 1024 * 1024,
+    DEFAULT_NUM_OF_RINGS = 16,
+    DEFAULT_SNAPLEN = 65535,
+  };
+
+  enum direction_t {
+    DIR_RX = 0,
+    DIR_TX = 1,
+  };
+
+  /* record as delivered by read_records() */
+  struct crecord {
+    uint64_t tstamp_nsec;
+    uint64_t connid;
+    uint32_t origlen;
+    uint32_t caplen;
+    direction_t dir;
+    uint8_t auxid;
+    const uint8_t *data;
+  };
+
+  /**
+   * @brief	Create trace file and enable tracing
+   *
+   * An existing file is truncated.
+   *
+   * @param path trace file
+   * @param ring_size size of each thread's ring in bytes
+   * @param num_of_rings maximum number of threads recording messages
+   * @param snaplen messages are truncated to this length
+   * @exception rofl::eSysCall file could not be created or mapped
+   */
+  static void initialize(const std::string &path,
+                         size_t ring_size = DEFAULT_RING_SIZE,
+                         unsigned int num_of_rings = DEFAULT_NUM_OF_RINGS,
+                         size_t snaplen = DEFAULT_SNAPLEN);
+
+  /**
+   * @brief	Disable tracing and unmap the trace file
+   *
+   * The file is kept on disk for export.
+   */
+  static void terminate();
+
+  /**
+   * @brief	Returns true if tracing is enabled
+   */
+  static bool is_enabled() {
+    return enabled.load(std::memory_order_relaxed);
+  };
+
+  /**
+   * @brief	Copy a message into the calling thread's ring
+   *
+   * @param dir message was received or sent
+   * @param connid connection identifier
+   * @param auxid auxiliary connection identifier
+   * @param buf start of message
+   * @param buflen length of message
+   */
+  static void record(direction_t dir, uint64_t connid, uint8_t auxid,
+                     const uint8_t *buf, size_t buflen) {
+    if (not is_enabled())
+      return;
+    record_slow(dir, connid, auxid, buf, buflen);
+  };
+
+  /**
+   * @brief	Returns number of records dropped as no ring was available
+   */
+  static uint64_t get_drops();
+
+  /**
+   * @brief	Read all records from a trace file in timestamp order
+   *
+   * May be called on a file while tracing is still running, records
+   * overwritten while reading the file are skipped. The record's data
+   * is valid during the call to fn only.
+   *
+   * @param tracefile trace file written by cmsgtrace
+   * @param fn function called for each record
+   * @param max_age_sec read records of the last max_age_sec seconds
+   * only, 0 reads all records
+   * @return number of records read
+   * @exception rofl::eSysCall file could not be read
+   * @exception rofl::eMsgTraceInvalid tracefile has an invalid format
+   */
+  static size_t read_records(const std::string &tracefile,
+                             const std::function<void(const crecord &)> &fn,
+                             unsigned int max_age_sec = 0);
+
+  /**
+   * @brief	Write all records from a trace file into a pcapng file
+   *
+   * May be called on a file while tracing is still running, records
+   * overwritten while reading the file are skipped.
+   *
+   * @param tracefile trace file written by cmsgtrace
+   * @param pcapfile pcapng file to be created
+   * @param max_age_sec export records of the last max_age_sec seconds
+   * only, 0 exports all records
+   * @return number of records written
+   * @exception rofl::eSysCall file could not be read or written
+   * @exception rofl::eMsgTraceInvalid tracefile has an invalid format
+   */
+  static size_t export_pcapng(const std::string &tracefile,
+                              const std::string &pcapfile,
+                              unsigned int max_age_sec = 0);
+
+private:
+  static const uint32_t TRACE_VERSION = 1;
+  static const uint32_t PAD_RECORD = 0xffffffff;
+
+  /* file header, followed by num_of_rings times ring header and ring */
+  struct ctracefile {
+    char magic[8];
+    uint32_t version;
+    uint32_t num_of_rings;
+    uint64_t ring_size;
+    uint32_t snaplen;
+    uint32_t rings_used;
+    uint64_t drops;
+    uint8_t pad[24];
+  };
+
+  /* head and tail count bytes written since initialization */
+  struct ctracering {
+    uint64_t head;
+    uint64_t tail;
+    uint32_t tid;
+    uint8_t pad[44];
+  };
+
+  /* records are aligned to 8 bytes, pad records fill the ring's end */
+  struct ctracerecord {
+    uint32_t reclen;
+    uint32_t caplen;
+    uint64_t tstamp_nsec;
+    uint64_t connid;
+    uint32_t origlen;
+    uint8_t dir;
+    uint8_t auxid;
+    uint8_t pad[2];
+    uint8_t data[0];
+  };
+
+  static void record_slow(direction_t dir, uint64_t connid, uint8_t auxid,
+                          const uint8_t *buf, size_t buflen);
+
+  static uint8_t *get_ring();
+
+private:
+  static std::atomic_bool enabled;
+  static std::atomic_uint active;
+  static std::atomic_uint generation;
+  static pthread_mutex_t trace_mutex;
+  static uint8_t *area;
+  static size_t area_size;
+  static size_t ring_size;
+  static size_t snaplen;
+};
+
+}; // end of namespace rofl
+
+#endif /* SRC_ROFL_COMMON_CMSGTRACE_HPP_ */
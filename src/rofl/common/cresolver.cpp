@@ -0,0 +1,254 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cresolver.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#include "rofl/common/cresolver.hpp"
+
+#include <algorithm>
+
+using namespace rofl;
+
+/*static*/ pthread_mutex_t cresolver::mutex = PTHREAD_MUTEX_INITIALIZER;
+/*static*/ pthread_cond_t cresolver::cond = PTHREAD_COND_INITIALIZER;
+/*static*/ std::vector<pthread_t> cresolver::workers;
+/*static*/ std::deque<cresolver::ckey> cresolver::requests;
+/*static*/ std::map<cresolver::ckey, cresolver::centry> cresolver::cache;
+/*static*/ bool cresolver::running = false;
+/*static*/ time_t cresolver::positive_ttl = cresolver::DEFAULT_POSITIVE_TTL;
+/*static*/ time_t cresolver::negative_ttl = cresolver::DEFAULT_NEGATIVE_TTL;
+
+cresolver::ckey::ckey(const caddrinfos &ais)
+    : node(ais.get_node()), service(ais.get_service()),
+      flags(ais.get_ai_hints().get_ai_flags()),
+      family(ais.get_ai_hints().get_ai_family()),
+      socktype(ais.get_ai_hints().get_ai_socktype()),
+      protocol(ais.get_ai_hints().get_ai_protocol()) {}
+
+bool cresolver::ckey::operator<(const ckey &key) const {
+  if (node != key.node)
+    return (node < key.node);
+  if (service != key.service)
+    return (service < key.service);
+  if (flags != key.flags)
+    return (flags < key.flags);
+  if (family != key.family)
+    return (family < key.family);
+  if (socktype != key.socktype)
+    return (socktype < key.socktype);
+  return (protocol < key.protocol);
+}
+
+void cresolver::initialize(unsigned int num_of_workers, time_t positive_ttl,
+                           time_t negative_ttl) {
+  cresolver::terminate();
+
+  pthread_mutex_lock(&mutex);
+  cresolver::positive_ttl = positive_ttl;
+  cresolver::negative_ttl = negative_ttl;
+  try {
+    start_workers((num_of_workers > 0) ? num_of_workers : 1);
+  } catch (...) {
+    pthread_mutex_unlock(&mutex);
+    throw;
+  }
+  pthread_mutex_unlock(&mutex);
+}
+
+void cresolver::terminate() {
+  std::vector<pthread_t> joinable;
+
+  pthread_mutex_lock(&mutex);
+  running = false;
+  joinable.swap(workers);
+  pthread_cond_broadcast(&cond);
+  pthread_mutex_unlock(&mutex);
+
+  for (auto tid : joinable) {
+    pthread_join(tid, NULL);
+  }
+
+  pthread_mutex_lock(&mutex);
+  requests.clear();
+  cache.clear();
+  pthread_mutex_unlock(&mutex);
+}
+
+cresolver::lookup_result_t cresolver::lookup(caddrinfos &ais,
+                                             uint32_t thread_num,
+                                             cthread_env *env, int *error) {
+  ckey key(ais);
+
+  pthread_mutex_lock(&mutex);
+  auto it = cache.find(key);
+  if (it != cache.end()) {
+    centry &entry = it->second;
+    if (ENTRY_PENDING == entry.state) {
+      auto waiter = std::make_pair(thread_num, env);
+      if (env && std::find(entry.waiters.begin(), entry.waiters.end(),
+                           waiter) == entry.waiters.end()) {
+        entry.waiters.push_back(waiter);
+      }
+      pthread_mutex_unlock(&mutex);
+      return LOOKUP_PENDING;
+    }
+    if (not entry.expires.is_expired()) {
+      lookup_result_t result = LOOKUP_RESOLVED;
+      if (ENTRY_RESOLVED == entry.state) {
+        ais = entry.ais;
+      } else {
+        result = LOOKUP_FAILED;
+        if (error)
+          *error = entry.error;
+      }
+      pthread_mutex_unlock(&mutex);
+      return result;
+    }
+    cache.erase(it);
+  }
+  pthread_mutex_unlock(&mutex);
+
+  /* numeric hosts and services never query DNS */
+  caddrinfos numeric(ais);
+  numeric.set_ai_hints().set_ai_flags(key.flags | AI_NUMERICHOST |
+                                      AI_NUMERICSERV);
+  if (0 == numeric.try_resolve()) {
+    numeric.set_ai_hints().set_ai_flags(key.flags);
+    ais = numeric;
+    return LOOKUP_RESOLVED;
+  }
+
+  pthread_mutex_lock(&mutex);
+  auto rv = cache.emplace(key, centry());
+  centry &entry = rv.first->second;
+  if (rv.second) {
+    entry.state = ENTRY_PENDING;
+    entry.error = 0;
+    entry.ais = ais;
+    requests.push_back(key);
+    if (workers.empty()) {
+      try {
+        start_workers(DEFAULT_NUM_OF_WORKERS);
+      } catch (...) {
+        cache.erase(rv.first);
+        requests.pop_back();
+        pthread_mutex_unlock(&mutex);
+        throw;
+      }
+    }
+    pthread_cond_signal(&cond);
+  } else if (ENTRY_PENDING != entry.state) {
+    /* completed meanwhile by another thread */
+    pthread_mutex_unlock(&mutex);
+    return lookup(ais, thread_num, env, error);
+  }
+  if (env) {
+    entry.waiters.push_back(std::make_pair(thread_num, env));
+  }
+  pthread_mutex_unlock(&mutex);
+
+  return LOOKUP_PENDING;
+}
+
+void cresolver::cancel(cthread_env *env) {
+  pthread_mutex_lock(&mutex);
+  for (auto &it : cache) {
+    auto &waiters = it.second.waiters;
+    for (auto jt = waiters.begin(); jt != waiters.end();) {
+      if (jt->second == env) {
+        jt = waiters.erase(jt);
+      } else {
+        ++jt;
+      }
+    }
+  }
+  pthread_mutex_unlock(&mutex);
+}
+
+void cresolver::flush() {
+  pthread_mutex_lock(&mutex);
+  for (auto it = cache.begin(); it != cache.end();) {
+    if (ENTRY_PENDING != it->second.state) {
+      it = cache.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  pthread_mutex_unlock(&mutex);
+}
+
+void cresolver::start_workers(unsigned int num_of_workers) {
+  running = true;
+  for (unsigned int i = 0; i < num_of_workers; i++) {
+    pthread_t tid;
+    if (pthread_create(&tid, NULL, &(cresolver::start_worker), NULL) != 0) {
+      throw eSysCall("eSysCall", "pthread_create", __FILE__, __FUNCTION__,
+                     __LINE__);
+    }
+    pthread_setname_np(tid, "rofl-resolve");
+    workers.push_back(tid);
+  }
+}
+
+void *cresolver::start_worker(void *arg) {
+  std::vector<std::pair<uint32_t, cthread_env *>> waiters;
+
+  pthread_mutex_lock(&mutex);
+  while (true) {
+    while (running && requests.empty()) {
+      pthread_cond_wait(&cond, &mutex);
+    }
+    if (not running) {
+      break;
+    }
+
+    ckey key = requests.front();
+    requests.pop_front();
+    auto it = cache.find(key);
+    if (it == cache.end()) {
+      continue;
+    }
+    caddrinfos ais(it->second.ais);
+    pthread_mutex_unlock(&mutex);
+
+    int rc = ais.try_resolve();
+
+    pthread_mutex_lock(&mutex);
+    if ((it = cache.find(key)) == cache.end()) {
+      continue;
+    }
+    centry &entry = it->second;
+    if (0 == rc) {
+      entry.state = ENTRY_RESOLVED;
+      entry.ais = ais;
+      entry.expires = ctimens::expire_in(positive_ttl);
+    } else {
+      entry.state = ENTRY_FAILED;
+      entry.error = rc;
+      entry.expires = ctimens::expire_in(negative_ttl);
+    }
+    waiters.swap(entry.waiters);
+    pthread_mutex_unlock(&mutex);
+
+    /* deliver completion to all waiting environments */
+    for (auto &waiter : waiters) {
+      try {
+        cthread::thread(waiter.first).wakeup(waiter.second);
+      } catch (eThreadNotFound &e) {
+        /* thread has been stopped meanwhile */
+      }
+    }
+    waiters.clear();
+
+    pthread_mutex_lock(&mutex);
+  }
+  pthread_mutex_unlock(&mutex);
+
+  return NULL;
+}
@@ -0,0 +1,143 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cresolver.hpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#ifndef SRC_ROFL_COMMON_CRESOLVER_HPP_
+#define SRC_ROFL_COMMON_CRESOLVER_HPP_
+
+#include <deque>
+#include <map>
+#include <pthread.h>
+#include <string>
+#include <vector>
+
+#include "rofl/common/caddrinfos.h"
+#include "rofl/common/cthread.hpp"
+#include "rofl/common/ctimespec.hpp"
+
+namespace rofl {
+
+/**
+ * @brief	Asynchronous name resolution for cthread environments.
+ *
+ * lookup() never waits for DNS. Numeric addresses are converted inline
+ * and cached results are returned right away. All other names are handed
+ * to resolver worker threads running getaddrinfo(). When a name has been
+ * resolved, each cthread_env waiting for it receives a wakeup on its
+ * cthread and calls lookup() again to fetch the cached result.
+ *
+ * getaddrinfo() does not expose record TTLs, so results are cached for
+ * fixed periods: positive_ttl seconds for addresses, negative_ttl seconds
+ * for failures.
+ */
+class cresolver {
+public:
+  enum cresolver_defaults_t {
+    DEFAULT_NUM_OF_WORKERS = 2,
+    DEFAULT_POSITIVE_TTL = 60, // seconds
+    DEFAULT_NEGATIVE_TTL = 5,  // seconds
+  };
+
+  enum lookup_result_t {
+    LOOKUP_RESOLVED,
+    LOOKUP_FAILED,
+    LOOKUP_PENDING,
+  };
+
+  /**
+   * @brief	Start resolver threads and set cache lifetimes
+   *
+   * lookup() starts DEFAULT_NUM_OF_WORKERS threads on demand, if this
+   * method was not called before.
+   *
+   * @param num_of_workers number of resolver threads, at least one
+   * @param positive_ttl lifetime of resolved entries in seconds
+   * @param negative_ttl lifetime of failed entries in seconds
+   */
+  static void initialize(unsigned int num_of_workers = DEFAULT_NUM_OF_WORKERS,
+                         time_t positive_ttl = DEFAULT_POSITIVE_TTL,
+                         time_t negative_ttl = DEFAULT_NEGATIVE_TTL);
+
+  /**
+   * @brief	Stop and join all resolver threads and drop the cache
+   *
+   * Waits for getaddrinfo() calls in progress. Pending lookups are
+   * dropped without waking up their environments.
+   */
+  static void terminate();
+
+  /**
+   * @brief	Resolves node and service of ais without blocking
+   *
+   * @param ais node, service and hints to resolve, receives the result
+   * @param thread_num cthread delivering the completion wakeup
+   * @param env environment to wake up once a pending lookup completes,
+   * nullptr for polling
+   * @param error receives the getaddrinfo() error code on LOOKUP_FAILED
+   */
+  static lookup_result_t lookup(caddrinfos &ais, uint32_t thread_num,
+                                cthread_env *env, int *error = nullptr);
+
+  /**
+   * @brief	Stops waking up env for lookups in progress
+   */
+  static void cancel(cthread_env *env);
+
+  /**
+   * @brief	Drops all completed entries from the cache
+   */
+  static void flush();
+
+private:
+  struct ckey {
+    std::string node;
+    std::string service;
+    int flags;
+    int family;
+    int socktype;
+    int protocol;
+
+    ckey(const caddrinfos &ais);
+
+    bool operator<(const ckey &key) const;
+  };
+
+  enum centry_state_t {
+    ENTRY_PENDING,
+    ENTRY_RESOLVED,
+    ENTRY_FAILED,
+  };
+
+  struct centry {
+    centry_state_t state;
+    int error;
+    ctimens expires;
+    caddrinfos ais;
+    std::vector<std::pair<uint32_t, cthread_env *>> waiters;
+  };
+
+  static void start_workers(unsigned int num_of_workers);
+
+  static void *start_worker(void *arg);
+
+private:
+  static pthread_mutex_t mutex;
+  static pthread_cond_t cond;
+  static std::vector<pthread_t> workers;
+  static std::deque<ckey> requests;
+  static std::map<ckey, centry> cache;
+  static bool running;
+  static time_t positive_ttl;
+  static time_t negative_ttl;
+};
+
+}; // end of namespace rofl
+
+#endif /* SRC_ROFL_COMMON_CRESOLVER_HPP_ */
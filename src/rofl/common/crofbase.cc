@@ -28,6 +28,16 @@ crofbase::~crofbase() {
   close_dpt_socks();
   close_ctl_socks();
 
+  /* close connections waiting for admission */
+  {
+    AcquireReadWriteLock rwlock(admission_rwlock);
+    for (auto it : pending) {
+      ::close(it.first);
+    }
+    pending.clear();
+    negotiating.clear();
+  }
+
   /* close all crofdpt instances */
   __drop_dpts();
 
@@ -44,7 +54,10 @@ crofbase::~crofbase() {
 crofbase::crofbase()
     : thread_num(cthread::get_mgt_thread_num_from_pool()), state(STATE_RUNNING),
       generation_is_defined(false),
-      cached_generation_id((uint64_t)((int64_t)-1)), enforce_tls(false) {
+      cached_generation_id((uint64_t)((int64_t)-1)), enforce_tls(false),
+      max_negotiations(DEFAULT_ADMISSION_MAX_NEGOTIATIONS),
+      max_pending(DEFAULT_ADMISSION_MAX_PENDING), accept_stalled(false),
+      admission_dropped(0) {
   AcquireReadWriteLock rwlock(rofbases_rwlock);
   if (crofbase::rofbases.empty()) {
     crofbase::initialize();
@@ -60,7 +73,11 @@ void crofbase::initialize(uint32_t pool_max_num_threads) {
 }
 
 /*static*/
-void crofbase::terminate() { cthread::pool_terminate(); }
+void crofbase::terminate() {
+  cresolver::terminate();
+  cworkerpool::terminate();
+  cthread::pool_terminate();
+}
 
 void crofbase::role_request_rcvd(crofctl &ctl, uint32_t role,
                                  uint64_t rcvd_generation_id) {
@@ -205,6 +222,56 @@ void crofbase::send_port_status_message(const cauxid &auxid, uint8_t reason,
   }
 }
 
+size_t crofbase::send_packet_out_message(
+    const std::list<rofl::cdptid> &dptids, const cauxid &auxid,
+    uint32_t buffer_id, uint32_t in_port,
+    const rofl::openflow::cofactions &actions, uint8_t *data, size_t datalen) {
+  /* one packed image per OpenFlow version */
+  std::map<uint8_t, std::shared_ptr<const rofl::cmemory>> images;
+  size_t queued = 0;
+
+  AcquireReadLock rlock(rofdpts_rwlock);
+  for (auto dptid : dptids) {
+    auto it = rofdpts.find(dptid);
+    if (it == rofdpts.end()) {
+      continue;
+    }
+
+    crofdpt &dpt = *(it->second);
+
+    if (not dpt.is_established()) {
+      continue;
+    }
+
+    uint8_t version = dpt.get_version();
+
+    try {
+      if (images.find(version) == images.end()) {
+        rofl::openflow::cofmsg_packet_out msg(version, 0, buffer_id, in_port,
+                                              actions, data, datalen);
+        std::shared_ptr<rofl::cmemory> image =
+            std::make_shared<rofl::cmemory>(msg.length());
+        msg.pack(image->somem(), image->length());
+        images[version] = image;
+      }
+
+      rofl::crofsock::msg_result_t msg_result =
+          dpt.send_packet_out_message(auxid, images[version]);
+
+      if ((msg_result == rofl::crofsock::MSG_QUEUED) ||
+          (msg_result == rofl::crofsock::MSG_QUEUED_CONGESTION)) {
+        queued++;
+      }
+
+    } catch (rofl::exception &e) {
+      VLOG(1) << __FUNCTION__ << " dptid=" << dptid
+              << " dropping message: " << e.what();
+    }
+  }
+
+  return queued;
+}
+
 int crofbase::listen(const csockaddr &baddr) {
   int sd;
   int rc;
@@ -299,6 +366,12 @@ void crofbase::handle_timeout(cthread &thread, uint32_t timer_id) {
     }
     rofdpts_deletion.clear();
   } break;
+  case TIMER_ID_ADMISSION: {
+    admit_connections();
+  } break;
+  case TIMER_ID_ACCEPT_RETRY: {
+    accept_stalled_connections();
+  } break;
   default: {};
   }
 }
@@ -314,40 +387,7 @@ void crofbase::handle_read_event(cthread &thread, int fd) {
     if ((it = find_if(dpt_sockets.begin(), dpt_sockets.end(),
                       csocket_find_by_sock_descriptor(fd))) !=
         dpt_sockets.end()) {
-
-      while (true) {
-        rofl::csockaddr raddr;
-        int sockfd = 0;
-        /* extract new connection from listening queue */
-        if ((sockfd = ::accept(fd, raddr.ca_saddr, &(raddr.salen))) < 0) {
-          switch (errno) {
-          case EAGAIN: {
-            /* do nothing */
-            return;
-          } break;
-          default: {
-            throw eSysCall("eSysCall", "accept", __FILE__, __FUNCTION__,
-                           __LINE__);
-          };
-          }
-        }
-
-        if (enforce_tls) {
-          (new crofconn(this))
-              ->set_tls_capath(capath)
-              .set_tls_cafile(cafile)
-              .set_tls_certfile(certfile)
-              .set_tls_keyfile(keyfile)
-              .set_tls_pswd(password)
-              .set_tls_verify_mode(verify_mode)
-              .set_tls_verify_depth(verify_depth)
-              .set_tls_ciphers(ciphers)
-              .tls_accept(sockfd, versionbitmap, crofconn::MODE_CONTROLLER);
-        } else {
-          (new crofconn(this))
-              ->tcp_accept(sockfd, versionbitmap, crofconn::MODE_CONTROLLER);
-        }
-      }
+      accept_connections(fd, crofconn::MODE_CONTROLLER);
     }
   }
 
@@ -357,48 +397,184 @@ void crofbase::handle_read_event(cthread &thread, int fd) {
     if ((it = find_if(ctl_sockets.begin(), ctl_sockets.end(),
                       csocket_find_by_sock_descriptor(fd))) !=
         ctl_sockets.end()) {
+      accept_connections(fd, crofconn::MODE_DATAPATH);
+    }
+  }
 
-      while (true) {
-        rofl::csockaddr raddr;
-        int sockfd = 0;
-        /* extract new connection from listening queue */
-        if ((sockfd = ::accept(fd, raddr.ca_saddr, &(raddr.salen))) < 0) {
-          switch (errno) {
-          case EAGAIN: {
-            /* do nothing */
-            return;
-          } break;
-          default: {
-            throw eSysCall("eSysCall", "accept", __FILE__, __FUNCTION__,
-                           __LINE__);
-          };
-          }
+  admit_connections();
+}
+
+void crofbase::accept_connections(int fd,
+                                  enum crofconn::crofconn_mode_t mode) {
+  while (true) {
+    rofl::csockaddr raddr;
+    int sockfd = 0;
+    /* extract new connection from listening queue */
+    if ((sockfd = ::accept4(fd, raddr.ca_saddr, &(raddr.salen),
+                            SOCK_NONBLOCK | SOCK_CLOEXEC)) < 0) {
+      switch (errno) {
+      case EAGAIN: {
+        /* listening queue drained */
+        return;
+      } break;
+      case EINTR:
+      case ECONNABORTED: {
+        continue;
+      } break;
+      case EMFILE:
+      case ENFILE:
+      case ENOBUFS:
+      case ENOMEM: {
+        /* out of resources, pending connections remain in the listening
+         * queue and are accepted on a retry timer or once a negotiation
+         * slot has been released */
+        VLOG(1) << __FUNCTION__
+                << " unable to accept connection: " << strerror(errno);
+        {
+          AcquireReadWriteLock rwlock(admission_rwlock);
+          accept_stalled = true;
         }
+        if (not cthread::thread(thread_num)
+                    .has_timer(this, TIMER_ID_ACCEPT_RETRY)) {
+          cthread::thread(thread_num)
+              .add_timer(this, TIMER_ID_ACCEPT_RETRY,
+                         ctimens::expire_in(0, ACCEPT_RETRY_MSECS * 1000000));
+        }
+        return;
+      } break;
+      default: {
+        throw eSysCall("eSysCall", "accept4", __FILE__, __FUNCTION__,
+                       __LINE__);
+      };
+      }
+    }
+
+    AcquireReadWriteLock rwlock(admission_rwlock);
+    if ((max_pending > 0) && (pending.size() >= max_pending)) {
+      ::close(sockfd);
+      admission_dropped++;
+      VLOG(2) << __FUNCTION__ << " admission queue full, dropping connection"
+              << " raddr=" << raddr.str();
+      continue;
+    }
+    pending.push_back(std::make_pair(sockfd, mode));
+  }
+}
+
+void crofbase::accept_stalled_connections() {
+  if (delete_in_progress())
+    return;
+
+  {
+    AcquireReadWriteLock rwlock(admission_rwlock);
+    if (not accept_stalled)
+      return;
+    accept_stalled = false;
+  }
+
+  {
+    AcquireReadLock rlock(dpt_sockets_rwlock);
+    for (auto it : dpt_sockets) {
+      accept_connections(it.second, crofconn::MODE_CONTROLLER);
+    }
+  }
+
+  {
+    AcquireReadLock rlock(ctl_sockets_rwlock);
+    for (auto it : ctl_sockets) {
+      accept_connections(it.second, crofconn::MODE_DATAPATH);
+    }
+  }
 
-        if (enforce_tls) {
-          (new crofconn(this))
-              ->set_tls_capath(capath)
-              .set_tls_cafile(cafile)
-              .set_tls_certfile(certfile)
-              .set_tls_keyfile(keyfile)
-              .set_tls_pswd(password)
-              .set_tls_verify_mode(verify_mode)
-              .set_tls_verify_depth(verify_depth)
-              .set_tls_ciphers(ciphers)
-              .tls_accept(sockfd, versionbitmap, crofconn::MODE_DATAPATH);
-        } else {
-          (new crofconn(this))
-              ->tcp_accept(sockfd, versionbitmap, crofconn::MODE_DATAPATH);
+  admit_connections();
+}
+
+void crofbase::sock_accept(int sockfd, enum crofconn::crofconn_mode_t mode) {
+  {
+    AcquireReadWriteLock rwlock(admission_rwlock);
+    pending.push_back(std::make_pair(sockfd, mode));
+  }
+  /* admit queued connections from within the management thread */
+  cthread::thread(thread_num)
+      .add_timer(this, TIMER_ID_ADMISSION, ctimens::expire_in(0, 0));
+}
+
+void crofbase::admit_connections() {
+  while (not delete_in_progress()) {
+    int sockfd = 0;
+    enum crofconn::crofconn_mode_t mode;
+    crofconn *conn = nullptr;
+
+    {
+      AcquireReadWriteLock rwlock(admission_rwlock);
+      if (pending.empty())
+        return;
+
+      /* resumed when a negotiation in progress has finished */
+      if ((max_negotiations > 0) && (negotiating.size() >= max_negotiations))
+        return;
+
+      if (not admission_bucket.consume()) {
+        if (not cthread::thread(thread_num).has_timer(this,
+                                                      TIMER_ID_ADMISSION)) {
+          unsigned int msecs = admission_bucket.get_wait_msecs();
+          cthread::thread(thread_num)
+              .add_timer(this, TIMER_ID_ADMISSION,
+                         ctimens::expire_in(msecs / 1000,
+                                            (msecs % 1000) * 1000000));
         }
+        return;
       }
+
+      sockfd = pending.front().first;
+      mode = pending.front().second;
+      pending.pop_front();
+
+      conn = new crofconn(this);
+      negotiating.insert(conn);
+    }
+
+    /* conn may call back synchronously, so admission_rwlock is released */
+    if (enforce_tls) {
+      conn->set_tls_capath(capath)
+          .set_tls_cafile(cafile)
+          .set_tls_certfile(certfile)
+          .set_tls_keyfile(keyfile)
+          .set_tls_pswd(password)
+          .set_tls_verify_mode(verify_mode)
+          .set_tls_verify_depth(verify_depth)
+          .set_tls_ciphers(ciphers)
+          .tls_accept(sockfd, versionbitmap, mode);
+    } else {
+      conn->tcp_accept(sockfd, versionbitmap, mode);
+    }
+  }
+}
+
+void crofbase::release_connection(crofconn &conn) {
+  {
+    AcquireReadWriteLock rwlock(admission_rwlock);
+    if (negotiating.erase(&conn) == 0)
+      return;
+    if (accept_stalled) {
+      /* a failed negotiation may have freed resources for accept4() */
+      cthread::thread(thread_num)
+          .add_timer(this, TIMER_ID_ACCEPT_RETRY, ctimens::expire_in(0, 0));
+      return;
     }
+    if (pending.empty())
+      return;
   }
+  /* admit queued connections from within the management thread */
+  cthread::thread(thread_num)
+      .add_timer(this, TIMER_ID_ADMISSION, ctimens::expire_in(0, 0));
 }
 
 void crofbase::handle_established(crofconn &conn, uint8_t ofp_version) {
   if (delete_in_progress())
     return;
   /* openflow connection has been established */
+  release_connection(conn);
 
   switch (conn.get_mode()) {
   case crofconn::MODE_CONTROLLER: {
@@ -459,18 +635,21 @@ void crofbase::handle_established(crofconn &conn, uint8_t ofp_version) {
 void crofbase::handle_accept_failed(crofconn &conn) {
   if (delete_in_progress())
     return;
+  release_connection(conn);
   delete &conn;
 }
 
 void crofbase::handle_negotiation_failed(crofconn &conn) {
   if (delete_in_progress())
     return;
+  release_connection(conn);
   delete &conn;
 }
 
 void crofbase::handle_closed(crofconn &conn) {
   if (delete_in_progress())
     return;
+  release_connection(conn);
   delete &conn;
 }
 
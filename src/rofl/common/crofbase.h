@@ -13,7 +13,11 @@
 #ifndef CROFBASE_H
 #define CROFBASE_H 1
 
+#include <deque>
 #include <glog/logging.h>
+#include <list>
+#include <map>
+#include <memory>
 #include <vector>
 
 #include "rofl/common/exception.hpp"
@@ -23,6 +27,8 @@
 #include "rofl/common/crofctl.h"
 #include "rofl/common/crofdpt.h"
 #include "rofl/common/cthread.hpp"
+#include "rofl/common/cworkerpool.hpp"
+#include "rofl/common/ctokenbucket.hpp"
 #include "rofl/common/openflow/cofhelloelemversionbitmap.h"
 #include "rofl/common/openflow/openflow.h"
 
@@ -189,6 +195,86 @@ public:
     return *this;
   };
 
+public:
+  /**
+   * @name	Admission control for accepted connections
+   *
+   * Connections accepted on listening sockets are queued and admitted to
+   * the OpenFlow handshake subject to a rate limit and a limit on the
+   * number of connections in TCP/TLS/HELLO negotiation. This bounds the
+   * work spent on new peers during a connect storm, so that I/O threads
+   * keep serving echo and other traffic of established connections.
+   */
+
+  /**@{*/
+
+  /**
+   * @brief	Sets rate of admitted connections per second and burst size.
+   *
+   * A rate of 0 disables rate limiting (default).
+   */
+  crofbase &set_admission_rate(double rate, double burst = 1) {
+    admission_bucket.set_rate(rate, burst);
+    return *this;
+  };
+
+  /**
+   *
+   */
+  double get_admission_rate() const { return admission_bucket.get_rate(); };
+
+  /**
+   * @brief	Sets maximum number of connections in negotiation, 0: unlimited
+   */
+  crofbase &set_admission_max_negotiations(unsigned int max_negotiations) {
+    this->max_negotiations = max_negotiations;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  unsigned int get_admission_max_negotiations() const {
+    return max_negotiations;
+  };
+
+  /**
+   * @brief	Sets maximum number of accepted connections waiting for
+   * admission, excess connections are closed, 0: unlimited
+   */
+  crofbase &set_admission_max_pending(unsigned int max_pending) {
+    this->max_pending = max_pending;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  unsigned int get_admission_max_pending() const { return max_pending; };
+
+  /**
+   * @brief	Returns number of accepted connections waiting for admission
+   */
+  size_t get_admission_pending() const {
+    AcquireReadLock rlock(admission_rwlock);
+    return pending.size();
+  };
+
+  /**
+   * @brief	Returns number of admitted connections in negotiation
+   */
+  size_t get_admission_negotiating() const {
+    AcquireReadLock rlock(admission_rwlock);
+    return negotiating.size();
+  };
+
+  /**
+   * @brief	Returns number of accepted connections closed due to overload
+   */
+  uint64_t get_admission_dropped() const { return admission_dropped; };
+
+  /**@}*/
+
 public:
   /**
    * @name	Methods for listening sockets accepting connections from
@@ -256,6 +342,20 @@ public:
     return (not(dpt_sockets.find(baddr) == dpt_sockets.end()));
   };
 
+  /**
+   * @brief	Admits an already connected socket as datapath connection.
+   *
+   * The socket passes admission control like connections accepted on
+   * listening sockets created by dpt_sock_listen(), e.g., one end of a
+   * socketpair for replaying recorded traffic. Ownership of sockfd is
+   * transferred to this rofl::crofbase instance.
+   *
+   * @param sockfd connected stream socket
+   */
+  void dpt_sock_accept(int sockfd) {
+    sock_accept(sockfd, crofconn::MODE_CONTROLLER);
+  };
+
   /**@}*/
 
 public:
@@ -326,6 +426,17 @@ public:
     return (not(ctl_sockets.find(baddr) == ctl_sockets.end()));
   };
 
+  /**
+   * @brief	Admits an already connected socket as controller connection.
+   *
+   * See dpt_sock_accept() for details.
+   *
+   * @param sockfd connected stream socket
+   */
+  void ctl_sock_accept(int sockfd) {
+    sock_accept(sockfd, crofconn::MODE_DATAPATH);
+  };
+
   /**@}*/
 
 public:
@@ -367,7 +478,7 @@ public:
     if (not cthread::thread(thread_num)
                 .has_timer(this, TIMER_ID_ROFDPT_DESTROY)) {
       cthread::thread(thread_num)
-          .add_timer(this, TIMER_ID_ROFDPT_DESTROY, ctimespec().expire_in(60));
+          .add_timer(this, TIMER_ID_ROFDPT_DESTROY, ctimens::expire_in(60));
     }
   };
 
@@ -501,7 +612,7 @@ public:
     if (not cthread::thread(thread_num)
                 .has_timer(this, TIMER_ID_ROFDPT_DESTROY)) {
       cthread::thread(thread_num)
-          .add_timer(this, TIMER_ID_ROFDPT_DESTROY, ctimespec().expire_in(60));
+          .add_timer(this, TIMER_ID_ROFDPT_DESTROY, ctimens::expire_in(60));
     }
     return true;
   };
@@ -611,7 +722,7 @@ public:
     if (not cthread::thread(thread_num)
                 .has_timer(this, TIMER_ID_ROFCTL_DESTROY)) {
       cthread::thread(thread_num)
-          .add_timer(this, TIMER_ID_ROFCTL_DESTROY, ctimespec().expire_in(60));
+          .add_timer(this, TIMER_ID_ROFCTL_DESTROY, ctimens::expire_in(60));
     }
   };
 
@@ -744,7 +855,7 @@ public:
     if (not cthread::thread(thread_num)
                 .has_timer(this, TIMER_ID_ROFCTL_DESTROY)) {
       cthread::thread(thread_num)
-          .add_timer(this, TIMER_ID_ROFCTL_DESTROY, ctimespec().expire_in(60));
+          .add_timer(this, TIMER_ID_ROFCTL_DESTROY, ctimens::expire_in(60));
     }
     return true;
   };
@@ -851,6 +962,40 @@ public:
 
   /**@}*/
 
+public:
+  /**
+   * @name	Methods for sending messages towards a group of datapath
+   * elements.
+   */
+
+  /**@{*/
+
+  /**
+   * @brief	Sends the same OpenFlow Packet-Out message to a group of
+   * datapath elements.
+   *
+   * The message is encoded once per negotiated OpenFlow version and the
+   * resulting image is shared among all datapath elements. Datapath
+   * elements not found or without an established control channel are
+   * skipped, as are those failing to queue the message.
+   *
+   * @param dptids internal datapath handles (not DPID)
+   * @param auxid controller connection identifier
+   * @param buffer_id OpenFlow packet buffer identifier
+   * @param in_port incoming port for OpenFlow matches
+   * @param actions OpenFlow actions list
+   * @param data start of packet frame
+   * @param datalen length of packet frame
+   * @return number of datapath elements the message was queued for
+   */
+  size_t send_packet_out_message(const std::list<rofl::cdptid> &dptids,
+                                 const rofl::cauxid &auxid, uint32_t buffer_id,
+                                 uint32_t in_port,
+                                 const rofl::openflow::cofactions &actions,
+                                 uint8_t *data = NULL, size_t datalen = 0);
+
+  /**@}*/
+
 public:
   /**
    * @name	Auxiliary methods
@@ -1326,6 +1471,19 @@ public:
   virtual void handle_flow_stats_reply_timeout(rofl::crofdpt &dpt,
                                                uint32_t xid){};
 
+  /**
+   * @brief	Reconciliation of shadow flow table has finished.
+   *
+   * @param dpt datapath instance
+   * @param auxid control connection identifier
+   * @param num_delta number of Flow-Mods required for reconciliation
+   * @param num_queued number of Flow-Mods queued for transmission
+   */
+  virtual void handle_flow_table_reconciled(rofl::crofdpt &dpt,
+                                            const rofl::cauxid &auxid,
+                                            size_t num_delta,
+                                            size_t num_queued){};
+
   /**
    * @brief	OpenFlow Aggregate-Stats-Reply message received.
    *
@@ -1600,6 +1758,33 @@ public:
   virtual void handle_experimenter_stats_reply_timeout(rofl::crofdpt &dpt,
                                                        uint32_t xid){};
 
+  /**
+   * @brief	OpenFlow Flow-Monitor-Reply message received.
+   *
+   * Carries the flows initially matching a new flow monitor as well as
+   * unsolicited add/modify/delete updates sent by the datapath afterwards.
+   *
+   * @param dpt datapath instance
+   * @param auxid control connection identifier
+   * @param msg OpenFlow message instance
+   */
+  virtual void
+  handle_flow_monitor_reply(rofl::crofdpt &dpt, const rofl::cauxid &auxid,
+                            rofl::openflow::cofmsg_flow_monitor_reply &msg){};
+
+  /**
+   * @brief	Timer expired while waiting for OpenFlow Flow-Monitor-Reply
+   * message.
+   *
+   * No Flow-Monitor-Reply message was received in the specified time
+   * interval for the given OpenFlow transaction identifier.
+   *
+   * @param dpt datapath instance
+   * @param xid OpenFlow transaction identifier
+   */
+  virtual void handle_flow_monitor_reply_timeout(rofl::crofdpt &dpt,
+                                                 uint32_t xid){};
+
   /**
    * @brief	OpenFlow Packet-In message received.
    *
@@ -1632,6 +1817,56 @@ public:
    */
   virtual void handle_barrier_reply_timeout(rofl::crofdpt &dpt, uint32_t xid){};
 
+  /**
+   * @brief	OpenFlow Bundle-Control message received.
+   *
+   * @param dpt datapath instance
+   * @param auxid control connection identifier
+   * @param msg OpenFlow message instance
+   */
+  virtual void
+  handle_bundle_control_reply(rofl::crofdpt &dpt, const rofl::cauxid &auxid,
+                              rofl::openflow::cofmsg_bundle_control &msg){};
+
+  /**
+   * @brief	Timer expired while waiting for OpenFlow Bundle-Control reply.
+   *
+   * @param dpt datapath instance
+   * @param xid OpenFlow transaction identifier
+   */
+  virtual void handle_bundle_control_reply_timeout(rofl::crofdpt &dpt,
+                                                   uint32_t xid){};
+
+  /**
+   * @brief	Bundle sent via crofdpt::send_bundle() has been committed.
+   *
+   * @param dpt datapath instance
+   * @param auxid control connection identifier
+   * @param bundle_id OpenFlow bundle identifier
+   */
+  virtual void handle_bundle_committed(rofl::crofdpt &dpt,
+                                       const rofl::cauxid &auxid,
+                                       uint32_t bundle_id){};
+
+  /**
+   * @brief	Bundle sent via crofdpt::send_bundle() has failed.
+   *
+   * Called for the first Error message referring to one of the bundle's
+   * messages or when the Open- or Commit-Request timed out (type
+   * OFPET_BUNDLE_FAILED, code OFPBFC_TIMEOUT). The Error message itself
+   * is delivered via handle_error_message() as well.
+   *
+   * @param dpt datapath instance
+   * @param auxid control connection identifier
+   * @param bundle_id OpenFlow bundle identifier
+   * @param err_type OpenFlow error type
+   * @param err_code OpenFlow error code
+   */
+  virtual void handle_bundle_failed(rofl::crofdpt &dpt,
+                                    const rofl::cauxid &auxid,
+                                    uint32_t bundle_id, uint16_t err_type,
+                                    uint16_t err_code){};
+
   /**
    * @brief	OpenFlow Flow-Removed message received.
    *
@@ -1653,6 +1888,27 @@ public:
   virtual void handle_port_status(rofl::crofdpt &dpt, const rofl::cauxid &auxid,
                                   rofl::openflow::cofmsg_port_status &msg){};
 
+  /**
+   * @brief	OpenFlow Role-Status message received (OpenFlow 1.4 and beyond).
+   *
+   * @param dpt datapath instance
+   * @param auxid control connection identifier
+   * @param msg OpenFlow message instance
+   */
+  virtual void handle_role_status(rofl::crofdpt &dpt, const rofl::cauxid &auxid,
+                                  rofl::openflow::cofmsg_role_status &msg){};
+
+  /**
+   * @brief	OpenFlow Table-Status message received (OpenFlow 1.4 and beyond).
+   *
+   * @param dpt datapath instance
+   * @param auxid control connection identifier
+   * @param msg OpenFlow message instance
+   */
+  virtual void handle_table_status(rofl::crofdpt &dpt,
+                                   const rofl::cauxid &auxid,
+                                   rofl::openflow::cofmsg_table_status &msg){};
+
   /**
    * @brief	OpenFlow Queue-Get-Config-Reply message received.
    *
@@ -1985,6 +2241,17 @@ public:
       rofl::crofctl &ctl, const rofl::cauxid &auxid,
       rofl::openflow::cofmsg_experimenter_stats_request &msg){};
 
+  /**
+   * @brief	OpenFlow Flow-Monitor-Request message received.
+   *
+   * @param ctl controller instance
+   * @param auxid control connection identifier
+   * @param msg OpenFlow message instance
+   */
+  virtual void handle_flow_monitor_request(
+      rofl::crofctl &ctl, const rofl::cauxid &auxid,
+      rofl::openflow::cofmsg_flow_monitor_request &msg){};
+
   /**
    * @brief	OpenFlow Packet-Out message received.
    *
@@ -2143,6 +2410,28 @@ public:
   virtual void handle_meter_mod(rofl::crofctl &ctl, const rofl::cauxid &auxid,
                                 rofl::openflow::cofmsg_meter_mod &msg){};
 
+  /**
+   * @brief	OpenFlow Bundle-Control message received.
+   *
+   * @param ctl controller instance
+   * @param auxid control connection identifier
+   * @param msg OpenFlow message instance
+   */
+  virtual void
+  handle_bundle_control(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                        rofl::openflow::cofmsg_bundle_control &msg){};
+
+  /**
+   * @brief	OpenFlow Bundle-Add-Message message received.
+   *
+   * @param ctl controller instance
+   * @param auxid control connection identifier
+   * @param msg OpenFlow message instance
+   */
+  virtual void
+  handle_bundle_add_message(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                            rofl::openflow::cofmsg_bundle_add_message &msg){};
+
   /**@}*/
 
 public:
@@ -2263,6 +2552,35 @@ private:
    */
   int listen(const csockaddr &baddr);
 
+  /**
+   * @brief	Accepts all connections pending on listening socket fd
+   */
+  void accept_connections(int fd, enum crofconn::crofconn_mode_t mode);
+
+  /**
+   * @brief	Accepts connections pending on all listening sockets
+   *
+   * Listening sockets are registered edge-triggered, so connections left
+   * in the kernel backlog after running out of descriptors or memory do
+   * not raise another read event.
+   */
+  void accept_stalled_connections();
+
+  /**
+   * @brief	Queues a connected socket for admission
+   */
+  void sock_accept(int sockfd, enum crofconn::crofconn_mode_t mode);
+
+  /**
+   * @brief	Starts negotiation for queued connections if admissible
+   */
+  void admit_connections();
+
+  /**
+   * @brief	Releases the negotiation slot occupied by conn
+   */
+  void release_connection(crofconn &conn);
+
   /**
    * @brief Check for state delete in progress
    */
@@ -2297,6 +2615,8 @@ private:
   enum crofbase_timer_t {
     TIMER_ID_ROFCTL_DESTROY,
     TIMER_ID_ROFDPT_DESTROY,
+    TIMER_ID_ADMISSION,
+    TIMER_ID_ACCEPT_RETRY,
   };
 
   // management thread
@@ -2362,6 +2682,38 @@ private:
   std::string verify_mode;
   std::string verify_depth;
   std::string ciphers;
+
+  /*
+   *
+   */
+
+  static const unsigned int DEFAULT_ADMISSION_MAX_NEGOTIATIONS = 1024;
+  static const unsigned int DEFAULT_ADMISSION_MAX_PENDING = 4096;
+  static const unsigned int ACCEPT_RETRY_MSECS = 100;
+
+  // rate limiter for admitted connections
+  ctokenbucket admission_bucket;
+
+  // maximum number of connections in negotiation
+  unsigned int max_negotiations;
+
+  // maximum number of accepted connections waiting for admission
+  unsigned int max_pending;
+
+  // accepted socket descriptors waiting for admission
+  std::deque<std::pair<int, enum crofconn::crofconn_mode_t>> pending;
+
+  // admitted connections in negotiation
+  std::set<crofconn *> negotiating;
+
+  // accept4() ran out of resources, backlog not drained
+  bool accept_stalled;
+
+  // lock for pending, negotiating and accept_stalled
+  mutable crwlock admission_rwlock;
+
+  // accepted connections closed due to overload
+  std::atomic<uint64_t> admission_dropped;
 };
 
 }; // end of namespace
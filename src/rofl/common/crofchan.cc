@@ -75,3 +75,54 @@ rofl::crofsock::msg_result_t crofchan::send_message(const cauxid &auxid,
   }
   return conns[auxid]->send_message(msg, ts);
 }
+
+rofl::crofsock::msg_result_t
+crofchan::try_send_message(const cauxid &auxid, rofl::openflow::cofmsg *msg) {
+  AcquireReadLock rwlock(conns_rwlock);
+  crofconn *conn = find_established_conn(auxid);
+  if (nullptr == conn) {
+    delete msg;
+    return rofl::crofsock::MSG_QUEUEING_FAILED_NOT_ESTABLISHED;
+  }
+  return conn->send_message(msg);
+}
+
+rofl::crofsock::msg_result_t
+crofchan::try_send_message(const cauxid &auxid, rofl::openflow::cofmsg *msg,
+                           const ctimespec &ts) {
+  AcquireReadLock rwlock(conns_rwlock);
+  crofconn *conn = find_established_conn(auxid);
+  if (nullptr == conn) {
+    delete msg;
+    return rofl::crofsock::MSG_QUEUEING_FAILED_NOT_ESTABLISHED;
+  }
+  return conn->send_message(msg, ts);
+}
+
+size_t
+crofchan::get_txqueue_capacity(const cauxid &auxid,
+                               crofsock::outqueue_type_t queue_id) const {
+  AcquireReadLock rwlock(conns_rwlock);
+  crofconn *conn = find_established_conn(auxid);
+  if (nullptr == conn) {
+    eRofConnNotConnected e(
+        "crofchan::get_txqueue_capacity() connection not established");
+    e.set_func(__FUNCTION__).set_line(__LINE__).set_key("auxid", auxid.str());
+    throw e;
+  }
+  return conn->get_txqueue_capacity(queue_id);
+}
+
+crofconn *crofchan::find_established_conn(const cauxid &auxid) const {
+  std::map<cauxid, crofconn *>::const_iterator it = conns.find(cauxid(0));
+  if ((it == conns.end()) || (not it->second->is_established())) {
+    return nullptr;
+  }
+  if (not(auxid == cauxid(0))) {
+    it = conns.find(auxid);
+    if ((it == conns.end()) || (not it->second->is_established())) {
+      return nullptr;
+    }
+  }
+  return it->second;
+}
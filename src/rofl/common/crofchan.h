@@ -182,6 +182,32 @@ public:
                                             rofl::openflow::cofmsg *msg,
                                             const ctimespec &ts);
 
+  /**
+   * @brief	Non-throwing variant of send_message()
+   *
+   * The message is consumed in any case. When the channel or the
+   * connection for auxid is not established, msg is deleted and
+   * MSG_QUEUEING_FAILED_NOT_ESTABLISHED is returned.
+   */
+  rofl::crofsock::msg_result_t try_send_message(const cauxid &auxid,
+                                                rofl::openflow::cofmsg *msg);
+
+  /**
+   * @brief	Non-throwing variant of send_message() with timeout
+   */
+  rofl::crofsock::msg_result_t try_send_message(const cauxid &auxid,
+                                                rofl::openflow::cofmsg *msg,
+                                                const ctimespec &ts);
+
+  /**
+   * @brief	Returns number of messages a txqueue of connection auxid may
+   * still accept
+   *
+   * @exception rofl::eRofConnNotConnected connection not established
+   */
+  size_t get_txqueue_capacity(const cauxid &auxid,
+                              crofsock::outqueue_type_t queue_id) const;
+
 public:
   /**
    *
@@ -242,7 +268,7 @@ public:
     if (not cthread::thread(thread_num)
                 .has_timer(this, TIMER_ID_ROFCONN_DESTROY)) {
       cthread::thread(thread_num)
-          .add_timer(this, TIMER_ID_ROFCONN_DESTROY, ctimespec().expire_in(8));
+          .add_timer(this, TIMER_ID_ROFCONN_DESTROY, ctimens::expire_in(8));
     }
     state = STATE_DISCONNECTED;
   };
@@ -300,8 +326,7 @@ public:
       if (not cthread::thread(thread_num)
                   .has_timer(this, TIMER_ID_ROFCONN_DESTROY)) {
         cthread::thread(thread_num)
-            .add_timer(this, TIMER_ID_ROFCONN_DESTROY,
-                       ctimespec().expire_in(8));
+            .add_timer(this, TIMER_ID_ROFCONN_DESTROY, ctimens::expire_in(8));
       }
     }
     (conns[auxid] = conn)->set_env(this);
@@ -379,7 +404,7 @@ public:
     if (not cthread::thread(thread_num)
                 .has_timer(this, TIMER_ID_ROFCONN_DESTROY)) {
       cthread::thread(thread_num)
-          .add_timer(this, TIMER_ID_ROFCONN_DESTROY, ctimespec().expire_in(8));
+          .add_timer(this, TIMER_ID_ROFCONN_DESTROY, ctimens::expire_in(8));
     }
     return true;
   };
@@ -517,7 +542,7 @@ private:
                       .has_timer(this, TIMER_ID_ROFCONN_DESTROY)) {
             cthread::thread(thread_num)
                 .add_timer(this, TIMER_ID_ROFCONN_DESTROY,
-                           ctimespec().expire_in(60));
+                           ctimens::expire_in(60));
           }
         }
         for (auto auxid : to_be_removed) {
@@ -544,7 +569,7 @@ private:
                     .has_timer(this, TIMER_ID_ROFCONN_DESTROY)) {
           cthread::thread(thread_num)
               .add_timer(this, TIMER_ID_ROFCONN_DESTROY,
-                         ctimespec().expire_in(60));
+                         ctimens::expire_in(60));
         }
       }
       crofchan_env::call_env(env).handle_closed(*this, conn);
@@ -634,6 +659,12 @@ private:
   };
 
 private:
+  /**
+   * @brief	Returns connection auxid, if it and the main connection are
+   * established, nullptr otherwise; conns_rwlock must be held
+   */
+  crofconn *find_established_conn(const cauxid &auxid) const;
+
   /**
    * @brief Check for state delete in progress
    */
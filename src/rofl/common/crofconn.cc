@@ -25,6 +25,9 @@ using namespace rofl;
 /*static*/ const time_t crofconn::DEFAULT_LIFECHECK_TIMEOUT = 1;
 /*static*/ const time_t crofconn::DEFAULT_SEGMENTS_TIMEOUT = 60;
 /*static*/ const unsigned int crofconn::DEFAULT_PENDING_SEGMENTS_MAX = 256;
+/*static*/ std::atomic_bool crofconn::rx_profiling(false);
+/*static*/ struct crofconn::crxprofile
+    crofconn::rxprofiles[crofconn::RXPROFILE_MAX];
 
 crofconn::~crofconn() {
   flag_set(FLAG_DELETE_IN_PROGRESS, true);
@@ -57,7 +60,10 @@ crofconn::crofconn(crofconn_env *env)
   /* set maximum queue size */
   for (unsigned int queue_id = 0; queue_id < QUEUE_MAX; queue_id++) {
     rxqueues[queue_id].set_queue_max_size(rxqueue_max_size);
+    rxpolicies[queue_id] = RXQUEUE_POLICY_BACKPRESSURE;
+    rxdrops[queue_id] = 0;
   }
+  rxpolicy_pkt_set = false;
   VLOG(5) << __FUNCTION__ << " "
           << "thread: " << cthread::thread(thread_num).get_thread_name();
 }
@@ -82,6 +88,26 @@ void crofconn::tcp_connect(
   rofsock.tcp_connect(reconnect);
 };
 
+void crofconn::mem_accept(
+    std::shared_ptr<cmemchannel> channel, cmemchannel::side_t side,
+    const rofl::openflow::cofhello_elem_versionbitmap &versionbitmap,
+    enum crofconn_mode_t mode) {
+  set_versionbitmap(versionbitmap);
+  set_mode(mode);
+  run_finite_state_machine(STATE_ACCEPT_PENDING);
+  rofsock.mem_accept(channel, side);
+};
+
+void crofconn::mem_connect(
+    std::shared_ptr<cmemchannel> channel, cmemchannel::side_t side,
+    const rofl::openflow::cofhello_elem_versionbitmap &versionbitmap,
+    enum crofconn_mode_t mode) {
+  set_versionbitmap(versionbitmap);
+  set_mode(mode);
+  run_finite_state_machine(STATE_CONNECT_PENDING);
+  rofsock.mem_connect(channel, side);
+};
+
 void crofconn::tls_accept(
     int sd, const rofl::openflow::cofhello_elem_versionbitmap &versionbitmap,
     enum crofconn_mode_t mode) {
@@ -231,7 +257,7 @@ void crofconn::run_finite_state_machine(enum crofconn_state_t new_state) {
         if (not flag_hello_rcvd) {
           cthread::thread(thread_num)
               .add_timer(this, TIMER_ID_WAIT_FOR_HELLO,
-                         ctimespec().expire_in(timeout_hello));
+                         ctimens::expire_in(timeout_hello));
         }
         if (not flag_hello_sent) {
           send_hello_message();
@@ -256,7 +282,7 @@ void crofconn::run_finite_state_machine(enum crofconn_state_t new_state) {
         /* start periodic checks for connection state (OAM) */
         cthread::thread(thread_num)
             .add_timer(this, TIMER_ID_NEED_LIFE_CHECK,
-                       ctimespec().expire_in(timeout_lifecheck));
+                       ctimens::expire_in(timeout_lifecheck));
         calls.push_back(STATE_ESTABLISHED);
 
       } break;
@@ -280,6 +306,8 @@ void crofconn::run_finite_state_machine(enum crofconn_state_t new_state) {
       } break;
       case STATE_ESTABLISHED: {
         crofconn_env::call_env(env).handle_established(*this, ofp_version);
+        /* deliver messages stored while negotiating */
+        cthread::thread(thread_num).wakeup(this);
       } break;
       case STATE_DISCONNECTED: {
         crofconn_env::call_env(env).handle_closed(*this);
@@ -606,7 +634,7 @@ void crofconn::send_features_request() {
   try {
     cthread::thread(thread_num)
         .add_timer(this, TIMER_ID_WAIT_FOR_FEATURES,
-                   ctimespec().expire_in(timeout_features));
+                   ctimens::expire_in(timeout_features));
 
     rofl::openflow::cofmsg_features_request *msg =
         new rofl::openflow::cofmsg_features_request(
@@ -676,13 +704,13 @@ void crofconn::send_echo_request() {
               << " raddr=" << rofsock.get_raddr().str();
       cthread::thread(thread_num)
           .add_timer(this, TIMER_ID_NEED_LIFE_CHECK,
-                     ctimespec().expire_in(timeout_lifecheck));
+                     ctimens::expire_in(timeout_lifecheck));
       return;
     }
 
     cthread::thread(thread_num)
         .add_timer(this, TIMER_ID_WAIT_FOR_ECHO,
-                   ctimespec().expire_in(timeout_echo));
+                   ctimens::expire_in(timeout_echo));
 
     rofl::openflow::cofmsg_echo_request *msg =
         new rofl::openflow::cofmsg_echo_request(ofp_version,
@@ -714,7 +742,7 @@ void crofconn::echo_reply_rcvd(rofl::openflow::cofmsg *pmsg) {
 
     cthread::thread(thread_num)
         .add_timer(this, TIMER_ID_NEED_LIFE_CHECK,
-                   ctimespec().expire_in(timeout_lifecheck));
+                   ctimens::expire_in(timeout_lifecheck));
 
   } catch (std::runtime_error &e) {
     VLOG(5) << __FUNCTION__ << " runtime error: " << e.what()
@@ -794,6 +822,11 @@ void crofconn::handle_tcp_connected(crofsock &rofsock) {
     VLOG(2) << __FUNCTION__
             << " socket indicates TCP connection -connect- established";
 
+    /* a Hello from our peer may have been processed by crofsock's
+     * RX thread already, see crofconn::handle_recv() */
+    if (STATE_CONNECT_PENDING != get_state())
+      return;
+
     run_finite_state_machine(STATE_NEGOTIATING);
 
   } catch (eRofConnNotFound &e) {
@@ -830,6 +863,11 @@ void crofconn::handle_tcp_accepted(crofsock &socket) {
     VLOG(2) << __FUNCTION__
             << " socket indicates TCP connection -accept- established";
 
+    /* a Hello from our peer may have been processed by crofsock's
+     * RX thread already, see crofconn::handle_recv() */
+    if (STATE_ACCEPT_PENDING != get_state())
+      return;
+
     run_finite_state_machine(STATE_NEGOTIATING);
 
   } catch (eRofConnNotFound &e) {
@@ -855,6 +893,11 @@ void crofconn::handle_tls_connected(crofsock &socket) {
     VLOG(2) << __FUNCTION__
             << " socket indicates TLS connection -connect- established";
 
+    /* a Hello from our peer may have been processed by crofsock's
+     * RX thread already, see crofconn::handle_recv() */
+    if (STATE_CONNECT_PENDING != get_state())
+      return;
+
     run_finite_state_machine(STATE_NEGOTIATING);
 
   } catch (eRofConnNotFound &e) {
@@ -880,6 +923,11 @@ void crofconn::handle_tls_accepted(crofsock &socket) {
     VLOG(2) << __FUNCTION__
             << " socket indicates TLS connection -accept- established";
 
+    /* a Hello from our peer may have been processed by crofsock's
+     * RX thread already, see crofconn::handle_recv() */
+    if (STATE_ACCEPT_PENDING != get_state())
+      return;
+
     run_finite_state_machine(STATE_NEGOTIATING);
 
   } catch (eRofConnNotFound &e) {
@@ -1068,27 +1116,14 @@ void crofconn::handle_recv(crofsock &socket, rofl::openflow::cofmsg *msg) {
       drop_pending_request(msg->get_xid());
     }
 
-    /* Store message in appropriate rxqueue:
-     * Strategy: we enforce queueing of successful received messages
-     * in rxqueues in any case and never drop messages. However, we
-     * disable reception of further messages from our peer, if we
-     * exceed the rxqueues capacity threshold. Once, the application
-     * starts reading message from the rxqueues, we reenable the
-     * socket. See method crofconn::handle_rx_messages() for details. */
+    /* Store message in appropriate rxqueue, see method
+     * crofconn::store_rx_message() for the admission policies. */
     switch (ofp_version.load()) {
     case rofl::openflow10::OFP_VERSION: {
       switch (msg->get_type()) {
       case rofl::openflow10::OFPT_PACKET_IN:
       case rofl::openflow10::OFPT_PACKET_OUT: {
-        rxqueues[QUEUE_PKT].store(msg, true);
-        if (rxqueues[QUEUE_PKT].capacity() == 0) {
-          if (not rofsock.is_rx_disabled()) {
-            VLOG(2) << __FUNCTION__ << " rxqueues[QUEUE_PKT] capacity "
-                                       "exhausted; action: disabling "
-                                       "reception of messages";
-          }
-          rofsock.rx_disable();
-        }
+        store_rx_message(QUEUE_PKT, msg);
       } break;
       case rofl::openflow10::OFPT_FLOW_MOD:
       case rofl::openflow10::OFPT_FLOW_REMOVED:
@@ -1096,40 +1131,15 @@ void crofconn::handle_recv(crofsock &socket, rofl::openflow::cofmsg *msg) {
       case rofl::openflow10::OFPT_STATS_REPLY:
       case rofl::openflow10::OFPT_BARRIER_REQUEST:
       case rofl::openflow10::OFPT_BARRIER_REPLY: {
-        rxqueues[QUEUE_FLOW].store(msg, true);
-        if (rxqueues[QUEUE_FLOW].capacity() == 0) {
-          if (not rofsock.is_rx_disabled()) {
-            VLOG(2) << __FUNCTION__ << " rxqueues[QUEUE_FLOW] capacity "
-                                       "exhausted; action: disabling "
-                                       "reception of messages";
-          }
-          rofsock.rx_disable();
-        }
+        store_rx_message(QUEUE_FLOW, msg);
       } break;
       case rofl::openflow10::OFPT_HELLO:
       case rofl::openflow10::OFPT_ECHO_REQUEST:
       case rofl::openflow10::OFPT_ECHO_REPLY: {
-        rxqueues[QUEUE_OAM].store(msg, true);
-        if (rxqueues[QUEUE_OAM].capacity() == 0) {
-          if (not rofsock.is_rx_disabled()) {
-            VLOG(2) << __FUNCTION__ << " rxqueues[QUEUE_OAM] capacity "
-                                       "exhausted; action: disabling "
-                                       "reception of messages";
-          }
-          rofsock.rx_disable();
-        }
+        store_rx_message(QUEUE_OAM, msg);
       } break;
       default: {
-        rxqueues[QUEUE_MGMT].store(msg, true);
-
-        if (rxqueues[QUEUE_MGMT].capacity() == 0) {
-          if (not rofsock.is_rx_disabled()) {
-            VLOG(2) << __FUNCTION__ << " rxqueues[QUEUE_MGMT] capacity "
-                                       "exhausted; action: disabling "
-                                       "reception of messages";
-          }
-          rofsock.rx_disable();
-        }
+        store_rx_message(QUEUE_MGMT, msg);
       };
       }
     } break;
@@ -1137,15 +1147,7 @@ void crofconn::handle_recv(crofsock &socket, rofl::openflow::cofmsg *msg) {
       switch (msg->get_type()) {
       case rofl::openflow12::OFPT_PACKET_IN:
       case rofl::openflow12::OFPT_PACKET_OUT: {
-        rxqueues[QUEUE_PKT].store(msg, true);
-        if (rxqueues[QUEUE_PKT].capacity() == 0) {
-          if (not rofsock.is_rx_disabled()) {
-            VLOG(2) << __FUNCTION__ << " rxqueues[QUEUE_PKT] capacity "
-                                       "exhausted; action: disabling "
-                                       "reception of messages";
-          }
-          rofsock.rx_disable();
-        }
+        store_rx_message(QUEUE_PKT, msg);
       } break;
       case rofl::openflow12::OFPT_FLOW_MOD:
       case rofl::openflow12::OFPT_FLOW_REMOVED:
@@ -1156,55 +1158,24 @@ void crofconn::handle_recv(crofsock &socket, rofl::openflow::cofmsg *msg) {
       case rofl::openflow12::OFPT_STATS_REPLY:
       case rofl::openflow12::OFPT_BARRIER_REQUEST:
       case rofl::openflow12::OFPT_BARRIER_REPLY: {
-        rxqueues[QUEUE_FLOW].store(msg, true);
-        if (rxqueues[QUEUE_FLOW].capacity() == 0) {
-          if (not rofsock.is_rx_disabled()) {
-            VLOG(2) << __FUNCTION__ << " rxqueues[QUEUE_FLOW] capacity "
-                                       "exhausted; action: disabling "
-                                       "reception of messages";
-          }
-          rofsock.rx_disable();
-        }
+        store_rx_message(QUEUE_FLOW, msg);
       } break;
       case rofl::openflow12::OFPT_HELLO:
       case rofl::openflow12::OFPT_ECHO_REQUEST:
       case rofl::openflow12::OFPT_ECHO_REPLY: {
-        rxqueues[QUEUE_OAM].store(msg, true);
-        if (rxqueues[QUEUE_OAM].capacity() == 0) {
-          if (not rofsock.is_rx_disabled()) {
-            VLOG(2) << __FUNCTION__ << " rxqueues[QUEUE_OAM] capacity "
-                                       "exhausted; action: disabling "
-                                       "reception of messages";
-          }
-          rofsock.rx_disable();
-        }
+        store_rx_message(QUEUE_OAM, msg);
       } break;
       default: {
-        rxqueues[QUEUE_MGMT].store(msg, true);
-        if (rxqueues[QUEUE_MGMT].capacity() == 0) {
-          if (not rofsock.is_rx_disabled()) {
-            VLOG(2) << __FUNCTION__ << " rxqueues[QUEUE_MGMT] capacity "
-                                       "exhausted; action: disabling "
-                                       "reception of messages";
-          }
-          rofsock.rx_disable();
-        }
+        store_rx_message(QUEUE_MGMT, msg);
       };
       }
     } break;
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       switch (msg->get_type()) {
       case rofl::openflow13::OFPT_PACKET_IN:
       case rofl::openflow13::OFPT_PACKET_OUT: {
-        rxqueues[QUEUE_PKT].store(msg, true);
-        if (rxqueues[QUEUE_PKT].capacity() == 0) {
-          if (not rofsock.is_rx_disabled()) {
-            VLOG(2) << __FUNCTION__ << " rxqueues[QUEUE_PKT] capacity "
-                                       "exhausted; action: disabling "
-                                       "reception of messages";
-          }
-          rofsock.rx_disable();
-        }
+        store_rx_message(QUEUE_PKT, msg);
       } break;
       case rofl::openflow13::OFPT_FLOW_MOD:
       case rofl::openflow13::OFPT_FLOW_REMOVED:
@@ -1214,38 +1185,18 @@ void crofconn::handle_recv(crofsock &socket, rofl::openflow::cofmsg *msg) {
       case rofl::openflow13::OFPT_MULTIPART_REQUEST:
       case rofl::openflow13::OFPT_MULTIPART_REPLY:
       case rofl::openflow13::OFPT_BARRIER_REQUEST:
-      case rofl::openflow13::OFPT_BARRIER_REPLY: {
-        rxqueues[QUEUE_FLOW].store(msg, true);
-        if (rxqueues[QUEUE_FLOW].capacity() == 0) {
-          if (not rofsock.is_rx_disabled()) {
-            VLOG(2) << __FUNCTION__ << " rxqueues[QUEUE_FLOW] capacity "
-                                       "exhausted; action: disabling "
-                                       "reception of messages";
-          }
-          rofsock.rx_disable();
-        }
+      case rofl::openflow13::OFPT_BARRIER_REPLY:
+      case rofl::openflow14::OFPT_BUNDLE_CONTROL:
+      case rofl::openflow14::OFPT_BUNDLE_ADD_MESSAGE: {
+        store_rx_message(QUEUE_FLOW, msg);
       } break;
       case rofl::openflow13::OFPT_HELLO:
       case rofl::openflow13::OFPT_ECHO_REQUEST:
       case rofl::openflow13::OFPT_ECHO_REPLY: {
-        rxqueues[QUEUE_OAM].store(msg, true);
-        if (rxqueues[QUEUE_OAM].capacity() == 0) {
-          if (not rofsock.is_rx_disabled()) {
-            VLOG(2) << __FUNCTION__ << " rxqueues[QUEUE_OAM] capacity "
-                                       "exhausted; action: disabling "
-                                       "reception of messages";
-          }
-          rofsock.rx_disable();
-        }
+        store_rx_message(QUEUE_OAM, msg);
       } break;
       default: {
-        rxqueues[QUEUE_MGMT].store(msg, true);
-        if (rxqueues[QUEUE_MGMT].capacity() == 0) {
-          VLOG(2) << __FUNCTION__ << " rxqueues[QUEUE_MGMT] capacity "
-                                     "exhausted; action: disabling "
-                                     "reception of messages";
-          rofsock.rx_disable();
-        }
+        store_rx_message(QUEUE_MGMT, msg);
       };
       }
     } break;
@@ -1268,6 +1219,41 @@ void crofconn::handle_recv(crofsock &socket, rofl::openflow::cofmsg *msg) {
   }
 }
 
+void crofconn::store_rx_message(outqueue_type_t queue_id,
+                                rofl::openflow::cofmsg *msg) {
+  /* Strategy RXQUEUE_POLICY_BACKPRESSURE: we enforce queueing of
+   * successfully received messages and never drop them. However, we
+   * disable reception of further messages from our peer, if we exceed
+   * the rxqueue's capacity threshold. Once the application starts reading
+   * messages from the rxqueues, we reenable the socket. See method
+   * crofconn::handle_rx_messages() for details.
+   *
+   * Strategy RXQUEUE_POLICY_TAILDROP: messages exceeding the rxqueue's
+   * capacity are dropped and counted, the socket is never disabled. */
+  if (rxqueues[queue_id].capacity() == 0) {
+    if (RXQUEUE_POLICY_TAILDROP == rxpolicies[queue_id]) {
+      rxdrops[queue_id]++;
+      VLOG(3) << __FUNCTION__ << " rxqueues[" << (unsigned int)queue_id
+              << "] capacity exhausted; action: dropping message, drops: "
+              << rxdrops[queue_id] << ", " << msg->str();
+      delete msg;
+      return;
+    }
+  }
+
+  rxqueues[queue_id].store(msg, true);
+
+  if ((rxqueues[queue_id].capacity() == 0) &&
+      (RXQUEUE_POLICY_BACKPRESSURE == rxpolicies[queue_id])) {
+    if (not rofsock.is_rx_disabled()) {
+      VLOG(2) << __FUNCTION__ << " rxqueues[" << (unsigned int)queue_id
+              << "] capacity exhausted; action: disabling "
+                 "reception of messages";
+    }
+    rofsock.rx_disable();
+  }
+}
+
 void crofconn::handle_wakeup(cthread &thread) {
   if (flag_test(FLAG_DELETE_IN_PROGRESS))
     return;
@@ -1312,6 +1298,14 @@ void crofconn::handle_rx_messages() {
             break; // no further messages in this queue
           }
 
+          /* msg is owned by the higher layers after handing it over */
+          uint8_t type = msg->get_type();
+          struct timespec ts_start;
+          bool profiling = rx_profiling;
+          if (profiling) {
+            clock_gettime(CLOCK_MONOTONIC, &ts_start);
+          }
+
           /* segmentation and reassembly */
           switch (ofp_version.load()) {
           case rofl::openflow10::OFP_VERSION:
@@ -1336,6 +1330,20 @@ void crofconn::handle_rx_messages() {
             }
           };
           }
+
+          if (profiling) {
+            struct timespec ts_stop;
+            clock_gettime(CLOCK_MONOTONIC, &ts_stop);
+            uint64_t nsec = (ts_stop.tv_sec - ts_start.tv_sec) * 1000000000 +
+                            (ts_stop.tv_nsec - ts_start.tv_nsec);
+            rxprofiles[type].rx_msgs++;
+            rxprofiles[type].nsec_sum += nsec;
+            uint64_t nsec_max = rxprofiles[type].nsec_max;
+            while ((nsec > nsec_max) &&
+                   (not rxprofiles[type].nsec_max.compare_exchange_weak(
+                       nsec_max, nsec))) {
+            }
+          }
         }
 
         /* reschedule this method */
@@ -1366,7 +1374,7 @@ void crofconn::handle_rx_messages() {
 
   cthread::thread(thread_num)
       .add_timer(this, TIMER_ID_NEED_LIFE_CHECK,
-                 ctimespec().expire_in(timeout_lifecheck));
+                 ctimens::expire_in(timeout_lifecheck));
 
   /* reenable reception of messages on socket */
   if (rofsock.is_rx_disabled()) {
@@ -1506,7 +1514,8 @@ rofl::crofsock::msg_result_t crofconn::send_message(rofl::openflow::cofmsg *msg,
     }
 
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     switch (msg->get_type()) {
     case rofl::openflow13::OFPT_MULTIPART_REQUEST: {
@@ -1573,7 +1582,8 @@ crofconn::segment_and_send_message(rofl::openflow::cofmsg *msg) {
       } break;
       }
     } break;
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
 
       switch (msg->get_type()) {
       case rofl::openflow13::OFPT_MULTIPART_REQUEST: {
@@ -1636,6 +1646,10 @@ crofconn::segment_and_send_message(rofl::openflow::cofmsg *msg) {
               dynamic_cast<rofl::openflow::cofmsg_meter_config_stats_reply *>(
                   msg));
         } break;
+        case rofl::openflow14::OFPMP_FLOW_MONITOR: {
+          msg_result = segment_flow_monitor_reply(
+              dynamic_cast<rofl::openflow::cofmsg_flow_monitor_reply *>(msg));
+        } break;
         case rofl::openflow13::OFPMP_METER_FEATURES: {
           // no array in meter-features, so no need to segment
           msg_result = rofsock.send_message(
@@ -2125,3 +2139,47 @@ rofl::crofsock::msg_result_t crofconn::segment_meter_config_stats_reply(
 
   return msg_result;
 }
+
+rofl::crofsock::msg_result_t crofconn::segment_flow_monitor_reply(
+    rofl::openflow::cofmsg_flow_monitor_reply *msg) {
+  std::list<rofl::openflow::cofmsg_flow_monitor_reply *> segments;
+  const int MAX_LENGTH = 64000 /*bytes*/;
+  auto updateids = msg->get_flow_updates().keys();
+  rofl::crofsock::msg_result_t msg_result = rofl::crofsock::MSG_QUEUED;
+
+  /* create fragments, updates keep their order across fragments */
+  while (not updateids.empty()) {
+    rofl::openflow::cofflowupdatearray array(msg->get_version());
+    unsigned int index = 0;
+
+    while ((not updateids.empty()) && (array.length() < MAX_LENGTH)) {
+      uint32_t updateid = updateids.front();
+      updateids.pop_front();
+      array.add_flow_update(index++) =
+          msg->get_flow_updates().get_flow_update(updateid);
+    }
+
+    segments.push_back(new rofl::openflow::cofmsg_flow_monitor_reply(
+        msg->get_version(), msg->get_xid(), msg->get_stats_flags(), array));
+  }
+
+  /* delete original message */
+  delete msg;
+
+  /* send fragments */
+  while (not segments.empty()) {
+    rofl::openflow::cofmsg_flow_monitor_reply *msg = segments.front();
+    segments.pop_front();
+    // set MORE flag on all segments except last one
+    if (not segments.empty()) {
+      msg->set_stats_flags(msg->get_stats_flags() |
+                           rofl::openflow13::OFPMPF_REPLY_MORE);
+    }
+    /* when enforcing queueing, there are only two return values possible:
+     * MSQ_QUEUED and MSG_QUEUED_CONGESTION. We return the result received for
+     * the last fragment. */
+    msg_result = rofsock.send_message(msg, /*enforce-queueing*/ true);
+  }
+
+  return msg_result;
+}
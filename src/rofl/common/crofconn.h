@@ -168,6 +168,11 @@ public:
     QUEUE_MAX,  // do not use
   };
 
+  enum rxqueue_policy_t {
+    RXQUEUE_POLICY_BACKPRESSURE = 0, // stop reading from socket when full
+    RXQUEUE_POLICY_TAILDROP = 1,     // drop new messages when full
+  };
+
   enum crofconn_mode_t {
     MODE_UNKNOWN = 0,
     MODE_CONTROLLER = 1,
@@ -221,6 +226,22 @@ public:
   tls_connect(const rofl::openflow::cofhello_elem_versionbitmap &versionbitmap,
               enum crofconn_mode_t mode, bool reconnect = true);
 
+  /**
+   * @brief	Accepts a connection on one side of an in-process channel
+   */
+  virtual void
+  mem_accept(std::shared_ptr<cmemchannel> channel, cmemchannel::side_t side,
+             const rofl::openflow::cofhello_elem_versionbitmap &versionbitmap,
+             enum crofconn_mode_t mode);
+
+  /**
+   * @brief	Connects on one side of an in-process channel
+   */
+  virtual void
+  mem_connect(std::shared_ptr<cmemchannel> channel, cmemchannel::side_t side,
+              const rofl::openflow::cofhello_elem_versionbitmap &versionbitmap,
+              enum crofconn_mode_t mode);
+
 public:
   /**
    *
@@ -315,7 +336,10 @@ public:
   /**
    *
    */
-  void set_auxid(const cauxid &auxid) { this->auxid = auxid; };
+  void set_auxid(const cauxid &auxid) {
+    this->auxid = auxid;
+    rofsock.set_trace_auxid(auxid.get_id());
+  };
 
 public:
   /**
@@ -346,6 +370,102 @@ public:
     return *this;
   };
 
+  /**
+   * @brief	Returns admission policy of a reception queue
+   */
+  rxqueue_policy_t get_rxqueue_policy(outqueue_type_t queue_id) const {
+    if (QUEUE_MAX <= queue_id) {
+      throw eRofConnInvalid("crofconn::get_rxqueue_policy() invalid queue_id")
+          .set_func(__FUNCTION__)
+          .set_file(__FILE__)
+          .set_line(__LINE__);
+    }
+    return rxpolicies[queue_id];
+  };
+
+  /**
+   * @brief	Sets admission policy of a reception queue
+   *
+   * RXQUEUE_POLICY_BACKPRESSURE stops reading from the socket once the
+   * queue is full, which also delays Echo-Requests queued behind. With
+   * RXQUEUE_POLICY_TAILDROP new messages are discarded and counted instead
+   * and the socket keeps being read. QUEUE_PKT defaults to tail-drop on
+   * controller side connections and to backpressure otherwise, unless set
+   * explicitly by this method.
+   */
+  crofconn &set_rxqueue_policy(outqueue_type_t queue_id,
+                               rxqueue_policy_t policy) {
+    if (QUEUE_MAX <= queue_id) {
+      throw eRofConnInvalid("crofconn::set_rxqueue_policy() invalid queue_id")
+          .set_func(__FUNCTION__)
+          .set_file(__FILE__)
+          .set_line(__LINE__);
+    }
+    rxpolicies[queue_id] = policy;
+    if (QUEUE_PKT == queue_id)
+      rxpolicy_pkt_set = true;
+    return *this;
+  };
+
+  /**
+   * @brief	Returns number of messages dropped by a reception queue
+   */
+  uint64_t get_rxqueue_drops(outqueue_type_t queue_id) const {
+    if (QUEUE_MAX <= queue_id) {
+      throw eRofConnInvalid("crofconn::get_rxqueue_drops() invalid queue_id")
+          .set_func(__FUNCTION__)
+          .set_file(__FILE__)
+          .set_line(__LINE__);
+    }
+    return rxdrops[queue_id];
+  };
+
+public:
+  /**
+   * @brief	Processing time of received messages of a single type
+   */
+  struct rxprofile_t {
+    uint64_t rx_msgs;
+    uint64_t nsec_sum;
+    uint64_t nsec_max;
+  };
+
+  /**
+   * @brief	Enables profiling of received messages for all connections
+   *
+   * Measures the time spent handing each received message over to the
+   * higher layers and the application, indexed by OpenFlow message type.
+   * Profiling is disabled by default.
+   */
+  static void set_rx_profiling(bool enable) { rx_profiling = enable; };
+
+  /**
+   * @brief	Returns true if profiling of received messages is enabled
+   */
+  static bool get_rx_profiling() { return rx_profiling; };
+
+  /**
+   * @brief	Returns processing time of received messages of given type
+   */
+  static rxprofile_t get_rx_profile(uint8_t type) {
+    rxprofile_t profile;
+    profile.rx_msgs = rxprofiles[type].rx_msgs;
+    profile.nsec_sum = rxprofiles[type].nsec_sum;
+    profile.nsec_max = rxprofiles[type].nsec_max;
+    return profile;
+  };
+
+  /**
+   * @brief	Resets processing time of received messages for all types
+   */
+  static void clear_rx_profile() {
+    for (unsigned int type = 0; type < RXPROFILE_MAX; type++) {
+      rxprofiles[type].rx_msgs = 0;
+      rxprofiles[type].nsec_sum = 0;
+      rxprofiles[type].nsec_max = 0;
+    }
+  };
+
 public:
   /**
    *
@@ -371,6 +491,13 @@ public:
     return *this;
   };
 
+  /**
+   * @brief	Returns number of messages a txqueue may still accept
+   */
+  size_t get_txqueue_capacity(crofsock::outqueue_type_t queue_id) const {
+    return rofsock.get_txqueue_capacity(queue_id);
+  };
+
 public:
   /**
    *
@@ -399,6 +526,14 @@ public:
     return *this;
   };
 
+  /**
+   * @brief	Sets remote address by host name and service
+   */
+  crofconn &set_raddr(const std::string &node, const std::string &service) {
+    rofsock.set_raddr(node, service);
+    return *this;
+  };
+
 public:
   /**
    *
@@ -650,7 +785,17 @@ public:
   };
 
 private:
-  void set_mode(enum crofconn_mode_t mode) { this->mode = mode; };
+  void set_mode(enum crofconn_mode_t mode) {
+    this->mode = mode;
+    /* Packet-In is dropped under overload on controller side connections,
+     * so Echo-Requests behind them are still answered; Packet-Out received
+     * by a datapath is subject to backpressure like all other messages */
+    if (not rxpolicy_pkt_set) {
+      rxpolicies[QUEUE_PKT] = (MODE_CONTROLLER == mode)
+                                  ? RXQUEUE_POLICY_TAILDROP
+                                  : RXQUEUE_POLICY_BACKPRESSURE;
+    }
+  };
 
   void set_state(enum crofconn_state_t state) { this->state = state; };
 
@@ -731,6 +876,8 @@ private:
 private:
   void handle_rx_messages();
 
+  void store_rx_message(outqueue_type_t queue_id, rofl::openflow::cofmsg *msg);
+
   void handle_rx_multipart_message(rofl::openflow::cofmsg *msg);
 
 private:
@@ -832,6 +979,12 @@ private:
   rofl::crofsock::msg_result_t segment_meter_config_stats_reply(
       rofl::openflow::cofmsg_meter_config_stats_reply *msg);
 
+  /**
+   *
+   */
+  rofl::crofsock::msg_result_t segment_flow_monitor_reply(
+      rofl::openflow::cofmsg_flow_monitor_reply *msg);
+
 private:
   /**
    *
@@ -839,7 +992,7 @@ private:
   class ctransaction {
   public:
     uint32_t xid;
-    ctimespec tspec;
+    ctimens tspec;
     uint8_t type;
     uint16_t subtype;
 
@@ -852,7 +1005,7 @@ private:
     /**
      *
      */
-    ctransaction(uint32_t xid, const ctimespec tspec, uint8_t type,
+    ctransaction(uint32_t xid, const ctimens &tspec, uint8_t type,
                  uint16_t subtype = 0)
         : xid(xid), tspec(tspec), type(type), subtype(subtype){};
 
@@ -886,7 +1039,7 @@ private:
 
     uint16_t get_subtype() const { return subtype; };
 
-    const ctimespec &get_tspec() const { return tspec; };
+    const ctimens &get_tspec() const { return tspec; };
 
   public:
     class ctransaction_find_by_xid {
@@ -1010,13 +1163,13 @@ private:
           .set_line(__LINE__);
     }
     pending_segments[xid] =
-        csegment(xid, ctimespec().expire_in(timeout_segments), msg_type,
+        csegment(xid, ctimens::expire_in(timeout_segments), msg_type,
                  msg_multipart_type);
     if (not cthread::thread(thread_num)
                 .has_timer(this, TIMER_ID_PENDING_SEGMENTS)) {
       cthread::thread(thread_num)
           .add_timer(this, TIMER_ID_PENDING_SEGMENTS,
-                     ctimespec().expire_in(timeout_segments));
+                     ctimens::expire_in(timeout_segments));
     }
     return pending_segments[xid];
   };
@@ -1036,14 +1189,14 @@ private:
     }
     if (pending_segments.find(xid) == pending_segments.end()) {
       pending_segments[xid] =
-          csegment(xid, ctimespec().expire_in(timeout_segments), msg_type,
+          csegment(xid, ctimens::expire_in(timeout_segments), msg_type,
                    msg_multipart_type);
     }
     if (not cthread::thread(thread_num)
                 .has_timer(this, TIMER_ID_PENDING_SEGMENTS)) {
       cthread::thread(thread_num)
           .add_timer(this, TIMER_ID_PENDING_SEGMENTS,
-                     ctimespec().expire_in(timeout_segments));
+                     ctimens::expire_in(timeout_segments));
     }
     return pending_segments[xid];
   };
@@ -1070,7 +1223,7 @@ private:
                 .has_timer(this, TIMER_ID_PENDING_SEGMENTS)) {
       cthread::thread(thread_num)
           .add_timer(this, TIMER_ID_PENDING_SEGMENTS,
-                     ctimespec().expire_in(timeout_segments));
+                     ctimens::expire_in(timeout_segments));
     }
     return pending_segments[xid];
   };
@@ -1123,7 +1276,7 @@ private:
     if (not pending_segments.empty()) {
       cthread::thread(thread_num)
           .add_timer(this, TIMER_ID_PENDING_SEGMENTS,
-                     ctimespec().expire_in(timeout_segments));
+                     ctimens::expire_in(timeout_segments));
     }
   };
 
@@ -1185,6 +1338,24 @@ private:
   // queues for storing received messages
   std::vector<crofqueue> rxqueues;
 
+  // admission policies for rxqueues
+  std::atomic<rxqueue_policy_t> rxpolicies[QUEUE_MAX];
+
+  // admission policy of QUEUE_PKT was set by the application
+  std::atomic_bool rxpolicy_pkt_set;
+
+  // number of messages dropped by rxqueues
+  std::atomic_uint_fast64_t rxdrops[QUEUE_MAX];
+
+  // profiling of received messages per OpenFlow message type
+  static const unsigned int RXPROFILE_MAX = 256;
+  static std::atomic_bool rx_profiling;
+  static struct crxprofile {
+    std::atomic<uint64_t> rx_msgs;
+    std::atomic<uint64_t> nsec_sum;
+    std::atomic<uint64_t> nsec_max;
+  } rxprofiles[RXPROFILE_MAX];
+
   // internal thread is working on pending messages
   std::atomic_bool rx_thread_working;
 
@@ -370,7 +370,8 @@ void crofctl::handle_recv(crofchan &chan, crofconn &conn,
       default: {};
       }
     } break;
-    case openflow13::OFP_VERSION: {
+    case openflow13::OFP_VERSION:
+    case openflow14::OFP_VERSION: {
 
       switch (msg->get_type()) {
       case rofl::openflow13::OFPT_EXPERIMENTER: {
@@ -569,6 +570,14 @@ void crofctl::handle_recv(crofchan &chan, crofconn &conn,
               dynamic_cast<rofl::openflow::cofmsg_experimenter_stats_request &>(
                   *msg));
 
+        } break;
+        case rofl::openflow14::OFPMP_FLOW_MONITOR: {
+
+          crofctl_env::call_env(env).handle_flow_monitor_request(
+              *this, conn.get_auxid(),
+              dynamic_cast<rofl::openflow::cofmsg_flow_monitor_request &>(
+                  *msg));
+
         } break;
         default: { } break; }
 
@@ -617,6 +626,18 @@ void crofctl::handle_recv(crofchan &chan, crofconn &conn,
             *this, conn.get_auxid(),
             dynamic_cast<rofl::openflow::cofmsg_meter_mod &>(*msg));
       } break;
+      case rofl::openflow14::OFPT_BUNDLE_CONTROL: {
+        check_role();
+        crofctl_env::call_env(env).handle_bundle_control(
+            *this, conn.get_auxid(),
+            dynamic_cast<rofl::openflow::cofmsg_bundle_control &>(*msg));
+      } break;
+      case rofl::openflow14::OFPT_BUNDLE_ADD_MESSAGE: {
+        check_role();
+        crofctl_env::call_env(env).handle_bundle_add_message(
+            *this, conn.get_auxid(),
+            dynamic_cast<rofl::openflow::cofmsg_bundle_add_message &>(*msg));
+      } break;
       default: {};
       }
     } break;
@@ -2160,7 +2181,8 @@ void crofctl::handle_transaction_timeout(crofchan &chan, crofconn &conn,
       }
 
     } break;
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       switch (type) {
       case rofl::openflow13::OFPT_EXPERIMENTER: {
         crofctl_env::call_env(env).handle_experimenter_timeout(*this, xid);
@@ -2506,6 +2528,37 @@ rofl::crofsock::msg_result_t crofctl::send_meter_stats_reply(
   }
 }
 
+rofl::crofsock::msg_result_t crofctl::send_flow_monitor_reply(
+    const cauxid &auxid, uint32_t xid,
+    const rofl::openflow::cofflowupdatearray &flow_updates,
+    uint16_t stats_flags) {
+  rofl::openflow::cofmsg *msg = nullptr;
+  try {
+    msg = new rofl::openflow::cofmsg_flow_monitor_reply(
+        rofchan.get_version(), xid, stats_flags, flow_updates);
+
+    return rofchan.send_message(auxid, msg);
+
+  } catch (eRofConnNotConnected &e) {
+    VLOG(1) << __FUNCTION__ << " dropping message " << e.what();
+    delete msg;
+    throw;
+  } catch (eRofQueueFull &e) {
+    VLOG(1) << __FUNCTION__ << " dropping message " << e.what();
+    delete msg;
+    throw;
+  }
+}
+
+rofl::crofsock::msg_result_t crofctl::send_flow_update_message(
+    const cauxid &auxid,
+    const rofl::openflow::cofflowupdatearray &flow_updates) {
+  if (0 == flow_updates.size()) {
+    return rofl::crofsock::MSG_IGNORED;
+  }
+  return send_flow_monitor_reply(auxid, 0, flow_updates);
+}
+
 rofl::crofsock::msg_result_t crofctl::send_meter_config_stats_reply(
     const cauxid &auxid, uint32_t xid,
     const rofl::openflow::cofmeterconfigarray &meter_config_array,
@@ -2563,7 +2616,8 @@ rofl::crofsock::msg_result_t crofctl::send_packet_in_message(
         return rofl::crofsock::MSG_IGNORED;
       }
     } break;
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       switch (role.get_role()) {
       case rofl::openflow13::OFPCR_ROLE_EQUAL:
       case rofl::openflow13::OFPCR_ROLE_MASTER: {
@@ -2623,6 +2677,28 @@ rofl::crofsock::msg_result_t crofctl::send_barrier_reply(const cauxid &auxid,
   }
 }
 
+rofl::crofsock::msg_result_t
+crofctl::send_bundle_control_reply(const cauxid &auxid, uint32_t xid,
+                                   uint32_t bundle_id, uint16_t ctrl_type,
+                                   uint16_t flags) {
+  rofl::openflow::cofmsg *msg = nullptr;
+  try {
+    msg = new rofl::openflow::cofmsg_bundle_control(
+        rofchan.get_version(), xid, bundle_id, ctrl_type, flags);
+
+    return rofchan.send_message(auxid, msg);
+
+  } catch (eRofConnNotConnected &e) {
+    VLOG(1) << __FUNCTION__ << " dropping message " << e.what();
+    delete msg;
+    throw;
+  } catch (eRofQueueFull &e) {
+    VLOG(1) << __FUNCTION__ << " dropping message " << e.what();
+    delete msg;
+    throw;
+  }
+}
+
 rofl::crofsock::msg_result_t
 crofctl::send_role_reply(const cauxid &auxid, uint32_t xid,
                          const rofl::openflow::cofrole &role) {
@@ -2675,7 +2751,7 @@ rofl::crofsock::msg_result_t crofctl::send_experimenter_message(
 
     if (timeout_in_secs > 0) {
       return rofchan.send_message(auxid, msg,
-                                  ctimespec().expire_in(timeout_in_secs));
+                                  ctimespec::deadline(timeout_in_secs));
     } else {
       return rofchan.send_message(auxid, msg);
     }
@@ -2704,7 +2780,8 @@ rofl::crofsock::msg_result_t crofctl::send_flow_removed_message(
         return rofl::crofsock::MSG_IGNORED;
       }
     } break;
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       switch (role.get_role()) {
       case rofl::openflow13::OFPCR_ROLE_EQUAL:
       case rofl::openflow13::OFPCR_ROLE_MASTER: {
@@ -2754,7 +2831,8 @@ crofctl::send_port_status_message(const cauxid &auxid, uint8_t reason,
     case rofl::openflow12::OFP_VERSION: {
       // OFP 1.2 => send port-status to controller entity in slave mode
     } break;
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       switch (role.get_role()) {
       case rofl::openflow13::OFPCR_ROLE_EQUAL:
       case rofl::openflow13::OFPCR_ROLE_MASTER: {
@@ -2793,6 +2871,55 @@ crofctl::send_port_status_message(const cauxid &auxid, uint8_t reason,
   }
 }
 
+rofl::crofsock::msg_result_t
+crofctl::send_role_status_message(const cauxid &auxid, uint32_t role,
+                                  uint8_t reason, uint64_t generation_id) {
+  if (rofchan.get_version() < rofl::openflow14::OFP_VERSION) {
+    return rofl::crofsock::MSG_IGNORED;
+  }
+  rofl::openflow::cofmsg *msg = nullptr;
+  try {
+    msg = new rofl::openflow::cofmsg_role_status(
+        rofchan.get_version(), ++xid_last, role, reason, generation_id);
+
+    return rofchan.send_message(auxid, msg);
+
+  } catch (eRofConnNotConnected &e) {
+    VLOG(1) << __FUNCTION__ << " dropping message " << e.what();
+    delete msg;
+    throw;
+  } catch (eRofQueueFull &e) {
+    VLOG(1) << __FUNCTION__ << " dropping message " << e.what();
+    delete msg;
+    throw;
+  }
+}
+
+rofl::crofsock::msg_result_t crofctl::send_table_status_message(
+    const cauxid &auxid, uint8_t reason, uint8_t table_id, uint32_t config,
+    const rofl::openflow::coftablemod_props &props) {
+  if (rofchan.get_version() < rofl::openflow14::OFP_VERSION) {
+    return rofl::crofsock::MSG_IGNORED;
+  }
+  rofl::openflow::cofmsg *msg = nullptr;
+  try {
+    msg = new rofl::openflow::cofmsg_table_status(rofchan.get_version(),
+                                                  ++xid_last, reason, table_id,
+                                                  config, props);
+
+    return rofchan.send_message(auxid, msg);
+
+  } catch (eRofConnNotConnected &e) {
+    VLOG(1) << __FUNCTION__ << " dropping message " << e.what();
+    delete msg;
+    throw;
+  } catch (eRofQueueFull &e) {
+    VLOG(1) << __FUNCTION__ << " dropping message " << e.what();
+    delete msg;
+    throw;
+  }
+}
+
 rofl::crofsock::msg_result_t crofctl::send_queue_get_config_reply(
     const cauxid &auxid, uint32_t xid, uint32_t portno,
     const rofl::openflow::cofpacket_queues &queues) {
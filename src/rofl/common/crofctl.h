@@ -29,6 +29,7 @@
 #include "rofl/common/openflow/cofaggrstats.h"
 #include "rofl/common/openflow/cofasyncconfig.h"
 #include "rofl/common/openflow/cofdescstats.h"
+#include "rofl/common/openflow/cofflowmonitorarray.h"
 #include "rofl/common/openflow/cofflowstatsarray.h"
 #include "rofl/common/openflow/cofgroupdescstatsarray.h"
 #include "rofl/common/openflow/cofgroupfeaturesstats.h"
@@ -44,6 +45,7 @@
 #include "rofl/common/openflow/cofportstatsarray.h"
 #include "rofl/common/openflow/cofqueuestatsarray.h"
 #include "rofl/common/openflow/cofrole.h"
+#include "rofl/common/openflow/coftablemodprops.h"
 #include "rofl/common/openflow/coftables.h"
 #include "rofl/common/openflow/coftablestatsarray.h"
 #include "rofl/common/openflow/messages/cofmsg.h"
@@ -472,6 +474,17 @@ protected:
       rofl::crofctl &ctl, const rofl::cauxid &auxid,
       rofl::openflow::cofmsg_experimenter_stats_request &msg){};
 
+  /**
+   * @brief	OpenFlow Flow-Monitor-Request message received.
+   *
+   * @param ctl controller instance
+   * @param auxid control connection identifier
+   * @param msg OpenFlow message instance
+   */
+  virtual void handle_flow_monitor_request(
+      rofl::crofctl &ctl, const rofl::cauxid &auxid,
+      rofl::openflow::cofmsg_flow_monitor_request &msg){};
+
   /**
    * @brief	OpenFlow Packet-Out message received.
    *
@@ -630,6 +643,28 @@ protected:
   virtual void handle_meter_mod(rofl::crofctl &ctl, const rofl::cauxid &auxid,
                                 rofl::openflow::cofmsg_meter_mod &msg){};
 
+  /**
+   * @brief	OpenFlow Bundle-Control message received.
+   *
+   * @param ctl controller instance
+   * @param auxid control connection identifier
+   * @param msg OpenFlow message instance
+   */
+  virtual void
+  handle_bundle_control(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                        rofl::openflow::cofmsg_bundle_control &msg){};
+
+  /**
+   * @brief	OpenFlow Bundle-Add-Message message received.
+   *
+   * @param ctl controller instance
+   * @param auxid control connection identifier
+   * @param msg OpenFlow message instance
+   */
+  virtual void
+  handle_bundle_add_message(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                            rofl::openflow::cofmsg_bundle_add_message &msg){};
+
   /**@}*/
 };
 
@@ -721,6 +756,7 @@ public:
     case rofl::openflow12::OFP_VERSION:
       return (rofl::openflow12::OFPCR_ROLE_SLAVE == role.get_role());
     case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION:
       return (rofl::openflow13::OFPCR_ROLE_SLAVE == role.get_role());
     default:
       return false;
@@ -1087,6 +1123,36 @@ public:
       const rofl::openflow::cofmeter_features &meter_features,
       uint16_t stats_flags = 0);
 
+  /**
+   * @brief	Sends OpenFlow Flow-Monitor-Reply message to attached controller
+   * entity.
+   *
+   * @param auxid auxiliary connection id
+   * @param xid OpenFlow transaction identifier
+   * @param flow_updates instance of type cofflowupdatearray
+   * @param stats_flags flags for OpenFlow statistics messages, if any (default:
+   * 0)
+   */
+  rofl::crofsock::msg_result_t send_flow_monitor_reply(
+      const rofl::cauxid &auxid, uint32_t xid,
+      const rofl::openflow::cofflowupdatearray &flow_updates,
+      uint16_t stats_flags = 0);
+
+  /**
+   * @brief	Sends unsolicited flow updates to attached controller entity.
+   *
+   * All updates are carried by a single Flow-Monitor-Reply message, so
+   * agents should collect the changes caused by a batch of flow-mods and
+   * emit them at once. Replies exceeding the maximum message size are
+   * segmented by the control channel.
+   *
+   * @param auxid auxiliary connection id
+   * @param flow_updates instance of type cofflowupdatearray
+   */
+  rofl::crofsock::msg_result_t send_flow_update_message(
+      const rofl::cauxid &auxid,
+      const rofl::openflow::cofflowupdatearray &flow_updates);
+
   /**
    * @brief	Sends OpenFlow Packet-In message to attached controller entity.
    *
@@ -1115,6 +1181,20 @@ public:
   rofl::crofsock::msg_result_t send_barrier_reply(const rofl::cauxid &auxid,
                                                   uint32_t xid);
 
+  /**
+   * @brief	Sends OpenFlow Bundle-Control message to attached controller
+   * entity.
+   *
+   * @param xid OpenFlow transaction identifier
+   * @param bundle_id OpenFlow bundle identifier
+   * @param ctrl_type OpenFlow bundle control type (OFPBCT_*)
+   * @param flags OpenFlow bundle flags (OFPBF_*)
+   */
+  rofl::crofsock::msg_result_t
+  send_bundle_control_reply(const rofl::cauxid &auxid, uint32_t xid,
+                            uint32_t bundle_id, uint16_t ctrl_type,
+                            uint16_t flags);
+
   /**
    * @brief	Sends OpenFlow Error message to attached controller entity.
    *
@@ -1178,6 +1258,38 @@ public:
   send_port_status_message(const rofl::cauxid &auxid, uint8_t reason,
                            const rofl::openflow::cofport &port);
 
+  /**
+   * @brief	Sends OpenFlow Role-Status message to attached controller
+   * entity.
+   *
+   * Role-Status messages exist in OpenFlow 1.4 and beyond only, the
+   * message is ignored for older protocol versions.
+   *
+   * @param role one of OpenFlow's OFPCR_ROLE_* constants
+   * @param reason one of OpenFlow's OFPCRR_* constants
+   * @param generation_id master election generation identifier
+   */
+  rofl::crofsock::msg_result_t
+  send_role_status_message(const rofl::cauxid &auxid, uint32_t role,
+                           uint8_t reason, uint64_t generation_id);
+
+  /**
+   * @brief	Sends OpenFlow Table-Status message to attached controller
+   * entity.
+   *
+   * Table-Status messages exist in OpenFlow 1.4 and beyond only, the
+   * message is ignored for older protocol versions.
+   *
+   * @param reason one of OpenFlow's OFPTR_* constants
+   * @param table_id identifier of table that changed its configuration
+   * @param config bitmap of OFPTC_* values
+   * @param props table properties
+   */
+  rofl::crofsock::msg_result_t send_table_status_message(
+      const rofl::cauxid &auxid, uint8_t reason, uint8_t table_id,
+      uint32_t config, const rofl::openflow::coftablemod_props &props =
+                           rofl::openflow::coftablemod_props());
+
   /**
    * @brief	Sends OpenFlow Queue-Get-Config-Reply message to attached
    * controller entity.
@@ -1247,7 +1359,8 @@ private:
     case rofl::openflow12::OFP_VERSION: {
       role.set_role(rofl::openflow12::OFPCR_ROLE_EQUAL);
     } break;
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       role.set_role(rofl::openflow13::OFPCR_ROLE_EQUAL);
     } break;
     }
@@ -1261,7 +1374,8 @@ private:
     case rofl::openflow12::OFP_VERSION: {
       role.set_role(rofl::openflow12::OFPCR_ROLE_EQUAL);
     } break;
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       role.set_role(rofl::openflow13::OFPCR_ROLE_EQUAL);
     } break;
     }
@@ -21,7 +21,9 @@ using namespace rofl;
 crofdpt::~crofdpt() { state = STATE_DELETE_IN_PROGRESS; };
 
 crofdpt::crofdpt(rofl::crofdpt_env *env, const rofl::cdptid &dptid)
-    : env(env), state(STATE_RUNNING), dptid(dptid), snoop(true), rofchan(this),
+    : env(env), state(STATE_RUNNING), dptid(dptid), snoop(true), shadow(false),
+      reconcile_xid(0), reconcile_auxid(0), reconcile_sending(false),
+      reconcile_num_delta(0), reconcile_num_queued(0), rofchan(this),
       xid_last(random.uint32()), n_buffers(0), n_tables(0), capabilities(0),
       miss_send_len(0), flags(0){};
 
@@ -105,7 +107,8 @@ void crofdpt::handle_recv(rofl::crofchan &chan, rofl::crofconn &conn,
       default: {};
       }
     } break;
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       switch (msg->get_type()) {
       case rofl::openflow13::OFPT_EXPERIMENTER: {
         experimenter_rcvd(conn.get_auxid(), msg);
@@ -143,6 +146,15 @@ void crofdpt::handle_recv(rofl::crofchan &chan, rofl::crofconn &conn,
       case rofl::openflow13::OFPT_GET_ASYNC_REPLY: {
         get_async_config_reply_rcvd(conn.get_auxid(), msg);
       } break;
+      case rofl::openflow14::OFPT_BUNDLE_CONTROL: {
+        bundle_control_rcvd(conn.get_auxid(), msg);
+      } break;
+      case rofl::openflow14::OFPT_ROLE_STATUS: {
+        role_status_rcvd(conn.get_auxid(), msg);
+      } break;
+      case rofl::openflow14::OFPT_TABLE_STATUS: {
+        table_status_rcvd(conn.get_auxid(), msg);
+      } break;
       default: {};
       }
     } break;
@@ -168,6 +180,10 @@ void crofdpt::handle_transaction_timeout(crofchan &chan, crofconn &conn,
     return;
   VLOG(2) << __FUNCTION__ << " transaction xid=" << (unsigned int)xid;
 
+  if (flowtable.reconcile_in_progress() && (xid == reconcile_xid)) {
+    flowtable.reconcile_abort();
+  }
+
   try {
     switch (get_version()) {
     case rofl::openflow10::OFP_VERSION: {
@@ -307,7 +323,8 @@ void crofdpt::handle_transaction_timeout(crofchan &chan, crofconn &conn,
       }
 
     } break;
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       switch (type) {
       case rofl::openflow13::OFPT_FEATURES_REQUEST: {
         crofdpt_env::call_env(env).handle_features_reply_timeout(*this, xid);
@@ -377,6 +394,10 @@ void crofdpt::handle_transaction_timeout(crofchan &chan, crofconn &conn,
           crofdpt_env::call_env(env).handle_experimenter_stats_reply_timeout(
               *this, xid);
         } break;
+        case rofl::openflow14::OFPMP_FLOW_MONITOR: {
+          crofdpt_env::call_env(env).handle_flow_monitor_reply_timeout(*this,
+                                                                       xid);
+        } break;
         default: {
           crofdpt_env::call_env(env).handle_stats_reply_timeout(*this, xid,
                                                                 sub_type);
@@ -401,6 +422,17 @@ void crofdpt::handle_transaction_timeout(crofchan &chan, crofconn &conn,
       case rofl::openflow13::OFPT_EXPERIMENTER: {
         crofdpt_env::call_env(env).handle_experimenter_timeout(*this, xid);
       } break;
+      case rofl::openflow14::OFPT_BUNDLE_CONTROL: {
+        crofdpt_env::call_env(env).handle_bundle_control_reply_timeout(*this,
+                                                                       xid);
+        cbundle_pending bundle;
+        if (bundle_done(xid, bundle)) {
+          crofdpt_env::call_env(env).handle_bundle_failed(
+              *this, bundle.auxid, bundle.bundle_id,
+              rofl::openflow14::OFPET_BUNDLE_FAILED,
+              rofl::openflow14::OFPBFC_TIMEOUT);
+        }
+      } break;
       default: {};
       }
 
@@ -512,6 +544,9 @@ void crofdpt::multipart_reply_rcvd(const rofl::cauxid &auxid,
   case rofl::openflow13::OFPMP_EXPERIMENTER: {
     experimenter_stats_reply_rcvd(auxid, msg);
   } break;
+  case rofl::openflow14::OFPMP_FLOW_MONITOR: {
+    flow_monitor_reply_rcvd(auxid, msg);
+  } break;
   default: {};
   }
 }
@@ -545,6 +580,22 @@ void crofdpt::flow_stats_reply_rcvd(const rofl::cauxid &auxid,
   rofl::openflow::cofmsg_flow_stats_reply &reply =
       dynamic_cast<rofl::openflow::cofmsg_flow_stats_reply &>(*msg);
 
+  if (shadow && flowtable.reconcile_in_progress() &&
+      (reply.get_xid() == reconcile_xid)) {
+    flowtable.reconcile_add(reply.get_flow_stats_array());
+    {
+      AcquireReadWriteLock rwlock(reconcile_lock);
+      reconcile_delta.clear();
+      flowtable.reconcile_end(reconcile_delta);
+      reconcile_auxid = auxid;
+      reconcile_sending = true;
+      reconcile_num_delta = reconcile_delta.size();
+      reconcile_num_queued = 0;
+    }
+    flowtable_reconcile_continue();
+    return;
+  }
+
   crofdpt_env::call_env(env).handle_flow_stats_reply(*this, auxid, reply);
 }
 
@@ -670,6 +721,14 @@ void crofdpt::experimenter_stats_reply_rcvd(const rofl::cauxid &auxid,
                                                              reply);
 }
 
+void crofdpt::flow_monitor_reply_rcvd(const rofl::cauxid &auxid,
+                                      rofl::openflow::cofmsg *msg) {
+  rofl::openflow::cofmsg_flow_monitor_reply &reply =
+      dynamic_cast<rofl::openflow::cofmsg_flow_monitor_reply &>(*msg);
+
+  crofdpt_env::call_env(env).handle_flow_monitor_reply(*this, auxid, reply);
+}
+
 void crofdpt::barrier_reply_rcvd(const rofl::cauxid &auxid,
                                  rofl::openflow::cofmsg *msg) {
   rofl::openflow::cofmsg_barrier_reply &reply =
@@ -678,11 +737,48 @@ void crofdpt::barrier_reply_rcvd(const rofl::cauxid &auxid,
   crofdpt_env::call_env(env).handle_barrier_reply(*this, auxid, reply);
 }
 
+void crofdpt::bundle_control_rcvd(const rofl::cauxid &auxid,
+                                  rofl::openflow::cofmsg *msg) {
+  rofl::openflow::cofmsg_bundle_control &reply =
+      dynamic_cast<rofl::openflow::cofmsg_bundle_control &>(*msg);
+
+  cbundle_pending bundle;
+  bool committed =
+      (reply.get_ctrl_type() == rofl::openflow14::OFPBCT_COMMIT_REPLY) &&
+      bundle_done(reply.get_xid(), bundle);
+
+  crofdpt_env::call_env(env).handle_bundle_control_reply(*this, auxid, reply);
+
+  if (committed) {
+    crofdpt_env::call_env(env).handle_bundle_committed(*this, auxid,
+                                                       bundle.bundle_id);
+  }
+}
+
+bool crofdpt::bundle_done(uint32_t xid, cbundle_pending &bundle) {
+  AcquireReadWriteLock rwlock(bundles_lock);
+  for (std::map<uint32_t, cbundle_pending>::iterator it = bundles.begin();
+       it != bundles.end(); ++it) {
+    if (it->second.has_xid(xid)) {
+      bundle = it->second;
+      bundles.erase(it);
+      return true;
+    }
+  }
+  return false;
+}
+
 void crofdpt::flow_removed_rcvd(const rofl::cauxid &auxid,
                                 rofl::openflow::cofmsg *msg) {
   rofl::openflow::cofmsg_flow_removed &flow_removed =
       dynamic_cast<rofl::openflow::cofmsg_flow_removed &>(*msg);
 
+  if (shadow) {
+    flowtable.flow_removed(flow_removed.get_table_id(),
+                           flow_removed.get_priority(),
+                           flow_removed.get_match());
+  }
+
   crofdpt_env::call_env(env).handle_flow_removed(*this, auxid, flow_removed);
 }
 
@@ -720,6 +816,22 @@ void crofdpt::port_status_rcvd(const rofl::cauxid &auxid,
   crofdpt_env::call_env(env).handle_port_status(*this, auxid, port_status);
 }
 
+void crofdpt::role_status_rcvd(const rofl::cauxid &auxid,
+                               rofl::openflow::cofmsg *msg) {
+  rofl::openflow::cofmsg_role_status &role_status =
+      dynamic_cast<rofl::openflow::cofmsg_role_status &>(*msg);
+
+  crofdpt_env::call_env(env).handle_role_status(*this, auxid, role_status);
+}
+
+void crofdpt::table_status_rcvd(const rofl::cauxid &auxid,
+                                rofl::openflow::cofmsg *msg) {
+  rofl::openflow::cofmsg_table_status &table_status =
+      dynamic_cast<rofl::openflow::cofmsg_table_status &>(*msg);
+
+  crofdpt_env::call_env(env).handle_table_status(*this, auxid, table_status);
+}
+
 void crofdpt::experimenter_rcvd(const rofl::cauxid &auxid,
                                 rofl::openflow::cofmsg *msg) {
   rofl::openflow::cofmsg_experimenter &exp =
@@ -734,6 +846,13 @@ void crofdpt::error_rcvd(const rofl::cauxid &auxid,
       dynamic_cast<rofl::openflow::cofmsg_error &>(*msg);
 
   crofdpt_env::call_env(env).handle_error_message(*this, auxid, error);
+
+  cbundle_pending bundle;
+  if (bundle_done(error.get_xid(), bundle)) {
+    crofdpt_env::call_env(env).handle_bundle_failed(
+        *this, auxid, bundle.bundle_id, error.get_err_type(),
+        error.get_err_code());
+  }
 }
 
 void crofdpt::role_reply_rcvd(const rofl::cauxid &auxid,
@@ -771,7 +890,8 @@ void crofdpt::flow_mod_reset() {
     fe.set_command(rofl::openflow12::OFPFC_DELETE);
     fe.set_table_id(rofl::openflow12::OFPTT_ALL /*all tables*/);
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     fe.set_command(rofl::openflow13::OFPFC_DELETE);
     fe.set_table_id(rofl::openflow13::OFPTT_ALL /*all tables*/);
   } break;
@@ -791,7 +911,8 @@ void crofdpt::group_mod_reset() {
     ge.set_command(openflow12::OFPGC_DELETE);
     ge.set_group_id(openflow12::OFPG_ALL);
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     ge.set_command(openflow13::OFPGC_DELETE);
     ge.set_group_id(openflow13::OFPG_ALL);
   } break;
@@ -818,7 +939,7 @@ crofdpt::send_features_request(const rofl::cauxid &auxid, int timeout_in_secs,
     }
 
     return rofchan.send_message(auxid, msg,
-                                ctimespec().expire_in(timeout_in_secs));
+                                ctimespec::deadline(timeout_in_secs));
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping message " << e.what();
@@ -845,7 +966,7 @@ crofdpt::send_get_config_request(const rofl::cauxid &auxid, int timeout_in_secs,
       *xid = __xid;
     }
     return rofchan.send_message(auxid, msg,
-                                ctimespec().expire_in(timeout_in_secs));
+                                ctimespec::deadline(timeout_in_secs));
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
@@ -871,7 +992,7 @@ crofdpt::send_desc_stats_request(const rofl::cauxid &auxid, uint16_t flags,
       *xid = __xid;
     }
     return rofchan.send_message(auxid, msg,
-                                ctimespec().expire_in(timeout_in_secs));
+                                ctimespec::deadline(timeout_in_secs));
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
@@ -898,7 +1019,7 @@ rofl::crofsock::msg_result_t crofdpt::send_flow_stats_request(
       *xid = __xid;
     }
     return rofchan.send_message(auxid, msg,
-                                ctimespec().expire_in(timeout_in_secs));
+                                ctimespec::deadline(timeout_in_secs));
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
@@ -925,7 +1046,7 @@ rofl::crofsock::msg_result_t crofdpt::send_aggr_stats_request(
       *xid = __xid;
     }
     return rofchan.send_message(auxid, msg,
-                                ctimespec().expire_in(timeout_in_secs));
+                                ctimespec::deadline(timeout_in_secs));
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
@@ -951,7 +1072,7 @@ crofdpt::send_table_stats_request(const rofl::cauxid &auxid, uint16_t flags,
       *xid = __xid;
     }
     return rofchan.send_message(auxid, msg,
-                                ctimespec().expire_in(timeout_in_secs));
+                                ctimespec::deadline(timeout_in_secs));
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
@@ -978,7 +1099,7 @@ rofl::crofsock::msg_result_t crofdpt::send_port_stats_request(
       *xid = __xid;
     }
     return rofchan.send_message(auxid, msg,
-                                ctimespec().expire_in(timeout_in_secs));
+                                ctimespec::deadline(timeout_in_secs));
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
@@ -1005,7 +1126,7 @@ rofl::crofsock::msg_result_t crofdpt::send_queue_stats_request(
       *xid = __xid;
     }
     return rofchan.send_message(auxid, msg,
-                                ctimespec().expire_in(timeout_in_secs));
+                                ctimespec::deadline(timeout_in_secs));
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
@@ -1032,7 +1153,7 @@ rofl::crofsock::msg_result_t crofdpt::send_group_stats_request(
       *xid = __xid;
     }
     return rofchan.send_message(auxid, msg,
-                                ctimespec().expire_in(timeout_in_secs));
+                                ctimespec::deadline(timeout_in_secs));
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
@@ -1059,7 +1180,7 @@ crofdpt::send_group_desc_stats_request(const rofl::cauxid &auxid,
       *xid = __xid;
     }
     return rofchan.send_message(auxid, msg,
-                                ctimespec().expire_in(timeout_in_secs));
+                                ctimespec::deadline(timeout_in_secs));
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
@@ -1086,7 +1207,7 @@ crofdpt::send_group_features_stats_request(const rofl::cauxid &auxid,
       *xid = __xid;
     }
     return rofchan.send_message(auxid, msg,
-                                ctimespec().expire_in(timeout_in_secs));
+                                ctimespec::deadline(timeout_in_secs));
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
@@ -1113,7 +1234,7 @@ crofdpt::send_table_features_stats_request(const rofl::cauxid &auxid,
       *xid = __xid;
     }
     return rofchan.send_message(auxid, msg,
-                                ctimespec().expire_in(timeout_in_secs));
+                                ctimespec::deadline(timeout_in_secs));
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
@@ -1139,7 +1260,7 @@ crofdpt::send_port_desc_stats_request(const rofl::cauxid &auxid, uint16_t flags,
       *xid = __xid;
     }
     return rofchan.send_message(auxid, msg,
-                                ctimespec().expire_in(timeout_in_secs));
+                                ctimespec::deadline(timeout_in_secs));
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
@@ -1167,7 +1288,7 @@ crofdpt::send_experimenter_stats_request(const rofl::cauxid &auxid,
       *xid = __xid;
     }
     return rofchan.send_message(auxid, msg,
-                                ctimespec().expire_in(timeout_in_secs));
+                                ctimespec::deadline(timeout_in_secs));
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
@@ -1194,7 +1315,7 @@ rofl::crofsock::msg_result_t crofdpt::send_meter_stats_request(
       *xid = __xid;
     }
     return rofchan.send_message(auxid, msg,
-                                ctimespec().expire_in(timeout_in_secs));
+                                ctimespec::deadline(timeout_in_secs));
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
@@ -1221,7 +1342,7 @@ rofl::crofsock::msg_result_t crofdpt::send_meter_config_stats_request(
       *xid = __xid;
     }
     return rofchan.send_message(auxid, msg,
-                                ctimespec().expire_in(timeout_in_secs));
+                                ctimespec::deadline(timeout_in_secs));
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
@@ -1248,7 +1369,34 @@ crofdpt::send_meter_features_stats_request(const rofl::cauxid &auxid,
       *xid = __xid;
     }
     return rofchan.send_message(auxid, msg,
-                                ctimespec().expire_in(timeout_in_secs));
+                                ctimespec::deadline(timeout_in_secs));
+
+  } catch (eRofConnNotConnected &e) {
+    VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
+    delete msg;
+    throw;
+  } catch (eRofQueueFull &e) {
+    VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
+    delete msg;
+    throw;
+  }
+}
+
+rofl::crofsock::msg_result_t crofdpt::send_flow_monitor_request(
+    const rofl::cauxid &auxid, uint16_t stats_flags,
+    const rofl::openflow::cofflowmonitorarray &monitors, int timeout_in_secs,
+    uint32_t *xid) {
+  rofl::openflow::cofmsg *msg = nullptr;
+  uint32_t __xid = ++xid_last;
+  try {
+    msg = new rofl::openflow::cofmsg_flow_monitor_request(
+        rofchan.get_version(), __xid, stats_flags, monitors);
+
+    if (xid != nullptr) {
+      *xid = __xid;
+    }
+    return rofchan.send_message(auxid, msg,
+                                ctimespec::deadline(timeout_in_secs));
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
@@ -1261,6 +1409,33 @@ crofdpt::send_meter_features_stats_request(const rofl::cauxid &auxid,
   }
 }
 
+rofl::crofsock::msg_result_t crofdpt::send_flow_monitor_add(
+    const rofl::cauxid &auxid, uint32_t monitor_id, uint8_t table_id,
+    uint32_t out_port, const rofl::openflow::cofmatch &match, uint16_t flags,
+    int timeout_in_secs, uint32_t *xid) {
+  rofl::openflow::cofflowmonitorarray monitors(rofchan.get_version());
+  monitors.add_flow_monitor(0)
+      .set_monitor_id(monitor_id)
+      .set_command(rofl::openflow14::OFPFMC_ADD)
+      .set_flags(flags)
+      .set_table_id(table_id)
+      .set_out_port(out_port)
+      .set_match(match);
+  return send_flow_monitor_request(auxid, 0, monitors, timeout_in_secs, xid);
+}
+
+rofl::crofsock::msg_result_t
+crofdpt::send_flow_monitor_delete(const rofl::cauxid &auxid,
+                                  uint32_t monitor_id, int timeout_in_secs,
+                                  uint32_t *xid) {
+  rofl::openflow::cofflowmonitorarray monitors(rofchan.get_version());
+  monitors.add_flow_monitor(0)
+      .set_monitor_id(monitor_id)
+      .set_command(rofl::openflow14::OFPFMC_DELETE)
+      .set_flags(0);
+  return send_flow_monitor_request(auxid, 0, monitors, timeout_in_secs, xid);
+}
+
 rofl::crofsock::msg_result_t
 crofdpt::send_packet_out_message(const rofl::cauxid &auxid, uint32_t buffer_id,
                                  uint32_t in_port,
@@ -1289,6 +1464,169 @@ crofdpt::send_packet_out_message(const rofl::cauxid &auxid, uint32_t buffer_id,
   }
 }
 
+rofl::crofsock::msg_result_t crofdpt::send_packet_out_messages(
+    const rofl::cauxid &auxid, const rofl::openflow::cofactions &actions,
+    const std::vector<rofl::openflow::cofpacket_out_frame> &frames,
+    size_t *num_queued) {
+  rofl::crofsock::msg_result_t msg_result = rofl::crofsock::MSG_IGNORED;
+  rofl::openflow::cofmsg_packed *msg = nullptr;
+  uint8_t version = rofchan.get_version();
+  size_t queued = 0;
+  size_t msgs_max = 0;
+
+  if (num_queued != nullptr) {
+    *num_queued = 0;
+  }
+
+  /* pack the shared action list once for all frames */
+  rofl::openflow::cofactions __actions(actions);
+  __actions.set_version(version);
+  rofl::cmemory packed_actions(__actions.length());
+  if (packed_actions.length() > 0) {
+    __actions.pack(packed_actions.somem(), packed_actions.length());
+  }
+
+  size_t hdrlen = (rofl::openflow10::OFP_VERSION == version)
+                      ? sizeof(struct rofl::openflow10::ofp_packet_out)
+                      : sizeof(struct rofl::openflow12::ofp_packet_out);
+
+  try {
+    for (auto &frame : frames) {
+      size_t msglen = hdrlen + packed_actions.length() + frame.datalen;
+
+      if (msglen > rofl::openflow::cofmsg_packed::MAX_LENGTH) {
+        throw eInvalid("crofdpt::send_packet_out_messages() frame too large",
+                       __FILE__, __FUNCTION__, __LINE__);
+      }
+
+      /* current block exhausted, hand it over to the channel */
+      if ((msg != nullptr) && ((msg->tailroom() < msglen) ||
+                               (msg->get_msgs_num() >= msgs_max))) {
+        msg_result = send_packed_block(auxid, msg, queued);
+        msg = nullptr;
+
+        /* stop on congestion or queueing failure */
+        if (msg_result != rofl::crofsock::MSG_QUEUED) {
+          break;
+        }
+      }
+
+      if (msg == nullptr) {
+        /* a block must not carry more messages than the txqueue accepts */
+        msgs_max =
+            rofchan.get_txqueue_capacity(auxid, rofl::crofsock::QUEUE_PKT);
+        if (0 == msgs_max) {
+          msg_result = rofl::crofsock::MSG_QUEUEING_FAILED_QUEUE_FULL;
+          break;
+        }
+      }
+
+      uint32_t __xid = ++xid_last;
+
+      if (msg == nullptr) {
+        msg = new rofl::openflow::cofmsg_packed(
+            version, rofl::openflow::OFPT_PACKET_OUT, __xid);
+      }
+
+      uint8_t *buf = msg->append(msglen);
+
+      switch (version) {
+      case rofl::openflow10::OFP_VERSION: {
+        struct rofl::openflow10::ofp_packet_out *hdr =
+            (struct rofl::openflow10::ofp_packet_out *)buf;
+
+        hdr->buffer_id = htobe32(frame.buffer_id);
+        hdr->in_port = htobe16(frame.in_port & 0x0000ffff);
+        hdr->actions_len = htobe16(packed_actions.length());
+      } break;
+      default: {
+        struct rofl::openflow12::ofp_packet_out *hdr =
+            (struct rofl::openflow12::ofp_packet_out *)buf;
+
+        hdr->buffer_id = htobe32(frame.buffer_id);
+        hdr->in_port = htobe32(frame.in_port);
+        hdr->actions_len = htobe16(packed_actions.length());
+        memset(hdr->pad, 0, sizeof(hdr->pad));
+      };
+      }
+
+      struct rofl::openflow::ofp_header *ofh =
+          (struct rofl::openflow::ofp_header *)buf;
+
+      ofh->version = version;
+      ofh->type = rofl::openflow::OFPT_PACKET_OUT;
+      ofh->length = htobe16(msglen);
+      ofh->xid = htobe32(__xid);
+
+      if (packed_actions.length() > 0) {
+        memcpy(buf + hdrlen, packed_actions.somem(), packed_actions.length());
+      }
+      if ((frame.data != nullptr) && (frame.datalen > 0)) {
+        memcpy(buf + hdrlen + packed_actions.length(), frame.data,
+               frame.datalen);
+      }
+    }
+
+    if (msg != nullptr) {
+      msg_result = send_packed_block(auxid, msg, queued);
+      msg = nullptr;
+    }
+
+    if (num_queued != nullptr) {
+      *num_queued = queued;
+    }
+    return msg_result;
+
+  } catch (eRofConnNotConnected &e) {
+    VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
+    if (num_queued != nullptr) {
+      *num_queued = queued;
+    }
+    delete msg;
+    throw;
+  } catch (...) {
+    if (num_queued != nullptr) {
+      *num_queued = queued;
+    }
+    delete msg;
+    throw;
+  }
+}
+
+rofl::crofsock::msg_result_t crofdpt::send_packet_out_message(
+    const rofl::cauxid &auxid,
+    const std::shared_ptr<const rofl::cmemory> &image, uint32_t *xid) {
+  rofl::openflow::cofmsg *msg = nullptr;
+  uint32_t __xid = ++xid_last;
+  try {
+    msg = new rofl::openflow::cofmsg_shared(image, __xid);
+
+    if (msg->get_version() != rofchan.get_version()) {
+      throw eBadVersion("crofdpt::send_packet_out_message() image version "
+                        "mismatch",
+                        __FILE__, __FUNCTION__, __LINE__);
+    }
+    if (msg->get_type() != rofl::openflow::OFPT_PACKET_OUT) {
+      throw eInvalid("crofdpt::send_packet_out_message() image is not a "
+                     "Packet-Out message",
+                     __FILE__, __FUNCTION__, __LINE__);
+    }
+
+    if (xid != nullptr) {
+      *xid = __xid;
+    }
+    return rofchan.send_message(auxid, msg);
+
+  } catch (eRofConnNotConnected &e) {
+    VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
+    delete msg;
+    throw;
+  } catch (...) {
+    delete msg;
+    throw;
+  }
+}
+
 rofl::crofsock::msg_result_t
 crofdpt::send_barrier_request(const rofl::cauxid &auxid, int timeout_in_secs,
                               uint32_t *xid) {
@@ -1302,7 +1640,33 @@ crofdpt::send_barrier_request(const rofl::cauxid &auxid, int timeout_in_secs,
       *xid = __xid;
     }
     return rofchan.send_message(auxid, msg,
-                                ctimespec().expire_in(timeout_in_secs));
+                                ctimespec::deadline(timeout_in_secs));
+
+  } catch (eRofConnNotConnected &e) {
+    VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
+    delete msg;
+    throw;
+  } catch (eRofQueueFull &e) {
+    VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
+    delete msg;
+    throw;
+  }
+}
+
+rofl::crofsock::msg_result_t crofdpt::send_bundle_control_request(
+    const rofl::cauxid &auxid, uint32_t bundle_id, uint16_t ctrl_type,
+    uint16_t flags, int timeout_in_secs, uint32_t *xid) {
+  rofl::openflow::cofmsg *msg = nullptr;
+  uint32_t __xid = ++xid_last;
+  try {
+    msg = new rofl::openflow::cofmsg_bundle_control(
+        rofchan.get_version(), __xid, bundle_id, ctrl_type, flags);
+
+    if (xid != nullptr) {
+      *xid = __xid;
+    }
+    return rofchan.send_message(auxid, msg,
+                                ctimespec::deadline(timeout_in_secs));
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
@@ -1315,6 +1679,279 @@ crofdpt::send_barrier_request(const rofl::cauxid &auxid, int timeout_in_secs,
   }
 }
 
+rofl::crofsock::msg_result_t
+crofdpt::send_bundle(const rofl::cauxid &auxid,
+                     const rofl::openflow::cofbundle &bundle,
+                     int timeout_in_secs, size_t *num_queued) {
+  rofl::crofsock::msg_result_t msg_result = rofl::crofsock::MSG_IGNORED;
+  rofl::openflow::cofmsg *msg = nullptr;
+  uint8_t version = rofchan.get_version();
+  bool congested = false;
+  size_t queued = 0;
+
+  if (num_queued != nullptr) {
+    *num_queued = 0;
+  }
+
+  if ((version < rofl::openflow14::OFP_VERSION) ||
+      (bundle.get_version() != version)) {
+    throw eBadVersion("crofdpt::send_bundle() bundle version mismatch",
+                      __FILE__, __FUNCTION__, __LINE__);
+  }
+
+  /* retry Discard-Requests and bundles stopped by an exhausted txqueue */
+  bundle_discard_pending();
+  bundle_send_pending();
+
+  /* Open-Request, all Bundle-Add-Messages and Commit-Request use a
+   * contiguous range of xids */
+  uint32_t xid_open = (uint32_t)(xid_last.fetch_add(bundle.size() + 2) + 1);
+  uint32_t xid_commit = xid_open + (uint32_t)bundle.size() + 1;
+  cbundle_pending pending(auxid, bundle.get_bundle_id(), xid_open,
+                          xid_commit);
+
+  {
+    AcquireReadWriteLock rwlock(bundles_lock);
+    bundles[xid_commit] = pending;
+  }
+
+  try {
+    msg = new rofl::openflow::cofmsg_bundle_control(
+        version, pending.xid_first, pending.bundle_id,
+        rofl::openflow14::OFPBCT_OPEN_REQUEST, bundle.get_flags());
+    msg_result = rofchan.send_message(pending.auxid, msg,
+                                      ctimespec::deadline(timeout_in_secs));
+    msg = nullptr;
+  } catch (...) {
+    delete msg;
+    bundle_abort(pending, false);
+    throw;
+  }
+
+  if ((msg_result != rofl::crofsock::MSG_QUEUED) &&
+      (msg_result != rofl::crofsock::MSG_QUEUED_CONGESTION)) {
+    VLOG(1) << __FUNCTION__ << " bundle_id=" << bundle.get_bundle_id()
+            << " Open-Request not queued";
+    bundle_abort(pending, false);
+    return msg_result;
+  }
+  congested |= (msg_result == rofl::crofsock::MSG_QUEUED_CONGESTION);
+
+  size_t offset = 0;
+  uint32_t xid = pending.xid_first;
+  try {
+    msg_result = send_bundle_messages(pending, bundle, timeout_in_secs, offset,
+                                      xid, queued, congested);
+  } catch (...) {
+    VLOG(1) << __FUNCTION__ << " bundle_id=" << bundle.get_bundle_id()
+            << " incomplete, " << queued << " of " << bundle.size()
+            << " messages queued";
+    bundle_abort(pending, true);
+    if (num_queued != nullptr) {
+      *num_queued = queued;
+    }
+    throw;
+  }
+
+  if (num_queued != nullptr) {
+    *num_queued = queued;
+  }
+
+  if (msg_result == rofl::crofsock::MSG_QUEUEING_FAILED_QUEUE_FULL) {
+    VLOG(2) << __FUNCTION__ << " bundle_id=" << bundle.get_bundle_id()
+            << " txqueue exhausted, " << queued << " of " << bundle.size()
+            << " messages queued";
+    AcquireReadWriteLock rwlock(bundles_lock);
+    bundles_sending.push_back(
+        cbundle_sending(pending, bundle, offset, xid, timeout_in_secs));
+    return rofl::crofsock::MSG_QUEUED_CONGESTION;
+  }
+
+  if ((msg_result != rofl::crofsock::MSG_QUEUED) &&
+      (msg_result != rofl::crofsock::MSG_QUEUED_CONGESTION)) {
+    VLOG(1) << __FUNCTION__ << " bundle_id=" << bundle.get_bundle_id()
+            << " incomplete, " << queued << " of " << bundle.size()
+            << " messages queued";
+    bundle_abort(pending, true);
+    return msg_result;
+  }
+
+  return congested ? rofl::crofsock::MSG_QUEUED_CONGESTION : msg_result;
+}
+
+rofl::crofsock::msg_result_t crofdpt::send_bundle_messages(
+    const cbundle_pending &pending, const rofl::openflow::cofbundle &bundle,
+    int timeout_in_secs, size_t &offset, uint32_t &xid, size_t &queued,
+    bool &congested) {
+  rofl::crofsock::msg_result_t msg_result = rofl::crofsock::MSG_IGNORED;
+  rofl::openflow::cofmsg *msg = nullptr;
+  rofl::openflow::cofmsg_packed *pmsg = nullptr;
+  uint8_t version = bundle.get_version();
+  size_t msgs_max = 0;
+
+  try {
+    /* offset and xid advance only for blocks that have been queued */
+    size_t next = offset;
+    uint32_t next_xid = xid;
+    while ((next < bundle.length()) || (pmsg != nullptr)) {
+      size_t msglen = 0;
+      if (next < bundle.length()) {
+        const struct rofl::openflow::ofp_header *hdr =
+            (const struct rofl::openflow::ofp_header *)(bundle.somem() +
+                                                        next);
+        msglen = be16toh(hdr->length);
+      }
+
+      /* current block exhausted, hand it over to the channel */
+      if ((pmsg != nullptr) && (pmsg->get_msgs_num() > 0) &&
+          ((next == bundle.length()) || (pmsg->tailroom() < msglen) ||
+           (pmsg->get_msgs_num() >= msgs_max))) {
+        msg_result = send_packed_block(pending.auxid, pmsg, queued);
+        pmsg = nullptr;
+        if ((msg_result != rofl::crofsock::MSG_QUEUED) &&
+            (msg_result != rofl::crofsock::MSG_QUEUED_CONGESTION)) {
+          return msg_result;
+        }
+        congested |= (msg_result == rofl::crofsock::MSG_QUEUED_CONGESTION);
+        offset = next;
+        xid = next_xid;
+        continue;
+      }
+
+      if (pmsg == nullptr) {
+        /* a block must not carry more messages than the txqueue accepts */
+        msgs_max = rofchan.get_txqueue_capacity(pending.auxid,
+                                                rofl::crofsock::QUEUE_FLOW);
+        if (0 == msgs_max) {
+          return rofl::crofsock::MSG_QUEUEING_FAILED_QUEUE_FULL;
+        }
+        pmsg = new rofl::openflow::cofmsg_packed(
+            version, rofl::openflow14::OFPT_BUNDLE_ADD_MESSAGE, next_xid + 1);
+      }
+
+      ++next_xid;
+      next += bundle.copy_message(next, pmsg->append(msglen), msglen,
+                                  next_xid);
+    }
+
+    msg = new rofl::openflow::cofmsg_bundle_control(
+        version, pending.xid_last, pending.bundle_id,
+        rofl::openflow14::OFPBCT_COMMIT_REQUEST, bundle.get_flags());
+    msg_result = rofchan.send_message(pending.auxid, msg,
+                                      ctimespec::deadline(timeout_in_secs));
+    msg = nullptr;
+    congested |= (msg_result == rofl::crofsock::MSG_QUEUED_CONGESTION);
+
+    return msg_result;
+
+  } catch (...) {
+    delete msg;
+    delete pmsg;
+    throw;
+  }
+}
+
+void crofdpt::bundle_send_pending() {
+  std::list<cbundle_sending> sending;
+  {
+    AcquireReadWriteLock rwlock(bundles_lock);
+    if (bundles_sending.empty())
+      return;
+    sending.swap(bundles_sending);
+  }
+
+  /* resume bundles in order, later ones must not overtake a bundle still
+   * waiting for the txqueue */
+  while (not sending.empty()) {
+    cbundle_sending &entry = sending.front();
+    rofl::crofsock::msg_result_t msg_result = rofl::crofsock::MSG_IGNORED;
+    size_t queued = 0;
+    bool congested = false;
+
+    try {
+      msg_result =
+          send_bundle_messages(entry.pending, entry.bundle,
+                               entry.timeout_in_secs, entry.offset, entry.xid,
+                               queued, congested);
+    } catch (rofl::exception &e) {
+      VLOG(1) << __FUNCTION__ << " bundle_id=" << entry.pending.bundle_id
+              << " " << e.what();
+    }
+
+    if (msg_result == rofl::crofsock::MSG_QUEUEING_FAILED_QUEUE_FULL)
+      break;
+
+    if ((msg_result != rofl::crofsock::MSG_QUEUED) &&
+        (msg_result != rofl::crofsock::MSG_QUEUED_CONGESTION)) {
+      VLOG(1) << __FUNCTION__ << " bundle_id=" << entry.pending.bundle_id
+              << " incomplete, dropping bundle";
+      bundle_abort(entry.pending, true);
+      crofdpt_env::call_env(env).handle_bundle_failed(
+          *this, entry.pending.auxid, entry.pending.bundle_id,
+          rofl::openflow14::OFPET_BUNDLE_FAILED,
+          rofl::openflow14::OFPBFC_UNKNOWN);
+    }
+    sending.pop_front();
+  }
+
+  if (sending.empty())
+    return;
+
+  /* bundles parked by send_bundle() meanwhile queue up behind */
+  AcquireReadWriteLock rwlock(bundles_lock);
+  bundles_sending.splice(bundles_sending.begin(), sending);
+}
+
+void crofdpt::bundle_abort(const cbundle_pending &pending, bool opened) {
+  {
+    AcquireReadWriteLock rwlock(bundles_lock);
+    bundles.erase(pending.xid_last);
+  }
+  /* an open bundle would occupy the datapath's resources until the
+   * connection is closed */
+  if (opened) {
+    bundle_discard(pending);
+  }
+}
+
+void crofdpt::bundle_discard(const cbundle_pending &pending) {
+  rofl::crofsock::msg_result_t msg_result = rofl::crofsock::MSG_IGNORED;
+  rofl::openflow::cofmsg *msg = nullptr;
+  try {
+    msg = new rofl::openflow::cofmsg_bundle_control(
+        rofchan.get_version(), ++xid_last, pending.bundle_id,
+        rofl::openflow14::OFPBCT_DISCARD_REQUEST, 0);
+    msg_result = rofchan.send_message(pending.auxid, msg);
+    msg = nullptr;
+  } catch (rofl::exception &e) {
+    /* connection lost, the datapath drops the bundle on its own */
+    VLOG(1) << __FUNCTION__ << " bundle_id=" << pending.bundle_id << " "
+            << e.what();
+    delete msg;
+    return;
+  }
+
+  if (msg_result == rofl::crofsock::MSG_QUEUEING_FAILED_QUEUE_FULL) {
+    VLOG(1) << __FUNCTION__ << " bundle_id=" << pending.bundle_id
+            << " txqueue exhausted, Discard-Request deferred";
+    AcquireReadWriteLock rwlock(bundles_lock);
+    bundles_discard.push_back(pending);
+  }
+}
+
+void crofdpt::bundle_discard_pending() {
+  std::vector<cbundle_pending> discard;
+  {
+    AcquireReadWriteLock rwlock(bundles_lock);
+    if (bundles_discard.empty())
+      return;
+    discard.swap(bundles_discard);
+  }
+  for (auto &pending : discard) {
+    bundle_discard(pending);
+  }
+}
+
 rofl::crofsock::msg_result_t
 crofdpt::send_role_request(const rofl::cauxid &auxid,
                            const rofl::openflow::cofrole &role,
@@ -1329,7 +1966,7 @@ crofdpt::send_role_request(const rofl::cauxid &auxid,
       *xid = __xid;
     }
     return rofchan.send_message(auxid, msg,
-                                ctimespec().expire_in(timeout_in_secs));
+                                ctimespec::deadline(timeout_in_secs));
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
@@ -1351,6 +1988,48 @@ crofdpt::send_flow_mod_message(const rofl::cauxid &auxid,
   try {
     msg = new rofl::openflow::cofmsg_flow_mod(rofchan.get_version(), __xid, fe);
 
+    if (xid != nullptr) {
+      *xid = __xid;
+    }
+    rofl::crofsock::msg_result_t msg_result = rofchan.send_message(auxid, msg);
+
+    if ((msg_result == rofl::crofsock::MSG_QUEUED) ||
+        (msg_result == rofl::crofsock::MSG_QUEUED_CONGESTION)) {
+      flowtable_update(fe);
+    }
+    return msg_result;
+
+  } catch (eRofConnNotConnected &e) {
+    VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
+    delete msg;
+    throw;
+  } catch (eRofQueueFull &e) {
+    VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
+    delete msg;
+    throw;
+  }
+}
+
+rofl::crofsock::msg_result_t
+crofdpt::send_flow_mod_message(const rofl::cauxid &auxid,
+                               rofl::openflow::cofflowmodtemplate &tmpl,
+                               uint32_t *xid) {
+  rofl::openflow::cofmsg_packed *msg = nullptr;
+  uint32_t __xid = ++xid_last;
+  try {
+    if (tmpl.get_version() != rofchan.get_version()) {
+      throw eBadVersion("crofdpt::send_flow_mod_message() template version "
+                        "mismatch",
+                        __FILE__, __FUNCTION__, __LINE__);
+    }
+
+    msg = new rofl::openflow::cofmsg_packed(
+        rofchan.get_version(), rofl::openflow::OFPT_FLOW_MOD, __xid,
+        tmpl.length());
+
+    tmpl.set_xid(__xid);
+    tmpl.pack(msg->append(tmpl.length()), tmpl.length());
+
     if (xid != nullptr) {
       *xid = __xid;
     }
@@ -1367,6 +2046,244 @@ crofdpt::send_flow_mod_message(const rofl::cauxid &auxid,
   }
 }
 
+rofl::crofsock::msg_result_t crofdpt::send_flow_mod_messages(
+    const rofl::cauxid &auxid,
+    const std::vector<rofl::openflow::cofflowmod> &flowmods,
+    size_t *num_queued) {
+  rofl::crofsock::msg_result_t msg_result = rofl::crofsock::MSG_IGNORED;
+  rofl::openflow::cofmsg_packed *msg = nullptr;
+  uint8_t version = rofchan.get_version();
+  size_t queued = 0;
+  size_t msgs_max = 0;
+
+  if (num_queued != nullptr) {
+    *num_queued = 0;
+  }
+
+  try {
+    for (auto &entry : flowmods) {
+      /* pack() leaves entries unchanged, but is not const qualified
+       * throughout the OpenFlow classes */
+      rofl::openflow::cofflowmod *flowmod =
+          const_cast<rofl::openflow::cofflowmod *>(&entry);
+      rofl::openflow::cofflowmod fe;
+      if (entry.get_version() != version) {
+        fe = entry;
+        fe.set_version(version);
+        flowmod = &fe;
+      }
+
+      size_t msglen =
+          sizeof(struct rofl::openflow::ofp_header) + flowmod->length();
+
+      if (msglen > rofl::openflow::cofmsg_packed::MAX_LENGTH) {
+        throw eInvalid("crofdpt::send_flow_mod_messages() flowmod too large",
+                       __FILE__, __FUNCTION__, __LINE__);
+      }
+
+      /* current block exhausted, hand it over to the channel */
+      if ((msg != nullptr) && ((msg->tailroom() < msglen) ||
+                               (msg->get_msgs_num() >= msgs_max))) {
+        msg_result = send_packed_block(auxid, msg, queued);
+        msg = nullptr;
+
+        /* stop on congestion or queueing failure */
+        if (msg_result != rofl::crofsock::MSG_QUEUED) {
+          break;
+        }
+      }
+
+      if (msg == nullptr) {
+        /* a block must not carry more messages than the txqueue accepts */
+        msgs_max = rofchan.get_txqueue_capacity(auxid,
+                                                rofl::crofsock::QUEUE_FLOW);
+        if (0 == msgs_max) {
+          msg_result = rofl::crofsock::MSG_QUEUEING_FAILED_QUEUE_FULL;
+          break;
+        }
+      }
+
+      uint32_t __xid = ++xid_last;
+
+      if (msg == nullptr) {
+        msg = new rofl::openflow::cofmsg_packed(
+            version, rofl::openflow::OFPT_FLOW_MOD, __xid);
+      }
+
+      struct rofl::openflow::ofp_header *hdr =
+          (struct rofl::openflow::ofp_header *)msg->append(msglen);
+
+      hdr->version = version;
+      hdr->type = rofl::openflow::OFPT_FLOW_MOD;
+      hdr->length = htobe16(msglen);
+      hdr->xid = htobe32(__xid);
+
+      flowmod->pack(hdr->body, flowmod->length());
+    }
+
+    if (msg != nullptr) {
+      msg_result = send_packed_block(auxid, msg, queued);
+      msg = nullptr;
+    }
+
+    flowtable_update(flowmods, queued);
+    if (num_queued != nullptr) {
+      *num_queued = queued;
+    }
+    return msg_result;
+
+  } catch (eRofConnNotConnected &e) {
+    VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
+    flowtable_update(flowmods, queued);
+    if (num_queued != nullptr) {
+      *num_queued = queued;
+    }
+    delete msg;
+    throw;
+  } catch (...) {
+    flowtable_update(flowmods, queued);
+    if (num_queued != nullptr) {
+      *num_queued = queued;
+    }
+    delete msg;
+    throw;
+  }
+}
+
+rofl::crofsock::msg_result_t
+crofdpt::send_packed_block(const rofl::cauxid &auxid,
+                           rofl::openflow::cofmsg_packed *msg,
+                           size_t &queued) {
+  size_t msgs_num = msg->get_msgs_num();
+  rofl::crofsock::msg_result_t msg_result = rofchan.send_message(auxid, msg);
+
+  if ((msg_result == rofl::crofsock::MSG_QUEUED) ||
+      (msg_result == rofl::crofsock::MSG_QUEUED_CONGESTION)) {
+    queued += msgs_num;
+  }
+  return msg_result;
+}
+
+void crofdpt::flowtable_update(const rofl::openflow::cofflowmod &flowmod) {
+  if (not shadow)
+    return;
+  if (flowtable.get_version() != rofchan.get_version()) {
+    flowtable.set_version(rofchan.get_version());
+  }
+  if (flowmod.get_version() == rofchan.get_version()) {
+    flowtable.flow_mod(flowmod);
+  } else {
+    rofl::openflow::cofflowmod fe(flowmod);
+    fe.set_version(rofchan.get_version());
+    flowtable.flow_mod(fe);
+  }
+}
+
+void crofdpt::flowtable_update(
+    const std::vector<rofl::openflow::cofflowmod> &flowmods, size_t num) {
+  if (not shadow)
+    return;
+  for (size_t i = 0; (i < num) && (i < flowmods.size()); i++) {
+    flowtable_update(flowmods[i]);
+  }
+}
+
+void crofdpt::flowtable_reconcile_continue(bool abort) {
+  rofl::cauxid auxid(0);
+  size_t num_delta = 0;
+  size_t num_queued = 0;
+
+  {
+    AcquireReadWriteLock rwlock(reconcile_lock);
+    if (not reconcile_sending)
+      return;
+
+    if (not abort && not reconcile_delta.empty()) {
+      size_t queued = 0;
+      /* applying the delta to the shadow table again is idempotent */
+      try {
+        send_flow_mod_messages(reconcile_auxid, reconcile_delta, &queued);
+      } catch (rofl::exception &e) {
+        VLOG(1) << __FUNCTION__ << " reconciliation failed: " << e.what();
+        abort = true;
+      }
+      reconcile_delta.erase(reconcile_delta.begin(),
+                            reconcile_delta.begin() + queued);
+      reconcile_num_queued += queued;
+    }
+
+    /* txqueue exhausted, wait for congestion_solved_indication() */
+    if (not abort && not reconcile_delta.empty())
+      return;
+
+    if (not reconcile_delta.empty()) {
+      VLOG(1) << __FUNCTION__ << " dropping " << reconcile_delta.size()
+              << " Flow-Mods of reconciliation";
+    }
+
+    auxid = reconcile_auxid;
+    num_delta = reconcile_num_delta;
+    num_queued = reconcile_num_queued;
+    reconcile_delta.clear();
+    reconcile_sending = false;
+  }
+
+  crofdpt_env::call_env(env).handle_flow_table_reconciled(
+      *this, auxid, num_delta, num_queued);
+}
+
+rofl::crofsock::msg_result_t
+crofdpt::reconcile_flowtable(const rofl::cauxid &auxid, int timeout_in_secs,
+                             uint32_t *xid) {
+  if (not shadow) {
+    throw eInvalid("crofdpt::reconcile_flowtable() shadowing disabled",
+                   __FILE__, __FUNCTION__, __LINE__);
+  }
+
+  rofl::openflow::cofmsg *msg = nullptr;
+  uint32_t __xid = ++xid_last;
+
+  if (flowtable.get_version() != rofchan.get_version()) {
+    flowtable.set_version(rofchan.get_version());
+  }
+
+  /* Flow-Mods still pending from a previous run are superseded */
+  flowtable_reconcile_continue(true);
+
+  /* the reply may arrive before send_message() returns */
+  reconcile_xid = __xid;
+  flowtable.reconcile_begin();
+
+  try {
+    msg = new rofl::openflow::cofmsg_flow_stats_request(
+        rofchan.get_version(), __xid, 0,
+        rofl::openflow::cofflow_stats_request(rofchan.get_version()));
+
+    if (xid != nullptr) {
+      *xid = __xid;
+    }
+    rofl::crofsock::msg_result_t msg_result = rofchan.send_message(
+        auxid, msg, ctimespec::deadline(timeout_in_secs));
+
+    if ((msg_result != rofl::crofsock::MSG_QUEUED) &&
+        (msg_result != rofl::crofsock::MSG_QUEUED_CONGESTION)) {
+      flowtable.reconcile_abort();
+    }
+    return msg_result;
+
+  } catch (eRofConnNotConnected &e) {
+    VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
+    flowtable.reconcile_abort();
+    delete msg;
+    throw;
+  } catch (eRofQueueFull &e) {
+    VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
+    flowtable.reconcile_abort();
+    delete msg;
+    throw;
+  }
+}
+
 rofl::crofsock::msg_result_t
 crofdpt::send_group_mod_message(const rofl::cauxid &auxid,
                                 const rofl::openflow::cofgroupmod &ge,
@@ -1495,7 +2412,7 @@ crofdpt::send_queue_get_config_request(const rofl::cauxid &auxid, uint32_t port,
       *xid = __xid;
     }
     return rofchan.send_message(auxid, msg,
-                                ctimespec().expire_in(timeout_in_secs));
+                                ctimespec::deadline(timeout_in_secs));
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
@@ -1521,7 +2438,7 @@ crofdpt::send_get_async_config_request(const rofl::cauxid &auxid,
       *xid = __xid;
     }
     return rofchan.send_message(auxid, msg,
-                                ctimespec().expire_in(timeout_in_secs));
+                                ctimespec::deadline(timeout_in_secs));
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
@@ -1617,7 +2534,7 @@ rofl::crofsock::msg_result_t crofdpt::send_experimenter_message(
 
     if (timeout_in_secs > 0) {
       return rofchan.send_message(auxid, msg,
-                                  ctimespec().expire_in(timeout_in_secs));
+                                  ctimespec::deadline(timeout_in_secs));
     } else {
       return rofchan.send_message(auxid, msg);
     }
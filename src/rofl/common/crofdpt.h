@@ -17,10 +17,13 @@
 #include <atomic>
 #include <bitset>
 #include <inttypes.h>
+#include <list>
 #include <map>
+#include <memory>
 #include <set>
 #include <stdio.h>
 #include <strings.h>
+#include <vector>
 
 #include "rofl/common/cmemory.h"
 
@@ -33,7 +36,11 @@
 #include "rofl/common/exception.hpp"
 
 #include "rofl/common/openflow/cofasyncconfig.h"
+#include "rofl/common/openflow/cofbundle.h"
 #include "rofl/common/openflow/cofflowmod.h"
+#include "rofl/common/openflow/cofflowmodtemplate.h"
+#include "rofl/common/openflow/cofflowmonitorarray.h"
+#include "rofl/common/openflow/cofflowtable.h"
 #include "rofl/common/openflow/cofgroupmod.h"
 #include "rofl/common/openflow/cofhelloelemversionbitmap.h"
 #include "rofl/common/openflow/cofmeterbands.h"
@@ -423,6 +430,26 @@ protected:
   virtual void handle_flow_stats_reply_timeout(rofl::crofdpt &dpt,
                                                uint32_t xid){};
 
+  /**
+   * @brief	Reconciliation of shadow flow table has finished.
+   *
+   * Called once per reconciliation, after all Flow-Mods have been queued
+   * or when the remaining ones have been given up (control channel lost,
+   * reconciliation superseded). Flow-Mods stopped by an exhausted txqueue
+   * are kept by crofdpt and sent once congestion has been solved or
+   * crofdpt::resume_flowtable_reconciliation() is called, so num_queued is
+   * less than num_delta only if Flow-Mods have been given up.
+   *
+   * @param dpt datapath instance
+   * @param auxid control connection identifier
+   * @param num_delta number of Flow-Mods required for reconciliation
+   * @param num_queued number of Flow-Mods queued for transmission
+   */
+  virtual void handle_flow_table_reconciled(rofl::crofdpt &dpt,
+                                            const rofl::cauxid &auxid,
+                                            size_t num_delta,
+                                            size_t num_queued){};
+
   /**
    * @brief	OpenFlow Aggregate-Stats-Reply message received.
    *
@@ -697,6 +724,33 @@ protected:
   virtual void handle_experimenter_stats_reply_timeout(rofl::crofdpt &dpt,
                                                        uint32_t xid){};
 
+  /**
+   * @brief	OpenFlow Flow-Monitor-Reply message received.
+   *
+   * Carries the flows initially matching a new flow monitor as well as
+   * unsolicited add/modify/delete updates sent by the datapath afterwards.
+   *
+   * @param dpt datapath instance
+   * @param auxid control connection identifier
+   * @param msg OpenFlow message instance
+   */
+  virtual void
+  handle_flow_monitor_reply(rofl::crofdpt &dpt, const rofl::cauxid &auxid,
+                            rofl::openflow::cofmsg_flow_monitor_reply &msg){};
+
+  /**
+   * @brief	Timer expired while waiting for OpenFlow Flow-Monitor-Reply
+   * message.
+   *
+   * No Flow-Monitor-Reply message was received in the specified time
+   * interval for the given OpenFlow transaction identifier.
+   *
+   * @param dpt datapath instance
+   * @param xid OpenFlow transaction identifier
+   */
+  virtual void handle_flow_monitor_reply_timeout(rofl::crofdpt &dpt,
+                                                 uint32_t xid){};
+
   /**
    * @brief	OpenFlow Packet-In message received.
    *
@@ -729,6 +783,56 @@ protected:
    */
   virtual void handle_barrier_reply_timeout(rofl::crofdpt &dpt, uint32_t xid){};
 
+  /**
+   * @brief	OpenFlow Bundle-Control message received.
+   *
+   * @param dpt datapath instance
+   * @param auxid control connection identifier
+   * @param msg OpenFlow message instance
+   */
+  virtual void
+  handle_bundle_control_reply(rofl::crofdpt &dpt, const rofl::cauxid &auxid,
+                              rofl::openflow::cofmsg_bundle_control &msg){};
+
+  /**
+   * @brief	Timer expired while waiting for OpenFlow Bundle-Control reply.
+   *
+   * @param dpt datapath instance
+   * @param xid OpenFlow transaction identifier
+   */
+  virtual void handle_bundle_control_reply_timeout(rofl::crofdpt &dpt,
+                                                   uint32_t xid){};
+
+  /**
+   * @brief	Bundle sent via crofdpt::send_bundle() has been committed.
+   *
+   * @param dpt datapath instance
+   * @param auxid control connection identifier
+   * @param bundle_id OpenFlow bundle identifier
+   */
+  virtual void handle_bundle_committed(rofl::crofdpt &dpt,
+                                       const rofl::cauxid &auxid,
+                                       uint32_t bundle_id){};
+
+  /**
+   * @brief	Bundle sent via crofdpt::send_bundle() has failed.
+   *
+   * Called for the first Error message referring to one of the bundle's
+   * messages or when the Open- or Commit-Request timed out (type
+   * OFPET_BUNDLE_FAILED, code OFPBFC_TIMEOUT). The Error message itself
+   * is delivered via handle_error_message() as well.
+   *
+   * @param dpt datapath instance
+   * @param auxid control connection identifier
+   * @param bundle_id OpenFlow bundle identifier
+   * @param err_type OpenFlow error type
+   * @param err_code OpenFlow error code
+   */
+  virtual void handle_bundle_failed(rofl::crofdpt &dpt,
+                                    const rofl::cauxid &auxid,
+                                    uint32_t bundle_id, uint16_t err_type,
+                                    uint16_t err_code){};
+
   /**
    * @brief	OpenFlow Flow-Removed message received.
    *
@@ -750,6 +854,27 @@ protected:
   virtual void handle_port_status(rofl::crofdpt &dpt, const rofl::cauxid &auxid,
                                   rofl::openflow::cofmsg_port_status &msg){};
 
+  /**
+   * @brief	OpenFlow Role-Status message received (OpenFlow 1.4 and beyond).
+   *
+   * @param dpt datapath instance
+   * @param auxid control connection identifier
+   * @param msg OpenFlow message instance
+   */
+  virtual void handle_role_status(rofl::crofdpt &dpt, const rofl::cauxid &auxid,
+                                  rofl::openflow::cofmsg_role_status &msg){};
+
+  /**
+   * @brief	OpenFlow Table-Status message received (OpenFlow 1.4 and beyond).
+   *
+   * @param dpt datapath instance
+   * @param auxid control connection identifier
+   * @param msg OpenFlow message instance
+   */
+  virtual void handle_table_status(rofl::crofdpt &dpt,
+                                   const rofl::cauxid &auxid,
+                                   rofl::openflow::cofmsg_table_status &msg){};
+
   /**
    * @brief	OpenFlow Queue-Get-Config-Reply message received.
    *
@@ -940,6 +1065,39 @@ public:
     return *this;
   };
 
+  /**
+   * @brief	Returns true when shadowing of flow tables is enabled
+   */
+  bool get_flowtable_shadowing() const { return shadow; };
+
+  /**
+   * @brief	Enables/disables shadowing of flow tables
+   *
+   * When enabled, all Flow-Mods sent via send_flow_mod_message() and
+   * send_flow_mod_messages() and all Flow-Removed messages received
+   * update a shadow copy of the datapath's flow tables. Flow-Mods
+   * generated from precompiled templates bypass the shadow table.
+   */
+  crofdpt &set_flowtable_shadowing(bool shadow) {
+    this->shadow = shadow;
+    if (not shadow) {
+      flowtable.clear();
+    }
+    return *this;
+  };
+
+  /**
+   * @brief	Returns const reference to shadow flow table
+   */
+  const rofl::openflow::cofflowtable &get_flowtable() const {
+    return flowtable;
+  };
+
+  /**
+   * @brief	Returns reference to shadow flow table
+   */
+  rofl::openflow::cofflowtable &set_flowtable() { return flowtable; };
+
   /**
    * @brief	Returns OpenFlow datapath identifier for this instance
    *
@@ -1403,6 +1561,69 @@ public:
       const rofl::cauxid &auxid, uint16_t stats_flags,
       int timeout_in_secs = DEFAULT_REQUEST_TIMEOUT, uint32_t *xid = nullptr);
 
+  /**
+   * @brief	Sends OpenFlow Flow-Monitor-Request message to attached datapath
+   * element.
+   *
+   * Adds, modifies or removes flow monitors on the datapath element. Once
+   * established, the datapath reports changes to matching flows via
+   * crofdpt_env::handle_flow_monitor_reply(), which replaces periodic
+   * polling by means of Flow-Stats-Requests (OpenFlow 1.4 only).
+   *
+   * @param auxid controller connection identifier
+   * @param stats_flags OpenFlow statistics flags
+   * @param monitors OpenFlow Flow-Monitor-Request payload
+   * @param timeout until this request expires
+   * @return OpenFlow transaction ID assigned to this request
+   * @exception rofl::eRofBaseNotConnected
+   * @exception rofl::eRofBaseCongested
+   */
+  rofl::crofsock::msg_result_t send_flow_monitor_request(
+      const rofl::cauxid &auxid, uint16_t stats_flags,
+      const rofl::openflow::cofflowmonitorarray &monitors,
+      int timeout_in_secs = DEFAULT_REQUEST_TIMEOUT, uint32_t *xid = nullptr);
+
+  /**
+   * @brief	Subscribes to changes of flows matching the given filter.
+   *
+   * @param auxid controller connection identifier
+   * @param monitor_id controller assigned flow monitor identifier
+   * @param table_id table to monitor or OFPTT_ALL
+   * @param out_port required output port or OFPP_ANY
+   * @param match fields flows must match
+   * @param flags OpenFlow flow monitor flags (OFPFMF_*)
+   * @param timeout until this request expires
+   * @return OpenFlow transaction ID assigned to this request
+   * @exception rofl::eRofBaseNotConnected
+   * @exception rofl::eRofBaseCongested
+   */
+  rofl::crofsock::msg_result_t send_flow_monitor_add(
+      const rofl::cauxid &auxid, uint32_t monitor_id,
+      uint8_t table_id = rofl::openflow14::OFPTT_ALL,
+      uint32_t out_port = rofl::openflow14::OFPP_ANY,
+      const rofl::openflow::cofmatch &match = rofl::openflow::cofmatch(
+          rofl::openflow::FLOW_MONITOR_INNER_VERSION),
+      uint16_t flags = rofl::openflow14::OFPFMF_INITIAL |
+                       rofl::openflow14::OFPFMF_ADD |
+                       rofl::openflow14::OFPFMF_REMOVED |
+                       rofl::openflow14::OFPFMF_MODIFY,
+      int timeout_in_secs = DEFAULT_REQUEST_TIMEOUT, uint32_t *xid = nullptr);
+
+  /**
+   * @brief	Cancels a flow monitor established via send_flow_monitor_add().
+   *
+   * @param auxid controller connection identifier
+   * @param monitor_id controller assigned flow monitor identifier
+   * @param timeout until this request expires
+   * @return OpenFlow transaction ID assigned to this request
+   * @exception rofl::eRofBaseNotConnected
+   * @exception rofl::eRofBaseCongested
+   */
+  rofl::crofsock::msg_result_t
+  send_flow_monitor_delete(const rofl::cauxid &auxid, uint32_t monitor_id,
+                           int timeout_in_secs = DEFAULT_REQUEST_TIMEOUT,
+                           uint32_t *xid = nullptr);
+
   /**
    * @brief	Sends OpenFlow Packet-Out message to attached datapath element.
    *
@@ -1421,6 +1642,50 @@ public:
       const rofl::openflow::cofactions &actions, uint8_t *data = NULL,
       size_t datalen = 0, uint32_t *xid = nullptr);
 
+  /**
+   * @brief	Sends a batch of OpenFlow Packet-Out messages sharing a single
+   * action list to attached datapath element.
+   *
+   * The action list is packed once and copied into each Packet-Out
+   * message, which are serialized directly into pre-packed blocks of up
+   * to 64kB each. Transmission stops after the first block that was
+   * queued under congestion or could not be queued at all, like
+   * send_flow_mod_messages().
+   *
+   * @param auxid controller connection identifier
+   * @param actions OpenFlow actions list applied to all frames
+   * @param frames packet frames along with buffer_id and in_port
+   * @param num_queued number of frames queued for transmission
+   * @return result of last queueing operation
+   * @exception rofl::eRofBaseNotConnected
+   * @exception rofl::eRofBaseCongested
+   * @exception rofl::eInvalid single Packet-Out message exceeds 64kB
+   */
+  rofl::crofsock::msg_result_t send_packet_out_messages(
+      const rofl::cauxid &auxid, const rofl::openflow::cofactions &actions,
+      const std::vector<rofl::openflow::cofpacket_out_frame> &frames,
+      size_t *num_queued = nullptr);
+
+  /**
+   * @brief	Sends a pre-packed OpenFlow Packet-Out message to attached
+   * datapath element.
+   *
+   * The image is shared, not copied, until the socket serializes it into
+   * its transmission buffer. A new transaction ID is assigned on
+   * transmission.
+   *
+   * @param auxid controller connection identifier
+   * @param image packed OpenFlow Packet-Out message
+   * @return OpenFlow transaction ID assigned to this request
+   * @exception rofl::eRofBaseNotConnected
+   * @exception rofl::eRofBaseCongested
+   * @exception rofl::eBadVersion image version differs from channel
+   */
+  rofl::crofsock::msg_result_t
+  send_packet_out_message(const rofl::cauxid &auxid,
+                          const std::shared_ptr<const rofl::cmemory> &image,
+                          uint32_t *xid = nullptr);
+
   /**
    * @brief	Sends OpenFlow Barrier-Request message to attached datapath
    * element.
@@ -1436,6 +1701,58 @@ public:
                        int timeout_in_secs = DEFAULT_REQUEST_TIMEOUT,
                        uint32_t *xid = nullptr);
 
+  /**
+   * @brief	Sends OpenFlow Bundle-Control message to attached datapath
+   * element.
+   *
+   * @param auxid controller connection identifier
+   * @param bundle_id OpenFlow bundle identifier
+   * @param ctrl_type OpenFlow bundle control type (OFPBCT_*)
+   * @param flags OpenFlow bundle flags (OFPBF_*)
+   * @param timeout until this request expires
+   * @return OpenFlow transaction ID assigned to this request
+   * @exception rofl::eRofBaseNotConnected
+   * @exception rofl::eRofBaseCongested
+   */
+  rofl::crofsock::msg_result_t send_bundle_control_request(
+      const rofl::cauxid &auxid, uint32_t bundle_id, uint16_t ctrl_type,
+      uint16_t flags, int timeout_in_secs = DEFAULT_REQUEST_TIMEOUT,
+      uint32_t *xid = nullptr);
+
+  /**
+   * @brief	Sends an OpenFlow bundle to attached datapath element and
+   * commits it.
+   *
+   * Sends an Open-Request, all Bundle-Add-Message messages from bundle
+   * in pre-packed blocks of up to 64kB and finally a Commit-Request.
+   * Completion is reported via crofdpt_env::handle_bundle_committed() or
+   * crofdpt_env::handle_bundle_failed().
+   *
+   * A block carries no more messages than the flow txqueue accepts. Once
+   * the txqueue is exhausted, the bundle stays open on the datapath and
+   * the remaining Bundle-Add-Messages and the Commit-Request are sent
+   * when congestion has been solved or with the next call to
+   * send_bundle(). If a message cannot be queued for any other reason, a
+   * Discard-Request closes the bundle on the datapath.
+   *
+   * @param auxid controller connection identifier
+   * @param bundle OpenFlow bundle
+   * @param timeout until Open- and Commit-Request expire
+   * @param num_queued number of messages from bundle queued for
+   * transmission by this call
+   * @return MSG_QUEUED_CONGESTION if any block was queued under congestion
+   * or the bundle awaits an exhausted txqueue, the result of the first
+   * message not queued otherwise
+   * @exception rofl::eRofBaseNotConnected
+   * @exception rofl::eRofBaseCongested
+   * @exception rofl::eBadVersion bundles require OpenFlow 1.4 or beyond
+   */
+  rofl::crofsock::msg_result_t
+  send_bundle(const rofl::cauxid &auxid,
+              const rofl::openflow::cofbundle &bundle,
+              int timeout_in_secs = DEFAULT_BUNDLE_TIMEOUT,
+              size_t *num_queued = nullptr);
+
   /**
    * @brief	Sends OpenFlow Role-Request message to attached datapath
    * element.
@@ -1465,6 +1782,92 @@ public:
                         const rofl::openflow::cofflowmod &flowmod,
                         uint32_t *xid = nullptr);
 
+  /**
+   * @brief	Sends a batch of OpenFlow Flow-Mod messages to attached datapath
+   * element.
+   *
+   * Flow-Mods are serialized directly into pre-packed blocks of up to
+   * 64kB each without creating an intermediate cofmsg_flow_mod per
+   * entry. Each Flow-Mod in a block counts against the socket's flow
+   * queue limit, a block never carries more entries than the queue
+   * still accepts. Transmission stops after the first block that was
+   * queued under congestion or could not be queued at all. Entries
+   * [num_queued, flowmods.size()) have not been sent and may be resent
+   * once congestion has been solved.
+   *
+   * @param auxid controller connection identifier
+   * @param flowmods OpenFlow flow mod entries, entries with a version
+   * other than the channel's negotiated version are sent as converted
+   * copies
+   * @param num_queued number of leading entries from flowmods queued for
+   * transmission
+   * @return result of last queueing operation,
+   * MSG_QUEUEING_FAILED_QUEUE_FULL if the flow queue was exhausted
+   * @exception rofl::eRofConnNotConnected
+   */
+  rofl::crofsock::msg_result_t send_flow_mod_messages(
+      const rofl::cauxid &auxid,
+      const std::vector<rofl::openflow::cofflowmod> &flowmods,
+      size_t *num_queued = nullptr);
+
+  /**
+   * @brief	Sends OpenFlow Flow-Mod message generated from a precompiled
+   * template to attached datapath element.
+   *
+   * The template's image is copied as is after assigning a new
+   * transaction ID, i.e., all fields must have been patched before.
+   *
+   * @param auxid controller connection identifier
+   * @param tmpl precompiled OpenFlow flow mod template
+   * @return OpenFlow transaction ID assigned to this request
+   * @exception rofl::eRofBaseNotConnected
+   * @exception rofl::eRofBaseCongested
+   * @exception rofl::eBadVersion template version differs from channel
+   */
+  rofl::crofsock::msg_result_t
+  send_flow_mod_message(const rofl::cauxid &auxid,
+                        rofl::openflow::cofflowmodtemplate &tmpl,
+                        uint32_t *xid = nullptr);
+
+  /**
+   * @brief	Reconciles the shadow flow table with the datapath's flow
+   * tables.
+   *
+   * Sends a Flow-Stats-Request for all flow entries in all tables. Once
+   * the reply has been received, the Flow-Mods required to restore the
+   * shadowed state are sent to the datapath and
+   * crofdpt_env::handle_flow_table_reconciled() is called.
+   *
+   * @param auxid controller connection identifier
+   * @param timeout until this request expires
+   * @return OpenFlow transaction ID assigned to this request
+   * @exception rofl::eRofBaseNotConnected
+   * @exception rofl::eRofBaseCongested
+   * @exception rofl::eInvalid shadowing of flow tables is disabled
+   */
+  rofl::crofsock::msg_result_t
+  reconcile_flowtable(const rofl::cauxid &auxid,
+                      int timeout_in_secs = DEFAULT_REQUEST_TIMEOUT,
+                      uint32_t *xid = nullptr);
+
+  /**
+   * @brief	Continues sending the Flow-Mods of a reconciliation stopped by
+   * an exhausted txqueue.
+   *
+   * Called automatically on congestion_solved_indication(). A txqueue
+   * filled up without socket congestion is not signalled, so applications
+   * may call this method, e.g., from a timer to proceed.
+   */
+  void resume_flowtable_reconciliation() { flowtable_reconcile_continue(); };
+
+  /**
+   * @brief	Returns the number of reconciliation Flow-Mods not queued yet.
+   */
+  size_t get_flowtable_reconcile_pending() const {
+    AcquireReadLock rlock(reconcile_lock);
+    return reconcile_delta.size();
+  };
+
   /**
    * @brief	Sends OpenFlow Group-Mod message to attached datapath element.
    *
@@ -1686,6 +2089,16 @@ private:
   virtual void handle_closed(crofchan &chan) {
     if (delete_in_progress())
       return;
+    flowtable_reconcile_continue(true);
+    {
+      /* open bundles are dropped by the datapath */
+      AcquireReadWriteLock rwlock(bundles_lock);
+      for (auto &sending : bundles_sending) {
+        bundles.erase(sending.pending.xid_last);
+      }
+      bundles_sending.clear();
+      bundles_discard.clear();
+    }
     crofdpt_env::call_env(env).handle_closed(*this);
   };
 
@@ -1735,6 +2148,9 @@ private:
   virtual void congestion_solved_indication(crofchan &chan, crofconn &conn) {
     if (delete_in_progress())
       return;
+    flowtable_reconcile_continue();
+    bundle_discard_pending();
+    bundle_send_pending();
     crofdpt_env::call_env(env).congestion_solved_indication(*this, conn);
   };
 
@@ -1806,6 +2222,12 @@ private:
   void experimenter_stats_reply_rcvd(const rofl::cauxid &auxid,
                                      rofl::openflow::cofmsg *msg);
 
+  void flow_monitor_reply_rcvd(const rofl::cauxid &auxid,
+                               rofl::openflow::cofmsg *msg);
+
+  void bundle_control_rcvd(const rofl::cauxid &auxid,
+                           rofl::openflow::cofmsg *msg);
+
   void barrier_reply_rcvd(const rofl::cauxid &auxid,
                           rofl::openflow::cofmsg *msg);
 
@@ -1818,6 +2240,11 @@ private:
 
   void port_status_rcvd(const rofl::cauxid &auxid, rofl::openflow::cofmsg *msg);
 
+  void role_status_rcvd(const rofl::cauxid &auxid, rofl::openflow::cofmsg *msg);
+
+  void table_status_rcvd(const rofl::cauxid &auxid,
+                         rofl::openflow::cofmsg *msg);
+
   void role_reply_rcvd(const rofl::cauxid &auxid, rofl::openflow::cofmsg *msg);
 
   void queue_get_config_reply_rcvd(const rofl::cauxid &auxid,
@@ -1830,6 +2257,27 @@ private:
     return (STATE_DELETE_IN_PROGRESS == state);
   };
 
+  /*
+   * hands a pre-packed block over to the channel, adds the number of
+   * messages it carries to queued if it was accepted
+   */
+  rofl::crofsock::msg_result_t
+  send_packed_block(const rofl::cauxid &auxid,
+                    rofl::openflow::cofmsg_packed *msg, size_t &queued);
+
+  void flowtable_update(const rofl::openflow::cofflowmod &flowmod);
+
+  void flowtable_update(const std::vector<rofl::openflow::cofflowmod> &flowmods,
+                        size_t num);
+
+  /**
+   * @brief	Sends pending reconciliation Flow-Mods, reports the
+   * reconciliation to the environment once none are left.
+   *
+   * @param abort give up pending Flow-Mods instead of sending them
+   */
+  void flowtable_reconcile_continue(bool abort = false);
+
 private:
   // environment
   rofl::crofdpt_env *env;
@@ -1843,6 +2291,121 @@ private:
   // enable snooping of ports, tables, ...
   bool snoop;
 
+  // enable shadowing of flow tables
+  bool shadow;
+
+  // shadow flow table
+  rofl::openflow::cofflowtable flowtable;
+
+  // xid of pending flow table reconciliation
+  std::atomic_uint_fast32_t reconcile_xid;
+
+  // reconciliation Flow-Mods not queued yet
+  std::vector<rofl::openflow::cofflowmod> reconcile_delta;
+  rofl::cauxid reconcile_auxid;
+  bool reconcile_sending;
+  size_t reconcile_num_delta;
+  size_t reconcile_num_queued;
+  mutable rofl::crwlock reconcile_lock;
+
+  /**
+   * @brief	Bundle sent via send_bundle() and not yet completed.
+   */
+  class cbundle_pending {
+  public:
+    cbundle_pending(const rofl::cauxid &auxid = rofl::cauxid(0),
+                    uint32_t bundle_id = 0, uint32_t xid_first = 0,
+                    uint32_t xid_last = 0)
+        : auxid(auxid), bundle_id(bundle_id), xid_first(xid_first),
+          xid_last(xid_last){};
+
+    // xid used by any of the bundle's messages, with wrap-around
+    bool has_xid(uint32_t xid) const {
+      return ((uint32_t)(xid - xid_first) <= (uint32_t)(xid_last - xid_first));
+    };
+
+  public:
+    rofl::cauxid auxid;
+    uint32_t bundle_id;
+    uint32_t xid_first;
+    uint32_t xid_last;
+  };
+
+  /**
+   * @brief	Open bundle waiting for an exhausted txqueue.
+   */
+  class cbundle_sending {
+  public:
+    cbundle_sending(const cbundle_pending &pending,
+                    const rofl::openflow::cofbundle &bundle, size_t offset,
+                    uint32_t xid, int timeout_in_secs)
+        : pending(pending), bundle(bundle), offset(offset), xid(xid),
+          timeout_in_secs(timeout_in_secs){};
+
+  public:
+    cbundle_pending pending;
+    rofl::openflow::cofbundle bundle;
+    // offset of the next Bundle-Add-Message in bundle
+    size_t offset;
+    // xid of the last Bundle-Add-Message queued
+    uint32_t xid;
+    int timeout_in_secs;
+  };
+
+  /**
+   * @brief	Removes pending bundle using xid and returns a copy.
+   *
+   * @return true if a pending bundle was found
+   */
+  bool bundle_done(uint32_t xid, cbundle_pending &bundle);
+
+  /**
+   * @brief	Sends Bundle-Add-Messages starting at offset and the
+   * Commit-Request.
+   *
+   * Stops with MSG_QUEUEING_FAILED_QUEUE_FULL once the flow txqueue is
+   * exhausted, offset and xid refer to the first message not queued then.
+   *
+   * @return result of the first message not queued or of the
+   * Commit-Request
+   */
+  rofl::crofsock::msg_result_t
+  send_bundle_messages(const cbundle_pending &pending,
+                       const rofl::openflow::cofbundle &bundle,
+                       int timeout_in_secs, size_t &offset, uint32_t &xid,
+                       size_t &queued, bool &congested);
+
+  /**
+   * @brief	Resumes bundles waiting for an exhausted txqueue.
+   */
+  void bundle_send_pending();
+
+  /**
+   * @brief	Drops a bundle send_bundle() failed to queue completely and
+   * discards it on the datapath if the Open-Request was queued.
+   */
+  void bundle_abort(const cbundle_pending &pending, bool opened);
+
+  /**
+   * @brief	Sends Discard-Request, defers it if the txqueue is exhausted.
+   */
+  void bundle_discard(const cbundle_pending &pending);
+
+  /**
+   * @brief	Sends deferred Discard-Requests.
+   */
+  void bundle_discard_pending();
+
+  // pending bundles, key: xid of Commit-Request
+  std::map<uint32_t, cbundle_pending> bundles;
+
+  // open bundles waiting for an exhausted txqueue, oldest first
+  std::list<cbundle_sending> bundles_sending;
+
+  // incomplete bundles still to be discarded on the datapath
+  std::vector<cbundle_pending> bundles_discard;
+  rofl::crwlock bundles_lock;
+
   // OFP control channel
   rofl::crofchan rofchan;
 
@@ -1855,6 +2418,9 @@ private:
   // default request timeout
   static const time_t DEFAULT_REQUEST_TIMEOUT = 0; // seconds (0 : no timeout)
 
+  // default timeout for Open- and Commit-Requests sent by send_bundle()
+  static const time_t DEFAULT_BUNDLE_TIMEOUT = 5; // seconds
+
   // datapath identifier
   rofl::cdpid dpid;
 
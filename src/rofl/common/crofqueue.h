@@ -8,9 +8,10 @@
 #ifndef CROFQUEUE_H_
 #define CROFQUEUE_H_
 
-#include <list>
+#include <deque>
 #include <ostream>
 
+#include "rofl/common/ctimespec.hpp"
 #include "rofl/common/locking.hpp"
 #include "rofl/common/openflow/messages/cofmsg.h"
 
@@ -52,7 +53,7 @@ public:
   /**
    *
    */
-  crofqueue() : queue_max_size(QUEUE_MAX_SIZE_DEFAULT){};
+  crofqueue() : queue_msgs(0), queue_max_size(QUEUE_MAX_SIZE_DEFAULT){};
 
   /**
    *
@@ -87,8 +88,9 @@ public:
         if (queue.empty()) {
           return;
         }
-        msg = queue.front();
+        msg = queue.front().msg;
         queue.pop_front();
+        queue_msgs -= msg->get_msgs_num();
       }
       delete msg;
     }
@@ -98,12 +100,30 @@ public:
    *
    */
   size_t store(rofl::openflow::cofmsg *msg, bool enforce = false) {
-    AcquireReadWriteLock rwlock(queue_lock);
-    if ((not enforce) && (queue.size() >= queue_max_size)) {
+    size_t size = try_store(msg, enforce);
+    if (0 == size) {
       throw eRofQueueFull("crofqueue::store() queue max size exceeded",
                           __FILE__, __FUNCTION__, __LINE__);
     }
-    queue.push_back(msg);
+    return size;
+  };
+
+  /**
+   * @brief	Non-throwing variant of store()
+   *
+   * Pre-packed blocks count with all messages they carry against the
+   * queue's maximum size.
+   *
+   * @return new queue size or 0 if the queue is full and msg was not stored
+   */
+  size_t try_store(rofl::openflow::cofmsg *msg, bool enforce = false) {
+    AcquireReadWriteLock rwlock(queue_lock);
+    size_t msgs_num = msg->get_msgs_num();
+    if ((not enforce) && (queue_msgs + msgs_num > queue_max_size)) {
+      return 0;
+    }
+    queue_msgs += msgs_num;
+    queue.push_back(entry_t(msg, cclock::now()));
     return queue.size();
   };
 
@@ -116,8 +136,9 @@ public:
     if (queue.empty()) {
       return msg;
     }
-    msg = queue.front();
+    msg = queue.front().msg;
     queue.pop_front();
+    queue_msgs -= msg->get_msgs_num();
     return msg;
   };
 
@@ -130,7 +151,7 @@ public:
     if (queue.empty()) {
       return msg;
     }
-    msg = queue.front();
+    msg = queue.front().msg;
     return msg;
   };
 
@@ -142,16 +163,27 @@ public:
     if (queue.empty()) {
       return;
     }
+    queue_msgs -= queue.front().msg->get_msgs_num();
     queue.pop_front();
   };
 
   /**
-   *
+   * @brief	Returns time (cclock, nanoseconds) the front message was stored
+   */
+  uint64_t front_stamp() const {
+    AcquireReadLock rwlock(queue_lock);
+    if (queue.empty()) {
+      return 0;
+    }
+    return queue.front().stamp;
+  };
+
+  /**
+   * @brief	Returns number of messages that may still be stored
    */
   size_t capacity() const {
     AcquireReadLock rwlock(queue_lock);
-    return (queue.size() < queue_max_size) ? (queue_max_size - queue.size())
-                                           : 0;
+    return (queue_msgs < queue_max_size) ? (queue_max_size - queue_msgs) : 0;
   };
 
 public:
@@ -173,16 +205,23 @@ public:
     AcquireReadLock rwlock(queue.queue_lock);
     os << "<crofqueue size #" << queue.queue.size() << " >" << std::endl;
 
-    for (std::list<rofl::openflow::cofmsg *>::const_iterator it =
-             queue.queue.begin();
+    for (std::deque<entry_t>::const_iterator it = queue.queue.begin();
          it != queue.queue.end(); ++it) {
-      os << *(*it);
+      os << *(it->msg);
     }
     return os;
   };
 
 private:
-  std::list<rofl::openflow::cofmsg *> queue;
+  struct entry_t {
+    entry_t(rofl::openflow::cofmsg *msg, uint64_t stamp)
+        : msg(msg), stamp(stamp){};
+    rofl::openflow::cofmsg *msg;
+    uint64_t stamp; // time stored, see cclock::now()
+  };
+
+  std::deque<entry_t> queue;
+  size_t queue_msgs; // messages stored, including those in pre-packed blocks
   mutable crwlock queue_lock;
   size_t queue_max_size;
   static const size_t QUEUE_MAX_SIZE_DEFAULT = 128;
@@ -18,6 +18,7 @@ using namespace rofl;
 
 /*static*/ std::set<crofsock_env *> crofsock_env::socket_envs;
 /*static*/ crwlock crofsock_env::socket_envs_lock;
+/*static*/ std::atomic<uint64_t> crofsock::next_trace_connid(1);
 
 crofsock::~crofsock() {
   flag_set(FLAG_DELETE_IN_PROGRESS, true);
@@ -33,21 +34,27 @@ crofsock::crofsock(crofsock_env *env)
       reconnect_backoff_max(60 /*secs*/), reconnect_backoff_start(1 /*secs*/),
       reconnect_backoff_current(1 /*secs*/), reconnect_counter(0), sd(-1),
       domain(AF_INET), type(SOCK_STREAM), protocol(IPPROTO_TCP), backlog(64),
-      ctx(NULL), ssl(NULL), bio(NULL), capath("."), cafile("ca.pem"),
-      certfile("crt.pem"), keyfile("key.pem"), password(""),
-      verify_mode("PEER"), verify_depth("1"),
+      channel_side(cmemchannel::SIDE_A), channel_txfd(-1), ctx(NULL),
+      ssl(NULL), bio(NULL), capath("."), cafile("ca.pem"), certfile("crt.pem"),
+      keyfile("key.pem"), password(""), verify_mode("PEER"),
+      verify_depth("1"),
       ciphers("EECDH+ECDSA+AESGCM EECDH+aRSA+AESGCM EECDH+ECDSA+SHA256 "
               "EECDH+aRSA+RC4 EDH+aRSA EECDH RC4 !aNULL !eNULL !LOW !3DES !MD5 "
               "!EXP !PSK !SRP !DSS"),
       rxbuffer((size_t)65536), rx_disabled(false), txbuffer((size_t)65536),
       tx_disabled(false), tx_is_running(false), txqueue_pending_pkts(0),
       txqueue_size_congestion_occurred(0), txqueue_size_tx_threshold(0),
-      txqueues(QUEUE_MAX), txweights(QUEUE_MAX) {
-  /* scheduler weights for transmission */
-  txweights[QUEUE_OAM] = 16;
-  txweights[QUEUE_MGMT] = 32;
-  txweights[QUEUE_FLOW] = 16;
-  txweights[QUEUE_PKT] = 8;
+      txqueue_exhausted(false), txqueues(QUEUE_MAX), oam_strict_priority(true),
+      trace_connid(next_trace_connid++), trace_auxid(0) {
+  /* deficit round robin quanta for transmission in bytes */
+  txquanta[QUEUE_OAM] = 1024;
+  txquanta[QUEUE_MGMT] = 4096;
+  txquanta[QUEUE_FLOW] = 8192;
+  txquanta[QUEUE_PKT] = 4096;
+  for (unsigned int queue_id = 0; queue_id < QUEUE_MAX; queue_id++) {
+    txdeficits[queue_id] = 0;
+  }
+  clear_txqueue_stats();
   VLOG(1) << __FUNCTION__ << " "
           << "RX thread: " << cthread::thread(rx_thread_num).get_thread_name()
           << " "
@@ -62,6 +69,12 @@ void crofsock::close() {
   flag_set(FLAG_CLOSING, true);
   AcquireReadWriteLock lock(tlock);
 
+  /* stop waiting for a pending name resolution */
+  if (flag_test(FLAG_RESOLVING)) {
+    flag_set(FLAG_RESOLVING, false);
+    cresolver::cancel(this);
+  }
+
   /* shutdown TLS */
   switch (state.load()) {
   case STATE_TLS_CONNECTING: {
@@ -170,6 +183,9 @@ void crofsock::close() {
       cthread::thread(tx_thread_num).drop_fd(sd);
       ::close(sd);
       sd = -1;
+      if (AF_UNIX == baddr.get_family()) {
+        ::unlink(baddr.ca_sunaddr->sun_path);
+      }
     }
 
     state = STATE_IDLE;
@@ -222,10 +238,20 @@ void crofsock::close() {
     tx_disable();
 
     cthread::thread(rx_thread_num).drop_read_fd(sd, false);
-    if (flag_test(FLAG_CONGESTED)) {
-      cthread::thread(tx_thread_num).drop_write_fd(sd);
+    if (flag_test(FLAG_MEMCHANNEL)) {
+      if (flag_test(FLAG_CONGESTED)) {
+        cthread::thread(tx_thread_num).drop_read_fd(channel_txfd, false);
+      }
+      channel->shutdown(channel_side);
+      cthread::thread(tx_thread_num).drop_fd(channel_txfd);
+      ::close(channel_txfd);
+      channel_txfd = -1;
+    } else {
+      if (flag_test(FLAG_CONGESTED)) {
+        cthread::thread(tx_thread_num).drop_write_fd(sd);
+      }
+      shutdown(sd, O_RDWR);
     }
-    shutdown(sd, O_RDWR);
 
     /* allow socket to send shutdown notification to peer */
     /* sleep(1); // use SO_LINGER option instead */
@@ -281,9 +307,14 @@ void crofsock::listen() {
 
   /* reconnect does not make sense for listening sockets */
   flag_set(FLAG_RECONNECT_ON_FAILURE, false);
+  flag_set(FLAG_MEMCHANNEL, false);
+
+  /* AF_UNIX sockets share the TCP code path */
+  domain = baddr.get_family();
+  protocol = (AF_UNIX == domain) ? 0 : IPPROTO_TCP;
 
   /* open socket */
-  if ((sd = ::socket(baddr.get_family(), type, protocol)) < 0) {
+  if ((sd = ::socket(domain, type, protocol)) < 0) {
     throw eSysCall("eSysCall", "socket", __FILE__, __FUNCTION__, __LINE__);
   }
 
@@ -340,6 +371,15 @@ void crofsock::listen() {
     }
   }
 
+  /* remove stale socket file left behind by a previous listener */
+  if (AF_UNIX == domain) {
+    struct stat st;
+    if ((::stat(baddr.ca_sunaddr->sun_path, &st) == 0) &&
+        S_ISSOCK(st.st_mode)) {
+      ::unlink(baddr.ca_sunaddr->sun_path);
+    }
+  }
+
   /* bind to local address */
   if ((rc = ::bind(sd, baddr.ca_saddr, (socklen_t)(baddr.salen))) < 0) {
     throw eSysCall("eSysCall", "bind", __FILE__, __FUNCTION__, __LINE__);
@@ -408,6 +448,7 @@ void crofsock::tcp_accept(int sd) {
 
   /* reconnect is not possible for server sockets */
   flag_set(FLAG_RECONNECT_ON_FAILURE, false);
+  flag_set(FLAG_MEMCHANNEL, false);
 
   /* new state */
   state = STATE_TCP_ACCEPTING;
@@ -531,12 +572,22 @@ void crofsock::tcp_connect(bool reconnect) {
 
   /* reconnect in case of an error? */
   flag_set(FLAG_RECONNECT_ON_FAILURE, reconnect);
+  flag_set(FLAG_MEMCHANNEL, false);
 
   /* new state */
   state = STATE_TCP_CONNECTING;
 
+  /* resolve remote host name first, this may suspend the connect */
+  if ((not rnode.empty()) && (not resolve_raddr())) {
+    return;
+  }
+
+  /* AF_UNIX sockets share the TCP code path */
+  domain = raddr.get_family();
+  protocol = (AF_UNIX == domain) ? 0 : IPPROTO_TCP;
+
   /* open socket */
-  if ((sd = ::socket(raddr.get_family(), type, protocol)) < 0) {
+  if ((sd = ::socket(domain, type, protocol)) < 0) {
     throw eSysCall("eSysCall", "socket", __FILE__, __FUNCTION__, __LINE__);
   }
 
@@ -659,98 +710,116 @@ void crofsock::tcp_connect(bool reconnect) {
   }
 }
 
-void crofsock::tls_init_context() {
+void crofsock::mem_accept(std::shared_ptr<cmemchannel> channel,
+                          cmemchannel::side_t side) {
+  /* socket in server mode */
+  mode = MODE_SERVER;
 
-  if (ctx) {
-    tls_term_context();
-  }
+  mem_establish(channel, side);
 
-  AcquireReadWriteLock lock(sslock);
+  crofsock_env::call_env(env).handle_tcp_accepted(*this);
+}
 
-#if (OPENSSL_VERSION_NUMBER >= 0x1010000fL)
-  // openssl 1.1.0
-  ctx = SSL_CTX_new(TLS_method());
-#else
-  ctx = SSL_CTX_new(TLSv1_2_method());
-#endif
+void crofsock::mem_connect(std::shared_ptr<cmemchannel> channel,
+                           cmemchannel::side_t side) {
+  /* we do an active connect */
+  mode = MODE_CLIENT;
 
-  // certificate
-  if (!SSL_CTX_use_certificate_file(ctx, certfile.c_str(), SSL_FILETYPE_PEM)) {
-    throw eLibCall("eLibCall", "SSL_CTX_use_certificate_file", __FILE__,
-                   __FUNCTION__, __LINE__)
-        .set_key("certfile", certfile);
-  }
+  mem_establish(channel, side);
 
-  // private key
-  SSL_CTX_set_default_passwd_cb(ctx, &crofsock::tls_pswd_cb);
-  SSL_CTX_set_default_passwd_cb_userdata(ctx, (void *)this);
+  crofsock_env::call_env(env).handle_tcp_connected(*this);
+}
 
-  if (!SSL_CTX_use_PrivateKey_file(ctx, keyfile.c_str(), SSL_FILETYPE_PEM)) {
-    throw eLibCall("eLibCall", "SSL_CTX_use_PrivateKey_file", __FILE__,
-                   __FUNCTION__, __LINE__)
-        .set_key("keyfile", keyfile);
-  }
-  // ciphers
-  if ((not ciphers.empty()) &&
-      (0 == SSL_CTX_set_cipher_list(ctx, ciphers.c_str()))) {
-    throw eLibCall("eLibCall", "SSL_CTX_set_cipher_list", __FILE__,
-                   __FUNCTION__, __LINE__)
-        .set_key("ciphers", ciphers);
+void crofsock::mem_establish(std::shared_ptr<cmemchannel> channel,
+                             cmemchannel::side_t side) {
+  if (get_state() != STATE_IDLE) {
+    close();
   }
 
-  // capath/cafile
-  if (!SSL_CTX_load_verify_locations(ctx,
-                                     cafile.empty() ? NULL : cafile.c_str(),
-                                     capath.empty() ? NULL : capath.c_str())) {
-    throw eLibCall("eLibCall", "SSL_CTX_load_verify_locations", __FILE__,
-                   __FUNCTION__, __LINE__)
-        .set_key("cafile", cafile)
-        .set_key("capath", capath);
+  /* remove all pending messages from tx queues */
+  for (auto &queue : txqueues) {
+    queue.clear();
   }
 
-  int mode = SSL_VERIFY_NONE;
-  if (verify_mode == "NONE") {
-    mode = SSL_VERIFY_NONE;
-  } else if (verify_mode == "PEER") {
-    mode = SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT;
+  /* cancel potentially pending reconnect timer */
+  cthread::thread(rx_thread_num).drop_timer(this, TIMER_ID_RECONNECT);
+
+  /* there is nothing to reconnect to and no need for encryption */
+  flag_set(FLAG_RECONNECT_ON_FAILURE, false);
+  flag_set(FLAG_TLS_IN_USE, false);
+  flag_set(FLAG_MEMCHANNEL, true);
+
+  this->channel = channel;
+  channel_side = side;
+
+  /* eventfds are duplicated, as close() releases them like a socket */
+  if ((sd = ::dup(channel->get_rx_fd(side))) < 0) {
+    throw eSysCall("eSysCall", "dup", __FILE__, __FUNCTION__, __LINE__);
+  }
+  if ((channel_txfd = ::dup(channel->get_tx_fd(side))) < 0) {
+    /* capture errno before releasing the first duplicate */
+    eSysCall e("eSysCall", "dup", __FILE__, __FUNCTION__, __LINE__);
+    ::close(sd);
+    sd = -1;
+    throw e;
   }
 
-  SSL_CTX_set_verify(ctx, mode, NULL);
+  state = STATE_TCP_ESTABLISHED;
+
+  VLOG(6) << __FUNCTION__ << " STATE_TCP_ESTABLISHED sd=" << sd
+          << " memory channel side=" << (unsigned int)side;
+
+  /* register eventfd for read operations */
+  cthread::thread(rx_thread_num).add_read_fd(this, sd, true, true);
+  cthread::thread(rx_thread_num).wakeup(this);
+}
 
-  int depth;
-  std::istringstream(verify_depth) >> depth;
+void crofsock::tls_init_context() {
 
-  SSL_CTX_set_verify_depth(ctx, depth);
+  if (ctx) {
+    tls_term_context();
+  }
+
+  AcquireReadWriteLock lock(sslock);
+
+  ctlscontext::key_t key;
+  key.capath = capath;
+  key.cafile = cafile;
+  key.certfile = certfile;
+  key.keyfile = keyfile;
+  key.password = password;
+  key.verify_mode = verify_mode;
+  key.verify_depth = verify_depth;
+  key.ciphers = ciphers;
+
+  /* shared among all sockets with identical TLS parameters */
+  ctx = ctlscontext::acquire(key);
 }
 
 void crofsock::tls_term_context() {
   AcquireReadWriteLock lock(sslock);
   if (ssl) {
+    /* keep client session for resumption on reconnect */
+    if ((MODE_CLIENT == mode) && ctx && (STATE_TLS_ESTABLISHED == state)) {
+      SSL_SESSION *session = SSL_get1_session(ssl);
+#if (OPENSSL_VERSION_NUMBER >= 0x1010100fL)
+      if (session && (not SSL_SESSION_is_resumable(session))) {
+        SSL_SESSION_free(session);
+        session = NULL;
+      }
+#endif
+      ctx->set_session(raddr.str(), session);
+    }
     SSL_free(ssl);
     ssl = NULL;
     bio = NULL;
   }
   if (ctx) {
-    SSL_CTX_free(ctx);
+    ctlscontext::release(ctx);
     ctx = NULL;
   }
 }
 
-int crofsock::tls_pswd_cb(char *buf, int size, int rwflag, void *userdata) {
-  if (userdata == NULL)
-    return 0;
-
-  crofsock &socket = *(static_cast<crofsock *>(userdata));
-
-  if (socket.get_tls_pswd().empty()) {
-    return 0;
-  }
-
-  strncpy(buf, socket.get_tls_pswd().c_str(), size);
-
-  return strnlen(buf, size);
-}
-
 void crofsock::tls_accept(int sockfd) {
   switch (state.load()) {
   case STATE_IDLE:
@@ -771,7 +840,7 @@ void crofsock::tls_accept(int sockfd) {
     {
       AcquireReadWriteLock lock(sslock);
 
-      if ((ssl = SSL_new(ctx)) == NULL) {
+      if ((ssl = SSL_new(ctx->get_ssl_ctx())) == NULL) {
         throw eLibCall("eLibCall", "SSL_new", __FILE__, __FUNCTION__, __LINE__);
       }
 
@@ -789,6 +858,9 @@ void crofsock::tls_accept(int sockfd) {
 
       SSL_set_accept_state(ssl);
 
+      tls_started = ctimespec::now();
+      ctlscontext::handshake_started();
+
       state = STATE_TLS_ACCEPTING;
     }
 
@@ -855,6 +927,8 @@ void crofsock::tls_accept(int sockfd) {
 
       tls_log_errors();
 
+      ctlscontext::handshake_failed();
+
       tls_term_context();
 
       crofsock::close();
@@ -871,6 +945,8 @@ void crofsock::tls_accept(int sockfd) {
 
         tls_log_errors();
 
+        ctlscontext::handshake_failed();
+
         tls_term_context();
 
         crofsock::close();
@@ -882,7 +958,11 @@ void crofsock::tls_accept(int sockfd) {
 
       VLOG(6) << __FUNCTION__ << " TLS: SSL_accept succeeded on sd=" << sd;
 
-      state = STATE_TLS_ESTABLISHED;
+      /* count each handshake once only */
+      socket_state_t expected = STATE_TLS_ACCEPTING;
+      if (state.compare_exchange_strong(expected, STATE_TLS_ESTABLISHED)) {
+        ctlscontext::handshake_completed(tls_started, SSL_session_reused(ssl));
+      }
 
       crofsock_env::call_env(env).handle_tls_accepted(*this);
     }
@@ -917,10 +997,17 @@ void crofsock::tls_connect(bool reconnect) {
 
     tls_init_context();
 
-    if ((ssl = SSL_new(ctx)) == NULL) {
+    if ((ssl = SSL_new(ctx->get_ssl_ctx())) == NULL) {
       throw eLibCall("eLibCall", "SSL_new", __FILE__, __FUNCTION__, __LINE__);
     }
 
+    /* resume previous session with this peer, if any */
+    SSL_SESSION *session = ctx->get_session(raddr.str());
+    if (session) {
+      SSL_set_session(ssl, session);
+      SSL_SESSION_free(session);
+    }
+
     SSL_set_mode(ssl,
                  SSL_MODE_ENABLE_PARTIAL_WRITE |
                      SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
@@ -935,6 +1022,9 @@ void crofsock::tls_connect(bool reconnect) {
 
     SSL_set_connect_state(ssl);
 
+    tls_started = ctimespec::now();
+    ctlscontext::handshake_started();
+
     state = STATE_TLS_CONNECTING;
 
     VLOG(6) << __FUNCTION__ << " TLS: start active connection sd=" << sd;
@@ -1001,6 +1091,13 @@ void crofsock::tls_connect(bool reconnect) {
 
       tls_log_errors();
 
+      ctlscontext::handshake_failed();
+
+      /* do not offer a possibly stale session again */
+      if (ctx) {
+        ctx->drop_session(raddr.str());
+      }
+
       tls_term_context();
 
       crofsock::close();
@@ -1017,6 +1114,13 @@ void crofsock::tls_connect(bool reconnect) {
 
         tls_log_errors();
 
+        ctlscontext::handshake_failed();
+
+        /* a resumed session must not be offered to this peer again */
+        if (ctx) {
+          ctx->drop_session(raddr.str());
+        }
+
         tls_term_context();
 
         crofsock::close();
@@ -1028,7 +1132,11 @@ void crofsock::tls_connect(bool reconnect) {
 
       VLOG(6) << __FUNCTION__ << " TLS: SSL_connect succeeded on sd=" << sd;
 
-      state = STATE_TLS_ESTABLISHED;
+      /* count each handshake once only */
+      socket_state_t expected = STATE_TLS_CONNECTING;
+      if (state.compare_exchange_strong(expected, STATE_TLS_ESTABLISHED)) {
+        ctlscontext::handshake_completed(tls_started, SSL_session_reused(ssl));
+      }
 
       crofsock_env::call_env(env).handle_tls_connected(*this);
     }
@@ -1317,17 +1425,59 @@ void crofsock::backoff_reconnect(bool reset_timeout) {
     }
   }
 
-  VLOG(6) << __FUNCTION__
-          << " scheduled reconnect in: " << reconnect_backoff_current << " secs"
+  /* equal jitter: wait between 50% and 100% of the current backoff, so
+   * that sockets disconnected at the same time do not reconnect in lockstep
+   */
+  long msecs = (long)(reconnect_backoff_current * 1000 *
+                      (0.5 + 0.5 * reconnect_random.rand()));
+
+  VLOG(6) << __FUNCTION__ << " scheduled reconnect in: " << msecs << " msecs"
           << " laddr" << laddr.str() << " raddr=" << raddr.str();
 
   cthread::thread(rx_thread_num)
       .add_timer(this, TIMER_ID_RECONNECT,
-                 ctimespec().expire_in(reconnect_backoff_current, 0));
+                 ctimens::expire_in(msecs / 1000, (msecs % 1000) * 1000000));
 
   ++reconnect_counter;
 }
 
+bool crofsock::resolve_raddr() {
+  caddrinfos ais;
+  ais.set_node(rnode);
+  ais.set_service(rservice);
+  ais.set_ai_hints().set_ai_socktype(SOCK_STREAM);
+
+  int error = 0;
+  switch (cresolver::lookup(ais, rx_thread_num, this, &error)) {
+  case cresolver::LOOKUP_RESOLVED: {
+    if (ais.size() > 0) {
+      raddr = ais.get_addr_infos().begin()->second.get_ai_addr();
+      return true;
+    }
+    error = EAI_NONAME;
+  } break;
+  case cresolver::LOOKUP_PENDING: {
+    VLOG(6) << __FUNCTION__ << " TCP: resolving node=" << rnode
+            << " service=" << rservice;
+    /* continued in handle_wakeup() */
+    flag_set(FLAG_RESOLVING, true);
+    return false;
+  };
+  default: {};
+  }
+
+  VLOG(1) << __FUNCTION__ << " TCP: resolving node=" << rnode
+          << " service=" << rservice << " failed: " << gai_strerror(error);
+  close();
+
+  crofsock_env::call_env(env).handle_tcp_connect_failed(*this);
+
+  if (flag_test(FLAG_RECONNECT_ON_FAILURE)) {
+    backoff_reconnect(false);
+  }
+  return false;
+}
+
 bool crofsock::is_established() const {
   return (STATE_TCP_ESTABLISHED <= state);
 }
@@ -1429,101 +1579,128 @@ crofsock::msg_result_t crofsock::send_message(rofl::openflow::cofmsg *msg,
     enforce_queueing = true;
   }
 
-  try {
+  outqueue_type_t queue_id = QUEUE_MGMT;
 
-    /* enqueue the message in rofl's internal queue, as long
-     * as these are not exhausted */
-    switch (msg->get_version()) {
-    case rofl::openflow10::OFP_VERSION: {
-      switch (msg->get_type()) {
-      case rofl::openflow10::OFPT_PACKET_IN:
-      case rofl::openflow10::OFPT_PACKET_OUT: {
-        txqueues[QUEUE_PKT].store(msg, enforce_queueing);
-      } break;
-      case rofl::openflow10::OFPT_FLOW_MOD:
-      case rofl::openflow10::OFPT_FLOW_REMOVED:
-      case rofl::openflow10::OFPT_BARRIER_REPLY:
-      case rofl::openflow10::OFPT_BARRIER_REQUEST: {
-        txqueues[QUEUE_FLOW].store(msg, enforce_queueing);
-      } break;
-      case rofl::openflow10::OFPT_ECHO_REQUEST:
-      case rofl::openflow10::OFPT_ECHO_REPLY: {
-        txqueues[QUEUE_OAM].store(msg, enforce_queueing);
-      } break;
-      default: { txqueues[QUEUE_MGMT].store(msg, enforce_queueing); };
-      }
+  /* enqueue the message in rofl's internal queue, as long
+   * as these are not exhausted */
+  switch (msg->get_version()) {
+  case rofl::openflow10::OFP_VERSION: {
+    switch (msg->get_type()) {
+    case rofl::openflow10::OFPT_PACKET_IN:
+    case rofl::openflow10::OFPT_PACKET_OUT: {
+      queue_id = QUEUE_PKT;
     } break;
-    case rofl::openflow12::OFP_VERSION: {
-      switch (msg->get_type()) {
-      case rofl::openflow12::OFPT_PACKET_IN:
-      case rofl::openflow12::OFPT_PACKET_OUT: {
-        txqueues[QUEUE_PKT].store(msg, enforce_queueing);
-      } break;
-      case rofl::openflow12::OFPT_FLOW_MOD:
-      case rofl::openflow12::OFPT_FLOW_REMOVED:
-      case rofl::openflow12::OFPT_GROUP_MOD:
-      case rofl::openflow12::OFPT_PORT_MOD:
-      case rofl::openflow12::OFPT_TABLE_MOD:
-      case rofl::openflow12::OFPT_BARRIER_REPLY:
-      case rofl::openflow12::OFPT_BARRIER_REQUEST: {
-        txqueues[QUEUE_FLOW].store(msg, enforce_queueing);
-      } break;
-      case rofl::openflow12::OFPT_ECHO_REQUEST:
-      case rofl::openflow12::OFPT_ECHO_REPLY: {
-        txqueues[QUEUE_OAM].store(msg, enforce_queueing);
-      } break;
-      default: { txqueues[QUEUE_MGMT].store(msg, enforce_queueing); };
-      }
+    case rofl::openflow10::OFPT_FLOW_MOD:
+    case rofl::openflow10::OFPT_FLOW_REMOVED:
+    case rofl::openflow10::OFPT_BARRIER_REPLY:
+    case rofl::openflow10::OFPT_BARRIER_REQUEST: {
+      queue_id = QUEUE_FLOW;
     } break;
-    case rofl::openflow13::OFP_VERSION:
-    default: {
-      switch (msg->get_type()) {
-      case rofl::openflow13::OFPT_PACKET_IN:
-      case rofl::openflow13::OFPT_PACKET_OUT: {
-        txqueues[QUEUE_PKT].store(msg, enforce_queueing);
-      } break;
-      case rofl::openflow13::OFPT_FLOW_MOD:
-      case rofl::openflow13::OFPT_FLOW_REMOVED:
-      case rofl::openflow13::OFPT_GROUP_MOD:
-      case rofl::openflow13::OFPT_PORT_MOD:
-      case rofl::openflow13::OFPT_TABLE_MOD:
-      case rofl::openflow13::OFPT_BARRIER_REPLY:
-      case rofl::openflow13::OFPT_BARRIER_REQUEST: {
-        txqueues[QUEUE_FLOW].store(msg, enforce_queueing);
-      } break;
-      case rofl::openflow13::OFPT_ECHO_REQUEST:
-      case rofl::openflow13::OFPT_ECHO_REPLY: {
-        txqueues[QUEUE_OAM].store(msg, enforce_queueing);
-      } break;
-      default: { txqueues[QUEUE_MGMT].store(msg, enforce_queueing); };
-      }
-    };
+    case rofl::openflow10::OFPT_ECHO_REQUEST:
+    case rofl::openflow10::OFPT_ECHO_REPLY: {
+      queue_id = QUEUE_OAM;
+    } break;
+    default: { queue_id = QUEUE_MGMT; };
     }
-
-    txqueue_pending_pkts++;
-
-    if (not tx_is_running) {
-      cthread::thread(tx_thread_num).wakeup(this);
+  } break;
+  case rofl::openflow12::OFP_VERSION: {
+    switch (msg->get_type()) {
+    case rofl::openflow12::OFPT_PACKET_IN:
+    case rofl::openflow12::OFPT_PACKET_OUT: {
+      queue_id = QUEUE_PKT;
+    } break;
+    case rofl::openflow12::OFPT_FLOW_MOD:
+    case rofl::openflow12::OFPT_FLOW_REMOVED:
+    case rofl::openflow12::OFPT_GROUP_MOD:
+    case rofl::openflow12::OFPT_PORT_MOD:
+    case rofl::openflow12::OFPT_TABLE_MOD:
+    case rofl::openflow12::OFPT_BARRIER_REPLY:
+    case rofl::openflow12::OFPT_BARRIER_REQUEST: {
+      queue_id = QUEUE_FLOW;
+    } break;
+    case rofl::openflow12::OFPT_ECHO_REQUEST:
+    case rofl::openflow12::OFPT_ECHO_REPLY: {
+      queue_id = QUEUE_OAM;
+    } break;
+    default: { queue_id = QUEUE_MGMT; };
     }
-
-    if (flag_test(FLAG_TX_BLOCK_QUEUEING)) {
-      /* message was queued, but congestion prevents us from sending it */
-      return MSG_QUEUED_CONGESTION;
+  } break;
+  case rofl::openflow13::OFP_VERSION:
+  default: {
+    switch (msg->get_type()) {
+    case rofl::openflow13::OFPT_PACKET_IN:
+    case rofl::openflow13::OFPT_PACKET_OUT: {
+      queue_id = QUEUE_PKT;
+    } break;
+    case rofl::openflow13::OFPT_FLOW_MOD:
+    case rofl::openflow13::OFPT_FLOW_REMOVED:
+    case rofl::openflow13::OFPT_GROUP_MOD:
+    case rofl::openflow13::OFPT_PORT_MOD:
+    case rofl::openflow13::OFPT_TABLE_MOD:
+    case rofl::openflow13::OFPT_BARRIER_REPLY:
+    case rofl::openflow13::OFPT_BARRIER_REQUEST: {
+      queue_id = QUEUE_FLOW;
+    } break;
+    case rofl::openflow13::OFPT_ECHO_REQUEST:
+    case rofl::openflow13::OFPT_ECHO_REPLY: {
+      queue_id = QUEUE_OAM;
+    } break;
+    default: { queue_id = QUEUE_MGMT; };
     }
+  } break;
+  case rofl::openflow14::OFP_VERSION: {
+    switch (msg->get_type()) {
+    case rofl::openflow14::OFPT_PACKET_IN:
+    case rofl::openflow14::OFPT_PACKET_OUT: {
+      queue_id = QUEUE_PKT;
+    } break;
+    case rofl::openflow14::OFPT_FLOW_MOD:
+    case rofl::openflow14::OFPT_FLOW_REMOVED:
+    case rofl::openflow14::OFPT_GROUP_MOD:
+    case rofl::openflow14::OFPT_PORT_MOD:
+    case rofl::openflow14::OFPT_TABLE_MOD:
+    case rofl::openflow14::OFPT_METER_MOD:
+    case rofl::openflow14::OFPT_BARRIER_REPLY:
+    case rofl::openflow14::OFPT_BARRIER_REQUEST:
+    case rofl::openflow14::OFPT_BUNDLE_CONTROL:
+    case rofl::openflow14::OFPT_BUNDLE_ADD_MESSAGE: {
+      queue_id = QUEUE_FLOW;
+    } break;
+    case rofl::openflow14::OFPT_ECHO_REQUEST:
+    case rofl::openflow14::OFPT_ECHO_REPLY: {
+      queue_id = QUEUE_OAM;
+    } break;
+    default: { queue_id = QUEUE_MGMT; };
+    }
+  };
+  }
 
-    /* message was queued, waiting for transmission */
-    return MSG_QUEUED;
-
-  } catch (eRofQueueFull &e) {
+  if (0 == txqueues[queue_id].try_store(msg, enforce_queueing)) {
     VLOG(6) << __FUNCTION__ << " txqueue exhausted, "
             << " msg=" << msg
             << " txqueue_pending_pkts=" << txqueue_pending_pkts
             << " tx_disabled=" << tx_disabled
             << " tx_is_running=" << tx_is_running;
+    txstats[queue_id].drops++;
+    txqueue_exhausted = true;
     delete msg;
     /* message was not stored in txqueue and deleted here */
     return MSG_QUEUEING_FAILED_QUEUE_FULL;
   }
+
+  txqueue_pending_pkts++;
+
+  if (not tx_is_running) {
+    cthread::thread(tx_thread_num).wakeup(this);
+  }
+
+  if (flag_test(FLAG_TX_BLOCK_QUEUEING)) {
+    /* message was queued, but congestion prevents us from sending it */
+    return MSG_QUEUED_CONGESTION;
+  }
+
+  /* message was queued, waiting for transmission */
+  return MSG_QUEUED;
 }
 
 void crofsock::handle_wakeup(cthread &thread) {
@@ -1531,6 +1708,18 @@ void crofsock::handle_wakeup(cthread &thread) {
     return;
   }
 
+  /* name resolution completed, restart the suspended connect */
+  if (flag_test(FLAG_RESOLVING) &&
+      (&thread == &cthread::thread(rx_thread_num))) {
+    flag_set(FLAG_RESOLVING, false);
+    if (flag_test(FLAG_TLS_IN_USE)) {
+      tls_connect(flag_test(FLAG_RECONNECT_ON_FAILURE));
+    } else {
+      tcp_connect(flag_test(FLAG_RECONNECT_ON_FAILURE));
+    }
+    return;
+  }
+
   if (&thread == &cthread::thread(rx_thread_num)) {
     // recv_message();
     handle_read_event_rxthread(thread, sd);
@@ -1571,7 +1760,12 @@ void crofsock::send_from_queue() {
     reschedule = false;
     for (unsigned int queue_id = 0; queue_id < QUEUE_MAX; ++queue_id) {
 
-      for (unsigned int num = 0; num < txweights[queue_id]; ++num) {
+      /* deficit round robin: grant credit to backlogged txqueues only */
+      if (not txqueues[queue_id].empty()) {
+        txdeficits[queue_id] += txquanta[queue_id];
+      }
+
+      while (true) {
 
         if ((tx_disabled) || (get_state() < STATE_TCP_ESTABLISHED)) {
           tx_is_running = false;
@@ -1581,15 +1775,45 @@ void crofsock::send_from_queue() {
         /* no pending fragment */
         if (txbuffer.empty()) {
           rofl::openflow::cofmsg *msg = nullptr;
+          unsigned int class_id = queue_id;
+
+          /* Echo messages overtake all other txqueues */
+          bool strict = false;
+          if (oam_strict_priority && (not txqueues[QUEUE_OAM].empty())) {
+            class_id = QUEUE_OAM;
+            strict = true;
+          }
 
           /* fetch a new message for transmission from tx queue */
-          if ((msg = txqueues[queue_id].retrieve()) == NULL)
+          if ((msg = txqueues[class_id].front()) == NULL)
             break;
-          // txqueues[queue_id].pop();
+
+          size_t msglen = msg->length();
+
+          /* wait for next round, if credit does not cover this message */
+          if (not strict) {
+            if (msglen > txdeficits[class_id])
+              break;
+            txdeficits[class_id] -= msglen;
+          }
+
+          uint64_t stamp = txqueues[class_id].front_stamp();
+          txqueues[class_id].pop();
+
+          /* queueing delay statistics */
+          uint64_t now = cclock::now();
+          uint64_t delay = (now > stamp) ? (now - stamp) / 1000 : 0;
+          txstats[class_id].tx_msgs++;
+          txstats[class_id].tx_bytes += msglen;
+          txstats[class_id].delay_usec_sum += delay;
+          if (delay > txstats[class_id].delay_usec_max)
+            txstats[class_id].delay_usec_max = delay;
 
           /* pack message into txbuffer */
           msg->pack(txbuffer.sowmem(), txbuffer.wmemlen());
-          txbuffer.wseek(msg->length());
+          cmsgtrace::record(cmsgtrace::DIR_TX, trace_connid, trace_auxid,
+                            txbuffer.sowmem(), msglen);
+          txbuffer.wseek(msglen);
 
           VLOG(6) << __FUNCTION__ << " sd=" << sd
                   << " message sent: " << msg->str().c_str()
@@ -1603,8 +1827,12 @@ void crofsock::send_from_queue() {
         case STATE_TCP_ESTABLISHED: {
 
           /* send memory block via socket in non-blocking mode */
-          int nbytes = ::send(sd, txbuffer.sormem(), txbuffer.rmemlen(),
-                              MSG_DONTWAIT | MSG_NOSIGNAL);
+          int nbytes =
+              flag_test(FLAG_MEMCHANNEL)
+                  ? channel->send(channel_side, txbuffer.sormem(),
+                                  txbuffer.rmemlen())
+                  : ::send(sd, txbuffer.sormem(), txbuffer.rmemlen(),
+                           MSG_DONTWAIT | MSG_NOSIGNAL);
 
           /* error occurred */
           if (nbytes < 0) {
@@ -1612,7 +1840,12 @@ void crofsock::send_from_queue() {
             case EAGAIN: /* socket would block */ {
               tx_is_running = false;
               flag_set(FLAG_CONGESTED, true);
-              cthread::thread(tx_thread_num).add_write_fd(this, sd);
+              if (flag_test(FLAG_MEMCHANNEL)) {
+                cthread::thread(tx_thread_num)
+                    .add_read_fd(this, channel_txfd, true, true);
+              } else {
+                cthread::thread(tx_thread_num).add_write_fd(this, sd);
+              }
 
               if (not flag_test(FLAG_TX_BLOCK_QUEUEING)) {
                 /* block transmission of further packets */
@@ -1784,11 +2017,16 @@ void crofsock::send_from_queue() {
 
           VLOG(6) << __FUNCTION__ << " unable to send in state=" << str()
                   << " on sd=" << sd;
-        };
+          tx_is_running = false;
+        }
+          return;
         }
       }
 
-      if (not txqueues[queue_id].empty()) {
+      /* idle txqueues must not accumulate credit */
+      if (txqueues[queue_id].empty()) {
+        txdeficits[queue_id] = 0;
+      } else {
         reschedule = true;
       }
     }
@@ -1803,8 +2041,18 @@ void crofsock::send_from_queue() {
                 << " txqueue_size_tx_threshold" << txqueue_size_tx_threshold
                 << " laddr=" << laddr.str() << " raddr=" << raddr.str();
 
+        txqueue_exhausted = false;
         crofsock_env::call_env(env).congestion_solved_indication(*this);
       }
+    } else if (txqueue_exhausted && (not flag_test(FLAG_TX_BLOCK_QUEUEING)) &&
+               (txqueue_pending_pkts <= get_txqueue_max_size() / 2)) {
+      /* producers stopped by an exhausted txqueue may resume */
+      txqueue_exhausted = false;
+      VLOG(6) << __FUNCTION__ << " sd=" << sd << " txqueue drained"
+              << " txqueue_pending_pkts" << txqueue_pending_pkts
+              << " laddr=" << laddr.str() << " raddr=" << raddr.str();
+
+      crofsock_env::call_env(env).congestion_solved_indication(*this);
     }
 
   } while (reschedule);
@@ -1820,7 +2068,12 @@ void crofsock::handle_read_event(cthread &thread, int fd) {
   if (flag_test(FLAG_CLOSING) || delete_in_progress()) {
     return;
   }
-  if (&thread == &cthread::thread(rx_thread_num)) {
+  if ((&thread == &cthread::thread(tx_thread_num)) && (fd == channel_txfd)) {
+    /* space available in memory channel */
+    flag_set(FLAG_CONGESTED, false);
+    cthread::thread(tx_thread_num).drop_read_fd(channel_txfd);
+    send_from_queue();
+  } else if (&thread == &cthread::thread(rx_thread_num)) {
     handle_read_event_rxthread(thread, fd);
   }
 }
@@ -1993,8 +2246,13 @@ void crofsock::recv_message() {
     switch (state.load()) {
     case STATE_TCP_ESTABLISHED: {
       /* read from socket more bytes, at most "msg_len - msg_bytes_read" */
-      nbytes = ::recv(sd, (void *)(rxbuffer.sowmem()),
-                      msg_len - rxbuffer.rmemlen(), MSG_DONTWAIT);
+      if (flag_test(FLAG_MEMCHANNEL)) {
+        nbytes = channel->recv(channel_side, rxbuffer.sowmem(),
+                               msg_len - rxbuffer.rmemlen());
+      } else {
+        nbytes = ::recv(sd, (void *)(rxbuffer.sowmem()),
+                        msg_len - rxbuffer.rmemlen(), MSG_DONTWAIT);
+      }
 
       if (nbytes < 0) {
         switch (errno) {
@@ -2153,30 +2411,24 @@ void crofsock::parse_message() {
       (struct rofl::openflow::ofp_header *)rxbuffer.somem();
 
   rofl::openflow::cofmsg *msg = (rofl::openflow::cofmsg *)0;
-  try {
-    if (rxbuffer.length() < sizeof(struct rofl::openflow::ofp_header)) {
-      throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
-                              __LINE__);
-    }
 
+  cmsgtrace::record(cmsgtrace::DIR_RX, trace_connid, trace_auxid,
+                    rxbuffer.sormem(), rxbuffer.rmemlen());
+
+  try {
     /* make sure to have a valid cofmsg* msg object after parsing */
-    switch (hdr->version) {
-    case rofl::openflow10::OFP_VERSION: {
-      parse_of10_message(&msg);
-    } break;
-    case rofl::openflow12::OFP_VERSION: {
-      parse_of12_message(&msg);
-    } break;
-    case rofl::openflow13::OFP_VERSION: {
-      parse_of13_message(&msg);
-    } break;
-    default: {
-      throw eBadRequestBadVersion("eBadRequestBadVersion", __FILE__,
-                                  __FUNCTION__, __LINE__);
-    };
+    parse_result_t result = try_parse(&msg);
+    if (PARSE_OK != result) {
+      VLOG(1) << __FUNCTION__ << " sd=" << sd
+              << " dropping message xid=" << be32toh(hdr->xid)
+              << " result=" << result << " laddr=" << laddr.str()
+              << " raddr=" << raddr.str();
+      send_bad_request(result);
+      return;
     }
 
     if ((get_state() <= STATE_IDLE) || delete_in_progress()) {
+      delete msg;
       return;
     }
 
@@ -2191,18 +2443,14 @@ void crofsock::parse_message() {
     VLOG(1) << __FUNCTION__ << " dropping message xid=" << be32toh(hdr->xid)
             << " laddr=" << laddr.str() << " raddr=" << raddr.str();
 
-    send_message(new rofl::openflow::cofmsg_error_bad_request_bad_type(
-        hdr->version, be32toh(hdr->xid), rxbuffer.somem(),
-        (rxbuffer.rmemlen() > 64) ? 64 : rxbuffer.rmemlen()));
+    send_bad_request(PARSE_BAD_TYPE);
 
   } catch (eBadRequestBadStat &e) {
 
     VLOG(1) << __FUNCTION__ << " dropping message xid=" << be32toh(hdr->xid)
             << " laddr=" << laddr.str() << " raddr=" << raddr.str();
 
-    send_message(new rofl::openflow::cofmsg_error_bad_request_bad_stat(
-        hdr->version, be32toh(hdr->xid), rxbuffer.somem(),
-        (rxbuffer.rmemlen() > 64) ? 64 : rxbuffer.rmemlen()));
+    send_bad_request(PARSE_BAD_STAT);
 
   } catch (eBadRequestBadVersion &e) {
 
@@ -2212,9 +2460,7 @@ void crofsock::parse_message() {
     if (msg)
       delete msg;
 
-    send_message(new rofl::openflow::cofmsg_error_bad_request_bad_version(
-        hdr->version, be32toh(hdr->xid), rxbuffer.somem(),
-        (rxbuffer.rmemlen() > 64) ? 64 : rxbuffer.rmemlen()));
+    send_bad_request(PARSE_BAD_VERSION);
 
   } catch (eBadRequestBadLen &e) {
 
@@ -2225,9 +2471,7 @@ void crofsock::parse_message() {
     if (msg)
       delete msg;
 
-    send_message(new rofl::openflow::cofmsg_error_bad_request_bad_len(
-        hdr->version, be32toh(hdr->xid), rxbuffer.somem(),
-        (rxbuffer.rmemlen() > 64) ? 64 : rxbuffer.rmemlen()));
+    send_bad_request(PARSE_BAD_LEN);
 
   } catch (rofl::exception &e) {
 
@@ -2243,7 +2487,94 @@ void crofsock::parse_message() {
   }
 }
 
-void crofsock::parse_of10_message(rofl::openflow::cofmsg **pmsg) {
+crofsock::parse_result_t crofsock::try_parse(rofl::openflow::cofmsg **pmsg) {
+  *pmsg = (rofl::openflow::cofmsg *)0;
+
+  if (rxbuffer.length() < sizeof(struct rofl::openflow::ofp_header)) {
+    return PARSE_BAD_LEN;
+  }
+
+  parse_result_t result = PARSE_BAD_VERSION;
+
+  switch (((struct rofl::openflow::ofp_header *)rxbuffer.somem())->version) {
+  case rofl::openflow10::OFP_VERSION: {
+    result = parse_of10_message(pmsg);
+  } break;
+  case rofl::openflow12::OFP_VERSION: {
+    result = parse_of12_message(pmsg);
+  } break;
+  case rofl::openflow13::OFP_VERSION: {
+    result = parse_of13_message(pmsg);
+  } break;
+  case rofl::openflow14::OFP_VERSION: {
+    result = parse_of14_message(pmsg);
+  } break;
+  default: {
+    return PARSE_BAD_VERSION;
+  };
+  }
+
+  if (PARSE_OK != result) {
+    return result;
+  }
+
+  /* message bodies still report malformed content by exception */
+  try {
+    (*pmsg)->unpack(rxbuffer.sormem(), rxbuffer.rmemlen());
+  } catch (eBadRequestBadLen &e) {
+    result = PARSE_BAD_LEN;
+  } catch (eBadRequestBadType &e) {
+    result = PARSE_BAD_TYPE;
+  } catch (eBadRequestBadStat &e) {
+    result = PARSE_BAD_STAT;
+  } catch (eBadRequestBadVersion &e) {
+    result = PARSE_BAD_VERSION;
+  } catch (...) {
+    delete *pmsg;
+    *pmsg = (rofl::openflow::cofmsg *)0;
+    throw;
+  }
+
+  if (PARSE_OK != result) {
+    delete *pmsg;
+    *pmsg = (rofl::openflow::cofmsg *)0;
+    return result;
+  }
+
+  rxbuffer.reset();
+  return PARSE_OK;
+}
+
+void crofsock::send_bad_request(parse_result_t result) {
+  struct rofl::openflow::ofp_header *hdr =
+      (struct rofl::openflow::ofp_header *)rxbuffer.somem();
+  uint8_t version = hdr->version;
+  uint32_t xid = be32toh(hdr->xid);
+  size_t len = (rxbuffer.rmemlen() > 64) ? 64 : rxbuffer.rmemlen();
+
+  switch (result) {
+  case PARSE_BAD_TYPE: {
+    send_message(new rofl::openflow::cofmsg_error_bad_request_bad_type(
+        version, xid, rxbuffer.somem(), len));
+  } break;
+  case PARSE_BAD_STAT: {
+    send_message(new rofl::openflow::cofmsg_error_bad_request_bad_stat(
+        version, xid, rxbuffer.somem(), len));
+  } break;
+  case PARSE_BAD_VERSION: {
+    send_message(new rofl::openflow::cofmsg_error_bad_request_bad_version(
+        version, xid, rxbuffer.somem(), len));
+  } break;
+  case PARSE_BAD_LEN: {
+    send_message(new rofl::openflow::cofmsg_error_bad_request_bad_len(
+        version, xid, rxbuffer.somem(), len));
+  } break;
+  default: {};
+  }
+}
+
+crofsock::parse_result_t
+crofsock::parse_of10_message(rofl::openflow::cofmsg **pmsg) {
   struct openflow::ofp_header *header =
       (struct openflow::ofp_header *)rxbuffer.somem();
 
@@ -2299,8 +2630,7 @@ void crofsock::parse_of10_message(rofl::openflow::cofmsg **pmsg) {
   case rofl::openflow10::OFPT_STATS_REQUEST: {
     if (rxbuffer.length() <
         sizeof(struct rofl::openflow10::ofp_stats_request)) {
-      throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
-                              __LINE__);
+      return PARSE_BAD_LEN;
     }
     uint16_t stats_type = be16toh(
         ((struct rofl::openflow10::ofp_stats_request *)rxbuffer.somem())->type);
@@ -2327,15 +2657,13 @@ void crofsock::parse_of10_message(rofl::openflow::cofmsg **pmsg) {
       *pmsg = new rofl::openflow::cofmsg_experimenter_stats_request();
     } break;
     default: {
-      throw eBadRequestBadStat("eBadRequestBadStat", __FILE__, __FUNCTION__,
-                               __LINE__);
+      return PARSE_BAD_STAT;
     };
     }
   } break;
   case rofl::openflow10::OFPT_STATS_REPLY: {
     if (rxbuffer.length() < sizeof(struct rofl::openflow10::ofp_stats_reply)) {
-      throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
-                              __LINE__);
+      return PARSE_BAD_LEN;
     }
     uint16_t stats_type = be16toh(
         ((struct rofl::openflow10::ofp_stats_reply *)rxbuffer.somem())->type);
@@ -2362,8 +2690,7 @@ void crofsock::parse_of10_message(rofl::openflow::cofmsg **pmsg) {
       *pmsg = new rofl::openflow::cofmsg_experimenter_stats_reply();
     } break;
     default: {
-      throw eBadRequestBadStat("eBadRequestBadStat", __FILE__, __FUNCTION__,
-                               __LINE__);
+      return PARSE_BAD_STAT;
     };
     }
   } break;
@@ -2380,16 +2707,15 @@ void crofsock::parse_of10_message(rofl::openflow::cofmsg **pmsg) {
     *pmsg = new rofl::openflow::cofmsg_queue_get_config_reply();
   } break;
   default: {
-    throw eBadRequestBadType("eBadRequestBadType", __FILE__, __FUNCTION__,
-                             __LINE__);
+    return PARSE_BAD_TYPE;
   };
   }
 
-  (*(*pmsg)).unpack(rxbuffer.sormem(), rxbuffer.rmemlen());
-  rxbuffer.reset();
+  return PARSE_OK;
 }
 
-void crofsock::parse_of12_message(rofl::openflow::cofmsg **pmsg) {
+crofsock::parse_result_t
+crofsock::parse_of12_message(rofl::openflow::cofmsg **pmsg) {
   struct openflow::ofp_header *header =
       (struct openflow::ofp_header *)rxbuffer.somem();
 
@@ -2451,8 +2777,7 @@ void crofsock::parse_of12_message(rofl::openflow::cofmsg **pmsg) {
   case rofl::openflow12::OFPT_STATS_REQUEST: {
     if (rxbuffer.length() <
         sizeof(struct rofl::openflow12::ofp_stats_request)) {
-      throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
-                              __LINE__);
+      return PARSE_BAD_LEN;
     }
     uint16_t stats_type = be16toh(
         ((struct rofl::openflow12::ofp_stats_request *)rxbuffer.somem())->type);
@@ -2488,15 +2813,13 @@ void crofsock::parse_of12_message(rofl::openflow::cofmsg **pmsg) {
       *pmsg = new rofl::openflow::cofmsg_experimenter_stats_request();
     } break;
     default: {
-      throw eBadRequestBadStat("eBadRequestBadStat", __FILE__, __FUNCTION__,
-                               __LINE__);
+      return PARSE_BAD_STAT;
     };
     }
   } break;
   case rofl::openflow12::OFPT_STATS_REPLY: {
     if (rxbuffer.length() < sizeof(struct rofl::openflow12::ofp_stats_reply)) {
-      throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
-                              __LINE__);
+      return PARSE_BAD_LEN;
     }
     uint16_t stats_type = be16toh(
         ((struct rofl::openflow12::ofp_stats_reply *)rxbuffer.somem())->type);
@@ -2532,8 +2855,7 @@ void crofsock::parse_of12_message(rofl::openflow::cofmsg **pmsg) {
       *pmsg = new rofl::openflow::cofmsg_experimenter_stats_reply();
     } break;
     default: {
-      throw eBadRequestBadStat("eBadRequestBadStat", __FILE__, __FUNCTION__,
-                               __LINE__);
+      return PARSE_BAD_STAT;
     };
     }
   } break;
@@ -2565,16 +2887,15 @@ void crofsock::parse_of12_message(rofl::openflow::cofmsg **pmsg) {
     *pmsg = new rofl::openflow::cofmsg_set_async_config();
   } break;
   default: {
-    throw eBadRequestBadType("eBadRequestBadType", __FILE__, __FUNCTION__,
-                             __LINE__);
+    return PARSE_BAD_TYPE;
   };
   }
 
-  (*(*pmsg)).unpack(rxbuffer.sormem(), rxbuffer.rmemlen());
-  rxbuffer.reset();
+  return PARSE_OK;
 }
 
-void crofsock::parse_of13_message(rofl::openflow::cofmsg **pmsg) {
+crofsock::parse_result_t
+crofsock::parse_of13_message(rofl::openflow::cofmsg **pmsg) {
   struct openflow::ofp_header *header =
       (struct openflow::ofp_header *)rxbuffer.somem();
 
@@ -2636,8 +2957,7 @@ void crofsock::parse_of13_message(rofl::openflow::cofmsg **pmsg) {
   case rofl::openflow13::OFPT_MULTIPART_REQUEST: {
     if (rxbuffer.memlen() <
         sizeof(struct rofl::openflow13::ofp_multipart_request)) {
-      throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
-                              __LINE__);
+      return PARSE_BAD_LEN;
     }
     uint16_t stats_type = be16toh(
         ((struct rofl::openflow13::ofp_multipart_request *)rxbuffer.somem())
@@ -2689,16 +3009,14 @@ void crofsock::parse_of13_message(rofl::openflow::cofmsg **pmsg) {
       *pmsg = new rofl::openflow::cofmsg_experimenter_stats_request();
     } break;
     default: {
-      throw eBadRequestBadStat("eBadRequestBadStat", __FILE__, __FUNCTION__,
-                               __LINE__);
+      return PARSE_BAD_STAT;
     };
     }
   } break;
   case rofl::openflow13::OFPT_MULTIPART_REPLY: {
     if (rxbuffer.memlen() <
         sizeof(struct rofl::openflow13::ofp_multipart_reply)) {
-      throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
-                              __LINE__);
+      return PARSE_BAD_LEN;
     }
     uint16_t stats_type = be16toh(
         ((struct rofl::openflow13::ofp_multipart_reply *)rxbuffer.somem())
@@ -2750,8 +3068,7 @@ void crofsock::parse_of13_message(rofl::openflow::cofmsg **pmsg) {
       *pmsg = new rofl::openflow::cofmsg_experimenter_stats_reply();
     } break;
     default: {
-      throw eBadRequestBadStat("eBadRequestBadStat", __FILE__, __FUNCTION__,
-                               __LINE__);
+      return PARSE_BAD_STAT;
     };
     }
   } break;
@@ -2786,11 +3103,54 @@ void crofsock::parse_of13_message(rofl::openflow::cofmsg **pmsg) {
     *pmsg = new rofl::openflow::cofmsg_meter_mod();
   } break;
   default: {
-    throw eBadRequestBadType("eBadRequestBadType", __FILE__, __FUNCTION__,
-                             __LINE__);
+    return PARSE_BAD_TYPE;
   };
   }
 
-  (*(*pmsg)).unpack(rxbuffer.sormem(), rxbuffer.rmemlen());
-  rxbuffer.reset();
+  return PARSE_OK;
+}
+
+crofsock::parse_result_t
+crofsock::parse_of14_message(rofl::openflow::cofmsg **pmsg) {
+  struct openflow::ofp_header *header =
+      (struct openflow::ofp_header *)rxbuffer.somem();
+
+  switch (header->type) {
+  case rofl::openflow14::OFPT_BUNDLE_CONTROL: {
+    *pmsg = new rofl::openflow::cofmsg_bundle_control();
+  } break;
+  case rofl::openflow14::OFPT_BUNDLE_ADD_MESSAGE: {
+    *pmsg = new rofl::openflow::cofmsg_bundle_add_message();
+  } break;
+  case rofl::openflow14::OFPT_ROLE_STATUS: {
+    *pmsg = new rofl::openflow::cofmsg_role_status();
+  } break;
+  case rofl::openflow14::OFPT_TABLE_STATUS: {
+    *pmsg = new rofl::openflow::cofmsg_table_status();
+  } break;
+  case rofl::openflow14::OFPT_MULTIPART_REQUEST:
+  case rofl::openflow14::OFPT_MULTIPART_REPLY: {
+    if (rxbuffer.memlen() <
+        sizeof(struct rofl::openflow13::ofp_multipart_request)) {
+      return PARSE_BAD_LEN;
+    }
+    uint16_t stats_type = be16toh(
+        ((struct rofl::openflow13::ofp_multipart_request *)rxbuffer.somem())
+            ->type);
+    if (rofl::openflow14::OFPMP_FLOW_MONITOR != stats_type) {
+      return parse_of13_message(pmsg);
+    }
+    if (rofl::openflow14::OFPT_MULTIPART_REQUEST == header->type) {
+      *pmsg = new rofl::openflow::cofmsg_flow_monitor_request();
+    } else {
+      *pmsg = new rofl::openflow::cofmsg_flow_monitor_reply();
+    }
+  } break;
+  default: {
+    /* remaining message types share their OpenFlow 1.3 wire format */
+    return parse_of13_message(pmsg);
+  };
+  }
+
+  return PARSE_OK;
 }
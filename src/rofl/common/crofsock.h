@@ -23,6 +23,7 @@
 #include <iostream>
 #include <list>
 #include <map>
+#include <memory>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <set>
@@ -31,6 +32,7 @@
 #include <strings.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
 #include <sys/uio.h>
 #include <sys/un.h>
 #include <unistd.h>
@@ -43,18 +45,23 @@
 #include <openssl/ssl.h>
 
 #include "rofl/common/cbuffer.hpp"
+#include "rofl/common/cmemchannel.hpp"
 #include "rofl/common/cmemory.h"
+#include "rofl/common/cmsgtrace.hpp"
 
 #include "rofl/common/crandom.h"
+#include "rofl/common/cresolver.hpp"
 #include "rofl/common/crofqueue.h"
 #include "rofl/common/csockaddr.h"
 #include "rofl/common/cthread.hpp"
+#include "rofl/common/ctlscontext.h"
 #include "rofl/common/exception.hpp"
 
 #include "rofl/common/openflow/messages/cofmsg.h"
 #include "rofl/common/openflow/messages/cofmsg_aggr_stats.h"
 #include "rofl/common/openflow/messages/cofmsg_async_config.h"
 #include "rofl/common/openflow/messages/cofmsg_barrier.h"
+#include "rofl/common/openflow/messages/cofmsg_bundle.h"
 #include "rofl/common/openflow/messages/cofmsg_config.h"
 #include "rofl/common/openflow/messages/cofmsg_desc_stats.h"
 #include "rofl/common/openflow/messages/cofmsg_echo.h"
@@ -64,6 +71,7 @@
 #include "rofl/common/openflow/messages/cofmsg_features.h"
 #include "rofl/common/openflow/messages/cofmsg_flow_mod.h"
 #include "rofl/common/openflow/messages/cofmsg_flow_removed.h"
+#include "rofl/common/openflow/messages/cofmsg_flow_monitor.h"
 #include "rofl/common/openflow/messages/cofmsg_flow_stats.h"
 #include "rofl/common/openflow/messages/cofmsg_group_desc_stats.h"
 #include "rofl/common/openflow/messages/cofmsg_group_features_stats.h"
@@ -76,6 +84,8 @@
 #include "rofl/common/openflow/messages/cofmsg_meter_stats.h"
 #include "rofl/common/openflow/messages/cofmsg_packet_in.h"
 #include "rofl/common/openflow/messages/cofmsg_packet_out.h"
+#include "rofl/common/openflow/messages/cofmsg_packed.h"
+#include "rofl/common/openflow/messages/cofmsg_shared.h"
 #include "rofl/common/openflow/messages/cofmsg_port_desc_stats.h"
 #include "rofl/common/openflow/messages/cofmsg_port_mod.h"
 #include "rofl/common/openflow/messages/cofmsg_port_stats.h"
@@ -83,10 +93,12 @@
 #include "rofl/common/openflow/messages/cofmsg_queue_get_config.h"
 #include "rofl/common/openflow/messages/cofmsg_queue_stats.h"
 #include "rofl/common/openflow/messages/cofmsg_role.h"
+#include "rofl/common/openflow/messages/cofmsg_role_status.h"
 #include "rofl/common/openflow/messages/cofmsg_stats.h"
 #include "rofl/common/openflow/messages/cofmsg_table_features_stats.h"
 #include "rofl/common/openflow/messages/cofmsg_table_mod.h"
 #include "rofl/common/openflow/messages/cofmsg_table_stats.h"
+#include "rofl/common/openflow/messages/cofmsg_table_status.h"
 
 namespace rofl {
 
@@ -221,6 +233,7 @@ private:
  * @brief	A socket capable of talking OpenFlow via TCP and vice versa
  */
 class crofsock : public cthread_env {
+public:
   enum outqueue_type_t {
     QUEUE_OAM = 0,  // Echo.request/Echo.reply
     QUEUE_MGMT = 1, // all remaining packets, except ...
@@ -229,6 +242,19 @@ class crofsock : public cthread_env {
     QUEUE_MAX,      // do not use
   };
 
+  /**
+   * @brief	Transmission statistics of a txqueue
+   */
+  struct txqueue_stats_t {
+    uint64_t tx_msgs;        // messages sent
+    uint64_t tx_bytes;       // bytes sent
+    uint64_t drops;          // messages rejected by a full txqueue
+    uint64_t delay_usec_sum; // accumulated queueing delay of sent messages
+    uint64_t delay_usec_max; // maximum queueing delay of sent messages
+  };
+
+private:
+
   enum crofsock_flag_t {
     FLAG_DELETE_IN_PROGRESS,
     FLAG_CONGESTED,
@@ -236,6 +262,8 @@ class crofsock : public cthread_env {
     FLAG_RECONNECT_ON_FAILURE,
     FLAG_TLS_IN_USE,
     FLAG_CLOSING,
+    FLAG_MEMCHANNEL,
+    FLAG_RESOLVING,
   };
 
   enum socket_mode_t {
@@ -272,6 +300,14 @@ public:
     MSG_QUEUEING_FAILED_SHUTDOWN_IN_PROGRESS,
   };
 
+  enum parse_result_t {
+    PARSE_OK,
+    PARSE_BAD_LEN,
+    PARSE_BAD_VERSION,
+    PARSE_BAD_TYPE,
+    PARSE_BAD_STAT,
+  };
+
 public:
   /**
    *
@@ -306,6 +342,25 @@ public:
    */
   virtual void tcp_connect(bool reconnect = true);
 
+  /**
+   * @brief	Establishes the socket on one side of an in-process channel
+   *
+   * Acts as server, i.e., crofsock_env::handle_tcp_accepted() is called.
+   * The socket stays on the channel's side until it is closed, neither
+   * TLS nor reconnects are supported. The peer side is typically served
+   * by another crofsock instance calling mem_connect().
+   */
+  virtual void mem_accept(std::shared_ptr<cmemchannel> channel,
+                          cmemchannel::side_t side);
+
+  /**
+   * @brief	Establishes the socket on one side of an in-process channel
+   *
+   * Acts as client, i.e., crofsock_env::handle_tcp_connected() is called.
+   */
+  virtual void mem_connect(std::shared_ptr<cmemchannel> channel,
+                           cmemchannel::side_t side);
+
   /**
    *
    */
@@ -394,7 +449,7 @@ public:
    * @brief	Returns capacity of transmission queues in messages
    */
   size_t get_txqueue_max_size() const {
-    return txqueue_size_congestion_occurred;
+    return txqueues[QUEUE_OAM].get_queue_max_size();
   };
 
   /**
@@ -408,6 +463,111 @@ public:
     return *this;
   };
 
+  /**
+   * @brief	Returns number of messages a txqueue may still accept
+   *
+   * Once an exhausted txqueue has drained to half of its maximum size,
+   * congestion_solved_indication() is called.
+   */
+  size_t get_txqueue_capacity(outqueue_type_t queue_id) const {
+    if (QUEUE_MAX <= queue_id) {
+      throw eRofSockInvalid("crofsock::get_txqueue_capacity() invalid queue_id",
+                            __FILE__, __FUNCTION__, __LINE__);
+    }
+    size_t capacity = txqueues[queue_id].capacity();
+    if (0 == capacity) {
+      txqueue_exhausted = true;
+      /* the tx thread may have drained the txqueue meanwhile */
+      capacity = txqueues[queue_id].capacity();
+    }
+    return capacity;
+  };
+
+  /**
+   * @brief	Returns deficit round robin quantum of a txqueue in bytes
+   */
+  size_t get_txqueue_quantum(outqueue_type_t queue_id) const {
+    if (QUEUE_MAX <= queue_id) {
+      throw eRofSockInvalid("crofsock::get_txqueue_quantum() invalid queue_id",
+                            __FILE__, __FUNCTION__, __LINE__);
+    }
+    return txquanta[queue_id];
+  };
+
+  /**
+   * @brief	Sets deficit round robin quantum of a txqueue in bytes
+   *
+   * Each scheduling round grants a txqueue its quantum of bytes. A message
+   * is sent once the txqueue has collected credit for its full length, so
+   * the share of the link is independent of message sizes.
+   */
+  crofsock &set_txqueue_quantum(outqueue_type_t queue_id, size_t quantum) {
+    if (QUEUE_MAX <= queue_id) {
+      throw eRofSockInvalid("crofsock::set_txqueue_quantum() invalid queue_id",
+                            __FILE__, __FUNCTION__, __LINE__);
+    }
+    txquanta[queue_id] = (quantum > 0) ? quantum : 1;
+    return *this;
+  };
+
+  /**
+   * @brief	Returns true if QUEUE_OAM is served with strict priority
+   */
+  bool get_oam_strict_priority() const { return oam_strict_priority; };
+
+  /**
+   * @brief	Serve QUEUE_OAM with strict priority ahead of all other txqueues
+   */
+  crofsock &set_oam_strict_priority(bool strict) {
+    oam_strict_priority = strict;
+    return *this;
+  };
+
+  /**
+   * @brief	Returns transmission statistics of a txqueue
+   */
+  txqueue_stats_t get_txqueue_stats(outqueue_type_t queue_id) const {
+    if (QUEUE_MAX <= queue_id) {
+      throw eRofSockInvalid("crofsock::get_txqueue_stats() invalid queue_id",
+                            __FILE__, __FUNCTION__, __LINE__);
+    }
+    txqueue_stats_t stats;
+    stats.tx_msgs = txstats[queue_id].tx_msgs;
+    stats.tx_bytes = txstats[queue_id].tx_bytes;
+    stats.drops = txstats[queue_id].drops;
+    stats.delay_usec_sum = txstats[queue_id].delay_usec_sum;
+    stats.delay_usec_max = txstats[queue_id].delay_usec_max;
+    return stats;
+  };
+
+  /**
+   * @brief	Resets transmission statistics of all txqueues
+   */
+  crofsock &clear_txqueue_stats() {
+    for (unsigned int queue_id = 0; queue_id < QUEUE_MAX; queue_id++) {
+      txstats[queue_id].tx_msgs = 0;
+      txstats[queue_id].tx_bytes = 0;
+      txstats[queue_id].drops = 0;
+      txstats[queue_id].delay_usec_sum = 0;
+      txstats[queue_id].delay_usec_max = 0;
+    }
+    return *this;
+  };
+
+public:
+  /**
+   * @brief	Returns identifier of this socket in message traces
+   */
+  uint64_t get_trace_connid() const { return trace_connid; };
+
+  /**
+   * @brief	Sets auxiliary id recorded along with messages in traces
+   */
+  crofsock &set_trace_auxid(uint8_t auxid) {
+    trace_auxid = auxid;
+    return *this;
+  };
+
 public:
   /**
    *
@@ -440,6 +600,21 @@ public:
    */
   crofsock &set_raddr(const csockaddr &raddr) {
     this->raddr = raddr;
+    rnode.clear();
+    rservice.clear();
+    return *this;
+  };
+
+  /**
+   * @brief	Sets remote address by host name and service
+   *
+   * The name is resolved via cresolver on every tcp_connect() or
+   * tls_connect() without blocking the calling thread. The connection
+   * attempt continues once the name has been resolved.
+   */
+  crofsock &set_raddr(const std::string &node, const std::string &service) {
+    rnode = node;
+    rservice = service;
     return *this;
   };
 
@@ -448,6 +623,16 @@ public:
    */
   const csockaddr &get_raddr() const { return raddr; };
 
+  /**
+   *
+   */
+  const std::string &get_rnode() const { return rnode; };
+
+  /**
+   *
+   */
+  const std::string &get_rservice() const { return rservice; };
+
 public:
   /**
    *
@@ -643,8 +828,6 @@ private:
 
   void tls_term_context();
 
-  static int tls_pswd_cb(char *buf, int size, int rwflag, void *userdata);
-
   bool tls_verify_ok();
 
   void tls_log_errors();
@@ -654,17 +837,42 @@ private:
 
   void parse_message();
 
-  void parse_of10_message(rofl::openflow::cofmsg **pmsg);
+  /**
+   * @brief	Parses the message in rxbuffer without throwing for malformed
+   * input
+   *
+   * On success *pmsg holds the new message, otherwise *pmsg is null and
+   * the result names the OFPET_BAD_REQUEST code to report.
+   */
+  parse_result_t try_parse(rofl::openflow::cofmsg **pmsg);
+
+  void send_bad_request(parse_result_t result);
 
-  void parse_of12_message(rofl::openflow::cofmsg **pmsg);
+  parse_result_t parse_of10_message(rofl::openflow::cofmsg **pmsg);
 
-  void parse_of13_message(rofl::openflow::cofmsg **pmsg);
+  parse_result_t parse_of12_message(rofl::openflow::cofmsg **pmsg);
+
+  parse_result_t parse_of13_message(rofl::openflow::cofmsg **pmsg);
+
+  parse_result_t parse_of14_message(rofl::openflow::cofmsg **pmsg);
 
   void send_from_queue();
 
 private:
   void backoff_reconnect(bool reset_timeout = false);
 
+  /**
+   * @brief	Resolves rnode/rservice into raddr without blocking
+   *
+   * Returns true once raddr is available. Otherwise the connection
+   * attempt is suspended until the resolver wakes up this socket, or it
+   * has failed and a reconnect has been scheduled.
+   */
+  bool resolve_raddr();
+
+  void mem_establish(std::shared_ptr<cmemchannel> channel,
+                     cmemchannel::side_t side);
+
   void handle_read_event_rxthread(cthread &thread, int fd);
 
   void handle_write_event_rxthread(cthread &thread, int fd);
@@ -702,6 +910,9 @@ private:
   int reconnect_backoff_current;
   int reconnect_counter;
 
+  // randomizes reconnect intervals among sockets
+  crandom reconnect_random;
+
   /* socket parameters */
 
   // socket descriptor
@@ -719,6 +930,15 @@ private:
   // socket backlog
   int backlog;
 
+  /* in-process memory channel */
+  std::shared_ptr<cmemchannel> channel;
+
+  // side of memory channel used by this socket
+  cmemchannel::side_t channel_side;
+
+  // eventfd signalling space in memory channel
+  int channel_txfd;
+
   /* binding addrees */
   csockaddr baddr;
 
@@ -728,12 +948,16 @@ private:
   /* remote address */
   csockaddr raddr;
 
+  /* remote host name and service, resolved into raddr */
+  std::string rnode;
+  std::string rservice;
+
   /*
    * OpenSSL related structures
    */
 
-  // SSL context
-  SSL_CTX *ctx;
+  // shared SSL context
+  ctlscontext *ctx;
 
   // SSL session
   SSL *ssl;
@@ -741,6 +965,9 @@ private:
   // basic input/output
   BIO *bio;
 
+  // start of current TLS handshake
+  ctimespec tls_started;
+
   // openssl rwlock
   crwlock sslock;
 
@@ -789,11 +1016,34 @@ private:
   // size of tx queue for reallowing transmissions
   unsigned int txqueue_size_tx_threshold;
 
+  // a txqueue rejected a message or reported no capacity
+  mutable std::atomic_bool txqueue_exhausted;
+
   // QUEUE_MAX txqueues
   std::vector<crofqueue> txqueues;
 
-  // relative scheduling weights for txqueues
-  std::vector<unsigned int> txweights;
+  // deficit round robin quanta for txqueues in bytes
+  std::atomic<size_t> txquanta[QUEUE_MAX];
+
+  // deficit round robin credit for txqueues in bytes
+  size_t txdeficits[QUEUE_MAX];
+
+  // serve QUEUE_OAM ahead of all other txqueues
+  std::atomic_bool oam_strict_priority;
+
+  // transmission statistics per txqueue
+  struct {
+    std::atomic<uint64_t> tx_msgs;
+    std::atomic<uint64_t> tx_bytes;
+    std::atomic<uint64_t> drops;
+    std::atomic<uint64_t> delay_usec_sum;
+    std::atomic<uint64_t> delay_usec_max;
+  } txstats[QUEUE_MAX];
+
+  // identifiers recorded in message traces
+  static std::atomic<uint64_t> next_trace_connid;
+  const uint64_t trace_connid;
+  std::atomic<uint8_t> trace_auxid;
 };
 
 } /* namespace rofl */
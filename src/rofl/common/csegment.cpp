@@ -198,6 +198,11 @@ void csegment::clone(const rofl::openflow::cofmsg &msg_stats) {
           dynamic_cast<rofl::openflow::cofmsg_port_desc_stats_reply const &>(
               msg_stats));
     } break;
+    case rofl::openflow14::OFPMP_FLOW_MONITOR: {
+      msg = new rofl::openflow::cofmsg_flow_monitor_reply(
+          dynamic_cast<rofl::openflow::cofmsg_flow_monitor_reply const &>(
+              msg_stats));
+    } break;
     default: {
       msg = new rofl::openflow::cofmsg_stats_reply(
           dynamic_cast<rofl::openflow::cofmsg_stats_reply const &>(msg_stats));
@@ -425,6 +430,19 @@ void csegment::store_and_merge_msg(const rofl::openflow::cofmsg &msg_stats) {
 
         msg_port_desc->set_ports() += msg_port_desc_stats.get_ports();
 
+      } break;
+      case rofl::openflow14::OFPMP_FLOW_MONITOR: {
+
+        rofl::openflow::cofmsg_flow_monitor_reply *msg_monitor =
+            dynamic_cast<rofl::openflow::cofmsg_flow_monitor_reply *>(msg);
+
+        rofl::openflow::cofmsg_flow_monitor_reply const &msg_monitor_updates =
+            dynamic_cast<rofl::openflow::cofmsg_flow_monitor_reply const &>(
+                msg_stats);
+
+        msg_monitor->set_flow_updates() +=
+            msg_monitor_updates.get_flow_updates();
+
       } break;
       default: {
         // cannot be fragmented, as request is too short
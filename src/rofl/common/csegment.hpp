@@ -20,6 +20,7 @@
 #include "rofl/common/exception.hpp"
 #include "rofl/common/openflow/messages/cofmsg_aggr_stats.h"
 #include "rofl/common/openflow/messages/cofmsg_desc_stats.h"
+#include "rofl/common/openflow/messages/cofmsg_flow_monitor.h"
 #include "rofl/common/openflow/messages/cofmsg_flow_stats.h"
 #include "rofl/common/openflow/messages/cofmsg_group_desc_stats.h"
 #include "rofl/common/openflow/messages/cofmsg_group_features_stats.h"
@@ -70,7 +71,7 @@ public:
   /**
    *
    */
-  csegment(uint32_t xid, const ctimespec &tspec, uint8_t msg_type,
+  csegment(uint32_t xid, const ctimens &tspec, uint8_t msg_type,
            uint16_t msg_multipart_type = 0)
       : tspec(tspec), xid(xid), msg(nullptr), msg_type(msg_type),
         msg_multipart_type(msg_multipart_type){};
@@ -173,7 +174,8 @@ public:
     }
 
     switch (msg.msg->get_version()) {
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
 
       switch (msg.msg->get_type()) {
       case rofl::openflow13::OFPT_MULTIPART_REQUEST: {
@@ -299,7 +301,7 @@ public:
 
 private:
   // time this fragmented OpenFlow message will expire
-  ctimespec tspec;
+  ctimens tspec;
 
   // transaction id used by this fragmented OpenFlow message
   uint32_t xid;
@@ -25,6 +25,14 @@ csockaddr::csockaddr(int family, const std::string &addr, uint16_t portno) {
     memcpy(ca_s6addr->sin6_addr.s6_addr, saddr.somem(), 16);
     ca_s6addr->sin6_port = htobe16(portno);
   } break;
+  case AF_UNIX: {
+    if (addr.length() >= sizeof(ca_sunaddr->sun_path))
+      throw eInvalid("csockaddr::csockaddr() path too long");
+    ca_mem = cmemory::resize(salen = sizeof(struct sockaddr_un));
+    memset(ca_mem, 0, salen);
+    ca_saddr->sa_family = AF_UNIX;
+    memcpy(ca_sunaddr->sun_path, addr.c_str(), addr.length());
+  } break;
   default:
     throw eInvalid("csockaddr::csockaddr() unsupported family");
   }
@@ -56,6 +64,9 @@ size_t csockaddr::length() const {
   case AF_INET6: {
     return sizeof(struct sockaddr_in6);
   } break;
+  case AF_UNIX: {
+    return sizeof(struct sockaddr_un);
+  } break;
   default:
     throw eInvalid("csockaddr::length() unsupported family");
   }
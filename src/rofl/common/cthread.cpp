@@ -28,9 +28,20 @@ using namespace rofl;
 
 /*static*/ std::set<cthread_env *> cthread_env::envs;
 /*static*/ crwlock cthread_env::envs_lock;
+/*static*/ std::atomic<uint64_t> cthread_env::envs_generation(0);
 
 /*static*/ BIO *cthread::bio_stderr;
 
+cthread_env::~cthread_env() {
+  {
+    AcquireReadWriteLock lock(envs_lock);
+    envs.erase(this);
+    envs_generation++;
+  }
+  /* no thread may dispatch events to this instance anymore */
+  cthread::pool_drop(this);
+}
+
 /*static*/ void cthread::openssl_initialize() {
   SSL_library_init();
   SSL_load_error_strings();
@@ -139,6 +150,15 @@ using namespace rofl;
   }
 }
 
+/*static*/ void cthread::pool_drop(cthread_env *env) {
+  if (not cthread::pool_initialized)
+    return;
+  AcquireReadLock lock(cthread::pool_lock);
+  for (auto it : cthread::pool) {
+    it.second->drop(env);
+  }
+}
+
 /*static*/ cthread &cthread::thread(uint32_t thread_num) {
   if (not cthread::pool_initialized) {
     cthread::pool_initialize();
@@ -216,7 +236,7 @@ void cthread::initialize() {
   struct epoll_event epev;
   memset((uint8_t *)&epev, 0, sizeof(struct epoll_event));
   epev.events = EPOLLIN; // level-triggered
-  epev.data.fd = event_fd;
+  epev.data.ptr = nullptr;
 
   if (epoll_ctl(epfd, EPOLL_CTL_ADD, event_fd, &epev) < 0) {
     switch (errno) {
@@ -238,21 +258,28 @@ void cthread::release() {
 
   {
     AcquireReadWriteLock lock(tlock);
-    for (auto it : fds) {
-      struct epoll_event epev;
-      memset((uint8_t *)&epev, 0, sizeof(struct epoll_event));
-      epev.events = 0;
-      epev.data.fd = it.first;
-      epoll_ctl(epfd, EPOLL_CTL_DEL, it.first, &epev);
+    for (auto &slot : fds) {
+      if (slot && slot->env) {
+        struct epoll_event epev;
+        memset((uint8_t *)&epev, 0, sizeof(struct epoll_event));
+        epoll_ctl(epfd, EPOLL_CTL_DEL, slot->fd, &epev);
+      }
     }
     fds.clear();
   }
 
+  // free pending wakeup requests
+  wakeup_t *w = wakeups.exchange(nullptr);
+  while (w) {
+    wakeup_t *next = w->next;
+    delete w;
+    w = next;
+  }
+
   // deregister event_fd from kernel
   struct epoll_event epev;
   memset((uint8_t *)&epev, 0, sizeof(struct epoll_event));
   epev.events = 0;
-  epev.data.fd = event_fd;
 
   if (epoll_ctl(epfd, EPOLL_CTL_DEL, event_fd, &epev) < 0) {
     switch (errno) {
@@ -276,14 +303,17 @@ void cthread::add_fd(cthread_env *env, int fd, bool exception,
     throw eThreadInvalid("thread environment must not be null");
 
   AcquireReadWriteLock lock(tlock);
-  if (fds.find(fd) != fds.end())
+  if (find_fd(fd))
     return;
 
-  uint32_t events = edge_triggered ? EPOLLET : 0;
+  fd_slot_t &slot = set_fd(fd);
+  slot.events = edge_triggered ? EPOLLET : 0;
+  slot.env.store(env, std::memory_order_release);
+
   struct epoll_event epev;
   memset((uint8_t *)&epev, 0, sizeof(struct epoll_event));
-  epev.events = events;
-  epev.data.fd = fd;
+  epev.events = slot.events;
+  epev.data.ptr = &slot;
 
   VLOG(7) << __FUNCTION__ << " fd=" << fd << " env=" << env
           << " edge-triggered=" << edge_triggered << " thread: "
@@ -297,25 +327,28 @@ void cthread::add_fd(cthread_env *env, int fd, bool exception,
       /* do nothing */
     } break;
     default: {
-      if (exception)
+      if (exception) {
+        slot.env.store(nullptr, std::memory_order_release);
         throw eSysCall("eSysCall", "epoll_ctl (EPOLL_CTL_ADD)", __FILE__,
                        __FUNCTION__, __LINE__);
+      }
     };
     }
   }
-
-  fds[fd].events = events;
-  fds[fd].env = env;
 }
 
 void cthread::drop_fd(int fd, bool exception) {
   AcquireReadWriteLock lock(tlock);
-  if (fds.find(fd) == fds.end())
+  fd_slot_t *slot = find_fd(fd);
+  if (nullptr == slot)
     return;
 
+  /* events already returned by epoll_pwait() are ignored from now on */
+  slot->env.store(nullptr, std::memory_order_release);
+  slot->events = 0;
+
   struct epoll_event epev;
   memset((uint8_t *)&epev, 0, sizeof(struct epoll_event));
-  epev.data.fd = fd;
 
   VLOG(7) << __FUNCTION__ << " fd=" << fd << " thread: "
           << " tid=0x" << std::hex << thread_tid << std::dec
@@ -334,8 +367,6 @@ void cthread::drop_fd(int fd, bool exception) {
     };
     }
   }
-
-  fds.erase(fd);
 }
 
 void cthread::add_read_fd(cthread_env *env, int fd, bool exception,
@@ -343,13 +374,16 @@ void cthread::add_read_fd(cthread_env *env, int fd, bool exception,
   add_fd(env, fd, exception, edge_triggered);
 
   AcquireReadWriteLock lock(tlock);
+  fd_slot_t *slot = find_fd(fd);
+  if (nullptr == slot)
+    return;
 
-  fds[fd].events |= EPOLLIN;
+  slot->events |= EPOLLIN;
 
   struct epoll_event epev;
   memset((uint8_t *)&epev, 0, sizeof(struct epoll_event));
-  epev.events = fds[fd].events;
-  epev.data.fd = fd;
+  epev.events = slot->events;
+  epev.data.ptr = slot;
 
   VLOG(7) << __FUNCTION__ << " fd=" << fd << " env=" << env
           << " edge-triggered=" << edge_triggered << " thread: "
@@ -373,15 +407,16 @@ void cthread::add_read_fd(cthread_env *env, int fd, bool exception,
 
 void cthread::drop_read_fd(int fd, bool exception) {
   AcquireReadWriteLock lock(tlock);
-  if (fds.find(fd) == fds.end())
+  fd_slot_t *slot = find_fd(fd);
+  if (nullptr == slot)
     return;
 
-  fds[fd].events &= ~EPOLLIN;
+  slot->events &= ~EPOLLIN;
 
   struct epoll_event epev;
   memset((uint8_t *)&epev, 0, sizeof(struct epoll_event));
-  epev.events = fds[fd].events;
-  epev.data.fd = fd;
+  epev.events = slot->events;
+  epev.data.ptr = slot;
 
   VLOG(7) << __FUNCTION__ << " fd=" << fd << " thread: "
           << " tid=0x" << std::hex << thread_tid << std::dec
@@ -407,13 +442,16 @@ void cthread::add_write_fd(cthread_env *env, int fd, bool exception,
   add_fd(env, fd, exception, edge_triggered);
 
   AcquireReadWriteLock lock(tlock);
+  fd_slot_t *slot = find_fd(fd);
+  if (nullptr == slot)
+    return;
 
-  fds[fd].events |= EPOLLOUT;
+  slot->events |= EPOLLOUT;
 
   struct epoll_event epev;
   memset((uint8_t *)&epev, 0, sizeof(struct epoll_event));
-  epev.events = fds[fd].events;
-  epev.data.fd = fd;
+  epev.events = slot->events;
+  epev.data.ptr = slot;
 
   VLOG(7) << __FUNCTION__ << " fd=" << fd << " env=" << env
           << " edge-triggered=" << edge_triggered << " thread: "
@@ -437,15 +475,16 @@ void cthread::add_write_fd(cthread_env *env, int fd, bool exception,
 
 void cthread::drop_write_fd(int fd, bool exception) {
   AcquireReadWriteLock lock(tlock);
-  if (fds.find(fd) == fds.end())
+  fd_slot_t *slot = find_fd(fd);
+  if (nullptr == slot)
     return;
 
-  fds[fd].events &= ~EPOLLOUT;
+  slot->events &= ~EPOLLOUT;
 
   struct epoll_event epev;
   memset((uint8_t *)&epev, 0, sizeof(struct epoll_event));
-  epev.events = fds[fd].events;
-  epev.data.fd = fd;
+  epev.events = slot->events;
+  epev.data.ptr = slot;
 
   VLOG(7) << __FUNCTION__ << " fd=" << fd << " thread: "
           << " tid=0x" << std::hex << thread_tid << std::dec
@@ -468,15 +507,13 @@ void cthread::drop_write_fd(int fd, bool exception) {
 
 void cthread::drop_fds(cthread_env *env) {
   AcquireReadWriteLock lock(tlock);
-restart:
-  for (auto it = fds.begin(); it != fds.end(); ++it) {
-    if (it->second.env == env) {
+  for (auto &slot : fds) {
+    if (slot && (slot->env == env)) {
+      slot->env.store(nullptr, std::memory_order_release);
+      slot->events = 0;
       struct epoll_event epev;
       memset((uint8_t *)&epev, 0, sizeof(struct epoll_event));
-      epev.data.fd = it->first;
-      epoll_ctl(epfd, EPOLL_CTL_DEL, it->first, &epev);
-      fds.erase(it);
-      goto restart;
+      epoll_ctl(epfd, EPOLL_CTL_DEL, slot->fd, &epev);
     }
   }
 }
@@ -487,13 +524,13 @@ void cthread::clear_timers() {
 };
 
 bool cthread::add_timer(cthread_env *env, uint32_t timer_id,
-                        const ctimespec &tspec) {
+                        const ctimens &tspec) {
   std::pair<std::set<ctimer>::iterator, bool> rv;
   bool do_wakeup = false;
   {
     AcquireReadWriteLock lock(tlock);
 
-    if (ordered_timers.empty() || tspec < ordered_timers.begin()->get_tspec())
+    if (ordered_timers.empty() || tspec < ordered_timers.begin()->get_time())
       do_wakeup = true;
 
     auto timer_it = find_if(ordered_timers.begin(), ordered_timers.end(),
@@ -613,8 +650,7 @@ void cthread::wakeup(cthread_env *env) {
   case STATE_RUNNING: {
     uint64_t c = 1;
     if (env) {
-      AcquireReadWriteLock lock(tlock);
-      wakeups.insert(env);
+      push_wakeup(env, false);
     }
     if (write(event_fd, &c, sizeof(c)) < 0) {
       switch (errno) {
@@ -635,29 +671,73 @@ void cthread::wakeup(cthread_env *env) {
   }
 }
 
+void cthread::push_wakeup(cthread_env *env, bool drop) {
+  wakeup_t *w = new wakeup_t;
+  w->env = env;
+  w->drop = drop;
+  w->next = wakeups.load(std::memory_order_relaxed);
+  while (not wakeups.compare_exchange_weak(w->next, w,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+  }
+}
+
 void cthread::handle_wakeup() {
-  std::set<cthread_env *> envs;
+  /* take all pending requests, newest first */
+  wakeup_t *w = wakeups.exchange(nullptr, std::memory_order_acquire);
+
+  wakeup_t *list = nullptr;
+  while (w) {
+    wakeup_t *next = w->next;
+    w->next = list;
+    list = w;
+    w = next;
+  }
+
+  /* replay oldest first, a drop cancels all earlier wakeups for its env */
+  std::vector<cthread_env *> order;
+  std::unordered_set<cthread_env *> pending;
+  while (list) {
+    if (list->drop) {
+      pending.erase(list->env);
+    } else if (pending.insert(list->env).second) {
+      order.push_back(list->env);
+    }
+    wakeup_t *next = list->next;
+    delete list;
+    list = next;
+  }
+
+  /* an env may have been destroyed after its wakeup was queued, validate
+   * the whole batch under a single acquisition of envs_lock */
+  std::vector<cthread_env *> envs;
+  uint64_t generation;
   {
-    AcquireReadWriteLock lock(tlock);
-    for (auto it = wakeups.begin(); it != wakeups.end(); ++it) {
-      envs.insert(*it);
+    AcquireReadLock lock(cthread_env::envs_lock);
+    generation = cthread_env::envs_generation;
+    for (auto env : order) {
+      if ((pending.erase(env) > 0) &&
+          (cthread_env::envs.find(env) != cthread_env::envs.end())) {
+        envs.push_back(env);
+      }
     }
-    wakeups.clear();
   }
-  for (auto it = envs.begin(); it != envs.end(); ++it) {
-    try {
-      env((*it)).handle_wakeup(*this);
-    } catch (eThreadNotFound &e) {
+
+  /* a handler may destroy other envs of this batch, re-validate them only
+   * if any env has been destroyed meanwhile */
+  for (auto env : envs) {
+    if ((generation == cthread_env::envs_generation) ||
+        (nullptr != cthread_env::try_env(env))) {
+      env->handle_wakeup(*this);
     }
   }
 }
 
 void cthread::drop_wakeup(cthread_env *env) {
-  AcquireReadWriteLock lock(tlock);
-  std::set<cthread_env *>::iterator it;
-  if (wakeups.find(env) != wakeups.end()) {
-    wakeups.erase(env);
-  }
+  /* nothing to cancel */
+  if (nullptr == wakeups.load(std::memory_order_acquire))
+    return;
+  push_wakeup(env, true);
 }
 
 void *cthread::run_loop() {
@@ -674,6 +754,10 @@ void *cthread::run_loop() {
 
       int timeout = 3600000; // in milliseconds: 1hour
 
+      /* refresh the cached clock before sleeping and after waking up, so
+       * callbacks below read the time without a syscall */
+      cclock::update();
+
       {
         AcquireReadLock lock(tlock);
         if (not ordered_timers.empty()) {
@@ -686,6 +770,8 @@ void *cthread::run_loop() {
       if (not running)
         goto out;
 
+      cclock::update();
+
       while (true) {
         /* handle expired timers */
         ctimer timer;
@@ -695,7 +781,7 @@ void *cthread::run_loop() {
             break;
           }
           timer = *(ordered_timers.begin());
-          if (not timer.get_tspec().is_expired()) {
+          if (not timer.get_time().is_expired()) {
             break;
           }
           ordered_timers.erase(ordered_timers.begin());
@@ -703,7 +789,10 @@ void *cthread::run_loop() {
         if (not running)
           goto out;
 
-        env(timer.env()).handle_timeout(*this, timer.get_timer_id());
+        cthread_env *thread_env = try_env(timer.env());
+        if (thread_env) {
+          thread_env->handle_timeout(*this, timer.get_timer_id());
+        }
       }
 
       if (not running)
@@ -716,7 +805,7 @@ void *cthread::run_loop() {
           if (not running)
             goto out;
 
-          if (events[i].data.fd == event_fd) {
+          if (nullptr == events[i].data.ptr) {
 
             if (not running) {
               return &retval;
@@ -730,14 +819,17 @@ void *cthread::run_loop() {
             }
 
           } else {
-            try {
-              if (events[i].events & EPOLLIN)
-                env(events[i].data.fd)
-                    .handle_read_event(*this, events[i].data.fd);
-              if (events[i].events & EPOLLOUT)
-                env(events[i].data.fd)
-                    .handle_write_event(*this, events[i].data.fd);
-            } catch (eThreadNotFound &e) {
+            /* slots live until release(), drop_fd() clears the env so
+             * events already returned by epoll_pwait() are ignored */
+            fd_slot_t *slot = (fd_slot_t *)events[i].data.ptr;
+            cthread_env *thread_env = nullptr;
+            if ((events[i].events & EPOLLIN) &&
+                (thread_env = slot->env.load(std::memory_order_acquire))) {
+              thread_env->handle_read_event(*this, slot->fd);
+            }
+            if ((events[i].events & EPOLLOUT) &&
+                (thread_env = slot->env.load(std::memory_order_acquire))) {
+              thread_env->handle_write_event(*this, slot->fd);
             }
           }
         }
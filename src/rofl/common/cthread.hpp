@@ -28,7 +28,10 @@
 #include <iostream>
 #include <list>
 #include <map>
+#include <memory>
 #include <set>
+#include <unordered_set>
+#include <vector>
 
 #include <openssl/bio.h>
 #include <openssl/conf.h>
@@ -64,23 +67,25 @@ class cthread_env : public ctimer_env {
   friend class cthread;
   static std::set<cthread_env *> envs;
   static crwlock envs_lock;
+  // incremented whenever an env is destroyed, guarded by envs_lock
+  static std::atomic<uint64_t> envs_generation;
 
 public:
   cthread_env() {
     AcquireReadWriteLock lock(envs_lock);
     envs.insert(this);
   }
-  virtual ~cthread_env() {
-    AcquireReadWriteLock lock(envs_lock);
-    envs.erase(this);
-  }
+  virtual ~cthread_env();
   static cthread_env &env(cthread_env *thread_env) {
-    AcquireReadLock lock(envs_lock);
-    if (envs.find(thread_env) == envs.end()) {
+    if (nullptr == try_env(thread_env)) {
       throw eThreadNotFound("thread environment not found");
     }
     return *(thread_env);
   }
+  static cthread_env *try_env(cthread_env *thread_env) {
+    AcquireReadLock lock(envs_lock);
+    return (envs.find(thread_env) == envs.end()) ? nullptr : thread_env;
+  }
 
 protected:
   virtual void handle_wakeup(cthread &thread) = 0;
@@ -90,6 +95,8 @@ protected:
 };
 
 class cthread {
+  friend class cthread_env;
+
 public:
   /**
    * @brief Initialize thread pool
@@ -148,7 +155,8 @@ public:
   /**
    *
    */
-  cthread(uint32_t thread_num) : thread_num(thread_num), state(STATE_IDLE) {
+  cthread(uint32_t thread_num)
+      : thread_num(thread_num), wakeups(nullptr), state(STATE_IDLE) {
     initialize();
   };
 
@@ -185,8 +193,7 @@ public:
   void wakeup(cthread_env *env = nullptr);
 
   /**
-   * @brief Removes pointer cthread_env instance from std::set<cthread_env*>
-   * wakeups
+   * @brief Cancels all pending wakeup requests for env
    */
   void drop_wakeup(cthread_env *env);
 
@@ -239,7 +246,7 @@ public:
   /**
    *
    */
-  bool add_timer(cthread_env *env, uint32_t timer_id, const ctimespec &tspec);
+  bool add_timer(cthread_env *env, uint32_t timer_id, const ctimens &tspec);
 
   /**
    *
@@ -336,13 +343,21 @@ private:
    * @brief Get environment for file descriptor
    */
   cthread_env &env(int fd) {
-    AcquireReadLock lock(tlock);
-    std::map<int, fd_priv_data_t>::const_iterator pos;
-    if ((pos = fds.find(fd)) == fds.end()) {
+    cthread_env *thread_env = try_env(fd);
+    if (nullptr == thread_env) {
       throw eThreadNotFound(
           "file descriptor to thread environment mapping not found");
     }
-    return cthread_env::env(pos->second.env);
+    return *thread_env;
+  };
+
+  /**
+   * @brief Non-throwing variant of env(int), returns nullptr if not found
+   */
+  cthread_env *try_env(int fd) {
+    AcquireReadLock lock(tlock);
+    fd_slot_t *slot = find_fd(fd);
+    return (slot) ? cthread_env::try_env(slot->env) : nullptr;
   };
 
   /**
@@ -352,11 +367,30 @@ private:
     return cthread_env::env(dynamic_cast<cthread_env *>(env));
   };
 
+  /**
+   * @brief Non-throwing variant of env(ctimer_env*)
+   */
+  cthread_env *try_env(ctimer_env *env) {
+    return cthread_env::try_env(dynamic_cast<cthread_env *>(env));
+  };
+
   /**
    * @brief Handle wakeup events
+   *
+   * Takes cthread_env::envs_lock once per batch of wakeups, not per env.
    */
   void handle_wakeup();
 
+  /**
+   * @brief Appends a wakeup or drop request to the lock-free wakeup list
+   */
+  void push_wakeup(cthread_env *env, bool drop);
+
+  /**
+   * @brief Removes env from all threads in the pool
+   */
+  static void pool_drop(cthread_env *env);
+
   /**
    * @brief	Global initialization of OpenSSL libraries
    */
@@ -434,25 +468,55 @@ private:
 
   crwlock tlock; // thread lock
 
-  class fd_priv_data_t {
+  /*
+   * registered file descriptor, epoll_event.data.ptr points to its slot.
+   * Slots are never freed while the thread exists, so run_loop() may
+   * dereference pointers from pending events after a concurrent drop_fd().
+   * A dropped slot has a null env.
+   */
+  class fd_slot_t {
   public:
-    uint32_t events;
+    const int fd;
+    uint32_t events;                // guarded by tlock
+    std::atomic<cthread_env *> env; // read by run_loop() without locking
+    fd_slot_t(int fd) : fd(fd), events(0), env(nullptr){};
+  };
+
+  /*
+   * wakeup request, run_loop() takes the whole list with a single exchange
+   * and processes the requests in order. A drop request cancels preceding
+   * wakeups for the same env.
+   */
+  struct wakeup_t {
     cthread_env *env;
-    fd_priv_data_t(uint32_t events = 0, cthread_env *env = nullptr)
-        : events(events), env(env){};
-    fd_priv_data_t(const fd_priv_data_t &priv_data) { *this = priv_data; };
-    fd_priv_data_t &operator=(const fd_priv_data_t &priv_data) {
-      if (this == &priv_data)
-        return *this;
-      events = priv_data.events;
-      env = priv_data.env;
-      return *this;
-    };
+    bool drop;
+    wakeup_t *next;
+  };
+
+  /**
+   * @brief Returns slot of a registered fd or nullptr, tlock must be held
+   */
+  fd_slot_t *find_fd(int fd) const {
+    if ((fd < 0) || ((size_t)fd >= fds.size()) || (not fds[fd]) ||
+        (nullptr == fds[fd]->env.load(std::memory_order_relaxed)))
+      return nullptr;
+    return fds[fd].get();
+  };
+
+  /**
+   * @brief Returns slot for fd and creates it if needed, tlock must be held
+   */
+  fd_slot_t &set_fd(int fd) {
+    if ((size_t)fd >= fds.size())
+      fds.resize(fd + 1);
+    if (not fds[fd])
+      fds[fd].reset(new fd_slot_t(fd));
+    return *fds[fd];
   };
 
-  std::map<int, fd_priv_data_t> fds; // set of registered file descriptors
-  std::set<ctimer> ordered_timers;   // ordered set of timers
-  std::set<cthread_env *> wakeups; // set of cthread_env instances to be called
+  std::vector<std::unique_ptr<fd_slot_t>> fds; // fd-indexed table of slots
+  std::set<ctimer> ordered_timers;             // ordered set of timers
+  std::atomic<wakeup_t *> wakeups;             // pending wakeups, newest first
 
   enum thread_state_t {
     STATE_IDLE = 0,
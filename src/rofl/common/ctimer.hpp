@@ -63,7 +63,7 @@ public:
    *
    */
   ctimer(ctimer_env *timer_env = nullptr, uint32_t timer_id = 0,
-         const ctimespec &tspec = ctimespec(::timespec{0, 0}))
+         const ctimens &tspec = ctimens())
       : timer_env(timer_env), timer_id(timer_id), tspec(tspec){};
 
   /**
@@ -111,21 +111,24 @@ public:
   /**
    *
    */
-  const ctimespec &get_tspec() const { return tspec; };
+  ctimespec get_tspec() const { return tspec.get_tspec(); };
+
+  /**
+   *
+   */
+  const ctimens &get_time() const { return tspec; };
 
   /**
    *
    */
   void expire_in(time_t tv_sec = 0, long tv_nsec = 0) {
-    tspec.expire_in(tv_sec, tv_nsec);
+    tspec = ctimens::expire_in(tv_sec, tv_nsec);
   };
 
   /**
    *
    */
-  int get_relative_timeout() const {
-    return get_tspec().get_relative_timeout();
-  };
+  int get_relative_timeout() const { return tspec.get_relative_timeout(); };
 
 public:
   /**
@@ -139,7 +142,7 @@ public:
 private:
   ctimer_env *timer_env;
   uint32_t timer_id;
-  ctimespec tspec;
+  ctimens tspec;
 };
 
 /**
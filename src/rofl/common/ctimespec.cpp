@@ -13,6 +13,10 @@
 
 using namespace rofl;
 
+thread_local uint64_t cclock::cached_ns = 0;
+
+std::atomic<clockid_t> cclock::clkid(CLOCK_MONOTONIC);
+
 ctimespec ctimespec::operator+(const ctimespec &t) const {
   ctimespec timer;
 
@@ -13,6 +13,7 @@
 #define SRC_ROFL_COMMON_CTIMESPEC_HPP_
 
 #include <algorithm>
+#include <atomic>
 #include <errno.h>
 #include <inttypes.h>
 #include <list>
@@ -79,6 +80,63 @@ private:
   clockid_t clkid;
 };
 
+/**
+ * @brief Per-thread cached monotonic clock in nanoseconds.
+ *
+ * A running cthread refreshes the cached value once per loop iteration, so
+ * callbacks executed by a cthread read the current time with a single load.
+ * Threads without a cached value fall back to clock_gettime().
+ */
+class cclock {
+public:
+  /**
+   * @brief Returns the cached time of this thread, or reads the clock
+   */
+  static uint64_t now() {
+    if (cached_ns)
+      return cached_ns;
+    return read();
+  };
+
+  /**
+   * @brief Reads the clock and stores the result as this thread's cache
+   */
+  static uint64_t update() { return (cached_ns = read()); };
+
+  /**
+   * @brief Reads the clock, bypassing the cache
+   */
+  static uint64_t read() {
+    struct timespec ts;
+    clock_gettime(clkid.load(std::memory_order_relaxed), &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+  };
+
+  /**
+   * @brief Returns the clock used by read() and update()
+   */
+  static clockid_t get_clkid() {
+    return clkid.load(std::memory_order_relaxed);
+  };
+
+  /**
+   * @brief Selects CLOCK_MONOTONIC_COARSE instead of CLOCK_MONOTONIC
+   *
+   * The coarse clock avoids the vDSO time read at the expense of
+   * resolution (one scheduler tick). Set this before starting any cthread.
+   */
+  static void set_coarse(bool coarse) {
+#ifdef CLOCK_MONOTONIC_COARSE
+    clkid.store(coarse ? CLOCK_MONOTONIC_COARSE : CLOCK_MONOTONIC,
+                std::memory_order_relaxed);
+#endif
+  };
+
+private:
+  static thread_local uint64_t cached_ns;
+  static std::atomic<clockid_t> clkid;
+};
+
 class ctimespec {
 public:
   /**
@@ -89,6 +147,27 @@ public:
     return ctimespec(clk_id);
   };
 
+  /**
+   * @brief Returns the current time from the cached clock (see cclock)
+   */
+  static const ctimespec cached_now() {
+    uint64_t ns = cclock::now();
+    return ctimespec(::timespec{(time_t)(ns / 1000000000),
+                                (long)(ns % 1000000000)},
+                     cclockid(cclock::get_clkid()));
+  };
+
+  /**
+   * @brief Returns the cached time advanced by tv_sec and tv_nsec
+   */
+  static const ctimespec deadline(time_t tv_sec = 0, long tv_nsec = 0) {
+    ctimespec ts(cached_now());
+    tv_nsec += ts.tspec.tv_nsec;
+    ts.tspec.tv_sec += (tv_nsec / (long)1e9) + tv_sec;
+    ts.tspec.tv_nsec = (tv_nsec % (long)1e9);
+    return ts;
+  };
+
 public:
   /**
    *
@@ -109,7 +188,6 @@ public:
   ctimespec(time_t tv_sec, long tv_nsec,
             const cclockid &clk_id = cclockid(CLOCK_MONOTONIC))
       : clk_id(clk_id) {
-    get_time(clk_id);
     expire_in(tv_sec, tv_nsec);
   };
 
@@ -287,11 +365,119 @@ private:
   static const long CC_TIMER_ONE_SECOND_S = 1;
   static const long CC_TIMER_ONE_SECOND_NS = 1000000000;
 
-  crwlock tlock;
   cclockid clk_id;
   struct timespec tspec;
 };
 
+/**
+ * @brief Point in time as integer nanoseconds of the cclock clock.
+ *
+ * Used by timers and transactions, where comparisons and deadline
+ * computations happen for every message.
+ */
+class ctimens {
+public:
+  /**
+   * @brief Returns the current time from the cached clock (see cclock)
+   */
+  static ctimens now() { return ctimens(cclock::now()); };
+
+  /**
+   * @brief Returns the cached time advanced by tv_sec and tv_nsec
+   */
+  static ctimens expire_in(time_t tv_sec = 0, long tv_nsec = 0) {
+    return ctimens(cclock::now() + (uint64_t)tv_sec * 1000000000 + tv_nsec);
+  };
+
+public:
+  /**
+   *
+   */
+  explicit ctimens(uint64_t ns = 0) : ns(ns){};
+
+  /**
+   *
+   */
+  ctimens(const ctimespec &ts)
+      : ns((uint64_t)ts.get_tspec().tv_sec * 1000000000 +
+           ts.get_tspec().tv_nsec){};
+
+  /**
+   *
+   */
+  bool operator==(const ctimens &t) const { return (ns == t.ns); };
+
+  /**
+   *
+   */
+  bool operator!=(const ctimens &t) const { return (ns != t.ns); };
+
+  /**
+   *
+   */
+  bool operator<(const ctimens &t) const { return (ns < t.ns); };
+
+  /**
+   *
+   */
+  bool operator<=(const ctimens &t) const { return (ns <= t.ns); };
+
+  /**
+   *
+   */
+  bool operator>(const ctimens &t) const { return (ns > t.ns); };
+
+  /**
+   *
+   */
+  bool operator>=(const ctimens &t) const { return (ns >= t.ns); };
+
+public:
+  /**
+   *
+   */
+  uint64_t get_ns() const { return ns; };
+
+  /**
+   *
+   */
+  ctimespec get_tspec() const {
+    return ctimespec(::timespec{(time_t)(ns / 1000000000),
+                                (long)(ns % 1000000000)},
+                     cclockid(cclock::get_clkid()));
+  };
+
+  /**
+   * @brief Returns milliseconds until this point in time, rounded up
+   */
+  int get_relative_timeout(const ctimens &reference_time = now()) const {
+    if (ns <= reference_time.ns)
+      return 0;
+    uint64_t msecs = (ns - reference_time.ns + 999999) / 1000000;
+    return (msecs > INT32_MAX) ? INT32_MAX : (int)msecs;
+  };
+
+  /**
+   *
+   */
+  bool is_expired(const ctimens &reference_time = now()) const {
+    return (ns <= reference_time.ns);
+  };
+
+public:
+  /**
+   *
+   */
+  friend std::ostream &operator<<(std::ostream &os, const ctimens &t) {
+    os << "<ctimens timeout: " << t.ns / 1000000000 << "."
+       << t.ns % 1000000000 << "s>";
+    return os;
+  };
+
+private:
+  uint64_t ns;
+};
+
 }; // end of namespace rofl
 
 #endif /* SRC_ROFL_COMMON_CTIMESPEC_HPP_ */
@@ -0,0 +1,294 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * ctlscontext.cc
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#include <glog/logging.h>
+#include <sstream>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "rofl/common/ctlscontext.h"
+
+using namespace rofl;
+
+/*static*/ std::map<ctlscontext::key_t, ctlscontext *> ctlscontext::contexts;
+/*static*/ crwlock ctlscontext::contexts_lock;
+/*static*/ time_t ctlscontext::linger = 300 /*secs*/;
+
+/*static*/ std::atomic<uint64_t> ctlscontext::stats_created(0);
+/*static*/ std::atomic<uint64_t> ctlscontext::stats_reused(0);
+/*static*/ std::atomic<uint64_t> ctlscontext::stats_started(0);
+/*static*/ std::atomic<uint64_t> ctlscontext::stats_completed(0);
+/*static*/ std::atomic<uint64_t> ctlscontext::stats_resumed(0);
+/*static*/ std::atomic<uint64_t> ctlscontext::stats_failed(0);
+/*static*/ std::atomic<uint64_t> ctlscontext::stats_usecs(0);
+
+double ctlsstats::get_handshake_rate(const ctlsstats &stats) const {
+  ctimespec delta = timestamp - stats.timestamp;
+  double secs = (double)delta.get_tspec().tv_sec +
+                (double)delta.get_tspec().tv_nsec / 1e9;
+  if ((secs <= 0) || (handshakes_completed < stats.handshakes_completed))
+    return 0;
+  return (double)(handshakes_completed - stats.handshakes_completed) / secs;
+}
+
+ctlscontext::~ctlscontext() {
+  for (auto it : sessions) {
+    SSL_SESSION_free(it.second);
+  }
+  sessions.clear();
+  if (ssl_ctx) {
+    SSL_CTX_free(ssl_ctx);
+    ssl_ctx = NULL;
+  }
+}
+
+ctlscontext::ctlscontext(const key_t &key)
+    : key(key), ssl_ctx(NULL), refcnt(0) {
+
+#if (OPENSSL_VERSION_NUMBER >= 0x1010000fL)
+  // openssl 1.1.0
+  ssl_ctx = SSL_CTX_new(TLS_method());
+#else
+  ssl_ctx = SSL_CTX_new(TLSv1_2_method());
+#endif
+
+  if (NULL == ssl_ctx) {
+    throw eLibCall("eLibCall", "SSL_CTX_new", __FILE__, __FUNCTION__,
+                   __LINE__);
+  }
+
+  try {
+    // certificate
+    if (!SSL_CTX_use_certificate_file(ssl_ctx, key.certfile.c_str(),
+                                      SSL_FILETYPE_PEM)) {
+      throw eLibCall("eLibCall", "SSL_CTX_use_certificate_file", __FILE__,
+                     __FUNCTION__, __LINE__)
+          .set_key("certfile", key.certfile);
+    }
+
+    // private key
+    SSL_CTX_set_default_passwd_cb(ssl_ctx, &ctlscontext::pswd_cb);
+    SSL_CTX_set_default_passwd_cb_userdata(ssl_ctx, (void *)this);
+
+    if (!SSL_CTX_use_PrivateKey_file(ssl_ctx, key.keyfile.c_str(),
+                                     SSL_FILETYPE_PEM)) {
+      throw eLibCall("eLibCall", "SSL_CTX_use_PrivateKey_file", __FILE__,
+                     __FUNCTION__, __LINE__)
+          .set_key("keyfile", key.keyfile);
+    }
+
+    // ciphers
+    if ((not key.ciphers.empty()) &&
+        (0 == SSL_CTX_set_cipher_list(ssl_ctx, key.ciphers.c_str()))) {
+      throw eLibCall("eLibCall", "SSL_CTX_set_cipher_list", __FILE__,
+                     __FUNCTION__, __LINE__)
+          .set_key("ciphers", key.ciphers);
+    }
+
+    // capath/cafile
+    if (!SSL_CTX_load_verify_locations(
+            ssl_ctx, key.cafile.empty() ? NULL : key.cafile.c_str(),
+            key.capath.empty() ? NULL : key.capath.c_str())) {
+      throw eLibCall("eLibCall", "SSL_CTX_load_verify_locations", __FILE__,
+                     __FUNCTION__, __LINE__)
+          .set_key("cafile", key.cafile)
+          .set_key("capath", key.capath);
+    }
+  } catch (...) {
+    SSL_CTX_free(ssl_ctx);
+    ssl_ctx = NULL;
+    throw;
+  }
+
+  int mode = SSL_VERIFY_NONE;
+  if (key.verify_mode == "NONE") {
+    mode = SSL_VERIFY_NONE;
+  } else if (key.verify_mode == "PEER") {
+    mode = SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT;
+  }
+
+  SSL_CTX_set_verify(ssl_ctx, mode, NULL);
+
+  int depth = 1;
+  std::istringstream(key.verify_depth) >> depth;
+
+  SSL_CTX_set_verify_depth(ssl_ctx, depth);
+
+  /* server side session cache and session tickets (enabled by default),
+   * a session id context is mandatory for resumption with peer
+   * verification */
+  static const unsigned char sid_ctx[] = "rofl-common";
+  SSL_CTX_set_session_id_context(ssl_ctx, sid_ctx, sizeof(sid_ctx) - 1);
+  SSL_CTX_set_session_cache_mode(ssl_ctx, SSL_SESS_CACHE_SERVER);
+}
+
+int ctlscontext::pswd_cb(char *buf, int size, int rwflag, void *userdata) {
+  if (userdata == NULL)
+    return 0;
+
+  ctlscontext &ctx = *(static_cast<ctlscontext *>(userdata));
+
+  if (ctx.key.password.empty()) {
+    return 0;
+  }
+
+  strncpy(buf, ctx.key.password.c_str(), size);
+
+  return strnlen(buf, size);
+}
+
+void ctlscontext::key_t::update_stamps() {
+  std::stringstream ss;
+  const std::string *paths[] = {&capath, &cafile, &certfile, &keyfile};
+  for (const std::string *path : paths) {
+    struct stat st;
+    if (path->empty() || (::stat(path->c_str(), &st) < 0)) {
+      ss << "-;";
+      continue;
+    }
+    ss << st.st_dev << ":" << st.st_ino << ":" << st.st_size << ":"
+       << st.st_mtim.tv_sec << "." << st.st_mtim.tv_nsec << ";";
+  }
+  stamps = ss.str();
+}
+
+/*static*/ ctlscontext *ctlscontext::acquire(const key_t &params) {
+  key_t key(params);
+  key.update_stamps();
+
+  AcquireReadWriteLock rwlock(contexts_lock);
+
+  expire(ctimespec::now());
+
+  std::map<key_t, ctlscontext *>::iterator it = contexts.find(key);
+  if (it != contexts.end()) {
+    it->second->refcnt++;
+    stats_reused++;
+    return it->second;
+  }
+
+  ctlscontext *ctx = new ctlscontext(key);
+  ctx->refcnt = 1;
+  contexts[key] = ctx;
+  stats_created++;
+
+  VLOG(2) << __FUNCTION__ << " TLS: created new context, certfile="
+          << key.certfile << " #contexts=" << contexts.size();
+
+  return ctx;
+}
+
+/*static*/ void ctlscontext::release(ctlscontext *ctx) {
+  if (NULL == ctx)
+    return;
+
+  AcquireReadWriteLock rwlock(contexts_lock);
+
+  if (ctx->refcnt > 0) {
+    ctx->refcnt--;
+  }
+  ctx->released = ctimespec::now();
+
+  expire(ctx->released);
+}
+
+/*static*/ void ctlscontext::expire(const ctimespec &now) {
+  for (std::map<key_t, ctlscontext *>::iterator it = contexts.begin();
+       it != contexts.end();) {
+    ctlscontext *ctx = it->second;
+    bool expired = (linger == 0) ||
+                   ((now - ctx->released).get_tspec().tv_sec >= linger);
+    if ((ctx->refcnt == 0) && expired) {
+      VLOG(2) << __FUNCTION__ << " TLS: destroying unused context, certfile="
+              << ctx->key.certfile;
+      contexts.erase(it++);
+      delete ctx;
+    } else {
+      ++it;
+    }
+  }
+}
+
+/*static*/ void ctlscontext::purge() {
+  AcquireReadWriteLock rwlock(contexts_lock);
+  for (std::map<key_t, ctlscontext *>::iterator it = contexts.begin();
+       it != contexts.end();) {
+    if (it->second->refcnt == 0) {
+      delete it->second;
+      contexts.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+}
+
+/*static*/ size_t ctlscontext::size() {
+  AcquireReadLock rwlock(contexts_lock);
+  return contexts.size();
+}
+
+SSL_SESSION *ctlscontext::get_session(const std::string &peer) {
+  AcquireReadLock rwlock(sessions_lock);
+  std::map<std::string, SSL_SESSION *>::iterator it = sessions.find(peer);
+  if (it == sessions.end())
+    return NULL;
+#if (OPENSSL_VERSION_NUMBER >= 0x1010000fL)
+  SSL_SESSION_up_ref(it->second);
+#else
+  CRYPTO_add(&it->second->references, 1, CRYPTO_LOCK_SSL_SESSION);
+#endif
+  return it->second;
+}
+
+void ctlscontext::set_session(const std::string &peer,
+                              SSL_SESSION *session) {
+  if (NULL == session)
+    return;
+  AcquireReadWriteLock rwlock(sessions_lock);
+  std::map<std::string, SSL_SESSION *>::iterator it = sessions.find(peer);
+  if (it != sessions.end()) {
+    SSL_SESSION_free(it->second);
+  }
+  sessions[peer] = session;
+}
+
+void ctlscontext::drop_session(const std::string &peer) {
+  AcquireReadWriteLock rwlock(sessions_lock);
+  std::map<std::string, SSL_SESSION *>::iterator it = sessions.find(peer);
+  if (it == sessions.end())
+    return;
+  SSL_SESSION_free(it->second);
+  sessions.erase(it);
+}
+
+/*static*/ void ctlscontext::handshake_completed(const ctimespec &started,
+                                                 bool resumed) {
+  ctimespec delta = ctimespec::now() - started;
+  stats_usecs += (uint64_t)delta.get_tspec().tv_sec * 1000000 +
+                 (uint64_t)delta.get_tspec().tv_nsec / 1000;
+  stats_completed++;
+  if (resumed) {
+    stats_resumed++;
+  }
+}
+
+/*static*/ ctlsstats ctlscontext::get_stats() {
+  ctlsstats stats;
+  stats.timestamp = ctimespec::now();
+  stats.contexts_created = stats_created;
+  stats.contexts_reused = stats_reused;
+  stats.handshakes_started = stats_started;
+  stats.handshakes_completed = stats_completed;
+  stats.handshakes_resumed = stats_resumed;
+  stats.handshakes_failed = stats_failed;
+  stats.handshake_usecs = stats_usecs;
+  return stats;
+}
@@ -0,0 +1,324 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * ctlscontext.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#ifndef ROFL_COMMON_CTLSCONTEXT_H
+#define ROFL_COMMON_CTLSCONTEXT_H 1
+
+#include <atomic>
+#include <inttypes.h>
+#include <iostream>
+#include <map>
+#include <string>
+
+#include <openssl/err.h>
+#include <openssl/opensslv.h>
+#include <openssl/ssl.h>
+
+#include "rofl/common/ctimespec.hpp"
+#include "rofl/common/exception.hpp"
+#include "rofl/common/locking.hpp"
+
+namespace rofl {
+
+/**
+ * @brief	Snapshot of TLS handshake counters.
+ *
+ * Counters are monotonically increasing. Rates are obtained by
+ * comparing two snapshots taken at different points in time.
+ */
+class ctlsstats {
+public:
+  /**
+   *
+   */
+  ~ctlsstats(){};
+
+  /**
+   *
+   */
+  ctlsstats()
+      : contexts_created(0), contexts_reused(0), handshakes_started(0),
+        handshakes_completed(0), handshakes_resumed(0), handshakes_failed(0),
+        handshake_usecs(0){};
+
+public:
+  /**
+   * @brief	Completed handshakes per second since snapshot stats.
+   */
+  double get_handshake_rate(const ctlsstats &stats) const;
+
+  /**
+   * @brief	Mean duration of a completed handshake in microseconds.
+   */
+  uint64_t get_handshake_mean_usecs() const {
+    return (handshakes_completed == 0)
+               ? 0
+               : handshake_usecs / handshakes_completed;
+  };
+
+public:
+  friend std::ostream &operator<<(std::ostream &os, const ctlsstats &stats) {
+    os << "<ctlsstats contexts created: " << stats.contexts_created
+       << " reused: " << stats.contexts_reused
+       << " handshakes started: " << stats.handshakes_started
+       << " completed: " << stats.handshakes_completed
+       << " resumed: " << stats.handshakes_resumed
+       << " failed: " << stats.handshakes_failed
+       << " mean-usecs: " << stats.get_handshake_mean_usecs() << " >"
+       << std::endl;
+    return os;
+  };
+
+public:
+  // time this snapshot was taken
+  ctimespec timestamp;
+
+  // SSL_CTX instances created
+  uint64_t contexts_created;
+
+  // SSL_CTX instances found in cache
+  uint64_t contexts_reused;
+
+  // handshakes initiated (SSL_accept/SSL_connect)
+  uint64_t handshakes_started;
+
+  // handshakes completed successfully
+  uint64_t handshakes_completed;
+
+  // completed handshakes with resumed session
+  uint64_t handshakes_resumed;
+
+  // handshakes failed or peer verification failed
+  uint64_t handshakes_failed;
+
+  // accumulated duration of completed handshakes
+  uint64_t handshake_usecs;
+};
+
+/**
+ * @brief	Shared and reference counted TLS context.
+ *
+ * Creating an SSL_CTX reads certificate, private key and CA files from
+ * disk. Sockets with identical TLS parameters share a single context
+ * obtained via ctlscontext::acquire() and returned via
+ * ctlscontext::release(). Sharing a context enables the server side
+ * session cache and session tickets for all accepted connections.
+ * Client sessions are stored per peer for resumption on reconnect.
+ *
+ * Unused contexts linger in the cache for get_linger() seconds, so that
+ * the session caches survive a simultaneous reconnect of all peers.
+ */
+class ctlscontext {
+public:
+  /**
+   * @brief	TLS parameters identifying a context.
+   */
+  class key_t {
+  public:
+    /**
+     * @brief	Records device, inode, size and modification time of the
+     * CA path and all files.
+     *
+     * Called by acquire(), so that replaced certificate, key or CA files
+     * result in a new context instead of the cached one.
+     */
+    void update_stamps();
+
+  public:
+    bool operator<(const key_t &key) const {
+      if (capath != key.capath)
+        return (capath < key.capath);
+      if (cafile != key.cafile)
+        return (cafile < key.cafile);
+      if (certfile != key.certfile)
+        return (certfile < key.certfile);
+      if (keyfile != key.keyfile)
+        return (keyfile < key.keyfile);
+      if (password != key.password)
+        return (password < key.password);
+      if (verify_mode != key.verify_mode)
+        return (verify_mode < key.verify_mode);
+      if (verify_depth != key.verify_depth)
+        return (verify_depth < key.verify_depth);
+      if (ciphers != key.ciphers)
+        return (ciphers < key.ciphers);
+      return (stamps < key.stamps);
+    };
+
+  public:
+    std::string capath;
+    std::string cafile;
+    std::string certfile;
+    std::string keyfile;
+    std::string password;
+    std::string verify_mode;
+    std::string verify_depth;
+    std::string ciphers;
+    // file identities, set by update_stamps()
+    std::string stamps;
+  };
+
+public:
+  /**
+   * @brief	Returns context for key, creates a new one if necessary.
+   *
+   * A cached context is only reused while the files it was created from
+   * have not been modified or replaced. Sockets still using a context
+   * for outdated files keep it until they release it.
+   *
+   * @exception rofl::eLibCall creation of SSL_CTX failed
+   */
+  static ctlscontext *acquire(const key_t &key);
+
+  /**
+   * @brief	Drops a reference obtained via acquire().
+   */
+  static void release(ctlscontext *ctx);
+
+  /**
+   * @brief	Frees all unreferenced contexts immediately.
+   */
+  static void purge();
+
+  /**
+   * @brief	Returns number of contexts in cache.
+   */
+  static size_t size();
+
+  /**
+   *
+   */
+  static time_t get_linger() { return linger; };
+
+  /**
+   * @brief	Sets lifetime of unreferenced contexts in seconds.
+   */
+  static void set_linger(time_t linger) { ctlscontext::linger = linger; };
+
+public:
+  /**
+   *
+   */
+  static void handshake_started() { stats_started++; };
+
+  /**
+   *
+   */
+  static void handshake_completed(const ctimespec &started, bool resumed);
+
+  /**
+   *
+   */
+  static void handshake_failed() { stats_failed++; };
+
+  /**
+   * @brief	Returns snapshot of handshake counters.
+   */
+  static ctlsstats get_stats();
+
+public:
+  /**
+   *
+   */
+  SSL_CTX *get_ssl_ctx() const { return ssl_ctx; };
+
+  /**
+   *
+   */
+  const key_t &get_key() const { return key; };
+
+  /**
+   *
+   */
+  unsigned int get_refcnt() const { return refcnt; };
+
+  /**
+   * @brief	Returns stored session for peer or NULL.
+   *
+   * The caller owns the returned reference and must call
+   * SSL_SESSION_free() after SSL_set_session().
+   */
+  SSL_SESSION *get_session(const std::string &peer);
+
+  /**
+   * @brief	Stores a resumable session for peer.
+   *
+   * Ownership of session is transferred to this context.
+   */
+  void set_session(const std::string &peer, SSL_SESSION *session);
+
+  /**
+   *
+   */
+  void drop_session(const std::string &peer);
+
+private:
+  /**
+   *
+   */
+  ~ctlscontext();
+
+  /**
+   *
+   */
+  ctlscontext(const key_t &key);
+
+  /**
+   *
+   */
+  ctlscontext(const ctlscontext &ctx);
+
+  /**
+   *
+   */
+  ctlscontext &operator=(const ctlscontext &ctx);
+
+  /**
+   *
+   */
+  static int pswd_cb(char *buf, int size, int rwflag, void *userdata);
+
+  /**
+   *
+   */
+  static void expire(const ctimespec &now);
+
+private:
+  key_t key;
+
+  SSL_CTX *ssl_ctx;
+
+  // number of sockets using this context, guarded by contexts_lock
+  unsigned int refcnt;
+
+  // time of last release
+  ctimespec released;
+
+  // peer => client session for resumption
+  std::map<std::string, SSL_SESSION *> sessions;
+  crwlock sessions_lock;
+
+  static std::map<key_t, ctlscontext *> contexts;
+  static crwlock contexts_lock;
+  static time_t linger;
+
+  static std::atomic<uint64_t> stats_created;
+  static std::atomic<uint64_t> stats_reused;
+  static std::atomic<uint64_t> stats_started;
+  static std::atomic<uint64_t> stats_completed;
+  static std::atomic<uint64_t> stats_resumed;
+  static std::atomic<uint64_t> stats_failed;
+  static std::atomic<uint64_t> stats_usecs;
+};
+
+}; // end of namespace rofl
+
+#endif /* ROFL_COMMON_CTLSCONTEXT_H */
@@ -0,0 +1,160 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * ctokenbucket.hpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#ifndef SRC_ROFL_COMMON_CTOKENBUCKET_HPP_
+#define SRC_ROFL_COMMON_CTOKENBUCKET_HPP_
+
+#include <ostream>
+
+#include "rofl/common/ctimespec.hpp"
+#include "rofl/common/locking.hpp"
+
+namespace rofl {
+
+/**
+ * @brief	Token bucket rate limiter.
+ *
+ * Tokens are refilled with rate tokens per second up to a maximum of
+ * burst tokens. A rate of 0 disables rate limiting.
+ */
+class ctokenbucket {
+public:
+  /**
+   *
+   */
+  ~ctokenbucket(){};
+
+  /**
+   *
+   */
+  ctokenbucket(double rate = 0, double burst = 1)
+      : rate(rate), burst(burst), tokens(burst), last(ctimespec::now()){};
+
+  /**
+   *
+   */
+  ctokenbucket(const ctokenbucket &bucket) { *this = bucket; };
+
+  /**
+   *
+   */
+  ctokenbucket &operator=(const ctokenbucket &bucket) {
+    if (this == &bucket)
+      return *this;
+    AcquireReadWriteLock rwlock(lock);
+    AcquireReadLock rlock(bucket.lock);
+    rate = bucket.rate;
+    burst = bucket.burst;
+    tokens = bucket.tokens;
+    last = bucket.last;
+    return *this;
+  };
+
+public:
+  /**
+   * @brief	Sets refill rate in tokens per second and bucket depth.
+   */
+  ctokenbucket &set_rate(double rate, double burst) {
+    AcquireReadWriteLock rwlock(lock);
+    this->rate = (rate < 0) ? 0 : rate;
+    this->burst = (burst < 1) ? 1 : burst;
+    if (tokens > this->burst)
+      tokens = this->burst;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  double get_rate() const {
+    AcquireReadLock rlock(lock);
+    return rate;
+  };
+
+  /**
+   *
+   */
+  double get_burst() const {
+    AcquireReadLock rlock(lock);
+    return burst;
+  };
+
+  /**
+   * @brief	Removes num tokens from the bucket if available.
+   *
+   * @return true if tokens were available
+   */
+  bool consume(double num = 1) {
+    AcquireReadWriteLock rwlock(lock);
+    if (rate == 0)
+      return true;
+    refill();
+    if (tokens < num)
+      return false;
+    tokens -= num;
+    return true;
+  };
+
+  /**
+   * @brief	Returns milliseconds until num tokens become available.
+   */
+  unsigned int get_wait_msecs(double num = 1) {
+    AcquireReadWriteLock rwlock(lock);
+    if (rate == 0)
+      return 0;
+    refill();
+    if (tokens >= num)
+      return 0;
+    return (unsigned int)((num - tokens) * 1e3 / rate) + 1;
+  };
+
+public:
+  friend std::ostream &operator<<(std::ostream &os,
+                                  const ctokenbucket &bucket) {
+    AcquireReadLock rlock(bucket.lock);
+    os << "<ctokenbucket rate: " << bucket.rate << " burst: " << bucket.burst
+       << " tokens: " << bucket.tokens << " >" << std::endl;
+    return os;
+  };
+
+private:
+  /**
+   *
+   */
+  void refill() {
+    ctimespec now = ctimespec::now();
+    ctimespec delta = now - last;
+    last = now;
+    tokens += rate * ((double)delta.get_tspec().tv_sec +
+                      (double)delta.get_tspec().tv_nsec / 1e9);
+    if (tokens > burst)
+      tokens = burst;
+  };
+
+private:
+  // tokens per second, 0: unlimited
+  double rate;
+
+  // maximum number of tokens
+  double burst;
+
+  // tokens currently available
+  double tokens;
+
+  // time of last refill
+  ctimespec last;
+
+  mutable crwlock lock;
+};
+
+}; // end of namespace rofl
+
+#endif /* SRC_ROFL_COMMON_CTOKENBUCKET_HPP_ */
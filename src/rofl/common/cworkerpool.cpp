@@ -0,0 +1,201 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cworkerpool.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#include "rofl/common/cworkerpool.hpp"
+
+using namespace rofl;
+
+/*static*/ pthread_mutex_t cworkerpool::pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+/*static*/ pthread_cond_t cworkerpool::pool_cond = PTHREAD_COND_INITIALIZER;
+/*static*/ std::vector<pthread_t> cworkerpool::workers;
+/*static*/ std::deque<cworkerpool::ctask> cworkerpool::tasks;
+/*static*/ bool cworkerpool::running = false;
+/*static*/ size_t cworkerpool::min_num_of_items =
+    cworkerpool::DEFAULT_MIN_NUM_OF_ITEMS;
+
+void cworkerpool::initialize(unsigned int num_of_workers,
+                             size_t min_num_of_items) {
+  cworkerpool::terminate();
+
+  pthread_mutex_lock(&pool_mutex);
+  cworkerpool::min_num_of_items = (min_num_of_items > 1) ? min_num_of_items : 2;
+  running = true;
+  for (unsigned int i = 0; i < num_of_workers; i++) {
+    pthread_t tid;
+    if (pthread_create(&tid, NULL, &(cworkerpool::start_worker), NULL) != 0) {
+      pthread_mutex_unlock(&pool_mutex);
+      throw eSysCall("eSysCall", "pthread_create", __FILE__, __FUNCTION__,
+                     __LINE__);
+    }
+    pthread_setname_np(tid, "rofl-decode");
+    workers.push_back(tid);
+  }
+  pthread_mutex_unlock(&pool_mutex);
+}
+
+void cworkerpool::terminate() {
+  std::vector<pthread_t> joinable;
+
+  pthread_mutex_lock(&pool_mutex);
+  running = false;
+  joinable.swap(workers);
+  pthread_cond_broadcast(&pool_cond);
+  pthread_mutex_unlock(&pool_mutex);
+
+  for (auto tid : joinable) {
+    pthread_join(tid, NULL);
+  }
+}
+
+bool cworkerpool::is_enabled() {
+  pthread_mutex_lock(&pool_mutex);
+  bool enabled = running && not workers.empty();
+  pthread_mutex_unlock(&pool_mutex);
+  return enabled;
+}
+
+size_t cworkerpool::get_min_num_of_items() {
+  pthread_mutex_lock(&pool_mutex);
+  size_t num = min_num_of_items;
+  pthread_mutex_unlock(&pool_mutex);
+  return num;
+}
+
+void cworkerpool::for_each_chunk(
+    size_t num_of_items, const std::function<void(size_t, size_t)> &fn) {
+  if (0 == num_of_items)
+    return;
+
+  pthread_mutex_lock(&pool_mutex);
+  size_t num_of_chunks = (running && (num_of_items >= min_num_of_items))
+                             ? workers.size() + 1
+                             : 1;
+  pthread_mutex_unlock(&pool_mutex);
+
+  if (num_of_chunks > num_of_items)
+    num_of_chunks = num_of_items;
+
+  /* no workers available or range too small: decode inline */
+  if (num_of_chunks < 2) {
+    fn(0, num_of_items);
+    return;
+  }
+
+  cbatch batch;
+  pthread_mutex_init(&batch.mutex, NULL);
+  pthread_cond_init(&batch.cond, NULL);
+  batch.pending = num_of_chunks;
+
+  size_t chunk_size = num_of_items / num_of_chunks;
+  size_t remainder = num_of_items % num_of_chunks;
+
+  /* chunk 0 stays on the calling thread, all others go to the workers */
+  size_t head = chunk_size + (remainder > 0 ? 1 : 0);
+  pthread_mutex_lock(&pool_mutex);
+  size_t first = head;
+  for (size_t i = 1; i < num_of_chunks; i++) {
+    size_t last = first + chunk_size + (i < remainder ? 1 : 0);
+    ctask task;
+    task.batch = &batch;
+    task.first = first;
+    task.last = last;
+    task.fn = &fn;
+    tasks.push_back(task);
+    first = last;
+  }
+  pthread_cond_broadcast(&pool_cond);
+  pthread_mutex_unlock(&pool_mutex);
+
+  ctask task;
+  task.batch = &batch;
+  task.first = 0;
+  task.last = head;
+  task.fn = &fn;
+  run_task(task);
+
+  /* wait for the workers, help out if they lag behind */
+  pthread_mutex_lock(&batch.mutex);
+  while (batch.pending > 0) {
+    pthread_mutex_unlock(&batch.mutex);
+
+    bool found = false;
+    pthread_mutex_lock(&pool_mutex);
+    for (auto it = tasks.begin(); it != tasks.end(); ++it) {
+      if (it->batch == &batch) {
+        task = *it;
+        tasks.erase(it);
+        found = true;
+        break;
+      }
+    }
+    pthread_mutex_unlock(&pool_mutex);
+
+    if (found) {
+      run_task(task);
+      pthread_mutex_lock(&batch.mutex);
+      continue;
+    }
+
+    pthread_mutex_lock(&batch.mutex);
+    while (batch.pending > 0) {
+      pthread_cond_wait(&batch.cond, &batch.mutex);
+    }
+  }
+  std::exception_ptr error = batch.error;
+  pthread_mutex_unlock(&batch.mutex);
+
+  pthread_cond_destroy(&batch.cond);
+  pthread_mutex_destroy(&batch.mutex);
+
+  if (error)
+    std::rethrow_exception(error);
+}
+
+void *cworkerpool::start_worker(void *arg) {
+  pthread_mutex_lock(&pool_mutex);
+  while (true) {
+    while (running && tasks.empty()) {
+      pthread_cond_wait(&pool_cond, &pool_mutex);
+    }
+    if (tasks.empty()) {
+      /* not running and nothing left to do */
+      break;
+    }
+    ctask task = tasks.front();
+    tasks.pop_front();
+    pthread_mutex_unlock(&pool_mutex);
+
+    run_task(task);
+
+    pthread_mutex_lock(&pool_mutex);
+  }
+  pthread_mutex_unlock(&pool_mutex);
+  return NULL;
+}
+
+void cworkerpool::run_task(const ctask &task) {
+  std::exception_ptr error;
+  try {
+    (*(task.fn))(task.first, task.last);
+  } catch (...) {
+    error = std::current_exception();
+  }
+  complete(task.batch, error);
+}
+
+void cworkerpool::complete(cbatch *batch, std::exception_ptr error) {
+  pthread_mutex_lock(&batch->mutex);
+  if (error && not batch->error)
+    batch->error = error;
+  if (--batch->pending == 0)
+    pthread_cond_broadcast(&batch->cond);
+  pthread_mutex_unlock(&batch->mutex);
+}
@@ -0,0 +1,108 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cworkerpool.hpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#ifndef SRC_ROFL_COMMON_CWORKERPOOL_HPP_
+#define SRC_ROFL_COMMON_CWORKERPOOL_HPP_
+
+#include <deque>
+#include <exception>
+#include <functional>
+#include <pthread.h>
+#include <vector>
+
+#include "rofl/common/exception.hpp"
+
+namespace rofl {
+
+/**
+ * @brief	Shared pool of worker threads for decoding large messages.
+ *
+ * The pool is disabled by default. When enabled, for_each_chunk() splits
+ * a range of independent items into contiguous chunks, hands all but the
+ * first chunk to the workers and decodes the first chunk on the calling
+ * thread. It returns once all chunks have been processed, so callers
+ * keep their ordering guarantees.
+ */
+class cworkerpool {
+public:
+  enum cworkerpool_defaults_t {
+    DEFAULT_NUM_OF_WORKERS = 0,
+    DEFAULT_MIN_NUM_OF_ITEMS = 64,
+  };
+
+  /**
+   * @brief	Start worker threads, 0 disables parallel decoding
+   *
+   * @param num_of_workers number of worker threads
+   * @param min_num_of_items ranges below this size are processed inline
+   */
+  static void initialize(unsigned int num_of_workers = DEFAULT_NUM_OF_WORKERS,
+                         size_t min_num_of_items = DEFAULT_MIN_NUM_OF_ITEMS);
+
+  /**
+   * @brief	Stop and join all worker threads
+   */
+  static void terminate();
+
+  /**
+   * @brief	Returns true if worker threads are available
+   */
+  static bool is_enabled();
+
+  /**
+   * @brief	Returns minimum number of items for splitting a range
+   */
+  static size_t get_min_num_of_items();
+
+  /**
+   * @brief	Process items [0, num_of_items) in contiguous chunks
+   *
+   * Function fn is called with half-open ranges [first, last). Chunks are
+   * processed concurrently and must not share mutable state. The first
+   * exception thrown by any chunk is rethrown on the calling thread.
+   */
+  static void
+  for_each_chunk(size_t num_of_items,
+                 const std::function<void(size_t first, size_t last)> &fn);
+
+private:
+  struct cbatch {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    size_t pending;
+    std::exception_ptr error;
+  };
+
+  struct ctask {
+    cbatch *batch;
+    size_t first;
+    size_t last;
+    const std::function<void(size_t, size_t)> *fn;
+  };
+
+  static void *start_worker(void *arg);
+
+  static void run_task(const ctask &task);
+
+  static void complete(cbatch *batch, std::exception_ptr error);
+
+private:
+  static pthread_mutex_t pool_mutex;
+  static pthread_cond_t pool_cond;
+  static std::vector<pthread_t> workers;
+  static std::deque<ctask> tasks;
+  static bool running;
+  static size_t min_num_of_items;
+};
+
+}; // end of namespace rofl
+
+#endif /* SRC_ROFL_COMMON_CWORKERPOOL_HPP_ */
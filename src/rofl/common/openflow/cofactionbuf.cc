@@ -0,0 +1,404 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string.h>
+
+#include "rofl/common/openflow/cofactionbuf.h"
+
+using namespace rofl::openflow;
+
+uint32_t cofactionbuf::caction::get_port_no() const {
+  switch (get_type()) {
+  case rofl::openflow::OFPAT_OUTPUT: {
+    if (is_of10())
+      return be16toh(
+          ((const struct rofl::openflow10::ofp_action_output *)buf)->port);
+    return be32toh(
+        ((const struct rofl::openflow13::ofp_action_output *)buf)->port);
+  } break;
+  case rofl::openflow10::OFPAT_ENQUEUE: {
+    if (is_of10())
+      return be16toh(
+          ((const struct rofl::openflow10::ofp_action_enqueue *)buf)->port);
+  } break;
+  default: {};
+  }
+  throw eActionBufInval("cofactionbuf::caction::get_port_no() no port");
+}
+
+uint16_t cofactionbuf::caction::get_max_len() const {
+  if (get_type() != rofl::openflow::OFPAT_OUTPUT)
+    throw eActionBufInval("cofactionbuf::caction::get_max_len() no output");
+  if (is_of10())
+    return be16toh(
+        ((const struct rofl::openflow10::ofp_action_output *)buf)->max_len);
+  return be16toh(
+      ((const struct rofl::openflow13::ofp_action_output *)buf)->max_len);
+}
+
+uint32_t cofactionbuf::caction::get_group_id() const {
+  if (is_of10() || (get_type() != rofl::openflow::OFPAT_GROUP))
+    throw eActionBufInval("cofactionbuf::caction::get_group_id() no group");
+  return be32toh(
+      ((const struct rofl::openflow13::ofp_action_group *)buf)->group_id);
+}
+
+uint32_t cofactionbuf::caction::get_queue_id() const {
+  if (is_of10() && (get_type() == rofl::openflow10::OFPAT_ENQUEUE))
+    return be32toh(
+        ((const struct rofl::openflow10::ofp_action_enqueue *)buf)->queue_id);
+  if ((not is_of10()) && (get_type() == rofl::openflow::OFPAT_SET_QUEUE))
+    return be32toh(
+        ((const struct rofl::openflow13::ofp_action_set_queue *)buf)->queue_id);
+  throw eActionBufInval("cofactionbuf::caction::get_queue_id() no queue");
+}
+
+uint32_t cofactionbuf::caction::get_oxm_id() const {
+  if (is_of10() || (get_type() != rofl::openflow::OFPAT_SET_FIELD))
+    throw eActionBufInval("cofactionbuf::caction::get_oxm_id() no set-field");
+  uint32_t oxm_id;
+  memcpy(&oxm_id,
+         ((const struct rofl::openflow13::ofp_action_set_field *)buf)->field,
+         sizeof(oxm_id));
+  return be32toh(oxm_id);
+}
+
+const uint8_t *cofactionbuf::caction::get_oxm_value() const {
+  if (is_of10() || (get_type() != rofl::openflow::OFPAT_SET_FIELD))
+    throw eActionBufInval(
+        "cofactionbuf::caction::get_oxm_value() no set-field");
+  return ((const struct rofl::openflow13::ofp_action_set_field *)buf)->field +
+         sizeof(uint32_t);
+}
+
+uint32_t cofactionbuf::caction::get_exp_id() const {
+  if (get_type() != rofl::openflow::OFPAT_EXPERIMENTER)
+    throw eActionBufInval("cofactionbuf::caction::get_exp_id() no "
+                          "experimenter");
+  if (is_of10())
+    return be32toh(
+        ((const struct rofl::openflow10::ofp_action_vendor_header *)buf)
+            ->vendor);
+  return be32toh(
+      ((const struct rofl::openflow13::ofp_action_experimenter_header *)buf)
+          ->experimenter);
+}
+
+void cofactionbuf::pack(uint8_t *buf, size_t buflen) const {
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  if (buflen < length())
+    throw eInvalid("cofactionbuf::pack() buflen too short", __FILE__,
+                   __FUNCTION__, __LINE__);
+
+  memcpy(buf, this->buf.data(), this->buf.size());
+}
+
+void cofactionbuf::unpack(uint8_t *buf, size_t buflen) {
+  clear();
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  /* validate all TLVs before copying */
+  size_t offset = 0;
+  size_t num = 0;
+  while (offset < buflen) {
+    if ((buflen - offset) < sizeof(struct rofl::openflow::ofp_action_header))
+      throw eBadActionBadLen("cofactionbuf::unpack() truncated action",
+                             __FILE__, __FUNCTION__, __LINE__);
+
+    struct rofl::openflow::ofp_action_header *hdr =
+        (struct rofl::openflow::ofp_action_header *)(buf + offset);
+
+    size_t len = be16toh(hdr->len);
+
+    if ((len < sizeof(struct rofl::openflow::ofp_action_header)) ||
+        (len % 8) || (len > (buflen - offset)))
+      throw eBadActionBadLen(
+          "cofactionbuf::unpack() invalid length field in action", __FILE__,
+          __FUNCTION__, __LINE__);
+
+    offset += len;
+    num++;
+  }
+
+  this->buf.assign(buf, buf + buflen);
+  count = num;
+}
+
+void cofactionbuf::pack_instruction(uint16_t type, uint8_t *buf,
+                                    size_t buflen) const {
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  switch (ofp_version) {
+  case rofl::openflow12::OFP_VERSION:
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
+  } break;
+  default:
+    throw eBadVersion("cofactionbuf::pack_instruction() invalid version",
+                      __FILE__, __FUNCTION__, __LINE__);
+  }
+
+  if (buflen < instruction_length())
+    throw eInvalid("cofactionbuf::pack_instruction() buflen too short",
+                   __FILE__, __FUNCTION__, __LINE__);
+
+  struct rofl::openflow13::ofp_instruction_actions *hdr =
+      (struct rofl::openflow13::ofp_instruction_actions *)buf;
+
+  hdr->type = htobe16(type);
+  hdr->len = htobe16(instruction_length());
+  memset(hdr->pad, 0, sizeof(hdr->pad));
+
+  memcpy(hdr->actions, this->buf.data(), this->buf.size());
+}
+
+cofactions cofactionbuf::get_actions() const {
+  cofactions actions(ofp_version);
+  actions.unpack((uint8_t *)buf.data(), buf.size());
+  return actions;
+}
+
+void cofactionbuf::set_actions(const cofactions &actions) {
+  cofactions tmp(actions);
+
+  ofp_version = tmp.get_version();
+  clear();
+  buf.resize(tmp.length());
+  tmp.pack(buf.data(), buf.size());
+  count = tmp.get_actions().size();
+}
+
+uint8_t *cofactionbuf::append(uint16_t type, size_t len, bool of10) {
+  switch (ofp_version) {
+  case rofl::openflow10::OFP_VERSION: {
+    if (not of10)
+      throw eBadVersion("cofactionbuf::append() action invalid for "
+                        "OpenFlow 1.0",
+                        __FILE__, __FUNCTION__, __LINE__);
+  } break;
+  case rofl::openflow12::OFP_VERSION:
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
+    if (of10)
+      throw eBadVersion("cofactionbuf::append() action valid for "
+                        "OpenFlow 1.0 only",
+                        __FILE__, __FUNCTION__, __LINE__);
+  } break;
+  default:
+    throw eBadVersion("cofactionbuf::append() invalid version", __FILE__,
+                      __FUNCTION__, __LINE__);
+  }
+
+  size_t offset = buf.size();
+  buf.resize(offset + len);
+  count++;
+
+  struct rofl::openflow::ofp_action_header *hdr =
+      (struct rofl::openflow::ofp_action_header *)(buf.data() + offset);
+  hdr->type = htobe16(type);
+  hdr->len = htobe16(len);
+
+  return buf.data() + offset;
+}
+
+cofactionbuf &cofactionbuf::append_output(uint32_t port_no, uint16_t max_len) {
+  if (rofl::openflow10::OFP_VERSION == ofp_version) {
+    struct rofl::openflow10::ofp_action_output *hdr =
+        (struct rofl::openflow10::ofp_action_output *)append(
+            rofl::openflow::OFPAT_OUTPUT,
+            sizeof(struct rofl::openflow10::ofp_action_output), true);
+    hdr->port = htobe16((uint16_t)port_no);
+    hdr->max_len = htobe16(max_len);
+  } else {
+    struct rofl::openflow13::ofp_action_output *hdr =
+        (struct rofl::openflow13::ofp_action_output *)append(
+            rofl::openflow::OFPAT_OUTPUT,
+            sizeof(struct rofl::openflow13::ofp_action_output));
+    hdr->port = htobe32(port_no);
+    hdr->max_len = htobe16(max_len);
+  }
+  return *this;
+}
+
+cofactionbuf &cofactionbuf::append_set_vlan_vid(uint16_t vlan_vid) {
+  struct rofl::openflow10::ofp_action_vlan_vid *hdr =
+      (struct rofl::openflow10::ofp_action_vlan_vid *)append(
+          rofl::openflow::OFPAT_SET_VLAN_VID,
+          sizeof(struct rofl::openflow10::ofp_action_vlan_vid), true);
+  hdr->vlan_vid = htobe16(vlan_vid);
+  return *this;
+}
+
+cofactionbuf &cofactionbuf::append_set_vlan_pcp(uint8_t vlan_pcp) {
+  struct rofl::openflow10::ofp_action_vlan_pcp *hdr =
+      (struct rofl::openflow10::ofp_action_vlan_pcp *)append(
+          rofl::openflow::OFPAT_SET_VLAN_PCP,
+          sizeof(struct rofl::openflow10::ofp_action_vlan_pcp), true);
+  hdr->vlan_pcp = vlan_pcp;
+  return *this;
+}
+
+cofactionbuf &cofactionbuf::append_dl_addr(uint16_t type,
+                                           const rofl::caddress_ll &addr) {
+  struct rofl::openflow10::ofp_action_dl_addr *hdr =
+      (struct rofl::openflow10::ofp_action_dl_addr *)append(
+          type, sizeof(struct rofl::openflow10::ofp_action_dl_addr), true);
+  memcpy(hdr->dl_addr, addr.somem(), OFP_ETH_ALEN);
+  return *this;
+}
+
+cofactionbuf &cofactionbuf::append_nw_addr(uint16_t type,
+                                           const rofl::caddress_in4 &addr) {
+  struct rofl::openflow10::ofp_action_nw_addr *hdr =
+      (struct rofl::openflow10::ofp_action_nw_addr *)append(
+          type, sizeof(struct rofl::openflow10::ofp_action_nw_addr), true);
+  hdr->nw_addr = addr.get_addr_nbo();
+  return *this;
+}
+
+cofactionbuf &cofactionbuf::append_set_nw_tos(uint8_t nw_tos) {
+  struct rofl::openflow10::ofp_action_nw_tos *hdr =
+      (struct rofl::openflow10::ofp_action_nw_tos *)append(
+          rofl::openflow::OFPAT_SET_NW_TOS,
+          sizeof(struct rofl::openflow10::ofp_action_nw_tos), true);
+  hdr->nw_tos = nw_tos;
+  return *this;
+}
+
+cofactionbuf &cofactionbuf::append_tp_port(uint16_t type, uint16_t tp_port) {
+  struct rofl::openflow10::ofp_action_tp_port *hdr =
+      (struct rofl::openflow10::ofp_action_tp_port *)append(
+          type, sizeof(struct rofl::openflow10::ofp_action_tp_port), true);
+  hdr->tp_port = htobe16(tp_port);
+  return *this;
+}
+
+cofactionbuf &cofactionbuf::append_enqueue(uint16_t port_no,
+                                           uint32_t queue_id) {
+  struct rofl::openflow10::ofp_action_enqueue *hdr =
+      (struct rofl::openflow10::ofp_action_enqueue *)append(
+          rofl::openflow10::OFPAT_ENQUEUE,
+          sizeof(struct rofl::openflow10::ofp_action_enqueue), true);
+  hdr->port = htobe16(port_no);
+  hdr->queue_id = htobe32(queue_id);
+  return *this;
+}
+
+cofactionbuf &cofactionbuf::append_vendor(uint32_t exp_id,
+                                          const rofl::cmemory &exp_body) {
+  return append_exp(rofl::openflow10::OFPAT_VENDOR, exp_id, exp_body, true);
+}
+
+cofactionbuf &cofactionbuf::append_set_mpls_ttl(uint8_t mpls_ttl) {
+  struct rofl::openflow13::ofp_action_mpls_ttl *hdr =
+      (struct rofl::openflow13::ofp_action_mpls_ttl *)append(
+          rofl::openflow::OFPAT_SET_MPLS_TTL,
+          sizeof(struct rofl::openflow13::ofp_action_mpls_ttl));
+  hdr->mpls_ttl = mpls_ttl;
+  return *this;
+}
+
+cofactionbuf &cofactionbuf::append_push(uint16_t type, uint16_t eth_type) {
+  /* ofp_action_pop_mpls shares its layout with ofp_action_push */
+  struct rofl::openflow13::ofp_action_push *hdr =
+      (struct rofl::openflow13::ofp_action_push *)append(
+          type, sizeof(struct rofl::openflow13::ofp_action_push));
+  hdr->ethertype = htobe16(eth_type);
+  return *this;
+}
+
+cofactionbuf &cofactionbuf::append_group(uint32_t group_id) {
+  struct rofl::openflow13::ofp_action_group *hdr =
+      (struct rofl::openflow13::ofp_action_group *)append(
+          rofl::openflow::OFPAT_GROUP,
+          sizeof(struct rofl::openflow13::ofp_action_group));
+  hdr->group_id = htobe32(group_id);
+  return *this;
+}
+
+cofactionbuf &cofactionbuf::append_set_nw_ttl(uint8_t nw_ttl) {
+  struct rofl::openflow13::ofp_action_nw_ttl *hdr =
+      (struct rofl::openflow13::ofp_action_nw_ttl *)append(
+          rofl::openflow::OFPAT_SET_NW_TTL,
+          sizeof(struct rofl::openflow13::ofp_action_nw_ttl));
+  hdr->nw_ttl = nw_ttl;
+  return *this;
+}
+
+cofactionbuf &cofactionbuf::append_set_queue(uint32_t queue_id) {
+  struct rofl::openflow13::ofp_action_set_queue *hdr =
+      (struct rofl::openflow13::ofp_action_set_queue *)append(
+          rofl::openflow::OFPAT_SET_QUEUE,
+          sizeof(struct rofl::openflow13::ofp_action_set_queue));
+  hdr->queue_id = htobe32(queue_id);
+  return *this;
+}
+
+cofactionbuf &
+cofactionbuf::append_experimenter(uint32_t exp_id,
+                                  const rofl::cmemory &exp_body) {
+  return append_exp(rofl::openflow::OFPAT_EXPERIMENTER, exp_id, exp_body,
+                    false);
+}
+
+cofactionbuf &cofactionbuf::append_exp(uint16_t type, uint32_t exp_id,
+                                       const rofl::cmemory &exp_body,
+                                       bool of10) {
+  /* vendor and experimenter headers share the same layout */
+  size_t len = sizeof(struct rofl::openflow13::ofp_action_experimenter_header) +
+               exp_body.length();
+
+  /* append padding if not a multiple of 8 */
+  if (len & 0x7)
+    len += 8 - (len & 0x7);
+
+  if (len > 0xffff)
+    throw eActionBufInval("cofactionbuf::append_exp() body too long");
+
+  struct rofl::openflow13::ofp_action_experimenter_header *hdr =
+      (struct rofl::openflow13::ofp_action_experimenter_header *)append(
+          type, len, of10);
+  hdr->experimenter = htobe32(exp_id);
+  if (exp_body.length())
+    memcpy(hdr->data, exp_body.somem(), exp_body.length());
+  return *this;
+}
+
+cofactionbuf &cofactionbuf::append_set_field(uint32_t oxm_id,
+                                             const uint8_t *value,
+                                             size_t valuelen) {
+  if ((oxm_id & HAS_MASK_FLAG) || ((oxm_id & 0x000000ff) != valuelen))
+    throw eActionBufInval("cofactionbuf::append_set_field() OXM TLV "
+                          "header does not match value");
+
+  size_t len = sizeof(struct rofl::openflow::ofp_action_header) -
+               4 * sizeof(uint8_t) + sizeof(uint32_t) + valuelen;
+
+  /* append padding if not a multiple of 8 */
+  if (len & 0x7)
+    len += 8 - (len & 0x7);
+
+  struct rofl::openflow13::ofp_action_set_field *hdr =
+      (struct rofl::openflow13::ofp_action_set_field *)append(
+          rofl::openflow::OFPAT_SET_FIELD, len);
+  oxm_id = htobe32(oxm_id);
+  memcpy(hdr->field, &oxm_id, sizeof(oxm_id));
+  memcpy(hdr->field + sizeof(oxm_id), value, valuelen);
+  return *this;
+}
+
+cofactionbuf &cofactionbuf::append_set_field(const coxmatch &oxm) {
+  rofl::cmemory mem(oxm.length());
+  /* coxmatch::pack() is not const, but leaves the instance unchanged */
+  const_cast<coxmatch &>(oxm).pack(mem.somem(), mem.length());
+
+  uint32_t oxm_id = be32toh(*(uint32_t *)mem.somem());
+  return append_set_field(oxm_id, mem.somem() + sizeof(uint32_t),
+                          mem.length() - sizeof(uint32_t));
+}
@@ -0,0 +1,1004 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef ROFL_COMMON_OPENFLOW_COFACTIONBUF_H
+#define ROFL_COMMON_OPENFLOW_COFACTIONBUF_H 1
+
+#include <endian.h>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <vector>
+#ifndef htobe16
+#include "../endian_conversion.h"
+#endif
+
+#include "rofl/common/caddress.h"
+#include "rofl/common/cmemory.h"
+#include "rofl/common/exception.hpp"
+#include "rofl/common/openflow/cofactions.h"
+#include "rofl/common/openflow/openflow.h"
+
+namespace rofl {
+namespace openflow {
+
+class eActionBufBase : public exception {
+public:
+  eActionBufBase(const std::string &__arg = std::string(""))
+      : exception(__arg) {
+    set_exception("eActionBufBase");
+  };
+};
+class eActionBufInval : public eActionBufBase {
+public:
+  eActionBufInval(const std::string &__arg = std::string(""))
+      : eActionBufBase(__arg) {
+    set_exception("eActionBufInval");
+  };
+};
+
+/**
+ * @brief	Action list in wire format.
+ *
+ * cofactionbuf appends actions directly as TLVs into a single contiguous
+ * buffer, so building an action list costs neither per-action heap
+ * allocations nor virtual pack() calls. The buffer keeps its capacity on
+ * clear(), hence a cofactionbuf reused for subsequent messages does not
+ * allocate at all once warmed up.
+ *
+ * Actions are appended in order of the append_*() calls. Appending an
+ * action not defined for the buffer's OpenFlow version throws
+ * eBadVersion. Iteration provides read-only access to the packed TLVs,
+ * get_actions() and set_actions() convert from and to cofactions.
+ */
+class cofactionbuf {
+public:
+  /**
+   * @brief	Read-only view on a single packed action.
+   */
+  class caction {
+  public:
+    /**
+     *
+     */
+    caction(uint8_t ofp_version = rofl::openflow::OFP_VERSION_UNKNOWN,
+            const uint8_t *buf = nullptr)
+        : ofp_version(ofp_version), buf(buf){};
+
+  public:
+    /**
+     *
+     */
+    uint8_t get_version() const { return ofp_version; };
+
+    /**
+     *
+     */
+    uint16_t get_type() const {
+      return be16toh(((const struct rofl::openflow::ofp_action_header *)buf)
+                         ->type);
+    };
+
+    /**
+     * @brief	Returns length of this action including header and padding.
+     */
+    uint16_t get_length() const {
+      return be16toh(((const struct rofl::openflow::ofp_action_header *)buf)
+                         ->len);
+    };
+
+    /**
+     * @brief	Returns start of this action in wire format.
+     */
+    const uint8_t *get_data() const { return buf; };
+
+  public:
+    /**
+     * @brief	Returns port of an output or OpenFlow 1.0 enqueue action.
+     *
+     * @exception eActionBufInval action carries no port
+     */
+    uint32_t get_port_no() const;
+
+    /**
+     * @brief	Returns max_len of an output action.
+     *
+     * @exception eActionBufInval action is not an output action
+     */
+    uint16_t get_max_len() const;
+
+    /**
+     * @brief	Returns group of a group action.
+     *
+     * @exception eActionBufInval action is not a group action
+     */
+    uint32_t get_group_id() const;
+
+    /**
+     * @brief	Returns queue of a set-queue or OpenFlow 1.0 enqueue action.
+     *
+     * @exception eActionBufInval action carries no queue
+     */
+    uint32_t get_queue_id() const;
+
+    /**
+     * @brief	Returns OXM TLV header of a set-field action.
+     *
+     * @exception eActionBufInval action is not a set-field action
+     */
+    uint32_t get_oxm_id() const;
+
+    /**
+     * @brief	Returns start of the value within a set-field action.
+     *
+     * The value is stored in network byte order, its length is given by
+     * the lower eight bits of get_oxm_id().
+     *
+     * @exception eActionBufInval action is not a set-field action
+     */
+    const uint8_t *get_oxm_value() const;
+
+    /**
+     * @brief	Returns identifier of an experimenter or vendor action.
+     *
+     * @exception eActionBufInval action is not an experimenter action
+     */
+    uint32_t get_exp_id() const;
+
+  private:
+    /**
+     *
+     */
+    bool is_of10() const {
+      return (rofl::openflow10::OFP_VERSION == ofp_version);
+    };
+
+  private:
+    uint8_t ofp_version;
+    const uint8_t *buf;
+  };
+
+  /**
+   * @brief	Forward iterator over the packed actions.
+   */
+  class const_iterator
+      : public std::iterator<std::forward_iterator_tag, const caction> {
+  public:
+    /**
+     *
+     */
+    const_iterator(uint8_t ofp_version, const uint8_t *buf)
+        : action(ofp_version, buf){};
+
+    /**
+     *
+     */
+    const caction &operator*() const { return action; };
+
+    /**
+     *
+     */
+    const caction *operator->() const { return &action; };
+
+    /**
+     *
+     */
+    const_iterator &operator++() {
+      action = caction(action.get_version(),
+                       action.get_data() + action.get_length());
+      return *this;
+    };
+
+    /**
+     *
+     */
+    const_iterator operator++(int) {
+      const_iterator it(*this);
+      ++(*this);
+      return it;
+    };
+
+    /**
+     *
+     */
+    bool operator==(const const_iterator &it) const {
+      return (action.get_data() == it.action.get_data());
+    };
+
+    /**
+     *
+     */
+    bool operator!=(const const_iterator &it) const {
+      return (not operator==(it));
+    };
+
+  private:
+    caction action;
+  };
+
+public:
+  /**
+   *
+   */
+  ~cofactionbuf(){};
+
+  /**
+   * @brief	Creates an empty action list.
+   *
+   * @param ofp_version OpenFlow version of all actions in this list
+   * @param capacity number of bytes reserved in advance
+   */
+  cofactionbuf(uint8_t ofp_version = rofl::openflow::OFP_VERSION_UNKNOWN,
+               size_t capacity = DEFAULT_CAPACITY)
+      : ofp_version(ofp_version), count(0) {
+    buf.reserve(capacity);
+  };
+
+  /**
+   * @brief	Creates an action list from cofactions in packed state.
+   */
+  cofactionbuf(const cofactions &actions)
+      : ofp_version(actions.get_version()), count(0) {
+    set_actions(actions);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf(const cofactionbuf &actions) { *this = actions; };
+
+  /**
+   *
+   */
+  cofactionbuf &operator=(const cofactionbuf &actions) {
+    if (this == &actions)
+      return *this;
+    ofp_version = actions.ofp_version;
+    buf = actions.buf;
+    count = actions.count;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  bool operator==(const cofactionbuf &actions) const {
+    return ((ofp_version == actions.ofp_version) && (buf == actions.buf));
+  };
+
+public:
+  /**
+   * @brief	Removes all actions, the buffer's capacity is retained.
+   */
+  void clear() {
+    buf.clear();
+    count = 0;
+  };
+
+  /**
+   *
+   */
+  void reserve(size_t capacity) { buf.reserve(capacity); };
+
+  /**
+   *
+   */
+  uint8_t get_version() const { return ofp_version; };
+
+  /**
+   * @brief	Sets the OpenFlow version, this drops all actions.
+   */
+  void set_version(uint8_t ofp_version) {
+    this->ofp_version = ofp_version;
+    clear();
+  };
+
+  /**
+   * @brief	Returns number of actions.
+   */
+  size_t size() const { return count; };
+
+  /**
+   *
+   */
+  bool empty() const { return (0 == count); };
+
+  /**
+   * @brief	Returns start of the action list in wire format.
+   */
+  const uint8_t *data() const { return buf.data(); };
+
+  /**
+   *
+   */
+  const_iterator begin() const { return const_iterator(ofp_version, data()); };
+
+  /**
+   *
+   */
+  const_iterator end() const {
+    return const_iterator(ofp_version, data() + buf.size());
+  };
+
+public:
+  /**
+   * @brief	Returns length of the action list in bytes.
+   */
+  size_t length() const { return buf.size(); };
+
+  /**
+   *
+   */
+  void pack(uint8_t *buf, size_t buflen) const;
+
+  /**
+   * @brief	Replaces all actions by an action list in wire format.
+   *
+   * @exception eBadActionBadLen malformed action list
+   */
+  void unpack(uint8_t *buf, size_t buflen);
+
+  /**
+   * @brief	Returns length of an OpenFlow 1.2+ actions instruction
+   * containing this action list.
+   */
+  size_t instruction_length() const {
+    return sizeof(struct rofl::openflow13::ofp_instruction_actions) +
+           buf.size();
+  };
+
+  /**
+   * @brief	Packs this action list as OpenFlow 1.2+ actions instruction.
+   *
+   * @param type OFPIT_APPLY_ACTIONS or OFPIT_WRITE_ACTIONS
+   */
+  void pack_instruction(uint16_t type, uint8_t *buf, size_t buflen) const;
+
+public:
+  /**
+   * @brief	Returns a copy of this action list as cofactions.
+   */
+  cofactions get_actions() const;
+
+  /**
+   * @brief	Replaces all actions and the version by those of actions.
+   */
+  void set_actions(const cofactions &actions);
+
+public:
+  /**
+   *
+   */
+  cofactionbuf &append_output(uint32_t port_no, uint16_t max_len = 128);
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_vlan_vid(uint16_t vlan_vid);
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_vlan_pcp(uint8_t vlan_pcp);
+
+  /**
+   *
+   */
+  cofactionbuf &append_strip_vlan() {
+    append(rofl::openflow::OFPAT_STRIP_VLAN,
+           sizeof(struct rofl::openflow10::ofp_action_header), true);
+    return *this;
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_dl_src(const rofl::caddress_ll &macaddr) {
+    return append_dl_addr(rofl::openflow::OFPAT_SET_DL_SRC, macaddr);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_dl_dst(const rofl::caddress_ll &macaddr) {
+    return append_dl_addr(rofl::openflow::OFPAT_SET_DL_DST, macaddr);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_nw_src(const rofl::caddress_in4 &addr) {
+    return append_nw_addr(rofl::openflow::OFPAT_SET_NW_SRC, addr);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_nw_dst(const rofl::caddress_in4 &addr) {
+    return append_nw_addr(rofl::openflow::OFPAT_SET_NW_DST, addr);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_nw_tos(uint8_t nw_tos);
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_tp_src(uint16_t tp_port) {
+    return append_tp_port(rofl::openflow::OFPAT_SET_TP_SRC, tp_port);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_tp_dst(uint16_t tp_port) {
+    return append_tp_port(rofl::openflow::OFPAT_SET_TP_DST, tp_port);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_enqueue(uint16_t port_no, uint32_t queue_id);
+
+  /**
+   *
+   */
+  cofactionbuf &append_vendor(uint32_t exp_id,
+                              const rofl::cmemory &exp_body = rofl::cmemory(
+                                  (size_t)0));
+
+public:
+  /**
+   *
+   */
+  cofactionbuf &append_copy_ttl_out() {
+    append(rofl::openflow::OFPAT_COPY_TTL_OUT,
+           sizeof(struct rofl::openflow13::ofp_action_header));
+    return *this;
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_copy_ttl_in() {
+    append(rofl::openflow::OFPAT_COPY_TTL_IN,
+           sizeof(struct rofl::openflow13::ofp_action_header));
+    return *this;
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_mpls_ttl(uint8_t mpls_ttl);
+
+  /**
+   *
+   */
+  cofactionbuf &append_dec_mpls_ttl() {
+    append(rofl::openflow::OFPAT_DEC_MPLS_TTL,
+           sizeof(struct rofl::openflow13::ofp_action_header));
+    return *this;
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_push_vlan(uint16_t eth_type) {
+    return append_push(rofl::openflow::OFPAT_PUSH_VLAN, eth_type);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_pop_vlan() {
+    append(rofl::openflow::OFPAT_POP_VLAN,
+           sizeof(struct rofl::openflow13::ofp_action_header));
+    return *this;
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_push_mpls(uint16_t eth_type) {
+    return append_push(rofl::openflow::OFPAT_PUSH_MPLS, eth_type);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_pop_mpls(uint16_t eth_type) {
+    return append_push(rofl::openflow::OFPAT_POP_MPLS, eth_type);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_group(uint32_t group_id);
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_nw_ttl(uint8_t nw_ttl);
+
+  /**
+   *
+   */
+  cofactionbuf &append_dec_nw_ttl() {
+    append(rofl::openflow::OFPAT_DEC_NW_TTL,
+           sizeof(struct rofl::openflow13::ofp_action_header));
+    return *this;
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_queue(uint32_t queue_id);
+
+  /**
+   *
+   */
+  cofactionbuf &append_push_pbb(uint16_t eth_type) {
+    return append_push(rofl::openflow::OFPAT_PUSH_PBB, eth_type);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_pop_pbb() {
+    append(rofl::openflow::OFPAT_POP_PBB,
+           sizeof(struct rofl::openflow13::ofp_action_header));
+    return *this;
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &
+  append_experimenter(uint32_t exp_id,
+                      const rofl::cmemory &exp_body = rofl::cmemory((size_t)0));
+
+public:
+  /**
+   * @brief	Appends a set-field action for an arbitrary OXM TLV.
+   *
+   * @param oxm_id OXM TLV header without mask as defined by OXM_TLV_*
+   * @param value value in network byte order, for experimenter OXM TLVs
+   * including the experimenter identifier
+   * @param valuelen length of value, must match the length in oxm_id
+   */
+  cofactionbuf &append_set_field(uint32_t oxm_id, const uint8_t *value,
+                                 size_t valuelen);
+
+  /**
+   * @brief	Appends a set-field action for an existing coxmatch instance.
+   */
+  cofactionbuf &append_set_field(const coxmatch &oxm);
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_u8(uint32_t oxm_id, uint8_t value) {
+    return append_set_field(oxm_id, &value, sizeof(value));
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_u16(uint32_t oxm_id, uint16_t value) {
+    value = htobe16(value);
+    return append_set_field(oxm_id, (const uint8_t *)&value, sizeof(value));
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_u24(uint32_t oxm_id, uint32_t value) {
+    value = htobe32(value);
+    return append_set_field(oxm_id, (const uint8_t *)&value + 1, 3);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_u32(uint32_t oxm_id, uint32_t value) {
+    value = htobe32(value);
+    return append_set_field(oxm_id, (const uint8_t *)&value, sizeof(value));
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_u48(uint32_t oxm_id, uint64_t value) {
+    value = htobe64(value);
+    return append_set_field(oxm_id, (const uint8_t *)&value + 2, 6);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_u64(uint32_t oxm_id, uint64_t value) {
+    value = htobe64(value);
+    return append_set_field(oxm_id, (const uint8_t *)&value, sizeof(value));
+  };
+
+public:
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_in_port(uint32_t port_no) {
+    return append_set_field_u32(rofl::openflow::OXM_TLV_BASIC_IN_PORT,
+                                port_no);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_in_phy_port(uint32_t port_no) {
+    return append_set_field_u32(rofl::openflow::OXM_TLV_BASIC_IN_PHY_PORT,
+                                port_no);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_metadata(uint64_t metadata) {
+    return append_set_field_u64(rofl::openflow::OXM_TLV_BASIC_METADATA,
+                                metadata);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_eth_dst(const rofl::caddress_ll &addr) {
+    return append_set_field(rofl::openflow::OXM_TLV_BASIC_ETH_DST,
+                            addr.somem(), addr.length());
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_eth_src(const rofl::caddress_ll &addr) {
+    return append_set_field(rofl::openflow::OXM_TLV_BASIC_ETH_SRC,
+                            addr.somem(), addr.length());
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_eth_type(uint16_t eth_type) {
+    return append_set_field_u16(rofl::openflow::OXM_TLV_BASIC_ETH_TYPE,
+                                eth_type);
+  };
+
+  /**
+   * @brief	Appends a set-field action for the VLAN id.
+   *
+   * @param vid VLAN id including OFPVID_PRESENT
+   */
+  cofactionbuf &append_set_field_vlan_vid(uint16_t vid) {
+    return append_set_field_u16(rofl::openflow::OXM_TLV_BASIC_VLAN_VID, vid);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_vlan_pcp(uint8_t pcp) {
+    return append_set_field_u8(rofl::openflow::OXM_TLV_BASIC_VLAN_PCP, pcp);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_ip_dscp(uint8_t dscp) {
+    return append_set_field_u8(rofl::openflow::OXM_TLV_BASIC_IP_DSCP, dscp);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_ip_ecn(uint8_t ecn) {
+    return append_set_field_u8(rofl::openflow::OXM_TLV_BASIC_IP_ECN, ecn);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_ip_proto(uint8_t proto) {
+    return append_set_field_u8(rofl::openflow::OXM_TLV_BASIC_IP_PROTO, proto);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_ipv4_src(const rofl::caddress_in4 &addr) {
+    return append_set_field(rofl::openflow::OXM_TLV_BASIC_IPV4_SRC,
+                            addr.somem(), addr.length());
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_ipv4_dst(const rofl::caddress_in4 &addr) {
+    return append_set_field(rofl::openflow::OXM_TLV_BASIC_IPV4_DST,
+                            addr.somem(), addr.length());
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_tcp_src(uint16_t port) {
+    return append_set_field_u16(rofl::openflow::OXM_TLV_BASIC_TCP_SRC, port);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_tcp_dst(uint16_t port) {
+    return append_set_field_u16(rofl::openflow::OXM_TLV_BASIC_TCP_DST, port);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_udp_src(uint16_t port) {
+    return append_set_field_u16(rofl::openflow::OXM_TLV_BASIC_UDP_SRC, port);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_udp_dst(uint16_t port) {
+    return append_set_field_u16(rofl::openflow::OXM_TLV_BASIC_UDP_DST, port);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_sctp_src(uint16_t port) {
+    return append_set_field_u16(rofl::openflow::OXM_TLV_BASIC_SCTP_SRC, port);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_sctp_dst(uint16_t port) {
+    return append_set_field_u16(rofl::openflow::OXM_TLV_BASIC_SCTP_DST, port);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_icmpv4_type(uint8_t type) {
+    return append_set_field_u8(rofl::openflow::OXM_TLV_BASIC_ICMPV4_TYPE,
+                               type);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_icmpv4_code(uint8_t code) {
+    return append_set_field_u8(rofl::openflow::OXM_TLV_BASIC_ICMPV4_CODE,
+                               code);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_arp_opcode(uint16_t opcode) {
+    return append_set_field_u16(rofl::openflow::OXM_TLV_BASIC_ARP_OP, opcode);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_arp_spa(const rofl::caddress_in4 &addr) {
+    return append_set_field(rofl::openflow::OXM_TLV_BASIC_ARP_SPA,
+                            addr.somem(), addr.length());
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_arp_tpa(const rofl::caddress_in4 &addr) {
+    return append_set_field(rofl::openflow::OXM_TLV_BASIC_ARP_TPA,
+                            addr.somem(), addr.length());
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_arp_sha(const rofl::caddress_ll &addr) {
+    return append_set_field(rofl::openflow::OXM_TLV_BASIC_ARP_SHA,
+                            addr.somem(), addr.length());
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_arp_tha(const rofl::caddress_ll &addr) {
+    return append_set_field(rofl::openflow::OXM_TLV_BASIC_ARP_THA,
+                            addr.somem(), addr.length());
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_ipv6_src(const rofl::caddress_in6 &addr) {
+    return append_set_field(rofl::openflow::OXM_TLV_BASIC_IPV6_SRC,
+                            addr.somem(), addr.length());
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_ipv6_dst(const rofl::caddress_in6 &addr) {
+    return append_set_field(rofl::openflow::OXM_TLV_BASIC_IPV6_DST,
+                            addr.somem(), addr.length());
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_ipv6_flabel(uint32_t flow_label) {
+    return append_set_field_u32(rofl::openflow::OXM_TLV_BASIC_IPV6_FLABEL,
+                                flow_label);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_icmpv6_type(uint8_t type) {
+    return append_set_field_u8(rofl::openflow::OXM_TLV_BASIC_ICMPV6_TYPE,
+                               type);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_icmpv6_code(uint8_t code) {
+    return append_set_field_u8(rofl::openflow::OXM_TLV_BASIC_ICMPV6_CODE,
+                               code);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &
+  append_set_field_ipv6_nd_target(const rofl::caddress_in6 &addr) {
+    return append_set_field(rofl::openflow::OXM_TLV_BASIC_IPV6_ND_TARGET,
+                            addr.somem(), addr.length());
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_ipv6_nd_sll(const rofl::caddress_ll &addr) {
+    return append_set_field(rofl::openflow::OXM_TLV_BASIC_IPV6_ND_SLL,
+                            addr.somem(), addr.length());
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_ipv6_nd_tll(const rofl::caddress_ll &addr) {
+    return append_set_field(rofl::openflow::OXM_TLV_BASIC_IPV6_ND_TLL,
+                            addr.somem(), addr.length());
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_mpls_label(uint32_t mpls_label) {
+    return append_set_field_u32(rofl::openflow::OXM_TLV_BASIC_MPLS_LABEL,
+                                mpls_label);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_mpls_tc(uint8_t mpls_tc) {
+    return append_set_field_u8(rofl::openflow::OXM_TLV_BASIC_MPLS_TC,
+                               mpls_tc);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_mpls_bos(uint8_t mpls_bos) {
+    return append_set_field_u8(rofl::openflow::OXM_TLV_BASIC_MPLS_BOS,
+                               mpls_bos);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_pbb_isid(uint32_t pbb_isid) {
+    return append_set_field_u24(rofl::openflow::OXM_TLV_BASIC_PBB_ISID,
+                                pbb_isid);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_tunnel_id(uint64_t tunnel_id) {
+    return append_set_field_u64(rofl::openflow::OXM_TLV_BASIC_TUNNEL_ID,
+                                tunnel_id);
+  };
+
+  /**
+   *
+   */
+  cofactionbuf &append_set_field_ipv6_exthdr(uint16_t ipv6_exthdr) {
+    return append_set_field_u16(rofl::openflow::OXM_TLV_BASIC_IPV6_EXTHDR,
+                                ipv6_exthdr);
+  };
+
+public:
+  friend std::ostream &operator<<(std::ostream &os,
+                                  cofactionbuf const &actions) {
+    os << "<cofactionbuf ofp-version:" << (int)actions.get_version()
+       << " #actions: " << actions.size() << " length: " << actions.length()
+       << " >" << std::endl;
+    for (cofactionbuf::const_iterator it = actions.begin();
+         it != actions.end(); ++it) {
+      os << "<action type:0x" << std::hex << (int)it->get_type() << std::dec
+         << " length:" << (int)it->get_length() << " >" << std::endl;
+    }
+    return os;
+  };
+
+private:
+  /**
+   * @brief	Appends a zero-filled action of type and length and returns
+   * its start.
+   *
+   * @param of10 action is defined for OpenFlow 1.0 rather than 1.2+
+   * @exception eBadVersion action is not defined for ofp_version
+   */
+  uint8_t *append(uint16_t type, size_t len, bool of10 = false);
+
+  /**
+   *
+   */
+  cofactionbuf &append_dl_addr(uint16_t type, const rofl::caddress_ll &addr);
+
+  /**
+   *
+   */
+  cofactionbuf &append_nw_addr(uint16_t type, const rofl::caddress_in4 &addr);
+
+  /**
+   *
+   */
+  cofactionbuf &append_tp_port(uint16_t type, uint16_t tp_port);
+
+  /**
+   *
+   */
+  cofactionbuf &append_push(uint16_t type, uint16_t eth_type);
+
+  /**
+   *
+   */
+  cofactionbuf &append_exp(uint16_t type, uint32_t exp_id,
+                           const rofl::cmemory &exp_body, bool of10);
+
+private:
+  static const size_t DEFAULT_CAPACITY = 256;
+
+  uint8_t ofp_version;
+
+  // action list in wire format
+  std::vector<uint8_t> buf;
+
+  // number of actions in buf
+  size_t count;
+};
+
+}; // end of namespace openflow
+}; // end of namespace rofl
+
+#endif /* ROFL_COMMON_OPENFLOW_COFACTIONBUF_H */
@@ -20,7 +20,8 @@ void cofaggr_stats_request::pack(uint8_t *buf, size_t buflen) {
 
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < (sizeof(struct openflow12::ofp_flow_stats_request) -
                   sizeof(struct openflow12::ofp_match) + match.length()))
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
@@ -58,7 +59,8 @@ void cofaggr_stats_request::unpack(uint8_t *buf, size_t buflen) {
 
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < sizeof(struct openflow12::ofp_flow_stats_request))
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
@@ -86,7 +88,8 @@ size_t cofaggr_stats_request::length() const {
     return sizeof(struct openflow10::ofp_flow_stats_request);
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct openflow12::ofp_flow_stats_request) -
             sizeof(struct openflow12::ofp_match) + match.length());
   } break;
@@ -109,7 +112,8 @@ void cofaggr_stats_reply::pack(uint8_t *buf, size_t buflen) {
 
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < length())
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
@@ -139,7 +143,8 @@ void cofaggr_stats_reply::unpack(uint8_t *buf, size_t buflen) {
 
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < sizeof(struct openflow12::ofp_aggregate_stats_reply))
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
@@ -161,7 +166,8 @@ size_t cofaggr_stats_reply::length() const {
     return (sizeof(struct openflow10::ofp_aggregate_stats_reply));
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct openflow12::ofp_aggregate_stats_reply));
   } break;
   default:
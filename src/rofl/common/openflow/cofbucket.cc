@@ -11,7 +11,8 @@ uint8_t *cofbucket::pack(uint8_t *bucket, size_t bclen) {
   case openflow12::OFP_VERSION: {
     return pack_of12(bucket, bclen);
   } break;
-  case openflow13::OFP_VERSION: {
+  case openflow13::OFP_VERSION:
+  case openflow14::OFP_VERSION: {
     return pack_of13(bucket, bclen);
   } break;
   default:
@@ -24,7 +25,8 @@ void cofbucket::unpack(uint8_t *bucket, size_t bclen) {
   case openflow12::OFP_VERSION: {
     unpack_of12(bucket, bclen);
   } break;
-  case openflow13::OFP_VERSION: {
+  case openflow13::OFP_VERSION:
+  case openflow14::OFP_VERSION: {
     unpack_of13(bucket, bclen);
   } break;
   default:
@@ -224,7 +224,8 @@ public:
       os << "ofp-version:" << (int)bucket.ofp_version << " >" << std::endl;
     } break;
     case rofl::openflow12::OFP_VERSION:
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       os << "<cofbucket ";
       os << "ofp-version:" << (int)bucket.ofp_version << " >" << std::endl;
       os << std::hex;
@@ -18,7 +18,8 @@ size_t cofbucket_counter::length() const {
   case rofl::openflow12::OFP_VERSION: {
     return sizeof(struct rofl::openflow12::ofp_bucket_counter);
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return sizeof(struct rofl::openflow13::ofp_bucket_counter);
   } break;
   default: {
@@ -42,7 +43,8 @@ void cofbucket_counter::pack(uint8_t *buf, size_t buflen) {
     bc->packet_count = htobe64(packet_count);
     bc->byte_count = htobe64(byte_count);
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     struct rofl::openflow13::ofp_bucket_counter *bc =
         (struct rofl::openflow13::ofp_bucket_counter *)buf;
     bc->packet_count = htobe64(packet_count);
@@ -65,7 +67,8 @@ void cofbucket_counter::unpack(uint8_t *buf, size_t buflen) {
     packet_count = be64toh(bc->packet_count);
     byte_count = be64toh(bc->byte_count);
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     struct rofl::openflow13::ofp_bucket_counter *bc =
         (struct rofl::openflow13::ofp_bucket_counter *)buf;
     packet_count = be64toh(bc->packet_count);
@@ -26,6 +26,7 @@ uint8_t *cofbuckets::pack(uint8_t *buf, size_t buflen) {
   switch (ofp_version) {
   case openflow12::OFP_VERSION:
   case openflow13::OFP_VERSION:
+  case openflow14::OFP_VERSION:
     return pack_of13(buf, buflen);
   default:
     throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
@@ -36,6 +37,7 @@ void cofbuckets::unpack(uint8_t *buf, size_t buflen) {
   switch (ofp_version) {
   case openflow12::OFP_VERSION:
   case openflow13::OFP_VERSION:
+  case openflow14::OFP_VERSION:
     unpack_of13(buf, buflen);
     break;
   default:
@@ -225,7 +225,8 @@ public:
 
     } break;
     case rofl::openflow12::OFP_VERSION:
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       os << "<cofbuckets ofp-version:" << (int)buckets.ofp_version
          << " #buckets:" << buckets.buckets.size() << " >" << std::endl;
 
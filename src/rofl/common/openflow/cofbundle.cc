@@ -0,0 +1,154 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cofbundle.cc
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#include "rofl/common/openflow/cofbundle.h"
+#include "rofl/common/openflow/messages/cofmsg_flow_mod.h"
+#include "rofl/common/openflow/messages/cofmsg_group_mod.h"
+#include "rofl/common/openflow/messages/cofmsg_meter_mod.h"
+#include "rofl/common/openflow/messages/cofmsg_packed.h"
+
+using namespace rofl::openflow;
+
+cofbundle::cofbundle(uint8_t ofp_version, uint32_t bundle_id, uint16_t flags)
+    : ofp_version(ofp_version), bundle_id(bundle_id), flags(flags),
+      mem((size_t)0), used(0), msgs_num(0) {}
+
+cofbundle::cofbundle(const cofbundle &bundle)
+    : mem((size_t)0), used(0), msgs_num(0) {
+  *this = bundle;
+}
+
+cofbundle &cofbundle::operator=(const cofbundle &bundle) {
+  if (this == &bundle)
+    return *this;
+  ofp_version = bundle.ofp_version;
+  bundle_id = bundle.bundle_id;
+  flags = bundle.flags;
+  mem.assign(bundle.mem.somem(), bundle.used);
+  used = bundle.used;
+  msgs_num = bundle.msgs_num;
+  return *this;
+}
+
+cofbundle &cofbundle::set_bundle_id(uint32_t bundle_id) {
+  this->bundle_id = bundle_id;
+  for (size_t offset = 0; offset < used;) {
+    struct rofl::openflow14::ofp_bundle_add_msg *hdr =
+        (struct rofl::openflow14::ofp_bundle_add_msg *)(mem.somem() + offset);
+    hdr->bundle_id = htobe32(bundle_id);
+    offset += be16toh(hdr->header.length);
+  }
+  return *this;
+}
+
+cofbundle &cofbundle::set_flags(uint16_t flags) {
+  this->flags = flags;
+  for (size_t offset = 0; offset < used;) {
+    struct rofl::openflow14::ofp_bundle_add_msg *hdr =
+        (struct rofl::openflow14::ofp_bundle_add_msg *)(mem.somem() + offset);
+    hdr->flags = htobe16(flags);
+    offset += be16toh(hdr->header.length);
+  }
+  return *this;
+}
+
+cofbundle &cofbundle::add_flow_mod(const rofl::openflow::cofflowmod &flowmod) {
+  cofmsg_flow_mod msg(inner_version, 0, flowmod);
+  return add_message(msg);
+}
+
+cofbundle &
+cofbundle::add_group_mod(const rofl::openflow::cofgroupmod &groupmod) {
+  rofl::openflow::cofgroupmod gm(groupmod);
+  gm.set_version(inner_version);
+  cofmsg_group_mod msg(inner_version, 0, gm);
+  return add_message(msg);
+}
+
+cofbundle &
+cofbundle::add_meter_mod(uint16_t command, uint16_t flags, uint32_t meter_id,
+                         const rofl::openflow::cofmeter_bands &mbands) {
+  rofl::openflow::cofmeter_bands mbs(mbands);
+  mbs.set_version(inner_version);
+  cofmsg_meter_mod msg(inner_version, 0, command, flags, meter_id, mbs);
+  return add_message(msg);
+}
+
+cofbundle &cofbundle::add_message(rofl::openflow::cofmsg &msg) {
+  size_t msglen = msg.length();
+  uint8_t *buf = append(msglen);
+  msg.pack(buf, msglen);
+
+  struct rofl::openflow::ofp_header *hdr =
+      (struct rofl::openflow::ofp_header *)buf;
+  hdr->version = ofp_version;
+  hdr->xid = 0;
+  return *this;
+}
+
+size_t cofbundle::copy_message(size_t offset, uint8_t *buf, size_t buflen,
+                               uint32_t xid) const {
+  if ((offset + sizeof(struct rofl::openflow14::ofp_bundle_add_msg)) > used)
+    throw eInvalid("cofbundle::copy_message() invalid offset", __FILE__,
+                   __FUNCTION__, __LINE__);
+
+  struct rofl::openflow14::ofp_bundle_add_msg *src =
+      (struct rofl::openflow14::ofp_bundle_add_msg *)(mem.somem() + offset);
+  size_t msglen = be16toh(src->header.length);
+
+  if (buflen < msglen)
+    throw eInvalid("cofbundle::copy_message() buffer too small", __FILE__,
+                   __FUNCTION__, __LINE__);
+
+  memcpy(buf, src, msglen);
+
+  /* the inner message carries the Bundle-Add-Message's xid */
+  struct rofl::openflow14::ofp_bundle_add_msg *dst =
+      (struct rofl::openflow14::ofp_bundle_add_msg *)buf;
+  dst->header.xid = htobe32(xid);
+  dst->message.xid = htobe32(xid);
+
+  return msglen;
+}
+
+uint8_t *cofbundle::append(size_t msglen) {
+  size_t offset =
+      offsetof(struct rofl::openflow14::ofp_bundle_add_msg, message);
+  size_t total = offset + msglen;
+
+  if (msglen < sizeof(struct rofl::openflow::ofp_header))
+    throw eBundleInval("cofbundle::append() message too short");
+
+  if (total > cofmsg_packed::MAX_LENGTH)
+    throw eBundleInval("cofbundle::append() message too large");
+
+  if (mem.length() < (used + total)) {
+    size_t capacity = 2 * mem.length();
+    mem.resize((capacity < (used + total)) ? (used + total) : capacity);
+  }
+
+  struct rofl::openflow14::ofp_bundle_add_msg *hdr =
+      (struct rofl::openflow14::ofp_bundle_add_msg *)(mem.somem() + used);
+
+  memset(hdr, 0, offset);
+  hdr->header.version = ofp_version;
+  hdr->header.type = rofl::openflow14::OFPT_BUNDLE_ADD_MESSAGE;
+  hdr->header.length = htobe16(total);
+  hdr->header.xid = 0;
+  hdr->bundle_id = htobe32(bundle_id);
+  hdr->pad = 0;
+  hdr->flags = htobe16(flags);
+
+  used += total;
+  msgs_num++;
+
+  return mem.somem() + used - msglen;
+}
@@ -0,0 +1,215 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cofbundle.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#ifndef ROFL_COMMON_OPENFLOW_COFBUNDLE_H
+#define ROFL_COMMON_OPENFLOW_COFBUNDLE_H 1
+
+#include <endian.h>
+#include <inttypes.h>
+#include <iostream>
+#include <sstream>
+#include <stddef.h>
+
+#include "rofl/common/cmemory.h"
+#include "rofl/common/exception.hpp"
+#include "rofl/common/openflow/cofflowmod.h"
+#include "rofl/common/openflow/cofgroupmod.h"
+#include "rofl/common/openflow/cofmeterbands.h"
+#include "rofl/common/openflow/messages/cofmsg.h"
+
+namespace rofl {
+namespace openflow {
+
+class eBundleBase : public exception {
+public:
+  eBundleBase(const std::string &__arg = std::string(""))
+      : exception(__arg) {
+    set_exception("eBundleBase");
+  };
+};
+class eBundleInval : public eBundleBase {
+public:
+  eBundleInval(const std::string &__arg = std::string(""))
+      : eBundleBase(__arg) {
+    set_exception("eBundleInval");
+  };
+};
+
+/**
+ * @brief	Builder for the messages of an OpenFlow bundle.
+ *
+ * Flow-, group- and meter-mods added to the bundle are encoded once as
+ * complete Bundle-Add-Message messages and stored back to back in a
+ * single buffer. Transaction ids are assigned when the bundle is sent,
+ * see crofdpt::send_bundle().
+ */
+class cofbundle {
+public:
+  /**
+   *
+   */
+  ~cofbundle(){};
+
+  /**
+   *
+   */
+  cofbundle(uint8_t ofp_version = rofl::openflow14::OFP_VERSION,
+            uint32_t bundle_id = 0,
+            uint16_t flags = rofl::openflow14::OFPBF_ATOMIC);
+
+  /**
+   *
+   */
+  cofbundle(const cofbundle &bundle);
+
+  /**
+   *
+   */
+  cofbundle &operator=(const cofbundle &bundle);
+
+public:
+  /**
+   *
+   */
+  uint8_t get_version() const { return ofp_version; };
+
+  /**
+   *
+   */
+  uint32_t get_bundle_id() const { return bundle_id; };
+
+  /**
+   * @brief	Sets bundle id in all messages stored so far.
+   */
+  cofbundle &set_bundle_id(uint32_t bundle_id);
+
+  /**
+   *
+   */
+  uint16_t get_flags() const { return flags; };
+
+  /**
+   * @brief	Sets bundle flags in all messages stored so far.
+   */
+  cofbundle &set_flags(uint16_t flags);
+
+public:
+  /**
+   *
+   */
+  cofbundle &add_flow_mod(const rofl::openflow::cofflowmod &flowmod);
+
+  /**
+   *
+   */
+  cofbundle &add_group_mod(const rofl::openflow::cofgroupmod &groupmod);
+
+  /**
+   *
+   */
+  cofbundle &add_meter_mod(uint16_t command, uint16_t flags, uint32_t meter_id,
+                           const rofl::openflow::cofmeter_bands &mbands);
+
+  /**
+   * @brief	Adds an arbitrary message to the bundle.
+   *
+   * The message is packed in its own version, the version field of its
+   * header is rewritten to the bundle's version.
+   *
+   * @exception eBundleInval message exceeds maximum OpenFlow message size
+   */
+  cofbundle &add_message(rofl::openflow::cofmsg &msg);
+
+  /**
+   * @brief	Removes all messages from the bundle.
+   */
+  void clear() {
+    used = 0;
+    msgs_num = 0;
+  };
+
+public:
+  /**
+   * @brief	Returns number of messages in the bundle.
+   */
+  size_t size() const { return msgs_num; };
+
+  /**
+   *
+   */
+  bool empty() const { return (0 == msgs_num); };
+
+  /**
+   * @brief	Returns number of bytes occupied by all messages.
+   */
+  size_t length() const { return used; };
+
+  /**
+   * @brief	Returns start of Bundle-Add-Message messages packed back to back.
+   */
+  const uint8_t *somem() const { return mem.somem(); };
+
+  /**
+   * @brief	Copies the Bundle-Add-Message at offset into buf and assigns xid.
+   *
+   * @return length of the message copied
+   */
+  size_t copy_message(size_t offset, uint8_t *buf, size_t buflen,
+                      uint32_t xid) const;
+
+public:
+  friend std::ostream &operator<<(std::ostream &os, const cofbundle &bundle) {
+    os << "<cofbundle version: " << (int)bundle.get_version()
+       << " bundle-id: 0x" << std::hex << bundle.get_bundle_id()
+       << " flags: 0x" << bundle.get_flags() << std::dec
+       << " #msgs: " << bundle.size() << " bytes: " << bundle.length() << " >"
+       << std::endl;
+    return os;
+  };
+
+  std::string str() const {
+    std::stringstream ss;
+    ss << "<cofbundle bundle_id: " << bundle_id << " flags: " << flags
+       << " #msgs: " << msgs_num << " bytes: " << used << " >";
+    return ss.str();
+  };
+
+private:
+  /**
+   * @brief	Reserves space for a Bundle-Add-Message carrying msglen bytes.
+   *
+   * @return pointer to the inner message's start
+   */
+  uint8_t *append(size_t msglen);
+
+  /**
+   * @brief	Encoding used for inner messages.
+   *
+   * Flow-, group- and meter-mods of OpenFlow 1.4 share the wire format of
+   * OpenFlow 1.3.
+   */
+  static const uint8_t inner_version = rofl::openflow13::OFP_VERSION;
+
+private:
+  uint8_t ofp_version;
+  uint32_t bundle_id;
+  uint16_t flags;
+
+  // Bundle-Add-Message messages packed back to back
+  rofl::cmemory mem;
+  size_t used;
+  size_t msgs_num;
+};
+
+}; // end of namespace openflow
+}; // end of namespace rofl
+
+#endif /* ROFL_COMMON_OPENFLOW_COFBUNDLE_H */
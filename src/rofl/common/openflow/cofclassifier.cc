@@ -0,0 +1,635 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <algorithm>
+
+#include "rofl/common/openflow/cofclassifier.h"
+
+using namespace rofl::openflow;
+
+namespace {
+
+/* order of fields within keys and subtables: by stage, then by type */
+template <typename T> bool field_less(const T &lhs, const T &rhs) {
+  if (lhs.stage != rhs.stage)
+    return (lhs.stage < rhs.stage);
+  return (lhs.id < rhs.id);
+}
+
+/* appends output ports and group ids of an action list */
+void collect_outputs(const cofactions &actions, std::vector<uint32_t> &ports,
+                     std::vector<uint32_t> &groups) {
+  for (auto &it : actions.get_actions()) {
+    const cofaction &action = *(it.second);
+    switch (action.get_type()) {
+    case rofl::openflow::OFPAT_OUTPUT: {
+      ports.push_back(
+          dynamic_cast<const cofaction_output &>(action).get_port_no());
+    } break;
+    case rofl::openflow::OFPAT_GROUP: {
+      groups.push_back(
+          dynamic_cast<const cofaction_group &>(action).get_group_id());
+    } break;
+    default: {};
+    }
+  }
+}
+
+}; // end of anonymous namespace
+
+cofclassifier::ckey::ckey(const cofmatch &match) {
+  cofclassifier::canonicalize(match, fields, /*with_masks=*/false);
+}
+
+cofclassifier::~cofclassifier() {}
+
+cofclassifier::cofclassifier(uint8_t ofp_version)
+    : ofp_version(ofp_version), staged(false) {}
+
+void cofclassifier::canonicalize(const cofmatch &match,
+                                 std::vector<cfield> &fields,
+                                 bool with_masks) {
+  fields.clear();
+  for (auto &it : match.get_matches().get_matches()) {
+    rofl::cmemory mem(it.second->length());
+    it.second->pack(mem.somem(), mem.length());
+
+    uint32_t oxm_id = be32toh(*(uint32_t *)mem.somem());
+    bool hasmask = (oxm_id & 0x00000100);
+    size_t len = (oxm_id & 0x000000ff);
+    uint8_t *body = mem.somem() + sizeof(uint32_t);
+
+    cfield field;
+    field.id = (uint64_t)(oxm_id & 0xfffffe00) << 32;
+    if ((oxm_id >> 16) == rofl::openflow13::OFPXMC_EXPERIMENTER) {
+      if (len < sizeof(uint32_t))
+        throw eOxmBadLen("cofclassifier::canonicalize() experimenter OXM");
+      field.id |= be32toh(*(uint32_t *)body);
+      body += sizeof(uint32_t);
+      len -= sizeof(uint32_t);
+    }
+    if (mem.length() < sizeof(uint32_t) + (oxm_id & 0x000000ff))
+      throw eOxmBadLen("cofclassifier::canonicalize() invalid oxm_length");
+
+    size_t vlen = hasmask ? len / 2 : len;
+    field.stage = get_stage(field.id);
+    field.value.assign((const char *)body, vlen);
+    field.mask.assign(vlen, (char)0xff);
+    if (hasmask) {
+      bool wildcard = true;
+      for (size_t i = 0; i < vlen; i++) {
+        field.value[i] &= body[vlen + i];
+        if (with_masks)
+          field.mask[i] = body[vlen + i];
+        if (body[vlen + i])
+          wildcard = false;
+      }
+      /* an all-zero mask matches any value */
+      if (wildcard && with_masks)
+        continue;
+    }
+    fields.push_back(field);
+  }
+  std::sort(fields.begin(), fields.end(), field_less<cfield>);
+}
+
+uint8_t cofclassifier::get_stage(uint64_t id) {
+  if ((id >> 48) != rofl::openflow13::OFPXMC_OPENFLOW_BASIC)
+    return STAGE_METADATA;
+
+  switch ((id >> 41) & 0x7f) {
+  case rofl::openflow13::OFPXMT_OFB_IN_PORT:
+  case rofl::openflow13::OFPXMT_OFB_IN_PHY_PORT:
+  case rofl::openflow13::OFPXMT_OFB_METADATA:
+  case rofl::openflow13::OFPXMT_OFB_TUNNEL_ID:
+    return STAGE_METADATA;
+  case rofl::openflow13::OFPXMT_OFB_ETH_DST:
+  case rofl::openflow13::OFPXMT_OFB_ETH_SRC:
+  case rofl::openflow13::OFPXMT_OFB_ETH_TYPE:
+  case rofl::openflow13::OFPXMT_OFB_VLAN_VID:
+  case rofl::openflow13::OFPXMT_OFB_VLAN_PCP:
+  case rofl::openflow13::OFPXMT_OFB_MPLS_LABEL:
+  case rofl::openflow13::OFPXMT_OFB_MPLS_TC:
+  case rofl::openflow13::OFPXMT_OFB_MPLS_BOS:
+  case rofl::openflow13::OFPXMT_OFB_PBB_ISID:
+    return STAGE_L2;
+  case rofl::openflow13::OFPXMT_OFB_TCP_SRC:
+  case rofl::openflow13::OFPXMT_OFB_TCP_DST:
+  case rofl::openflow13::OFPXMT_OFB_UDP_SRC:
+  case rofl::openflow13::OFPXMT_OFB_UDP_DST:
+  case rofl::openflow13::OFPXMT_OFB_SCTP_SRC:
+  case rofl::openflow13::OFPXMT_OFB_SCTP_DST:
+  case rofl::openflow13::OFPXMT_OFB_ICMPV4_TYPE:
+  case rofl::openflow13::OFPXMT_OFB_ICMPV4_CODE:
+  case rofl::openflow13::OFPXMT_OFB_ICMPV6_TYPE:
+  case rofl::openflow13::OFPXMT_OFB_ICMPV6_CODE:
+  case rofl::openflow13::OFPXMT_OFB_IPV6_ND_TARGET:
+  case rofl::openflow13::OFPXMT_OFB_IPV6_ND_SLL:
+  case rofl::openflow13::OFPXMT_OFB_IPV6_ND_TLL:
+    return STAGE_L4;
+  default:
+    return STAGE_L3;
+  }
+}
+
+std::string cofclassifier::signature(const std::vector<cfield> &fields) {
+  std::string sig;
+  for (auto &field : fields) {
+    sig.append((const char *)&field.id, sizeof(field.id));
+    sig.push_back((char)field.mask.length());
+    sig.append(field.mask);
+  }
+  return sig;
+}
+
+std::string cofclassifier::masked_key(const std::vector<cfield> &fields) {
+  std::string key;
+  for (auto &field : fields) {
+    key.append(field.value);
+  }
+  return key;
+}
+
+bool cofclassifier::covers(const std::vector<cfield> &wildcard,
+                           const std::vector<cfield> &exact) {
+  /* every field in wildcard must be present in exact with a mask covering
+   * wildcard's mask and an identical value under wildcard's mask */
+  auto jt = exact.begin();
+  for (auto &field : wildcard) {
+    while ((jt != exact.end()) && field_less(*jt, field))
+      ++jt;
+    if ((jt == exact.end()) || (jt->id != field.id) ||
+        (jt->mask.length() != field.mask.length()))
+      return false;
+    for (size_t i = 0; i < field.mask.length(); i++) {
+      if ((jt->mask[i] & field.mask[i]) != field.mask[i])
+        return false;
+      if ((jt->value[i] & field.mask[i]) != field.value[i])
+        return false;
+    }
+  }
+  return true;
+}
+
+bool cofclassifier::overlaps(const std::vector<cfield> &lfields,
+                             const std::vector<cfield> &rfields) {
+  /* a single packet may match both, unless a common field differs under
+   * both masks */
+  auto jt = rfields.begin();
+  for (auto &field : lfields) {
+    while ((jt != rfields.end()) && field_less(*jt, field))
+      ++jt;
+    if ((jt == rfields.end()) || (jt->id != field.id) ||
+        (jt->mask.length() != field.mask.length()))
+      continue;
+    for (size_t i = 0; i < field.mask.length(); i++) {
+      char mask = jt->mask[i] & field.mask[i];
+      if ((jt->value[i] & mask) != (field.value[i] & mask))
+        return false;
+    }
+  }
+  return true;
+}
+
+uint8_t cofclassifier::get_table_id(const cofflowmod &flowmod) const {
+  /* OpenFlow 1.0 knows a single table only (from the controller's view) */
+  if (rofl::openflow10::OFP_VERSION == ofp_version)
+    return 0;
+  return flowmod.get_table_id();
+}
+
+bool cofclassifier::filter(const cofflowmod &flowmod, const cofflowmod &entry,
+                           bool check_out) const {
+  if ((flowmod.get_cookie() & flowmod.get_cookie_mask()) !=
+      (entry.get_cookie() & flowmod.get_cookie_mask()))
+    return false;
+
+  if (not check_out)
+    return true;
+
+  std::vector<uint32_t> ports;
+  std::vector<uint32_t> groups;
+  uint32_t out_port = flowmod.get_out_port();
+  uint32_t out_group = rofl::openflow::OFPG_ANY;
+
+  switch (ofp_version) {
+  case rofl::openflow10::OFP_VERSION: {
+    if (rofl::openflow10::OFPP_NONE == out_port)
+      out_port = rofl::openflow::OFPP_ANY;
+    if (rofl::openflow::OFPP_ANY != out_port)
+      collect_outputs(entry.get_actions(), ports, groups);
+  } break;
+  default: {
+    out_group = flowmod.get_out_group();
+    if ((rofl::openflow::OFPP_ANY == out_port) &&
+        (rofl::openflow::OFPG_ANY == out_group))
+      break;
+    const cofinstructions &instructions = entry.get_instructions();
+    if (instructions.has_inst_apply_actions())
+      collect_outputs(instructions.get_inst_apply_actions().get_actions(),
+                      ports, groups);
+    if (instructions.has_inst_write_actions())
+      collect_outputs(instructions.get_inst_write_actions().get_actions(),
+                      ports, groups);
+  };
+  }
+
+  if ((rofl::openflow::OFPP_ANY != out_port) &&
+      (std::find(ports.begin(), ports.end(), out_port) == ports.end()))
+    return false;
+  if ((rofl::openflow::OFPG_ANY != out_group) &&
+      (std::find(groups.begin(), groups.end(), out_group) == groups.end()))
+    return false;
+  return true;
+}
+
+std::shared_ptr<const cofflowmod>
+cofclassifier::stored(const cofflowmod &flowmod) const {
+  std::shared_ptr<cofflowmod> flow = std::make_shared<cofflowmod>(flowmod);
+  flow->set_command(rofl::openflow::OFPFC_ADD);
+  flow->set_table_id(get_table_id(flowmod));
+  flow->set_buffer_id(rofl::openflow::OFP_NO_BUFFER);
+  flow->set_cookie_mask(0);
+  return flow;
+}
+
+std::shared_ptr<const cofflowmod>
+cofclassifier::modified(const cofflowmod &entry,
+                        const cofflowmod &flowmod) const {
+  std::shared_ptr<cofflowmod> flow = std::make_shared<cofflowmod>(entry);
+  switch (ofp_version) {
+  case rofl::openflow10::OFP_VERSION: {
+    flow->set_actions(flowmod.get_actions());
+  } break;
+  default: { flow->set_instructions(flowmod.get_instructions()); };
+  }
+  return flow;
+}
+
+void cofclassifier::reorder(ctable &table) {
+  std::sort(table.ordered.begin(), table.ordered.end(),
+            [](const csubtable *lhs, const csubtable *rhs) {
+              return (lhs->max_priority > rhs->max_priority);
+            });
+}
+
+void cofclassifier::insert(ctable &table, const std::vector<cfield> &fields,
+                           std::shared_ptr<centry> entry) {
+  std::string sig = signature(fields);
+
+  csubtable *subtable = nullptr;
+  auto it = table.subtables.find(sig);
+  if (it == table.subtables.end()) {
+    subtable = new csubtable();
+    table.subtables[sig].reset(subtable);
+    subtable->fields = fields;
+    for (size_t i = 1; i < fields.size(); i++) {
+      if (fields[i].stage != fields[i - 1].stage)
+        subtable->stage_ends.push_back(i);
+    }
+    subtable->stage_keys.resize(subtable->stage_ends.size());
+    subtable->max_priority = entry->priority;
+    subtable->size = 0;
+    table.ordered.push_back(subtable);
+  } else {
+    subtable = it->second.get();
+  }
+
+  std::string key = masked_key(fields);
+  std::vector<std::shared_ptr<centry>> &bucket = subtable->buckets[key];
+
+  /* identical match and priority replaces the existing entry */
+  for (auto &e : bucket) {
+    if (e->priority == entry->priority) {
+      e = entry;
+      return;
+    }
+  }
+
+  bucket.insert(std::find_if(bucket.begin(), bucket.end(),
+                             [&entry](const std::shared_ptr<centry> &e) {
+                               return (e->priority < entry->priority);
+                             }),
+                entry);
+
+  if (bucket.size() == 1) {
+    size_t offset = 0;
+    size_t index = 0;
+    for (size_t stage = 0; stage < subtable->stage_ends.size(); stage++) {
+      for (; index < subtable->stage_ends[stage]; index++)
+        offset += fields[index].value.length();
+      subtable->stage_keys[stage][key.substr(0, offset)]++;
+    }
+  }
+
+  subtable->priorities[entry->priority]++;
+  subtable->size++;
+  table.size++;
+
+  if ((entry->priority > subtable->max_priority) || (subtable->size == 1)) {
+    subtable->max_priority = entry->priority;
+    reorder(table);
+  }
+}
+
+void cofclassifier::erase(ctable &table, const std::vector<cfield> &fields,
+                          uint16_t priority) {
+  auto it = table.subtables.find(signature(fields));
+  if (it == table.subtables.end())
+    return;
+  csubtable &subtable = *(it->second);
+
+  std::string key = masked_key(fields);
+  auto bt = subtable.buckets.find(key);
+  if (bt == subtable.buckets.end())
+    return;
+  std::vector<std::shared_ptr<centry>> &bucket = bt->second;
+
+  auto et = std::find_if(bucket.begin(), bucket.end(),
+                         [priority](const std::shared_ptr<centry> &e) {
+                           return (e->priority == priority);
+                         });
+  if (et == bucket.end())
+    return;
+  bucket.erase(et);
+
+  if (bucket.empty()) {
+    size_t offset = 0;
+    size_t index = 0;
+    for (size_t stage = 0; stage < subtable.stage_ends.size(); stage++) {
+      for (; index < subtable.stage_ends[stage]; index++)
+        offset += fields[index].value.length();
+      auto st = subtable.stage_keys[stage].find(key.substr(0, offset));
+      if (--(st->second) == 0)
+        subtable.stage_keys[stage].erase(st);
+    }
+    subtable.buckets.erase(bt);
+  }
+
+  if (--subtable.priorities[priority] == 0)
+    subtable.priorities.erase(priority);
+  subtable.size--;
+  table.size--;
+
+  if (subtable.size == 0) {
+    table.ordered.erase(
+        std::find(table.ordered.begin(), table.ordered.end(), &subtable));
+    table.subtables.erase(it);
+  } else if (subtable.max_priority != subtable.priorities.rbegin()->first) {
+    subtable.max_priority = subtable.priorities.rbegin()->first;
+    reorder(table);
+  }
+}
+
+size_t cofclassifier::add(const cofflowmod &flowmod) {
+  uint8_t table_id = get_table_id(flowmod);
+  if (rofl::openflow13::OFPTT_ALL == table_id)
+    throw eFlowClassifierBadTableId("cofclassifier::add() OFPTT_ALL");
+
+  std::shared_ptr<centry> entry = std::make_shared<centry>();
+  entry->priority = flowmod.get_priority();
+  canonicalize(flowmod.get_match(), entry->fields, /*with_masks=*/true);
+
+  ctable &table = tables[table_id];
+
+  if (flowmod.get_flags() & rofl::openflow::OFPFF_CHECK_OVERLAP) {
+    for (auto &it : table.subtables) {
+      const csubtable &subtable = *(it.second);
+      if (subtable.priorities.find(entry->priority) ==
+          subtable.priorities.end())
+        continue;
+      for (auto &bucket : subtable.buckets) {
+        for (auto &e : bucket.second) {
+          if ((e->priority == entry->priority) &&
+              overlaps(e->fields, entry->fields))
+            throw eFlowClassifierOverlap("cofclassifier::add() overlap");
+        }
+      }
+    }
+  }
+
+  entry->flow = stored(flowmod);
+  insert(table, entry->fields, entry);
+  return 1;
+}
+
+size_t cofclassifier::modify(const cofflowmod &flowmod, bool strict) {
+  uint8_t table_id = get_table_id(flowmod);
+  if (rofl::openflow13::OFPTT_ALL == table_id)
+    throw eFlowClassifierBadTableId("cofclassifier::modify() OFPTT_ALL");
+
+  std::vector<cfield> fields;
+  canonicalize(flowmod.get_match(), fields, /*with_masks=*/true);
+
+  size_t count = 0;
+  auto tt = tables.find(table_id);
+  if (tt != tables.end()) {
+    ctable &table = tt->second;
+    if (strict) {
+      auto it = table.subtables.find(signature(fields));
+      if (it != table.subtables.end()) {
+        auto bt = it->second->buckets.find(masked_key(fields));
+        if (bt != it->second->buckets.end()) {
+          for (auto &e : bt->second) {
+            if ((e->priority != flowmod.get_priority()) ||
+                (not filter(flowmod, *(e->flow), false)))
+              continue;
+            e->flow = modified(*(e->flow), flowmod);
+            count++;
+          }
+        }
+      }
+    } else {
+      for (auto &it : table.subtables) {
+        for (auto &bucket : it.second->buckets) {
+          for (auto &e : bucket.second) {
+            if ((not covers(fields, e->fields)) ||
+                (not filter(flowmod, *(e->flow), false)))
+              continue;
+            e->flow = modified(*(e->flow), flowmod);
+            count++;
+          }
+        }
+      }
+    }
+  }
+
+  /* OpenFlow 1.0 adds a missing entry on modify */
+  if ((0 == count) && (rofl::openflow10::OFP_VERSION == ofp_version)) {
+    return add(flowmod);
+  }
+  return count;
+}
+
+size_t
+cofclassifier::remove(const cofflowmod &flowmod, bool strict,
+                      std::vector<std::shared_ptr<const cofflowmod>> *removed) {
+  uint8_t table_id = get_table_id(flowmod);
+
+  std::vector<cfield> fields;
+  canonicalize(flowmod.get_match(), fields, /*with_masks=*/true);
+
+  size_t count = 0;
+  for (auto &tt : tables) {
+    if ((rofl::openflow13::OFPTT_ALL != table_id) && (tt.first != table_id))
+      continue;
+    ctable &table = tt.second;
+
+    std::vector<std::shared_ptr<centry>> victims;
+    if (strict) {
+      auto it = table.subtables.find(signature(fields));
+      if (it == table.subtables.end())
+        continue;
+      auto bt = it->second->buckets.find(masked_key(fields));
+      if (bt == it->second->buckets.end())
+        continue;
+      for (auto &e : bt->second) {
+        if ((e->priority == flowmod.get_priority()) &&
+            filter(flowmod, *(e->flow), true))
+          victims.push_back(e);
+      }
+    } else {
+      for (auto &it : table.subtables) {
+        for (auto &bucket : it.second->buckets) {
+          for (auto &e : bucket.second) {
+            if (covers(fields, e->fields) && filter(flowmod, *(e->flow), true))
+              victims.push_back(e);
+          }
+        }
+      }
+    }
+
+    for (auto &e : victims) {
+      erase(table, e->fields, e->priority);
+      if (removed)
+        removed->push_back(e->flow);
+      count++;
+    }
+  }
+  return count;
+}
+
+size_t cofclassifier::flow_mod(
+    const cofflowmod &flowmod,
+    std::vector<std::shared_ptr<const cofflowmod>> *removed) {
+  AcquireReadWriteLock rwlock(tables_lock);
+
+  if (flowmod.get_version() != ofp_version)
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+
+  switch (flowmod.get_command()) {
+  case rofl::openflow::OFPFC_ADD: {
+    return add(flowmod);
+  } break;
+  case rofl::openflow::OFPFC_MODIFY: {
+    return modify(flowmod, false);
+  } break;
+  case rofl::openflow::OFPFC_MODIFY_STRICT: {
+    return modify(flowmod, true);
+  } break;
+  case rofl::openflow::OFPFC_DELETE: {
+    return remove(flowmod, false, removed);
+  } break;
+  case rofl::openflow::OFPFC_DELETE_STRICT: {
+    return remove(flowmod, true, removed);
+  } break;
+  default:
+    throw eFlowClassifierBadCommand("cofclassifier::flow_mod() bad command");
+  }
+}
+
+std::shared_ptr<const cofflowmod>
+cofclassifier::lookup(uint8_t table_id, const ckey &key) const {
+  AcquireReadLock rwlock(tables_lock);
+
+  auto tt = tables.find(table_id);
+  if (tt == tables.end())
+    return std::shared_ptr<const cofflowmod>();
+
+  const centry *best = nullptr;
+  std::string buf;
+  for (const csubtable *subtable : tt->second.ordered) {
+    /* subtables are ordered by priority, nothing better to come */
+    if (best && (subtable->max_priority <= best->priority))
+      break;
+
+    buf.clear();
+    bool match = true;
+    size_t stage = 0;
+    auto jt = key.fields.begin();
+    for (size_t i = 0; i < subtable->fields.size(); i++) {
+      const cfield &field = subtable->fields[i];
+      while ((jt != key.fields.end()) && field_less(*jt, field))
+        ++jt;
+      if ((jt == key.fields.end()) || (jt->id != field.id) ||
+          (jt->value.length() != field.mask.length())) {
+        match = false;
+        break;
+      }
+      for (size_t k = 0; k < field.mask.length(); k++)
+        buf.push_back(jt->value[k] & field.mask[k]);
+
+      /* leave subtable early, if no entry shares the stages so far */
+      if (staged && (stage < subtable->stage_ends.size()) &&
+          (i + 1 == subtable->stage_ends[stage])) {
+        if (subtable->stage_keys[stage].find(buf) ==
+            subtable->stage_keys[stage].end()) {
+          match = false;
+          break;
+        }
+        stage++;
+      }
+    }
+    if (not match)
+      continue;
+
+    auto bt = subtable->buckets.find(buf);
+    if (bt == subtable->buckets.end())
+      continue;
+    const centry *entry = bt->second.front().get();
+    if ((nullptr == best) || (entry->priority > best->priority))
+      best = entry;
+  }
+
+  return best ? best->flow : std::shared_ptr<const cofflowmod>();
+}
+
+std::vector<std::shared_ptr<const cofflowmod>>
+cofclassifier::get_flows(uint8_t table_id) const {
+  AcquireReadLock rwlock(tables_lock);
+  std::vector<std::shared_ptr<const cofflowmod>> flows;
+  for (auto &tt : tables) {
+    if ((rofl::openflow13::OFPTT_ALL != table_id) && (tt.first != table_id))
+      continue;
+    for (auto &it : tt.second.subtables) {
+      for (auto &bucket : it.second->buckets) {
+        for (auto &e : bucket.second) {
+          flows.push_back(e->flow);
+        }
+      }
+    }
+  }
+  return flows;
+}
+
+size_t cofclassifier::size() const {
+  AcquireReadLock rwlock(tables_lock);
+  size_t size = 0;
+  for (auto &tt : tables) {
+    size += tt.second.size;
+  }
+  return size;
+}
+
+size_t cofclassifier::size(uint8_t table_id) const {
+  AcquireReadLock rwlock(tables_lock);
+  auto tt = tables.find(table_id);
+  return (tt == tables.end()) ? 0 : tt->second.size;
+}
+
+size_t cofclassifier::get_num_of_subtables(uint8_t table_id) const {
+  AcquireReadLock rwlock(tables_lock);
+  auto tt = tables.find(table_id);
+  return (tt == tables.end()) ? 0 : tt->second.subtables.size();
+}
@@ -0,0 +1,306 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef ROFL_COMMON_OPENFLOW_COFCLASSIFIER_H
+#define ROFL_COMMON_OPENFLOW_COFCLASSIFIER_H 1
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "rofl/common/exception.hpp"
+#include "rofl/common/locking.hpp"
+#include "rofl/common/openflow/cofflowmod.h"
+
+namespace rofl {
+namespace openflow {
+
+class eFlowClassifierBase : public exception {
+public:
+  eFlowClassifierBase(const std::string &__arg = std::string(""))
+      : exception(__arg) {
+    set_exception("eFlowClassifierBase");
+  };
+};
+class eFlowClassifierOverlap : public eFlowClassifierBase {
+public:
+  eFlowClassifierOverlap(const std::string &__arg = std::string(""))
+      : eFlowClassifierBase(__arg) {
+    set_exception("eFlowClassifierOverlap");
+  };
+};
+class eFlowClassifierBadTableId : public eFlowClassifierBase {
+public:
+  eFlowClassifierBadTableId(const std::string &__arg = std::string(""))
+      : eFlowClassifierBase(__arg) {
+    set_exception("eFlowClassifierBadTableId");
+  };
+};
+class eFlowClassifierBadCommand : public eFlowClassifierBase {
+public:
+  eFlowClassifierBadCommand(const std::string &__arg = std::string(""))
+      : eFlowClassifierBase(__arg) {
+    set_exception("eFlowClassifierBadCommand");
+  };
+};
+
+/**
+ * @brief	Software flow tables for datapath agents.
+ *
+ * Stores the Flow-Mods received from a controller in up to 256 flow
+ * tables and classifies packets against them. Each table performs a
+ * tuple space search: flow entries sharing the same set of OXM fields
+ * and masks are kept in a subtable, which is a hash table over the
+ * masked field values. A lookup probes the subtables in order of their
+ * highest priority and stops as soon as no remaining subtable can hold
+ * a flow entry with higher priority than the best match found so far.
+ *
+ * With staged lookup enabled, the fields of a subtable are grouped into
+ * the stages metadata, L2, L3 and L4. A subtable is left after the first
+ * stage whose masked values do not occur in any of its flow entries, so
+ * packets are not hashed over all fields of subtables they cannot match.
+ *
+ * Flow-Mods are applied with OpenFlow semantics: strict commands address
+ * a single entry by priority and match, non-strict commands address all
+ * entries whose match is at least as specific as the Flow-Mod's match.
+ * Deletions honour cookie, out_port and out_group restrictions. Flow
+ * entries are immutable once stored and returned as shared pointers,
+ * so they remain valid for the caller when being modified or removed
+ * concurrently. Packet and byte counters are left to the agent.
+ */
+class cofclassifier {
+public:
+  /**
+   * @brief	Header fields of a packet to be classified
+   *
+   * Built from a match with one OXM TLV per header field found in the
+   * packet, e.g., from a packet parser or a Packet-In's match. Masks,
+   * if any, are applied to the values.
+   */
+  class ckey {
+  public:
+    ckey(){};
+
+    ckey(const cofmatch &match);
+
+  private:
+    friend class cofclassifier;
+    struct cfield {
+      uint64_t id;
+      uint8_t stage;
+      std::string value;
+      std::string mask;
+    };
+    std::vector<cfield> fields;
+  };
+
+  /**
+   *
+   */
+  ~cofclassifier();
+
+  /**
+   *
+   */
+  cofclassifier(uint8_t ofp_version = rofl::openflow::OFP_VERSION_UNKNOWN);
+
+public:
+  /**
+   *
+   */
+  cofclassifier &set_version(uint8_t ofp_version) {
+    AcquireReadWriteLock rwlock(tables_lock);
+    if (this->ofp_version != ofp_version) {
+      tables.clear();
+    }
+    this->ofp_version = ofp_version;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint8_t get_version() const { return ofp_version; };
+
+  /**
+   * @brief	Enables or disables staged lookup
+   */
+  cofclassifier &set_staged_lookup(bool staged) {
+    AcquireReadWriteLock rwlock(tables_lock);
+    this->staged = staged;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  bool get_staged_lookup() const { return staged; };
+
+  /**
+   * @brief	Returns number of flow entries in all tables
+   */
+  size_t size() const;
+
+  /**
+   * @brief	Returns number of flow entries in a table
+   */
+  size_t size(uint8_t table_id) const;
+
+  /**
+   * @brief	Returns number of subtables, i.e., distinct field/mask sets
+   */
+  size_t get_num_of_subtables(uint8_t table_id) const;
+
+  /**
+   *
+   */
+  void clear() {
+    AcquireReadWriteLock rwlock(tables_lock);
+    tables.clear();
+  };
+
+public:
+  /**
+   * @brief	Applies a Flow-Mod received from a controller.
+   *
+   * @param flowmod Flow-Mod to be applied
+   * @param removed if not null, receives the entries deleted by a
+   * delete command, e.g., for sending Flow-Removed messages
+   * @return number of flow entries added, modified or deleted
+   * @exception eFlowClassifierOverlap OFPFF_CHECK_OVERLAP is set and an
+   * entry with equal priority overlaps the new entry
+   * @exception eFlowClassifierBadTableId invalid table_id for an add
+   * @exception eFlowClassifierBadCommand unknown command
+   * @exception eBadVersion Flow-Mod does not match this classifier's version
+   */
+  size_t flow_mod(
+      const cofflowmod &flowmod,
+      std::vector<std::shared_ptr<const cofflowmod>> *removed = nullptr);
+
+  /**
+   * @brief	Returns the highest priority flow entry matching a packet
+   *
+   * @return matching flow entry or null on table miss
+   */
+  std::shared_ptr<const cofflowmod> lookup(uint8_t table_id,
+                                           const ckey &key) const;
+
+  /**
+   * @brief	Returns all flow entries of a table or all tables (OFPTT_ALL)
+   */
+  std::vector<std::shared_ptr<const cofflowmod>>
+  get_flows(uint8_t table_id = rofl::openflow13::OFPTT_ALL) const;
+
+public:
+  friend std::ostream &operator<<(std::ostream &os,
+                                  cofclassifier const &classifier) {
+    AcquireReadLock rwlock(classifier.tables_lock);
+    os << "<cofclassifier ofp-version:" << (int)classifier.ofp_version
+       << " #tables: " << classifier.tables.size() << " >" << std::endl;
+    for (auto &it : classifier.tables) {
+      os << "<table " << (int)it.first << " #flows: " << it.second.size
+         << " #subtables: " << it.second.subtables.size() << " >"
+         << std::endl;
+    }
+    return os;
+  };
+
+private:
+  typedef ckey::cfield cfield;
+
+  enum cofclassifier_stage_t {
+    STAGE_METADATA = 0,
+    STAGE_L2 = 1,
+    STAGE_L3 = 2,
+    STAGE_L4 = 3,
+  };
+
+  struct centry {
+    uint16_t priority;
+    std::vector<cfield> fields;
+    std::shared_ptr<const cofflowmod> flow;
+  };
+
+  /* flow entries with identical fields and masks */
+  struct csubtable {
+    // fields and masks, ordered by stage
+    std::vector<cfield> fields;
+    // number of fields up to and including each but the last stage
+    std::vector<size_t> stage_ends;
+    // masked values of stages preceding the last one, reference counted
+    std::vector<std::unordered_map<std::string, unsigned int>> stage_keys;
+    // masked values => entries with identical match, highest priority first
+    std::unordered_map<std::string, std::vector<std::shared_ptr<centry>>>
+        buckets;
+    // priorities in use, reference counted
+    std::map<uint16_t, unsigned int> priorities;
+    uint16_t max_priority;
+    size_t size;
+  };
+
+  struct ctable {
+    ctable() : size(0){};
+    std::unordered_map<std::string, std::unique_ptr<csubtable>> subtables;
+    // subtables ordered by their highest priority
+    std::vector<csubtable *> ordered;
+    size_t size;
+  };
+
+  static void canonicalize(const cofmatch &match, std::vector<cfield> &fields,
+                           bool with_masks);
+
+  static uint8_t get_stage(uint64_t id);
+
+  static std::string signature(const std::vector<cfield> &fields);
+
+  static std::string masked_key(const std::vector<cfield> &fields);
+
+  static bool covers(const std::vector<cfield> &wildcard,
+                     const std::vector<cfield> &exact);
+
+  static bool overlaps(const std::vector<cfield> &lfields,
+                       const std::vector<cfield> &rfields);
+
+  bool filter(const cofflowmod &flowmod, const cofflowmod &entry,
+              bool check_out) const;
+
+  std::shared_ptr<const cofflowmod> stored(const cofflowmod &flowmod) const;
+
+  std::shared_ptr<const cofflowmod>
+  modified(const cofflowmod &entry, const cofflowmod &flowmod) const;
+
+  size_t add(const cofflowmod &flowmod);
+
+  size_t modify(const cofflowmod &flowmod, bool strict);
+
+  size_t remove(const cofflowmod &flowmod, bool strict,
+                std::vector<std::shared_ptr<const cofflowmod>> *removed);
+
+  void insert(ctable &table, const std::vector<cfield> &fields,
+              std::shared_ptr<centry> entry);
+
+  void erase(ctable &table, const std::vector<cfield> &fields,
+             uint16_t priority);
+
+  static void reorder(ctable &table);
+
+  uint8_t get_table_id(const cofflowmod &flowmod) const;
+
+private:
+  uint8_t ofp_version;
+
+  bool staged;
+
+  std::map<uint8_t, ctable> tables;
+
+  mutable rofl::crwlock tables_lock;
+};
+
+}; // end of namespace openflow
+}; // end of namespace rofl
+
+#endif /* ROFL_COMMON_OPENFLOW_COFCLASSIFIER_H */
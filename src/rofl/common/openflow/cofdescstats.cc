@@ -14,7 +14,8 @@ size_t cofdesc_stats_reply::length() const {
   case rofl::openflow12::OFP_VERSION: {
     return (sizeof(struct openflow12::ofp_desc_stats));
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct openflow13::ofp_desc));
   } break;
   default:
@@ -40,7 +41,8 @@ void cofdesc_stats_reply::pack(uint8_t *buf, size_t buflen) const {
     snprintf(desc->dp_desc, DESC_STR_LEN, dp_desc.c_str(), dp_desc.length());
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < sizeof(struct openflow12::ofp_desc_stats))
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
@@ -76,7 +78,8 @@ void cofdesc_stats_reply::unpack(uint8_t *buf, size_t buflen) {
 
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < sizeof(struct openflow12::ofp_desc_stats))
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
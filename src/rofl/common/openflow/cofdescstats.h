@@ -192,7 +192,8 @@ public:
 
     } break;
     case rofl::openflow12::OFP_VERSION:
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       os << "<cofdesc_stats_reply ofp-version:" << (int)reply.get_version()
          << " >" << std::endl;
       os << "<mfr-desc: " << reply.mfr_desc << " >" << std::endl;
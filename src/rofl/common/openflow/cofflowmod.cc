@@ -14,7 +14,8 @@ void cofflowmod::check_prerequisites() const {
     actions.check_prerequisites();
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     instructions.check_prerequisites();
   } break;
   default:
@@ -28,7 +29,8 @@ size_t cofflowmod::length() const {
     return (sizeof(struct ofp10_flow_mod) + actions.length());
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct ofp13_flow_mod) + match.length() +
             instructions.length());
   } break;
@@ -65,7 +67,8 @@ void cofflowmod::pack(uint8_t *buf, size_t buflen) {
 
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct ofp13_flow_mod *hdr = (struct ofp13_flow_mod *)buf;
 
@@ -127,7 +130,8 @@ void cofflowmod::unpack(uint8_t *buf, size_t buflen) {
 
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     if (buflen < sizeof(struct ofp13_flow_mod))
       throw eInvalid("cofflowmod::unpack() buflen too short", __FILE__,
@@ -378,7 +378,8 @@ public:
       os << fe.get_actions();
     } break;
     case rofl::openflow12::OFP_VERSION:
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       os << fe.get_instructions();
     } break;
     }
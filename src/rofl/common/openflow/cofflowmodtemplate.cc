@@ -0,0 +1,394 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "rofl/common/openflow/cofflowmodtemplate.h"
+
+using namespace rofl::openflow;
+
+void cofflowmodtemplate::compile(const cofflowmod &flowmod, uint32_t xid) {
+  cofflowmod fe(flowmod);
+
+  oxms.clear();
+  outputs.clear();
+
+  size_t msglen = sizeof(struct rofl::openflow::ofp_header) + fe.length();
+
+  if (msglen > 65535)
+    throw eFlowModTemplateInval("cofflowmodtemplate::compile() flowmod "
+                                "exceeds maximum message size");
+
+  image = rofl::cmemory(msglen);
+  ofp_version = fe.get_version();
+
+  struct rofl::openflow::ofp_header *hdr =
+      (struct rofl::openflow::ofp_header *)image.somem();
+
+  hdr->version = ofp_version;
+  hdr->type = rofl::openflow::OFPT_FLOW_MOD;
+  hdr->length = htobe16(msglen);
+  hdr->xid = htobe32(xid);
+
+  fe.pack(hdr->body, fe.length());
+
+  switch (ofp_version) {
+  case rofl::openflow10::OFP_VERSION: {
+
+    compile_match10(offsetof(struct rofl::openflow10::ofp_flow_mod, match));
+
+    compile_actions(sizeof(struct rofl::openflow10::ofp_flow_mod), msglen);
+
+  } break;
+  case rofl::openflow12::OFP_VERSION:
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
+
+    size_t match_offset =
+        offsetof(struct rofl::openflow13::ofp_flow_mod, match);
+    size_t matchlen = be16toh(*(uint16_t *)(image.somem() + match_offset + 2));
+    size_t offset = match_offset + 4;
+    size_t end = match_offset + matchlen;
+
+    /* OXM TLVs */
+    while (offset < end) {
+      if ((end - offset) < sizeof(uint32_t))
+        throw eFlowModTemplateInval("cofflowmodtemplate::compile() "
+                                    "truncated OXM TLV");
+
+      uint32_t oxm_tlv = be32toh(*(uint32_t *)(image.somem() + offset));
+      size_t oxm_len = oxm_tlv & 0x000000ff;
+      uint16_t oxm_class = oxm_tlv >> 16;
+
+      if ((end - offset - sizeof(uint32_t)) < oxm_len)
+        throw eFlowModTemplateInval("cofflowmodtemplate::compile() "
+                                    "truncated OXM TLV");
+
+      patch_t p;
+      p.offset = offset + sizeof(uint32_t);
+      p.length = oxm_len;
+      p.mask_offset = 0;
+
+      /* skip experimenter identifier */
+      if (oxm_class == rofl::openflow13::OFPXMC_EXPERIMENTER) {
+        if (p.length < sizeof(uint32_t))
+          throw eFlowModTemplateInval("cofflowmodtemplate::compile() "
+                                      "truncated experimenter OXM TLV");
+        p.offset += sizeof(uint32_t);
+        p.length -= sizeof(uint32_t);
+      }
+
+      if (oxm_tlv & HAS_MASK_FLAG) {
+        p.length /= 2;
+        p.mask_offset = p.offset + p.length;
+      }
+
+      if (oxms.find(oxm_tlv) == oxms.end()) {
+        oxms[oxm_tlv] = p;
+      }
+
+      offset += sizeof(uint32_t) + oxm_len;
+    }
+
+    /* instructions follow the padded match structure */
+    offset = match_offset + ((matchlen + 7) / 8) * 8;
+
+    while (offset < msglen) {
+      if ((msglen - offset) < sizeof(struct rofl::openflow13::ofp_instruction))
+        throw eFlowModTemplateInval("cofflowmodtemplate::compile() "
+                                    "truncated instruction");
+
+      struct rofl::openflow13::ofp_instruction *inst =
+          (struct rofl::openflow13::ofp_instruction *)(image.somem() + offset);
+
+      size_t instlen = be16toh(inst->len);
+
+      if ((instlen < sizeof(struct rofl::openflow13::ofp_instruction)) ||
+          (instlen > (msglen - offset)))
+        throw eFlowModTemplateInval("cofflowmodtemplate::compile() "
+                                    "invalid instruction length");
+
+      switch (be16toh(inst->type)) {
+      case rofl::openflow13::OFPIT_WRITE_ACTIONS:
+      case rofl::openflow13::OFPIT_APPLY_ACTIONS: {
+        compile_actions(
+            offset + sizeof(struct rofl::openflow13::ofp_instruction_actions),
+            offset + instlen);
+      } break;
+      default: {};
+      }
+
+      offset += instlen;
+    }
+
+  } break;
+  default:
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+  }
+}
+
+void cofflowmodtemplate::compile_match10(size_t match_offset) {
+  struct rofl::openflow10::ofp_match *m =
+      (struct rofl::openflow10::ofp_match *)(image.somem() + match_offset);
+  uint32_t wildcards = be32toh(m->wildcards);
+
+  /* OF1.0 match fields and the OXM TLVs cofmatch packs them from, all of
+   * them share their encoding with the OXM value */
+  struct field10_t {
+    uint32_t wildcard;
+    uint32_t oxm_tlv;
+    size_t offset;
+    size_t length;
+  };
+  static const field10_t fields[] = {
+      {rofl::openflow10::OFPFW_DL_SRC, rofl::openflow::OXM_TLV_BASIC_ETH_SRC,
+       offsetof(struct rofl::openflow10::ofp_match, dl_src), OFP_ETH_ALEN},
+      {rofl::openflow10::OFPFW_DL_DST, rofl::openflow::OXM_TLV_BASIC_ETH_DST,
+       offsetof(struct rofl::openflow10::ofp_match, dl_dst), OFP_ETH_ALEN},
+      {rofl::openflow10::OFPFW_DL_VLAN,
+       rofl::openflow::OXM_TLV_BASIC_VLAN_VID,
+       offsetof(struct rofl::openflow10::ofp_match, dl_vlan),
+       sizeof(uint16_t)},
+      {rofl::openflow10::OFPFW_DL_VLAN_PCP,
+       rofl::openflow::OXM_TLV_BASIC_VLAN_PCP,
+       offsetof(struct rofl::openflow10::ofp_match, dl_vlan_pcp),
+       sizeof(uint8_t)},
+      {rofl::openflow10::OFPFW_DL_TYPE, rofl::openflow::OXM_TLV_BASIC_ETH_TYPE,
+       offsetof(struct rofl::openflow10::ofp_match, dl_type),
+       sizeof(uint16_t)},
+      {rofl::openflow10::OFPFW_NW_TOS,
+       (uint32_t)rofl::openflow::experimental::OXM_TLV_EXPR_NW_TOS,
+       offsetof(struct rofl::openflow10::ofp_match, nw_tos), sizeof(uint8_t)},
+      {rofl::openflow10::OFPFW_NW_PROTO,
+       (uint32_t)rofl::openflow::experimental::OXM_TLV_EXPR_NW_PROTO,
+       offsetof(struct rofl::openflow10::ofp_match, nw_proto),
+       sizeof(uint8_t)},
+      /* IPv4 addresses qualify only when matched exactly */
+      {rofl::openflow10::OFPFW_NW_SRC_MASK,
+       (uint32_t)rofl::openflow::experimental::OXM_TLV_EXPR_NW_SRC,
+       offsetof(struct rofl::openflow10::ofp_match, nw_src),
+       sizeof(uint32_t)},
+      {rofl::openflow10::OFPFW_NW_DST_MASK,
+       (uint32_t)rofl::openflow::experimental::OXM_TLV_EXPR_NW_DST,
+       offsetof(struct rofl::openflow10::ofp_match, nw_dst),
+       sizeof(uint32_t)},
+      {rofl::openflow10::OFPFW_TP_SRC,
+       (uint32_t)rofl::openflow::experimental::OXM_TLV_EXPR_TP_SRC,
+       offsetof(struct rofl::openflow10::ofp_match, tp_src),
+       sizeof(uint16_t)},
+      {rofl::openflow10::OFPFW_TP_DST,
+       (uint32_t)rofl::openflow::experimental::OXM_TLV_EXPR_TP_DST,
+       offsetof(struct rofl::openflow10::ofp_match, tp_dst),
+       sizeof(uint16_t)},
+  };
+
+  for (const field10_t &field : fields) {
+    if (wildcards & field.wildcard)
+      continue;
+    patch_t p;
+    p.offset = match_offset + field.offset;
+    p.length = field.length;
+    p.mask_offset = 0;
+    oxms[field.oxm_tlv] = p;
+  }
+}
+
+void cofflowmodtemplate::compile_actions(size_t offset, size_t end) {
+  while (offset < end) {
+    if ((end - offset) < sizeof(struct rofl::openflow13::ofp_action_header))
+      throw eFlowModTemplateInval("cofflowmodtemplate::compile() "
+                                  "truncated action");
+
+    struct rofl::openflow13::ofp_action_header *action =
+        (struct rofl::openflow13::ofp_action_header *)(image.somem() + offset);
+
+    size_t actionlen = be16toh(action->len);
+
+    if ((actionlen < sizeof(struct rofl::openflow13::ofp_action_header)) ||
+        (actionlen > (end - offset)))
+      throw eFlowModTemplateInval("cofflowmodtemplate::compile() "
+                                  "invalid action length");
+
+    /* OFPAT_OUTPUT is 0 for all versions, port follows type and length */
+    if (be16toh(action->type) == rofl::openflow::OFPAT_OUTPUT) {
+      outputs.push_back(offset + 2 * sizeof(uint16_t));
+    }
+
+    offset += actionlen;
+  }
+}
+
+void cofflowmodtemplate::pack(uint8_t *buf, size_t buflen) const {
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  if (buflen < image.length())
+    throw eInvalid("cofflowmodtemplate::pack() buflen too short", __FILE__,
+                   __FUNCTION__, __LINE__);
+
+  memcpy(buf, image.somem(), image.length());
+}
+
+void cofflowmodtemplate::patch(size_t offset, const void *data,
+                               size_t datalen) {
+  if ((offset + datalen) > image.length())
+    throw eFlowModTemplateInval("cofflowmodtemplate::patch() offset out of "
+                                "range, template not compiled?");
+
+  memcpy(image.somem() + offset, data, datalen);
+}
+
+void cofflowmodtemplate::check_version_of13() const {
+  switch (ofp_version) {
+  case rofl::openflow12::OFP_VERSION:
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
+    /* do nothing */
+  } break;
+  default:
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+  }
+}
+
+cofflowmodtemplate &cofflowmodtemplate::set_cookie(uint64_t cookie) {
+  cookie = htobe64(cookie);
+  switch (ofp_version) {
+  case rofl::openflow10::OFP_VERSION: {
+    patch(offsetof(struct rofl::openflow10::ofp_flow_mod, cookie), &cookie,
+          sizeof(cookie));
+  } break;
+  default: {
+    check_version_of13();
+    patch(offsetof(struct rofl::openflow13::ofp_flow_mod, cookie), &cookie,
+          sizeof(cookie));
+  };
+  }
+  return *this;
+}
+
+cofflowmodtemplate &cofflowmodtemplate::set_table_id(uint8_t table_id) {
+  check_version_of13();
+  patch(offsetof(struct rofl::openflow13::ofp_flow_mod, table_id), &table_id,
+        sizeof(table_id));
+  return *this;
+}
+
+cofflowmodtemplate &
+cofflowmodtemplate::set_idle_timeout(uint16_t idle_timeout) {
+  idle_timeout = htobe16(idle_timeout);
+  switch (ofp_version) {
+  case rofl::openflow10::OFP_VERSION: {
+    patch(offsetof(struct rofl::openflow10::ofp_flow_mod, idle_timeout),
+          &idle_timeout, sizeof(idle_timeout));
+  } break;
+  default: {
+    check_version_of13();
+    patch(offsetof(struct rofl::openflow13::ofp_flow_mod, idle_timeout),
+          &idle_timeout, sizeof(idle_timeout));
+  };
+  }
+  return *this;
+}
+
+cofflowmodtemplate &
+cofflowmodtemplate::set_hard_timeout(uint16_t hard_timeout) {
+  hard_timeout = htobe16(hard_timeout);
+  switch (ofp_version) {
+  case rofl::openflow10::OFP_VERSION: {
+    patch(offsetof(struct rofl::openflow10::ofp_flow_mod, hard_timeout),
+          &hard_timeout, sizeof(hard_timeout));
+  } break;
+  default: {
+    check_version_of13();
+    patch(offsetof(struct rofl::openflow13::ofp_flow_mod, hard_timeout),
+          &hard_timeout, sizeof(hard_timeout));
+  };
+  }
+  return *this;
+}
+
+cofflowmodtemplate &cofflowmodtemplate::set_priority(uint16_t priority) {
+  priority = htobe16(priority);
+  switch (ofp_version) {
+  case rofl::openflow10::OFP_VERSION: {
+    patch(offsetof(struct rofl::openflow10::ofp_flow_mod, priority), &priority,
+          sizeof(priority));
+  } break;
+  default: {
+    check_version_of13();
+    patch(offsetof(struct rofl::openflow13::ofp_flow_mod, priority), &priority,
+          sizeof(priority));
+  };
+  }
+  return *this;
+}
+
+cofflowmodtemplate &cofflowmodtemplate::set_buffer_id(uint32_t buffer_id) {
+  buffer_id = htobe32(buffer_id);
+  switch (ofp_version) {
+  case rofl::openflow10::OFP_VERSION: {
+    patch(offsetof(struct rofl::openflow10::ofp_flow_mod, buffer_id),
+          &buffer_id, sizeof(buffer_id));
+  } break;
+  default: {
+    check_version_of13();
+    patch(offsetof(struct rofl::openflow13::ofp_flow_mod, buffer_id),
+          &buffer_id, sizeof(buffer_id));
+  };
+  }
+  return *this;
+}
+
+cofflowmodtemplate &cofflowmodtemplate::set_output_port(unsigned int index,
+                                                        uint32_t port_no) {
+  if (index >= outputs.size())
+    throw eFlowModTemplateNotFound("cofflowmodtemplate::set_output_port() "
+                                   "output action not found");
+
+  switch (ofp_version) {
+  case rofl::openflow10::OFP_VERSION: {
+    uint16_t port = htobe16((uint16_t)(port_no & 0x0000ffff));
+    patch(outputs[index], &port, sizeof(port));
+  } break;
+  default: {
+    uint32_t port = htobe32(port_no);
+    patch(outputs[index], &port, sizeof(port));
+  };
+  }
+  return *this;
+}
+
+cofflowmodtemplate &cofflowmodtemplate::set_oxm(uint32_t oxm_tlv,
+                                                const uint8_t *value,
+                                                size_t valuelen,
+                                                const uint8_t *mask) {
+  std::map<uint32_t, patch_t>::const_iterator it = oxms.find(oxm_tlv);
+  if (it == oxms.end())
+    throw eFlowModTemplateNotFound("cofflowmodtemplate::set_oxm() OXM TLV "
+                                   "not found in match");
+
+  const patch_t &p = it->second;
+
+  if (valuelen != p.length)
+    throw eFlowModTemplateInval("cofflowmodtemplate::set_oxm() invalid "
+                                "value length");
+
+  if ((mask != nullptr) && (0 == p.mask_offset))
+    throw eFlowModTemplateInval("cofflowmodtemplate::set_oxm() OXM TLV "
+                                "has no mask");
+
+  patch(p.offset, value, valuelen);
+
+  if (0 == p.mask_offset)
+    return *this;
+
+  if (mask != nullptr)
+    patch(p.mask_offset, mask, valuelen);
+
+  /* no value bits outside of the field's mask, see OpenFlow 1.3 A.2.3.5 */
+  uint8_t *v = image.somem() + p.offset;
+  const uint8_t *m = image.somem() + p.mask_offset;
+  for (size_t i = 0; i < valuelen; i++) {
+    v[i] &= m[i];
+  }
+  return *this;
+}
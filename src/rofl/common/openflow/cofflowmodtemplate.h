@@ -0,0 +1,283 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef ROFL_COMMON_OPENFLOW_COFFLOWMODTEMPLATE_H
+#define ROFL_COMMON_OPENFLOW_COFFLOWMODTEMPLATE_H 1
+
+#include <endian.h>
+#include <map>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+#include "rofl/common/cmemory.h"
+#include "rofl/common/exception.hpp"
+#include "rofl/common/openflow/cofflowmod.h"
+
+namespace rofl {
+namespace openflow {
+
+class eFlowModTemplateBase : public exception {
+public:
+  eFlowModTemplateBase(const std::string &__arg = std::string(""))
+      : exception(__arg) {
+    set_exception("eFlowModTemplateBase");
+  };
+};
+class eFlowModTemplateInval : public eFlowModTemplateBase {
+public:
+  eFlowModTemplateInval(const std::string &__arg = std::string(""))
+      : eFlowModTemplateBase(__arg) {
+    set_exception("eFlowModTemplateInval");
+  };
+};
+class eFlowModTemplateNotFound : public eFlowModTemplateBase {
+public:
+  eFlowModTemplateNotFound(const std::string &__arg = std::string(""))
+      : eFlowModTemplateBase(__arg) {
+    set_exception("eFlowModTemplateNotFound");
+  };
+};
+
+/**
+ * @brief	Precompiled Flow-Mod message in wire format.
+ *
+ * A template is compiled once from a cofflowmod instance. Compilation
+ * packs the complete OFPT_FLOW_MOD message including its OpenFlow
+ * header and records the offsets of all patchable fields: the fixed
+ * header fields, the value of each OXM TLV contained in the match and
+ * the port of each output action. Instances are generated by patching
+ * these fields in place and copying the image via pack().
+ *
+ * OpenFlow 1.0 has no OXM TLVs. Its templates expose each non-wildcarded
+ * match field under the OXM TLV header cofmatch packs it from: the
+ * OpenFlow basic TLVs for the Ethernet and VLAN fields and the OFX
+ * experimental TLVs for the network and transport fields. IPv4 addresses
+ * are exposed only when matched exactly and in_port cannot be patched.
+ *
+ * Patching modifies the template itself, so a template must not be
+ * shared among threads without external locking.
+ */
+class cofflowmodtemplate {
+public:
+  /**
+   *
+   */
+  ~cofflowmodtemplate(){};
+
+  /**
+   *
+   */
+  cofflowmodtemplate() : ofp_version(rofl::openflow::OFP_VERSION_UNKNOWN){};
+
+  /**
+   * @brief	Compiles flowmod into a new template.
+   *
+   * @param flowmod flow mod entry, its version defines the template version
+   * @param xid initial transaction identifier
+   */
+  cofflowmodtemplate(const cofflowmod &flowmod, uint32_t xid = 0)
+      : ofp_version(rofl::openflow::OFP_VERSION_UNKNOWN) {
+    compile(flowmod, xid);
+  };
+
+  /**
+   *
+   */
+  cofflowmodtemplate(const cofflowmodtemplate &tmpl) { *this = tmpl; };
+
+  /**
+   *
+   */
+  cofflowmodtemplate &operator=(const cofflowmodtemplate &tmpl) {
+    if (this == &tmpl)
+      return *this;
+    ofp_version = tmpl.ofp_version;
+    image = tmpl.image;
+    oxms = tmpl.oxms;
+    outputs = tmpl.outputs;
+    return *this;
+  };
+
+public:
+  /**
+   * @brief	Replaces the current image with flowmod in packed state.
+   */
+  void compile(const cofflowmod &flowmod, uint32_t xid = 0);
+
+  /**
+   * @brief	Returns length of the Flow-Mod message including its header.
+   */
+  size_t length() const { return image.length(); };
+
+  /**
+   * @brief	Copies the current image into buf.
+   */
+  void pack(uint8_t *buf, size_t buflen) const;
+
+  /**
+   *
+   */
+  uint8_t get_version() const { return ofp_version; };
+
+public:
+  /**
+   *
+   */
+  cofflowmodtemplate &set_xid(uint32_t xid) {
+    xid = htobe32(xid);
+    patch(offsetof(struct rofl::openflow::ofp_header, xid), &xid, sizeof(xid));
+    return *this;
+  };
+
+  /**
+   *
+   */
+  cofflowmodtemplate &set_cookie(uint64_t cookie);
+
+  /**
+   *
+   */
+  cofflowmodtemplate &set_table_id(uint8_t table_id);
+
+  /**
+   *
+   */
+  cofflowmodtemplate &set_idle_timeout(uint16_t idle_timeout);
+
+  /**
+   *
+   */
+  cofflowmodtemplate &set_hard_timeout(uint16_t hard_timeout);
+
+  /**
+   *
+   */
+  cofflowmodtemplate &set_priority(uint16_t priority);
+
+  /**
+   *
+   */
+  cofflowmodtemplate &set_buffer_id(uint32_t buffer_id);
+
+public:
+  /**
+   * @brief	Returns number of output actions found in the image.
+   */
+  size_t get_num_of_output_ports() const { return outputs.size(); };
+
+  /**
+   * @brief	Overwrites the port of the index-th output action.
+   *
+   * @exception eFlowModTemplateNotFound no such output action
+   */
+  cofflowmodtemplate &set_output_port(unsigned int index, uint32_t port_no);
+
+public:
+  /**
+   * @brief	Checks for an OXM TLV in the match of this template.
+   *
+   * @param oxm_tlv OXM TLV header as defined by OXM_TLV_* constants
+   */
+  bool has_oxm(uint32_t oxm_tlv) const {
+    return (not(oxms.find(oxm_tlv) == oxms.end()));
+  };
+
+  /**
+   * @brief	Overwrites the value (and mask, if mask is non-null) of an
+   * OXM TLV.
+   *
+   * For masked OXM TLVs value bits outside of the (new) mask are cleared.
+   *
+   * @exception eFlowModTemplateNotFound no such OXM TLV in match
+   * @exception eFlowModTemplateInval length mismatch
+   */
+  cofflowmodtemplate &set_oxm(uint32_t oxm_tlv, const uint8_t *value,
+                              size_t valuelen, const uint8_t *mask = nullptr);
+
+  /**
+   *
+   */
+  cofflowmodtemplate &set_oxm_u8(uint32_t oxm_tlv, uint8_t value) {
+    return set_oxm(oxm_tlv, &value, sizeof(value));
+  };
+
+  /**
+   *
+   */
+  cofflowmodtemplate &set_oxm_u16(uint32_t oxm_tlv, uint16_t value) {
+    value = htobe16(value);
+    return set_oxm(oxm_tlv, (const uint8_t *)&value, sizeof(value));
+  };
+
+  /**
+   *
+   */
+  cofflowmodtemplate &set_oxm_u32(uint32_t oxm_tlv, uint32_t value) {
+    value = htobe32(value);
+    return set_oxm(oxm_tlv, (const uint8_t *)&value, sizeof(value));
+  };
+
+  /**
+   *
+   */
+  cofflowmodtemplate &set_oxm_u64(uint32_t oxm_tlv, uint64_t value) {
+    value = htobe64(value);
+    return set_oxm(oxm_tlv, (const uint8_t *)&value, sizeof(value));
+  };
+
+public:
+  friend std::ostream &operator<<(std::ostream &os,
+                                  cofflowmodtemplate const &tmpl) {
+    os << "<cofflowmodtemplate ofp-version:" << (int)tmpl.get_version()
+       << " length: " << tmpl.length() << " #oxms: " << tmpl.oxms.size()
+       << " #outputs: " << tmpl.outputs.size() << " >" << std::endl;
+    os << tmpl.image;
+    return os;
+  };
+
+private:
+  /**
+   *
+   */
+  void compile_match10(size_t match_offset);
+
+  /**
+   *
+   */
+  void compile_actions(size_t offset, size_t end);
+
+  /**
+   *
+   */
+  void patch(size_t offset, const void *data, size_t datalen);
+
+  /**
+   *
+   */
+  void check_version_of13() const;
+
+private:
+  struct patch_t {
+    size_t offset;
+    size_t length;
+    size_t mask_offset; // 0: no mask present
+  };
+
+  uint8_t ofp_version;
+
+  // Flow-Mod message in wire format
+  rofl::cmemory image;
+
+  // OXM TLV header => offset of value within image
+  std::map<uint32_t, patch_t> oxms;
+
+  // offsets of output action port fields within image
+  std::vector<size_t> outputs;
+};
+
+}; // end of namespace openflow
+}; // end of namespace rofl
+
+#endif /* ROFL_COMMON_OPENFLOW_COFFLOWMODTEMPLATE_H */
@@ -0,0 +1,227 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cofflowmonitor.cc
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#include "rofl/common/openflow/cofflowmonitor.h"
+
+using namespace rofl::openflow;
+
+size_t cofflow_monitor_request::length() const {
+  switch (of_version) {
+  case rofl::openflow14::OFP_VERSION: {
+    return (sizeof(struct rofl::openflow14::ofp_flow_monitor_request) -
+            sizeof(struct rofl::openflow14::ofp_match) + match.length());
+  } break;
+  default:
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+  }
+  return 0;
+}
+
+void cofflow_monitor_request::pack(uint8_t *buf, size_t buflen) {
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  if (buflen < cofflow_monitor_request::length())
+    throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+  switch (of_version) {
+  case rofl::openflow14::OFP_VERSION: {
+    struct rofl::openflow14::ofp_flow_monitor_request *req =
+        (struct rofl::openflow14::ofp_flow_monitor_request *)buf;
+
+    req->monitor_id = htobe32(monitor_id);
+    req->out_port = htobe32(out_port);
+    req->out_group = htobe32(out_group);
+    req->flags = htobe16(flags);
+    req->table_id = table_id;
+    req->command = command;
+
+    match.pack((uint8_t *)&(req->match), match.length());
+  } break;
+  default:
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+  }
+}
+
+void cofflow_monitor_request::unpack(uint8_t *buf, size_t buflen) {
+  switch (of_version) {
+  case rofl::openflow14::OFP_VERSION: {
+    if (buflen < sizeof(struct rofl::openflow14::ofp_flow_monitor_request))
+      throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+    struct rofl::openflow14::ofp_flow_monitor_request *req =
+        (struct rofl::openflow14::ofp_flow_monitor_request *)buf;
+
+    monitor_id = be32toh(req->monitor_id);
+    out_port = be32toh(req->out_port);
+    out_group = be32toh(req->out_group);
+    flags = be16toh(req->flags);
+    table_id = req->table_id;
+    command = req->command;
+
+    match.set_version(FLOW_MONITOR_INNER_VERSION);
+    match.unpack((uint8_t *)&(req->match),
+                 buflen -
+                     sizeof(struct rofl::openflow14::ofp_flow_monitor_request) +
+                     sizeof(struct rofl::openflow14::ofp_match));
+  } break;
+  default:
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+  }
+}
+
+size_t cofflow_update::length() const {
+  switch (of_version) {
+  case rofl::openflow14::OFP_VERSION: {
+    switch (event) {
+    case rofl::openflow14::OFPFME_INITIAL:
+    case rofl::openflow14::OFPFME_ADDED:
+    case rofl::openflow14::OFPFME_MODIFIED: {
+      return (sizeof(struct rofl::openflow14::ofp_flow_update_full) -
+              sizeof(struct rofl::openflow14::ofp_match) + match.length() +
+              instructions.length());
+    } break;
+    case rofl::openflow14::OFPFME_REMOVED: {
+      /* removal events never carry instructions */
+      return (sizeof(struct rofl::openflow14::ofp_flow_update_full) -
+              sizeof(struct rofl::openflow14::ofp_match) + match.length());
+    } break;
+    case rofl::openflow14::OFPFME_ABBREV: {
+      return sizeof(struct rofl::openflow14::ofp_flow_update_abbrev);
+    } break;
+    default: {
+      return sizeof(struct rofl::openflow14::ofp_flow_update_paused);
+    };
+    }
+  } break;
+  default:
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+  }
+  return 0;
+}
+
+void cofflow_update::pack(uint8_t *buf, size_t buflen) {
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  if (buflen < cofflow_update::length())
+    throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+  switch (of_version) {
+  case rofl::openflow14::OFP_VERSION: {
+    if (is_full()) {
+      struct rofl::openflow14::ofp_flow_update_full *fu =
+          (struct rofl::openflow14::ofp_flow_update_full *)buf;
+
+      fu->length = htobe16(length());
+      fu->event = htobe16(event);
+      fu->table_id = table_id;
+      fu->reason = reason;
+      fu->idle_timeout = htobe16(idle_timeout);
+      fu->hard_timeout = htobe16(hard_timeout);
+      fu->priority = htobe16(priority);
+      memset(fu->zeros, 0, sizeof(fu->zeros));
+      fu->cookie = htobe64(cookie);
+
+      uint8_t *p_match = (uint8_t *)&(fu->match);
+      match.pack(p_match, match.length());
+      if (rofl::openflow14::OFPFME_REMOVED != event) {
+        instructions.pack(p_match + match.length(), instructions.length());
+      }
+
+    } else if (rofl::openflow14::OFPFME_ABBREV == event) {
+      struct rofl::openflow14::ofp_flow_update_abbrev *fu =
+          (struct rofl::openflow14::ofp_flow_update_abbrev *)buf;
+
+      fu->length = htobe16(length());
+      fu->event = htobe16(event);
+      fu->xid = htobe32(xid);
+
+    } else {
+      struct rofl::openflow14::ofp_flow_update_paused *fu =
+          (struct rofl::openflow14::ofp_flow_update_paused *)buf;
+
+      fu->length = htobe16(length());
+      fu->event = htobe16(event);
+      memset(fu->zeros, 0, sizeof(fu->zeros));
+    }
+  } break;
+  default:
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+  }
+}
+
+void cofflow_update::unpack(uint8_t *buf, size_t buflen) {
+  match.clear();
+  instructions.clear();
+
+  switch (of_version) {
+  case rofl::openflow14::OFP_VERSION: {
+    if (buflen < sizeof(struct rofl::openflow14::ofp_flow_update_header))
+      throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+    struct rofl::openflow14::ofp_flow_update_header *hdr =
+        (struct rofl::openflow14::ofp_flow_update_header *)buf;
+
+    event = be16toh(hdr->event);
+
+    if (is_full()) {
+      if (buflen < sizeof(struct rofl::openflow14::ofp_flow_update_full))
+        throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+      struct rofl::openflow14::ofp_flow_update_full *fu =
+          (struct rofl::openflow14::ofp_flow_update_full *)buf;
+
+      table_id = fu->table_id;
+      reason = fu->reason;
+      idle_timeout = be16toh(fu->idle_timeout);
+      hard_timeout = be16toh(fu->hard_timeout);
+      priority = be16toh(fu->priority);
+      cookie = be64toh(fu->cookie);
+
+      // derive length for match
+      size_t matchlen = be16toh(fu->match.length);
+
+      size_t pad = (0x7 & matchlen);
+      /* append padding if not a multiple of 8 */
+      if (pad) {
+        matchlen += 8 - pad;
+      }
+
+      size_t offset = sizeof(struct rofl::openflow14::ofp_flow_update_full) -
+                      sizeof(struct rofl::openflow14::ofp_match);
+
+      if (buflen < (offset + matchlen))
+        throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+      match.set_version(FLOW_MONITOR_INNER_VERSION);
+      match.unpack(buf + offset, matchlen);
+
+      instructions.set_version(FLOW_MONITOR_INNER_VERSION);
+      if (buflen > (offset + matchlen)) {
+        instructions.unpack(buf + offset + matchlen,
+                            buflen - offset - matchlen);
+      }
+
+    } else if (rofl::openflow14::OFPFME_ABBREV == event) {
+      if (buflen < sizeof(struct rofl::openflow14::ofp_flow_update_abbrev))
+        throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+      struct rofl::openflow14::ofp_flow_update_abbrev *fu =
+          (struct rofl::openflow14::ofp_flow_update_abbrev *)buf;
+
+      xid = be32toh(fu->xid);
+    }
+  } break;
+  default:
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+  }
+}
@@ -0,0 +1,576 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cofflowmonitor.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#ifndef ROFL_COMMON_OPENFLOW_COFFLOWMONITOR_H
+#define ROFL_COMMON_OPENFLOW_COFFLOWMONITOR_H 1
+
+#include <endian.h>
+#include <inttypes.h>
+#include <iostream>
+#include <sstream>
+
+#include "rofl/common/openflow/cofinstructions.h"
+#include "rofl/common/openflow/cofmatch.h"
+#include "rofl/common/openflow/openflow.h"
+#include "rofl/common/openflow/openflow_rofl_exceptions.h"
+
+namespace rofl {
+namespace openflow {
+
+class eFlowMonitorBase : public exception {
+public:
+  eFlowMonitorBase(const std::string &__arg = std::string(""))
+      : exception(__arg) {
+    set_exception("eFlowMonitorBase");
+  };
+};
+class eFlowMonitorNotFound : public eFlowMonitorBase {
+public:
+  eFlowMonitorNotFound(const std::string &__arg = std::string(""))
+      : eFlowMonitorBase(__arg) {
+    set_exception("eFlowMonitorNotFound");
+  };
+};
+
+/**
+ * @brief	Match encoding used within flow monitor requests and updates.
+ *
+ * OpenFlow 1.4 shares the OXM match and instruction wire format of
+ * OpenFlow 1.3.
+ */
+static const uint8_t FLOW_MONITOR_INNER_VERSION = rofl::openflow13::OFP_VERSION;
+
+class cofflow_monitor_request {
+public:
+  /**
+   *
+   */
+  ~cofflow_monitor_request(){};
+
+  /**
+   *
+   */
+  cofflow_monitor_request(
+      uint8_t of_version = rofl::openflow::OFP_VERSION_UNKNOWN,
+      uint32_t monitor_id = 0,
+      uint8_t command = rofl::openflow14::OFPFMC_ADD,
+      uint16_t flags = rofl::openflow14::OFPFMF_INITIAL |
+                       rofl::openflow14::OFPFMF_ADD |
+                       rofl::openflow14::OFPFMF_REMOVED |
+                       rofl::openflow14::OFPFMF_MODIFY,
+      uint8_t table_id = rofl::openflow14::OFPTT_ALL,
+      uint32_t out_port = rofl::openflow14::OFPP_ANY,
+      uint32_t out_group = rofl::openflow14::OFPG_ANY,
+      const cofmatch &match = cofmatch(FLOW_MONITOR_INNER_VERSION))
+      : of_version(of_version), monitor_id(monitor_id), out_port(out_port),
+        out_group(out_group), flags(flags), table_id(table_id),
+        command(command), match(match) {
+    this->match.set_version(FLOW_MONITOR_INNER_VERSION);
+  };
+
+  /**
+   *
+   */
+  cofflow_monitor_request(const cofflow_monitor_request &request) {
+    *this = request;
+  };
+
+  /**
+   *
+   */
+  cofflow_monitor_request &operator=(const cofflow_monitor_request &request) {
+    if (this == &request)
+      return *this;
+    of_version = request.of_version;
+    monitor_id = request.monitor_id;
+    out_port = request.out_port;
+    out_group = request.out_group;
+    flags = request.flags;
+    table_id = request.table_id;
+    command = request.command;
+    match = request.match;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  bool operator==(const cofflow_monitor_request &request) const {
+    return ((of_version == request.of_version) &&
+            (monitor_id == request.monitor_id) &&
+            (out_port == request.out_port) &&
+            (out_group == request.out_group) && (flags == request.flags) &&
+            (table_id == request.table_id) && (command == request.command) &&
+            (match == request.match));
+  };
+
+public:
+  /**
+   *
+   */
+  size_t length() const;
+
+  /**
+   *
+   */
+  void pack(uint8_t *buf, size_t buflen);
+
+  /**
+   *
+   */
+  void unpack(uint8_t *buf, size_t buflen);
+
+public:
+  /**
+   *
+   */
+  cofflow_monitor_request &set_version(uint8_t of_version) {
+    this->of_version = of_version;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint8_t get_version() const { return of_version; };
+
+  /**
+   *
+   */
+  cofflow_monitor_request &set_monitor_id(uint32_t monitor_id) {
+    this->monitor_id = monitor_id;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint32_t get_monitor_id() const { return monitor_id; };
+
+  /**
+   *
+   */
+  cofflow_monitor_request &set_out_port(uint32_t out_port) {
+    this->out_port = out_port;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint32_t get_out_port() const { return out_port; };
+
+  /**
+   *
+   */
+  cofflow_monitor_request &set_out_group(uint32_t out_group) {
+    this->out_group = out_group;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint32_t get_out_group() const { return out_group; };
+
+  /**
+   *
+   */
+  cofflow_monitor_request &set_flags(uint16_t flags) {
+    this->flags = flags;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint16_t get_flags() const { return flags; };
+
+  /**
+   *
+   */
+  cofflow_monitor_request &set_table_id(uint8_t table_id) {
+    this->table_id = table_id;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint8_t get_table_id() const { return table_id; };
+
+  /**
+   *
+   */
+  cofflow_monitor_request &set_command(uint8_t command) {
+    this->command = command;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint8_t get_command() const { return command; };
+
+  /**
+   *
+   */
+  cofflow_monitor_request &set_match(const cofmatch &match) {
+    (this->match = match).set_version(FLOW_MONITOR_INNER_VERSION);
+    return *this;
+  };
+
+  /**
+   *
+   */
+  cofmatch &set_match() { return match; };
+
+  /**
+   *
+   */
+  const cofmatch &get_match() const { return match; };
+
+public:
+  friend std::ostream &operator<<(std::ostream &os,
+                                  const cofflow_monitor_request &request) {
+    os << "<cofflow_monitor_request >" << std::endl;
+    os << std::hex;
+    os << "<monitor-id: 0x" << (unsigned int)request.get_monitor_id() << " >"
+       << std::endl;
+    os << "<command: 0x" << (unsigned int)request.get_command() << " >"
+       << std::endl;
+    os << "<flags: 0x" << (unsigned int)request.get_flags() << " >"
+       << std::endl;
+    os << "<table-id: 0x" << (unsigned int)request.get_table_id() << " >"
+       << std::endl;
+    os << "<out-port: 0x" << (unsigned int)request.get_out_port() << " >"
+       << std::endl;
+    os << "<out-group: 0x" << (unsigned int)request.get_out_group() << " >"
+       << std::endl;
+    os << std::dec;
+    os << request.match;
+    return os;
+  };
+
+  std::string str() const {
+    std::stringstream ss;
+    ss << "<cofflow_monitor_request monitor-id: " << monitor_id
+       << " command: " << (unsigned int)command << " flags: 0x" << std::hex
+       << flags << std::dec << " table-id: " << (unsigned int)table_id
+       << " >";
+    return ss.str();
+  };
+
+private:
+  uint8_t of_version;
+  uint32_t monitor_id;
+  uint32_t out_port;
+  uint32_t out_group;
+  uint16_t flags;
+  uint8_t table_id;
+  uint8_t command;
+  cofmatch match;
+};
+
+/**
+ * @brief	A single entry of a flow monitor reply.
+ *
+ * Depending on the event, an update carries the full flow entry
+ * (OFPFME_INITIAL/ADDED/REMOVED/MODIFIED), only the xid of the request that
+ * caused the change (OFPFME_ABBREV) or nothing (OFPFME_PAUSED/RESUMED).
+ */
+class cofflow_update {
+public:
+  /**
+   *
+   */
+  ~cofflow_update(){};
+
+  /**
+   *
+   */
+  cofflow_update(uint8_t of_version = rofl::openflow::OFP_VERSION_UNKNOWN,
+                 uint16_t event = rofl::openflow14::OFPFME_ADDED)
+      : of_version(of_version), event(event), table_id(0), reason(0),
+        idle_timeout(0), hard_timeout(0), priority(0), cookie(0), xid(0),
+        match(FLOW_MONITOR_INNER_VERSION),
+        instructions(FLOW_MONITOR_INNER_VERSION){};
+
+  /**
+   *
+   */
+  cofflow_update(const cofflow_update &update) { *this = update; };
+
+  /**
+   *
+   */
+  cofflow_update &operator=(const cofflow_update &update) {
+    if (this == &update)
+      return *this;
+    of_version = update.of_version;
+    event = update.event;
+    table_id = update.table_id;
+    reason = update.reason;
+    idle_timeout = update.idle_timeout;
+    hard_timeout = update.hard_timeout;
+    priority = update.priority;
+    cookie = update.cookie;
+    xid = update.xid;
+    match = update.match;
+    instructions = update.instructions;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  bool operator==(const cofflow_update &update) const {
+    return ((of_version == update.of_version) && (event == update.event) &&
+            (table_id == update.table_id) && (reason == update.reason) &&
+            (idle_timeout == update.idle_timeout) &&
+            (hard_timeout == update.hard_timeout) &&
+            (priority == update.priority) && (cookie == update.cookie) &&
+            (xid == update.xid) && (match == update.match) &&
+            (instructions == update.instructions));
+  };
+
+public:
+  /**
+   *
+   */
+  size_t length() const;
+
+  /**
+   *
+   */
+  void pack(uint8_t *buf, size_t buflen);
+
+  /**
+   *
+   */
+  void unpack(uint8_t *buf, size_t buflen);
+
+public:
+  /**
+   * @brief	Returns true for events carrying a complete flow entry.
+   */
+  bool is_full() const {
+    return ((rofl::openflow14::OFPFME_INITIAL == event) ||
+            (rofl::openflow14::OFPFME_ADDED == event) ||
+            (rofl::openflow14::OFPFME_REMOVED == event) ||
+            (rofl::openflow14::OFPFME_MODIFIED == event));
+  };
+
+  /**
+   *
+   */
+  cofflow_update &set_version(uint8_t of_version) {
+    this->of_version = of_version;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint8_t get_version() const { return of_version; };
+
+  /**
+   *
+   */
+  cofflow_update &set_event(uint16_t event) {
+    this->event = event;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint16_t get_event() const { return event; };
+
+  /**
+   *
+   */
+  cofflow_update &set_table_id(uint8_t table_id) {
+    this->table_id = table_id;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint8_t get_table_id() const { return table_id; };
+
+  /**
+   *
+   */
+  cofflow_update &set_reason(uint8_t reason) {
+    this->reason = reason;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint8_t get_reason() const { return reason; };
+
+  /**
+   *
+   */
+  cofflow_update &set_idle_timeout(uint16_t idle_timeout) {
+    this->idle_timeout = idle_timeout;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint16_t get_idle_timeout() const { return idle_timeout; };
+
+  /**
+   *
+   */
+  cofflow_update &set_hard_timeout(uint16_t hard_timeout) {
+    this->hard_timeout = hard_timeout;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint16_t get_hard_timeout() const { return hard_timeout; };
+
+  /**
+   *
+   */
+  cofflow_update &set_priority(uint16_t priority) {
+    this->priority = priority;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint16_t get_priority() const { return priority; };
+
+  /**
+   *
+   */
+  cofflow_update &set_cookie(uint64_t cookie) {
+    this->cookie = cookie;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint64_t get_cookie() const { return cookie; };
+
+  /**
+   * @brief	Sets xid of the flow-mod an OFPFME_ABBREV update refers to.
+   */
+  cofflow_update &set_xid(uint32_t xid) {
+    this->xid = xid;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint32_t get_xid() const { return xid; };
+
+  /**
+   *
+   */
+  cofflow_update &set_match(const cofmatch &match) {
+    (this->match = match).set_version(FLOW_MONITOR_INNER_VERSION);
+    return *this;
+  };
+
+  /**
+   *
+   */
+  cofmatch &set_match() { return match; };
+
+  /**
+   *
+   */
+  const cofmatch &get_match() const { return match; };
+
+  /**
+   *
+   */
+  cofflow_update &set_instructions(const cofinstructions &instructions) {
+    (this->instructions = instructions)
+        .set_version(FLOW_MONITOR_INNER_VERSION);
+    return *this;
+  };
+
+  /**
+   *
+   */
+  cofinstructions &set_instructions() { return instructions; };
+
+  /**
+   *
+   */
+  const cofinstructions &get_instructions() const { return instructions; };
+
+public:
+  friend std::ostream &operator<<(std::ostream &os,
+                                  const cofflow_update &update) {
+    os << "<cofflow_update event: " << (unsigned int)update.get_event() << " >"
+       << std::endl;
+    if (update.is_full()) {
+      os << std::hex;
+      os << "<table-id: 0x" << (unsigned int)update.get_table_id() << " >"
+         << std::endl;
+      os << "<reason: 0x" << (unsigned int)update.get_reason() << " >"
+         << std::endl;
+      os << "<priority: 0x" << (unsigned int)update.get_priority() << " >"
+         << std::endl;
+      os << "<cookie: 0x" << (unsigned long long)update.get_cookie() << " >"
+         << std::endl;
+      os << std::dec;
+      os << update.match;
+      os << update.instructions;
+    } else if (rofl::openflow14::OFPFME_ABBREV == update.get_event()) {
+      os << "<xid: 0x" << std::hex << (unsigned int)update.get_xid()
+         << std::dec << " >" << std::endl;
+    }
+    return os;
+  };
+
+  std::string str() const {
+    std::stringstream ss;
+    ss << "<cofflow_update event: " << (unsigned int)event
+       << " table-id: " << (unsigned int)table_id << " priority: " << priority
+       << " cookie: 0x" << std::hex << cookie << std::dec << " >";
+    return ss.str();
+  };
+
+private:
+  uint8_t of_version;
+  uint16_t event;
+  uint8_t table_id;
+  uint8_t reason;
+  uint16_t idle_timeout;
+  uint16_t hard_timeout;
+  uint16_t priority;
+  uint64_t cookie;
+  uint32_t xid;
+  cofmatch match;
+  cofinstructions instructions;
+};
+
+}; // end of namespace openflow
+}; // end of namespace rofl
+
+#endif /* ROFL_COMMON_OPENFLOW_COFFLOWMONITOR_H */
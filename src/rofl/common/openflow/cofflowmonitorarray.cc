@@ -0,0 +1,158 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cofflowmonitorarray.cc
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#include "rofl/common/openflow/cofflowmonitorarray.h"
+
+using namespace rofl::openflow;
+
+size_t cofflowmonitorarray::length() const {
+  size_t len = 0;
+  for (std::map<unsigned int, cofflow_monitor_request>::const_iterator it =
+           array.begin();
+       it != array.end(); ++it) {
+    len += it->second.length();
+  }
+  return len;
+}
+
+void cofflowmonitorarray::pack(uint8_t *buf, size_t buflen) {
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  if (buflen < length())
+    throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+  switch (ofp_version) {
+  case rofl::openflow14::OFP_VERSION: {
+    for (std::map<unsigned int, cofflow_monitor_request>::iterator it =
+             array.begin();
+         it != array.end(); ++it) {
+      it->second.pack(buf, it->second.length());
+      buf += it->second.length();
+    }
+  } break;
+  default:
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+  }
+}
+
+void cofflowmonitorarray::unpack(uint8_t *buf, size_t buflen) {
+  clear();
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  size_t offset = 0;
+  unsigned int index = 0;
+
+  switch (ofp_version) {
+  case rofl::openflow14::OFP_VERSION: {
+
+    while ((buflen - offset) >=
+           sizeof(struct rofl::openflow14::ofp_flow_monitor_request)) {
+
+      struct rofl::openflow14::ofp_flow_monitor_request *req =
+          (struct rofl::openflow14::ofp_flow_monitor_request *)(buf + offset);
+
+      // derive length for match
+      size_t matchlen = be16toh(req->match.length);
+
+      size_t pad = (0x7 & matchlen);
+      /* append padding if not a multiple of 8 */
+      if (pad) {
+        matchlen += 8 - pad;
+      }
+
+      size_t reqlen =
+          sizeof(struct rofl::openflow14::ofp_flow_monitor_request) -
+          sizeof(struct rofl::openflow14::ofp_match) + matchlen;
+
+      if ((matchlen < sizeof(struct rofl::openflow14::ofp_match)) ||
+          (reqlen > (buflen - offset))) {
+        throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+      }
+
+      add_flow_monitor(index++).unpack(buf + offset, reqlen);
+
+      offset += reqlen;
+    }
+  } break;
+  default:
+    throw eBadRequestBadVersion("eBadRequestBadVersion", __FILE__, __FUNCTION__,
+                                __LINE__);
+  }
+}
+
+size_t cofflowupdatearray::length() const {
+  size_t len = 0;
+  for (std::map<unsigned int, cofflow_update>::const_iterator it =
+           array.begin();
+       it != array.end(); ++it) {
+    len += it->second.length();
+  }
+  return len;
+}
+
+void cofflowupdatearray::pack(uint8_t *buf, size_t buflen) {
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  if (buflen < length())
+    throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+  switch (ofp_version) {
+  case rofl::openflow14::OFP_VERSION: {
+    for (std::map<unsigned int, cofflow_update>::iterator it = array.begin();
+         it != array.end(); ++it) {
+      it->second.pack(buf, it->second.length());
+      buf += it->second.length();
+    }
+  } break;
+  default:
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+  }
+}
+
+void cofflowupdatearray::unpack(uint8_t *buf, size_t buflen) {
+  clear();
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  size_t offset = 0;
+  unsigned int index = 0;
+
+  switch (ofp_version) {
+  case rofl::openflow14::OFP_VERSION: {
+
+    while ((buflen - offset) >=
+           sizeof(struct rofl::openflow14::ofp_flow_update_header)) {
+
+      struct rofl::openflow14::ofp_flow_update_header *hdr =
+          (struct rofl::openflow14::ofp_flow_update_header *)(buf + offset);
+
+      size_t updlen = be16toh(hdr->length);
+
+      if ((updlen < sizeof(struct rofl::openflow14::ofp_flow_update_header)) ||
+          (updlen > (buflen - offset))) {
+        throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+      }
+
+      add_flow_update(index++).unpack(buf + offset, updlen);
+
+      offset += updlen;
+    }
+  } break;
+  default:
+    throw eBadRequestBadVersion("eBadRequestBadVersion", __FILE__, __FUNCTION__,
+                                __LINE__);
+  }
+}
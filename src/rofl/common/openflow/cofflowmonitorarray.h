@@ -0,0 +1,401 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cofflowmonitorarray.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#ifndef ROFL_COMMON_OPENFLOW_COFFLOWMONITORARRAY_H
+#define ROFL_COMMON_OPENFLOW_COFFLOWMONITORARRAY_H 1
+
+#include <iostream>
+#include <list>
+#include <map>
+
+#include "rofl/common/locking.hpp"
+#include "rofl/common/openflow/cofflowmonitor.h"
+
+namespace rofl {
+namespace openflow {
+
+/**
+ * @brief	Body of an OFPMP_FLOW_MONITOR request.
+ */
+class cofflowmonitorarray {
+public:
+  /**
+   *
+   */
+  ~cofflowmonitorarray(){};
+
+  /**
+   *
+   */
+  cofflowmonitorarray(uint8_t ofp_version = OFP_VERSION_UNKNOWN)
+      : ofp_version(ofp_version){};
+
+  /**
+   *
+   */
+  cofflowmonitorarray(const cofflowmonitorarray &array) { *this = array; };
+
+  /**
+   *
+   */
+  cofflowmonitorarray &operator=(const cofflowmonitorarray &array) {
+    if (this == &array)
+      return *this;
+
+    AcquireReadWriteLock lock(array_lock);
+    ofp_version = array.ofp_version;
+    this->array = array.array;
+
+    return *this;
+  };
+
+  /**
+   *
+   */
+  bool operator==(const cofflowmonitorarray &array) const {
+    if (ofp_version != array.ofp_version)
+      return false;
+    return (this->array == array.array);
+  };
+
+public:
+  /**
+   *
+   */
+  uint8_t get_version() const { return ofp_version; };
+
+  /**
+   *
+   */
+  cofflowmonitorarray &set_version(uint8_t ofp_version) {
+    AcquireReadWriteLock lock(array_lock);
+    this->ofp_version = ofp_version;
+    for (auto &it : array) {
+      it.second.set_version(ofp_version);
+    }
+    return *this;
+  };
+
+public:
+  /**
+   *
+   */
+  std::list<uint32_t> keys() const {
+    AcquireReadLock rwlock(array_lock);
+    std::list<uint32_t> ids;
+    for (auto it : array) {
+      ids.push_back(it.first);
+    }
+    return ids;
+  };
+
+  /**
+   *
+   */
+  size_t size() const {
+    AcquireReadLock lock(array_lock);
+    return array.size();
+  };
+
+  /**
+   *
+   */
+  cofflowmonitorarray &clear() {
+    AcquireReadWriteLock lock(array_lock);
+    array.clear();
+    return *this;
+  };
+
+public:
+  /**
+   *
+   */
+  cofflow_monitor_request &add_flow_monitor(unsigned int index) {
+    AcquireReadWriteLock lock(array_lock);
+    if (array.find(index) != array.end()) {
+      array.erase(index);
+    }
+    return (array[index] = cofflow_monitor_request(ofp_version));
+  };
+
+  /**
+   *
+   */
+  cofflow_monitor_request &set_flow_monitor(unsigned int index) {
+    AcquireReadWriteLock lock(array_lock);
+    if (array.find(index) == array.end()) {
+      array[index] = cofflow_monitor_request(ofp_version);
+    }
+    return array[index];
+  };
+
+  /**
+   *
+   */
+  const cofflow_monitor_request &get_flow_monitor(unsigned int index) const {
+    AcquireReadLock lock(array_lock);
+    if (array.find(index) == array.end()) {
+      throw eFlowMonitorNotFound();
+    }
+    return array.at(index);
+  };
+
+  /**
+   *
+   */
+  bool drop_flow_monitor(unsigned int index) {
+    AcquireReadWriteLock lock(array_lock);
+    if (array.find(index) == array.end()) {
+      return false;
+    }
+    array.erase(index);
+    return true;
+  };
+
+  /**
+   *
+   */
+  bool has_flow_monitor(unsigned int index) const {
+    AcquireReadLock lock(array_lock);
+    return (not(array.find(index) == array.end()));
+  };
+
+public:
+  /**
+   *
+   */
+  size_t length() const;
+
+  /**
+   *
+   */
+  void pack(uint8_t *buf = (uint8_t *)0, size_t buflen = 0);
+
+  /**
+   *
+   */
+  void unpack(uint8_t *buf, size_t buflen);
+
+public:
+  friend std::ostream &operator<<(std::ostream &os,
+                                  const cofflowmonitorarray &array) {
+    os << "<cofflowmonitorarray #flow-monitors:" << (int)array.array.size()
+       << " >" << std::endl;
+    for (auto it : array.array) {
+      os << it.second;
+    }
+    return os;
+  };
+
+private:
+  uint8_t ofp_version;
+  std::map<unsigned int, cofflow_monitor_request> array;
+  mutable rofl::crwlock array_lock;
+};
+
+/**
+ * @brief	Body of an OFPMP_FLOW_MONITOR reply.
+ */
+class cofflowupdatearray {
+public:
+  /**
+   *
+   */
+  ~cofflowupdatearray(){};
+
+  /**
+   *
+   */
+  cofflowupdatearray(uint8_t ofp_version = OFP_VERSION_UNKNOWN)
+      : ofp_version(ofp_version){};
+
+  /**
+   *
+   */
+  cofflowupdatearray(const cofflowupdatearray &array) { *this = array; };
+
+  /**
+   *
+   */
+  cofflowupdatearray &operator=(const cofflowupdatearray &array) {
+    if (this == &array)
+      return *this;
+
+    AcquireReadWriteLock lock(array_lock);
+    ofp_version = array.ofp_version;
+    this->array = array.array;
+
+    return *this;
+  };
+
+  /**
+   *
+   */
+  bool operator==(const cofflowupdatearray &array) const {
+    if (ofp_version != array.ofp_version)
+      return false;
+    return (this->array == array.array);
+  };
+
+  /**
+   *
+   */
+  cofflowupdatearray &operator+=(const cofflowupdatearray &array) {
+    AcquireReadWriteLock lock(array_lock);
+    unsigned int index = 0;
+    for (auto it : array.array) {
+      while (this->array.find(index) != this->array.end()) {
+        index++;
+      }
+      this->array[index] = it.second;
+    }
+    return *this;
+  };
+
+public:
+  /**
+   *
+   */
+  uint8_t get_version() const { return ofp_version; };
+
+  /**
+   *
+   */
+  cofflowupdatearray &set_version(uint8_t ofp_version) {
+    AcquireReadWriteLock lock(array_lock);
+    this->ofp_version = ofp_version;
+    for (auto &it : array) {
+      it.second.set_version(ofp_version);
+    }
+    return *this;
+  };
+
+public:
+  /**
+   *
+   */
+  std::list<uint32_t> keys() const {
+    AcquireReadLock rwlock(array_lock);
+    std::list<uint32_t> ids;
+    for (auto it : array) {
+      ids.push_back(it.first);
+    }
+    return ids;
+  };
+
+  /**
+   *
+   */
+  size_t size() const {
+    AcquireReadLock lock(array_lock);
+    return array.size();
+  };
+
+  /**
+   *
+   */
+  cofflowupdatearray &clear() {
+    AcquireReadWriteLock lock(array_lock);
+    array.clear();
+    return *this;
+  };
+
+public:
+  /**
+   *
+   */
+  cofflow_update &add_flow_update(unsigned int index) {
+    AcquireReadWriteLock lock(array_lock);
+    if (array.find(index) != array.end()) {
+      array.erase(index);
+    }
+    return (array[index] = cofflow_update(ofp_version));
+  };
+
+  /**
+   *
+   */
+  cofflow_update &set_flow_update(unsigned int index) {
+    AcquireReadWriteLock lock(array_lock);
+    if (array.find(index) == array.end()) {
+      array[index] = cofflow_update(ofp_version);
+    }
+    return array[index];
+  };
+
+  /**
+   *
+   */
+  const cofflow_update &get_flow_update(unsigned int index) const {
+    AcquireReadLock lock(array_lock);
+    if (array.find(index) == array.end()) {
+      throw eFlowMonitorNotFound();
+    }
+    return array.at(index);
+  };
+
+  /**
+   *
+   */
+  bool drop_flow_update(unsigned int index) {
+    AcquireReadWriteLock lock(array_lock);
+    if (array.find(index) == array.end()) {
+      return false;
+    }
+    array.erase(index);
+    return true;
+  };
+
+  /**
+   *
+   */
+  bool has_flow_update(unsigned int index) const {
+    AcquireReadLock lock(array_lock);
+    return (not(array.find(index) == array.end()));
+  };
+
+public:
+  /**
+   *
+   */
+  size_t length() const;
+
+  /**
+   *
+   */
+  void pack(uint8_t *buf = (uint8_t *)0, size_t buflen = 0);
+
+  /**
+   *
+   */
+  void unpack(uint8_t *buf, size_t buflen);
+
+public:
+  friend std::ostream &operator<<(std::ostream &os,
+                                  const cofflowupdatearray &array) {
+    os << "<cofflowupdatearray #flow-updates:" << (int)array.array.size()
+       << " >" << std::endl;
+    for (auto it : array.array) {
+      os << it.second;
+    }
+    return os;
+  };
+
+private:
+  uint8_t ofp_version;
+  std::map<unsigned int, cofflow_update> array;
+  mutable rofl::crwlock array_lock;
+};
+
+}; // end of namespace openflow
+}; // end of namespace rofl
+
+#endif /* ROFL_COMMON_OPENFLOW_COFFLOWMONITORARRAY_H */
@@ -12,7 +12,8 @@ size_t cofflow_stats_request::length() const {
     return sizeof(struct rofl::openflow10::ofp_flow_stats_request);
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow12::ofp_flow_stats_request) -
             sizeof(struct rofl::openflow12::ofp_match) + match.length());
   } break;
@@ -38,7 +39,8 @@ void cofflow_stats_request::pack(uint8_t *buf, size_t buflen) {
                sizeof(struct rofl::openflow10::ofp_match));
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < cofflow_stats_request::length())
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
@@ -77,7 +79,8 @@ void cofflow_stats_request::unpack(uint8_t *buf, size_t buflen) {
     out_port = (uint32_t)(be16toh(req->out_port));
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < sizeof(struct rofl::openflow12::ofp_flow_stats_request))
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
@@ -109,7 +112,8 @@ size_t cofflow_stats_reply::length() const {
             sizeof(struct rofl::openflow12::ofp_match) + match.length() +
             instructions.length());
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_flow_stats) -
             sizeof(struct rofl::openflow13::ofp_match) + match.length() +
             instructions.length());
@@ -173,7 +177,8 @@ void cofflow_stats_reply::pack(uint8_t *buf, size_t buflen) {
     instructions.pack(p_match + match.length(), instructions.length());
 
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < length())
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
@@ -273,7 +278,8 @@ void cofflow_stats_reply::unpack(uint8_t *buf, size_t buflen) {
             sizeof(struct rofl::openflow12::ofp_match) - matchlen);
 
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < sizeof(struct rofl::openflow13::ofp_flow_stats))
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
@@ -229,7 +229,8 @@ public:
 
     } break;
     case openflow12::OFP_VERSION:
-    case openflow13::OFP_VERSION: {
+    case openflow13::OFP_VERSION:
+    case openflow14::OFP_VERSION: {
       os << "<cofflow_stats_request >" << std::endl;
       os << "<table-id:" << (int)flow_stats_request.get_table_id() << " >"
          << std::endl;
@@ -586,7 +587,8 @@ public:
     switch (flow_stats_reply.of_version) {
     case rofl::openflow10::OFP_VERSION:
     case rofl::openflow12::OFP_VERSION:
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       os << "<cofflow_stats_reply >" << std::endl;
       os << "<table-id: " << (int)flow_stats_reply.get_table_id() << " >"
          << std::endl;
@@ -623,6 +625,7 @@ public:
       os << flow_stats_reply.instructions;
       break;
     case openflow13::OFP_VERSION:
+    case openflow14::OFP_VERSION:
       os << flow_stats_reply.instructions;
       break;
     default:
@@ -11,6 +11,10 @@
 
 #include "rofl/common/openflow/cofflowstatsarray.h"
 
+#include <vector>
+
+#include "rofl/common/cworkerpool.hpp"
+
 using namespace rofl::openflow;
 
 size_t cofflowstatsarray::length() const {
@@ -33,7 +37,8 @@ void cofflowstatsarray::pack(uint8_t *buf, size_t buflen) {
   switch (ofp_version) {
   case rofl::openflow10::OFP_VERSION:
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     for (std::map<uint32_t, cofflow_stats_reply>::iterator it = array.begin();
          it != array.end(); ++it) {
@@ -50,15 +55,16 @@ void cofflowstatsarray::pack(uint8_t *buf, size_t buflen) {
 void cofflowstatsarray::unpack(uint8_t *buf, size_t buflen) {
   array.clear();
 
+  /* pre-scan entry boundaries, decoding happens in a second step */
+  std::vector<std::pair<uint8_t *, size_t>> entries;
+
   switch (ofp_version) {
   case rofl::openflow10::OFP_VERSION: {
 
-    uint32_t flow_id = 0;
-
     while (buflen >= sizeof(struct rofl::openflow10::ofp_flow_stats)) {
 
-      add_flow_stats(flow_id++).unpack(
-          buf, sizeof(struct rofl::openflow10::ofp_flow_stats));
+      entries.push_back(
+          std::make_pair(buf, sizeof(struct rofl::openflow10::ofp_flow_stats)));
 
       buf += sizeof(struct rofl::openflow10::ofp_flow_stats);
       buflen -= sizeof(struct rofl::openflow10::ofp_flow_stats);
@@ -66,8 +72,6 @@ void cofflowstatsarray::unpack(uint8_t *buf, size_t buflen) {
   } break;
   case rofl::openflow12::OFP_VERSION: {
 
-    uint32_t flow_id = 0;
-
     while (buflen >= sizeof(struct rofl::openflow12::ofp_flow_stats)) {
 
       struct rofl::openflow12::ofp_flow_stats *flow_stats =
@@ -75,19 +79,19 @@ void cofflowstatsarray::unpack(uint8_t *buf, size_t buflen) {
 
       uint16_t length = be16toh(flow_stats->length);
 
-      if (length < sizeof(struct rofl::openflow12::ofp_flow_stats))
+      if ((length < sizeof(struct rofl::openflow12::ofp_flow_stats)) ||
+          (length > buflen))
         throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
-      add_flow_stats(flow_id++).unpack(buf, length);
+      entries.push_back(std::make_pair(buf, length));
 
       buf += length;
       buflen -= length;
     }
 
   } break;
-  case rofl::openflow13::OFP_VERSION: {
-
-    uint32_t flow_id = 0;
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     while (buflen >= sizeof(struct rofl::openflow13::ofp_flow_stats)) {
 
@@ -96,10 +100,11 @@ void cofflowstatsarray::unpack(uint8_t *buf, size_t buflen) {
 
       uint16_t length = be16toh(flow_stats->length);
 
-      if (length < sizeof(struct rofl::openflow13::ofp_flow_stats))
+      if ((length < sizeof(struct rofl::openflow13::ofp_flow_stats)) ||
+          (length > buflen))
         throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
-      add_flow_stats(flow_id++).unpack(buf, length);
+      entries.push_back(std::make_pair(buf, length));
 
       buf += length;
       buflen -= length;
@@ -110,4 +115,17 @@ void cofflowstatsarray::unpack(uint8_t *buf, size_t buflen) {
     throw eBadRequestBadVersion("eBadRequestBadVersion", __FILE__, __FUNCTION__,
                                 __LINE__);
   }
+
+  std::vector<cofflow_stats_reply *> flow_stats(entries.size());
+  for (uint32_t flow_id = 0; flow_id < entries.size(); flow_id++) {
+    flow_stats[flow_id] = &add_flow_stats(flow_id);
+  }
+
+  /* entries are independent, decode them on the worker pool if enabled */
+  rofl::cworkerpool::for_each_chunk(
+      entries.size(), [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+          flow_stats[i]->unpack(entries[i].first, entries[i].second);
+        }
+      });
 }
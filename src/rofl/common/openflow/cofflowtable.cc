@@ -0,0 +1,273 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "rofl/common/openflow/cofflowtable.h"
+
+using namespace rofl::openflow;
+
+cofflowtable::key_t::key_t(uint8_t ofp_version, uint8_t table_id,
+                           uint16_t priority, const cofmatch &match)
+    : table_id(table_id), priority(priority), match(match.get_matches()) {
+  /* OpenFlow 1.0 knows a single table only (from the controller's view) */
+  if (rofl::openflow10::OFP_VERSION == ofp_version)
+    this->table_id = 0;
+}
+
+bool cofflowtable::covers(const cofflowmod &flowmod,
+                          const cofflowmod &entry) const {
+  switch (ofp_version) {
+  case rofl::openflow10::OFP_VERSION: {
+    /* no table or cookie filter */
+  } break;
+  default: {
+    if ((flowmod.get_table_id() != rofl::openflow13::OFPTT_ALL) &&
+        (flowmod.get_table_id() != entry.get_table_id()))
+      return false;
+    if ((flowmod.get_cookie() & flowmod.get_cookie_mask()) !=
+        (entry.get_cookie() & flowmod.get_cookie_mask()))
+      return false;
+  };
+  }
+  /* all OXM TLVs in flowmod must be present in entry with identical value
+   * and mask, entry may contain additional OXM TLVs */
+  const std::map<uint64_t, coxmatch *> &wildcard =
+      flowmod.get_match().get_matches().get_matches();
+  const std::map<uint64_t, coxmatch *> &exact =
+      entry.get_match().get_matches().get_matches();
+
+  for (auto it : wildcard) {
+    std::map<uint64_t, coxmatch *>::const_iterator jt = exact.find(it.first);
+    if (jt == exact.end())
+      return false;
+    rofl::cmemory lmem(it.second->length());
+    rofl::cmemory rmem(jt->second->length());
+    it.second->pack(lmem.somem(), lmem.length());
+    jt->second->pack(rmem.somem(), rmem.length());
+    if (not(lmem == rmem))
+      return false;
+  }
+  return true;
+}
+
+void cofflowtable::set_flow_actions(cofflowmod &entry,
+                                    const cofflowmod &flowmod) const {
+  switch (ofp_version) {
+  case rofl::openflow10::OFP_VERSION: {
+    entry.set_actions(flowmod.get_actions());
+  } break;
+  default: { entry.set_instructions(flowmod.get_instructions()); };
+  }
+}
+
+bool cofflowtable::is_modified(const cofflowmod &desired,
+                               const cofflowmod &observed) const {
+  if (desired.get_cookie() != observed.get_cookie())
+    return true;
+
+  /* compare actions/instructions in wire format */
+  switch (ofp_version) {
+  case rofl::openflow10::OFP_VERSION: {
+    cofactions lactions(desired.get_actions());
+    cofactions ractions(observed.get_actions());
+    rofl::cmemory lmem(lactions.length());
+    rofl::cmemory rmem(ractions.length());
+    lactions.pack(lmem.somem(), lmem.length());
+    ractions.pack(rmem.somem(), rmem.length());
+    return (not(lmem == rmem));
+  } break;
+  default: {
+    cofinstructions linstructions(desired.get_instructions());
+    cofinstructions rinstructions(observed.get_instructions());
+    rofl::cmemory lmem(linstructions.length());
+    rofl::cmemory rmem(rinstructions.length());
+    linstructions.pack(lmem.somem(), lmem.length());
+    rinstructions.pack(rmem.somem(), rmem.length());
+    return (not(lmem == rmem));
+  };
+  }
+}
+
+void cofflowtable::flow_mod(const cofflowmod &flowmod) {
+  AcquireReadWriteLock rwlock(flows_lock);
+
+  if (flowmod.get_version() != ofp_version)
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+
+  key_t key(ofp_version, flowmod.get_table_id(), flowmod.get_priority(),
+            flowmod.get_match());
+
+  switch (flowmod.get_command()) {
+  case rofl::openflow::OFPFC_ADD: {
+    cofflowmod &entry = (flows[key] = flowmod);
+    entry.set_command(rofl::openflow::OFPFC_ADD);
+    entry.set_buffer_id(rofl::openflow::OFP_NO_BUFFER);
+    entry.set_cookie_mask(0);
+  } break;
+  case rofl::openflow::OFPFC_MODIFY_STRICT: {
+    std::map<key_t, cofflowmod>::iterator it = flows.find(key);
+    if (it != flows.end()) {
+      set_flow_actions(it->second, flowmod);
+    } else if (rofl::openflow10::OFP_VERSION == ofp_version) {
+      /* OpenFlow 1.0 adds a missing entry on modify */
+      cofflowmod &entry = (flows[key] = flowmod);
+      entry.set_command(rofl::openflow::OFPFC_ADD);
+      entry.set_buffer_id(rofl::openflow::OFP_NO_BUFFER);
+    }
+  } break;
+  case rofl::openflow::OFPFC_MODIFY: {
+    bool found = false;
+    for (auto &it : flows) {
+      if (not covers(flowmod, it.second))
+        continue;
+      set_flow_actions(it.second, flowmod);
+      found = true;
+    }
+    if ((not found) && (rofl::openflow10::OFP_VERSION == ofp_version)) {
+      cofflowmod &entry = (flows[key] = flowmod);
+      entry.set_command(rofl::openflow::OFPFC_ADD);
+      entry.set_buffer_id(rofl::openflow::OFP_NO_BUFFER);
+    }
+  } break;
+  case rofl::openflow::OFPFC_DELETE_STRICT: {
+    flows.erase(key);
+  } break;
+  case rofl::openflow::OFPFC_DELETE: {
+    for (std::map<key_t, cofflowmod>::iterator it = flows.begin();
+         it != flows.end();) {
+      if (covers(flowmod, it->second)) {
+        flows.erase(it++);
+      } else {
+        ++it;
+      }
+    }
+  } break;
+  default: {
+    /* unknown command, ignore */
+  };
+  }
+}
+
+bool cofflowtable::flow_removed(uint8_t table_id, uint16_t priority,
+                                const cofmatch &match) {
+  AcquireReadWriteLock rwlock(flows_lock);
+  key_t key(ofp_version, table_id, priority, match);
+  observed.erase(key);
+  return (flows.erase(key) > 0);
+}
+
+bool cofflowtable::has_flow(uint8_t table_id, uint16_t priority,
+                            const cofmatch &match) const {
+  AcquireReadLock rwlock(flows_lock);
+  return (not(flows.find(key_t(ofp_version, table_id, priority, match)) ==
+              flows.end()));
+}
+
+cofflowmod cofflowtable::get_flow(uint8_t table_id, uint16_t priority,
+                                  const cofmatch &match) const {
+  AcquireReadLock rwlock(flows_lock);
+  std::map<key_t, cofflowmod>::const_iterator it =
+      flows.find(key_t(ofp_version, table_id, priority, match));
+  if (it == flows.end())
+    throw eFlowTableNotFound("cofflowtable::get_flow() entry not found");
+  return it->second;
+}
+
+void cofflowtable::reconcile_begin() {
+  AcquireReadWriteLock rwlock(flows_lock);
+  observed.clear();
+  reconciling = true;
+}
+
+void cofflowtable::reconcile_add(const cofflowstatsarray &stats) {
+  AcquireReadWriteLock rwlock(flows_lock);
+
+  if (not reconciling)
+    return;
+
+  for (auto id : stats.keys()) {
+    const cofflow_stats_reply &reply = stats.get_flow_stats(id);
+
+    cofflowmod entry(ofp_version);
+    entry.set_command(rofl::openflow::OFPFC_ADD);
+    entry.set_table_id(reply.get_table_id());
+    entry.set_priority(reply.get_priority());
+    entry.set_idle_timeout(reply.get_idle_timeout());
+    entry.set_hard_timeout(reply.get_hard_timeout());
+    entry.set_cookie(reply.get_cookie());
+    entry.set_match(reply.get_match());
+    switch (ofp_version) {
+    case rofl::openflow10::OFP_VERSION: {
+      entry.set_actions(reply.get_actions());
+    } break;
+    default: {
+      entry.set_flags(reply.get_flags());
+      entry.set_instructions(reply.get_instructions());
+    };
+    }
+
+    observed[key_t(ofp_version, entry.get_table_id(), entry.get_priority(),
+                   entry.get_match())] = entry;
+  }
+}
+
+void cofflowtable::reconcile_abort() {
+  AcquireReadWriteLock rwlock(flows_lock);
+  observed.clear();
+  reconciling = false;
+}
+
+size_t cofflowtable::reconcile_end(std::vector<cofflowmod> &delta) {
+  AcquireReadWriteLock rwlock(flows_lock);
+
+  if (not reconciling)
+    return 0;
+
+  size_t num = 0;
+
+  /* shadowed entries: add missing ones, modify differing ones */
+  for (std::map<key_t, cofflowmod>::iterator it = flows.begin();
+       it != flows.end();) {
+    std::map<key_t, cofflowmod>::iterator jt = observed.find(it->first);
+
+    if (jt == observed.end()) {
+      if ((it->second.get_idle_timeout() != 0) ||
+          (it->second.get_hard_timeout() != 0)) {
+        /* entry has expired on the datapath */
+        flows.erase(it++);
+        continue;
+      }
+      delta.push_back(it->second);
+      delta.back().set_command(rofl::openflow::OFPFC_ADD);
+      num++;
+    } else if (is_modified(it->second, jt->second)) {
+      delta.push_back(it->second);
+      if (it->second.get_cookie() == jt->second.get_cookie()) {
+        delta.back().set_command(rofl::openflow::OFPFC_MODIFY_STRICT);
+      } else {
+        /* overwrites the existing entry including its cookie */
+        delta.back().set_command(rofl::openflow::OFPFC_ADD);
+      }
+      num++;
+    }
+    ++it;
+  }
+
+  /* unknown entries found on the datapath */
+  for (auto it : observed) {
+    if (flows.find(it.first) != flows.end())
+      continue;
+    cofflowmod entry(ofp_version);
+    entry.set_command(rofl::openflow::OFPFC_DELETE_STRICT);
+    entry.set_table_id(it.second.get_table_id());
+    entry.set_priority(it.second.get_priority());
+    entry.set_match(it.second.get_match());
+    delta.push_back(entry);
+    num++;
+  }
+
+  observed.clear();
+  reconciling = false;
+
+  return num;
+}
@@ -0,0 +1,250 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef ROFL_COMMON_OPENFLOW_COFFLOWTABLE_H
+#define ROFL_COMMON_OPENFLOW_COFFLOWTABLE_H 1
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "rofl/common/cmemory.h"
+#include "rofl/common/exception.hpp"
+#include "rofl/common/locking.hpp"
+#include "rofl/common/openflow/cofflowmod.h"
+#include "rofl/common/openflow/cofflowstatsarray.h"
+
+namespace rofl {
+namespace openflow {
+
+class eFlowTableBase : public exception {
+public:
+  eFlowTableBase(const std::string &__arg = std::string(""))
+      : exception(__arg) {
+    set_exception("eFlowTableBase");
+  };
+};
+class eFlowTableNotFound : public eFlowTableBase {
+public:
+  eFlowTableNotFound(const std::string &__arg = std::string(""))
+      : eFlowTableBase(__arg) {
+    set_exception("eFlowTableNotFound");
+  };
+};
+
+/**
+ * @brief	Shadow copy of a datapath's flow tables.
+ *
+ * Entries are indexed by (table_id, priority, match) and reflect the
+ * flow-mods sent to the datapath. Matches are compared in canonical form,
+ * so a datapath reporting a masked value normalized by its mask still
+ * refers to the same entry. Flow-Removed messages received from
+ * the datapath delete the affected entry. After a reconnect, the shadow
+ * table can be reconciled against the datapath's flow-stats: only the
+ * Flow-Mods required to restore the shadowed state are emitted.
+ *
+ * Non-strict Flow-Mod commands are applied by match containment only,
+ * restrictions by out_port and out_group are ignored.
+ */
+class cofflowtable {
+public:
+  /**
+   *
+   */
+  ~cofflowtable(){};
+
+  /**
+   *
+   */
+  cofflowtable(uint8_t ofp_version = rofl::openflow::OFP_VERSION_UNKNOWN)
+      : ofp_version(ofp_version), reconciling(false){};
+
+  /**
+   *
+   */
+  cofflowtable(const cofflowtable &table) { *this = table; };
+
+  /**
+   *
+   */
+  cofflowtable &operator=(const cofflowtable &table) {
+    if (this == &table)
+      return *this;
+    AcquireReadWriteLock rwlock(flows_lock);
+    AcquireReadLock rlock(table.flows_lock);
+    ofp_version = table.ofp_version;
+    flows = table.flows;
+    observed = table.observed;
+    reconciling = table.reconciling;
+    return *this;
+  };
+
+public:
+  /**
+   *
+   */
+  cofflowtable &set_version(uint8_t ofp_version) {
+    AcquireReadWriteLock rwlock(flows_lock);
+    if (this->ofp_version != ofp_version) {
+      flows.clear();
+      observed.clear();
+      reconciling = false;
+    }
+    this->ofp_version = ofp_version;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint8_t get_version() const { return ofp_version; };
+
+  /**
+   *
+   */
+  size_t size() const {
+    AcquireReadLock rwlock(flows_lock);
+    return flows.size();
+  };
+
+  /**
+   *
+   */
+  void clear() {
+    AcquireReadWriteLock rwlock(flows_lock);
+    flows.clear();
+    observed.clear();
+    reconciling = false;
+  };
+
+public:
+  /**
+   * @brief	Applies a Flow-Mod sent to the datapath to this table.
+   */
+  void flow_mod(const cofflowmod &flowmod);
+
+  /**
+   * @brief	Removes an entry announced by a Flow-Removed message.
+   *
+   * @return true if an entry was removed
+   */
+  bool flow_removed(uint8_t table_id, uint16_t priority,
+                    const cofmatch &match);
+
+  /**
+   *
+   */
+  bool has_flow(uint8_t table_id, uint16_t priority,
+                const cofmatch &match) const;
+
+  /**
+   * @exception eFlowTableNotFound no such entry
+   */
+  cofflowmod get_flow(uint8_t table_id, uint16_t priority,
+                      const cofmatch &match) const;
+
+public:
+  /**
+   * @brief	Starts reconciliation with the datapath's flow-stats.
+   */
+  void reconcile_begin();
+
+  /**
+   * @brief	Adds a (partial) flow-stats dump received from the datapath.
+   */
+  void reconcile_add(const cofflowstatsarray &stats);
+
+  /**
+   * @brief	Terminates reconciliation and calculates the delta.
+   *
+   * Entries shadowed but missing on the datapath are re-added, unless
+   * they carry an idle or hard timeout, in which case they are assumed
+   * to have expired and are removed from this table. Entries found on
+   * the datapath but not shadowed are deleted. Entries with different
+   * instructions are modified or, if their cookie differs, replaced.
+   *
+   * @param delta vector receiving the Flow-Mods to be sent
+   * @return number of Flow-Mods appended to delta
+   */
+  size_t reconcile_end(std::vector<cofflowmod> &delta);
+
+  /**
+   * @brief	Drops all flow-stats collected since reconcile_begin().
+   */
+  void reconcile_abort();
+
+  /**
+   *
+   */
+  bool reconcile_in_progress() const {
+    AcquireReadLock rwlock(flows_lock);
+    return reconciling;
+  };
+
+public:
+  friend std::ostream &operator<<(std::ostream &os,
+                                  cofflowtable const &table) {
+    AcquireReadLock rwlock(table.flows_lock);
+    os << "<cofflowtable ofp-version:" << (int)table.ofp_version
+       << " #flows: " << table.flows.size() << " >" << std::endl;
+    for (auto it : table.flows) {
+      os << it.second;
+    }
+    return os;
+  };
+
+private:
+  class key_t {
+  public:
+    key_t(uint8_t ofp_version, uint8_t table_id, uint16_t priority,
+          const cofmatch &match);
+
+    bool operator<(const key_t &key) const {
+      if (table_id != key.table_id)
+        return (table_id < key.table_id);
+      if (priority != key.priority)
+        return (priority < key.priority);
+      return (match.compare(key.match) < 0);
+    };
+
+    uint8_t table_id;
+    uint16_t priority;
+    coxmatches match; // compared canonically, see coxmatches::compare()
+  };
+
+  /**
+   *
+   */
+  bool is_modified(const cofflowmod &desired,
+                   const cofflowmod &observed) const;
+
+  /**
+   *
+   */
+  bool covers(const cofflowmod &flowmod, const cofflowmod &entry) const;
+
+  /**
+   *
+   */
+  void set_flow_actions(cofflowmod &entry, const cofflowmod &flowmod) const;
+
+private:
+  uint8_t ofp_version;
+
+  // desired state as sent to the datapath
+  std::map<key_t, cofflowmod> flows;
+
+  // state reported by the datapath during reconciliation
+  std::map<key_t, cofflowmod> observed;
+
+  bool reconciling;
+
+  mutable rofl::crwlock flows_lock;
+};
+
+}; // end of namespace openflow
+}; // end of namespace rofl
+
+#endif /* ROFL_COMMON_OPENFLOW_COFFLOWTABLE_H */
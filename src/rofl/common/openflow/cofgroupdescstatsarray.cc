@@ -11,6 +11,10 @@
 
 #include "rofl/common/openflow/cofgroupdescstatsarray.h"
 
+#include <vector>
+
+#include "rofl/common/cworkerpool.hpp"
+
 using namespace rofl::openflow;
 
 size_t cofgroupdescstatsarray::length() const {
@@ -32,7 +36,8 @@ void cofgroupdescstatsarray::pack(uint8_t *buf, size_t buflen) {
 
   switch (ofp_version) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     for (std::map<uint32_t, cofgroup_desc_stats_reply>::iterator it =
              array.begin();
@@ -50,6 +55,9 @@ void cofgroupdescstatsarray::pack(uint8_t *buf, size_t buflen) {
 void cofgroupdescstatsarray::unpack(uint8_t *buf, size_t buflen) {
   array.clear();
 
+  /* pre-scan entry boundaries, a later entry for the same group wins */
+  std::map<uint32_t, std::pair<uint8_t *, size_t>> entries;
+
   switch (ofp_version) {
   case rofl::openflow12::OFP_VERSION: {
 
@@ -58,32 +66,35 @@ void cofgroupdescstatsarray::unpack(uint8_t *buf, size_t buflen) {
       size_t length = be16toh(
           ((struct rofl::openflow12::ofp_group_desc_stats *)buf)->length);
 
-      if (length < sizeof(struct rofl::openflow12::ofp_group_desc_stats))
+      if ((length < sizeof(struct rofl::openflow12::ofp_group_desc_stats)) ||
+          (length > buflen))
         throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
       uint32_t group_id = be32toh(
           ((struct rofl::openflow12::ofp_group_desc_stats *)buf)->group_id);
 
-      add_group_desc_stats(group_id).unpack(buf, length);
+      entries[group_id] = std::make_pair(buf, length);
 
       buf += length;
       buflen -= length;
     }
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     while (buflen >= sizeof(struct rofl::openflow13::ofp_group_desc)) {
 
       size_t length =
           be16toh(((struct rofl::openflow13::ofp_group_desc *)buf)->length);
 
-      if (length < sizeof(struct rofl::openflow13::ofp_group_desc))
+      if ((length < sizeof(struct rofl::openflow13::ofp_group_desc)) ||
+          (length > buflen))
         throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
       uint32_t group_id =
           be32toh(((struct rofl::openflow13::ofp_group_desc *)buf)->group_id);
 
-      add_group_desc_stats(group_id).unpack(buf, length);
+      entries[group_id] = std::make_pair(buf, length);
 
       buf += length;
       buflen -= length;
@@ -93,4 +104,20 @@ void cofgroupdescstatsarray::unpack(uint8_t *buf, size_t buflen) {
     throw eBadRequestBadVersion("eBadRequestBadVersion", __FILE__, __FUNCTION__,
                                 __LINE__);
   }
+
+  std::vector<std::pair<cofgroup_desc_stats_reply *,
+                        std::pair<uint8_t *, size_t>>> group_descs;
+  for (auto it : entries) {
+    group_descs.push_back(
+        std::make_pair(&add_group_desc_stats(it.first), it.second));
+  }
+
+  /* entries are independent, decode them on the worker pool if enabled */
+  rofl::cworkerpool::for_each_chunk(
+      group_descs.size(), [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+          group_descs[i].first->unpack(group_descs[i].second.first,
+                                       group_descs[i].second.second);
+        }
+      });
 }
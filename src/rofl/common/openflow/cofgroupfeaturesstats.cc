@@ -9,7 +9,8 @@ using namespace rofl::openflow;
 size_t cofgroup_features_stats_reply::length() const {
   switch (of_version) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow12::ofp_group_features_stats));
   } break;
   default:
@@ -21,7 +22,8 @@ size_t cofgroup_features_stats_reply::length() const {
 void cofgroup_features_stats_reply::pack(uint8_t *buf, size_t buflen) const {
   switch (of_version) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < length())
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
     struct rofl::openflow12::ofp_group_features_stats *fs =
@@ -41,7 +43,8 @@ void cofgroup_features_stats_reply::pack(uint8_t *buf, size_t buflen) const {
 void cofgroup_features_stats_reply::unpack(uint8_t *buf, size_t buflen) {
   switch (of_version) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < sizeof(struct rofl::openflow12::ofp_group_features_stats))
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
@@ -9,7 +9,8 @@ using namespace rofl::openflow;
 size_t cofgroupmod::length() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct ofp_group_mod) + buckets.length());
   } break;
   default:
@@ -27,7 +28,8 @@ void cofgroupmod::pack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct ofp_group_mod *hdr = (struct ofp_group_mod *)buf;
 
@@ -57,7 +59,8 @@ void cofgroupmod::unpack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct ofp_group_mod *hdr = (struct ofp_group_mod *)buf;
 
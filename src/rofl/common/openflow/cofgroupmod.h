@@ -153,7 +153,8 @@ public:
     os << "cmd:";
     switch (groupmod.ofp_version) {
     case openflow12::OFP_VERSION:
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       switch (groupmod.get_command()) {
       case rofl::openflow13::OFPGC_ADD:
         os << "ADD ";
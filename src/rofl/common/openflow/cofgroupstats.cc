@@ -12,7 +12,8 @@ size_t cofgroup_stats_request::length() const {
   case rofl::openflow12::OFP_VERSION: {
     return (sizeof(struct rofl::openflow12::ofp_group_stats_request));
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_group_stats_request));
   } break;
   default:
@@ -34,7 +35,8 @@ void cofgroup_stats_request::pack(uint8_t *buf, size_t buflen) const {
     stats->group_id = htobe32(group_id);
 
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < sizeof(struct rofl::openflow13::ofp_group_stats_request))
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
@@ -63,7 +65,8 @@ void cofgroup_stats_request::unpack(uint8_t *buf, size_t buflen) {
     group_id = be32toh(stats->group_id);
 
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < sizeof(struct rofl::openflow13::ofp_group_stats_request)) {
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
     }
@@ -85,7 +88,8 @@ size_t cofgroup_stats_reply::length() const {
     return (sizeof(struct rofl::openflow12::ofp_group_stats) +
             bucket_counters.length());
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_group_stats) +
             bucket_counters.length());
   } break;
@@ -118,7 +122,8 @@ void cofgroup_stats_reply::pack(uint8_t *buf, size_t buflen) {
                          bucket_counters.length());
 
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     if (buflen < length())
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
@@ -178,7 +183,8 @@ void cofgroup_stats_reply::unpack(uint8_t *buf, size_t buflen) {
     }
 
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < sizeof(struct rofl::openflow13::ofp_group_stats))
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
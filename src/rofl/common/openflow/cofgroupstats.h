@@ -322,7 +322,8 @@ public:
     os << "<byte-count: 0x" << (int)r.get_byte_count() << " >" << std::endl;
     os << std::dec;
     switch (r.get_version()) {
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       os << std::hex;
       os << "<duration-sec: 0x" << (int)r.get_duration_sec() << " >"
          << std::endl;
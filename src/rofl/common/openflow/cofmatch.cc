@@ -29,13 +29,26 @@ bool cofmatch::operator==(const cofmatch &match) const {
           (type == match.type));
 }
 
+bool cofmatch::operator<(const cofmatch &match) const {
+  if (of_version != match.of_version)
+    return (of_version < match.of_version);
+  if (type != match.type)
+    return (type < match.type);
+  return (matches.compare(match.matches) < 0);
+}
+
+size_t cofmatch::hash() const {
+  return matches.hash() ^ (((size_t)of_version << 16) | type);
+}
+
 size_t cofmatch::length() const {
   switch (of_version) {
   case rofl::openflow10::OFP_VERSION: {
     return sizeof(struct rofl::openflow10::ofp_match);
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     size_t total_length =
         2 * sizeof(uint16_t) +
         matches.length(); // type-field + length-field + OXM-TLV list
@@ -60,6 +73,7 @@ void cofmatch::pack(uint8_t *buf, size_t buflen) {
     break;
   case rofl::openflow12::OFP_VERSION:
   case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
     return pack_of13(buf, buflen);
     break;
   default:
@@ -74,6 +88,7 @@ void cofmatch::unpack(uint8_t *buf, size_t buflen) {
     break;
   case rofl::openflow12::OFP_VERSION:
   case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
     unpack_of13(buf, buflen);
     break;
   default:
@@ -367,413 +382,14 @@ void cofmatch::unpack_of13(uint8_t *buf, size_t buflen) {
 void cofmatch::check_prerequisites() const {
   switch (of_version) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     /*
      * these are generic prerequisites as defined in OF 1.3, section 7.2.3.6,
-     * page 53 ff.
+     * page 53 ff., see coxmatch_fields for the rule table
      */
-    if (matches.has_ofb_in_phy_port()) {
-      if (not matches.has_ofb_in_port()) {
-        std::cerr << "[rofl][match] rejecting ofp_match: IN-PHY-PORT defined "
-                     "while no IN-PORT is present"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_vlan_pcp()) {
-      if (openflow::OFPVID_NONE == matches.get_ofb_vlan_vid().get_u16value()) {
-        std::cerr << "[rofl][match] rejecting ofp_match: VLAN-PCP defined "
-                     "while VID is set to OFPVID-NONE"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_ip_dscp()) {
-      if ((not matches.has_ofb_eth_type()) ||
-          ((matches.get_ofb_eth_type().get_u16value() != 0x0800) &&
-           (matches.get_ofb_eth_type().get_u16value() != 0x86dd))) {
-        std::cerr << "[rofl][match] rejecting ofp_match: IP-DSCP defined while "
-                     "ETH-TYPE is not IPv4/IPv6"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_ip_ecn()) {
-      if ((not matches.has_ofb_eth_type()) ||
-          ((matches.get_ofb_eth_type().get_u16value() != 0x0800) &&
-           (matches.get_ofb_eth_type().get_u16value() != 0x86dd))) {
-        std::cerr << "[rofl][match] rejecting ofp_match: IP-ECN defined while "
-                     "ETH-TYPE is not IPv4/IPv6"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_ip_proto()) {
-      if ((not matches.has_ofb_eth_type()) ||
-          ((matches.get_ofb_eth_type().get_u16value() != 0x0800) &&
-           (matches.get_ofb_eth_type().get_u16value() != 0x86dd))) {
-        std::cerr << "[rofl][match] rejecting ofp_match: IP-PROTO defined "
-                     "while ETH-TYPE is not IPv4/IPv6"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_ipv4_src()) {
-      if ((not matches.has_ofb_eth_type()) ||
-          (matches.get_ofb_eth_type().get_u16value() != 0x0800)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: IPV4-SRC defined "
-                     "while ETH-TYPE is not IPv4"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_ipv4_dst()) {
-      if ((not matches.has_ofb_eth_type()) ||
-          (matches.get_ofb_eth_type().get_u16value() != 0x0800)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: IPV4-DST defined "
-                     "while ETH-TYPE is not IPv4"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_tcp_src()) {
-      if ((not matches.has_ofb_ip_proto()) ||
-          (matches.get_ofb_ip_proto().get_u8value() != 6)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: TCP-SRC defined while "
-                     "IP-PROTO is not TCP"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_tcp_dst()) {
-      if ((not matches.has_ofb_ip_proto()) ||
-          (matches.get_ofb_ip_proto().get_u8value() != 6)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: TCP-DST defined while "
-                     "IP-PROTO is not TCP"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_udp_src()) {
-      if ((not matches.has_ofb_ip_proto()) ||
-          (matches.get_ofb_ip_proto().get_u8value() != 17)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: UDP-SRC defined while "
-                     "IP-PROTO is not UDP"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_udp_dst()) {
-      if ((not matches.has_ofb_ip_proto()) ||
-          (matches.get_ofb_ip_proto().get_u8value() != 17)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: UDP-DST defined while "
-                     "IP-PROTO is not UDP"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_sctp_src()) {
-      if ((not matches.has_ofb_ip_proto()) ||
-          (matches.get_ofb_ip_proto().get_u8value() != 132)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: SCTP-SRC defined "
-                     "while IP-PROTO is not SCTP"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_sctp_dst()) {
-      if ((not matches.has_ofb_ip_proto()) ||
-          (matches.get_ofb_ip_proto().get_u8value() != 132)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: SCTP-DST defined "
-                     "while IP-PROTO is not SCTP"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_icmpv4_type()) {
-      if ((not matches.has_ofb_ip_proto()) ||
-          (matches.get_ofb_ip_proto().get_u8value() != 1)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: ICMPV4-TYPE defined "
-                     "while IP-PROTO is not ICMPV4"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_icmpv4_code()) {
-      if ((not matches.has_ofb_ip_proto()) ||
-          (matches.get_ofb_ip_proto().get_u8value() != 1)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: ICMPV4-CODE defined "
-                     "while IP-PROTO is not ICMPV4"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_arp_opcode()) {
-      if ((not matches.has_ofb_eth_type()) ||
-          (matches.get_ofb_eth_type().get_u16value() != 0x0806)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: ARP-OPCODE defined "
-                     "while ETH-TYPE is not ARP"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_arp_spa()) {
-      if ((not matches.has_ofb_eth_type()) ||
-          (matches.get_ofb_eth_type().get_u16value() != 0x0806)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: ARP-SPA defined while "
-                     "ETH-TYPE is not ARP"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_arp_tpa()) {
-      if ((not matches.has_ofb_eth_type()) ||
-          (matches.get_ofb_eth_type().get_u16value() != 0x0806)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: ARP-TPA defined while "
-                     "ETH-TYPE is not ARP"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_arp_sha()) {
-      if ((not matches.has_ofb_eth_type()) ||
-          (matches.get_ofb_eth_type().get_u16value() != 0x0806)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: ARP-SHA defined while "
-                     "ETH-TYPE is not ARP"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_arp_tha()) {
-      if ((not matches.has_ofb_eth_type()) ||
-          (matches.get_ofb_eth_type().get_u16value() != 0x0806)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: ARP-THA defined while "
-                     "ETH-TYPE is not ARP"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_ipv6_src()) {
-      if ((not matches.has_ofb_eth_type()) ||
-          (matches.get_ofb_eth_type().get_u16value() != 0x86dd)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: IPV6-SRC defined "
-                     "while ETH-TYPE is not IPv6"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_ipv6_dst()) {
-      if ((not matches.has_ofb_eth_type()) ||
-          (matches.get_ofb_eth_type().get_u16value() != 0x86dd)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: IPV6-DST defined "
-                     "while ETH-TYPE is not IPv6"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_ipv6_flabel()) {
-      if ((not matches.has_ofb_eth_type()) ||
-          (matches.get_ofb_eth_type().get_u16value() != 0x86dd)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: IPV6-FLABEL defined "
-                     "while ETH-TYPE is not IPv6"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_icmpv6_type()) {
-      if ((not matches.has_ofb_ip_proto()) ||
-          (matches.get_ofb_ip_proto().get_u8value() != 58)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: ICMPV6-TYPE defined "
-                     "while IP-PROTO is not ICMPV6"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_icmpv6_code()) {
-      if ((not matches.has_ofb_ip_proto()) ||
-          (matches.get_ofb_ip_proto().get_u8value() != 58)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: ICMPV6-CODE defined "
-                     "while IP-PROTO is not ICMPV6"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_ipv6_nd_target()) {
-      if ((not matches.has_ofb_icmpv6_type()) ||
-          ((matches.get_ofb_icmpv6_type().get_u8value() != 135) &&
-           (matches.get_ofb_icmpv6_type().get_u8value() != 136))) {
-        std::cerr << "[rofl][match] rejecting ofp_match: IPv6-ND-TARGET "
-                     "defined while ICMPV6-TYPE is not ND-SOLICITATION or "
-                     "ND-ADVERTISEMENT"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_ipv6_nd_sll()) {
-      if ((not matches.has_ofb_icmpv6_type()) ||
-          (matches.get_ofb_icmpv6_type().get_u8value() != 135)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: IPv6-ND-SLL defined "
-                     "while ICMPV6-TYPE is not ND-SOLICITATION"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_ipv6_nd_tll()) {
-      if ((not matches.has_ofb_icmpv6_type()) ||
-          (matches.get_ofb_icmpv6_type().get_u8value() != 136)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: IPv6-ND-TLL defined "
-                     "while ICMPV6-TYPE is not ND-ADVERTISEMENT"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_mpls_label()) {
-      if ((not matches.has_ofb_eth_type()) ||
-          ((matches.get_ofb_eth_type().get_u16value() != 0x8847) &&
-           (matches.get_ofb_eth_type().get_u16value() != 0x8848))) {
-        std::cerr << "[rofl][match] rejecting ofp_match: MPLS-LABEL defined "
-                     "while ETH-TYPE is not MPLS/MPLS-UPSTREAM"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_mpls_tc()) {
-      if ((not matches.has_ofb_eth_type()) ||
-          ((matches.get_ofb_eth_type().get_u16value() != 0x8847) &&
-           (matches.get_ofb_eth_type().get_u16value() != 0x8848))) {
-        std::cerr << "[rofl][match] rejecting ofp_match: MPLS-TC defined while "
-                     "ETH-TYPE is not MPLS/MPLS-UPSTREAM"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_mpls_bos()) {
-      if ((not matches.has_ofb_eth_type()) ||
-          ((matches.get_ofb_eth_type().get_u16value() != 0x8847) &&
-           (matches.get_ofb_eth_type().get_u16value() != 0x8848))) {
-        std::cerr << "[rofl][match] rejecting ofp_match: MPLS-BOS defined "
-                     "while ETH-TYPE is not MPLS/MPLS-UPSTREAM"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_pbb_isid()) {
-      if ((not matches.has_ofb_eth_type()) ||
-          (matches.get_ofb_eth_type().get_u16value() != 0x88e7)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: PBB-ISID defined "
-                     "while ETH-TYPE is not PBB"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
-
-    if (matches.has_ofb_ipv6_exthdr()) {
-      if ((not matches.has_ofb_eth_type()) ||
-          (matches.get_ofb_eth_type().get_u16value() != 0x86dd)) {
-        std::cerr << "[rofl][match] rejecting ofp_match: IPV6-EXTHDR defined "
-                     "while ETH-TYPE is not IPv6"
-                  << std::endl
-                  << matches;
-        throw eBadMatchBadPrereq("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
-                                 __LINE__);
-      }
-    }
+    matches.check_prerequisites();
 
   } break;
   default: {
@@ -52,10 +52,25 @@ public:
   cofmatch &operator=(const cofmatch &match);
 
   /**
-   *
+   * @brief	Equality by version, type and canonical OXMs
    */
   bool operator==(const cofmatch &m) const;
 
+  /**
+   * @brief	Strict weak ordering by version, type and canonical OXMs
+   *
+   * See coxmatches::compare() for the normalization of masked fields.
+   */
+  bool operator<(const cofmatch &m) const;
+
+  /**
+   * @brief	Returns a hash value over version, type and canonical OXMs
+   *
+   * Matches that are equal under operator== (neither orders before the
+   * other under operator<) yield the same value.
+   */
+  size_t hash() const;
+
 public:
   /**
    *
@@ -156,7 +171,8 @@ public:
     os << "<cofmatch ofp-version:" << (int)m.get_version() << " >" << std::endl;
     switch (m.of_version) {
     case rofl::openflow12::OFP_VERSION:
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       os << "<type: " << m.type << " >" << std::endl;
     } break;
     }
@@ -716,4 +732,13 @@ public:
 }; // end of namespace openflow
 }; // end of namespace rofl
 
+namespace std {
+/* equal values under operator== hash equally, see cofmatch::hash() */
+template <> struct hash<rofl::openflow::cofmatch> {
+  size_t operator()(const rofl::openflow::cofmatch &match) const {
+    return match.hash();
+  };
+};
+}; // end of namespace std
+
 #endif
@@ -189,7 +189,8 @@ bool cofmeter_bands::has_meter_band_experimenter(unsigned int index) const {
 
 size_t cofmeter_bands::length() const {
   switch (of_version) {
-  case openflow13::OFP_VERSION: {
+  case openflow13::OFP_VERSION:
+  case openflow14::OFP_VERSION: {
     size_t len = 0;
     for (std::map<unsigned int, cofmeter_band_drop>::const_iterator it =
              mbs_drop.begin();
@@ -223,7 +224,8 @@ void cofmeter_bands::pack(uint8_t *buf, size_t buflen) {
   unsigned int offset = 0;
 
   switch (of_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     for (std::map<unsigned int, cofmeter_band_drop>::iterator it =
              mbs_drop.begin();
          it != mbs_drop.end(); ++it) {
@@ -258,7 +260,8 @@ void cofmeter_bands::unpack(uint8_t *buf, size_t buflen) {
   clear();
 
   switch (of_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     unsigned int offset = 0;
     unsigned int index_drop = 0;
     unsigned int index_dscp_remark = 0;
@@ -91,7 +91,8 @@ const bool cofmeter_band_stats_array::has_mbstats(unsigned int index) const {
 
 size_t cofmeter_band_stats_array::length() const {
   switch (of_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     size_t len = 0;
     for (std::map<unsigned int, cofmeter_band_stats>::const_iterator it =
              array.begin();
@@ -110,7 +111,8 @@ void cofmeter_band_stats_array::pack(uint8_t *buf, size_t buflen) {
     return;
 
   switch (of_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     if (buflen < length())
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
@@ -132,7 +134,8 @@ void cofmeter_band_stats_array::pack(uint8_t *buf, size_t buflen) {
 
 void cofmeter_band_stats_array::unpack(uint8_t *buf, size_t buflen) {
   switch (of_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     clear();
 
@@ -56,7 +56,8 @@ void cofmeter_features_reply::clear() {
 
 size_t cofmeter_features_reply::length() const {
   switch (of_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_meter_features));
   } break;
   default:
@@ -70,7 +71,8 @@ void cofmeter_features_reply::pack(uint8_t *buf, size_t buflen) {
     return;
 
   switch (of_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < length())
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
@@ -94,7 +96,8 @@ void cofmeter_features_reply::unpack(uint8_t *buf, size_t buflen) {
     return;
 
   switch (of_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     if (buflen < length())
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
@@ -31,7 +31,8 @@ void cofmeterstatsarray::pack(uint8_t *buf, size_t buflen) {
     throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
   switch (ofp_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     for (std::map<unsigned int, cofmeter_stats_reply>::iterator it =
              array.begin();
@@ -56,7 +57,8 @@ void cofmeterstatsarray::unpack(uint8_t *buf, size_t buflen) {
   unsigned int index = 0;
 
   switch (ofp_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     while ((buflen - offset) >=
            sizeof(struct rofl::openflow13::ofp_meter_stats)) {
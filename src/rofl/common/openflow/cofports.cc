@@ -45,6 +45,16 @@ void cofports::pack(uint8_t *buf, size_t buflen) {
       buf += port.length();
     }
   } break;
+  case rofl::openflow14::OFP_VERSION: {
+    // variable length: fixed header plus port description properties
+    for (std::map<uint32_t, cofport *>::iterator it = ports.begin();
+         it != ports.end(); ++it) {
+      cofport &port = *(it->second);
+      size_t portlen = port.length();
+      port.pack(buf, portlen);
+      buf += portlen;
+    }
+  } break;
   default:
     throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
   }
@@ -97,6 +107,27 @@ void cofports::unpack(uint8_t *buf, size_t buflen) {
       buf += sizeof(struct rofl::openflow13::ofp_port);
       buflen -= sizeof(struct rofl::openflow13::ofp_port);
 
+    } break;
+    case rofl::openflow14::OFP_VERSION: {
+      if (buflen < sizeof(struct rofl::openflow14::ofp_port))
+        return;
+
+      // each entry carries its own length including all properties
+      size_t portlen =
+          be16toh(((struct rofl::openflow14::ofp_port *)buf)->length);
+      if ((portlen < sizeof(struct rofl::openflow14::ofp_port)) ||
+          (portlen > buflen))
+        throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+      cofport port(ofp_version, buf, portlen);
+      if (ports.find(port.get_port_no()) != ports.end()) {
+        delete ports[port.get_port_no()];
+      }
+      ports[port.get_port_no()] = new cofport(port);
+
+      buf += portlen;
+      buflen -= portlen;
+
     } break;
     default:
       throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
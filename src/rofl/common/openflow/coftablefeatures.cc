@@ -8,7 +8,8 @@ using namespace rofl::openflow;
 
 size_t coftable_features::length() const {
   switch (get_version()) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_table_features) +
             properties.length());
   } break;
@@ -22,7 +23,8 @@ void coftable_features::pack(uint8_t *buf, size_t buflen) {
     return;
 
   switch (ofp_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < coftable_features::length())
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
@@ -51,7 +53,8 @@ void coftable_features::pack(uint8_t *buf, size_t buflen) {
 
 void coftable_features::unpack(uint8_t *buf, size_t buflen) {
   switch (ofp_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < sizeof(struct rofl::openflow13::ofp_table_features))
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
@@ -14,7 +14,8 @@ size_t coftable_stats_reply::length() const {
   case rofl::openflow12::OFP_VERSION: {
     return (sizeof(struct rofl::openflow12::ofp_table_stats));
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_table_stats));
   } break;
   default:
@@ -68,7 +69,8 @@ void coftable_stats_reply::pack(uint8_t *buf, size_t buflen) const {
     table_stats->matched_count = htobe64(matched_count);
 
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < sizeof(struct rofl::openflow13::ofp_table_stats))
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
@@ -131,7 +133,8 @@ void coftable_stats_reply::unpack(uint8_t *buf, size_t buflen) {
     matched_count = be64toh(table_stats->matched_count);
 
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < sizeof(struct rofl::openflow13::ofp_table_stats))
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
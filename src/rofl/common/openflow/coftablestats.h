@@ -433,7 +433,8 @@ public:
       os << " matched-count:" << (unsigned long long)tsr.matched_count << " >"
          << std::endl;
     } break;
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       os << "<coftable_stats_reply ofp-version:" << (int)tsr.of_version << " >"
          << std::endl;
       os << std::hex;
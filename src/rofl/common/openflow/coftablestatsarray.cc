@@ -33,7 +33,8 @@ void coftablestatsarray::pack(uint8_t *buf, size_t buflen) {
   switch (ofp_version) {
   case rofl::openflow10::OFP_VERSION:
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     for (std::map<uint8_t, coftable_stats_reply>::iterator it = array.begin();
          it != array.end(); ++it) {
@@ -79,7 +80,8 @@ void coftablestatsarray::unpack(uint8_t *buf, size_t buflen) {
       buflen -= sizeof(struct rofl::openflow12::ofp_table_stats);
     }
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     while (buflen >= sizeof(struct rofl::openflow13::ofp_table_stats)) {
 
@@ -0,0 +1,237 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef ROFL_COMMON_OPENFLOW_COXMATCH_FIELDS_H
+#define ROFL_COMMON_OPENFLOW_COXMATCH_FIELDS_H 1
+
+#include <inttypes.h>
+#include <stddef.h>
+
+#include "rofl/common/openflow/openflow_common.h"
+
+namespace rofl {
+namespace openflow {
+
+/**
+ * @brief	Static properties of an OpenFlow basic class OXM field
+ */
+struct coxmatch_field {
+  enum prereq_t {
+    PREREQ_NONE = 0,      // no prerequisite
+    PREREQ_PRESENT = 1,   // prereq_field must be present
+    PREREQ_VALUE = 2,     // prereq_field must match one of prereq_values
+    PREREQ_NOT_VALUE = 3, // prereq_field must match none of prereq_values
+  };
+
+  uint32_t oxm_id;            // OXM header without mask flag
+  uint8_t width;              // length of the value in bytes
+  bool maskable;              // field may carry a mask
+  const char *name;           // name used in diagnostics
+  uint8_t prereq;             // prereq_t
+  uint8_t prereq_field;       // OFPXMT_OFB_* the prerequisite refers to
+  uint8_t prereq_num;         // number of valid entries in prereq_values
+  uint16_t prereq_values[2];  // admitted or rejected values of prereq_field
+};
+
+/**
+ * @brief	Descriptor table for all OpenFlow basic class OXM fields
+ *
+ * The table is indexed by the OFPXMT_OFB_* field number and holds width,
+ * maskability and prerequisites as defined in OF 1.3, section 7.2.3.6.
+ * Prerequisite values refer to 8bit or 16bit fields only.
+ * coxmatches::unpack() and coxmatches::check_prerequisites() are driven
+ * by it, the consistency with the OXM_TLV_BASIC_* constants is verified
+ * at compile time.
+ */
+class coxmatch_fields {
+public:
+  static constexpr coxmatch_field fields[OFPXMT_OFB_MAX] = {
+      {OXM_TLV_BASIC_IN_PORT, 4, false, "IN-PORT",
+       coxmatch_field::PREREQ_NONE, 0, 0, {0, 0}},
+      {OXM_TLV_BASIC_IN_PHY_PORT, 4, false, "IN-PHY-PORT",
+       coxmatch_field::PREREQ_PRESENT, OFPXMT_OFB_IN_PORT, 0, {0, 0}},
+      {OXM_TLV_BASIC_METADATA, 8, true, "METADATA",
+       coxmatch_field::PREREQ_NONE, 0, 0, {0, 0}},
+      {OXM_TLV_BASIC_ETH_DST, 6, true, "ETH-DST",
+       coxmatch_field::PREREQ_NONE, 0, 0, {0, 0}},
+      {OXM_TLV_BASIC_ETH_SRC, 6, true, "ETH-SRC",
+       coxmatch_field::PREREQ_NONE, 0, 0, {0, 0}},
+      {OXM_TLV_BASIC_ETH_TYPE, 2, false, "ETH-TYPE",
+       coxmatch_field::PREREQ_NONE, 0, 0, {0, 0}},
+      {OXM_TLV_BASIC_VLAN_VID, 2, true, "VLAN-VID",
+       coxmatch_field::PREREQ_NONE, 0, 0, {0, 0}},
+      {OXM_TLV_BASIC_VLAN_PCP, 1, false, "VLAN-PCP",
+       coxmatch_field::PREREQ_NOT_VALUE, OFPXMT_OFB_VLAN_VID, 1,
+       {OFPVID_NONE, 0}},
+      {OXM_TLV_BASIC_IP_DSCP, 1, false, "IP-DSCP",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_ETH_TYPE, 2, {0x0800, 0x86dd}},
+      {OXM_TLV_BASIC_IP_ECN, 1, false, "IP-ECN",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_ETH_TYPE, 2, {0x0800, 0x86dd}},
+      {OXM_TLV_BASIC_IP_PROTO, 1, false, "IP-PROTO",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_ETH_TYPE, 2, {0x0800, 0x86dd}},
+      {OXM_TLV_BASIC_IPV4_SRC, 4, true, "IPV4-SRC",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_ETH_TYPE, 1, {0x0800, 0}},
+      {OXM_TLV_BASIC_IPV4_DST, 4, true, "IPV4-DST",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_ETH_TYPE, 1, {0x0800, 0}},
+      {OXM_TLV_BASIC_TCP_SRC, 2, false, "TCP-SRC",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_IP_PROTO, 1, {6, 0}},
+      {OXM_TLV_BASIC_TCP_DST, 2, false, "TCP-DST",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_IP_PROTO, 1, {6, 0}},
+      {OXM_TLV_BASIC_UDP_SRC, 2, false, "UDP-SRC",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_IP_PROTO, 1, {17, 0}},
+      {OXM_TLV_BASIC_UDP_DST, 2, false, "UDP-DST",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_IP_PROTO, 1, {17, 0}},
+      {OXM_TLV_BASIC_SCTP_SRC, 2, false, "SCTP-SRC",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_IP_PROTO, 1, {132, 0}},
+      {OXM_TLV_BASIC_SCTP_DST, 2, false, "SCTP-DST",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_IP_PROTO, 1, {132, 0}},
+      {OXM_TLV_BASIC_ICMPV4_TYPE, 1, false, "ICMPV4-TYPE",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_IP_PROTO, 1, {1, 0}},
+      {OXM_TLV_BASIC_ICMPV4_CODE, 1, false, "ICMPV4-CODE",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_IP_PROTO, 1, {1, 0}},
+      {OXM_TLV_BASIC_ARP_OP, 2, false, "ARP-OP",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_ETH_TYPE, 1, {0x0806, 0}},
+      {OXM_TLV_BASIC_ARP_SPA, 4, true, "ARP-SPA",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_ETH_TYPE, 1, {0x0806, 0}},
+      {OXM_TLV_BASIC_ARP_TPA, 4, true, "ARP-TPA",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_ETH_TYPE, 1, {0x0806, 0}},
+      {OXM_TLV_BASIC_ARP_SHA, 6, true, "ARP-SHA",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_ETH_TYPE, 1, {0x0806, 0}},
+      {OXM_TLV_BASIC_ARP_THA, 6, true, "ARP-THA",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_ETH_TYPE, 1, {0x0806, 0}},
+      {OXM_TLV_BASIC_IPV6_SRC, 16, true, "IPV6-SRC",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_ETH_TYPE, 1, {0x86dd, 0}},
+      {OXM_TLV_BASIC_IPV6_DST, 16, true, "IPV6-DST",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_ETH_TYPE, 1, {0x86dd, 0}},
+      {OXM_TLV_BASIC_IPV6_FLABEL, 4, true, "IPV6-FLABEL",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_ETH_TYPE, 1, {0x86dd, 0}},
+      {OXM_TLV_BASIC_ICMPV6_TYPE, 1, false, "ICMPV6-TYPE",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_IP_PROTO, 1, {58, 0}},
+      {OXM_TLV_BASIC_ICMPV6_CODE, 1, false, "ICMPV6-CODE",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_IP_PROTO, 1, {58, 0}},
+      {OXM_TLV_BASIC_IPV6_ND_TARGET, 16, false, "IPV6-ND-TARGET",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_ICMPV6_TYPE, 2, {135, 136}},
+      {OXM_TLV_BASIC_IPV6_ND_SLL, 6, false, "IPV6-ND-SLL",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_ICMPV6_TYPE, 1, {135, 0}},
+      {OXM_TLV_BASIC_IPV6_ND_TLL, 6, false, "IPV6-ND-TLL",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_ICMPV6_TYPE, 1, {136, 0}},
+      {OXM_TLV_BASIC_MPLS_LABEL, 4, false, "MPLS-LABEL",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_ETH_TYPE, 2, {0x8847, 0x8848}},
+      {OXM_TLV_BASIC_MPLS_TC, 1, false, "MPLS-TC",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_ETH_TYPE, 2, {0x8847, 0x8848}},
+      {OXM_TLV_BASIC_MPLS_BOS, 1, false, "MPLS-BOS",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_ETH_TYPE, 2, {0x8847, 0x8848}},
+      {OXM_TLV_BASIC_PBB_ISID, 3, true, "PBB-ISID",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_ETH_TYPE, 1, {0x88e7, 0}},
+      {OXM_TLV_BASIC_TUNNEL_ID, 8, true, "TUNNEL-ID",
+       coxmatch_field::PREREQ_NONE, 0, 0, {0, 0}},
+      {OXM_TLV_BASIC_IPV6_EXTHDR, 2, true, "IPV6-EXTHDR",
+       coxmatch_field::PREREQ_VALUE, OFPXMT_OFB_ETH_TYPE, 1, {0x86dd, 0}},
+  };
+
+public:
+  /**
+   * @brief	Returns the OFB field number encoded in an OXM header
+   */
+  static constexpr unsigned field(uint32_t oxm_id) {
+    return (oxm_id >> 9) & 0x7f;
+  };
+
+  /**
+   * @brief	Returns true for the mask flag set in an OXM header
+   */
+  static constexpr bool hasmask(uint32_t oxm_id) {
+    return (oxm_id & HAS_MASK_FLAG) != 0;
+  };
+
+  /**
+   * @brief	Returns true for an OpenFlow basic class field covered by the
+   * table
+   */
+  static constexpr bool is_known(uint32_t oxm_id) {
+    return ((oxm_id >> 16) == OFPXMC_OPENFLOW_BASIC) &&
+           (field(oxm_id) < OFPXMT_OFB_MAX);
+  };
+
+  /**
+   * @brief	Returns the expected oxm_length of a known field
+   */
+  static constexpr size_t length(uint32_t oxm_id) {
+    return (size_t)fields[field(oxm_id)].width << (hasmask(oxm_id) ? 1 : 0);
+  };
+
+  /**
+   * @brief	Returns true, if the oxm_length of a known field is valid
+   */
+  static constexpr bool valid_length(uint32_t oxm_id) {
+    return (oxm_id & 0xff) == length(oxm_id);
+  };
+
+  /**
+   * @brief	Returns true, if the mask flag of a known field is valid
+   */
+  static constexpr bool valid_mask(uint32_t oxm_id) {
+    return (not hasmask(oxm_id)) || fields[field(oxm_id)].maskable;
+  };
+
+  /**
+   * @brief	Returns true, if value matches the prerequisite values of entry
+   */
+  static bool match_prereq(const coxmatch_field &entry, uint16_t value) {
+    bool found = false;
+    for (unsigned i = 0; i < entry.prereq_num; i++) {
+      found |= (entry.prereq_values[i] == value);
+    }
+    return (entry.prereq == coxmatch_field::PREREQ_NOT_VALUE) ? not found
+                                                              : found;
+  };
+
+  /**
+   * @brief	Returns the bitmap of fields carrying a prerequisite
+   */
+  static constexpr uint64_t prereq_fields(unsigned i = 0) {
+    return (i >= OFPXMT_OFB_MAX)
+               ? 0
+               : ((fields[i].prereq != coxmatch_field::PREREQ_NONE)
+                      ? (UINT64_C(1) << i)
+                      : 0) |
+                     prereq_fields(i + 1);
+  };
+
+  /**
+   * @brief	Returns the bitmap of fields whose value is referred to by a
+   * prerequisite
+   */
+  static constexpr uint64_t prereq_targets(unsigned i = 0) {
+    return (i >= OFPXMT_OFB_MAX)
+               ? 0
+               : ((fields[i].prereq > coxmatch_field::PREREQ_PRESENT)
+                      ? (UINT64_C(1) << fields[i].prereq_field)
+                      : 0) |
+                     prereq_targets(i + 1);
+  };
+
+  /**
+   * @brief	Verifies the table entries from index i onwards
+   */
+  static constexpr bool consistent(unsigned i = 0) {
+    return (i >= OFPXMT_OFB_MAX) ||
+           ((field(fields[i].oxm_id) == i) && (not hasmask(fields[i].oxm_id)) &&
+            ((fields[i].oxm_id & 0xff) == fields[i].width) &&
+            (fields[i].prereq_num <= 2) &&
+            ((fields[i].prereq <= coxmatch_field::PREREQ_PRESENT) ||
+             (fields[fields[i].prereq_field].width <= sizeof(uint16_t))) &&
+            ((fields[i].prereq == coxmatch_field::PREREQ_NONE) ||
+             (fields[i].prereq_field < OFPXMT_OFB_MAX)) &&
+            consistent(i + 1));
+  };
+};
+
+static_assert(coxmatch_fields::consistent(),
+              "coxmatch_fields: table out of sync with OXM_TLV_BASIC_*");
+
+}; // end of namespace openflow
+}; // end of namespace rofl
+
+#endif /* ROFL_COMMON_OPENFLOW_COXMATCH_FIELDS_H */
@@ -9,12 +9,70 @@
  *      Author: andreas
  */
 
+#include <endian.h>
 #include <stdexcept>
+#ifndef le64toh
+#include "../endian_conversion.h"
+#endif
 
 #include "rofl/common/openflow/coxmatches.h"
 
 using namespace rofl::openflow;
 
+constexpr coxmatch_field coxmatch_fields::fields[];
+
+/* fields carrying a prerequisite and fields referred to by one */
+static constexpr uint64_t coxmatch_ofb_prereq_fields =
+    coxmatch_fields::prereq_fields();
+static constexpr uint64_t coxmatch_ofb_prereq_targets =
+    coxmatch_fields::prereq_targets();
+
+template <class T> static coxmatch *coxmatch_ofb_create() { return new T(); }
+
+/* factories for OpenFlow basic class fields, indexed by OFPXMT_OFB_* */
+static coxmatch *(*const coxmatch_ofb_factory[OFPXMT_OFB_MAX])() = {
+    &coxmatch_ofb_create<coxmatch_ofb_in_port>,
+    &coxmatch_ofb_create<coxmatch_ofb_in_phy_port>,
+    &coxmatch_ofb_create<coxmatch_ofb_metadata>,
+    &coxmatch_ofb_create<coxmatch_ofb_eth_dst>,
+    &coxmatch_ofb_create<coxmatch_ofb_eth_src>,
+    &coxmatch_ofb_create<coxmatch_ofb_eth_type>,
+    &coxmatch_ofb_create<coxmatch_ofb_vlan_vid>,
+    &coxmatch_ofb_create<coxmatch_ofb_vlan_pcp>,
+    &coxmatch_ofb_create<coxmatch_ofb_ip_dscp>,
+    &coxmatch_ofb_create<coxmatch_ofb_ip_ecn>,
+    &coxmatch_ofb_create<coxmatch_ofb_ip_proto>,
+    &coxmatch_ofb_create<coxmatch_ofb_ipv4_src>,
+    &coxmatch_ofb_create<coxmatch_ofb_ipv4_dst>,
+    &coxmatch_ofb_create<coxmatch_ofb_tcp_src>,
+    &coxmatch_ofb_create<coxmatch_ofb_tcp_dst>,
+    &coxmatch_ofb_create<coxmatch_ofb_udp_src>,
+    &coxmatch_ofb_create<coxmatch_ofb_udp_dst>,
+    &coxmatch_ofb_create<coxmatch_ofb_sctp_src>,
+    &coxmatch_ofb_create<coxmatch_ofb_sctp_dst>,
+    &coxmatch_ofb_create<coxmatch_ofb_icmpv4_type>,
+    &coxmatch_ofb_create<coxmatch_ofb_icmpv4_code>,
+    &coxmatch_ofb_create<coxmatch_ofb_arp_opcode>,
+    &coxmatch_ofb_create<coxmatch_ofb_arp_spa>,
+    &coxmatch_ofb_create<coxmatch_ofb_arp_tpa>,
+    &coxmatch_ofb_create<coxmatch_ofb_arp_sha>,
+    &coxmatch_ofb_create<coxmatch_ofb_arp_tha>,
+    &coxmatch_ofb_create<coxmatch_ofb_ipv6_src>,
+    &coxmatch_ofb_create<coxmatch_ofb_ipv6_dst>,
+    &coxmatch_ofb_create<coxmatch_ofb_ipv6_flabel>,
+    &coxmatch_ofb_create<coxmatch_ofb_icmpv6_type>,
+    &coxmatch_ofb_create<coxmatch_ofb_icmpv6_code>,
+    &coxmatch_ofb_create<coxmatch_ofb_ipv6_nd_target>,
+    &coxmatch_ofb_create<coxmatch_ofb_ipv6_nd_sll>,
+    &coxmatch_ofb_create<coxmatch_ofb_ipv6_nd_tll>,
+    &coxmatch_ofb_create<coxmatch_ofb_mpls_label>,
+    &coxmatch_ofb_create<coxmatch_ofb_mpls_tc>,
+    &coxmatch_ofb_create<coxmatch_ofb_mpls_bos>,
+    &coxmatch_ofb_create<coxmatch_ofb_pbb_isid>,
+    &coxmatch_ofb_create<coxmatch_ofb_tunnel_id>,
+    &coxmatch_ofb_create<coxmatch_ofb_ipv6_exthdr>,
+};
+
 coxmatches::coxmatches() {}
 
 coxmatches::~coxmatches() { clear(); }
@@ -30,19 +88,124 @@ coxmatches &coxmatches::operator=(coxmatches const &oxms) {
 }
 
 bool coxmatches::operator==(coxmatches const &oxms) const {
-  if (matches.size() != oxms.matches.size()) {
-    return false;
+  return (compare(oxms) == 0);
+}
+
+size_t coxmatches::canonicalize(coxmatch &oxm, uint8_t *buf, size_t buflen) {
+  size_t len = oxm.length();
+  if (len > buflen)
+    throw eOxmBadLen("coxmatches::canonicalize() buf too short");
+  oxm.pack(buf, len);
+
+  uint32_t oxm_id;
+  memcpy(&oxm_id, buf, sizeof(oxm_id));
+  oxm_id = be32toh(oxm_id);
+  if (not(oxm_id & 0x00000100))
+    return len;
+
+  size_t hdrlen = sizeof(uint32_t);
+  if ((oxm_id >> 16) == rofl::openflow::OFPXMC_EXPERIMENTER)
+    hdrlen += sizeof(uint32_t);
+  if (len < hdrlen)
+    throw eOxmBadLen("coxmatches::canonicalize() invalid oxm_length");
+  size_t vlen = (len - hdrlen) / 2;
+
+  // apply mask to value and look for trivial masks
+  uint8_t *value = buf + hdrlen;
+  uint8_t *mask = value + vlen;
+  bool zeros = true, ones = true;
+  for (size_t i = 0; i < vlen; i++) {
+    value[i] &= mask[i];
+    zeros = zeros && (mask[i] == 0x00);
+    ones = ones && (mask[i] == 0xff);
   }
-  for (std::map<uint64_t, coxmatch *>::const_iterator it = matches.begin();
-       it != matches.end(); ++it) {
-    if (oxms.matches.find(it->first) == oxms.matches.end()) {
-      return false;
+
+  // matches any value, equal to a missing field
+  if (zeros)
+    return 0;
+
+  // matches a single value, equal to an unmasked field
+  if (ones) {
+    oxm_id = (oxm_id & 0xfffffe00) | ((oxm_id & 0x000000ff) - vlen);
+    oxm_id = htobe32(oxm_id);
+    memcpy(buf, &oxm_id, sizeof(oxm_id));
+    return len - vlen;
+  }
+
+  return len;
+}
+
+int coxmatches::compare(coxmatches const &oxms) const {
+  if (this == &oxms)
+    return 0;
+
+  AcquireReadLock llock(rwlock);
+  AcquireReadLock rlock(oxms.rwlock);
+
+  uint8_t lbuf[OXM_MAX_LEN];
+  uint8_t rbuf[OXM_MAX_LEN];
+  size_t llen = 0, rlen = 0;
+
+  auto it = matches.begin();
+  auto jt = oxms.matches.begin();
+  while (true) {
+    // skip fields with a mask of all zeros
+    for (; (it != matches.end()) &&
+           (0 == (llen = canonicalize(*it->second, lbuf, sizeof(lbuf))));
+         ++it)
+      ;
+    for (; (jt != oxms.matches.end()) &&
+           (0 == (rlen = canonicalize(*jt->second, rbuf, sizeof(rbuf))));
+         ++jt)
+      ;
+
+    if ((it == matches.end()) || (jt == oxms.matches.end())) {
+      return (int)(jt == oxms.matches.end()) - (int)(it == matches.end());
     }
-    if (*it->second != *oxms.matches.at(it->first)) {
-      return false;
+    if (it->first != jt->first) {
+      return (it->first < jt->first) ? -1 : 1;
+    }
+    int rc = memcmp(lbuf, rbuf, std::min(llen, rlen));
+    if (rc != 0) {
+      return rc;
     }
+    if (llen != rlen) {
+      return (llen < rlen) ? -1 : 1;
+    }
+    ++it;
+    ++jt;
   }
-  return true;
+}
+
+size_t coxmatches::hash() const {
+  AcquireReadLock lock(rwlock);
+
+  // word-wise multiply/xor over the canonical TLVs, read as little endian
+  // words for identical values on all hosts
+  const uint64_t prime = __UINT64_C(0x9e3779b97f4a7c15);
+  uint64_t h = __UINT64_C(0xcbf29ce484222325);
+  uint64_t buf[(OXM_MAX_LEN + sizeof(uint64_t) - 1) / sizeof(uint64_t)];
+
+  for (auto &it : matches) {
+    size_t len = canonicalize(*it.second, (uint8_t *)buf, OXM_MAX_LEN);
+    if (0 == len)
+      continue;
+    size_t words = (len + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    memset((uint8_t *)buf + len, 0, words * sizeof(uint64_t) - len);
+    h = (h ^ len) * prime;
+    for (size_t i = 0; i < words; i++) {
+      h = (h ^ le64toh(buf[i])) * prime;
+      h ^= h >> 32;
+    }
+  }
+
+  // final avalanche (murmur3 fmix64)
+  h ^= h >> 33;
+  h *= __UINT64_C(0xff51afd7ed558ccd);
+  h ^= h >> 33;
+  h *= __UINT64_C(0xc4ceb9fe1a85ec53);
+  h ^= h >> 33;
+  return (size_t)h;
 }
 
 void coxmatches::unpack(uint8_t *buf, size_t buflen) {
@@ -67,132 +230,33 @@ void coxmatches::unpack(uint8_t *buf, size_t buflen) {
       struct rofl::openflow::ofp_oxm_tlv_hdr *oxm =
           (struct rofl::openflow::ofp_oxm_tlv_hdr *)buf;
 
-      uint64_t oxm_type = OXM_ROFL_TYPE(be32toh(oxm->oxm_id));
+      uint32_t oxm_id = be32toh(oxm->oxm_id);
 
-      switch (oxm_type) {
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IN_PORT): {
-        add_ofb_in_port().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IN_PHY_PORT): {
-        add_ofb_in_phy_port().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_METADATA): {
-        add_ofb_metadata().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ETH_DST): {
-        add_ofb_eth_dst().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ETH_SRC): {
-        add_ofb_eth_src().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ETH_TYPE): {
-        add_ofb_eth_type().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_VLAN_VID): {
-        add_ofb_vlan_vid().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_VLAN_PCP): {
-        add_ofb_vlan_pcp().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IP_DSCP): {
-        add_ofb_ip_dscp().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IP_ECN): {
-        add_ofb_ip_ecn().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IP_PROTO): {
-        add_ofb_ip_proto().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV4_SRC): {
-        add_ofb_ipv4_src().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV4_DST): {
-        add_ofb_ipv4_dst().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_TCP_SRC): {
-        add_ofb_tcp_src().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_TCP_DST): {
-        add_ofb_tcp_dst().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_UDP_SRC): {
-        add_ofb_udp_src().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_UDP_DST): {
-        add_ofb_udp_dst().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_SCTP_SRC): {
-        add_ofb_sctp_src().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_SCTP_DST): {
-        add_ofb_sctp_dst().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ICMPV4_TYPE): {
-        add_ofb_icmpv4_type().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ICMPV4_CODE): {
-        add_ofb_icmpv4_code().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ARP_OP): {
-        add_ofb_arp_opcode().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ARP_SPA): {
-        add_ofb_arp_spa().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ARP_TPA): {
-        add_ofb_arp_tpa().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ARP_SHA): {
-        add_ofb_arp_sha().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ARP_THA): {
-        add_ofb_arp_tha().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_SRC): {
-        add_ofb_ipv6_src().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_DST): {
-        add_ofb_ipv6_dst().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_FLABEL): {
-        add_ofb_ipv6_flabel().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ICMPV6_TYPE): {
-        add_ofb_icmpv6_type().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ICMPV6_CODE): {
-        add_ofb_icmpv6_code().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_ND_TARGET): {
-        add_ofb_ipv6_nd_target().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_ND_SLL): {
-        add_ofb_ipv6_nd_sll().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_ND_TLL): {
-        add_ofb_ipv6_nd_tll().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_MPLS_LABEL): {
-        add_ofb_mpls_label().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_MPLS_TC): {
-        add_ofb_mpls_tc().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_MPLS_BOS): {
-        add_ofb_mpls_bos().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_PBB_ISID): {
-        add_ofb_pbb_isid().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_TUNNEL_ID): {
-        add_ofb_mpls_bos().unpack(buf, buflen);
-      } break;
-      case OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_EXTHDR): {
-        add_ofb_ipv6_exthdr().unpack(buf, buflen);
-      } break;
-      default: {};
+      if (not coxmatch_fields::is_known(oxm_id)) {
+        break; // unknown basic class field, skip it
+      }
+      if (not coxmatch_fields::valid_mask(oxm_id)) {
+        throw eBadMatchBadMask("eBadMatchBadMask", __FILE__, __FUNCTION__,
+                               __LINE__);
+      }
+      if (not coxmatch_fields::valid_length(oxm_id)) {
+        throw eBadMatchBadLen("eBadMatchBadLen", __FILE__, __FUNCTION__,
+                              __LINE__);
+      }
+
+      coxmatch *match = coxmatch_ofb_factory[coxmatch_fields::field(oxm_id)]();
+      try {
+        match->unpack(buf, buflen);
+      } catch (...) {
+        delete match;
+        throw;
       }
 
+      AcquireReadWriteLock lock(rwlock);
+      coxmatch *&entry = matches[OXM_ROFL_OFB_TYPE(oxm_id)];
+      delete entry;
+      entry = match;
+
     } break;
     case rofl::openflow::OFPXMC_EXPERIMENTER: {
 
@@ -259,11 +323,59 @@ void coxmatches::pack(uint8_t *buf, size_t buflen) {
   for (std::map<uint64_t, coxmatch *>::iterator jt = matches.begin();
        jt != matches.end(); ++jt) {
 
-    coxmatch *match = (matches[jt->first]);
+    coxmatch *match = jt->second;
+
+    size_t len = match->length();
 
-    match->pack(buf, match->length());
+    match->pack(buf, len);
+
+    buf += len;
+  }
+}
+
+void coxmatches::check_prerequisites() const {
+  uint64_t present = 0;
+  uint16_t values[OFPXMT_OFB_MAX];
+  {
+    AcquireReadLock lock(rwlock);
+    for (std::map<uint64_t, coxmatch *>::const_iterator it = matches.begin();
+         it != matches.end(); ++it) {
+      if ((it->first >> 32) || (not coxmatch_fields::is_known(it->first))) {
+        continue;
+      }
+      unsigned field = coxmatch_fields::field(it->first);
+      present |= (UINT64_C(1) << field);
+      if (0 == (coxmatch_ofb_prereq_targets & (UINT64_C(1) << field))) {
+        continue;
+      }
+      values[field] =
+          (coxmatch_fields::fields[field].width == sizeof(uint8_t))
+              ? static_cast<const coxmatch_8 *>(it->second)->get_u8value()
+              : static_cast<const coxmatch_16 *>(it->second)->get_u16value();
+    }
+  }
+
+  /* only present fields carrying a prerequisite need a closer look */
+  uint64_t failed = 0;
+  for (uint64_t pending = present & coxmatch_ofb_prereq_fields; pending;
+       pending &= (pending - 1)) {
+    unsigned field = __builtin_ctzll(pending);
+    const coxmatch_field &entry = coxmatch_fields::fields[field];
+    bool ok = (present >> entry.prereq_field) & 1;
+    if (ok && (entry.prereq != coxmatch_field::PREREQ_PRESENT)) {
+      ok = coxmatch_fields::match_prereq(entry, values[entry.prereq_field]);
+    }
+    failed |= ((uint64_t)(not ok) << field);
+  }
 
-    buf += match->length();
+  if (failed) {
+    const coxmatch_field &entry =
+        coxmatch_fields::fields[__builtin_ctzll(failed)];
+    eBadMatchBadPrereq e("eBadMatchBadPrereq", __FILE__, __FUNCTION__,
+                         __LINE__);
+    e.set_key("field", entry.name);
+    e.set_key("prereq", coxmatch_fields::fields[entry.prereq_field].name);
+    throw e;
   }
 }
 
@@ -13,6 +13,7 @@
 #define COXMATCHES_H_
 
 #include <deque>
+#include <functional>
 #include <map>
 #include <ostream>
 #include <string>
@@ -26,6 +27,7 @@
 #include "rofl/common/openflow/openflow_rofl_exceptions.h"
 
 #include "rofl/common/openflow/coxmatch.h"
+#include "rofl/common/openflow/coxmatch_fields.h"
 #include "rofl/common/openflow/coxmatch_output.h"
 #include "rofl/common/openflow/extensions/matches/ext244_matches.h"
 #include "rofl/common/openflow/experimental/matches/capwap_matches.h"
@@ -69,10 +71,34 @@ public:
   coxmatches &operator=(coxmatches const &oxms);
 
   /**
-   *
+   * @brief	Equality of canonical OXM representations, see compare()
    */
   bool operator==(coxmatches const &oxms) const;
 
+  /**
+   * @brief	Strict weak ordering, see compare()
+   */
+  bool operator<(coxmatches const &oxms) const { return (compare(oxms) < 0); };
+
+public:
+  /**
+   * @brief	Compares the canonical OXM representations of two lists
+   *
+   * Masked fields are compared by their masked values, a mask of all
+   * ones is equal to no mask and a field with a mask of all zeros is
+   * equal to a missing field.
+   *
+   * @return less than, equal to or greater than zero like memcmp()
+   */
+  int compare(coxmatches const &oxms) const;
+
+  /**
+   * @brief	Returns a hash value over the canonical OXM representation
+   *
+   * Lists comparing equal yield the same value on any host.
+   */
+  size_t hash() const;
+
 public:
   /**
    *
@@ -89,6 +115,15 @@ public:
    */
   virtual void pack(uint8_t *buf, size_t buflen);
 
+  /**
+   * @brief	Validates the prerequisites of all OpenFlow basic class fields
+   *
+   * Rules are taken from coxmatch_fields, see OF 1.3, section 7.2.3.6.
+   *
+   * @throws eBadMatchBadPrereq
+   */
+  void check_prerequisites() const;
+
 public:
   /**
    *
@@ -3864,6 +3899,12 @@ public:
     return os;
   };
 
+private:
+  /* maximum length of a single OXM TLV including its header */
+  static const size_t OXM_MAX_LEN = sizeof(uint32_t) + 255;
+
+  static size_t canonicalize(coxmatch &oxm, uint8_t *buf, size_t buflen);
+
 private:
   mutable rofl::crwlock rwlock;
 
@@ -3873,4 +3914,13 @@ private:
 }; // end of namespace openflow
 }; // end of namespace rofl
 
+namespace std {
+/* equal values under operator==, i.e. compare() == 0, hash equally */
+template <> struct hash<rofl::openflow::coxmatches> {
+  size_t operator()(const rofl::openflow::coxmatches &oxms) const {
+    return oxms.hash();
+  };
+};
+}; // end of namespace std
+
 #endif /* COXMLIST_H_ */
@@ -71,6 +71,11 @@ public:
    */
   virtual void unpack(uint8_t *buf, size_t buflen);
 
+  /**
+   * @brief	Number of OpenFlow messages carried by this object
+   */
+  virtual unsigned int get_msgs_num() const { return 1; };
+
 public:
   /**
    *
@@ -139,6 +144,9 @@ public:
     case rofl::openflow13::OFP_VERSION: {
       ss << "version: 1.3";
     } break;
+    case rofl::openflow14::OFP_VERSION: {
+      ss << "version: 1.4";
+    } break;
     default: { ss << "version: " << (int)get_version() << "(on wire)"; } break;
     }
     ss << ", type: " << (int)get_type() << ", len: " << (int)get_length()
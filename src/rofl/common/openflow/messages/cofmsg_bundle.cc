@@ -0,0 +1,262 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "rofl/common/openflow/messages/cofmsg_bundle.h"
+
+using namespace rofl::openflow;
+
+cofmsg_bundle_control::~cofmsg_bundle_control() {}
+
+cofmsg_bundle_control::cofmsg_bundle_control(uint8_t version, uint32_t xid,
+                                             uint32_t bundle_id,
+                                             uint16_t ctrl_type,
+                                             uint16_t flags,
+                                             const rofl::cmemory &properties)
+    : cofmsg(version, rofl::openflow14::OFPT_BUNDLE_CONTROL, xid),
+      bundle_id(bundle_id), ctrl_type(ctrl_type), flags(flags),
+      properties(properties) {}
+
+cofmsg_bundle_control::cofmsg_bundle_control(const cofmsg_bundle_control &msg)
+    : properties((size_t)0) {
+  *this = msg;
+}
+
+cofmsg_bundle_control &cofmsg_bundle_control::
+operator=(const cofmsg_bundle_control &msg) {
+  if (this == &msg)
+    return *this;
+  cofmsg::operator=(msg);
+  bundle_id = msg.bundle_id;
+  ctrl_type = msg.ctrl_type;
+  flags = msg.flags;
+  properties = msg.properties;
+  return *this;
+}
+
+size_t cofmsg_bundle_control::length() const {
+  switch (get_version()) {
+  case rofl::openflow14::OFP_VERSION: {
+    return (sizeof(struct rofl::openflow14::ofp_bundle_ctrl_msg) +
+            properties.length());
+  } break;
+  default:
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+  }
+  return 0;
+}
+
+void cofmsg_bundle_control::pack(uint8_t *buf, size_t buflen) {
+  cofmsg::pack(buf, buflen);
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  if (buflen < cofmsg_bundle_control::length())
+    throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+  switch (get_version()) {
+  default: {
+    struct rofl::openflow14::ofp_bundle_ctrl_msg *hdr =
+        (struct rofl::openflow14::ofp_bundle_ctrl_msg *)buf;
+
+    hdr->bundle_id = htobe32(bundle_id);
+    hdr->type = htobe16(ctrl_type);
+    hdr->flags = htobe16(flags);
+
+    if (properties.length() > 0) {
+      memcpy(buf + sizeof(struct rofl::openflow14::ofp_bundle_ctrl_msg),
+             properties.somem(), properties.length());
+    }
+  };
+  }
+}
+
+void cofmsg_bundle_control::unpack(uint8_t *buf, size_t buflen) {
+  cofmsg::unpack(buf, buflen);
+
+  properties.resize(0);
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  switch (get_version()) {
+  case rofl::openflow14::OFP_VERSION: {
+    if (get_type() != rofl::openflow14::OFPT_BUNDLE_CONTROL)
+      throw eBadRequestBadType("eBadRequestBadType", __FILE__, __FUNCTION__,
+                               __LINE__);
+
+    if (buflen < sizeof(struct rofl::openflow14::ofp_bundle_ctrl_msg))
+      throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                              __LINE__);
+
+    struct rofl::openflow14::ofp_bundle_ctrl_msg *hdr =
+        (struct rofl::openflow14::ofp_bundle_ctrl_msg *)buf;
+
+    bundle_id = be32toh(hdr->bundle_id);
+    ctrl_type = be16toh(hdr->type);
+    flags = be16toh(hdr->flags);
+
+    size_t offset = sizeof(struct rofl::openflow14::ofp_bundle_ctrl_msg);
+    if (get_length() > offset) {
+      properties.assign(buf + offset, get_length() - offset);
+    }
+  } break;
+  default:
+    throw eBadRequestBadVersion("eBadRequestBadVersion", __FILE__,
+                                __FUNCTION__, __LINE__);
+  }
+
+  if (get_length() < cofmsg_bundle_control::length())
+    throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                            __LINE__);
+}
+
+cofmsg_bundle_add_message::~cofmsg_bundle_add_message() {}
+
+cofmsg_bundle_add_message::cofmsg_bundle_add_message(
+    uint8_t version, uint32_t xid, uint32_t bundle_id, uint16_t flags,
+    const rofl::cmemory &message, const rofl::cmemory &properties)
+    : cofmsg(version, rofl::openflow14::OFPT_BUNDLE_ADD_MESSAGE, xid),
+      bundle_id(bundle_id), flags(flags), message(message),
+      properties(properties) {}
+
+cofmsg_bundle_add_message::cofmsg_bundle_add_message(
+    const cofmsg_bundle_add_message &msg)
+    : message((size_t)0), properties((size_t)0) {
+  *this = msg;
+}
+
+cofmsg_bundle_add_message &cofmsg_bundle_add_message::
+operator=(const cofmsg_bundle_add_message &msg) {
+  if (this == &msg)
+    return *this;
+  cofmsg::operator=(msg);
+  bundle_id = msg.bundle_id;
+  flags = msg.flags;
+  message = msg.message;
+  properties = msg.properties;
+  return *this;
+}
+
+cofmsg_bundle_add_message &cofmsg_bundle_add_message::set_message(cofmsg &msg) {
+  message.resize(msg.length());
+  msg.pack(message.somem(), message.length());
+  return *this;
+}
+
+uint8_t cofmsg_bundle_add_message::get_message_type() const {
+  if (message.length() < sizeof(struct rofl::openflow::ofp_header))
+    throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                            __LINE__);
+  return ((struct rofl::openflow::ofp_header *)message.somem())->type;
+}
+
+size_t cofmsg_bundle_add_message::length() const {
+  switch (get_version()) {
+  case rofl::openflow14::OFP_VERSION: {
+    size_t len =
+        offsetof(struct rofl::openflow14::ofp_bundle_add_msg, message) +
+        message.length();
+    if (properties.length() > 0) {
+      /* properties start on the next 64bit boundary */
+      len = ((len + 7) / 8) * 8 + properties.length();
+    }
+    return len;
+  } break;
+  default:
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+  }
+  return 0;
+}
+
+void cofmsg_bundle_add_message::pack(uint8_t *buf, size_t buflen) {
+  cofmsg::pack(buf, buflen);
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  if (buflen < cofmsg_bundle_add_message::length())
+    throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+  switch (get_version()) {
+  default: {
+    struct rofl::openflow14::ofp_bundle_add_msg *hdr =
+        (struct rofl::openflow14::ofp_bundle_add_msg *)buf;
+
+    hdr->bundle_id = htobe32(bundle_id);
+    hdr->pad = 0;
+    hdr->flags = htobe16(flags);
+
+    size_t offset =
+        offsetof(struct rofl::openflow14::ofp_bundle_add_msg, message);
+
+    if (message.length() > 0) {
+      memcpy(buf + offset, message.somem(), message.length());
+      if (message.length() >= sizeof(struct rofl::openflow::ofp_header)) {
+        /* xid of inner message must match the Bundle-Add-Message */
+        hdr->message.xid = htobe32(get_xid());
+      }
+    }
+    offset += message.length();
+
+    if (properties.length() > 0) {
+      offset = ((offset + 7) / 8) * 8;
+      memcpy(buf + offset, properties.somem(), properties.length());
+    }
+  };
+  }
+}
+
+void cofmsg_bundle_add_message::unpack(uint8_t *buf, size_t buflen) {
+  cofmsg::unpack(buf, buflen);
+
+  message.resize(0);
+  properties.resize(0);
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  switch (get_version()) {
+  case rofl::openflow14::OFP_VERSION: {
+    if (get_type() != rofl::openflow14::OFPT_BUNDLE_ADD_MESSAGE)
+      throw eBadRequestBadType("eBadRequestBadType", __FILE__, __FUNCTION__,
+                               __LINE__);
+
+    if (buflen < sizeof(struct rofl::openflow14::ofp_bundle_add_msg))
+      throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                              __LINE__);
+
+    struct rofl::openflow14::ofp_bundle_add_msg *hdr =
+        (struct rofl::openflow14::ofp_bundle_add_msg *)buf;
+
+    bundle_id = be32toh(hdr->bundle_id);
+    flags = be16toh(hdr->flags);
+
+    size_t offset =
+        offsetof(struct rofl::openflow14::ofp_bundle_add_msg, message);
+    size_t msglen = be16toh(hdr->message.length);
+
+    if ((msglen < sizeof(struct rofl::openflow::ofp_header)) ||
+        (msglen > (get_length() - offset)))
+      throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                              __LINE__);
+
+    message.assign(buf + offset, msglen);
+    offset += msglen;
+
+    /* properties start on the next 64bit boundary */
+    offset = ((offset + 7) / 8) * 8;
+    if (get_length() > offset) {
+      properties.assign(buf + offset, get_length() - offset);
+    }
+  } break;
+  default:
+    throw eBadRequestBadVersion("eBadRequestBadVersion", __FILE__,
+                                __FUNCTION__, __LINE__);
+  }
+
+  if (get_length() < cofmsg_bundle_add_message::length())
+    throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                            __LINE__);
+}
@@ -0,0 +1,281 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cofmsg_bundle.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#ifndef COFMSG_BUNDLE_H_
+#define COFMSG_BUNDLE_H_ 1
+
+#include "rofl/common/cmemory.h"
+#include "rofl/common/openflow/messages/cofmsg.h"
+
+namespace rofl {
+namespace openflow {
+
+/**
+ * @brief	OpenFlow Bundle-Control message (OpenFlow 1.4 and beyond)
+ *
+ * Used for requests and replies, the direction is defined by the
+ * control type (OFPBCT_*). Bundle properties are kept in wire format.
+ */
+class cofmsg_bundle_control : public cofmsg {
+public:
+  /**
+   *
+   */
+  virtual ~cofmsg_bundle_control();
+
+  /**
+   *
+   */
+  cofmsg_bundle_control(
+      uint8_t version = rofl::openflow::OFP_VERSION_UNKNOWN, uint32_t xid = 0,
+      uint32_t bundle_id = 0, uint16_t ctrl_type = 0, uint16_t flags = 0,
+      const rofl::cmemory &properties = rofl::cmemory((size_t)0));
+
+  /**
+   *
+   */
+  cofmsg_bundle_control(const cofmsg_bundle_control &msg);
+
+  /**
+   *
+   */
+  cofmsg_bundle_control &operator=(const cofmsg_bundle_control &msg);
+
+public:
+  /**
+   *
+   */
+  virtual size_t length() const;
+
+  /**
+   *
+   */
+  virtual void pack(uint8_t *buf = (uint8_t *)0, size_t buflen = 0);
+
+  /**
+   *
+   */
+  virtual void unpack(uint8_t *buf, size_t buflen);
+
+public:
+  /**
+   *
+   */
+  uint32_t get_bundle_id() const { return bundle_id; };
+
+  /**
+   *
+   */
+  cofmsg_bundle_control &set_bundle_id(uint32_t bundle_id) {
+    this->bundle_id = bundle_id;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint16_t get_ctrl_type() const { return ctrl_type; };
+
+  /**
+   *
+   */
+  cofmsg_bundle_control &set_ctrl_type(uint16_t ctrl_type) {
+    this->ctrl_type = ctrl_type;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint16_t get_flags() const { return flags; };
+
+  /**
+   *
+   */
+  cofmsg_bundle_control &set_flags(uint16_t flags) {
+    this->flags = flags;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  const rofl::cmemory &get_properties() const { return properties; };
+
+  /**
+   *
+   */
+  rofl::cmemory &set_properties() { return properties; };
+
+public:
+  friend std::ostream &operator<<(std::ostream &os,
+                                  const cofmsg_bundle_control &msg) {
+    os << dynamic_cast<const cofmsg &>(msg);
+    os << "<cofmsg_bundle_control >" << std::endl;
+    os << "<bundle-id: 0x" << std::hex << msg.get_bundle_id() << std::dec
+       << " ctrl-type: " << msg.get_ctrl_type() << " flags: 0x" << std::hex
+       << msg.get_flags() << std::dec << " >" << std::endl;
+    os << msg.properties;
+    return os;
+  };
+
+  virtual std::string str() const {
+    std::stringstream ss;
+    ss << cofmsg::str() << "-Bundle-Control- bundle_id: " << bundle_id
+       << " ctrl_type: " << (int)ctrl_type << " flags: " << (int)flags << " ";
+    return ss.str();
+  };
+
+private:
+  uint32_t bundle_id;
+  uint16_t ctrl_type;
+  uint16_t flags;
+  rofl::cmemory properties;
+};
+
+/**
+ * @brief	OpenFlow Bundle-Add-Message message (OpenFlow 1.4 and beyond)
+ *
+ * The message added to the bundle is kept in wire format. Its xid is
+ * overwritten with the xid of the Bundle-Add-Message when packed.
+ */
+class cofmsg_bundle_add_message : public cofmsg {
+public:
+  /**
+   *
+   */
+  virtual ~cofmsg_bundle_add_message();
+
+  /**
+   *
+   */
+  cofmsg_bundle_add_message(
+      uint8_t version = rofl::openflow::OFP_VERSION_UNKNOWN, uint32_t xid = 0,
+      uint32_t bundle_id = 0, uint16_t flags = 0,
+      const rofl::cmemory &message = rofl::cmemory((size_t)0),
+      const rofl::cmemory &properties = rofl::cmemory((size_t)0));
+
+  /**
+   *
+   */
+  cofmsg_bundle_add_message(const cofmsg_bundle_add_message &msg);
+
+  /**
+   *
+   */
+  cofmsg_bundle_add_message &operator=(const cofmsg_bundle_add_message &msg);
+
+public:
+  /**
+   *
+   */
+  virtual size_t length() const;
+
+  /**
+   *
+   */
+  virtual void pack(uint8_t *buf = (uint8_t *)0, size_t buflen = 0);
+
+  /**
+   *
+   */
+  virtual void unpack(uint8_t *buf, size_t buflen);
+
+public:
+  /**
+   *
+   */
+  uint32_t get_bundle_id() const { return bundle_id; };
+
+  /**
+   *
+   */
+  cofmsg_bundle_add_message &set_bundle_id(uint32_t bundle_id) {
+    this->bundle_id = bundle_id;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint16_t get_flags() const { return flags; };
+
+  /**
+   *
+   */
+  cofmsg_bundle_add_message &set_flags(uint16_t flags) {
+    this->flags = flags;
+    return *this;
+  };
+
+  /**
+   * @brief	Returns the message added to the bundle in wire format.
+   */
+  const rofl::cmemory &get_message() const { return message; };
+
+  /**
+   *
+   */
+  rofl::cmemory &set_message() { return message; };
+
+  /**
+   * @brief	Packs msg as message added to the bundle.
+   */
+  cofmsg_bundle_add_message &set_message(cofmsg &msg);
+
+  /**
+   * @brief	Returns type of the message added to the bundle.
+   *
+   * @exception eBadRequestBadLen no valid message stored
+   */
+  uint8_t get_message_type() const;
+
+  /**
+   *
+   */
+  const rofl::cmemory &get_properties() const { return properties; };
+
+  /**
+   *
+   */
+  rofl::cmemory &set_properties() { return properties; };
+
+public:
+  friend std::ostream &operator<<(std::ostream &os,
+                                  const cofmsg_bundle_add_message &msg) {
+    os << dynamic_cast<const cofmsg &>(msg);
+    os << "<cofmsg_bundle_add_message >" << std::endl;
+    os << "<bundle-id: 0x" << std::hex << msg.get_bundle_id() << std::dec
+       << " flags: 0x" << std::hex << msg.get_flags() << std::dec << " >"
+       << std::endl;
+    os << msg.message;
+    os << msg.properties;
+    return os;
+  };
+
+  virtual std::string str() const {
+    std::stringstream ss;
+    ss << cofmsg::str() << "-Bundle-Add-Message- bundle_id: " << bundle_id
+       << " flags: " << (int)flags << " msglen: " << message.length() << " ";
+    return ss.str();
+  };
+
+private:
+  uint32_t bundle_id;
+  uint16_t flags;
+  rofl::cmemory message;
+  rofl::cmemory properties;
+};
+
+} // end of namespace openflow
+} // end of namespace rofl
+
+#endif /* COFMSG_BUNDLE_H_ */
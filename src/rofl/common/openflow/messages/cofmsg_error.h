@@ -1273,6 +1273,7 @@ public:
     } break;
     case rofl::openflow12::OFP_VERSION:
     case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION:
     default: {
       set_err_type(rofl::openflow12::OFPET_FLOW_MOD_FAILED);
       set_err_code(rofl::openflow12::OFPFMFC_TABLE_FULL);
@@ -1309,6 +1310,7 @@ public:
     } break;
     case rofl::openflow12::OFP_VERSION:
     case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION:
     default: {
       set_err_type(rofl::openflow12::OFPET_FLOW_MOD_FAILED);
       set_err_code(rofl::openflow12::OFPFMFC_OVERLAP);
@@ -1330,6 +1332,7 @@ public:
     } break;
     case rofl::openflow12::OFP_VERSION:
     case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION:
     default: {
       set_err_type(rofl::openflow12::OFPET_FLOW_MOD_FAILED);
       set_err_code(rofl::openflow12::OFPFMFC_EPERM);
@@ -1352,6 +1355,7 @@ public:
     } break;
     case rofl::openflow12::OFP_VERSION:
     case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION:
     default: {
       set_err_type(rofl::openflow12::OFPET_FLOW_MOD_FAILED);
       set_err_code(rofl::openflow12::OFPFMFC_BAD_TIMEOUT);
@@ -1374,6 +1378,7 @@ public:
     } break;
     case rofl::openflow12::OFP_VERSION:
     case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION:
     default: {
       set_err_type(rofl::openflow12::OFPET_FLOW_MOD_FAILED);
       set_err_code(rofl::openflow12::OFPFMFC_BAD_COMMAND);
@@ -221,7 +221,8 @@ public:
          << std::endl
          << msg.ports;
     } break;
-    case openflow13::OFP_VERSION: {
+    case openflow13::OFP_VERSION:
+    case openflow14::OFP_VERSION: {
       os << "dpid:" << msg.get_dpid()
          << " #buffers:" << (unsigned int)msg.get_n_buffers()
          << " #tables:" << (int)msg.get_n_tables() << " capabilities:0x"
@@ -0,0 +1,179 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "rofl/common/openflow/messages/cofmsg_flow_monitor.h"
+
+using namespace rofl::openflow;
+
+cofmsg_flow_monitor_request::~cofmsg_flow_monitor_request() {}
+
+cofmsg_flow_monitor_request::cofmsg_flow_monitor_request(
+    uint8_t version, uint32_t xid, uint16_t stats_flags,
+    const rofl::openflow::cofflowmonitorarray &monitors)
+    : cofmsg_stats_request(version, xid, rofl::openflow14::OFPMP_FLOW_MONITOR,
+                           stats_flags),
+      monitors(monitors) {
+  this->monitors.set_version(version);
+}
+
+cofmsg_flow_monitor_request::cofmsg_flow_monitor_request(
+    const cofmsg_flow_monitor_request &msg) {
+  *this = msg;
+}
+
+cofmsg_flow_monitor_request &cofmsg_flow_monitor_request::
+operator=(const cofmsg_flow_monitor_request &msg) {
+  if (this == &msg)
+    return *this;
+  cofmsg_stats_request::operator=(msg);
+  monitors = msg.monitors;
+  return *this;
+}
+
+size_t cofmsg_flow_monitor_request::length() const {
+  switch (get_version()) {
+  default: {
+    return (sizeof(struct rofl::openflow13::ofp_multipart_request) +
+            monitors.length());
+  };
+  }
+}
+
+void cofmsg_flow_monitor_request::pack(uint8_t *buf, size_t buflen) {
+  cofmsg_stats_request::pack(buf, buflen); // copies common statistics header
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  if (buflen < cofmsg_flow_monitor_request::length())
+    throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+  switch (get_version()) {
+  default: {
+    struct rofl::openflow13::ofp_multipart_request *hdr =
+        (struct rofl::openflow13::ofp_multipart_request *)buf;
+    monitors.pack(hdr->body, monitors.length());
+  };
+  }
+}
+
+void cofmsg_flow_monitor_request::unpack(uint8_t *buf, size_t buflen) {
+  cofmsg_stats_request::unpack(buf, buflen);
+
+  monitors.set_version(get_version());
+  monitors.clear();
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  if (buflen < cofmsg_flow_monitor_request::length())
+    throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                            __LINE__);
+
+  switch (get_version()) {
+  default: {
+    if (get_stats_type() != rofl::openflow14::OFPMP_FLOW_MONITOR)
+      throw eBadRequestBadStat("eBadRequestBadStat", __FILE__, __FUNCTION__,
+                               __LINE__);
+
+    struct rofl::openflow13::ofp_multipart_request *hdr =
+        (struct rofl::openflow13::ofp_multipart_request *)buf;
+    if (buflen > sizeof(struct rofl::openflow13::ofp_multipart_request)) {
+      monitors.unpack(
+          hdr->body,
+          buflen - sizeof(struct rofl::openflow13::ofp_multipart_request));
+    }
+  };
+  }
+
+  if (get_length() < cofmsg_flow_monitor_request::length())
+    throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                            __LINE__);
+}
+
+cofmsg_flow_monitor_reply::~cofmsg_flow_monitor_reply() {}
+
+cofmsg_flow_monitor_reply::cofmsg_flow_monitor_reply(
+    uint8_t version, uint32_t xid, uint16_t stats_flags,
+    const rofl::openflow::cofflowupdatearray &updates)
+    : cofmsg_stats_reply(version, xid, rofl::openflow14::OFPMP_FLOW_MONITOR,
+                         stats_flags),
+      updates(updates) {
+  this->updates.set_version(version);
+}
+
+cofmsg_flow_monitor_reply::cofmsg_flow_monitor_reply(
+    const cofmsg_flow_monitor_reply &msg) {
+  *this = msg;
+}
+
+cofmsg_flow_monitor_reply &cofmsg_flow_monitor_reply::
+operator=(const cofmsg_flow_monitor_reply &msg) {
+  if (this == &msg)
+    return *this;
+  cofmsg_stats_reply::operator=(msg);
+  updates = msg.updates;
+  return *this;
+}
+
+size_t cofmsg_flow_monitor_reply::length() const {
+  switch (get_version()) {
+  default: {
+    return (sizeof(struct rofl::openflow13::ofp_multipart_reply) +
+            updates.length());
+  };
+  }
+}
+
+void cofmsg_flow_monitor_reply::pack(uint8_t *buf, size_t buflen) {
+  cofmsg_stats_reply::pack(buf, buflen); // copies common statistics header
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  if (buflen < cofmsg_flow_monitor_reply::length())
+    throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+  switch (get_version()) {
+  default: {
+    struct rofl::openflow13::ofp_multipart_reply *hdr =
+        (struct rofl::openflow13::ofp_multipart_reply *)buf;
+    updates.pack(hdr->body, updates.length());
+  };
+  }
+}
+
+void cofmsg_flow_monitor_reply::unpack(uint8_t *buf, size_t buflen) {
+  cofmsg_stats_reply::unpack(buf, buflen);
+
+  updates.set_version(get_version());
+  updates.clear();
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  if (buflen < cofmsg_flow_monitor_reply::length())
+    throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                            __LINE__);
+
+  switch (get_version()) {
+  default: {
+    if (get_stats_type() != rofl::openflow14::OFPMP_FLOW_MONITOR)
+      throw eBadRequestBadStat("eBadRequestBadStat", __FILE__, __FUNCTION__,
+                               __LINE__);
+
+    struct rofl::openflow13::ofp_multipart_reply *hdr =
+        (struct rofl::openflow13::ofp_multipart_reply *)buf;
+    if (buflen > sizeof(struct rofl::openflow13::ofp_multipart_reply)) {
+      updates.unpack(
+          hdr->body,
+          buflen - sizeof(struct rofl::openflow13::ofp_multipart_reply));
+    }
+  };
+  }
+
+  if (get_length() < cofmsg_flow_monitor_reply::length())
+    throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                            __LINE__);
+}
@@ -0,0 +1,189 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cofmsg_flow_monitor.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#ifndef COFMSG_FLOW_MONITOR_H_
+#define COFMSG_FLOW_MONITOR_H_ 1
+
+#include <inttypes.h>
+#include <map>
+
+#include "rofl/common/openflow/cofflowmonitorarray.h"
+#include "rofl/common/openflow/messages/cofmsg_stats.h"
+
+namespace rofl {
+namespace openflow {
+
+/**
+ * @brief	OFPMP_FLOW_MONITOR request (OpenFlow 1.4)
+ */
+class cofmsg_flow_monitor_request : public cofmsg_stats_request {
+public:
+  /**
+   *
+   */
+  virtual ~cofmsg_flow_monitor_request();
+
+  /**
+   *
+   */
+  cofmsg_flow_monitor_request(
+      uint8_t version = rofl::openflow::OFP_VERSION_UNKNOWN, uint32_t xid = 0,
+      uint16_t stats_flags = 0,
+      const rofl::openflow::cofflowmonitorarray &monitors =
+          rofl::openflow::cofflowmonitorarray());
+
+  /**
+   *
+   */
+  cofmsg_flow_monitor_request(const cofmsg_flow_monitor_request &msg);
+
+  /**
+   *
+   */
+  cofmsg_flow_monitor_request &
+  operator=(const cofmsg_flow_monitor_request &msg);
+
+public:
+  /**
+   *
+   */
+  virtual size_t length() const;
+
+  /**
+   *
+   */
+  virtual void pack(uint8_t *buf = (uint8_t *)0, size_t buflen = 0);
+
+  /**
+   *
+   */
+  virtual void unpack(uint8_t *buf, size_t buflen);
+
+public:
+  /**
+   *
+   */
+  const rofl::openflow::cofflowmonitorarray &get_flow_monitors() const {
+    return monitors;
+  };
+
+  /**
+   *
+   */
+  rofl::openflow::cofflowmonitorarray &set_flow_monitors() {
+    return monitors;
+  };
+
+public:
+  friend std::ostream &operator<<(std::ostream &os,
+                                  const cofmsg_flow_monitor_request &msg) {
+    os << dynamic_cast<const cofmsg_stats_request &>(msg);
+    os << "<cofmsg_flow_monitor_request >" << std::endl;
+    os << msg.get_flow_monitors();
+    return os;
+  };
+
+  virtual std::string str() const {
+    std::stringstream ss;
+    ss << cofmsg_stats_request::str() << "-Flow-Monitor-Request- ";
+    ss << "#monitors: " << monitors.size() << " ";
+    return ss.str();
+  };
+
+private:
+  rofl::openflow::cofflowmonitorarray monitors;
+};
+
+/**
+ * @brief	OFPMP_FLOW_MONITOR reply (OpenFlow 1.4)
+ *
+ * Carries the initial flow entries of a new monitor as well as all
+ * unsolicited updates sent by the datapath afterwards.
+ */
+class cofmsg_flow_monitor_reply : public cofmsg_stats_reply {
+public:
+  /**
+   *
+   */
+  virtual ~cofmsg_flow_monitor_reply();
+
+  /**
+   *
+   */
+  cofmsg_flow_monitor_reply(
+      uint8_t version = rofl::openflow::OFP_VERSION_UNKNOWN, uint32_t xid = 0,
+      uint16_t stats_flags = 0,
+      const rofl::openflow::cofflowupdatearray &updates =
+          rofl::openflow::cofflowupdatearray());
+
+  /**
+   *
+   */
+  cofmsg_flow_monitor_reply(const cofmsg_flow_monitor_reply &msg);
+
+  /**
+   *
+   */
+  cofmsg_flow_monitor_reply &operator=(const cofmsg_flow_monitor_reply &msg);
+
+public:
+  /**
+   *
+   */
+  virtual size_t length() const;
+
+  /**
+   *
+   */
+  virtual void pack(uint8_t *buf = (uint8_t *)0, size_t buflen = 0);
+
+  /**
+   *
+   */
+  virtual void unpack(uint8_t *buf, size_t buflen);
+
+public:
+  /**
+   *
+   */
+  const rofl::openflow::cofflowupdatearray &get_flow_updates() const {
+    return updates;
+  };
+
+  /**
+   *
+   */
+  rofl::openflow::cofflowupdatearray &set_flow_updates() { return updates; };
+
+public:
+  friend std::ostream &operator<<(std::ostream &os,
+                                  const cofmsg_flow_monitor_reply &msg) {
+    os << dynamic_cast<const cofmsg_stats_reply &>(msg);
+    os << "<cofmsg_flow_monitor_reply >" << std::endl;
+    os << msg.get_flow_updates();
+    return os;
+  };
+
+  virtual std::string str() const {
+    std::stringstream ss;
+    ss << cofmsg_stats_reply::str() << "-Flow-Monitor-Reply- ";
+    ss << "#updates: " << updates.size() << " ";
+    return ss.str();
+  };
+
+private:
+  rofl::openflow::cofflowupdatearray updates;
+};
+
+} // end of namespace openflow
+} // end of namespace rofl
+
+#endif /* COFMSG_FLOW_MONITOR_H_ */
@@ -41,7 +41,8 @@ operator=(const cofmsg_meter_config_stats_request &msg) {
 
 size_t cofmsg_meter_config_stats_request::length() const {
   switch (get_version()) {
-  case openflow13::OFP_VERSION: {
+  case openflow13::OFP_VERSION:
+  case openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_multipart_request) +
             meter_config.length());
   } break;
@@ -128,7 +129,8 @@ operator=(const cofmsg_meter_config_stats_reply &msg) {
 
 size_t cofmsg_meter_config_stats_reply::length() const {
   switch (get_version()) {
-  case openflow13::OFP_VERSION: {
+  case openflow13::OFP_VERSION:
+  case openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_multipart_reply) +
             array.length());
   } break;
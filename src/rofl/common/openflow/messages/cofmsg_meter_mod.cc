@@ -31,7 +31,8 @@ cofmsg_meter_mod &cofmsg_meter_mod::operator=(const cofmsg_meter_mod &msg) {
 
 size_t cofmsg_meter_mod::length() const {
   switch (get_version()) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_meter_mod) +
             meter_bands.length());
   } break;
@@ -0,0 +1,96 @@
+#include "cofmsg_packed.h"
+
+using namespace rofl::openflow;
+
+cofmsg_packed::~cofmsg_packed() {}
+
+cofmsg_packed::cofmsg_packed(uint8_t version, uint8_t type, uint32_t xid,
+                             size_t capacity)
+    : cofmsg(version, type, xid),
+      mem(capacity > MAX_LENGTH ? MAX_LENGTH : capacity), used(0),
+      msgs_num(0) {}
+
+cofmsg_packed::cofmsg_packed(const cofmsg_packed &msg)
+    : used(0), msgs_num(0) {
+  *this = msg;
+}
+
+cofmsg_packed &cofmsg_packed::operator=(const cofmsg_packed &msg) {
+  if (this == &msg)
+    return *this;
+  cofmsg::operator=(msg);
+  mem = msg.mem;
+  used = msg.used;
+  msgs_num = msg.msgs_num;
+  return *this;
+}
+
+uint8_t *cofmsg_packed::append(size_t msglen) {
+  if (msglen < sizeof(struct rofl::openflow::ofp_header))
+    throw eInvalid("cofmsg_packed::append() msglen too short", __FILE__,
+                   __FUNCTION__, __LINE__);
+
+  if (tailroom() < msglen)
+    throw eInvalid("cofmsg_packed::append() tailroom exhausted", __FILE__,
+                   __FUNCTION__, __LINE__);
+
+  uint8_t *ptr = mem.somem() + used;
+  used += msglen;
+  msgs_num++;
+  return ptr;
+}
+
+void cofmsg_packed::pack(uint8_t *buf, size_t buflen) {
+  /* update the header length only, cofmsg::pack() would clear the entire
+   * buffer otherwise */
+  cofmsg::pack(nullptr, 0);
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  if (buflen < used)
+    throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+  memcpy(buf, mem.somem(), used);
+}
+
+void cofmsg_packed::unpack(uint8_t *buf, size_t buflen) {
+  used = 0;
+  msgs_num = 0;
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  if (buflen > MAX_LENGTH)
+    throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                            __LINE__);
+
+  /* version, type and xid are taken from the first message */
+  cofmsg::unpack(buf, buflen);
+
+  /* validate framing of all messages contained */
+  unsigned int num = 0;
+  size_t offset = 0;
+  while (offset < buflen) {
+    if ((buflen - offset) < sizeof(struct rofl::openflow::ofp_header))
+      throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                              __LINE__);
+
+    struct rofl::openflow::ofp_header *hdr =
+        (struct rofl::openflow::ofp_header *)(buf + offset);
+
+    size_t msglen = be16toh(hdr->length);
+
+    if ((msglen < sizeof(struct rofl::openflow::ofp_header)) ||
+        (msglen > (buflen - offset)))
+      throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                              __LINE__);
+
+    offset += msglen;
+    num++;
+  }
+
+  mem.assign(buf, buflen);
+  used = buflen;
+  msgs_num = num;
+}
@@ -0,0 +1,123 @@
+/*
+ * cofmsg_packed.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#ifndef COFMSG_PACKED_H_
+#define COFMSG_PACKED_H_ 1
+
+#include "rofl/common/cmemory.h"
+#include "rofl/common/openflow/messages/cofmsg.h"
+
+namespace rofl {
+namespace openflow {
+
+/**
+ * @brief	A sequence of one or more OpenFlow messages already in wire
+ * format.
+ *
+ * Serves as container for bulk operations: callers append complete
+ * messages (header included) via append(), the socket copies the
+ * entire block into its transmit buffer with a single memcpy. Version,
+ * type and xid of this object reflect the first message stored and are
+ * used for queue classification only.
+ */
+class cofmsg_packed : public cofmsg {
+public:
+  /**
+   * @brief	Maximum size of a packed block, limited by the socket's
+   * transmit buffer and the segmentation threshold.
+   */
+  static const size_t MAX_LENGTH = 65535;
+
+public:
+  /**
+   *
+   */
+  virtual ~cofmsg_packed();
+
+  /**
+   *
+   */
+  cofmsg_packed(uint8_t version = rofl::openflow::OFP_VERSION_UNKNOWN,
+                uint8_t type = 0, uint32_t xid = 0,
+                size_t capacity = MAX_LENGTH);
+
+  /**
+   *
+   */
+  cofmsg_packed(const cofmsg_packed &msg);
+
+  /**
+   *
+   */
+  cofmsg_packed &operator=(const cofmsg_packed &msg);
+
+public:
+  /** returns length of packet in packed state
+   *
+   */
+  virtual size_t length() const { return used; };
+
+  /**
+   *
+   */
+  virtual void pack(uint8_t *buf = (uint8_t *)0, size_t buflen = 0);
+
+  /**
+   *
+   */
+  virtual void unpack(uint8_t *buf, size_t buflen);
+
+public:
+  /**
+   * @brief	Reserves msglen bytes at the tail of this block.
+   *
+   * @param msglen length of the message to be written
+   * @return pointer to zero-initialized memory of msglen bytes
+   * @exception rofl::eInvalid not enough tailroom available
+   */
+  uint8_t *append(size_t msglen);
+
+  /**
+   * @brief	Number of bytes still available in this block.
+   */
+  size_t tailroom() const { return mem.length() - used; };
+
+  /**
+   * @brief	Number of OpenFlow messages stored in this block.
+   */
+  virtual unsigned int get_msgs_num() const { return msgs_num; };
+
+  /**
+   *
+   */
+  bool empty() const { return (0 == msgs_num); };
+
+public:
+  friend std::ostream &operator<<(std::ostream &os, const cofmsg_packed &msg) {
+    os << "<cofmsg_packed >" << std::endl;
+    { os << dynamic_cast<const cofmsg &>(msg); };
+    os << "<msgs_num: " << msg.get_msgs_num() << " >" << std::endl;
+    return os;
+  };
+
+  std::string str() const {
+    std::stringstream ss;
+    ss << cofmsg::str() << "-Packed- msgs_num: " << msgs_num
+       << " bytes: " << used << " ";
+    return ss.str();
+  };
+
+private:
+  rofl::cmemory mem;
+  size_t used;
+  unsigned int msgs_num;
+};
+
+} // end of namespace openflow
+} // end of namespace rofl
+
+#endif /* COFMSG_PACKED_H_ */
@@ -182,7 +182,8 @@ private:
       if (rofl::openflow12::OFPR_INVALID_TTL == get_reason())
         ss.append("invalid ttl ");
     } break;
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       if (rofl::openflow13::OFPR_NO_MATCH == get_reason())
         ss.append("no match ");
       if (rofl::openflow13::OFPR_ACTION == get_reason())
@@ -227,7 +228,8 @@ public:
       os << "<table-id:" << (int)msg.get_table_id() << " >" << std::endl;
 
     } break;
-    case openflow13::OFP_VERSION: {
+    case openflow13::OFP_VERSION:
+    case openflow14::OFP_VERSION: {
       os << "<buffer-id:" << (int)msg.get_buffer_id() << " >" << std::endl;
       os << "<total-len:" << (int)msg.get_total_len() << " >" << std::endl;
       os << "<reason:" << msg.s_reason() << " >" << std::endl;
@@ -15,6 +15,25 @@
 namespace rofl {
 namespace openflow {
 
+/**
+ * @brief	Frame for a batch of Packet-Out messages
+ *
+ * Refers to memory owned by the caller, the frame is copied while
+ * queueing the Packet-Out message.
+ */
+struct cofpacket_out_frame {
+  uint32_t buffer_id;
+  uint32_t in_port;
+  const uint8_t *data;
+  size_t datalen;
+
+  cofpacket_out_frame(uint32_t buffer_id = rofl::openflow::OFP_NO_BUFFER,
+                      uint32_t in_port = rofl::openflow::OFPP_CONTROLLER,
+                      const uint8_t *data = nullptr, size_t datalen = 0)
+      : buffer_id(buffer_id), in_port(in_port), data(data),
+        datalen(datalen){};
+};
+
 /**
  *
  */
@@ -28,7 +28,8 @@ operator=(const cofmsg_port_desc_stats_request &msg) {
 
 size_t cofmsg_port_desc_stats_request::length() const {
   switch (get_version()) {
-  case openflow13::OFP_VERSION: {
+  case openflow13::OFP_VERSION:
+  case openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_multipart_request));
   } break;
   default:
@@ -97,7 +98,8 @@ operator=(const cofmsg_port_desc_stats_reply &msg) {
 
 size_t cofmsg_port_desc_stats_reply::length() const {
   switch (get_version()) {
-  case openflow13::OFP_VERSION: {
+  case openflow13::OFP_VERSION:
+  case openflow14::OFP_VERSION: {
     return sizeof(struct openflow13::ofp_multipart_reply) + ports.length();
   } break;
   default:
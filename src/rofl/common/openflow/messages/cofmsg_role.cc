@@ -32,7 +32,8 @@ size_t cofmsg_role_request::length() const {
   case rofl::openflow12::OFP_VERSION: {
     return (sizeof(struct rofl::openflow12::ofp_header) + role.length());
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_header) + role.length());
   } break;
   default:
@@ -113,7 +114,8 @@ size_t cofmsg_role_reply::length() const {
   case rofl::openflow12::OFP_VERSION: {
     return (sizeof(struct rofl::openflow12::ofp_header) + role.length());
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_header) + role.length());
   } break;
   default:
@@ -0,0 +1,112 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "rofl/common/openflow/messages/cofmsg_role_status.h"
+
+using namespace rofl::openflow;
+
+cofmsg_role_status::~cofmsg_role_status() {}
+
+cofmsg_role_status::cofmsg_role_status(uint8_t version, uint32_t xid,
+                                       uint32_t role, uint8_t reason,
+                                       uint64_t generation_id,
+                                       const rofl::cmemory &properties)
+    : cofmsg(version, rofl::openflow14::OFPT_ROLE_STATUS, xid), role(role),
+      reason(reason), generation_id(generation_id), properties(properties) {}
+
+cofmsg_role_status::cofmsg_role_status(const cofmsg_role_status &msg)
+    : properties((size_t)0) {
+  *this = msg;
+}
+
+cofmsg_role_status &cofmsg_role_status::
+operator=(const cofmsg_role_status &msg) {
+  if (this == &msg)
+    return *this;
+  cofmsg::operator=(msg);
+  role = msg.role;
+  reason = msg.reason;
+  generation_id = msg.generation_id;
+  properties = msg.properties;
+  return *this;
+}
+
+size_t cofmsg_role_status::length() const {
+  switch (get_version()) {
+  case rofl::openflow14::OFP_VERSION: {
+    return (sizeof(struct rofl::openflow14::ofp_role_status) +
+            properties.length());
+  } break;
+  default:
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+  }
+  return 0;
+}
+
+void cofmsg_role_status::pack(uint8_t *buf, size_t buflen) {
+  cofmsg::pack(buf, buflen);
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  if (buflen < cofmsg_role_status::length())
+    throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+  switch (get_version()) {
+  default: {
+    struct rofl::openflow14::ofp_role_status *hdr =
+        (struct rofl::openflow14::ofp_role_status *)buf;
+
+    hdr->role = htobe32(role);
+    hdr->reason = reason;
+    memset(hdr->pad, 0, sizeof(hdr->pad));
+    hdr->generation_id = htobe64(generation_id);
+
+    if (properties.length() > 0) {
+      memcpy(buf + sizeof(struct rofl::openflow14::ofp_role_status),
+             properties.somem(), properties.length());
+    }
+  };
+  }
+}
+
+void cofmsg_role_status::unpack(uint8_t *buf, size_t buflen) {
+  cofmsg::unpack(buf, buflen);
+
+  properties.resize(0);
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  switch (get_version()) {
+  case rofl::openflow14::OFP_VERSION: {
+    if (get_type() != rofl::openflow14::OFPT_ROLE_STATUS)
+      throw eBadRequestBadType("eBadRequestBadType", __FILE__, __FUNCTION__,
+                               __LINE__);
+
+    if (buflen < sizeof(struct rofl::openflow14::ofp_role_status))
+      throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                              __LINE__);
+
+    struct rofl::openflow14::ofp_role_status *hdr =
+        (struct rofl::openflow14::ofp_role_status *)buf;
+
+    role = be32toh(hdr->role);
+    reason = hdr->reason;
+    generation_id = be64toh(hdr->generation_id);
+
+    size_t offset = sizeof(struct rofl::openflow14::ofp_role_status);
+    if (get_length() > offset) {
+      properties.assign(buf + offset, get_length() - offset);
+    }
+  } break;
+  default:
+    throw eBadRequestBadVersion("eBadRequestBadVersion", __FILE__,
+                                __FUNCTION__, __LINE__);
+  }
+
+  if (get_length() < cofmsg_role_status::length())
+    throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                            __LINE__);
+}
@@ -0,0 +1,149 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cofmsg_role_status.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#ifndef COFMSG_ROLE_STATUS_H_
+#define COFMSG_ROLE_STATUS_H_ 1
+
+#include "rofl/common/cmemory.h"
+#include "rofl/common/openflow/messages/cofmsg.h"
+
+namespace rofl {
+namespace openflow {
+
+/**
+ * @brief	OpenFlow Role-Status message (OpenFlow 1.4 and beyond)
+ *
+ * Sent by the datapath when a controller's role has been changed by
+ * another controller or by the switch configuration. Role properties
+ * are kept in wire format.
+ */
+class cofmsg_role_status : public cofmsg {
+public:
+  /**
+   *
+   */
+  virtual ~cofmsg_role_status();
+
+  /**
+   *
+   */
+  cofmsg_role_status(
+      uint8_t version = rofl::openflow::OFP_VERSION_UNKNOWN, uint32_t xid = 0,
+      uint32_t role = 0, uint8_t reason = 0, uint64_t generation_id = 0,
+      const rofl::cmemory &properties = rofl::cmemory((size_t)0));
+
+  /**
+   *
+   */
+  cofmsg_role_status(const cofmsg_role_status &msg);
+
+  /**
+   *
+   */
+  cofmsg_role_status &operator=(const cofmsg_role_status &msg);
+
+public:
+  /**
+   *
+   */
+  virtual size_t length() const;
+
+  /**
+   *
+   */
+  virtual void pack(uint8_t *buf = (uint8_t *)0, size_t buflen = 0);
+
+  /**
+   *
+   */
+  virtual void unpack(uint8_t *buf, size_t buflen);
+
+public:
+  /**
+   *
+   */
+  uint32_t get_role() const { return role; };
+
+  /**
+   *
+   */
+  cofmsg_role_status &set_role(uint32_t role) {
+    this->role = role;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint8_t get_reason() const { return reason; };
+
+  /**
+   *
+   */
+  cofmsg_role_status &set_reason(uint8_t reason) {
+    this->reason = reason;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint64_t get_generation_id() const { return generation_id; };
+
+  /**
+   *
+   */
+  cofmsg_role_status &set_generation_id(uint64_t generation_id) {
+    this->generation_id = generation_id;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  const rofl::cmemory &get_properties() const { return properties; };
+
+  /**
+   *
+   */
+  rofl::cmemory &set_properties() { return properties; };
+
+public:
+  friend std::ostream &operator<<(std::ostream &os,
+                                  const cofmsg_role_status &msg) {
+    os << dynamic_cast<const cofmsg &>(msg);
+    os << "<cofmsg_role_status >" << std::endl;
+    os << "<role: " << msg.get_role() << " reason: " << (int)msg.get_reason()
+       << " generation-id: 0x" << std::hex << msg.get_generation_id()
+       << std::dec << " >" << std::endl;
+    os << msg.properties;
+    return os;
+  };
+
+  virtual std::string str() const {
+    std::stringstream ss;
+    ss << cofmsg::str() << "-Role-Status- role: " << role
+       << " reason: " << (int)reason << " generation_id: " << generation_id
+       << " ";
+    return ss.str();
+  };
+
+private:
+  uint32_t role;
+  uint8_t reason;
+  uint64_t generation_id;
+  rofl::cmemory properties;
+};
+
+} // end of namespace openflow
+} // end of namespace rofl
+
+#endif /* COFMSG_ROLE_STATUS_H_ */
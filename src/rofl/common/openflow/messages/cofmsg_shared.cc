@@ -0,0 +1,61 @@
+#include "cofmsg_shared.h"
+
+using namespace rofl::openflow;
+
+cofmsg_shared::~cofmsg_shared() {}
+
+cofmsg_shared::cofmsg_shared(const std::shared_ptr<const rofl::cmemory> &image,
+                             uint32_t xid)
+    : image(image) {
+  if ((not image) ||
+      (image->length() < sizeof(struct rofl::openflow::ofp_header)) ||
+      (be16toh(((const struct rofl::openflow::ofp_header *)image->somem())
+                   ->length) != image->length()))
+    throw eInvalid("cofmsg_shared::cofmsg_shared() invalid image", __FILE__,
+                   __FUNCTION__, __LINE__);
+
+  const struct rofl::openflow::ofp_header *hdr =
+      (const struct rofl::openflow::ofp_header *)image->somem();
+  set_version(hdr->version);
+  set_type(hdr->type);
+  set_xid(xid);
+}
+
+cofmsg_shared::cofmsg_shared(const cofmsg_shared &msg) : cofmsg(msg) {
+  *this = msg;
+}
+
+cofmsg_shared &cofmsg_shared::operator=(const cofmsg_shared &msg) {
+  if (this == &msg)
+    return *this;
+  cofmsg::operator=(msg);
+  image = msg.image;
+  return *this;
+}
+
+void cofmsg_shared::pack(uint8_t *buf, size_t buflen) {
+  /* update the header length only, cofmsg::pack() would clear the entire
+   * buffer otherwise */
+  cofmsg::pack(nullptr, 0);
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  if (buflen < image->length())
+    throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+  memcpy(buf, image->somem(), image->length());
+
+  struct rofl::openflow::ofp_header *hdr =
+      (struct rofl::openflow::ofp_header *)buf;
+  hdr->xid = htobe32(get_xid());
+}
+
+void cofmsg_shared::unpack(uint8_t *buf, size_t buflen) {
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  cofmsg::unpack(buf, buflen);
+
+  image = std::make_shared<const rofl::cmemory>(buf, get_length());
+}
@@ -0,0 +1,97 @@
+/*
+ * cofmsg_shared.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#ifndef COFMSG_SHARED_H_
+#define COFMSG_SHARED_H_ 1
+
+#include <memory>
+
+#include "rofl/common/cmemory.h"
+#include "rofl/common/openflow/messages/cofmsg.h"
+
+namespace rofl {
+namespace openflow {
+
+/**
+ * @brief	A single OpenFlow message in wire format shared by several
+ * instances.
+ *
+ * The image is encoded once and referenced by all instances, e.g., when
+ * sending the same Packet-Out to many datapath elements. pack() copies
+ * the image and stamps this instance's xid into the header. Version,
+ * type and length are taken from the image.
+ */
+class cofmsg_shared : public cofmsg {
+public:
+  /**
+   *
+   */
+  virtual ~cofmsg_shared();
+
+  /**
+   *
+   * @exception rofl::eInvalid image is not a single OpenFlow message
+   */
+  cofmsg_shared(const std::shared_ptr<const rofl::cmemory> &image,
+                uint32_t xid = 0);
+
+  /**
+   *
+   */
+  cofmsg_shared(const cofmsg_shared &msg);
+
+  /**
+   *
+   */
+  cofmsg_shared &operator=(const cofmsg_shared &msg);
+
+public:
+  /** returns length of packet in packed state
+   *
+   */
+  virtual size_t length() const { return image->length(); };
+
+  /**
+   *
+   */
+  virtual void pack(uint8_t *buf = (uint8_t *)0, size_t buflen = 0);
+
+  /**
+   *
+   */
+  virtual void unpack(uint8_t *buf, size_t buflen);
+
+public:
+  /**
+   * @brief	Returns the shared message image
+   */
+  const std::shared_ptr<const rofl::cmemory> &get_image() const {
+    return image;
+  };
+
+public:
+  friend std::ostream &operator<<(std::ostream &os, const cofmsg_shared &msg) {
+    os << "<cofmsg_shared >" << std::endl;
+    { os << dynamic_cast<const cofmsg &>(msg); };
+    os << "<refs: " << msg.image.use_count() << " >" << std::endl;
+    return os;
+  };
+
+  std::string str() const {
+    std::stringstream ss;
+    ss << cofmsg::str() << "-Shared- refs: " << image.use_count() << " ";
+    return ss.str();
+  };
+
+private:
+  std::shared_ptr<const rofl::cmemory> image;
+};
+
+} // end of namespace openflow
+} // end of namespace rofl
+
+#endif /* COFMSG_SHARED_H_ */
@@ -27,7 +27,8 @@ cofmsg_table_mod &cofmsg_table_mod::operator=(const cofmsg_table_mod &msg) {
 size_t cofmsg_table_mod::length() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_table_mod));
   } break;
   default:
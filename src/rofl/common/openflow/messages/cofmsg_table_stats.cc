@@ -35,7 +35,8 @@ size_t cofmsg_table_stats_request::length() const {
   case rofl::openflow12::OFP_VERSION: {
     return (sizeof(struct rofl::openflow12::ofp_stats_request));
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_multipart_request));
   } break;
   default:
@@ -117,7 +118,8 @@ size_t cofmsg_table_stats_reply::length() const {
     return (sizeof(struct rofl::openflow12::ofp_stats_reply) +
             tablestatsarray.length());
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_multipart_reply) +
             tablestatsarray.length());
   } break;
@@ -0,0 +1,115 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "rofl/common/openflow/messages/cofmsg_table_status.h"
+
+using namespace rofl::openflow;
+
+cofmsg_table_status::~cofmsg_table_status() {}
+
+cofmsg_table_status::cofmsg_table_status(
+    uint8_t version, uint32_t xid, uint8_t reason, uint8_t table_id,
+    uint32_t config, const rofl::openflow::coftablemod_props &properties)
+    : cofmsg(version, rofl::openflow14::OFPT_TABLE_STATUS, xid),
+      reason(reason), table_id(table_id), config(config),
+      properties(properties) {
+  this->properties.set_version(version);
+}
+
+cofmsg_table_status::cofmsg_table_status(const cofmsg_table_status &msg) {
+  *this = msg;
+}
+
+cofmsg_table_status &cofmsg_table_status::
+operator=(const cofmsg_table_status &msg) {
+  if (this == &msg)
+    return *this;
+  cofmsg::operator=(msg);
+  reason = msg.reason;
+  table_id = msg.table_id;
+  config = msg.config;
+  properties = msg.properties;
+  return *this;
+}
+
+size_t cofmsg_table_status::length() const {
+  switch (get_version()) {
+  case rofl::openflow14::OFP_VERSION: {
+    return (sizeof(struct rofl::openflow14::ofp_table_status) +
+            properties.length());
+  } break;
+  default:
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+  }
+  return 0;
+}
+
+void cofmsg_table_status::pack(uint8_t *buf, size_t buflen) {
+  cofmsg::pack(buf, buflen);
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  if (buflen < cofmsg_table_status::length())
+    throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+  switch (get_version()) {
+  default: {
+    struct rofl::openflow14::ofp_table_status *hdr =
+        (struct rofl::openflow14::ofp_table_status *)buf;
+
+    hdr->reason = reason;
+    memset(hdr->pad, 0, sizeof(hdr->pad));
+    hdr->table.length = htobe16(
+        sizeof(struct rofl::openflow14::ofp_table_desc) + properties.length());
+    hdr->table.table_id = table_id;
+    hdr->table.pad[0] = 0;
+    hdr->table.config = htobe32(config);
+
+    properties.pack(buf + sizeof(struct rofl::openflow14::ofp_table_status),
+                    properties.length());
+  };
+  }
+}
+
+void cofmsg_table_status::unpack(uint8_t *buf, size_t buflen) {
+  cofmsg::unpack(buf, buflen);
+
+  properties.clear();
+  properties.set_version(get_version());
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  switch (get_version()) {
+  case rofl::openflow14::OFP_VERSION: {
+    if (get_type() != rofl::openflow14::OFPT_TABLE_STATUS)
+      throw eBadRequestBadType("eBadRequestBadType", __FILE__, __FUNCTION__,
+                               __LINE__);
+
+    if (buflen < sizeof(struct rofl::openflow14::ofp_table_status))
+      throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                              __LINE__);
+
+    struct rofl::openflow14::ofp_table_status *hdr =
+        (struct rofl::openflow14::ofp_table_status *)buf;
+
+    reason = hdr->reason;
+    table_id = hdr->table.table_id;
+    config = be32toh(hdr->table.config);
+
+    size_t offset = sizeof(struct rofl::openflow14::ofp_table_status);
+    if (get_length() > offset) {
+      properties.unpack(buf + offset, get_length() - offset);
+    }
+  } break;
+  default:
+    throw eBadRequestBadVersion("eBadRequestBadVersion", __FILE__,
+                                __FUNCTION__, __LINE__);
+  }
+
+  if (get_length() < cofmsg_table_status::length())
+    throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                            __LINE__);
+}
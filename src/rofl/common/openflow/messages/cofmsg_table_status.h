@@ -0,0 +1,158 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cofmsg_table_status.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: andreas
+ */
+
+#ifndef COFMSG_TABLE_STATUS_H_
+#define COFMSG_TABLE_STATUS_H_ 1
+
+#include "rofl/common/openflow/coftablemodprops.h"
+#include "rofl/common/openflow/messages/cofmsg.h"
+
+namespace rofl {
+namespace openflow {
+
+/**
+ * @brief	OpenFlow Table-Status message (OpenFlow 1.4 and beyond)
+ *
+ * Sent by the datapath when a table's configuration has changed, e.g.
+ * when a vacancy threshold has been crossed.
+ */
+class cofmsg_table_status : public cofmsg {
+public:
+  /**
+   *
+   */
+  virtual ~cofmsg_table_status();
+
+  /**
+   *
+   */
+  cofmsg_table_status(uint8_t version = rofl::openflow::OFP_VERSION_UNKNOWN,
+                      uint32_t xid = 0, uint8_t reason = 0,
+                      uint8_t table_id = 0, uint32_t config = 0,
+                      const rofl::openflow::coftablemod_props &properties =
+                          rofl::openflow::coftablemod_props());
+
+  /**
+   *
+   */
+  cofmsg_table_status(const cofmsg_table_status &msg);
+
+  /**
+   *
+   */
+  cofmsg_table_status &operator=(const cofmsg_table_status &msg);
+
+public:
+  /**
+   *
+   */
+  virtual size_t length() const;
+
+  /**
+   *
+   */
+  virtual void pack(uint8_t *buf = (uint8_t *)0, size_t buflen = 0);
+
+  /**
+   *
+   */
+  virtual void unpack(uint8_t *buf, size_t buflen);
+
+public:
+  /**
+   *
+   */
+  uint8_t get_reason() const { return reason; };
+
+  /**
+   *
+   */
+  cofmsg_table_status &set_reason(uint8_t reason) {
+    this->reason = reason;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint8_t get_table_id() const { return table_id; };
+
+  /**
+   *
+   */
+  cofmsg_table_status &set_table_id(uint8_t table_id) {
+    this->table_id = table_id;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint32_t get_config() const { return config; };
+
+  /**
+   *
+   */
+  cofmsg_table_status &set_config(uint32_t config) {
+    this->config = config;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  const rofl::openflow::coftablemod_props &get_properties() const {
+    return properties;
+  };
+
+  /**
+   *
+   */
+  rofl::openflow::coftablemod_props &set_properties() { return properties; };
+
+public:
+  friend std::ostream &operator<<(std::ostream &os,
+                                  const cofmsg_table_status &msg) {
+    os << dynamic_cast<const cofmsg &>(msg);
+    os << "<cofmsg_table_status >" << std::endl;
+    switch (msg.get_reason()) {
+    case rofl::openflow14::OFPTR_VACANCY_DOWN: {
+      os << "<reason: -VACANCY-DOWN- >" << std::endl;
+    } break;
+    case rofl::openflow14::OFPTR_VACANCY_UP: {
+      os << "<reason: -VACANCY-UP- >" << std::endl;
+    } break;
+    default: { os << "<reason: -UNKNOWN- >" << std::endl; } break;
+    }
+    os << "<table-id: " << (int)msg.get_table_id() << " config: 0x" << std::hex
+       << msg.get_config() << std::dec << " >" << std::endl;
+    os << msg.properties;
+    return os;
+  };
+
+  virtual std::string str() const {
+    std::stringstream ss;
+    ss << cofmsg::str() << "-Table-Status- reason: " << (int)reason
+       << " table_id: " << (int)table_id << " config: " << config << " ";
+    return ss.str();
+  };
+
+private:
+  uint8_t reason;
+  uint8_t table_id;
+  uint32_t config;
+  rofl::openflow::coftablemod_props properties;
+};
+
+} // end of namespace openflow
+} // end of namespace rofl
+
+#endif /* COFMSG_TABLE_STATUS_H_ */
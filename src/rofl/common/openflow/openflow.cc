@@ -19,6 +19,7 @@ uint32_t base::get_ofp_no_buffer(uint8_t ofp_version) {
     return rofl::openflow12::OFP_NO_BUFFER;
     break;
   case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
     return rofl::openflow13::OFP_NO_BUFFER;
     break;
   default:
@@ -36,6 +37,7 @@ uint32_t base::get_ofpp_flood_port(uint8_t ofp_version) {
     return rofl::openflow12::OFPP_FLOOD;
     break;
   case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
     return rofl::openflow13::OFPP_FLOOD;
     break;
   default:
@@ -53,6 +55,7 @@ uint32_t base::get_ofpp_controller_port(uint8_t ofp_version) {
     return rofl::openflow12::OFPP_CONTROLLER;
     break;
   case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
     return rofl::openflow13::OFPP_CONTROLLER;
     break;
   default:
@@ -70,6 +73,7 @@ uint8_t base::get_ofptt_all(uint8_t ofp_version) {
     return rofl::openflow12::OFPTT_ALL;
     break;
   case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
     return rofl::openflow13::OFPTT_ALL;
     break;
   default:
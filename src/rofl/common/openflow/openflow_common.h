@@ -626,10 +626,10 @@ enum oxm_tlv_match_fields {
                                  HAS_MASK_FLAG,
   OXM_TLV_BASIC_IPV6_EXTHDR = (uint32_t)(OFPXMC_OPENFLOW_BASIC << 16) |
                               (OFPXMT_OFB_IPV6_EXTHDR << 9) |
-                              4, /* IPv6 Extension Header pseudo-field */
+                              2, /* IPv6 Extension Header pseudo-field */
   OXM_TLV_BASIC_IPV6_EXTHDR_MASK =
       (uint32_t)(OFPXMC_OPENFLOW_BASIC << 16) | (OFPXMT_OFB_IPV6_EXTHDR << 9) |
-      8 | HAS_MASK_FLAG, /* IPv6 Extension Header pseudo-field */
+      4 | HAS_MASK_FLAG, /* IPv6 Extension Header pseudo-field */
 };
 
 /* The VLAN id is 12-bits, so we can use the entire 16 bits to indicate
@@ -38,3 +38,63 @@ void caddrinfos_test::testAddrInfos() {
 
   std::cerr << "addrinfos:" << std::endl << ai;
 }
+
+void caddrinfos_test::testResolver() {
+  cobject object;
+  int error = 0;
+
+  /* numeric addresses are converted inline */
+  rofl::caddrinfos numeric;
+  numeric.set_node("127.0.0.1");
+  numeric.set_service("6653");
+  numeric.set_ai_hints().set_ai_socktype(SOCK_STREAM);
+  CPPUNIT_ASSERT(rofl::cresolver::LOOKUP_RESOLVED ==
+                 rofl::cresolver::lookup(numeric, object.thread_num, &object));
+  CPPUNIT_ASSERT(numeric.size() > 0);
+  CPPUNIT_ASSERT(numeric.get_addr_info(0).get_ai_addr().get_family() ==
+                 AF_INET);
+
+  /* names are resolved by a worker, completion wakes up the object */
+  rofl::caddrinfos named;
+  named.set_node("localhost");
+  named.set_service("6653");
+  named.set_ai_hints().set_ai_family(AF_INET);
+  named.set_ai_hints().set_ai_socktype(SOCK_STREAM);
+  CPPUNIT_ASSERT(rofl::cresolver::LOOKUP_PENDING ==
+                 rofl::cresolver::lookup(named, object.thread_num, &object));
+  CPPUNIT_ASSERT(named.size() == 0);
+
+  unsigned int keep_running = 50;
+  while ((--keep_running > 0) && (object.wakeups == 0)) {
+    usleep(100000);
+  }
+  CPPUNIT_ASSERT(object.wakeups > 0);
+
+  /* served from cache now */
+  CPPUNIT_ASSERT(rofl::cresolver::LOOKUP_RESOLVED ==
+                 rofl::cresolver::lookup(named, object.thread_num, &object));
+  CPPUNIT_ASSERT(named.size() > 0);
+  CPPUNIT_ASSERT(named.get_addr_info(0).get_ai_addr().get_family() ==
+                 AF_INET);
+
+  /* failures are cached as well */
+  rofl::caddrinfos failed;
+  failed.set_node("localhost");
+  failed.set_service("no-such-service");
+  object.wakeups = 0;
+  rofl::cresolver::lookup(failed, object.thread_num, &object);
+  keep_running = 50;
+  while ((--keep_running > 0) && (object.wakeups == 0)) {
+    usleep(100000);
+  }
+  CPPUNIT_ASSERT(rofl::cresolver::LOOKUP_FAILED ==
+                 rofl::cresolver::lookup(failed, object.thread_num, &object,
+                                         &error));
+  CPPUNIT_ASSERT(error != 0);
+
+  rofl::cresolver::flush();
+  CPPUNIT_ASSERT(rofl::cresolver::LOOKUP_PENDING ==
+                 rofl::cresolver::lookup(failed, object.thread_num, nullptr));
+
+  rofl::cresolver::terminate();
+}
@@ -1,5 +1,6 @@
 #include "rofl/common/caddrinfos.h"
 #include "rofl/common/cmemory.h"
+#include "rofl/common/cresolver.hpp"
 #include <cppunit/TestFixture.h>
 #include <cppunit/extensions/HelperMacros.h>
 
@@ -7,12 +8,34 @@ class caddrinfos_test : public CppUnit::TestFixture {
 
   CPPUNIT_TEST_SUITE(caddrinfos_test);
   CPPUNIT_TEST(testAddrInfos);
+  CPPUNIT_TEST(testResolver);
   CPPUNIT_TEST_SUITE_END();
 
 private:
+  class cobject : public rofl::cthread_env {
+  public:
+    virtual ~cobject() { rofl::cthread::thread(thread_num).drop(this); };
+
+    cobject()
+        : thread_num(rofl::cthread::get_mgt_thread_num_from_pool()),
+          wakeups(0){};
+
+  protected:
+    virtual void handle_wakeup(rofl::cthread &thread) { wakeups++; };
+    virtual void handle_timeout(rofl::cthread &thread, uint32_t timer_id){};
+    virtual void handle_read_event(rofl::cthread &thread, int fd){};
+    virtual void handle_write_event(rofl::cthread &thread, int fd){};
+
+  public:
+    uint32_t thread_num;
+
+    std::atomic_uint wakeups;
+  };
+
 public:
   void setUp();
   void tearDown();
 
   void testAddrInfos();
+  void testResolver();
 };
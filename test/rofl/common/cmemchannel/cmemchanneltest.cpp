@@ -0,0 +1,131 @@
+/*
+ * cmemchanneltest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "cmemchanneltest.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(cmemchanneltest);
+
+void cmemchanneltest::setUp() {}
+
+void cmemchanneltest::tearDown() {}
+
+bool cmemchanneltest::readable(int fd) {
+  struct pollfd pfd;
+  pfd.fd = fd;
+  pfd.events = POLLIN;
+  pfd.revents = 0;
+  return (poll(&pfd, 1, 0) == 1) && (pfd.revents & POLLIN);
+}
+
+void cmemchanneltest::testSendRecv() {
+  rofl::cmemchannel channel(64);
+  uint8_t txbuf[48];
+  uint8_t rxbuf[48];
+
+  CPPUNIT_ASSERT(channel.get_ring_size() == 64);
+  CPPUNIT_ASSERT(not readable(channel.get_rx_fd(rofl::cmemchannel::SIDE_B)));
+
+  /* wraps around the end of the ring in the second round */
+  for (unsigned int round = 0; round < 4; round++) {
+    memset(txbuf, round, sizeof(txbuf));
+    CPPUNIT_ASSERT(channel.send(rofl::cmemchannel::SIDE_A, txbuf,
+                                sizeof(txbuf)) == sizeof(txbuf));
+    CPPUNIT_ASSERT(readable(channel.get_rx_fd(rofl::cmemchannel::SIDE_B)));
+    CPPUNIT_ASSERT(not readable(channel.get_rx_fd(rofl::cmemchannel::SIDE_A)));
+
+    memset(rxbuf, 0xff, sizeof(rxbuf));
+    CPPUNIT_ASSERT(channel.recv(rofl::cmemchannel::SIDE_B, rxbuf, 16) == 16);
+    CPPUNIT_ASSERT(channel.recv(rofl::cmemchannel::SIDE_B, rxbuf + 16,
+                                sizeof(rxbuf)) == sizeof(rxbuf) - 16);
+    CPPUNIT_ASSERT(memcmp(txbuf, rxbuf, sizeof(rxbuf)) == 0);
+
+    /* empty ring rearms the eventfd */
+    CPPUNIT_ASSERT(channel.recv(rofl::cmemchannel::SIDE_B, rxbuf,
+                                sizeof(rxbuf)) == -1);
+    CPPUNIT_ASSERT(errno == EAGAIN);
+    CPPUNIT_ASSERT(not readable(channel.get_rx_fd(rofl::cmemchannel::SIDE_B)));
+  }
+
+  /* opposite direction */
+  CPPUNIT_ASSERT(channel.send(rofl::cmemchannel::SIDE_B, txbuf, 8) == 8);
+  CPPUNIT_ASSERT(readable(channel.get_rx_fd(rofl::cmemchannel::SIDE_A)));
+  CPPUNIT_ASSERT(channel.recv(rofl::cmemchannel::SIDE_A, rxbuf, 8) == 8);
+}
+
+void cmemchanneltest::testCongestion() {
+  rofl::cmemchannel channel(64);
+  uint8_t txbuf[100];
+  uint8_t rxbuf[100];
+
+  for (unsigned int i = 0; i < sizeof(txbuf); i++) {
+    txbuf[i] = i;
+  }
+
+  /* partial write fills the ring */
+  CPPUNIT_ASSERT(channel.send(rofl::cmemchannel::SIDE_A, txbuf,
+                              sizeof(txbuf)) == 64);
+  CPPUNIT_ASSERT(channel.send(rofl::cmemchannel::SIDE_A, txbuf + 64,
+                              sizeof(txbuf) - 64) == -1);
+  CPPUNIT_ASSERT(errno == EAGAIN);
+  CPPUNIT_ASSERT(not readable(channel.get_tx_fd(rofl::cmemchannel::SIDE_A)));
+
+  /* consumer signals space to the blocked producer */
+  CPPUNIT_ASSERT(channel.recv(rofl::cmemchannel::SIDE_B, rxbuf, 40) == 40);
+  CPPUNIT_ASSERT(readable(channel.get_tx_fd(rofl::cmemchannel::SIDE_A)));
+
+  CPPUNIT_ASSERT(channel.send(rofl::cmemchannel::SIDE_A, txbuf + 64,
+                              sizeof(txbuf) - 64) == sizeof(txbuf) - 64);
+  CPPUNIT_ASSERT(channel.recv(rofl::cmemchannel::SIDE_B, rxbuf + 40,
+                              sizeof(rxbuf)) == sizeof(rxbuf) - 40);
+  CPPUNIT_ASSERT(memcmp(txbuf, rxbuf, sizeof(rxbuf)) == 0);
+}
+
+void cmemchanneltest::testShutdown() {
+  rofl::cmemchannel channel(64);
+  uint8_t buf[16];
+
+  memset(buf, 0xa5, sizeof(buf));
+  CPPUNIT_ASSERT(channel.send(rofl::cmemchannel::SIDE_A, buf, sizeof(buf)) ==
+                 sizeof(buf));
+
+  channel.shutdown(rofl::cmemchannel::SIDE_A);
+  CPPUNIT_ASSERT(readable(channel.get_rx_fd(rofl::cmemchannel::SIDE_B)));
+  CPPUNIT_ASSERT(readable(channel.get_tx_fd(rofl::cmemchannel::SIDE_B)));
+
+  /* peer drains pending data first */
+  CPPUNIT_ASSERT(channel.recv(rofl::cmemchannel::SIDE_B, buf, sizeof(buf)) ==
+                 sizeof(buf));
+  CPPUNIT_ASSERT(channel.recv(rofl::cmemchannel::SIDE_B, buf, sizeof(buf)) ==
+                 0);
+
+  CPPUNIT_ASSERT(channel.send(rofl::cmemchannel::SIDE_B, buf, sizeof(buf)) ==
+                 -1);
+  CPPUNIT_ASSERT(errno == EPIPE);
+  CPPUNIT_ASSERT(channel.send(rofl::cmemchannel::SIDE_A, buf, sizeof(buf)) ==
+                 -1);
+  CPPUNIT_ASSERT(errno == EPIPE);
+}
+
+void cmemchanneltest::testInvalid() {
+  try {
+    rofl::cmemchannel channel(100);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eMemChannelInvalid &e) {
+  }
+  try {
+    rofl::cmemchannel channel(0);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eMemChannelInvalid &e) {
+  }
+}
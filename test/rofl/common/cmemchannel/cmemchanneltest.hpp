@@ -0,0 +1,38 @@
+/*
+ * cmemchanneltest.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_CMEMCHANNEL_TEST_HPP_
+#define TEST_SRC_ROFL_COMMON_CMEMCHANNEL_TEST_HPP_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/cmemchannel.hpp"
+
+class cmemchanneltest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(cmemchanneltest);
+  CPPUNIT_TEST(testSendRecv);
+  CPPUNIT_TEST(testCongestion);
+  CPPUNIT_TEST(testShutdown);
+  CPPUNIT_TEST(testInvalid);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void testSendRecv();
+  void testCongestion();
+  void testShutdown();
+  void testInvalid();
+
+private:
+  static bool readable(int fd);
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_CMEMCHANNEL_TEST_HPP_ */
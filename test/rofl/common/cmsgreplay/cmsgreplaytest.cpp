@@ -0,0 +1,188 @@
+/*
+ * cmsgreplaytest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#include <fstream>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "cmsgreplaytest.hpp"
+#include "rofl/common/cmsgtrace.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(cmsgreplaytest);
+
+/*static*/ const std::string cmsgreplaytest::streamfile = "cmsgreplaytest.raw";
+/*static*/ const std::string cmsgreplaytest::tracefile = "cmsgreplaytest.trc";
+
+ccontroller::ccontroller() : pkt_ins_rcvd(0) {
+  rofl::openflow::cofhello_elem_versionbitmap vbitmap;
+  vbitmap.add_ofp_version(rofl::openflow13::OFP_VERSION);
+  crofbase::set_versionbitmap(vbitmap);
+}
+
+ccontroller::~ccontroller() {}
+
+void ccontroller::handle_packet_in(rofl::crofdpt &dpt,
+                                   const rofl::cauxid &auxid,
+                                   rofl::openflow::cofmsg_packet_in &msg) {
+  pkt_ins_rcvd++;
+}
+
+void cmsgreplaytest::setUp() {
+  rofl::cthread::pool_initialize(/*#threads=*/8);
+  controller = new ccontroller();
+}
+
+void cmsgreplaytest::tearDown() {
+  rofl::cthread::pool_stop_all_threads();
+  delete controller;
+  rofl::cthread::pool_terminate();
+  rofl::cmsgtrace::terminate();
+  unlink(streamfile.c_str());
+  unlink(tracefile.c_str());
+}
+
+std::string cmsgreplaytest::packet_in(uint32_t xid) {
+  uint8_t frame[64];
+  memset(frame, 0xa5, sizeof(frame));
+  rofl::openflow::cofmatch match(rofl::openflow13::OFP_VERSION);
+  match.set_in_port(3);
+  rofl::openflow::cofmsg_packet_in msg(
+      rofl::openflow13::OFP_VERSION, xid, rofl::openflow::OFP_NO_BUFFER,
+      sizeof(frame), rofl::openflow13::OFPR_NO_MATCH, 0, 0, 0, match, frame,
+      sizeof(frame));
+  std::string buf(msg.length(), '\0');
+  msg.pack((uint8_t *)&buf[0], buf.length());
+  return buf;
+}
+
+void cmsgreplaytest::testStream() {
+  const unsigned int num_of_pkt_ins = 64;
+  const uint8_t version = rofl::openflow13::OFP_VERSION;
+
+  /* recorded datapath side of a session incl. handshake */
+  std::ofstream ofs(streamfile.c_str(), std::ios::out | std::ios::binary);
+
+  rofl::openflow::cofhelloelems helloIEs;
+  helloIEs.add_hello_elem_versionbitmap().add_ofp_version(version);
+  rofl::openflow::cofmsg_hello hello(version, 1, helloIEs);
+  std::string buf(hello.length(), '\0');
+  hello.pack((uint8_t *)&buf[0], buf.length());
+  ofs << buf;
+
+  rofl::openflow::cofmsg_features_reply features(version, 2, 0xa1a2a3a4a5a6a7);
+  buf.assign(features.length(), '\0');
+  features.pack((uint8_t *)&buf[0], buf.length());
+  ofs << buf;
+
+  for (unsigned int i = 0; i < num_of_pkt_ins; i++) {
+    ofs << packet_in(3 + i);
+  }
+
+  rofl::openflow::cofmsg_echo_request echo(version, 0xb1);
+  buf.assign(echo.length(), '\0');
+  echo.pack((uint8_t *)&buf[0], buf.length());
+  ofs << buf;
+
+  /* a recorded Echo-Reply is never replayed */
+  rofl::openflow::cofmsg_echo_reply reply(version, 0xb2);
+  buf.assign(reply.length(), '\0');
+  reply.pack((uint8_t *)&buf[0], buf.length());
+  ofs << buf;
+  ofs.close();
+
+  rofl::cmsgreplay replay;
+  CPPUNIT_ASSERT(replay.load_stream(streamfile) == num_of_pkt_ins + 4);
+
+  rofl::cmsgreplay::cresult result =
+      replay.run(*controller, rofl::crofconn::MODE_CONTROLLER);
+
+  CPPUNIT_ASSERT(result.msgs_sent == num_of_pkt_ins + 3);
+  CPPUNIT_ASSERT(result.msgs_expected == num_of_pkt_ins);
+  CPPUNIT_ASSERT(result.msgs_dispatched == num_of_pkt_ins);
+  CPPUNIT_ASSERT(result.wall_nsec > 0);
+  CPPUNIT_ASSERT(controller->get_pkt_ins_rcvd() == num_of_pkt_ins);
+  CPPUNIT_ASSERT(result.profiles.size() == 1);
+  CPPUNIT_ASSERT(result.profiles[rofl::openflow::OFPT_PACKET_IN].rx_msgs ==
+                 num_of_pkt_ins);
+  CPPUNIT_ASSERT(result.profiles[rofl::openflow::OFPT_PACKET_IN].nsec_max <=
+                 result.profiles[rofl::openflow::OFPT_PACKET_IN].nsec_sum);
+  CPPUNIT_ASSERT(not rofl::crofconn::get_rx_profiling());
+}
+
+void cmsgreplaytest::testTrace() {
+  const unsigned int num_of_pkt_ins = 16;
+  const uint64_t tstamp_step = 2000000;
+
+  /* handshake is missing, e.g., overwritten in a wrapped trace */
+  rofl::cmsgtrace::initialize(tracefile, 64 * 1024, 1);
+  for (unsigned int i = 0; i < num_of_pkt_ins; i++) {
+    std::string buf = packet_in(i);
+    rofl::cmsgtrace::record(rofl::cmsgtrace::DIR_RX, 7, 0,
+                            (const uint8_t *)buf.data(), buf.length());
+    /* other directions and connections are skipped */
+    rofl::cmsgtrace::record(rofl::cmsgtrace::DIR_TX, 7, 0,
+                            (const uint8_t *)buf.data(), buf.length());
+    rofl::cmsgtrace::record(rofl::cmsgtrace::DIR_RX, 8, 0,
+                            (const uint8_t *)buf.data(), buf.length());
+    usleep(tstamp_step / 1000);
+  }
+  rofl::cmsgtrace::terminate();
+
+  rofl::cmsgreplay replay;
+  CPPUNIT_ASSERT(replay.load_trace(tracefile, 7) == num_of_pkt_ins);
+
+  /* counters of earlier replays and other connections are kept */
+  rofl::crofconn::rxprofile_t profile =
+      rofl::crofconn::get_rx_profile(rofl::openflow::OFPT_PACKET_IN);
+
+  /* replay at recorded pace */
+  rofl::cmsgreplay::cresult result =
+      replay.run(*controller, rofl::crofconn::MODE_CONTROLLER, 1.0);
+
+  CPPUNIT_ASSERT(result.msgs_sent == num_of_pkt_ins + 2);
+  CPPUNIT_ASSERT(result.msgs_dispatched == num_of_pkt_ins);
+  CPPUNIT_ASSERT(result.wall_nsec >= (num_of_pkt_ins - 1) * tstamp_step);
+  CPPUNIT_ASSERT(controller->get_pkt_ins_rcvd() == num_of_pkt_ins);
+  CPPUNIT_ASSERT(result.profiles[rofl::openflow::OFPT_PACKET_IN].rx_msgs ==
+                 num_of_pkt_ins);
+  CPPUNIT_ASSERT(result.profiles[rofl::openflow::OFPT_PACKET_IN].nsec_max <=
+                 result.profiles[rofl::openflow::OFPT_PACKET_IN].nsec_sum);
+  CPPUNIT_ASSERT(
+      rofl::crofconn::get_rx_profile(rofl::openflow::OFPT_PACKET_IN).rx_msgs ==
+      profile.rx_msgs + num_of_pkt_ins);
+}
+
+void cmsgreplaytest::testInvalid() {
+  rofl::cmsgreplay replay;
+
+  try {
+    replay.run(*controller, rofl::crofconn::MODE_CONTROLLER);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eMsgReplayInvalid &e) {
+  }
+
+  std::string buf = packet_in(1);
+  try {
+    replay.add_message((const uint8_t *)buf.data(), buf.length() - 1);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eMsgReplayInvalid &e) {
+  }
+
+  std::ofstream ofs(streamfile.c_str(), std::ios::out | std::ios::binary);
+  ofs << buf.substr(0, buf.length() - 1);
+  ofs.close();
+  try {
+    replay.load_stream(streamfile);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eMsgReplayInvalid &e) {
+  }
+
+  CPPUNIT_ASSERT(replay.size() == 0);
+}
@@ -0,0 +1,60 @@
+/*
+ * cmsgreplaytest.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_CMSGREPLAY_TEST_HPP_
+#define TEST_SRC_ROFL_COMMON_CMSGREPLAY_TEST_HPP_
+
+#include <atomic>
+#include <string>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/cmsgreplay.hpp"
+
+class ccontroller : public rofl::crofbase {
+public:
+  ccontroller();
+
+  ~ccontroller();
+
+  size_t get_pkt_ins_rcvd() const { return pkt_ins_rcvd; };
+
+private:
+  virtual void handle_packet_in(rofl::crofdpt &dpt, const rofl::cauxid &auxid,
+                                rofl::openflow::cofmsg_packet_in &msg);
+
+private:
+  std::atomic<size_t> pkt_ins_rcvd;
+};
+
+class cmsgreplaytest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(cmsgreplaytest);
+  CPPUNIT_TEST(testStream);
+  CPPUNIT_TEST(testTrace);
+  CPPUNIT_TEST(testInvalid);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void testStream();
+  void testTrace();
+  void testInvalid();
+
+private:
+  static std::string packet_in(uint32_t xid);
+
+  static const std::string streamfile;
+  static const std::string tracefile;
+
+  ccontroller *controller;
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_CMSGREPLAY_TEST_HPP_ */
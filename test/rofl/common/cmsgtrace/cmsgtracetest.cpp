@@ -0,0 +1,214 @@
+/*
+ * cmsgtracetest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#include <fstream>
+#include <pthread.h>
+#include <sstream>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "cmsgtracetest.hpp"
+#include "rofl/common/openflow/openflow_common.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(cmsgtracetest);
+
+/*static*/ const std::string cmsgtracetest::tracefile = "cmsgtracetest.trc";
+/*static*/ const std::string cmsgtracetest::pcapfile = "cmsgtracetest.pcapng";
+
+void cmsgtracetest::setUp() {}
+
+void cmsgtracetest::tearDown() {
+  rofl::cmsgtrace::terminate();
+  unlink(tracefile.c_str());
+  unlink(pcapfile.c_str());
+}
+
+std::vector<cmsgtracetest::cpcapngpacket>
+cmsgtracetest::read_pcapng(const std::string &path) {
+  std::ifstream ifs(path.c_str(), std::ios::in | std::ios::binary);
+  std::stringstream ss;
+  ss << ifs.rdbuf();
+  std::string file = ss.str();
+
+  std::vector<cpcapngpacket> packets;
+  size_t offset = 0;
+  while (offset + 12 <= file.length()) {
+    uint32_t type = *(const uint32_t *)(file.data() + offset);
+    uint32_t blocklen = *(const uint32_t *)(file.data() + offset + 4);
+    CPPUNIT_ASSERT((blocklen % 4) == 0);
+    CPPUNIT_ASSERT(offset + blocklen <= file.length());
+    CPPUNIT_ASSERT(*(const uint32_t *)(file.data() + offset + blocklen - 4) ==
+                   blocklen);
+
+    if (type == 6) {
+      const char *epb = file.data() + offset;
+      cpcapngpacket packet;
+      packet.caplen = *(const uint32_t *)(epb + 20);
+      packet.origlen = *(const uint32_t *)(epb + 24);
+      packet.data = std::string(epb + 28, packet.caplen);
+      const char *opt = epb + 28 + ((packet.caplen + 3) & ~3);
+      if (*(const uint16_t *)opt == 1) {
+        packet.comment = std::string(opt + 4, *(const uint16_t *)(opt + 2));
+      }
+      packets.push_back(packet);
+    }
+    offset += blocklen;
+  }
+  CPPUNIT_ASSERT(offset == file.length());
+  return packets;
+}
+
+void *cmsgtracetest::record_thread(void *arg) {
+  uint8_t msg[64];
+  memset(msg, 0xb0, sizeof(msg));
+  struct rofl::openflow::ofp_header *hdr =
+      (struct rofl::openflow::ofp_header *)msg;
+  hdr->version = 4;
+  hdr->type = rofl::openflow::OFPT_PACKET_OUT;
+  hdr->length = htobe16(sizeof(msg));
+  hdr->xid = htobe32(0xb1b2b3b4);
+  rofl::cmsgtrace::record(rofl::cmsgtrace::DIR_TX, 2, 1, msg, sizeof(msg));
+  return NULL;
+}
+
+void cmsgtracetest::testExport() {
+  /* disabled by default, records are ignored */
+  uint8_t msg[16];
+  memset(msg, 0, sizeof(msg));
+  rofl::cmsgtrace::record(rofl::cmsgtrace::DIR_RX, 1, 0, msg, sizeof(msg));
+  CPPUNIT_ASSERT(not rofl::cmsgtrace::is_enabled());
+
+  rofl::cmsgtrace::initialize(tracefile, 65536, 4);
+  CPPUNIT_ASSERT(rofl::cmsgtrace::is_enabled());
+
+  memset(msg, 0xa0, sizeof(msg));
+  struct rofl::openflow::ofp_header *hdr =
+      (struct rofl::openflow::ofp_header *)msg;
+  hdr->version = 4;
+  hdr->type = rofl::openflow::OFPT_ECHO_REQUEST;
+  hdr->length = htobe16(sizeof(msg));
+  hdr->xid = htobe32(0xa1a2a3a4);
+  rofl::cmsgtrace::record(rofl::cmsgtrace::DIR_RX, 1, 0, msg, sizeof(msg));
+
+  /* second thread records into its own ring */
+  pthread_t tid;
+  CPPUNIT_ASSERT(pthread_create(&tid, NULL, &record_thread, NULL) == 0);
+  pthread_join(tid, NULL);
+
+  /* export works while tracing is still enabled */
+  CPPUNIT_ASSERT(rofl::cmsgtrace::export_pcapng(tracefile, pcapfile) == 2);
+  rofl::cmsgtrace::terminate();
+  CPPUNIT_ASSERT(rofl::cmsgtrace::export_pcapng(tracefile, pcapfile) == 2);
+
+  std::vector<cpcapngpacket> packets = read_pcapng(pcapfile);
+  CPPUNIT_ASSERT(packets.size() == 2);
+
+  /* Ethernet + IPv4 + TCP pseudo header */
+  const size_t hdrlen = 14 + 20 + 20;
+
+  /* received by local side on TCP port 6653 */
+  const cpcapngpacket &rx = packets[0];
+  CPPUNIT_ASSERT(rx.caplen == hdrlen + sizeof(msg));
+  CPPUNIT_ASSERT(rx.origlen == hdrlen + sizeof(msg));
+  CPPUNIT_ASSERT(memcmp(rx.data.data() + hdrlen, msg, sizeof(msg)) == 0);
+  CPPUNIT_ASSERT(be16toh(*(const uint16_t *)(rx.data.data() + 12)) == 0x0800);
+  CPPUNIT_ASSERT(be32toh(*(const uint32_t *)(rx.data.data() + 14 + 16)) ==
+                 0x7f000001);
+  CPPUNIT_ASSERT(be16toh(*(const uint16_t *)(rx.data.data() + 34)) == 49152);
+  CPPUNIT_ASSERT(be16toh(*(const uint16_t *)(rx.data.data() + 36)) == 6653);
+  CPPUNIT_ASSERT(rx.comment == "connid=1 auxid=0");
+
+  /* sent from local side */
+  const cpcapngpacket &tx = packets[1];
+  CPPUNIT_ASSERT(tx.caplen == hdrlen + 64);
+  CPPUNIT_ASSERT(be16toh(*(const uint16_t *)(tx.data.data() + 34)) == 6653);
+  CPPUNIT_ASSERT(be16toh(*(const uint16_t *)(tx.data.data() + 36)) == 49153);
+  CPPUNIT_ASSERT(be32toh(*(const uint32_t *)(tx.data.data() + hdrlen + 4)) ==
+                 0xb1b2b3b4);
+  CPPUNIT_ASSERT(tx.comment == "connid=2 auxid=1");
+}
+
+void cmsgtracetest::testWrap() {
+  /* small ring with truncated records */
+  rofl::cmsgtrace::initialize(tracefile, 4096, 1, 512);
+
+  uint8_t msg[1000];
+  const unsigned int num = 64;
+  for (unsigned int i = 0; i < num; i++) {
+    memset(msg, i, sizeof(msg));
+    size_t msglen = 100 + 13 * i;
+    struct rofl::openflow::ofp_header *hdr =
+        (struct rofl::openflow::ofp_header *)msg;
+    hdr->version = 4;
+    hdr->type = rofl::openflow::OFPT_PACKET_OUT;
+    hdr->length = htobe16(msglen);
+    hdr->xid = htobe32(i);
+    rofl::cmsgtrace::record(rofl::cmsgtrace::DIR_TX, 7, 0, msg, msglen);
+  }
+
+  size_t exported = rofl::cmsgtrace::export_pcapng(tracefile, pcapfile);
+  CPPUNIT_ASSERT(exported > 0);
+  CPPUNIT_ASSERT(exported < num);
+
+  /* the most recent records survive in order */
+  std::vector<cpcapngpacket> packets = read_pcapng(pcapfile);
+  CPPUNIT_ASSERT(packets.size() == exported);
+  const size_t hdrlen = 14 + 20 + 20;
+  for (unsigned int j = 0; j < packets.size(); j++) {
+    unsigned int i = num - packets.size() + j;
+    size_t msglen = 100 + 13 * i;
+    const cpcapngpacket &packet = packets[j];
+    CPPUNIT_ASSERT(packet.origlen == hdrlen + msglen);
+    CPPUNIT_ASSERT(packet.caplen == hdrlen + std::min(msglen, (size_t)512));
+    CPPUNIT_ASSERT(be32toh(*(const uint32_t *)(packet.data.data() + hdrlen +
+                                               4)) == i);
+    CPPUNIT_ASSERT((uint8_t)packet.data[packet.caplen - 1] == i);
+  }
+}
+
+void cmsgtracetest::testRingsExhausted() {
+  rofl::cmsgtrace::initialize(tracefile, 4096, 1);
+
+  uint8_t msg[8];
+  memset(msg, 0, sizeof(msg));
+  rofl::cmsgtrace::record(rofl::cmsgtrace::DIR_RX, 1, 0, msg, sizeof(msg));
+  CPPUNIT_ASSERT(rofl::cmsgtrace::get_drops() == 0);
+
+  /* no ring left for a second thread */
+  pthread_t tid;
+  CPPUNIT_ASSERT(pthread_create(&tid, NULL, &record_thread, NULL) == 0);
+  pthread_join(tid, NULL);
+  CPPUNIT_ASSERT(rofl::cmsgtrace::get_drops() == 1);
+
+  /* rings are claimed again after re-initialization */
+  rofl::cmsgtrace::initialize(tracefile, 4096, 1);
+  rofl::cmsgtrace::record(rofl::cmsgtrace::DIR_RX, 1, 0, msg, sizeof(msg));
+  CPPUNIT_ASSERT(rofl::cmsgtrace::get_drops() == 0);
+  CPPUNIT_ASSERT(rofl::cmsgtrace::export_pcapng(tracefile, pcapfile) == 1);
+}
+
+void cmsgtracetest::testInvalid() {
+  std::ofstream ofs(tracefile.c_str(), std::ios::out | std::ios::binary);
+  ofs << std::string(128, 'x');
+  ofs.close();
+
+  try {
+    rofl::cmsgtrace::export_pcapng(tracefile, pcapfile);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eMsgTraceInvalid &e) {
+  }
+
+  try {
+    rofl::cmsgtrace::export_pcapng("cmsgtracetest.missing", pcapfile);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eSysCall &e) {
+  }
+}
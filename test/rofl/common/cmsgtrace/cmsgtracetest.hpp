@@ -0,0 +1,53 @@
+/*
+ * cmsgtracetest.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_CMSGTRACE_TEST_HPP_
+#define TEST_SRC_ROFL_COMMON_CMSGTRACE_TEST_HPP_
+
+#include <string>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/cmsgtrace.hpp"
+
+class cmsgtracetest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(cmsgtracetest);
+  CPPUNIT_TEST(testExport);
+  CPPUNIT_TEST(testWrap);
+  CPPUNIT_TEST(testRingsExhausted);
+  CPPUNIT_TEST(testInvalid);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void testExport();
+  void testWrap();
+  void testRingsExhausted();
+  void testInvalid();
+
+private:
+  struct cpcapngpacket {
+    uint32_t caplen;
+    uint32_t origlen;
+    std::string data;
+    std::string comment;
+  };
+
+  std::vector<cpcapngpacket> read_pcapng(const std::string &path);
+
+  static void *record_thread(void *arg);
+
+  static const std::string tracefile;
+  static const std::string pcapfile;
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_CMSGTRACE_TEST_HPP_ */
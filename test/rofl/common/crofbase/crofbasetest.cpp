@@ -41,6 +41,89 @@ void crofbasetest::test() {
     LOG(INFO) << "#";
   }
   LOG(INFO) << std::endl;
+
+  /* three frames via batch API, one via multi-datapath API */
+  for (unsigned int i = 0; (i < 10) && (datapath->get_pkt_outs_rcvd() < 4);
+       i++) {
+    struct timespec ts;
+    ts.tv_sec = 0;
+    ts.tv_nsec = 100000000;
+    pselect(0, NULL, NULL, NULL, &ts, NULL);
+  }
+  CPPUNIT_ASSERT(controller->get_pkt_outs_queued() == 3);
+  CPPUNIT_ASSERT(controller->get_pkt_outs_dpts() == 1);
+  CPPUNIT_ASSERT(datapath->get_pkt_outs_rcvd() == 4);
+  CPPUNIT_ASSERT(datapath->get_pkt_outs_valid() == 4);
+
+  /* reconciliation stalled by the exhausted flow queue is resumed */
+  for (unsigned int i = 0; (i < 100) && not controller->get_reconciled();
+       i++) {
+    controller->set_dpt(controller->get_dptid())
+        .resume_flowtable_reconciliation();
+    struct timespec ts;
+    ts.tv_sec = 0;
+    ts.tv_nsec = 100000000;
+    pselect(0, NULL, NULL, NULL, &ts, NULL);
+  }
+  CPPUNIT_ASSERT(controller->get_reconciled());
+  CPPUNIT_ASSERT(controller->get_reconcile_delta() == NUM_FLOW_MODS);
+  CPPUNIT_ASSERT(controller->get_reconcile_queued() == NUM_FLOW_MODS);
+
+  /* Flow-Mods split over several blocks arrive complete, all shadowed
+   * entries are missing on the datapath and are sent once more */
+  for (unsigned int i = 0;
+       (i < 10) && (datapath->get_flow_mods_rcvd() < 2 * NUM_FLOW_MODS);
+       i++) {
+    struct timespec ts;
+    ts.tv_sec = 0;
+    ts.tv_nsec = 100000000;
+    pselect(0, NULL, NULL, NULL, &ts, NULL);
+  }
+  CPPUNIT_ASSERT(controller->get_flow_mods_full());
+  CPPUNIT_ASSERT(controller->get_flow_mods_queued() == NUM_FLOW_MODS);
+  CPPUNIT_ASSERT(datapath->get_flow_mods_rcvd() == 2 * NUM_FLOW_MODS);
+}
+
+void crofbasetest::testAdmission() {
+  const unsigned int NUM_CONNS = 5;
+
+  /* a single token, no refill within this test */
+  controller->set_admission_rate(0.001, 1);
+  controller->set_admission_max_pending(2);
+
+  std::vector<int> sds;
+  for (unsigned int i = 0; i < NUM_CONNS; i++) {
+    rofl::csockaddr raddr(AF_INET, "127.0.0.1", 6653);
+    int sd = ::socket(AF_INET, SOCK_STREAM, 0);
+    CPPUNIT_ASSERT(sd >= 0);
+    CPPUNIT_ASSERT(::connect(sd, raddr.ca_saddr, raddr.salen) == 0);
+    sds.push_back(sd);
+  }
+
+  for (unsigned int i = 0; i < 20; i++) {
+    if (controller->get_admission_negotiating() +
+            controller->get_admission_pending() +
+            controller->get_admission_dropped() ==
+        NUM_CONNS)
+      break;
+    struct timespec ts;
+    ts.tv_sec = 0;
+    ts.tv_nsec = 100000000;
+    pselect(0, NULL, NULL, NULL, &ts, NULL);
+  }
+
+  /* one admitted, the queue limit is hit before or after admission
+   * depending on how many connections a single read event accepts */
+  CPPUNIT_ASSERT(controller->get_admission_negotiating() == 1);
+  CPPUNIT_ASSERT(controller->get_admission_pending() <= 2);
+  CPPUNIT_ASSERT(controller->get_admission_dropped() >= NUM_CONNS - 3);
+  CPPUNIT_ASSERT(controller->get_admission_pending() +
+                     controller->get_admission_dropped() ==
+                 NUM_CONNS - 1);
+
+  for (auto sd : sds) {
+    ::close(sd);
+  }
 }
 
 void crofbasetest::handle_wakeup(rofl::cthread &thread) {}
@@ -50,7 +133,10 @@ void crofbasetest::handle_timeout(rofl::cthread &thread, uint32_t timer_id) {}
 ccontroller::~ccontroller() {}
 
 ccontroller::ccontroller()
-    : baddr(rofl::csockaddr(AF_INET, "127.0.0.1", 6653)), __keep_running(true) {
+    : baddr(rofl::csockaddr(AF_INET, "127.0.0.1", 6653)), pkt_outs_queued(0),
+      pkt_outs_dpts(0), flow_mods_queued(0), flow_mods_full(false),
+      reconciled(false), reconcile_delta(0), reconcile_queued(0),
+      __keep_running(true) {
   vbitmap.add_ofp_version(rofl::openflow13::OFP_VERSION);
 
   crofbase::set_versionbitmap(vbitmap);
@@ -62,7 +148,8 @@ cdatapath::~cdatapath() {}
 cdatapath::cdatapath()
     : raddr(rofl::csockaddr(AF_INET, "127.0.0.1", 6653)),
       dpid(0xa0a1a2a3a4a5a6a7), n_buffers(0xb0b1b2b3), n_tables(0xc1),
-      capabilities(0xd0d1d2d3), flags(0xf0f1), miss_send_len(0xa0a1) {
+      capabilities(0xd0d1d2d3), flags(0xf0f1), miss_send_len(0xa0a1),
+      pkt_outs_rcvd(0), pkt_outs_valid(0), flow_mods_rcvd(0) {
   vbitmap.add_ofp_version(rofl::openflow13::OFP_VERSION);
 
   ctlid = add_ctl().get_ctlid();
@@ -132,6 +219,42 @@ void cdatapath::handle_barrier_request(
   /* do not send barrier-reply back => wait for request timeout at controller */
 }
 
+void cdatapath::handle_packet_out(rofl::crofctl &ctl,
+                                  const rofl::cauxid &auxid,
+                                  rofl::openflow::cofmsg_packet_out &msg) {
+  LOG(INFO) << ">>> XXX -Packet-Out- rcvd" << std::endl;
+
+  pkt_outs_rcvd++;
+
+  /* frames sent by the controller are filled with 0xa0 + in_port, the
+   * frame sent via multi-datapath API carries in_port 3 and 0xa0 */
+  uint8_t fill = 0xa0 + ((msg.get_in_port() < 3) ? msg.get_in_port() : 0);
+  uint8_t expected[64];
+  memset(expected, fill, sizeof(expected));
+
+  if ((msg.get_buffer_id() == rofl::openflow::OFP_NO_BUFFER) &&
+      (msg.get_packet().length() == sizeof(expected)) &&
+      (memcmp(msg.get_packet().soframe(), expected, sizeof(expected)) == 0) &&
+      (msg.get_actions().get_action_output(rofl::cindex(0)).get_port_no() ==
+       1)) {
+    pkt_outs_valid++;
+  }
+}
+
+void cdatapath::handle_flow_mod(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                                rofl::openflow::cofmsg_flow_mod &msg) {
+  flow_mods_rcvd++;
+}
+
+void cdatapath::handle_flow_stats_request(
+    rofl::crofctl &ctl, const rofl::cauxid &auxid,
+    rofl::openflow::cofmsg_flow_stats_request &msg) {
+  /* no flow entries installed */
+  ctl.send_flow_stats_reply(
+      auxid, msg.get_xid(),
+      rofl::openflow::cofflowstatsarray(msg.get_version()));
+}
+
 void ccontroller::handle_get_config_reply(
     rofl::crofdpt &dpt, const rofl::cauxid &auxid,
     rofl::openflow::cofmsg_get_config_reply &msg) {
@@ -171,6 +294,56 @@ void ccontroller::handle_port_desc_stats_reply(
     rofl::openflow::cofmsg_port_desc_stats_reply &msg) {
   LOG(INFO) << ">>> XXX -Port-Desc-Stats-Reply- rcvd" << std::endl;
 
+  rofl::openflow::cofactions actions(dpt.get_version());
+  actions.add_action_output(rofl::cindex(0)).set_port_no(1);
+
+  uint8_t data[3][64];
+  std::vector<rofl::openflow::cofpacket_out_frame> frames;
+  for (unsigned int i = 0; i < 3; i++) {
+    memset(data[i], 0xa0 + i, sizeof(data[i]));
+    frames.push_back(rofl::openflow::cofpacket_out_frame(
+        rofl::openflow::OFP_NO_BUFFER, i, data[i], sizeof(data[i])));
+  }
+
+  size_t num_queued = 0;
+  dpt.send_packet_out_messages(auxid, actions, frames, &num_queued);
+  pkt_outs_queued = num_queued;
+
+  /* unknown datapaths are skipped */
+  std::list<rofl::cdptid> dptids;
+  dptids.push_back(dpt.get_dptid());
+  dptids.push_back(dpt.get_dptid() + 1);
+  pkt_outs_dpts = send_packet_out_message(dptids, auxid,
+                                          rofl::openflow::OFP_NO_BUFFER, 3,
+                                          actions, data[0], sizeof(data[0]));
+
+  std::vector<rofl::openflow::cofflowmod> flowmods;
+  for (unsigned int i = 0; i < crofbasetest::NUM_FLOW_MODS; i++) {
+    flowmods.push_back(rofl::openflow::cofflowmod(dpt.get_version()));
+    flowmods.back().set_command(rofl::openflow::OFPFC_ADD);
+    flowmods.back().set_priority(i);
+    flowmods.back().set_instructions().set_inst_apply_actions().set_actions() =
+        actions;
+  }
+
+  /* nothing is sent while the flow queue is exhausted */
+  size_t txqueue_max_size = dpt.set_conn(auxid).get_txqueue_max_size();
+  dpt.set_flowtable_shadowing(true);
+  dpt.set_conn(auxid).set_txqueue_max_size(0);
+  flow_mods_full = (rofl::crofsock::MSG_QUEUEING_FAILED_QUEUE_FULL ==
+                    dpt.send_flow_mod_messages(auxid, flowmods, &num_queued)) &&
+                   (0 == num_queued);
+
+  /* entries exceed a single 64kB block */
+  dpt.set_conn(auxid).set_txqueue_max_size(2 * crofbasetest::NUM_FLOW_MODS);
+  dpt.send_flow_mod_messages(auxid, flowmods, &num_queued);
+  flow_mods_queued = num_queued;
+  dpt.set_conn(auxid).set_txqueue_max_size(txqueue_max_size);
+
+  /* datapath reports an empty flow table, the shadowed entries are
+   * re-added in several rounds limited by the flow queue's capacity */
+  dpt.reconcile_flowtable(auxid, 5);
+
   for (int i = 0; i < 4; i++) {
     dpt.send_barrier_request(auxid);
   }
@@ -190,3 +363,14 @@ void ccontroller::handle_barrier_reply_timeout(rofl::crofdpt &dpt,
 
   set_keep_running(false);
 }
+
+void ccontroller::handle_flow_table_reconciled(rofl::crofdpt &dpt,
+                                               const rofl::cauxid &auxid,
+                                               size_t num_delta,
+                                               size_t num_queued) {
+  LOG(INFO) << ">>> XXX -Flow-Table-Reconciled- rcvd" << std::endl;
+
+  reconcile_delta = num_delta;
+  reconcile_queued = num_queued;
+  reconciled = true;
+}
@@ -49,6 +49,41 @@ public:
    */
   const rofl::cdptid &get_dptid() const { return dptid; };
 
+  /**
+   *
+   */
+  size_t get_pkt_outs_queued() const { return pkt_outs_queued; };
+
+  /**
+   *
+   */
+  size_t get_pkt_outs_dpts() const { return pkt_outs_dpts; };
+
+  /**
+   *
+   */
+  size_t get_flow_mods_queued() const { return flow_mods_queued; };
+
+  /**
+   *
+   */
+  bool get_flow_mods_full() const { return flow_mods_full; };
+
+  /**
+   *
+   */
+  bool get_reconciled() const { return reconciled; };
+
+  /**
+   *
+   */
+  size_t get_reconcile_delta() const { return reconcile_delta; };
+
+  /**
+   *
+   */
+  size_t get_reconcile_queued() const { return reconcile_queued; };
+
 private:
   virtual void handle_dpt_open(rofl::crofdpt &dpt);
 
@@ -74,6 +109,11 @@ private:
 
   virtual void handle_barrier_reply_timeout(rofl::crofdpt &dpt, uint32_t xid);
 
+  virtual void handle_flow_table_reconciled(rofl::crofdpt &dpt,
+                                            const rofl::cauxid &auxid,
+                                            size_t num_delta,
+                                            size_t num_queued);
+
 private:
   rofl::openflow::cofhello_elem_versionbitmap vbitmap;
 
@@ -83,6 +123,23 @@ private:
   // dptid
   rofl::cdptid dptid;
 
+  // Packet-Outs queued via batch API
+  std::atomic_size_t pkt_outs_queued;
+
+  // datapaths reached via multi-datapath API
+  std::atomic_size_t pkt_outs_dpts;
+
+  // Flow-Mods queued via batch API
+  std::atomic_size_t flow_mods_queued;
+
+  // batch API reported an exhausted flow queue
+  std::atomic_bool flow_mods_full;
+
+  // shadow flow table reconciliation has finished
+  std::atomic_bool reconciled;
+  std::atomic_size_t reconcile_delta;
+  std::atomic_size_t reconcile_queued;
+
   // keep test running
   std::atomic_bool __keep_running;
 
@@ -114,6 +171,21 @@ public:
    */
   const rofl::cctlid &get_ctlid() const { return ctlid; };
 
+  /**
+   *
+   */
+  unsigned int get_pkt_outs_rcvd() const { return pkt_outs_rcvd; };
+
+  /**
+   *
+   */
+  unsigned int get_pkt_outs_valid() const { return pkt_outs_valid; };
+
+  /**
+   *
+   */
+  unsigned int get_flow_mods_rcvd() const { return flow_mods_rcvd; };
+
 private:
   virtual void handle_ctl_open(rofl::crofctl &ctl);
 
@@ -137,6 +209,16 @@ private:
   handle_barrier_request(rofl::crofctl &ctl, const rofl::cauxid &auxid,
                          rofl::openflow::cofmsg_barrier_request &msg);
 
+  virtual void handle_packet_out(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                                 rofl::openflow::cofmsg_packet_out &msg);
+
+  virtual void handle_flow_mod(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                               rofl::openflow::cofmsg_flow_mod &msg);
+
+  virtual void
+  handle_flow_stats_request(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                            rofl::openflow::cofmsg_flow_stats_request &msg);
+
 private:
   rofl::openflow::cofhello_elem_versionbitmap vbitmap;
 
@@ -154,12 +236,21 @@ private:
   uint16_t miss_send_len;
   rofl::openflow::coftables tables;
   rofl::openflow::cofports ports;
+  std::atomic_uint pkt_outs_rcvd;
+  std::atomic_uint pkt_outs_valid;
+  std::atomic_uint flow_mods_rcvd;
 };
 
 class crofbasetest : public CppUnit::TestFixture, public rofl::cthread_env {
+public:
+  // Flow-Mods sent via batch API, enough to fill more than one block
+  static const unsigned int NUM_FLOW_MODS = 2048;
+
+private:
 
   CPPUNIT_TEST_SUITE(crofbasetest);
   CPPUNIT_TEST(test);
+  CPPUNIT_TEST(testAdmission);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -168,6 +259,7 @@ public:
 
 public:
   void test();
+  void testAdmission();
 
 private:
   virtual void handle_wakeup(rofl::cthread &thread);
@@ -0,0 +1,209 @@
+/*
+ * crofbundletest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#include <glog/logging.h>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "crofbundletest.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(crofbundletest);
+
+static const uint16_t BUNDLE_TEST_PORT = 6654;
+
+void crofbundletest::setUp() {
+  rofl::cthread::pool_initialize(/*#threads=*/16);
+  controller = new cbundlectl();
+  datapath = new cbundledpt();
+}
+
+void crofbundletest::tearDown() {
+  rofl::cthread::pool_stop_all_threads();
+  delete controller;
+  delete datapath;
+  rofl::cthread::pool_terminate();
+}
+
+bool crofbundletest::wait_for(const std::function<bool()> &cond) {
+  for (unsigned int i = 0; i < 50; i++) {
+    if (cond())
+      return true;
+    struct timespec ts;
+    ts.tv_sec = 0;
+    ts.tv_nsec = 100000000;
+    pselect(0, NULL, NULL, NULL, &ts, NULL);
+  }
+  return cond();
+}
+
+rofl::openflow::cofbundle
+crofbundletest::make_bundle(uint32_t bundle_id, unsigned int num_flow_mods) {
+  rofl::openflow::cofbundle bundle(rofl::openflow14::OFP_VERSION, bundle_id);
+  for (unsigned int i = 0; i < num_flow_mods; i++) {
+    rofl::openflow::cofflowmod flowmod(rofl::openflow14::OFP_VERSION);
+    flowmod.set_command(rofl::openflow::OFPFC_ADD);
+    flowmod.set_priority(i);
+    bundle.add_flow_mod(flowmod);
+  }
+  return bundle;
+}
+
+void crofbundletest::testCongestion() {
+  const unsigned int NUM_FLOW_MODS = 20;
+  rofl::cauxid auxid(0);
+
+  datapath->test_start();
+  CPPUNIT_ASSERT(wait_for([&]() { return controller->get_dpt_open(); }));
+
+  rofl::crofdpt &dpt = controller->set_dpt(controller->get_dptid());
+
+  /* the Open-Request fits into the txqueue, the Bundle-Add-Messages follow
+   * while the txqueue drains */
+  rofl::openflow::cofbundle bundle = make_bundle(1, NUM_FLOW_MODS);
+  size_t txqueue_max_size = dpt.set_conn(auxid).get_txqueue_max_size();
+  size_t num_queued = NUM_FLOW_MODS;
+  dpt.set_conn(auxid).set_txqueue_max_size(2);
+  CPPUNIT_ASSERT(rofl::crofsock::MSG_QUEUED_CONGESTION ==
+                 dpt.send_bundle(auxid, bundle, 5, &num_queued));
+  CPPUNIT_ASSERT(num_queued < NUM_FLOW_MODS);
+
+  /* bundle stays open and is committed with all messages */
+  CPPUNIT_ASSERT(
+      wait_for([&]() { return controller->get_bundles_committed() == 1; }));
+  dpt.set_conn(auxid).set_txqueue_max_size(txqueue_max_size);
+  CPPUNIT_ASSERT(controller->get_bundles_failed() == 0);
+  CPPUNIT_ASSERT(datapath->get_opened() == 1);
+  CPPUNIT_ASSERT(datapath->get_added() == NUM_FLOW_MODS);
+  CPPUNIT_ASSERT(datapath->get_committed() == 1);
+  CPPUNIT_ASSERT(datapath->get_discarded() == 0);
+
+  /* bundle fitting into the txqueue is queued at once */
+  bundle.set_bundle_id(2);
+  CPPUNIT_ASSERT(rofl::crofsock::MSG_QUEUED ==
+                 dpt.send_bundle(auxid, bundle, 5, &num_queued));
+  CPPUNIT_ASSERT(num_queued == NUM_FLOW_MODS);
+  CPPUNIT_ASSERT(
+      wait_for([&]() { return controller->get_bundles_committed() == 2; }));
+  CPPUNIT_ASSERT(datapath->get_opened() == 2);
+  CPPUNIT_ASSERT(datapath->get_added() == 2 * NUM_FLOW_MODS);
+  CPPUNIT_ASSERT(datapath->get_committed() == 2);
+  CPPUNIT_ASSERT(datapath->get_discarded() == 0);
+}
+
+void crofbundletest::testLargeBundle() {
+  rofl::cauxid auxid(0);
+
+  datapath->test_start();
+  CPPUNIT_ASSERT(wait_for([&]() { return controller->get_dpt_open(); }));
+
+  rofl::crofdpt &dpt = controller->set_dpt(controller->get_dptid());
+
+  /* a bundle exceeding the txqueue is split into blocks the txqueue
+   * accepts */
+  unsigned int num_flow_mods =
+      4 * dpt.set_conn(auxid).get_txqueue_max_size() + 1;
+  rofl::openflow::cofbundle bundle = make_bundle(1, num_flow_mods);
+  size_t num_queued = 0;
+  rofl::crofsock::msg_result_t msg_result =
+      dpt.send_bundle(auxid, bundle, 5, &num_queued);
+  CPPUNIT_ASSERT((rofl::crofsock::MSG_QUEUED == msg_result) ||
+                 (rofl::crofsock::MSG_QUEUED_CONGESTION == msg_result));
+  CPPUNIT_ASSERT(num_queued > 0);
+
+  CPPUNIT_ASSERT(
+      wait_for([&]() { return controller->get_bundles_committed() == 1; }));
+  CPPUNIT_ASSERT(controller->get_bundles_failed() == 0);
+  CPPUNIT_ASSERT(datapath->get_opened() == 1);
+  CPPUNIT_ASSERT(datapath->get_added() == num_flow_mods);
+  CPPUNIT_ASSERT(datapath->get_committed() == 1);
+  CPPUNIT_ASSERT(datapath->get_discarded() == 0);
+}
+
+cbundlectl::cbundlectl()
+    : dpt_open(false), bundles_committed(0), bundles_failed(0) {
+  vbitmap.add_ofp_version(rofl::openflow14::OFP_VERSION);
+
+  crofbase::set_versionbitmap(vbitmap);
+  crofbase::dpt_sock_listen(
+      rofl::csockaddr(AF_INET, "127.0.0.1", BUNDLE_TEST_PORT));
+}
+
+void cbundlectl::handle_dpt_open(rofl::crofdpt &dpt) {
+  dptid = dpt.get_dptid();
+  dpt_open = true;
+}
+
+void cbundlectl::handle_bundle_committed(rofl::crofdpt &dpt,
+                                         const rofl::cauxid &auxid,
+                                         uint32_t bundle_id) {
+  LOG(INFO) << ">>> XXX -Bundle-Committed- bundle_id=" << bundle_id
+            << std::endl;
+  bundles_committed++;
+}
+
+void cbundlectl::handle_bundle_failed(rofl::crofdpt &dpt,
+                                      const rofl::cauxid &auxid,
+                                      uint32_t bundle_id, uint16_t err_type,
+                                      uint16_t err_code) {
+  LOG(INFO) << ">>> XXX -Bundle-Failed- bundle_id=" << bundle_id
+            << " err_type=" << err_type << " err_code=" << err_code
+            << std::endl;
+  bundles_failed++;
+}
+
+cbundledpt::cbundledpt() : opened(0), committed(0), discarded(0), added(0) {
+  vbitmap.add_ofp_version(rofl::openflow14::OFP_VERSION);
+
+  ctlid = add_ctl().get_ctlid();
+}
+
+void cbundledpt::test_start() {
+  crofbase::set_ctl(ctlid)
+      .add_conn(rofl::cauxid(0))
+      .set_raddr(rofl::csockaddr(AF_INET, "127.0.0.1", BUNDLE_TEST_PORT))
+      .tcp_connect(vbitmap, rofl::crofconn::MODE_DATAPATH, false);
+}
+
+void cbundledpt::handle_features_request(
+    rofl::crofctl &ctl, const rofl::cauxid &auxid,
+    rofl::openflow::cofmsg_features_request &msg) {
+  ctl.send_features_reply(auxid, msg.get_xid(), /*dpid=*/0xb0b1b2b3b4b5b6b7,
+                          /*n_buffers=*/0, /*n_tables=*/1,
+                          /*capabilities=*/0, /*auxid=*/0);
+}
+
+void cbundledpt::handle_bundle_control(
+    rofl::crofctl &ctl, const rofl::cauxid &auxid,
+    rofl::openflow::cofmsg_bundle_control &msg) {
+  LOG(INFO) << ">>> XXX -Bundle-Control- rcvd" << msg;
+
+  uint16_t ctrl_type = msg.get_ctrl_type();
+  switch (ctrl_type) {
+  case rofl::openflow14::OFPBCT_OPEN_REQUEST: {
+    opened++;
+  } break;
+  case rofl::openflow14::OFPBCT_COMMIT_REQUEST: {
+    committed++;
+  } break;
+  case rofl::openflow14::OFPBCT_DISCARD_REQUEST: {
+    discarded++;
+  } break;
+  default:
+    return;
+  }
+
+  /* replies follow their requests */
+  ctl.send_bundle_control_reply(auxid, msg.get_xid(), msg.get_bundle_id(),
+                                ctrl_type + 1, msg.get_flags());
+}
+
+void cbundledpt::handle_bundle_add_message(
+    rofl::crofctl &ctl, const rofl::cauxid &auxid,
+    rofl::openflow::cofmsg_bundle_add_message &msg) {
+  added++;
+}
@@ -0,0 +1,156 @@
+/*
+ * crofbundletest.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_CROFBUNDLE_TEST_HPP_
+#define TEST_SRC_ROFL_COMMON_CROFBUNDLE_TEST_HPP_
+
+#include <atomic>
+#include <functional>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/crofbase.h"
+
+class cbundlectl : public rofl::crofbase {
+public:
+  /**
+   *
+   */
+  ~cbundlectl(){};
+
+  /**
+   *
+   */
+  cbundlectl();
+
+public:
+  /**
+   *
+   */
+  bool get_dpt_open() const { return dpt_open; };
+
+  /**
+   *
+   */
+  const rofl::cdptid &get_dptid() const { return dptid; };
+
+  /**
+   *
+   */
+  unsigned int get_bundles_committed() const { return bundles_committed; };
+
+  /**
+   *
+   */
+  unsigned int get_bundles_failed() const { return bundles_failed; };
+
+private:
+  virtual void handle_dpt_open(rofl::crofdpt &dpt);
+
+  virtual void handle_bundle_committed(rofl::crofdpt &dpt,
+                                       const rofl::cauxid &auxid,
+                                       uint32_t bundle_id);
+
+  virtual void handle_bundle_failed(rofl::crofdpt &dpt,
+                                    const rofl::cauxid &auxid,
+                                    uint32_t bundle_id, uint16_t err_type,
+                                    uint16_t err_code);
+
+private:
+  rofl::openflow::cofhello_elem_versionbitmap vbitmap;
+  rofl::cdptid dptid;
+  std::atomic_bool dpt_open;
+  std::atomic_uint bundles_committed;
+  std::atomic_uint bundles_failed;
+};
+
+class cbundledpt : public rofl::crofbase {
+public:
+  /**
+   *
+   */
+  ~cbundledpt(){};
+
+  /**
+   *
+   */
+  cbundledpt();
+
+public:
+  /**
+   *
+   */
+  void test_start();
+
+  /**
+   *
+   */
+  unsigned int get_opened() const { return opened; };
+
+  /**
+   *
+   */
+  unsigned int get_committed() const { return committed; };
+
+  /**
+   *
+   */
+  unsigned int get_discarded() const { return discarded; };
+
+  /**
+   *
+   */
+  unsigned int get_added() const { return added; };
+
+private:
+  virtual void
+  handle_features_request(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                          rofl::openflow::cofmsg_features_request &msg);
+
+  virtual void
+  handle_bundle_control(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                        rofl::openflow::cofmsg_bundle_control &msg);
+
+  virtual void
+  handle_bundle_add_message(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                            rofl::openflow::cofmsg_bundle_add_message &msg);
+
+private:
+  rofl::openflow::cofhello_elem_versionbitmap vbitmap;
+  rofl::cctlid ctlid;
+  std::atomic_uint opened;
+  std::atomic_uint committed;
+  std::atomic_uint discarded;
+  std::atomic_uint added;
+};
+
+class crofbundletest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(crofbundletest);
+  CPPUNIT_TEST(testCongestion);
+  CPPUNIT_TEST(testLargeBundle);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void testCongestion();
+  void testLargeBundle();
+
+private:
+  bool wait_for(const std::function<bool()> &cond);
+
+  rofl::openflow::cofbundle make_bundle(uint32_t bundle_id,
+                                        unsigned int num_flow_mods);
+
+  cbundlectl *controller;
+  cbundledpt *datapath;
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_CROFBUNDLE_TEST_HPP_ */
@@ -52,6 +52,13 @@ void crofchantest::test_connections() {
 
   LOG(INFO) << "TEST: <== crofchantest::test_connections() ==>" << std::endl;
 
+  /* sending on a channel not established yet fails without throwing */
+  CPPUNIT_ASSERT(
+      channel1->try_send_message(
+          rofl::cauxid(0), new rofl::openflow::cofmsg_echo_request(
+                               rofl::openflow13::OFP_VERSION, xid)) ==
+      rofl::crofsock::MSG_QUEUEING_FAILED_NOT_ESTABLISHED);
+
   /* try to find idle port for test */
   bool lookup_idle_port = true;
   while (lookup_idle_port) {
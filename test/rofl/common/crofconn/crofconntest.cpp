@@ -5,7 +5,9 @@
  *      Author: andi
  */
 
+#include <sstream>
 #include <stdlib.h>
+#include <unistd.h>
 
 #include <cppunit/extensions/TestFactoryRegistry.h>
 #include <cppunit/ui/text/TestRunner.h>
@@ -22,12 +24,41 @@ void crofconntest::setUp() {}
 void crofconntest::tearDown() {}
 
 void crofconntest::test() {
+  test_mode = TEST_MODE_TCP;
+  test_connection(rofl::openflow13::OFP_VERSION);
+}
+
+void crofconntest::test14() {
+  test_mode = TEST_MODE_TCP;
+  test_connection(rofl::openflow14::OFP_VERSION);
+}
+
+void crofconntest::testRxTailDrop() {
+  test_mode = TEST_MODE_TAILDROP;
+  test_connection(rofl::openflow13::OFP_VERSION);
+}
+
+void crofconntest::testUnix() {
+  test_mode = TEST_MODE_UNIX;
+  test_connection(rofl::openflow13::OFP_VERSION);
+}
+
+void crofconntest::testMemChannel() {
+  test_mode = TEST_MODE_MEMCHANNEL;
+  test_connection(rofl::openflow13::OFP_VERSION);
+}
+
+void crofconntest::test_connection(uint8_t ofp_version) {
+  uint64_t srv_pkts_dropped = 0;
+  bool srv_established = false;
+  std::string sunpath;
   try {
-    test_mode = TEST_MODE_TCP;
+    ofp_version_highest = ofp_version;
     keep_running = 10;
     msg_counter = 0;
     xid = 0xa1a2a3a4;
-    num_of_packets = 2048;
+    num_of_packets = (test_mode == TEST_MODE_TAILDROP) ? 64 : 2048;
+    srv_stalled = false;
     srv_pkts_rcvd = 0;
     srv_pkts_sent = 0;
     cli_pkts_rcvd = 0;
@@ -37,38 +68,75 @@ void crofconntest::test() {
 
     slisten = new rofl::crofsock(this);
     sclient = new rofl::crofconn(this);
+    sserver = nullptr;
     client_is_closed = false;
     server_is_closed = false;
 
     listening_port = 0;
 
-    /* try to find idle port for test */
-    bool lookup_idle_port = true;
-    while (lookup_idle_port) {
-      do {
-        listening_port = rand.uint16();
-      } while ((listening_port < 10000) || (listening_port > 49000));
-      try {
-        LOG(INFO) << "trying listening port=" << (int)listening_port
-                  << std::endl;
-        baddr =
-            rofl::csockaddr(rofl::caddress_in4("127.0.0.1"), listening_port);
-        /* try to bind address first */
-        slisten->set_baddr(baddr).listen();
-        LOG(INFO) << "binding to " << baddr.str() << std::endl;
-        lookup_idle_port = false;
-      } catch (rofl::eSysCall &e) {
-        /* port in use, try another one */
+    switch (test_mode) {
+    case TEST_MODE_MEMCHANNEL: {
+      /* no listening socket required */
+    } break;
+    case TEST_MODE_UNIX: {
+      std::stringstream ss;
+      ss << "/tmp/crofconntest." << getpid() << ".sock";
+      sunpath = ss.str();
+      baddr = rofl::csockaddr(AF_UNIX, sunpath, 0);
+      slisten->set_baddr(baddr).listen();
+      LOG(INFO) << "binding to " << baddr.str() << std::endl;
+    } break;
+    default: {
+      /* try to find idle port for test */
+      bool lookup_idle_port = true;
+      while (lookup_idle_port) {
+        do {
+          listening_port = rand.uint16();
+        } while ((listening_port < 10000) || (listening_port > 49000));
+        try {
+          LOG(INFO) << "trying listening port=" << (int)listening_port
+                    << std::endl;
+          baddr =
+              rofl::csockaddr(rofl::caddress_in4("127.0.0.1"), listening_port);
+          /* try to bind address first */
+          slisten->set_baddr(baddr).listen();
+          LOG(INFO) << "binding to " << baddr.str() << std::endl;
+          lookup_idle_port = false;
+        } catch (rofl::eSysCall &e) {
+          /* port in use, try another one */
+        }
       }
+    };
     }
 
     /* create new crofconn instance and connect to peer */
     versionbitmap_dpt.add_ofp_version(rofl::openflow10::OFP_VERSION);
     versionbitmap_dpt.add_ofp_version(rofl::openflow12::OFP_VERSION);
     versionbitmap_dpt.add_ofp_version(rofl::openflow13::OFP_VERSION);
-    LOG(INFO) << "connecting to " << baddr.str() << std::endl;
-    sclient->set_raddr(baddr).tcp_connect(
-        versionbitmap_dpt, rofl::crofconn::MODE_DATAPATH, /*reconnect=*/false);
+    if (ofp_version_highest >= rofl::openflow14::OFP_VERSION)
+      versionbitmap_dpt.add_ofp_version(rofl::openflow14::OFP_VERSION);
+    if (test_mode == TEST_MODE_MEMCHANNEL) {
+      versionbitmap_ctl.add_ofp_version(rofl::openflow13::OFP_VERSION);
+
+      /* a tiny ring enforces partial writes and congestion */
+      std::shared_ptr<rofl::cmemchannel> channel =
+          std::make_shared<rofl::cmemchannel>(64);
+
+      sserver = new rofl::crofconn(this);
+      sserver->mem_accept(channel, rofl::cmemchannel::SIDE_B,
+                          versionbitmap_ctl, rofl::crofconn::MODE_CONTROLLER);
+      sclient->mem_connect(channel, rofl::cmemchannel::SIDE_A,
+                           versionbitmap_dpt, rofl::crofconn::MODE_DATAPATH);
+    } else {
+      LOG(INFO) << "connecting to " << baddr.str() << std::endl;
+      sclient->set_raddr(baddr).tcp_connect(versionbitmap_dpt,
+                                            rofl::crofconn::MODE_DATAPATH,
+                                            /*reconnect=*/false);
+    }
+
+    /* Packet-Out received by a datapath is never dropped */
+    CPPUNIT_ASSERT(sclient->get_rxqueue_policy(rofl::crofconn::QUEUE_PKT) ==
+                   rofl::crofconn::RXQUEUE_POLICY_BACKPRESSURE);
 
     while (--keep_running > 0) {
       struct timespec ts;
@@ -83,9 +151,21 @@ void crofconntest::test() {
           (srv_pkts_rcvd >= num_of_packets)) {
         break;
       }
+      if ((test_mode == TEST_MODE_TAILDROP) && (sserver != nullptr) &&
+          (cli_pkts_sent > 0) &&
+          (srv_pkts_rcvd +
+               sserver->get_rxqueue_drops(rofl::crofconn::QUEUE_PKT) >=
+           (uint64_t)cli_pkts_sent)) {
+        break;
+      }
     }
     LOG(INFO) << std::endl;
 
+    if ((test_mode == TEST_MODE_TAILDROP) && (sserver != nullptr)) {
+      srv_pkts_dropped = sserver->get_rxqueue_drops(rofl::crofconn::QUEUE_PKT);
+      srv_established = sserver->is_established();
+    }
+
     slisten->close();
     if (not client_is_closed)
       sclient->close();
@@ -114,6 +194,23 @@ void crofconntest::test() {
     LOG(INFO) << "crofconntest::test() exception, what: " << e.what()
               << std::endl;
   }
+
+  if ((test_mode == TEST_MODE_UNIX) || (test_mode == TEST_MODE_MEMCHANNEL)) {
+    CPPUNIT_ASSERT(srv_pkts_rcvd >= num_of_packets);
+    CPPUNIT_ASSERT(cli_pkts_rcvd >= num_of_packets);
+  }
+
+  if (test_mode == TEST_MODE_UNIX) {
+    /* listening socket removes its socket file */
+    CPPUNIT_ASSERT(access(sunpath.c_str(), F_OK) < 0);
+  }
+
+  if (test_mode == TEST_MODE_TAILDROP) {
+    /* stalled handler must lead to drops, not to a stalled connection */
+    CPPUNIT_ASSERT(srv_established);
+    CPPUNIT_ASSERT(srv_pkts_dropped > 0);
+    CPPUNIT_ASSERT(srv_pkts_rcvd + srv_pkts_dropped == (uint64_t)cli_pkts_sent);
+  }
 }
 
 void crofconntest::handle_listen(rofl::crofsock &socket) {
@@ -123,14 +220,30 @@ void crofconntest::handle_listen(rofl::crofsock &socket) {
     LOG(INFO) << "crofconntest::handle_listen() sd=" << sd << std::endl;
 
     switch (test_mode) {
-    case TEST_MODE_TCP: {
+    case TEST_MODE_TCP:
+    case TEST_MODE_UNIX: {
       versionbitmap_ctl.add_ofp_version(rofl::openflow10::OFP_VERSION);
       versionbitmap_ctl.add_ofp_version(rofl::openflow12::OFP_VERSION);
       versionbitmap_ctl.add_ofp_version(rofl::openflow13::OFP_VERSION);
+      if (ofp_version_highest >= rofl::openflow14::OFP_VERSION)
+        versionbitmap_ctl.add_ofp_version(rofl::openflow14::OFP_VERSION);
+
+      sserver = new rofl::crofconn(this);
+      sserver->tcp_accept(sd, versionbitmap_ctl,
+                          rofl::crofconn::MODE_CONTROLLER);
+
+    } break;
+    case TEST_MODE_TAILDROP: {
+      versionbitmap_ctl.add_ofp_version(rofl::openflow13::OFP_VERSION);
 
       sserver = new rofl::crofconn(this);
+      sserver->set_rxqueue_max_size(rofl::crofconn::QUEUE_PKT, 8);
       sserver->tcp_accept(sd, versionbitmap_ctl,
                           rofl::crofconn::MODE_CONTROLLER);
+      /* controller side connections tail-drop Packet-In by default */
+      CPPUNIT_ASSERT(
+          sserver->get_rxqueue_policy(rofl::crofconn::QUEUE_PKT) ==
+          rofl::crofconn::RXQUEUE_POLICY_TAILDROP);
 
     } break;
     default: {};
@@ -142,6 +255,18 @@ void crofconntest::handle_established(rofl::crofconn &conn,
                                       uint8_t ofp_version) {
   LOG(INFO) << "crofconntest::handle_established()" << std::endl;
 
+  CPPUNIT_ASSERT(ofp_version == ofp_version_highest);
+
+  if (test_mode == TEST_MODE_TAILDROP) {
+    /* flood the server with Packet-In messages */
+    if (&conn == sclient) {
+      for (int i = 0; i < num_of_packets; i++) {
+        send_packet_in(ofp_version);
+      }
+    }
+    return;
+  }
+
   if (&conn == sserver) {
     LOG(INFO) << "[Ss], ";
     send_packet_out(ofp_version);
@@ -224,6 +349,14 @@ void crofconntest::handle_recv(rofl::crofconn &conn,
   } break;
   case rofl::openflow::OFPT_PACKET_IN: {
     srv_pkts_rcvd++;
+    if (test_mode == TEST_MODE_TAILDROP) {
+      /* stall the handler thread, so that the rxqueue fills up */
+      if (not srv_stalled) {
+        srv_stalled = true;
+        sleep(2);
+      }
+      break;
+    }
     // LOG(INFO) << "RECV(Packet-In): s:" << srv_pkts_rcvd << "(" <<
     // cli_pkts_sent
     //          << "), ";
@@ -249,9 +382,14 @@ void crofconntest::handle_recv(rofl::crofconn &conn,
 }
 
 void crofconntest::send_packet_in(uint8_t version) {
-  sclient->send_message(
-      new rofl::openflow::cofmsg_packet_in(version, ++xid_client));
-  cli_pkts_sent++;
+  switch (sclient->send_message(
+      new rofl::openflow::cofmsg_packet_in(version, ++xid_client))) {
+  case rofl::crofsock::MSG_QUEUED:
+  case rofl::crofsock::MSG_QUEUED_CONGESTION: {
+    cli_pkts_sent++;
+  } break;
+  default: {};
+  }
 }
 
 void crofconntest::send_packet_out(uint8_t version) {
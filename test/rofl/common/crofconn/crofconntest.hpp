@@ -11,6 +11,7 @@
 #include <cppunit/TestFixture.h>
 #include <cppunit/extensions/HelperMacros.h>
 
+#include "rofl/common/cmemchannel.hpp"
 #include "rofl/common/cmemory.h"
 #include "rofl/common/crofconn.h"
 #include "rofl/common/crofsock.h"
@@ -20,6 +21,10 @@ class crofconntest : public CppUnit::TestFixture,
                      public rofl::crofsock_env {
   CPPUNIT_TEST_SUITE(crofconntest);
   CPPUNIT_TEST(test);
+  CPPUNIT_TEST(test14);
+  CPPUNIT_TEST(testRxTailDrop);
+  CPPUNIT_TEST(testUnix);
+  CPPUNIT_TEST(testMemChannel);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -28,6 +33,13 @@ public:
 
 public:
   void test();
+  void test14();
+  void testRxTailDrop();
+  void testUnix();
+  void testMemChannel();
+
+private:
+  void test_connection(uint8_t ofp_version);
 
 private:
   virtual void handle_listen(rofl::crofsock &socket);
@@ -92,11 +104,15 @@ private:
 private:
   enum crofconn_test_mode_t {
     TEST_MODE_TCP = 1,
+    TEST_MODE_TAILDROP = 2,
+    TEST_MODE_UNIX = 3,
+    TEST_MODE_MEMCHANNEL = 4,
   };
 
   rofl::openflow::cofhello_elem_versionbitmap versionbitmap_ctl;
   rofl::openflow::cofhello_elem_versionbitmap versionbitmap_dpt;
   enum crofconn_test_mode_t test_mode;
+  uint8_t ofp_version_highest;
   int keep_running;
   int msg_counter;
   rofl::crofsock *slisten;
@@ -120,6 +136,7 @@ private:
   std::atomic_int srv_pkts_sent;
   std::atomic_int cli_pkts_rcvd;
   std::atomic_int cli_pkts_sent;
+  std::atomic_bool srv_stalled;
 
   rofl::crwlock tlock;
   std::atomic_bool client_is_closed;
@@ -91,3 +91,55 @@ void crofqueuetest::test2() {
   CPPUNIT_ASSERT(queue.size() == 0);
   CPPUNIT_ASSERT(queue.empty());
 }
+
+void crofqueuetest::testTryStore() {
+  uint32_t xid = 0xa1a2a3a4;
+  rofl::crofqueue queue;
+
+  queue.set_queue_max_size(4);
+
+  for (unsigned int i = 0; i < 4; i++) {
+    rofl::openflow::cofmsg *msg = new rofl::openflow::cofmsg(
+        rofl::openflow13::OFP_VERSION, rofl::openflow13::OFPT_HELLO, xid++);
+    CPPUNIT_ASSERT(queue.try_store(msg) == (i + 1));
+  }
+
+  rofl::openflow::cofmsg *msg = new rofl::openflow::cofmsg(
+      rofl::openflow13::OFP_VERSION, rofl::openflow13::OFPT_HELLO, xid++);
+  CPPUNIT_ASSERT(queue.try_store(msg) == 0);
+  CPPUNIT_ASSERT(queue.size() == 4);
+
+  CPPUNIT_ASSERT(queue.try_store(msg, true) == 5);
+
+  queue.clear();
+
+  CPPUNIT_ASSERT(queue.empty());
+}
+
+void crofqueuetest::testFrontStamp() {
+  uint32_t xid = 0xa1a2a3a4;
+  rofl::crofqueue queue;
+
+  CPPUNIT_ASSERT(queue.front_stamp() == 0);
+
+  uint64_t before = rofl::cclock::read();
+  for (unsigned int i = 0; i < 4; i++) {
+    queue.store(new rofl::openflow::cofmsg(rofl::openflow13::OFP_VERSION,
+                                           rofl::openflow13::OFPT_HELLO,
+                                           xid++));
+  }
+  uint64_t after = rofl::cclock::read();
+
+  /* stamps follow their messages and are stored in order */
+  uint64_t last = 0;
+  while (not queue.empty()) {
+    uint64_t stamp = queue.front_stamp();
+    CPPUNIT_ASSERT(stamp >= before);
+    CPPUNIT_ASSERT(stamp <= after);
+    CPPUNIT_ASSERT(stamp >= last);
+    last = stamp;
+    delete queue.retrieve();
+  }
+
+  CPPUNIT_ASSERT(queue.front_stamp() == 0);
+}
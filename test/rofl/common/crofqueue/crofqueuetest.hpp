@@ -17,6 +17,8 @@ class crofqueuetest : public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(crofqueuetest);
   CPPUNIT_TEST(test1);
   CPPUNIT_TEST(test2);
+  CPPUNIT_TEST(testTryStore);
+  CPPUNIT_TEST(testFrontStamp);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -26,6 +28,8 @@ public:
 public:
   void test1();
   void test2();
+  void testTryStore();
+  void testFrontStamp();
 };
 
 #endif /* TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGAGGRSTATS_TEST_HPP_ */
@@ -6,6 +6,7 @@
  */
 
 #include <stdlib.h>
+#include <unistd.h>
 
 #include <cppunit/extensions/TestFactoryRegistry.h>
 #include <cppunit/ui/text/TestRunner.h>
@@ -96,6 +97,18 @@ void crofsocktest::test() {
         } while ((listening_port < 10000) || (listening_port > 49000));
       }
 
+      /* second round: quantum smaller than a single message */
+      if (i == 1) {
+        sclient->set_txqueue_quantum(rofl::crofsock::QUEUE_MGMT, 3);
+        CPPUNIT_ASSERT(
+            sclient->get_txqueue_quantum(rofl::crofsock::QUEUE_MGMT) == 3);
+      }
+
+      /* first round: record all messages in a trace file */
+      if (i == 0) {
+        rofl::cmsgtrace::initialize("crofsocktest.trc", 65536, 8);
+      }
+
       sclient->set_raddr(baddr).tcp_connect(false);
 
       pthread_yield();
@@ -110,6 +123,33 @@ void crofsocktest::test() {
 
       CPPUNIT_ASSERT(timeout > 0);
 
+      /* each message is recorded once by sender and once by receiver */
+      if (i == 0) {
+        rofl::cmsgtrace::terminate();
+        CPPUNIT_ASSERT(rofl::cmsgtrace::export_pcapng(
+                           "crofsocktest.trc", "crofsocktest.pcapng") >= 40);
+        unlink("crofsocktest.trc");
+        unlink("crofsocktest.pcapng");
+      }
+
+      /* Hello messages are sent via QUEUE_MGMT */
+      rofl::crofsock::txqueue_stats_t stats =
+          sclient->get_txqueue_stats(rofl::crofsock::QUEUE_MGMT);
+      CPPUNIT_ASSERT(stats.tx_msgs >= 10);
+      CPPUNIT_ASSERT(stats.tx_bytes ==
+                     stats.tx_msgs * sizeof(struct rofl::openflow::ofp_header));
+      CPPUNIT_ASSERT(stats.drops == 0);
+      CPPUNIT_ASSERT(stats.delay_usec_max * stats.tx_msgs >=
+                     stats.delay_usec_sum);
+      CPPUNIT_ASSERT(
+          sclient->get_txqueue_stats(rofl::crofsock::QUEUE_PKT).tx_msgs == 0);
+
+      try {
+        sclient->get_txqueue_quantum(rofl::crofsock::QUEUE_MAX);
+        CPPUNIT_ASSERT(false);
+      } catch (rofl::eRofSockInvalid &e) {
+      }
+
       // sleep(1);
 
       slisten->close();
@@ -32,3 +32,20 @@ void csockaddr_test::testSockAddr() {
 
   std::cerr << "saddr:" << std::endl << saddr;
 }
+
+void csockaddr_test::testSockAddrUnix() {
+  rofl::csockaddr saddr(AF_UNIX, "/tmp/rofl.sock", 0);
+
+  std::cerr << "saddr:" << std::endl << saddr;
+
+  CPPUNIT_ASSERT(saddr.get_family() == AF_UNIX);
+  CPPUNIT_ASSERT(saddr.length() == sizeof(struct sockaddr_un));
+  CPPUNIT_ASSERT(saddr.str() == "unix:/tmp/rofl.sock");
+
+  std::string path(sizeof(saddr.ca_sunaddr->sun_path), 'x');
+  try {
+    rofl::csockaddr(AF_UNIX, path, 0);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eInvalid &e) {
+  }
+}
@@ -7,6 +7,7 @@ class csockaddr_test : public CppUnit::TestFixture {
 
   CPPUNIT_TEST_SUITE(csockaddr_test);
   CPPUNIT_TEST(testSockAddr);
+  CPPUNIT_TEST(testSockAddrUnix);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -15,4 +16,5 @@ public:
   void tearDown();
 
   void testSockAddr();
+  void testSockAddrUnix();
 };
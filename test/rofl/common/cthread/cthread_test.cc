@@ -28,6 +28,71 @@ void cthread_test::test1() {
   CPPUNIT_ASSERT(keep_running > 0);
 }
 
+void cthread_test::testCachedClock() {
+  /* no cached clock outside of a cthread */
+  uint64_t t1 = rofl::cclock::now();
+  usleep(1000);
+  CPPUNIT_ASSERT(rofl::cclock::now() > t1);
+
+  rofl::ctimens ts(rofl::ctimens::expire_in(1, 1));
+  CPPUNIT_ASSERT(ts.get_ns() >= t1 + 1000000001);
+  CPPUNIT_ASSERT(not ts.is_expired());
+  CPPUNIT_ASSERT(ts.get_relative_timeout(rofl::ctimens(t1)) >= 1001);
+  CPPUNIT_ASSERT(ts.get_relative_timeout(ts) == 0);
+  CPPUNIT_ASSERT(rofl::ctimens(ts.get_tspec()) == ts);
+
+  /* timer callbacks read the time cached by the cthread loop */
+  unsigned int keep_running = 10;
+  rofl::cthread::thread(object->thread_num)
+      .add_timer(object, 2, rofl::ctimens::expire_in(0, 1000000));
+  while ((--keep_running > 0) && (not object->clock_checked)) {
+    sleep(1);
+  }
+  CPPUNIT_ASSERT(object->clock_checked);
+  CPPUNIT_ASSERT(object->clock_cached);
+}
+
+void cthread_test::testFdEvents() {
+  rofl::cthread &thread = rofl::cthread::thread(object->thread_num);
+  int pipefd[2];
+  CPPUNIT_ASSERT(pipe(pipefd) == 0);
+
+  /* read events are dispatched to the registered environment */
+  thread.add_read_fd(object, pipefd[0]);
+  CPPUNIT_ASSERT(write(pipefd[1], "x", 1) == 1);
+  unsigned int keep_running = 10;
+  while ((--keep_running > 0) && (object->read_cnt < 1)) {
+    sleep(1);
+  }
+  CPPUNIT_ASSERT(object->read_cnt == 1);
+
+  /* no events for dropped file descriptors */
+  thread.drop_fd(pipefd[0]);
+  CPPUNIT_ASSERT(write(pipefd[1], "x", 1) == 1);
+  sleep(1);
+  CPPUNIT_ASSERT(object->read_cnt == 1);
+
+  /* wakeups for the same environment are coalesced */
+  thread.wakeup(object);
+  thread.wakeup(object);
+  keep_running = 10;
+  while ((--keep_running > 0) && (object->wakeup_cnt < 1)) {
+    sleep(1);
+  }
+  sleep(1);
+  CPPUNIT_ASSERT(object->wakeup_cnt >= 1);
+  CPPUNIT_ASSERT(object->wakeup_cnt <= 2);
+
+  close(pipefd[0]);
+  close(pipefd[1]);
+}
+
+void cthread_test::cobject::handle_read_event(rofl::cthread &thread, int fd) {
+  char c;
+  if (read(fd, &c, sizeof(c)) == 1)
+    read_cnt++;
+}
+
 void cthread_test::cobject::handle_timeout(rofl::cthread &thread,
                                            uint32_t timer_id) {
   switch (timer_id) {
@@ -41,6 +106,12 @@ void cthread_test::cobject::handle_timeout(rofl::cthread &thread,
   case 1: {
     error = true;
   } break;
+  case 2: {
+    uint64_t t1 = rofl::cclock::now();
+    usleep(1000);
+    clock_cached = (rofl::cclock::now() == t1);
+    clock_checked = true;
+  } break;
   default: {};
   }
 };
@@ -1,4 +1,5 @@
 #include "rofl/common/cthread.hpp"
+#include <atomic>
 #include <cppunit/TestFixture.h>
 #include <cppunit/extensions/HelperMacros.h>
 
@@ -6,6 +7,8 @@ class cthread_test : public CppUnit::TestFixture {
 
   CPPUNIT_TEST_SUITE(cthread_test);
   CPPUNIT_TEST(test1);
+  CPPUNIT_TEST(testCachedClock);
+  CPPUNIT_TEST(testFdEvents);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -21,12 +24,13 @@ private:
      */
     cobject()
         : thread_num(rofl::cthread::get_mgt_thread_num_from_pool()), cnt(0),
-          error(false){};
+          error(false), clock_checked(false), clock_cached(false),
+          wakeup_cnt(0), read_cnt(0){};
 
   protected:
-    virtual void handle_wakeup(rofl::cthread &thread){};
+    virtual void handle_wakeup(rofl::cthread &thread) { wakeup_cnt++; };
     virtual void handle_timeout(rofl::cthread &thread, uint32_t timer_id);
-    virtual void handle_read_event(rofl::cthread &thread, int fd){};
+    virtual void handle_read_event(rofl::cthread &thread, int fd);
     virtual void handle_write_event(rofl::cthread &thread, int fd){};
 
   public:
@@ -35,6 +39,15 @@ private:
     unsigned int cnt;
 
     bool error;
+
+    bool clock_checked;
+
+    bool clock_cached;
+
+    // updated by the cthread, read by the test
+    std::atomic_uint wakeup_cnt;
+
+    std::atomic_uint read_cnt;
   };
 
 private:
@@ -45,4 +58,6 @@ public:
   void tearDown();
 
   void test1();
+  void testCachedClock();
+  void testFdEvents();
 };
@@ -0,0 +1,213 @@
+/*
+ * ctlscontexttest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/rsa.h>
+#include <openssl/x509.h>
+
+#include "ctlscontexttest.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ctlscontexttest);
+
+void ctlscontexttest::setUp() {
+  /* create a self-signed certificate for the duration of this test */
+  char certpath[] = "/tmp/ctlscontexttest-crt-XXXXXX";
+  char keypath[] = "/tmp/ctlscontexttest-key-XXXXXX";
+  int certfd = mkstemp(certpath);
+  int keyfd = mkstemp(keypath);
+  CPPUNIT_ASSERT((certfd >= 0) && (keyfd >= 0));
+  ::close(certfd);
+  ::close(keyfd);
+  certfile = certpath;
+  keyfile = keypath;
+
+  EVP_PKEY *pkey = NULL;
+  EVP_PKEY_CTX *pctx = EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, NULL);
+  CPPUNIT_ASSERT(pctx != NULL);
+  CPPUNIT_ASSERT(EVP_PKEY_keygen_init(pctx) > 0);
+  CPPUNIT_ASSERT(EVP_PKEY_CTX_set_rsa_keygen_bits(pctx, 2048) > 0);
+  CPPUNIT_ASSERT(EVP_PKEY_keygen(pctx, &pkey) > 0);
+  EVP_PKEY_CTX_free(pctx);
+
+  X509 *x509 = X509_new();
+  ASN1_INTEGER_set(X509_get_serialNumber(x509), 1);
+  X509_gmtime_adj(X509_get_notBefore(x509), 0);
+  X509_gmtime_adj(X509_get_notAfter(x509), 3600);
+  X509_set_pubkey(x509, pkey);
+  X509_NAME *name = X509_get_subject_name(x509);
+  X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                             (const unsigned char *)"ctlscontexttest", -1, -1,
+                             0);
+  X509_set_issuer_name(x509, name);
+  CPPUNIT_ASSERT(X509_sign(x509, pkey, EVP_sha256()) > 0);
+
+  FILE *fp = NULL;
+  CPPUNIT_ASSERT((fp = fopen(certfile.c_str(), "w")) != NULL);
+  PEM_write_X509(fp, x509);
+  fclose(fp);
+  CPPUNIT_ASSERT((fp = fopen(keyfile.c_str(), "w")) != NULL);
+  PEM_write_PrivateKey(fp, pkey, NULL, NULL, 0, NULL, NULL);
+  fclose(fp);
+
+  X509_free(x509);
+  EVP_PKEY_free(pkey);
+}
+
+void ctlscontexttest::tearDown() {
+  rofl::ctlscontext::purge();
+  unlink(certfile.c_str());
+  unlink(keyfile.c_str());
+}
+
+rofl::ctlscontext::key_t ctlscontexttest::key() const {
+  rofl::ctlscontext::key_t key;
+  key.cafile = certfile;
+  key.certfile = certfile;
+  key.keyfile = keyfile;
+  key.verify_mode = "PEER";
+  key.verify_depth = "1";
+  return key;
+}
+
+void ctlscontexttest::testCache() {
+  rofl::ctlscontext::set_linger(300);
+
+  rofl::ctlscontext *ctx1 = rofl::ctlscontext::acquire(key());
+  rofl::ctlscontext *ctx2 = rofl::ctlscontext::acquire(key());
+
+  CPPUNIT_ASSERT(ctx1 == ctx2);
+  CPPUNIT_ASSERT(ctx1->get_ssl_ctx() != NULL);
+  CPPUNIT_ASSERT(ctx1->get_refcnt() == 2);
+  CPPUNIT_ASSERT(rofl::ctlscontext::size() == 1);
+
+  /* different TLS parameters */
+  rofl::ctlscontext::key_t other = key();
+  other.verify_mode = "NONE";
+  rofl::ctlscontext *ctx3 = rofl::ctlscontext::acquire(other);
+  CPPUNIT_ASSERT(ctx3 != ctx1);
+  CPPUNIT_ASSERT(rofl::ctlscontext::size() == 2);
+
+  rofl::ctlscontext::release(ctx1);
+  rofl::ctlscontext::release(ctx2);
+  rofl::ctlscontext::release(ctx3);
+
+  /* unused contexts linger in cache */
+  CPPUNIT_ASSERT(rofl::ctlscontext::size() == 2);
+  CPPUNIT_ASSERT(rofl::ctlscontext::acquire(key()) == ctx1);
+  rofl::ctlscontext::release(ctx1);
+
+  rofl::ctlscontext::purge();
+  CPPUNIT_ASSERT(rofl::ctlscontext::size() == 0);
+
+  /* no linger time */
+  rofl::ctlscontext::set_linger(0);
+  ctx1 = rofl::ctlscontext::acquire(key());
+  CPPUNIT_ASSERT(rofl::ctlscontext::size() == 1);
+  rofl::ctlscontext::release(ctx1);
+  CPPUNIT_ASSERT(rofl::ctlscontext::size() == 0);
+  rofl::ctlscontext::set_linger(300);
+}
+
+void ctlscontexttest::testReload() {
+  rofl::ctlscontext::set_linger(300);
+
+  rofl::ctlscontext *ctx1 = rofl::ctlscontext::acquire(key());
+  rofl::ctlscontext::release(ctx1);
+
+  /* files unchanged */
+  CPPUNIT_ASSERT(rofl::ctlscontext::acquire(key()) == ctx1);
+  rofl::ctlscontext::release(ctx1);
+
+  /* rotate certificate by replacing the file */
+  std::string rotated = certfile + ".new";
+  FILE *in = NULL, *out = NULL;
+  CPPUNIT_ASSERT((in = fopen(certfile.c_str(), "r")) != NULL);
+  CPPUNIT_ASSERT((out = fopen(rotated.c_str(), "w")) != NULL);
+  int c;
+  while ((c = fgetc(in)) != EOF)
+    fputc(c, out);
+  fclose(in);
+  fclose(out);
+  CPPUNIT_ASSERT(rename(rotated.c_str(), certfile.c_str()) == 0);
+
+  rofl::ctlscontext *ctx2 = rofl::ctlscontext::acquire(key());
+  CPPUNIT_ASSERT(ctx2 != ctx1);
+  CPPUNIT_ASSERT(ctx2->get_ssl_ctx() != NULL);
+  CPPUNIT_ASSERT(rofl::ctlscontext::size() == 2);
+  CPPUNIT_ASSERT(rofl::ctlscontext::acquire(key()) == ctx2);
+  rofl::ctlscontext::release(ctx2);
+  rofl::ctlscontext::release(ctx2);
+
+  /* outdated context is freed like any other unused one */
+  rofl::ctlscontext::purge();
+  CPPUNIT_ASSERT(rofl::ctlscontext::size() == 0);
+}
+
+void ctlscontexttest::testSessions() {
+  rofl::ctlscontext *ctx = rofl::ctlscontext::acquire(key());
+
+  CPPUNIT_ASSERT(ctx->get_session("peer") == NULL);
+
+  ctx->set_session("peer", SSL_SESSION_new());
+
+  SSL_SESSION *session = ctx->get_session("peer");
+  CPPUNIT_ASSERT(session != NULL);
+  SSL_SESSION_free(session);
+
+  /* replaces existing session */
+  ctx->set_session("peer", SSL_SESSION_new());
+  CPPUNIT_ASSERT((session = ctx->get_session("peer")) != NULL);
+  SSL_SESSION_free(session);
+
+  ctx->drop_session("peer");
+  CPPUNIT_ASSERT(ctx->get_session("peer") == NULL);
+
+  rofl::ctlscontext::release(ctx);
+}
+
+void ctlscontexttest::testInvalid() {
+  rofl::ctlscontext::key_t invalid = key();
+  invalid.certfile = "/nonexistent/crt.pem";
+
+  try {
+    rofl::ctlscontext::acquire(invalid);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eLibCall &e) {
+  }
+  CPPUNIT_ASSERT(rofl::ctlscontext::size() == 0);
+}
+
+void ctlscontexttest::testStats() {
+  rofl::ctlsstats start = rofl::ctlscontext::get_stats();
+
+  rofl::ctimespec started = rofl::ctimespec::now();
+  rofl::ctlscontext::handshake_started();
+  rofl::ctlscontext::handshake_started();
+  rofl::ctlscontext::handshake_started();
+  rofl::ctlscontext::handshake_completed(started, false);
+  rofl::ctlscontext::handshake_completed(started, true);
+  rofl::ctlscontext::handshake_failed();
+  usleep(10000);
+
+  rofl::ctlsstats stats = rofl::ctlscontext::get_stats();
+
+  CPPUNIT_ASSERT(stats.handshakes_started - start.handshakes_started == 3);
+  CPPUNIT_ASSERT(stats.handshakes_completed - start.handshakes_completed ==
+                 2);
+  CPPUNIT_ASSERT(stats.handshakes_resumed - start.handshakes_resumed == 1);
+  CPPUNIT_ASSERT(stats.handshakes_failed - start.handshakes_failed == 1);
+  CPPUNIT_ASSERT(stats.get_handshake_rate(start) > 0);
+  CPPUNIT_ASSERT(start.get_handshake_rate(stats) == 0);
+}
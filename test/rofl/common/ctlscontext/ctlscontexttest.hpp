@@ -0,0 +1,43 @@
+/*
+ * ctlscontexttest.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_CTLSCONTEXT_TEST_HPP_
+#define TEST_SRC_ROFL_COMMON_CTLSCONTEXT_TEST_HPP_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/ctlscontext.h"
+
+class ctlscontexttest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(ctlscontexttest);
+  CPPUNIT_TEST(testCache);
+  CPPUNIT_TEST(testReload);
+  CPPUNIT_TEST(testSessions);
+  CPPUNIT_TEST(testInvalid);
+  CPPUNIT_TEST(testStats);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void testCache();
+  void testReload();
+  void testSessions();
+  void testInvalid();
+  void testStats();
+
+private:
+  rofl::ctlscontext::key_t key() const;
+
+  std::string certfile;
+  std::string keyfile;
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_CTLSCONTEXT_TEST_HPP_ */
@@ -0,0 +1,75 @@
+/*
+ * ctokenbuckettest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#include <unistd.h>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "ctokenbuckettest.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ctokenbuckettest);
+
+void ctokenbuckettest::testUnlimited() {
+  rofl::ctokenbucket bucket;
+
+  CPPUNIT_ASSERT(bucket.get_rate() == 0);
+  for (unsigned int i = 0; i < 1000; i++) {
+    CPPUNIT_ASSERT(bucket.consume());
+  }
+  CPPUNIT_ASSERT(bucket.get_wait_msecs() == 0);
+}
+
+void ctokenbuckettest::testBurst() {
+  rofl::ctokenbucket bucket(/*rate=*/10, /*burst=*/5);
+
+  /* bucket starts full */
+  for (unsigned int i = 0; i < 5; i++) {
+    CPPUNIT_ASSERT(bucket.consume());
+  }
+  CPPUNIT_ASSERT(not bucket.consume());
+
+  /* one token per 100ms */
+  unsigned int msecs = bucket.get_wait_msecs();
+  CPPUNIT_ASSERT((msecs > 0) && (msecs <= 101));
+  CPPUNIT_ASSERT(bucket.get_wait_msecs(2) > msecs);
+}
+
+void ctokenbuckettest::testRefill() {
+  rofl::ctokenbucket bucket(/*rate=*/100, /*burst=*/2);
+
+  CPPUNIT_ASSERT(bucket.consume(2));
+  CPPUNIT_ASSERT(not bucket.consume());
+
+  /* 20 tokens worth of time, capped by burst */
+  usleep(200000);
+  CPPUNIT_ASSERT(bucket.get_wait_msecs(2) == 0);
+  CPPUNIT_ASSERT(bucket.consume());
+  CPPUNIT_ASSERT(bucket.consume());
+  CPPUNIT_ASSERT(not bucket.consume());
+
+  /* partial refill */
+  usleep(20000);
+  CPPUNIT_ASSERT(bucket.consume());
+}
+
+void ctokenbuckettest::testSetRate() {
+  rofl::ctokenbucket bucket(/*rate=*/10, /*burst=*/5);
+
+  /* shrinking the bucket drops excess tokens */
+  bucket.set_rate(10, 2);
+  CPPUNIT_ASSERT(bucket.get_burst() == 2);
+  CPPUNIT_ASSERT(bucket.consume());
+  CPPUNIT_ASSERT(bucket.consume());
+  CPPUNIT_ASSERT(not bucket.consume());
+
+  /* invalid values are clamped */
+  bucket.set_rate(-1, 0);
+  CPPUNIT_ASSERT(bucket.get_rate() == 0);
+  CPPUNIT_ASSERT(bucket.get_burst() == 1);
+  CPPUNIT_ASSERT(bucket.consume());
+}
@@ -0,0 +1,35 @@
+/*
+ * ctokenbuckettest.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_CTOKENBUCKET_TEST_HPP_
+#define TEST_SRC_ROFL_COMMON_CTOKENBUCKET_TEST_HPP_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/ctokenbucket.hpp"
+
+class ctokenbuckettest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(ctokenbuckettest);
+  CPPUNIT_TEST(testUnlimited);
+  CPPUNIT_TEST(testBurst);
+  CPPUNIT_TEST(testRefill);
+  CPPUNIT_TEST(testSetRate);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp(){};
+  void tearDown(){};
+
+public:
+  void testUnlimited();
+  void testBurst();
+  void testRefill();
+  void testSetRate();
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_CTOKENBUCKET_TEST_HPP_ */
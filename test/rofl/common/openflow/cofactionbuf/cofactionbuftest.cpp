@@ -0,0 +1,357 @@
+/*
+ * cofactionbuftest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#include <stdlib.h>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "cofactionbuftest.hpp"
+
+using namespace rofl::openflow;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(cofactionbuftest);
+
+void cofactionbuftest::setUp() {}
+
+void cofactionbuftest::tearDown() {}
+
+rofl::cmemory
+cofactionbuftest::pack(const rofl::openflow::cofactions &actions) {
+  rofl::openflow::cofactions tmp(actions);
+  rofl::cmemory mem(tmp.length());
+  tmp.pack(mem.somem(), mem.length());
+  return mem;
+}
+
+rofl::cmemory
+cofactionbuftest::pack(const rofl::openflow::cofactionbuf &actions) {
+  rofl::cmemory mem(actions.length());
+  actions.pack(mem.somem(), mem.length());
+  return mem;
+}
+
+void cofactionbuftest::testAppend10() {
+  rofl::caddress_ll lladdr("00:11:22:33:44:55");
+  rofl::caddress_in4 in4addr("10.1.2.3");
+  rofl::cmemory body(5);
+  body[0] = 0xa1;
+  body[4] = 0xa5;
+
+  cofactions actions(rofl::openflow10::OFP_VERSION);
+  unsigned int i = 0;
+  actions.add_action_output(rofl::cindex(i++)).set_port_no(0x0003);
+  actions.add_action_set_vlan_vid(rofl::cindex(i++)).set_vlan_vid(0x0123);
+  actions.add_action_set_vlan_pcp(rofl::cindex(i++)).set_vlan_pcp(0x05);
+  actions.add_action_strip_vlan(rofl::cindex(i++));
+  actions.add_action_set_dl_src(rofl::cindex(i++)).set_dl_src(lladdr);
+  actions.add_action_set_dl_dst(rofl::cindex(i++)).set_dl_dst(lladdr);
+  actions.add_action_set_nw_src(rofl::cindex(i++)).set_nw_src(in4addr);
+  actions.add_action_set_nw_dst(rofl::cindex(i++)).set_nw_dst(in4addr);
+  actions.add_action_set_nw_tos(rofl::cindex(i++)).set_nw_tos(0x1c);
+  actions.add_action_set_tp_src(rofl::cindex(i++)).set_tp_src(0x1234);
+  actions.add_action_set_tp_dst(rofl::cindex(i++)).set_tp_dst(0x4321);
+  actions.add_action_enqueue(rofl::cindex(i++)).set_port_no(0x0007);
+  actions.set_action_enqueue(rofl::cindex(i - 1)).set_queue_id(0x0a0b0c0d);
+  actions.add_action_vendor(rofl::cindex(i++)).set_exp_id(0xfefdfcfb);
+  actions.set_action_vendor(rofl::cindex(i - 1)).set_exp_body() = body;
+
+  cofactionbuf buf(rofl::openflow10::OFP_VERSION);
+  buf.append_output(0x0003)
+      .append_set_vlan_vid(0x0123)
+      .append_set_vlan_pcp(0x05)
+      .append_strip_vlan()
+      .append_set_dl_src(lladdr)
+      .append_set_dl_dst(lladdr)
+      .append_set_nw_src(in4addr)
+      .append_set_nw_dst(in4addr)
+      .append_set_nw_tos(0x1c)
+      .append_set_tp_src(0x1234)
+      .append_set_tp_dst(0x4321)
+      .append_enqueue(0x0007, 0x0a0b0c0d)
+      .append_vendor(0xfefdfcfb, body);
+
+  CPPUNIT_ASSERT(buf.size() == 13);
+  CPPUNIT_ASSERT(buf.length() == actions.length());
+  CPPUNIT_ASSERT(pack(buf) == pack(actions));
+}
+
+void cofactionbuftest::testAppend13() {
+  rofl::cmemory body(11);
+  body[0] = 0xb1;
+  body[10] = 0xbb;
+
+  cofactions actions(rofl::openflow13::OFP_VERSION);
+  unsigned int i = 0;
+  actions.add_action_copy_ttl_out(rofl::cindex(i++));
+  actions.add_action_copy_ttl_in(rofl::cindex(i++));
+  actions.add_action_set_mpls_ttl(rofl::cindex(i++)).set_mpls_ttl(0x40);
+  actions.add_action_dec_mpls_ttl(rofl::cindex(i++));
+  actions.add_action_push_vlan(rofl::cindex(i++)).set_eth_type(0x8100);
+  actions.add_action_pop_vlan(rofl::cindex(i++));
+  actions.add_action_push_mpls(rofl::cindex(i++)).set_eth_type(0x8847);
+  actions.add_action_pop_mpls(rofl::cindex(i++)).set_eth_type(0x0800);
+  actions.add_action_set_nw_ttl(rofl::cindex(i++)).set_nw_ttl(0x11);
+  actions.add_action_dec_nw_ttl(rofl::cindex(i++));
+  actions.add_action_set_queue(rofl::cindex(i++)).set_queue_id(0x01020304);
+  actions.add_action_push_pbb(rofl::cindex(i++)).set_eth_type(0x88e7);
+  actions.add_action_pop_pbb(rofl::cindex(i++));
+  actions.add_action_experimenter(rofl::cindex(i++)).set_exp_id(0xa0a1a2a3);
+  actions.set_action_experimenter(rofl::cindex(i - 1)).set_exp_body(body);
+  actions.add_action_group(rofl::cindex(i++)).set_group_id(0x00000017);
+  actions.add_action_output(rofl::cindex(i++)).set_port_no(0xfffffffd);
+  actions.set_action_output(rofl::cindex(i - 1)).set_max_len(0xffff);
+
+  cofactionbuf buf(rofl::openflow13::OFP_VERSION);
+  buf.append_copy_ttl_out()
+      .append_copy_ttl_in()
+      .append_set_mpls_ttl(0x40)
+      .append_dec_mpls_ttl()
+      .append_push_vlan(0x8100)
+      .append_pop_vlan()
+      .append_push_mpls(0x8847)
+      .append_pop_mpls(0x0800)
+      .append_set_nw_ttl(0x11)
+      .append_dec_nw_ttl()
+      .append_set_queue(0x01020304)
+      .append_push_pbb(0x88e7)
+      .append_pop_pbb()
+      .append_experimenter(0xa0a1a2a3, body)
+      .append_group(0x00000017)
+      .append_output(0xfffffffd, 0xffff);
+
+  CPPUNIT_ASSERT(buf.size() == 16);
+  CPPUNIT_ASSERT(buf.length() == actions.length());
+  CPPUNIT_ASSERT(pack(buf) == pack(actions));
+}
+
+void cofactionbuftest::testSetField() {
+  rofl::caddress_ll lladdr("00:11:22:33:44:55");
+  rofl::caddress_in4 in4addr("192.168.1.1");
+  rofl::caddress_in6 in6addr("fe80::1:2:3:4");
+
+  cofactions actions(rofl::openflow13::OFP_VERSION);
+  unsigned int i = 0;
+  actions.add_action_set_field(rofl::cindex(i++))
+      .set_oxm(coxmatch_ofb_in_port(7));
+  actions.add_action_set_field(rofl::cindex(i++)).set_oxm(
+      coxmatch_ofb_metadata(0x0102030405060708ULL));
+  actions.add_action_set_field(rofl::cindex(i++))
+      .set_oxm(coxmatch_ofb_eth_dst(lladdr));
+  actions.add_action_set_field(rofl::cindex(i++))
+      .set_oxm(coxmatch_ofb_eth_src(lladdr));
+  actions.add_action_set_field(rofl::cindex(i++))
+      .set_oxm(coxmatch_ofb_eth_type(0x86dd));
+  actions.add_action_set_field(rofl::cindex(i++)).set_oxm(
+      coxmatch_ofb_vlan_vid(rofl::openflow::OFPVID_PRESENT | 0x0064));
+  actions.add_action_set_field(rofl::cindex(i++))
+      .set_oxm(coxmatch_ofb_vlan_pcp(3));
+  actions.add_action_set_field(rofl::cindex(i++))
+      .set_oxm(coxmatch_ofb_ip_dscp(10));
+  actions.add_action_set_field(rofl::cindex(i++)).set_oxm(
+      coxmatch_ofb_ipv4_src(in4addr));
+  actions.add_action_set_field(rofl::cindex(i++)).set_oxm(
+      coxmatch_ofb_ipv6_dst(in6addr));
+  actions.add_action_set_field(rofl::cindex(i++))
+      .set_oxm(coxmatch_ofb_tcp_dst(80));
+  actions.add_action_set_field(rofl::cindex(i++)).set_oxm(
+      coxmatch_ofb_mpls_label(0x000fffff));
+  actions.add_action_set_field(rofl::cindex(i++)).set_oxm(
+      coxmatch_ofb_pbb_isid(0x00abcdef));
+  actions.add_action_set_field(rofl::cindex(i++)).set_oxm(
+      coxmatch_ofb_tunnel_id(0x1122334455667788ULL));
+  actions.add_action_set_field(rofl::cindex(i++)).set_oxm(
+      coxmatch_ofb_ipv6_nd_sll(lladdr));
+
+  cofactionbuf buf(rofl::openflow13::OFP_VERSION);
+  buf.append_set_field_in_port(7)
+      .append_set_field_metadata(0x0102030405060708ULL)
+      .append_set_field_eth_dst(lladdr)
+      .append_set_field_eth_src(lladdr)
+      .append_set_field_eth_type(0x86dd)
+      .append_set_field_vlan_vid(rofl::openflow::OFPVID_PRESENT | 0x0064)
+      .append_set_field_vlan_pcp(3)
+      .append_set_field_ip_dscp(10)
+      .append_set_field_ipv4_src(in4addr)
+      .append_set_field_ipv6_dst(in6addr)
+      .append_set_field_tcp_dst(80)
+      .append_set_field_mpls_label(0x000fffff)
+      .append_set_field_pbb_isid(0x00abcdef)
+      .append_set_field_tunnel_id(0x1122334455667788ULL)
+      .append_set_field(coxmatch_ofb_ipv6_nd_sll(lladdr));
+
+  CPPUNIT_ASSERT(buf.size() == 15);
+  CPPUNIT_ASSERT(buf.length() == actions.length());
+  CPPUNIT_ASSERT(pack(buf) == pack(actions));
+}
+
+void cofactionbuftest::testIterate() {
+  cofactionbuf buf(rofl::openflow13::OFP_VERSION);
+  buf.append_set_field_tcp_src(0x1f90)
+      .append_set_queue(5)
+      .append_group(9)
+      .append_experimenter(0xc0c1c2c3)
+      .append_output(2, 64);
+
+  cofactionbuf::const_iterator it = buf.begin();
+  CPPUNIT_ASSERT(it->get_type() == rofl::openflow::OFPAT_SET_FIELD);
+  CPPUNIT_ASSERT(it->get_length() == 16);
+  CPPUNIT_ASSERT(it->get_oxm_id() == rofl::openflow::OXM_TLV_BASIC_TCP_SRC);
+  CPPUNIT_ASSERT(it->get_oxm_value()[0] == 0x1f);
+  CPPUNIT_ASSERT(it->get_oxm_value()[1] == 0x90);
+  try {
+    it->get_port_no();
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::openflow::eActionBufInval &e) {
+  }
+  ++it;
+  CPPUNIT_ASSERT(it->get_type() == rofl::openflow::OFPAT_SET_QUEUE);
+  CPPUNIT_ASSERT(it->get_queue_id() == 5);
+  ++it;
+  CPPUNIT_ASSERT(it->get_type() == rofl::openflow::OFPAT_GROUP);
+  CPPUNIT_ASSERT(it->get_group_id() == 9);
+  ++it;
+  CPPUNIT_ASSERT(it->get_type() == rofl::openflow::OFPAT_EXPERIMENTER);
+  CPPUNIT_ASSERT(it->get_exp_id() == 0xc0c1c2c3);
+  CPPUNIT_ASSERT(it->get_length() == 8);
+  it++;
+  CPPUNIT_ASSERT((*it).get_type() == rofl::openflow::OFPAT_OUTPUT);
+  CPPUNIT_ASSERT((*it).get_port_no() == 2);
+  CPPUNIT_ASSERT((*it).get_max_len() == 64);
+  ++it;
+  CPPUNIT_ASSERT(it == buf.end());
+
+  size_t count = 0;
+  for (auto action : buf) {
+    (void)action;
+    count++;
+  }
+  CPPUNIT_ASSERT(count == buf.size());
+
+  cofactionbuf of10(rofl::openflow10::OFP_VERSION);
+  of10.append_output(0xfffd, 0xffff).append_enqueue(4, 6);
+  it = of10.begin();
+  CPPUNIT_ASSERT(it->get_port_no() == 0xfffd);
+  CPPUNIT_ASSERT(it->get_max_len() == 0xffff);
+  ++it;
+  CPPUNIT_ASSERT(it->get_port_no() == 4);
+  CPPUNIT_ASSERT(it->get_queue_id() == 6);
+}
+
+void cofactionbuftest::testConversion() {
+  cofactions actions(rofl::openflow13::OFP_VERSION);
+  actions.add_action_push_vlan(rofl::cindex(0)).set_eth_type(0x8100);
+  actions.add_action_set_field(rofl::cindex(1))
+      .set_oxm(coxmatch_ofb_vlan_vid(rofl::openflow::OFPVID_PRESENT | 10));
+  actions.add_action_output(rofl::cindex(2)).set_port_no(3);
+
+  cofactionbuf buf(actions);
+  CPPUNIT_ASSERT(buf.get_version() == rofl::openflow13::OFP_VERSION);
+  CPPUNIT_ASSERT(buf.size() == 3);
+  CPPUNIT_ASSERT(pack(buf) == pack(actions));
+
+  cofactions converted = buf.get_actions();
+  CPPUNIT_ASSERT(converted.get_version() == rofl::openflow13::OFP_VERSION);
+  CPPUNIT_ASSERT(converted.get_actions().size() == 3);
+  CPPUNIT_ASSERT(pack(converted) == pack(actions));
+  CPPUNIT_ASSERT(
+      converted.get_action_output(rofl::cindex(2)).get_port_no() == 3);
+
+  rofl::cmemory mem(pack(actions));
+  cofactionbuf unpacked(rofl::openflow13::OFP_VERSION);
+  unpacked.unpack(mem.somem(), mem.length());
+  CPPUNIT_ASSERT(unpacked == buf);
+  CPPUNIT_ASSERT(unpacked.size() == 3);
+
+  /* clear() retains the buffer for reuse */
+  unpacked.clear();
+  CPPUNIT_ASSERT(unpacked.empty());
+  CPPUNIT_ASSERT(unpacked.begin() == unpacked.end());
+  CPPUNIT_ASSERT(unpacked.get_actions().get_actions().empty());
+}
+
+void cofactionbuftest::testInstruction() {
+  cofinstruction_apply_actions inst(rofl::openflow13::OFP_VERSION);
+  inst.set_actions().add_action_set_nw_ttl(rofl::cindex(0)).set_nw_ttl(0x20);
+  inst.set_actions().add_action_output(rofl::cindex(1)).set_port_no(1);
+
+  rofl::cmemory expected(inst.length());
+  inst.pack(expected.somem(), expected.length());
+
+  cofactionbuf buf(rofl::openflow13::OFP_VERSION);
+  buf.append_set_nw_ttl(0x20).append_output(1);
+
+  CPPUNIT_ASSERT(buf.instruction_length() == inst.length());
+  rofl::cmemory mem(buf.instruction_length());
+  buf.pack_instruction(rofl::openflow13::OFPIT_APPLY_ACTIONS, mem.somem(),
+                       mem.length());
+  CPPUNIT_ASSERT(mem == expected);
+
+  cofactionbuf of10(rofl::openflow10::OFP_VERSION);
+  of10.append_output(1);
+  rofl::cmemory mem10(of10.instruction_length());
+  try {
+    of10.pack_instruction(rofl::openflow13::OFPIT_APPLY_ACTIONS,
+                          mem10.somem(), mem10.length());
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadVersion &e) {
+  }
+}
+
+void cofactionbuftest::testInvalid() {
+  cofactionbuf of10(rofl::openflow10::OFP_VERSION);
+  try {
+    of10.append_group(1);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadVersion &e) {
+  }
+  try {
+    of10.append_set_field_tcp_dst(80);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadVersion &e) {
+  }
+
+  cofactionbuf of13(rofl::openflow13::OFP_VERSION);
+  try {
+    of13.append_set_vlan_vid(1);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadVersion &e) {
+  }
+  try {
+    of13.append_enqueue(1, 1);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadVersion &e) {
+  }
+  try {
+    of13.append_set_field(coxmatch_ofb_ipv4_dst(0x0a000000, 0xff000000));
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::openflow::eActionBufInval &e) {
+  }
+  CPPUNIT_ASSERT(of13.empty());
+
+  cofactionbuf unknown;
+  try {
+    unknown.append_output(1);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadVersion &e) {
+  }
+
+  /* truncated and misaligned action lists */
+  of13.append_output(1);
+  rofl::cmemory mem(pack(of13));
+  try {
+    of13.unpack(mem.somem(), mem.length() - 4);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadActionBadLen &e) {
+  }
+  mem[3] = 12;
+  try {
+    of13.unpack(mem.somem(), mem.length());
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadActionBadLen &e) {
+  }
+}
@@ -0,0 +1,48 @@
+/*
+ * cofactionbuftest.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_OPENFLOW_COFACTIONBUF_TEST_HPP_
+#define TEST_SRC_ROFL_COMMON_OPENFLOW_COFACTIONBUF_TEST_HPP_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/cmemory.h"
+#include "rofl/common/openflow/cofactionbuf.h"
+#include "rofl/common/openflow/cofinstruction.h"
+
+class cofactionbuftest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(cofactionbuftest);
+  CPPUNIT_TEST(testAppend10);
+  CPPUNIT_TEST(testAppend13);
+  CPPUNIT_TEST(testSetField);
+  CPPUNIT_TEST(testIterate);
+  CPPUNIT_TEST(testConversion);
+  CPPUNIT_TEST(testInstruction);
+  CPPUNIT_TEST(testInvalid);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void testAppend10();
+  void testAppend13();
+  void testSetField();
+  void testIterate();
+  void testConversion();
+  void testInstruction();
+  void testInvalid();
+
+private:
+  rofl::cmemory pack(const rofl::openflow::cofactions &actions);
+
+  rofl::cmemory pack(const rofl::openflow::cofactionbuf &actions);
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_OPENFLOW_COFACTIONBUF_TEST_HPP_ */
@@ -0,0 +1,305 @@
+/*
+ * cofclassifiertest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#include <stdlib.h>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "cofclassifiertest.hpp"
+
+using namespace rofl::openflow;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(cofclassifiertest);
+
+void cofclassifiertest::setUp() {}
+
+void cofclassifiertest::tearDown() {}
+
+cofflowmod cofclassifiertest::flowmod(uint8_t command, uint16_t priority,
+                                      const std::string &ipv4_dst,
+                                      const std::string &mask,
+                                      uint32_t port_no) {
+  cofflowmod fe(rofl::openflow13::OFP_VERSION);
+  fe.set_command(command);
+  fe.set_table_id(1);
+  fe.set_priority(priority);
+  fe.set_match().set_eth_type(0x0800);
+  if (not ipv4_dst.empty()) {
+    fe.set_match().set_ipv4_dst(rofl::caddress_in4(ipv4_dst),
+                                rofl::caddress_in4(mask));
+  }
+  fe.set_instructions()
+      .set_inst_apply_actions()
+      .set_actions()
+      .add_action_output(rofl::cindex(0))
+      .set_port_no(port_no);
+  return fe;
+}
+
+cofclassifier::ckey cofclassifiertest::packet(const std::string &ipv4_dst,
+                                              uint16_t tcp_dst) {
+  cofmatch match(rofl::openflow13::OFP_VERSION);
+  match.set_in_port(1);
+  match.set_eth_type(0x0800);
+  match.set_ip_proto(6);
+  match.set_ipv4_dst(rofl::caddress_in4(ipv4_dst));
+  match.set_tcp_dst(tcp_dst);
+  return cofclassifier::ckey(match);
+}
+
+uint32_t
+cofclassifiertest::output(const std::shared_ptr<const cofflowmod> &fe) {
+  CPPUNIT_ASSERT(fe.get() != nullptr);
+  return fe->get_instructions()
+      .get_inst_apply_actions()
+      .get_actions()
+      .get_action_output(rofl::cindex(0))
+      .get_port_no();
+}
+
+void cofclassifiertest::testLookup() {
+  cofclassifier classifier(rofl::openflow13::OFP_VERSION);
+
+  classifier.flow_mod(flowmod(OFPFC_ADD, 0, "", "", 1));
+  classifier.flow_mod(flowmod(OFPFC_ADD, 8, "10.0.0.0", "255.0.0.0", 2));
+  classifier.flow_mod(flowmod(OFPFC_ADD, 24, "10.1.1.0", "255.255.255.0", 3));
+  classifier.flow_mod(flowmod(OFPFC_ADD, 24, "10.1.2.0", "255.255.255.0", 4));
+  classifier.flow_mod(
+      flowmod(OFPFC_ADD, 32, "10.1.1.1", "255.255.255.255", 5));
+  CPPUNIT_ASSERT(classifier.size() == 5);
+  CPPUNIT_ASSERT(classifier.size(1) == 5);
+  CPPUNIT_ASSERT(classifier.get_num_of_subtables(1) == 4);
+
+  /* longest prefix wins */
+  CPPUNIT_ASSERT(output(classifier.lookup(1, packet("10.1.1.1", 80))) == 5);
+  CPPUNIT_ASSERT(output(classifier.lookup(1, packet("10.1.1.2", 80))) == 3);
+  CPPUNIT_ASSERT(output(classifier.lookup(1, packet("10.1.2.2", 80))) == 4);
+  CPPUNIT_ASSERT(output(classifier.lookup(1, packet("10.2.2.2", 80))) == 2);
+  CPPUNIT_ASSERT(output(classifier.lookup(1, packet("192.168.0.1", 80))) == 1);
+
+  /* unknown table */
+  CPPUNIT_ASSERT(classifier.lookup(2, packet("10.1.1.1", 80)).get() ==
+                 nullptr);
+
+  /* a lower priority for a more specific match does not shadow others */
+  classifier.flow_mod(flowmod(OFPFC_ADD, 1, "10.2.2.2", "255.255.255.255", 6));
+  CPPUNIT_ASSERT(output(classifier.lookup(1, packet("10.2.2.2", 80))) == 2);
+
+  /* replace an existing entry */
+  classifier.flow_mod(
+      flowmod(OFPFC_ADD, 32, "10.1.1.1", "255.255.255.255", 7));
+  CPPUNIT_ASSERT(classifier.size() == 6);
+  CPPUNIT_ASSERT(output(classifier.lookup(1, packet("10.1.1.1", 80))) == 7);
+
+  /* table miss after clearing */
+  classifier.clear();
+  CPPUNIT_ASSERT(classifier.size() == 0);
+  CPPUNIT_ASSERT(classifier.lookup(1, packet("10.1.1.1", 80)).get() ==
+                 nullptr);
+}
+
+void cofclassifiertest::testStagedLookup() {
+  cofclassifier classifier(rofl::openflow13::OFP_VERSION);
+  classifier.set_staged_lookup(true);
+  CPPUNIT_ASSERT(classifier.get_staged_lookup());
+
+  /* fields in stages metadata, L2, L3 and L4 */
+  cofflowmod fe(rofl::openflow13::OFP_VERSION);
+  fe.set_command(OFPFC_ADD);
+  fe.set_table_id(1);
+  fe.set_priority(10);
+  fe.set_match().set_in_port(1);
+  fe.set_match().set_eth_type(0x0800);
+  fe.set_match().set_ip_proto(6);
+  fe.set_match().set_ipv4_dst(rofl::caddress_in4("10.1.1.1"));
+  fe.set_match().set_tcp_dst(80);
+  classifier.flow_mod(fe);
+
+  fe.set_match().set_tcp_dst(443);
+  fe.set_priority(20);
+  classifier.flow_mod(fe);
+
+  classifier.flow_mod(flowmod(OFPFC_ADD, 5, "10.0.0.0", "255.0.0.0", 1));
+
+  CPPUNIT_ASSERT(classifier.lookup(1, packet("10.1.1.1", 80))->get_priority() ==
+                 10);
+  CPPUNIT_ASSERT(
+      classifier.lookup(1, packet("10.1.1.1", 443))->get_priority() == 20);
+  CPPUNIT_ASSERT(classifier.lookup(1, packet("10.1.1.1", 22))->get_priority() ==
+                 5);
+  CPPUNIT_ASSERT(classifier.lookup(1, packet("10.1.1.2", 80))->get_priority() ==
+                 5);
+
+  /* stage keys are released with their last entry */
+  fe.set_command(OFPFC_DELETE_STRICT);
+  classifier.flow_mod(fe);
+  fe.set_match().set_tcp_dst(80);
+  fe.set_priority(10);
+  classifier.flow_mod(fe);
+  CPPUNIT_ASSERT(classifier.size() == 1);
+  CPPUNIT_ASSERT(classifier.get_num_of_subtables(1) == 1);
+  CPPUNIT_ASSERT(classifier.lookup(1, packet("10.1.1.1", 80))->get_priority() ==
+                 5);
+}
+
+void cofclassifiertest::testFlowMod() {
+  cofclassifier classifier(rofl::openflow13::OFP_VERSION);
+
+  classifier.flow_mod(flowmod(OFPFC_ADD, 24, "10.1.1.0", "255.255.255.0", 1));
+  classifier.flow_mod(flowmod(OFPFC_ADD, 24, "10.1.2.0", "255.255.255.0", 1));
+  classifier.flow_mod(flowmod(OFPFC_ADD, 30, "10.1.1.0", "255.255.255.0", 1));
+
+  /* strict modify */
+  CPPUNIT_ASSERT(classifier.flow_mod(flowmod(OFPFC_MODIFY_STRICT, 30,
+                                             "10.1.1.0", "255.255.255.0",
+                                             2)) == 1);
+  CPPUNIT_ASSERT(output(classifier.lookup(1, packet("10.1.1.1", 80))) == 2);
+  CPPUNIT_ASSERT(classifier.lookup(1, packet("10.1.1.1", 80))->get_command() ==
+                 OFPFC_ADD);
+
+  /* strict modify of an unknown entry adds nothing in OpenFlow 1.3 */
+  CPPUNIT_ASSERT(classifier.flow_mod(flowmod(OFPFC_MODIFY_STRICT, 31,
+                                             "10.1.1.0", "255.255.255.0",
+                                             2)) == 0);
+  CPPUNIT_ASSERT(classifier.size() == 3);
+
+  /* strict delete */
+  std::vector<std::shared_ptr<const cofflowmod>> removed;
+  CPPUNIT_ASSERT(classifier.flow_mod(flowmod(OFPFC_DELETE_STRICT, 30,
+                                             "10.1.1.0", "255.255.255.0", 0),
+                                     &removed) == 1);
+  CPPUNIT_ASSERT(removed.size() == 1);
+  CPPUNIT_ASSERT(output(removed.front()) == 2);
+  CPPUNIT_ASSERT(classifier.size() == 2);
+  CPPUNIT_ASSERT(output(classifier.lookup(1, packet("10.1.1.1", 80))) == 1);
+
+  /* add to OFPTT_ALL */
+  cofflowmod fe = flowmod(OFPFC_ADD, 1, "", "", 1);
+  fe.set_table_id(rofl::openflow13::OFPTT_ALL);
+  try {
+    classifier.flow_mod(fe);
+    CPPUNIT_ASSERT(false);
+  } catch (eFlowClassifierBadTableId &e) {
+  }
+
+  /* unknown command */
+  fe.set_command(0xee);
+  try {
+    classifier.flow_mod(fe);
+    CPPUNIT_ASSERT(false);
+  } catch (eFlowClassifierBadCommand &e) {
+  }
+
+  /* version mismatch */
+  try {
+    classifier.flow_mod(cofflowmod(rofl::openflow12::OFP_VERSION));
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadVersion &e) {
+  }
+}
+
+void cofclassifiertest::testFlowModNonStrict() {
+  cofclassifier classifier(rofl::openflow13::OFP_VERSION);
+
+  classifier.flow_mod(flowmod(OFPFC_ADD, 8, "10.0.0.0", "255.0.0.0", 1));
+  classifier.flow_mod(flowmod(OFPFC_ADD, 24, "10.1.1.0", "255.255.255.0", 1));
+  classifier.flow_mod(
+      flowmod(OFPFC_ADD, 32, "10.1.1.1", "255.255.255.255", 1));
+  classifier.flow_mod(flowmod(OFPFC_ADD, 24, "10.2.1.0", "255.255.255.0", 1));
+
+  /* non-strict modify covering 10.1.0.0/16 */
+  CPPUNIT_ASSERT(classifier.flow_mod(flowmod(OFPFC_MODIFY, 0, "10.1.0.0",
+                                             "255.255.0.0", 2)) == 2);
+  CPPUNIT_ASSERT(output(classifier.lookup(1, packet("10.1.1.1", 80))) == 2);
+  CPPUNIT_ASSERT(output(classifier.lookup(1, packet("10.1.1.2", 80))) == 2);
+  CPPUNIT_ASSERT(output(classifier.lookup(1, packet("10.2.1.1", 80))) == 1);
+  CPPUNIT_ASSERT(output(classifier.lookup(1, packet("10.3.1.1", 80))) == 1);
+
+  /* non-strict delete with cookie filter */
+  cofflowmod fe = flowmod(OFPFC_DELETE, 0, "10.0.0.0", "255.0.0.0", 0);
+  fe.set_cookie(0x1);
+  fe.set_cookie_mask(0xff);
+  CPPUNIT_ASSERT(classifier.flow_mod(fe) == 0);
+
+  /* non-strict delete covering 10.1.0.0/16 */
+  CPPUNIT_ASSERT(classifier.flow_mod(flowmod(OFPFC_DELETE, 0, "10.1.0.0",
+                                             "255.255.0.0", 0)) == 2);
+  CPPUNIT_ASSERT(classifier.size() == 2);
+  CPPUNIT_ASSERT(output(classifier.lookup(1, packet("10.1.1.1", 80))) == 1);
+
+  /* non-strict delete in a different table */
+  fe = flowmod(OFPFC_DELETE, 0, "", "", 0);
+  fe.set_table_id(2);
+  CPPUNIT_ASSERT(classifier.flow_mod(fe) == 0);
+
+  /* non-strict delete in all tables */
+  classifier.flow_mod(flowmod(OFPFC_ADD, 0, "", "", 1).set_table_id(3));
+  fe.set_table_id(rofl::openflow13::OFPTT_ALL);
+  CPPUNIT_ASSERT(classifier.flow_mod(fe) == 3);
+  CPPUNIT_ASSERT(classifier.size() == 0);
+  CPPUNIT_ASSERT(classifier.get_num_of_subtables(1) == 0);
+}
+
+void cofclassifiertest::testOverlap() {
+  cofclassifier classifier(rofl::openflow13::OFP_VERSION);
+
+  classifier.flow_mod(flowmod(OFPFC_ADD, 10, "10.1.0.0", "255.255.0.0", 1));
+
+  /* disjoint */
+  cofflowmod fe = flowmod(OFPFC_ADD, 10, "10.2.0.0", "255.255.0.0", 2);
+  fe.set_flags(OFPFF_CHECK_OVERLAP);
+  classifier.flow_mod(fe);
+
+  /* different priority */
+  fe = flowmod(OFPFC_ADD, 11, "10.1.1.0", "255.255.255.0", 3);
+  fe.set_flags(OFPFF_CHECK_OVERLAP);
+  classifier.flow_mod(fe);
+  CPPUNIT_ASSERT(classifier.size() == 3);
+
+  /* overlaps 10.1.0.0/16 */
+  fe = flowmod(OFPFC_ADD, 10, "10.1.1.0", "255.255.255.0", 4);
+  fe.set_flags(OFPFF_CHECK_OVERLAP);
+  try {
+    classifier.flow_mod(fe);
+    CPPUNIT_ASSERT(false);
+  } catch (eFlowClassifierOverlap &e) {
+  }
+
+  /* a wildcard match overlaps everything */
+  fe = flowmod(OFPFC_ADD, 10, "", "", 5);
+  fe.set_flags(OFPFF_CHECK_OVERLAP);
+  try {
+    classifier.flow_mod(fe);
+    CPPUNIT_ASSERT(false);
+  } catch (eFlowClassifierOverlap &e) {
+  }
+  CPPUNIT_ASSERT(classifier.size() == 3);
+}
+
+void cofclassifiertest::testOutPort() {
+  cofclassifier classifier(rofl::openflow13::OFP_VERSION);
+
+  classifier.flow_mod(flowmod(OFPFC_ADD, 24, "10.1.1.0", "255.255.255.0", 1));
+  classifier.flow_mod(flowmod(OFPFC_ADD, 24, "10.1.2.0", "255.255.255.0", 2));
+
+  cofflowmod fe = flowmod(OFPFC_DELETE, 0, "", "", 0);
+  fe.set_out_port(3);
+  CPPUNIT_ASSERT(classifier.flow_mod(fe) == 0);
+
+  fe.set_out_port(2);
+  CPPUNIT_ASSERT(classifier.flow_mod(fe) == 1);
+  CPPUNIT_ASSERT(output(classifier.lookup(1, packet("10.1.1.1", 80))) == 1);
+  CPPUNIT_ASSERT(classifier.lookup(1, packet("10.1.2.1", 80)).get() ==
+                 nullptr);
+
+  /* out_group */
+  fe = flowmod(OFPFC_DELETE, 0, "", "", 0);
+  fe.set_out_group(5);
+  CPPUNIT_ASSERT(classifier.flow_mod(fe) == 0);
+  CPPUNIT_ASSERT(classifier.size() == 1);
+}
@@ -0,0 +1,49 @@
+/*
+ * cofclassifiertest.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_OPENFLOW_COFCLASSIFIER_TEST_HPP_
+#define TEST_SRC_ROFL_COMMON_OPENFLOW_COFCLASSIFIER_TEST_HPP_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/openflow/cofclassifier.h"
+
+class cofclassifiertest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(cofclassifiertest);
+  CPPUNIT_TEST(testLookup);
+  CPPUNIT_TEST(testStagedLookup);
+  CPPUNIT_TEST(testFlowMod);
+  CPPUNIT_TEST(testFlowModNonStrict);
+  CPPUNIT_TEST(testOverlap);
+  CPPUNIT_TEST(testOutPort);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void testLookup();
+  void testStagedLookup();
+  void testFlowMod();
+  void testFlowModNonStrict();
+  void testOverlap();
+  void testOutPort();
+
+private:
+  rofl::openflow::cofflowmod flowmod(uint8_t command, uint16_t priority,
+                                     const std::string &ipv4_dst,
+                                     const std::string &mask, uint32_t port_no);
+
+  rofl::openflow::cofclassifier::ckey packet(const std::string &ipv4_dst,
+                                             uint16_t tcp_dst);
+
+  uint32_t output(const std::shared_ptr<const rofl::openflow::cofflowmod> &fe);
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_OPENFLOW_COFCLASSIFIER_TEST_HPP_ */
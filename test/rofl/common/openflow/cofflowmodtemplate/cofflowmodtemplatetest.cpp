@@ -0,0 +1,281 @@
+/*
+ * cofflowmodtemplatetest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#include <stdlib.h>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "cofflowmodtemplatetest.hpp"
+
+using namespace rofl::openflow;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(cofflowmodtemplatetest);
+
+void cofflowmodtemplatetest::setUp() {}
+
+void cofflowmodtemplatetest::tearDown() {}
+
+rofl::openflow::cofflowmod
+cofflowmodtemplatetest::flowmod(uint8_t version, uint64_t cookie,
+                                uint16_t priority, uint32_t ipv4_dst,
+                                uint32_t port_no) {
+  rofl::openflow::cofflowmod fe(version);
+  rofl::caddress_in4 dst;
+  dst.set_addr_hbo(ipv4_dst);
+
+  fe.set_command(rofl::openflow::OFPFC_ADD);
+  fe.set_cookie(cookie);
+  fe.set_priority(priority);
+  fe.set_idle_timeout(0x1112);
+  fe.set_hard_timeout(0x2122);
+  fe.set_match().set_in_port(0x31);
+  fe.set_match().set_eth_type(0x0800);
+  fe.set_match().set_ipv4_dst(dst);
+
+  switch (version) {
+  case rofl::openflow10::OFP_VERSION: {
+    fe.set_actions()
+        .add_action_output(rofl::cindex(0))
+        .set_port_no(port_no & 0x0000ffff);
+  } break;
+  default: {
+    fe.set_table_id(0x02);
+    fe.set_instructions()
+        .set_inst_apply_actions()
+        .set_actions()
+        .add_action_output(rofl::cindex(0))
+        .set_port_no(port_no);
+    fe.set_instructions().set_inst_goto_table().set_table_id(0x03);
+  };
+  }
+
+  return fe;
+}
+
+rofl::cmemory
+cofflowmodtemplatetest::pack(uint8_t version, uint32_t xid,
+                             const rofl::openflow::cofflowmod &flowmod) {
+  rofl::openflow::cofmsg_flow_mod msg(version, xid, flowmod);
+  rofl::cmemory mem(msg.length());
+  msg.pack(mem.somem(), mem.length());
+  return mem;
+}
+
+void cofflowmodtemplatetest::testTemplate10() {
+  testTemplate(rofl::openflow10::OFP_VERSION);
+}
+
+void cofflowmodtemplatetest::testTemplate12() {
+  testTemplate(rofl::openflow12::OFP_VERSION);
+}
+
+void cofflowmodtemplatetest::testTemplate13() {
+  testTemplate(rofl::openflow13::OFP_VERSION);
+}
+
+void cofflowmodtemplatetest::testTemplate(uint8_t version) {
+  rofl::openflow::cofflowmodtemplate tmpl(
+      flowmod(version, 0xa1a2a3a4a5a6a7a8, 0xb1b2, 0x0a000001, 0xc1c2c3c4),
+      0xd1d2d3d4);
+
+  CPPUNIT_ASSERT(tmpl.get_version() == version);
+  CPPUNIT_ASSERT(tmpl.get_num_of_output_ports() == 1);
+
+  /* unpatched image equals regular pack() output */
+  {
+    rofl::cmemory expected =
+        pack(version, 0xd1d2d3d4, flowmod(version, 0xa1a2a3a4a5a6a7a8, 0xb1b2,
+                                          0x0a000001, 0xc1c2c3c4));
+    rofl::cmemory mem(tmpl.length());
+    tmpl.pack(mem.somem(), mem.length());
+    CPPUNIT_ASSERT(mem == expected);
+  }
+
+  /* stamp out instances and compare with regular pack() output */
+  for (unsigned int i = 0; i < 16; i++) {
+    uint32_t xid = 0x100 + i;
+    uint64_t cookie = 0x1000000000000000ULL + i;
+    uint16_t priority = 0x2000 + i;
+    uint32_t ipv4_dst = 0x0a010000 + i;
+    uint32_t port_no = 0x30 + i;
+
+    tmpl.set_xid(xid).set_cookie(cookie).set_priority(priority);
+    tmpl.set_output_port(0, port_no);
+    if (version > rofl::openflow10::OFP_VERSION) {
+      tmpl.set_oxm_u32(rofl::openflow::OXM_TLV_BASIC_IPV4_DST, ipv4_dst);
+    } else {
+      /* OF1.0 packs OFX network fields only */
+      ipv4_dst = 0x0a000001;
+      CPPUNIT_ASSERT(
+          not tmpl.has_oxm(rofl::openflow::OXM_TLV_BASIC_IPV4_DST));
+    }
+
+    rofl::cmemory expected = pack(
+        version, xid, flowmod(version, cookie, priority, ipv4_dst, port_no));
+    rofl::cmemory mem(tmpl.length());
+    tmpl.pack(mem.somem(), mem.length());
+
+    if (not(mem == expected)) {
+      std::cerr << ">>> template <<<" << std::endl << tmpl;
+      std::cerr << ">>> expected <<<" << std::endl << expected;
+    }
+    CPPUNIT_ASSERT(mem == expected);
+  }
+}
+
+void cofflowmodtemplatetest::testTemplateMasked13() {
+  uint8_t version = rofl::openflow13::OFP_VERSION;
+  rofl::caddress_in4 dst, mask;
+  dst.set_addr_hbo(0x0a000000);
+  mask.set_addr_hbo(0xff000000);
+
+  rofl::openflow::cofflowmod fe(version);
+  fe.set_match().set_eth_type(0x0800);
+  fe.set_match().set_ipv4_dst(dst, mask);
+
+  rofl::openflow::cofflowmodtemplate tmpl(fe);
+
+  CPPUNIT_ASSERT(tmpl.has_oxm(rofl::openflow::OXM_TLV_BASIC_IPV4_DST_MASK));
+  CPPUNIT_ASSERT(not tmpl.has_oxm(rofl::openflow::OXM_TLV_BASIC_IPV4_DST));
+  CPPUNIT_ASSERT(tmpl.get_num_of_output_ports() == 0);
+
+  uint32_t value = htobe32(0xc0a80000);
+  uint32_t valuemask = htobe32(0xffff0000);
+  tmpl.set_oxm(rofl::openflow::OXM_TLV_BASIC_IPV4_DST_MASK,
+               (const uint8_t *)&value, sizeof(value),
+               (const uint8_t *)&valuemask);
+
+  dst.set_addr_hbo(0xc0a80000);
+  mask.set_addr_hbo(0xffff0000);
+  rofl::openflow::cofflowmod ref(version);
+  ref.set_match().set_eth_type(0x0800);
+  ref.set_match().set_ipv4_dst(dst, mask);
+
+  rofl::cmemory expected = pack(version, 0, ref);
+  rofl::cmemory mem(tmpl.length());
+  tmpl.pack(mem.somem(), mem.length());
+  CPPUNIT_ASSERT(mem == expected);
+
+  /* value bits outside of the mask are cleared */
+  value = htobe32(0xc0a80101);
+  tmpl.set_oxm(rofl::openflow::OXM_TLV_BASIC_IPV4_DST_MASK,
+               (const uint8_t *)&value, sizeof(value));
+  tmpl.pack(mem.somem(), mem.length());
+  CPPUNIT_ASSERT(mem == expected);
+
+  value = htobe32(0xc0a80101);
+  valuemask = htobe32(0xffffff00);
+  tmpl.set_oxm(rofl::openflow::OXM_TLV_BASIC_IPV4_DST_MASK,
+               (const uint8_t *)&value, sizeof(value),
+               (const uint8_t *)&valuemask);
+
+  dst.set_addr_hbo(0xc0a80100);
+  mask.set_addr_hbo(0xffffff00);
+  rofl::openflow::cofflowmod ref2(version);
+  ref2.set_match().set_eth_type(0x0800);
+  ref2.set_match().set_ipv4_dst(dst, mask);
+
+  expected = pack(version, 0, ref2);
+  tmpl.pack(mem.somem(), mem.length());
+  CPPUNIT_ASSERT(mem == expected);
+}
+
+void cofflowmodtemplatetest::testTemplateMatch10() {
+  uint8_t version = rofl::openflow10::OFP_VERSION;
+  rofl::caddress_in4 dst, src, mask, exact;
+  dst.set_addr_hbo(0x0a000001);
+  src.set_addr_hbo(0x0b000000);
+  mask.set_addr_hbo(0xff000000);
+  exact.set_addr_hbo(0xffffffff);
+
+  rofl::openflow::cofflowmod fe(version);
+  fe.set_match().set_eth_type(0x0800);
+  fe.set_match().set_eth_dst(rofl::caddress_ll("00:11:22:33:44:55"));
+  fe.set_match().set_nw_proto(6);
+  fe.set_match().set_nw_dst(dst, exact);
+  fe.set_match().set_nw_src(src, mask);
+  fe.set_match().set_tp_dst(80);
+
+  rofl::openflow::cofflowmodtemplate tmpl(fe);
+
+  CPPUNIT_ASSERT(tmpl.has_oxm(rofl::openflow::OXM_TLV_BASIC_ETH_TYPE));
+  CPPUNIT_ASSERT(tmpl.has_oxm(rofl::openflow::OXM_TLV_BASIC_ETH_DST));
+  CPPUNIT_ASSERT(
+      tmpl.has_oxm(rofl::openflow::experimental::OXM_TLV_EXPR_NW_PROTO));
+  CPPUNIT_ASSERT(
+      tmpl.has_oxm(rofl::openflow::experimental::OXM_TLV_EXPR_NW_DST));
+  CPPUNIT_ASSERT(
+      tmpl.has_oxm(rofl::openflow::experimental::OXM_TLV_EXPR_TP_DST));
+  /* wildcarded or prefix matched */
+  CPPUNIT_ASSERT(not tmpl.has_oxm(rofl::openflow::OXM_TLV_BASIC_ETH_SRC));
+  CPPUNIT_ASSERT(
+      not tmpl.has_oxm(rofl::openflow::experimental::OXM_TLV_EXPR_NW_SRC));
+  CPPUNIT_ASSERT(
+      not tmpl.has_oxm(rofl::openflow::experimental::OXM_TLV_EXPR_TP_SRC));
+
+  tmpl.set_oxm_u16(rofl::openflow::experimental::OXM_TLV_EXPR_TP_DST, 443);
+  tmpl.set_oxm_u32(rofl::openflow::experimental::OXM_TLV_EXPR_NW_DST,
+                   0x0a000002);
+  uint8_t eth_dst[OFP_ETH_ALEN] = {0x00, 0x66, 0x77, 0x88, 0x99, 0xaa};
+  tmpl.set_oxm(rofl::openflow::OXM_TLV_BASIC_ETH_DST, eth_dst,
+               sizeof(eth_dst));
+
+  dst.set_addr_hbo(0x0a000002);
+  rofl::openflow::cofflowmod ref(version);
+  ref.set_match().set_eth_type(0x0800);
+  ref.set_match().set_eth_dst(rofl::caddress_ll("00:66:77:88:99:aa"));
+  ref.set_match().set_nw_proto(6);
+  ref.set_match().set_nw_dst(dst, exact);
+  ref.set_match().set_nw_src(src, mask);
+  ref.set_match().set_tp_dst(443);
+
+  rofl::cmemory expected = pack(version, 0, ref);
+  rofl::cmemory mem(tmpl.length());
+  tmpl.pack(mem.somem(), mem.length());
+  CPPUNIT_ASSERT(mem == expected);
+}
+
+void cofflowmodtemplatetest::testTemplateNotFound() {
+  rofl::openflow::cofflowmodtemplate tmpl13(
+      flowmod(rofl::openflow13::OFP_VERSION, 0, 0, 0, 0));
+
+  try {
+    tmpl13.set_oxm_u16(rofl::openflow::OXM_TLV_BASIC_TCP_DST, 80);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::openflow::eFlowModTemplateNotFound &e) {
+  }
+
+  try {
+    tmpl13.set_oxm_u16(rofl::openflow::OXM_TLV_BASIC_IPV4_DST, 80);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::openflow::eFlowModTemplateInval &e) {
+  }
+
+  try {
+    tmpl13.set_output_port(1, 1);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::openflow::eFlowModTemplateNotFound &e) {
+  }
+
+  rofl::openflow::cofflowmodtemplate tmpl10(
+      flowmod(rofl::openflow10::OFP_VERSION, 0, 0, 0, 0));
+
+  try {
+    tmpl10.set_table_id(1);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadVersion &e) {
+  }
+
+  rofl::openflow::cofflowmodtemplate empty;
+
+  try {
+    empty.set_xid(1);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::openflow::eFlowModTemplateInval &e) {
+  }
+}
@@ -0,0 +1,51 @@
+/*
+ * cofflowmodtemplatetest.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_OPENFLOW_COFFLOWMODTEMPLATE_TEST_HPP_
+#define TEST_SRC_ROFL_COMMON_OPENFLOW_COFFLOWMODTEMPLATE_TEST_HPP_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/cmemory.h"
+#include "rofl/common/openflow/cofflowmodtemplate.h"
+#include "rofl/common/openflow/messages/cofmsg_flow_mod.h"
+
+class cofflowmodtemplatetest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(cofflowmodtemplatetest);
+  CPPUNIT_TEST(testTemplate10);
+  CPPUNIT_TEST(testTemplate12);
+  CPPUNIT_TEST(testTemplate13);
+  CPPUNIT_TEST(testTemplateMasked13);
+  CPPUNIT_TEST(testTemplateMatch10);
+  CPPUNIT_TEST(testTemplateNotFound);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void testTemplate10();
+  void testTemplate12();
+  void testTemplate13();
+  void testTemplateMasked13();
+  void testTemplateMatch10();
+  void testTemplateNotFound();
+
+private:
+  void testTemplate(uint8_t version);
+
+  rofl::openflow::cofflowmod flowmod(uint8_t version, uint64_t cookie,
+                                     uint16_t priority, uint32_t ipv4_dst,
+                                     uint32_t port_no);
+
+  rofl::cmemory pack(uint8_t version, uint32_t xid,
+                     const rofl::openflow::cofflowmod &flowmod);
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_OPENFLOW_COFFLOWMODTEMPLATE_TEST_HPP_ */
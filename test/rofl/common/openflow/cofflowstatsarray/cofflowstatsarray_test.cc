@@ -334,3 +334,78 @@ void cofflowstatsarray_test::testAddDropSetGetHas() {
   }
   array.add_flow_stats(0);
 }
+
+void cofflowstatsarray_test::testParallelUnpack() {
+  rofl::openflow::cofflowstatsarray array(rofl::openflow13::OFP_VERSION);
+
+  for (unsigned int i = 0; i < 500; i++) {
+    rofl::openflow::cofflow_stats_reply &stats = array.add_flow_stats(i);
+    stats.set_table_id(i % 8);
+    stats.set_priority(i);
+    stats.set_cookie(0xa1a2a3a4a5a6a7a8ULL + i);
+    stats.set_packet_count(i * 3);
+    stats.set_match().set_eth_type(0x0800);
+    stats.set_match().set_ipv4_dst(rofl::caddress_in4("10.0.0.1"));
+    stats.set_match().set_ip_proto(6);
+    stats.set_match().set_tcp_dst(i);
+    stats.set_instructions().set_inst_goto_table().set_table_id(i % 8 + 1);
+  }
+
+  rofl::cmemory mem(array.length());
+  array.pack(mem.somem(), mem.length());
+
+  /* sequential decoding */
+  rofl::openflow::cofflowstatsarray seq(rofl::openflow13::OFP_VERSION);
+  seq.unpack(mem.somem(), mem.length());
+
+  /* parallel decoding on three workers plus the calling thread */
+  rofl::cworkerpool::initialize(3, 16);
+  rofl::openflow::cofflowstatsarray par(rofl::openflow13::OFP_VERSION);
+  try {
+    par.unpack(mem.somem(), mem.length());
+  } catch (...) {
+    rofl::cworkerpool::terminate();
+    throw;
+  }
+  rofl::cworkerpool::terminate();
+
+  CPPUNIT_ASSERT(seq.size() == 500);
+  CPPUNIT_ASSERT(par.size() == 500);
+  for (unsigned int i = 0; i < 500; i++) {
+    CPPUNIT_ASSERT(par.get_flow_stats(i).get_priority() == i);
+    CPPUNIT_ASSERT(par.get_flow_stats(i).get_match().get_tcp_dst() == i);
+  }
+
+  rofl::cmemory mseq(seq.length());
+  seq.pack(mseq.somem(), mseq.length());
+  rofl::cmemory mpar(par.length());
+  par.pack(mpar.somem(), mpar.length());
+
+  CPPUNIT_ASSERT(mseq == mem);
+  CPPUNIT_ASSERT(mpar == mem);
+}
+
+void cofflowstatsarray_test::testUnpackBadLength() {
+  rofl::openflow::cofflowstatsarray array(rofl::openflow13::OFP_VERSION);
+  array.add_flow_stats(0).set_match().set_eth_type(0x0800);
+  array.add_flow_stats(1).set_match().set_eth_type(0x86dd);
+
+  rofl::cmemory mem(array.length());
+  array.pack(mem.somem(), mem.length());
+
+  /* last entry claims to extend beyond the end of the buffer */
+  size_t offset = array.get_flow_stats(0).length();
+  struct rofl::openflow13::ofp_flow_stats *flow_stats =
+      (struct rofl::openflow13::ofp_flow_stats *)(mem.somem() + offset);
+  flow_stats->length = htobe16(mem.length() - offset + 8);
+
+  rofl::cworkerpool::initialize(2, 2);
+  try {
+    rofl::openflow::cofflowstatsarray clone(rofl::openflow13::OFP_VERSION);
+    clone.unpack(mem.somem(), mem.length());
+    rofl::cworkerpool::terminate();
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eInvalid &e) {
+    rofl::cworkerpool::terminate();
+  }
+}
@@ -1,5 +1,6 @@
 #include "rofl/common/caddress.h"
 #include "rofl/common/cmemory.h"
+#include "rofl/common/cworkerpool.hpp"
 #include "rofl/common/openflow/cofflowstatsarray.h"
 #include <cppunit/TestFixture.h>
 #include <cppunit/extensions/HelperMacros.h>
@@ -12,6 +13,8 @@ class cofflowstatsarray_test : public CppUnit::TestFixture {
   CPPUNIT_TEST(testOperatorPlus);
   CPPUNIT_TEST(testPackUnpack);
   CPPUNIT_TEST(testAddDropSetGetHas);
+  CPPUNIT_TEST(testParallelUnpack);
+  CPPUNIT_TEST(testUnpackBadLength);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -24,4 +27,6 @@ public:
   void testOperatorPlus();
   void testPackUnpack();
   void testAddDropSetGetHas();
+  void testParallelUnpack();
+  void testUnpackBadLength();
 };
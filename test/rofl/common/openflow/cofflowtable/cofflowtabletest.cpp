@@ -0,0 +1,243 @@
+/*
+ * cofflowtabletest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#include <stdlib.h>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "cofflowtabletest.hpp"
+
+using namespace rofl::openflow;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(cofflowtabletest);
+
+void cofflowtabletest::setUp() {}
+
+void cofflowtabletest::tearDown() {}
+
+cofflowmod cofflowtabletest::flowmod(uint8_t command, uint16_t priority,
+                                     uint16_t tcp_dst, uint32_t port_no) {
+  cofflowmod fe(rofl::openflow13::OFP_VERSION);
+  fe.set_command(command);
+  fe.set_table_id(1);
+  fe.set_priority(priority);
+  fe.set_cookie(0x1000 + tcp_dst);
+  fe.set_match().set_eth_type(0x0800);
+  fe.set_match().set_ip_proto(6);
+  fe.set_match().set_tcp_dst(tcp_dst);
+  fe.set_instructions()
+      .set_inst_apply_actions()
+      .set_actions()
+      .add_action_output(rofl::cindex(0))
+      .set_port_no(port_no);
+  return fe;
+}
+
+void cofflowtabletest::add_flow_stats(cofflowstatsarray &stats,
+                                      const cofflowmod &fe) {
+  cofflow_stats_reply &reply = stats.add_flow_stats();
+  reply.set_table_id(fe.get_table_id());
+  reply.set_priority(fe.get_priority());
+  reply.set_idle_timeout(fe.get_idle_timeout());
+  reply.set_cookie(fe.get_cookie());
+  reply.set_match(fe.get_match());
+  reply.set_instructions(fe.get_instructions());
+}
+
+void cofflowtabletest::testFlowMod() {
+  cofflowtable table(rofl::openflow13::OFP_VERSION);
+
+  table.flow_mod(flowmod(OFPFC_ADD, 100, 80, 1));
+  table.flow_mod(flowmod(OFPFC_ADD, 100, 443, 1));
+  table.flow_mod(flowmod(OFPFC_ADD, 200, 80, 1));
+  CPPUNIT_ASSERT(table.size() == 3);
+
+  /* replace an existing entry */
+  table.flow_mod(flowmod(OFPFC_ADD, 100, 80, 2));
+  CPPUNIT_ASSERT(table.size() == 3);
+
+  /* strict modify */
+  table.flow_mod(flowmod(OFPFC_MODIFY_STRICT, 200, 80, 3));
+  cofflowmod fe = flowmod(OFPFC_ADD, 200, 80, 3);
+  CPPUNIT_ASSERT(table.get_flow(1, 200, fe.get_match()).get_instructions() ==
+                 fe.get_instructions());
+
+  /* strict modify of an unknown entry adds nothing in OpenFlow 1.3 */
+  table.flow_mod(flowmod(OFPFC_MODIFY_STRICT, 300, 80, 3));
+  CPPUNIT_ASSERT(table.size() == 3);
+
+  /* strict delete */
+  table.flow_mod(flowmod(OFPFC_DELETE_STRICT, 100, 443, 0));
+  CPPUNIT_ASSERT(table.size() == 2);
+  CPPUNIT_ASSERT(table.has_flow(1, 200, fe.get_match()));
+
+  try {
+    table.get_flow(1, 100, flowmod(OFPFC_ADD, 100, 443, 0).get_match());
+    CPPUNIT_ASSERT(false);
+  } catch (eFlowTableNotFound &e) {
+  }
+}
+
+void cofflowtabletest::testFlowModNonStrict() {
+  cofflowtable table(rofl::openflow13::OFP_VERSION);
+
+  table.flow_mod(flowmod(OFPFC_ADD, 100, 80, 1));
+  table.flow_mod(flowmod(OFPFC_ADD, 200, 443, 1));
+
+  /* non-strict modify covering all TCP entries */
+  cofflowmod fe(rofl::openflow13::OFP_VERSION);
+  fe.set_command(OFPFC_MODIFY);
+  fe.set_table_id(1);
+  fe.set_match().set_eth_type(0x0800);
+  fe.set_match().set_ip_proto(6);
+  fe.set_instructions()
+      .set_inst_apply_actions()
+      .set_actions()
+      .add_action_output(rofl::cindex(0))
+      .set_port_no(7);
+  table.flow_mod(fe);
+
+  cofmatch http(flowmod(OFPFC_ADD, 100, 80, 0).get_match());
+  cofmatch https(flowmod(OFPFC_ADD, 200, 443, 0).get_match());
+  CPPUNIT_ASSERT(table.get_flow(1, 100, http).get_instructions() ==
+                 fe.get_instructions());
+  CPPUNIT_ASSERT(table.get_flow(1, 200, https).get_instructions() ==
+                 fe.get_instructions());
+
+  /* non-strict delete in a different table */
+  fe.clear();
+  fe.set_command(OFPFC_DELETE);
+  fe.set_table_id(2);
+  table.flow_mod(fe);
+  CPPUNIT_ASSERT(table.size() == 2);
+
+  /* non-strict delete in all tables */
+  fe.set_table_id(rofl::openflow13::OFPTT_ALL);
+  fe.set_match().set_tcp_dst(80);
+  table.flow_mod(fe);
+  CPPUNIT_ASSERT(table.size() == 1);
+
+  fe.clear();
+  fe.set_table_id(rofl::openflow13::OFPTT_ALL);
+  table.flow_mod(fe);
+  CPPUNIT_ASSERT(table.size() == 0);
+}
+
+void cofflowtabletest::testFlowRemoved() {
+  cofflowtable table(rofl::openflow13::OFP_VERSION);
+
+  table.flow_mod(flowmod(OFPFC_ADD, 100, 80, 1));
+  table.flow_mod(flowmod(OFPFC_ADD, 100, 443, 1));
+
+  cofmatch match(flowmod(OFPFC_ADD, 100, 80, 1).get_match());
+  CPPUNIT_ASSERT(table.flow_removed(1, 100, match));
+  CPPUNIT_ASSERT(not table.flow_removed(1, 100, match));
+  CPPUNIT_ASSERT(not table.has_flow(1, 100, match));
+  CPPUNIT_ASSERT(table.size() == 1);
+}
+
+void cofflowtabletest::testReconcile() {
+  cofflowtable table(rofl::openflow13::OFP_VERSION);
+
+  table.flow_mod(flowmod(OFPFC_ADD, 100, 22, 1)); // in sync
+  table.flow_mod(flowmod(OFPFC_ADD, 100, 80, 1)); // missing on datapath
+  table.flow_mod(flowmod(OFPFC_ADD, 100, 443, 1)); // modified on datapath
+
+  cofflowstatsarray stats(rofl::openflow13::OFP_VERSION);
+  add_flow_stats(stats, flowmod(OFPFC_ADD, 100, 22, 1));
+  add_flow_stats(stats, flowmod(OFPFC_ADD, 100, 443, 2));
+  add_flow_stats(stats, flowmod(OFPFC_ADD, 100, 8080, 1)); // unknown
+
+  std::vector<cofflowmod> delta;
+
+  /* no reconciliation in progress */
+  CPPUNIT_ASSERT(table.reconcile_end(delta) == 0);
+
+  table.reconcile_begin();
+  CPPUNIT_ASSERT(table.reconcile_in_progress());
+  table.reconcile_add(stats);
+  CPPUNIT_ASSERT(table.reconcile_end(delta) == 3);
+  CPPUNIT_ASSERT(not table.reconcile_in_progress());
+  CPPUNIT_ASSERT(delta.size() == 3);
+
+  unsigned int num_add = 0, num_modify = 0, num_delete = 0;
+  for (auto fe : delta) {
+    switch (fe.get_command()) {
+    case OFPFC_ADD: {
+      num_add++;
+      CPPUNIT_ASSERT(fe.get_match() ==
+                     flowmod(OFPFC_ADD, 100, 80, 1).get_match());
+    } break;
+    case OFPFC_MODIFY_STRICT: {
+      num_modify++;
+      CPPUNIT_ASSERT(fe.get_instructions() ==
+                     flowmod(OFPFC_ADD, 100, 443, 1).get_instructions());
+    } break;
+    case OFPFC_DELETE_STRICT: {
+      num_delete++;
+      CPPUNIT_ASSERT(fe.get_match() ==
+                     flowmod(OFPFC_ADD, 100, 8080, 1).get_match());
+    } break;
+    default: { CPPUNIT_ASSERT(false); };
+    }
+  }
+  CPPUNIT_ASSERT(num_add == 1);
+  CPPUNIT_ASSERT(num_modify == 1);
+  CPPUNIT_ASSERT(num_delete == 1);
+  CPPUNIT_ASSERT(table.size() == 3);
+}
+
+void cofflowtabletest::testReconcileExpired() {
+  cofflowtable table(rofl::openflow13::OFP_VERSION);
+
+  cofflowmod fe = flowmod(OFPFC_ADD, 100, 80, 1);
+  fe.set_idle_timeout(30);
+  table.flow_mod(fe);
+
+  std::vector<cofflowmod> delta;
+  table.reconcile_begin();
+  table.reconcile_add(cofflowstatsarray(rofl::openflow13::OFP_VERSION));
+  CPPUNIT_ASSERT(table.reconcile_end(delta) == 0);
+  CPPUNIT_ASSERT(table.size() == 0);
+
+  /* aborted reconciliation keeps all entries */
+  table.flow_mod(flowmod(OFPFC_ADD, 100, 80, 1));
+  table.reconcile_begin();
+  table.reconcile_abort();
+  CPPUNIT_ASSERT(table.reconcile_end(delta) == 0);
+  CPPUNIT_ASSERT(table.size() == 1);
+}
+
+void cofflowtabletest::testReconcileNormalized() {
+  cofflowtable table(rofl::openflow13::OFP_VERSION);
+  rofl::caddress_in4 dst, mask;
+  mask.set_addr_hbo(0xffffff00);
+
+  cofflowmod fe = flowmod(OFPFC_ADD, 100, 80, 1);
+  dst.set_addr_hbo(0x0a000001);
+  fe.set_match().set_ipv4_dst(dst, mask);
+  table.flow_mod(fe);
+
+  /* datapath reports the masked value normalized by its mask */
+  cofflowmod reported = flowmod(OFPFC_ADD, 100, 80, 1);
+  dst.set_addr_hbo(0x0a000000);
+  reported.set_match().set_ipv4_dst(dst, mask);
+  CPPUNIT_ASSERT(table.has_flow(reported.get_table_id(),
+                                reported.get_priority(),
+                                reported.get_match()));
+
+  cofflowstatsarray stats(rofl::openflow13::OFP_VERSION);
+  add_flow_stats(stats, reported);
+
+  std::vector<cofflowmod> delta;
+  table.reconcile_begin();
+  table.reconcile_add(stats);
+  CPPUNIT_ASSERT(table.reconcile_end(delta) == 0);
+  CPPUNIT_ASSERT(delta.empty());
+  CPPUNIT_ASSERT(table.size() == 1);
+}
@@ -0,0 +1,46 @@
+/*
+ * cofflowtabletest.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_OPENFLOW_COFFLOWTABLE_TEST_HPP_
+#define TEST_SRC_ROFL_COMMON_OPENFLOW_COFFLOWTABLE_TEST_HPP_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/openflow/cofflowtable.h"
+
+class cofflowtabletest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(cofflowtabletest);
+  CPPUNIT_TEST(testFlowMod);
+  CPPUNIT_TEST(testFlowModNonStrict);
+  CPPUNIT_TEST(testFlowRemoved);
+  CPPUNIT_TEST(testReconcile);
+  CPPUNIT_TEST(testReconcileExpired);
+  CPPUNIT_TEST(testReconcileNormalized);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void testFlowMod();
+  void testFlowModNonStrict();
+  void testFlowRemoved();
+  void testReconcile();
+  void testReconcileExpired();
+  void testReconcileNormalized();
+
+private:
+  rofl::openflow::cofflowmod flowmod(uint8_t command, uint16_t priority,
+                                     uint16_t tcp_dst, uint32_t port_no);
+
+  void add_flow_stats(rofl::openflow::cofflowstatsarray &stats,
+                      const rofl::openflow::cofflowmod &fe);
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_OPENFLOW_COFFLOWTABLE_TEST_HPP_ */
@@ -5,12 +5,15 @@
  *      Author: andi
  */
 
+#include <set>
 #include <stdlib.h>
+#include <unordered_map>
 
 #include <cppunit/extensions/TestFactoryRegistry.h>
 #include <cppunit/ui/text/TestRunner.h>
 
 #include "coxmatchestest.hpp"
+#include "rofl/common/openflow/cofmatch.h"
 
 using namespace rofl::openflow;
 
@@ -430,3 +433,295 @@ void coxmatchestest::testExp() {
   CPPUNIT_ASSERT(clone.get_exp_match(exp_id, oxm_id2).get_value() == u17value);
   CPPUNIT_ASSERT(clone.get_exp_match(exp_id, oxm_id2).get_mask() == u17mask);
 }
+
+void coxmatchestest::testHash() {
+  rofl::openflow::coxmatches a, b;
+
+  /* insertion order does not matter */
+  a.add_ofb_eth_type(0x0800);
+  a.add_ofb_ipv4_dst(rofl::caddress_in4("10.1.1.1"));
+  b.add_ofb_ipv4_dst(rofl::caddress_in4("10.1.1.1"));
+  b.add_ofb_eth_type(0x0800);
+  CPPUNIT_ASSERT(a == b);
+  CPPUNIT_ASSERT(a.hash() == b.hash());
+  CPPUNIT_ASSERT(a.compare(b) == 0);
+
+  /* mask of all ones equals no mask */
+  b.add_ofb_ipv4_dst(rofl::caddress_in4("10.1.1.1"),
+                     rofl::caddress_in4("255.255.255.255"));
+  CPPUNIT_ASSERT(a.hash() == b.hash());
+  CPPUNIT_ASSERT(a.compare(b) == 0);
+
+  /* masked values are normalized by their mask */
+  a.add_ofb_ipv4_dst(rofl::caddress_in4("10.1.1.1"),
+                     rofl::caddress_in4("255.255.255.0"));
+  b.add_ofb_ipv4_dst(rofl::caddress_in4("10.1.1.0"),
+                     rofl::caddress_in4("255.255.255.0"));
+  CPPUNIT_ASSERT(a.hash() == b.hash());
+  CPPUNIT_ASSERT(a.compare(b) == 0);
+
+  /* mask of all zeros equals a missing field */
+  b.add_ofb_ipv4_src(rofl::caddress_in4("10.2.2.2"),
+                     rofl::caddress_in4("0.0.0.0"));
+  CPPUNIT_ASSERT(a.hash() == b.hash());
+  CPPUNIT_ASSERT(a.compare(b) == 0);
+
+  /* different values, masks and fields */
+  b.add_ofb_ipv4_dst(rofl::caddress_in4("10.1.2.0"),
+                     rofl::caddress_in4("255.255.255.0"));
+  CPPUNIT_ASSERT(a.hash() != b.hash());
+  b.add_ofb_ipv4_dst(rofl::caddress_in4("10.1.0.0"),
+                     rofl::caddress_in4("255.255.0.0"));
+  CPPUNIT_ASSERT(a.hash() != b.hash());
+  b.add_ofb_ipv4_dst(rofl::caddress_in4("10.1.1.0"),
+                     rofl::caddress_in4("255.255.255.0"));
+  b.add_ofb_ip_proto(6);
+  CPPUNIT_ASSERT(a.hash() != b.hash());
+
+  /* unordered containers keyed by matches */
+  std::unordered_map<rofl::openflow::coxmatches, int> oxmap;
+  oxmap[a] = 1;
+  oxmap[b] = 2;
+  CPPUNIT_ASSERT(oxmap.size() == 2);
+  CPPUNIT_ASSERT(oxmap[a] == 1);
+
+  rofl::openflow::cofmatch ma(rofl::openflow13::OFP_VERSION);
+  rofl::openflow::cofmatch mb(rofl::openflow13::OFP_VERSION);
+  ma.set_matches() = a;
+  mb.set_matches() = a;
+  std::unordered_map<rofl::openflow::cofmatch, int> matchmap;
+  matchmap[ma] = 1;
+  matchmap[mb] = 2;
+  CPPUNIT_ASSERT(matchmap.size() == 1);
+  CPPUNIT_ASSERT(matchmap[ma] == 2);
+  mb.set_version(rofl::openflow12::OFP_VERSION);
+  CPPUNIT_ASSERT(std::hash<rofl::openflow::cofmatch>()(ma) !=
+                 std::hash<rofl::openflow::cofmatch>()(mb));
+}
+
+void coxmatchestest::testEquality() {
+  rofl::openflow::coxmatches a, b;
+
+  /* same field, different values */
+  a.add_ofb_ipv4_dst(rofl::caddress_in4("10.1.1.1"));
+  b.add_ofb_ipv4_dst(rofl::caddress_in4("10.1.1.2"));
+  CPPUNIT_ASSERT(not(a == b));
+  CPPUNIT_ASSERT(a.compare(b) != 0);
+
+  rofl::openflow::cofmatch ma(rofl::openflow13::OFP_VERSION);
+  rofl::openflow::cofmatch mb(rofl::openflow13::OFP_VERSION);
+  ma.set_matches() = a;
+  mb.set_matches() = b;
+  CPPUNIT_ASSERT(not(ma == mb));
+
+  std::unordered_map<rofl::openflow::cofmatch, int> matchmap;
+  matchmap[ma] = 1;
+  matchmap[mb] = 2;
+  CPPUNIT_ASSERT(matchmap.size() == 2);
+  CPPUNIT_ASSERT(matchmap[ma] == 1);
+  CPPUNIT_ASSERT(matchmap[mb] == 2);
+
+  /* operator== agrees with compare() on normalized masks */
+  b.add_ofb_ipv4_dst(rofl::caddress_in4("10.1.1.1"),
+                     rofl::caddress_in4("255.255.255.255"));
+  CPPUNIT_ASSERT(a == b);
+  CPPUNIT_ASSERT(a.hash() == b.hash());
+}
+
+void coxmatchestest::testOrdering() {
+  rofl::openflow::coxmatches empty, eth, ip, ipmasked, tcp;
+
+  eth.add_ofb_eth_type(0x0800);
+  ip = eth;
+  ip.add_ofb_ipv4_dst(rofl::caddress_in4("10.1.1.1"));
+  ipmasked = eth;
+  ipmasked.add_ofb_ipv4_dst(rofl::caddress_in4("10.1.1.1"),
+                            rofl::caddress_in4("255.255.0.0"));
+  tcp = ip;
+  tcp.add_ofb_ip_proto(6);
+
+  std::vector<rofl::openflow::coxmatches *> all = {&empty, &eth, &ip,
+                                                   &ipmasked, &tcp};
+  for (auto l : all) {
+    CPPUNIT_ASSERT(not(*l < *l));
+    for (auto r : all) {
+      if (l == r)
+        continue;
+      /* exactly one ordering for distinct lists */
+      CPPUNIT_ASSERT((*l < *r) != (*r < *l));
+      CPPUNIT_ASSERT((l->compare(*r) < 0) == (r->compare(*l) > 0));
+    }
+  }
+  CPPUNIT_ASSERT(empty < eth);
+  CPPUNIT_ASSERT(eth < ip);
+
+  std::set<rofl::openflow::coxmatches> oxset;
+  for (auto m : all) {
+    oxset.insert(*m);
+  }
+  /* equivalent to ipmasked after normalization */
+  rofl::openflow::coxmatches ipnorm(eth);
+  ipnorm.add_ofb_ipv4_dst(rofl::caddress_in4("10.1.0.0"),
+                          rofl::caddress_in4("255.255.0.0"));
+  oxset.insert(ipnorm);
+  CPPUNIT_ASSERT(oxset.size() == all.size());
+  CPPUNIT_ASSERT(oxset.find(ipnorm) != oxset.end());
+}
+
+void coxmatchestest::testFieldTable() {
+  using rofl::openflow::coxmatch_fields;
+
+  for (unsigned field = 0; field < rofl::openflow::OFPXMT_OFB_MAX; field++) {
+    const rofl::openflow::coxmatch_field &entry =
+        coxmatch_fields::fields[field];
+
+    for (unsigned hasmask = 0; hasmask < 2; hasmask++) {
+      if (hasmask && (not entry.maskable)) {
+        continue;
+      }
+      uint32_t oxm_id = entry.oxm_id;
+      if (hasmask) {
+        oxm_id = (oxm_id & 0xffffff00) | HAS_MASK_FLAG | (2 * entry.width);
+      }
+      CPPUNIT_ASSERT(coxmatch_fields::is_known(oxm_id));
+      CPPUNIT_ASSERT(coxmatch_fields::valid_length(oxm_id));
+      CPPUNIT_ASSERT(coxmatch_fields::valid_mask(oxm_id));
+
+      rofl::cmemory tlv(4 + (oxm_id & 0xff));
+      *(uint32_t *)tlv.somem() = htobe32(oxm_id);
+      for (unsigned i = 4; i < tlv.length(); i++) {
+        tlv[i] = 0x11 * (i % 15 + 1);
+      }
+
+      rofl::openflow::coxmatches matches;
+      matches.unpack(tlv.somem(), tlv.length());
+
+      CPPUNIT_ASSERT(matches.get_matches().size() == 1);
+      CPPUNIT_ASSERT(matches.get_matches().begin()->first ==
+                     OXM_ROFL_OFB_TYPE(entry.oxm_id));
+      CPPUNIT_ASSERT(matches.get_matches().begin()->second->get_oxm_id() ==
+                     oxm_id);
+      CPPUNIT_ASSERT(matches.length() == tlv.length());
+
+      rofl::cmemory packed(matches.length());
+      matches.pack(packed.somem(), packed.length());
+      CPPUNIT_ASSERT(packed == tlv);
+    }
+  }
+
+  CPPUNIT_ASSERT(not coxmatch_fields::is_known(
+      (rofl::openflow::OFPXMC_OPENFLOW_BASIC << 16) |
+      (rofl::openflow::OFPXMT_OFB_MAX << 9) | 4));
+  CPPUNIT_ASSERT(not coxmatch_fields::is_known(
+      (rofl::openflow::OFPXMC_EXPERIMENTER << 16) | 4));
+}
+
+void coxmatchestest::testUnPackInvalid() {
+  rofl::openflow::coxmatches matches;
+
+  // ETH_TYPE with oxm_length 4
+  rofl::cmemory badlen(8);
+  badlen[0] = 0x80;
+  badlen[1] = 0x00;
+  badlen[2] = 0x0a; // (ETH_TYPE == 5) << 1, has-mask == 0
+  badlen[3] = 0x04;
+  try {
+    matches.unpack(badlen.somem(), badlen.memlen());
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadMatchBadLen &e) {
+  }
+
+  // IN_PORT with mask
+  rofl::cmemory badmask(12);
+  badmask[0] = 0x80;
+  badmask[1] = 0x00;
+  badmask[2] = 0x01; // (IN_PORT == 0) << 1, has-mask == 1
+  badmask[3] = 0x08;
+  try {
+    matches.unpack(badmask.somem(), badmask.memlen());
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadMatchBadMask &e) {
+  }
+
+  // unknown basic class field is skipped
+  rofl::cmemory unknown(12);
+  unknown[0] = 0x80;
+  unknown[1] = 0x00;
+  unknown[2] = 0x7e; // (63) << 1, has-mask == 0
+  unknown[3] = 0x02;
+  unknown[6] = 0x80;
+  unknown[7] = 0x00;
+  unknown[8] = 0x0a; // (ETH_TYPE == 5) << 1, has-mask == 0
+  unknown[9] = 0x02;
+  unknown[10] = 0x08;
+  unknown[11] = 0x00;
+  matches.unpack(unknown.somem(), unknown.memlen());
+  CPPUNIT_ASSERT(matches.get_matches().size() == 1);
+  CPPUNIT_ASSERT(matches.get_ofb_eth_type().get_u16value() == 0x0800);
+}
+
+void coxmatchestest::testPrerequisites() {
+  rofl::openflow::coxmatches matches;
+
+  matches.add_ofb_tcp_dst(80);
+  try {
+    matches.check_prerequisites();
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadMatchBadPrereq &e) {
+    CPPUNIT_ASSERT(e.get_key("field") == "TCP-DST");
+    CPPUNIT_ASSERT(e.get_key("prereq") == "IP-PROTO");
+  }
+
+  matches.add_ofb_ip_proto(17);
+  try {
+    matches.check_prerequisites();
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadMatchBadPrereq &e) {
+  }
+
+  matches.add_ofb_ip_proto(6);
+  try {
+    matches.check_prerequisites();
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadMatchBadPrereq &e) {
+  }
+
+  matches.add_ofb_eth_type(0x86dd);
+  matches.check_prerequisites();
+
+  matches.drop_ofb_tcp_dst();
+  matches.add_ofb_ip_proto(58);
+  matches.add_ofb_ipv6_nd_target(rofl::caddress_in6("fe80::1"));
+  matches.add_ofb_icmpv6_type(1);
+  try {
+    matches.check_prerequisites();
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadMatchBadPrereq &e) {
+  }
+  matches.add_ofb_icmpv6_type(136);
+  matches.check_prerequisites();
+
+  matches.add_ofb_vlan_pcp(3);
+  try {
+    matches.check_prerequisites();
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadMatchBadPrereq &e) {
+  }
+  matches.add_ofb_vlan_vid(rofl::openflow::OFPVID_NONE);
+  try {
+    matches.check_prerequisites();
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadMatchBadPrereq &e) {
+  }
+  matches.add_ofb_vlan_vid(rofl::openflow::OFPVID_PRESENT | 10);
+  matches.check_prerequisites();
+
+  matches.add_ofb_in_phy_port(1);
+  try {
+    matches.check_prerequisites();
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadMatchBadPrereq &e) {
+  }
+  matches.add_ofb_in_port(1);
+  matches.check_prerequisites();
+}
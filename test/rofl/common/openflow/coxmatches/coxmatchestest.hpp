@@ -27,6 +27,12 @@ class coxmatchestest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testNonStrictMatching);
   CPPUNIT_TEST(testOxmVlanVidUnpack);
   CPPUNIT_TEST(testExp);
+  CPPUNIT_TEST(testHash);
+  CPPUNIT_TEST(testEquality);
+  CPPUNIT_TEST(testOrdering);
+  CPPUNIT_TEST(testFieldTable);
+  CPPUNIT_TEST(testUnPackInvalid);
+  CPPUNIT_TEST(testPrerequisites);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -47,6 +53,15 @@ public:
   void testOxmVlanVidUnpack();
 
   void testExp();
+
+  void testHash();
+  void testEquality();
+
+  void testOrdering();
+
+  void testFieldTable();
+  void testUnPackInvalid();
+  void testPrerequisites();
 };
 
 #endif /* TEST_SRC_ROFL_COMMON_OPENFLOW_COXMATCH_TEST_HPP_ */
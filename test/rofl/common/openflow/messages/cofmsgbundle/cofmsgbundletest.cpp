@@ -0,0 +1,326 @@
+/*
+ * cofmsgbundletest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#include <stdlib.h>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "cofmsgbundletest.hpp"
+
+using namespace rofl::openflow;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(cofmsgbundletest);
+
+void cofmsgbundletest::setUp() {}
+
+void cofmsgbundletest::tearDown() {}
+
+void cofmsgbundletest::testControl14() {
+  uint8_t version = rofl::openflow14::OFP_VERSION;
+  uint32_t xid = 0xa1a2a3a4;
+  rofl::cmemory props(8);
+  props[0] = 0xff;
+  props[3] = 0x08;
+
+  rofl::openflow::cofmsg_bundle_control msg1(
+      version, xid, 0xb1b2b3b4, rofl::openflow14::OFPBCT_COMMIT_REQUEST,
+      rofl::openflow14::OFPBF_ATOMIC | rofl::openflow14::OFPBF_ORDERED, props);
+  rofl::openflow::cofmsg_bundle_control msg2;
+  rofl::cmemory mem(msg1.length());
+
+  try {
+    msg1.pack(mem.somem(), mem.length());
+    msg2.unpack(mem.somem(), mem.length());
+
+    CPPUNIT_ASSERT(msg2.get_version() == version);
+    CPPUNIT_ASSERT(msg2.get_type() == rofl::openflow14::OFPT_BUNDLE_CONTROL);
+    CPPUNIT_ASSERT(msg2.get_length() == msg1.length());
+    CPPUNIT_ASSERT(msg2.get_length() ==
+                   sizeof(struct rofl::openflow14::ofp_bundle_ctrl_msg) + 8);
+    CPPUNIT_ASSERT(msg2.get_xid() == xid);
+    CPPUNIT_ASSERT(msg2.get_bundle_id() == 0xb1b2b3b4);
+    CPPUNIT_ASSERT(msg2.get_ctrl_type() ==
+                   rofl::openflow14::OFPBCT_COMMIT_REQUEST);
+    CPPUNIT_ASSERT(msg2.get_flags() == (rofl::openflow14::OFPBF_ATOMIC |
+                                        rofl::openflow14::OFPBF_ORDERED));
+    CPPUNIT_ASSERT(msg2.get_properties() == props);
+
+  } catch (...) {
+    std::cerr << ">>> request <<<" << std::endl << msg1;
+    std::cerr << ">>> memory <<<" << std::endl << mem;
+    std::cerr << ">>> clone <<<" << std::endl << msg2;
+    throw;
+  }
+
+  /* no support for bundles before OpenFlow 1.4 */
+  try {
+    rofl::openflow::cofmsg_bundle_control msg(rofl::openflow13::OFP_VERSION);
+    msg.length();
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadVersion &e) {
+  }
+}
+
+void cofmsgbundletest::testAddMessage14() {
+  uint8_t version = rofl::openflow14::OFP_VERSION;
+  uint32_t xid = 0xa1a2a3a4;
+
+  rofl::openflow::cofflowmod flowmod(rofl::openflow13::OFP_VERSION);
+  flowmod.set_priority(0x1234);
+  flowmod.set_match().set_eth_type(0x0800);
+  flowmod.set_instructions().add_inst_goto_table().set_table_id(1);
+  rofl::openflow::cofmsg_flow_mod fmsg(rofl::openflow13::OFP_VERSION, 0,
+                                       flowmod);
+
+  rofl::cmemory props(8);
+  props[0] = 0xff;
+  props[3] = 0x08;
+
+  rofl::openflow::cofmsg_bundle_add_message msg1(
+      version, xid, 0xb1b2b3b4, rofl::openflow14::OFPBF_ATOMIC);
+  msg1.set_message(fmsg);
+  msg1.set_properties() = props;
+  rofl::openflow::cofmsg_bundle_add_message msg2;
+  rofl::cmemory mem(msg1.length());
+
+  try {
+    msg1.pack(mem.somem(), mem.length());
+    msg2.unpack(mem.somem(), mem.length());
+
+    size_t msglen =
+        offsetof(struct rofl::openflow14::ofp_bundle_add_msg, message) +
+        fmsg.length();
+
+    CPPUNIT_ASSERT(msg2.get_version() == version);
+    CPPUNIT_ASSERT(msg2.get_type() ==
+                   rofl::openflow14::OFPT_BUNDLE_ADD_MESSAGE);
+    CPPUNIT_ASSERT(msg2.get_length() == msg1.length());
+    CPPUNIT_ASSERT(msg2.get_length() == ((msglen + 7) / 8) * 8 + 8);
+    CPPUNIT_ASSERT(msg2.get_xid() == xid);
+    CPPUNIT_ASSERT(msg2.get_bundle_id() == 0xb1b2b3b4);
+    CPPUNIT_ASSERT(msg2.get_flags() == rofl::openflow14::OFPBF_ATOMIC);
+    CPPUNIT_ASSERT(msg2.get_message().length() == fmsg.length());
+    CPPUNIT_ASSERT(msg2.get_message_type() == rofl::openflow::OFPT_FLOW_MOD);
+    CPPUNIT_ASSERT(msg2.get_properties() == props);
+
+    /* inner message carries the outer xid */
+    rofl::openflow::cofmsg_flow_mod fmsg2;
+    fmsg2.unpack(msg2.get_message().somem(), msg2.get_message().length());
+    CPPUNIT_ASSERT(fmsg2.get_xid() == xid);
+    CPPUNIT_ASSERT(fmsg2.get_flowmod().get_priority() == 0x1234);
+
+  } catch (...) {
+    std::cerr << ">>> request <<<" << std::endl << msg1;
+    std::cerr << ">>> memory <<<" << std::endl << mem;
+    std::cerr << ">>> clone <<<" << std::endl << msg2;
+    throw;
+  }
+}
+
+void cofmsgbundletest::testControlParser14() {
+  size_t msglen = sizeof(struct rofl::openflow14::ofp_bundle_ctrl_msg);
+  size_t memlen = 2 * msglen /*test overhead*/;
+
+  rofl::cmemory mem(memlen);
+  struct rofl::openflow14::ofp_bundle_ctrl_msg *hdr =
+      (struct rofl::openflow14::ofp_bundle_ctrl_msg *)(mem.somem());
+
+  hdr->header.version = rofl::openflow14::OFP_VERSION;
+  hdr->header.type = rofl::openflow14::OFPT_BUNDLE_CONTROL;
+  hdr->header.xid = htobe32(0xa1a2a3a4);
+
+  for (unsigned int i = 1; i < msglen; i++) {
+    rofl::openflow::cofmsg_bundle_control msg;
+    try {
+      hdr->header.length = htobe16(i);
+      msg.unpack(mem.somem(), i);
+
+      std::cerr << ">>> testing length values (len: " << i << ") <<< "
+                << std::endl;
+      std::cerr << "[FAILURE] unpack() no exception seen" << std::endl;
+      std::cerr << ">>> memory <<<" << std::endl << mem;
+
+      /* unpack() Must yield an axception */
+      CPPUNIT_ASSERT(false);
+
+    } catch (rofl::eBadRequestBadLen &e) {
+      CPPUNIT_ASSERT(i < msglen);
+    }
+  }
+
+  for (unsigned int i = msglen; i <= memlen; i++) {
+    rofl::openflow::cofmsg_bundle_control msg;
+    try {
+      hdr->header.length = htobe16(i);
+      msg.unpack(mem.somem(), i);
+      CPPUNIT_ASSERT(msg.get_properties().length() == (i - msglen));
+
+    } catch (rofl::eBadRequestBadLen &e) {
+      std::cerr << ">>> testing length values (len: " << i << ") <<< "
+                << std::endl;
+      std::cerr << "[FAILURE] unpack() exception seen" << std::endl;
+      std::cerr << ">>> memory <<<" << std::endl << mem;
+
+      CPPUNIT_ASSERT(false);
+    }
+  }
+
+  /* bundles in OpenFlow 1.3 are rejected */
+  try {
+    rofl::openflow::cofmsg_bundle_control msg;
+    hdr->header.version = rofl::openflow13::OFP_VERSION;
+    hdr->header.length = htobe16(msglen);
+    msg.unpack(mem.somem(), msglen);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadRequestBadVersion &e) {
+  }
+}
+
+void cofmsgbundletest::testAddMessageParser14() {
+  size_t msglen = sizeof(struct rofl::openflow14::ofp_bundle_add_msg);
+  size_t memlen = 2 * msglen /*test overhead*/;
+
+  rofl::cmemory mem(memlen);
+  struct rofl::openflow14::ofp_bundle_add_msg *hdr =
+      (struct rofl::openflow14::ofp_bundle_add_msg *)(mem.somem());
+
+  hdr->header.version = rofl::openflow14::OFP_VERSION;
+  hdr->header.type = rofl::openflow14::OFPT_BUNDLE_ADD_MESSAGE;
+  hdr->header.xid = htobe32(0xa1a2a3a4);
+  hdr->message.version = rofl::openflow14::OFP_VERSION;
+  hdr->message.type = rofl::openflow14::OFPT_BARRIER_REQUEST;
+  hdr->message.length = htobe16(sizeof(struct rofl::openflow::ofp_header));
+  hdr->message.xid = htobe32(0xa1a2a3a4);
+
+  for (unsigned int i = 1; i < msglen; i++) {
+    rofl::openflow::cofmsg_bundle_add_message msg;
+    try {
+      hdr->header.length = htobe16(i);
+      msg.unpack(mem.somem(), i);
+
+      std::cerr << ">>> testing length values (len: " << i << ") <<< "
+                << std::endl;
+      std::cerr << "[FAILURE] unpack() no exception seen" << std::endl;
+      std::cerr << ">>> memory <<<" << std::endl << mem;
+
+      /* unpack() Must yield an axception */
+      CPPUNIT_ASSERT(false);
+
+    } catch (rofl::eBadRequestBadLen &e) {
+      CPPUNIT_ASSERT(i < msglen);
+    }
+  }
+
+  for (unsigned int i = msglen; i <= memlen; i++) {
+    rofl::openflow::cofmsg_bundle_add_message msg;
+    try {
+      hdr->header.length = htobe16(i);
+      msg.unpack(mem.somem(), i);
+      CPPUNIT_ASSERT(msg.get_message_type() ==
+                     rofl::openflow14::OFPT_BARRIER_REQUEST);
+      CPPUNIT_ASSERT(msg.get_properties().length() == (i - msglen));
+
+    } catch (rofl::eBadRequestBadLen &e) {
+      std::cerr << ">>> testing length values (len: " << i << ") <<< "
+                << std::endl;
+      std::cerr << "[FAILURE] unpack() exception seen" << std::endl;
+      std::cerr << ">>> memory <<<" << std::endl << mem;
+
+      CPPUNIT_ASSERT(false);
+    }
+  }
+
+  /* inner message exceeding the outer message */
+  try {
+    rofl::openflow::cofmsg_bundle_add_message msg;
+    hdr->header.length = htobe16(msglen);
+    hdr->message.length = htobe16(sizeof(struct rofl::openflow::ofp_header) +
+                                  1);
+    msg.unpack(mem.somem(), msglen);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadRequestBadLen &e) {
+  }
+}
+
+void cofmsgbundletest::testBundle14() {
+  const unsigned int num = 16;
+  rofl::openflow::cofbundle bundle(rofl::openflow14::OFP_VERSION, 0xb1b2b3b4);
+
+  CPPUNIT_ASSERT(bundle.empty());
+
+  for (unsigned int i = 0; i < num; i++) {
+    rofl::openflow::cofflowmod flowmod(rofl::openflow13::OFP_VERSION);
+    flowmod.set_priority(0x1000 + i);
+    flowmod.set_match().set_eth_type(0x0800);
+    flowmod.set_instructions().add_inst_goto_table().set_table_id(1);
+    bundle.add_flow_mod(flowmod);
+  }
+
+  rofl::openflow::cofgroupmod groupmod(rofl::openflow13::OFP_VERSION);
+  groupmod.set_command(rofl::openflow13::OFPGC_ADD);
+  groupmod.set_type(rofl::openflow13::OFPGT_ALL);
+  groupmod.set_group_id(7);
+  bundle.add_group_mod(groupmod);
+
+  bundle.add_meter_mod(rofl::openflow13::OFPMC_ADD,
+                       rofl::openflow13::OFPMF_KBPS, 3,
+                       rofl::openflow::cofmeter_bands());
+
+  CPPUNIT_ASSERT(bundle.size() == num + 2);
+
+  /* rewrite bundle id and flags in all stored messages */
+  bundle.set_bundle_id(0xc1c2c3c4);
+  bundle.set_flags(rofl::openflow14::OFPBF_ORDERED);
+
+  size_t offset = 0;
+  uint32_t xid = 0xa1a2a3a4;
+  for (unsigned int i = 0; i < bundle.size(); i++, xid++) {
+    rofl::cmemory mem(65535);
+    size_t msglen = bundle.copy_message(offset, mem.somem(), mem.length(), xid);
+
+    rofl::openflow::cofmsg_bundle_add_message msg;
+    msg.unpack(mem.somem(), msglen);
+
+    CPPUNIT_ASSERT(msg.get_xid() == xid);
+    CPPUNIT_ASSERT(msg.get_bundle_id() == 0xc1c2c3c4);
+    CPPUNIT_ASSERT(msg.get_flags() == rofl::openflow14::OFPBF_ORDERED);
+
+    /* inner message uses the bundle's version and xid */
+    struct rofl::openflow::ofp_header *hdr =
+        (struct rofl::openflow::ofp_header *)msg.get_message().somem();
+    CPPUNIT_ASSERT(hdr->version == rofl::openflow14::OFP_VERSION);
+    CPPUNIT_ASSERT(be32toh(hdr->xid) == xid);
+
+    if (i < num) {
+      CPPUNIT_ASSERT(msg.get_message_type() == rofl::openflow::OFPT_FLOW_MOD);
+      /* decode inner flow-mod in its 1.3 encoding */
+      rofl::cmemory inner(msg.get_message());
+      inner[0] = rofl::openflow13::OFP_VERSION;
+      rofl::openflow::cofmsg_flow_mod fmsg;
+      fmsg.unpack(inner.somem(), inner.length());
+      CPPUNIT_ASSERT(fmsg.get_flowmod().get_priority() == 0x1000 + i);
+    } else if (i == num) {
+      CPPUNIT_ASSERT(msg.get_message_type() ==
+                     rofl::openflow13::OFPT_GROUP_MOD);
+    } else {
+      CPPUNIT_ASSERT(msg.get_message_type() ==
+                     rofl::openflow13::OFPT_METER_MOD);
+    }
+
+    offset += msglen;
+  }
+  CPPUNIT_ASSERT(offset == bundle.length());
+
+  rofl::openflow::cofbundle copy(bundle);
+  CPPUNIT_ASSERT(copy.size() == bundle.size());
+  CPPUNIT_ASSERT(copy.length() == bundle.length());
+
+  bundle.clear();
+  CPPUNIT_ASSERT(bundle.empty());
+  CPPUNIT_ASSERT(bundle.length() == 0);
+}
@@ -0,0 +1,40 @@
+/*
+ * cofmsgbundletest.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGBUNDLE_TEST_HPP_
+#define TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGBUNDLE_TEST_HPP_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/cmemory.h"
+#include "rofl/common/openflow/cofbundle.h"
+#include "rofl/common/openflow/messages/cofmsg_bundle.h"
+#include "rofl/common/openflow/messages/cofmsg_flow_mod.h"
+
+class cofmsgbundletest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(cofmsgbundletest);
+  CPPUNIT_TEST(testControl14);
+  CPPUNIT_TEST(testAddMessage14);
+  CPPUNIT_TEST(testControlParser14);
+  CPPUNIT_TEST(testAddMessageParser14);
+  CPPUNIT_TEST(testBundle14);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void testControl14();
+  void testAddMessage14();
+  void testControlParser14();
+  void testAddMessageParser14();
+  void testBundle14();
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGBUNDLE_TEST_HPP_ */
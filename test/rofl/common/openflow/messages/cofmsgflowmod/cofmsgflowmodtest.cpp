@@ -35,6 +35,11 @@ void cofmsgflowmodtest::testFlowMod13() {
               0xa1a2a3a4);
 }
 
+void cofmsgflowmodtest::testFlowMod14() {
+  testFlowMod(rofl::openflow14::OFP_VERSION, rofl::openflow14::OFPT_FLOW_MOD,
+              0xa1a2a3a4);
+}
+
 void cofmsgflowmodtest::testFlowMod(uint8_t version, uint8_t type,
                                     uint32_t xid) {
   rofl::openflow::cofflowmod flowmod(version);
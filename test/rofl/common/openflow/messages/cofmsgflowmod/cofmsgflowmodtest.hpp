@@ -19,6 +19,7 @@ class cofmsgflowmodtest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testFlowMod10);
   CPPUNIT_TEST(testFlowMod12);
   CPPUNIT_TEST(testFlowMod13);
+  CPPUNIT_TEST(testFlowMod14);
   CPPUNIT_TEST(testFlowModParser10);
   CPPUNIT_TEST(testFlowModParser12);
   CPPUNIT_TEST(testFlowModParser13);
@@ -32,6 +33,7 @@ public:
   void testFlowMod10();
   void testFlowMod12();
   void testFlowMod13();
+  void testFlowMod14();
   void testFlowModParser10();
   void testFlowModParser12();
   void testFlowModParser13();
@@ -0,0 +1,210 @@
+/*
+ * cofmsgflowmonitortest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#include <stdlib.h>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "cofmsgflowmonitortest.hpp"
+
+using namespace rofl::openflow;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(cofmsgflowmonitortest);
+
+void cofmsgflowmonitortest::setUp() {}
+
+void cofmsgflowmonitortest::tearDown() {}
+
+void cofmsgflowmonitortest::testRequest14() {
+  uint8_t version = rofl::openflow14::OFP_VERSION;
+  uint32_t xid = 0xa1a2a3a4;
+
+  rofl::openflow::cofflowmonitorarray monitors(version);
+  monitors.add_flow_monitor(0)
+      .set_monitor_id(0xb1b2b3b4)
+      .set_command(rofl::openflow14::OFPFMC_ADD)
+      .set_flags(rofl::openflow14::OFPFMF_ADD |
+                 rofl::openflow14::OFPFMF_REMOVED)
+      .set_table_id(3)
+      .set_out_port(0xc1c2c3c4)
+      .set_out_group(0xd1d2d3d4)
+      .set_match()
+      .set_eth_type(0x0800);
+  monitors.add_flow_monitor(1)
+      .set_monitor_id(0xe1e2e3e4)
+      .set_command(rofl::openflow14::OFPFMC_DELETE);
+
+  rofl::openflow::cofmsg_flow_monitor_request msg1(version, xid, 0, monitors);
+  rofl::openflow::cofmsg_flow_monitor_request msg2;
+  rofl::cmemory mem(msg1.length());
+
+  try {
+    msg1.pack(mem.somem(), mem.length());
+    msg2.unpack(mem.somem(), mem.length());
+
+    /* eth_type requires 16 bytes of ofp_match incl. padding */
+    CPPUNIT_ASSERT(msg1.length() ==
+                   sizeof(struct rofl::openflow13::ofp_multipart_request) +
+                       (24 + 8) + 24);
+    CPPUNIT_ASSERT(msg2.get_version() == version);
+    CPPUNIT_ASSERT(msg2.get_type() == rofl::openflow14::OFPT_MULTIPART_REQUEST);
+    CPPUNIT_ASSERT(msg2.get_stats_type() ==
+                   rofl::openflow14::OFPMP_FLOW_MONITOR);
+    CPPUNIT_ASSERT(msg2.get_length() == msg1.length());
+    CPPUNIT_ASSERT(msg2.get_xid() == xid);
+    CPPUNIT_ASSERT(msg2.get_flow_monitors().size() == 2);
+
+    const rofl::openflow::cofflow_monitor_request &mon =
+        msg2.get_flow_monitors().get_flow_monitor(0);
+    CPPUNIT_ASSERT(mon.get_monitor_id() == 0xb1b2b3b4);
+    CPPUNIT_ASSERT(mon.get_command() == rofl::openflow14::OFPFMC_ADD);
+    CPPUNIT_ASSERT(mon.get_flags() == (rofl::openflow14::OFPFMF_ADD |
+                                       rofl::openflow14::OFPFMF_REMOVED));
+    CPPUNIT_ASSERT(mon.get_table_id() == 3);
+    CPPUNIT_ASSERT(mon.get_out_port() == 0xc1c2c3c4);
+    CPPUNIT_ASSERT(mon.get_out_group() == 0xd1d2d3d4);
+    CPPUNIT_ASSERT(mon.get_match().get_eth_type() == 0x0800);
+
+    CPPUNIT_ASSERT(
+        msg2.get_flow_monitors().get_flow_monitor(1).get_monitor_id() ==
+        0xe1e2e3e4);
+    CPPUNIT_ASSERT(msg2.get_flow_monitors().get_flow_monitor(1).get_command() ==
+                   rofl::openflow14::OFPFMC_DELETE);
+
+    rofl::cmemory mem2(msg2.length());
+    msg2.pack(mem2.somem(), mem2.length());
+    CPPUNIT_ASSERT(mem == mem2);
+
+  } catch (...) {
+    std::cerr << ">>> request <<<" << std::endl << msg1;
+    std::cerr << ">>> memory <<<" << std::endl << mem;
+    std::cerr << ">>> clone <<<" << std::endl << msg2;
+    throw;
+  }
+
+  /* no support for flow monitors before OpenFlow 1.4 */
+  try {
+    rofl::openflow::cofflow_monitor_request req(rofl::openflow13::OFP_VERSION);
+    req.length();
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadVersion &e) {
+  }
+}
+
+void cofmsgflowmonitortest::testReply14() {
+  uint8_t version = rofl::openflow14::OFP_VERSION;
+  uint32_t xid = 0xa1a2a3a4;
+
+  rofl::openflow::cofflowupdatearray updates(version);
+
+  rofl::openflow::cofflow_update &added = updates.add_flow_update(0);
+  added.set_event(rofl::openflow14::OFPFME_ADDED)
+      .set_table_id(1)
+      .set_idle_timeout(0x1112)
+      .set_hard_timeout(0x2122)
+      .set_priority(0x3132)
+      .set_cookie(0x4142434445464748ULL);
+  added.set_match().set_eth_type(0x86dd);
+  added.set_instructions().add_inst_goto_table().set_table_id(2);
+
+  rofl::openflow::cofflow_update &removed = updates.add_flow_update(1);
+  removed.set_event(rofl::openflow14::OFPFME_REMOVED)
+      .set_table_id(1)
+      .set_reason(rofl::openflow14::OFPRR_HARD_TIMEOUT)
+      .set_priority(0x3132);
+  removed.set_match().set_eth_type(0x86dd);
+  /* instructions are never sent along with removal events */
+  removed.set_instructions().add_inst_goto_table().set_table_id(2);
+
+  updates.add_flow_update(2)
+      .set_event(rofl::openflow14::OFPFME_ABBREV)
+      .set_xid(0x51525354);
+  updates.add_flow_update(3).set_event(rofl::openflow14::OFPFME_PAUSED);
+
+  rofl::openflow::cofmsg_flow_monitor_reply msg1(version, xid, 0, updates);
+  rofl::openflow::cofmsg_flow_monitor_reply msg2;
+  rofl::cmemory mem(msg1.length());
+
+  try {
+    msg1.pack(mem.somem(), mem.length());
+    msg2.unpack(mem.somem(), mem.length());
+
+    CPPUNIT_ASSERT(msg1.length() ==
+                   sizeof(struct rofl::openflow13::ofp_multipart_reply) +
+                       (32 + 8 + 8) + (32 + 8) + 8 + 8);
+    CPPUNIT_ASSERT(msg2.get_version() == version);
+    CPPUNIT_ASSERT(msg2.get_type() == rofl::openflow14::OFPT_MULTIPART_REPLY);
+    CPPUNIT_ASSERT(msg2.get_stats_type() ==
+                   rofl::openflow14::OFPMP_FLOW_MONITOR);
+    CPPUNIT_ASSERT(msg2.get_length() == msg1.length());
+    CPPUNIT_ASSERT(msg2.get_xid() == xid);
+    CPPUNIT_ASSERT(msg2.get_flow_updates().size() == 4);
+
+    const rofl::openflow::cofflow_update &upd0 =
+        msg2.get_flow_updates().get_flow_update(0);
+    CPPUNIT_ASSERT(upd0.get_event() == rofl::openflow14::OFPFME_ADDED);
+    CPPUNIT_ASSERT(upd0.get_table_id() == 1);
+    CPPUNIT_ASSERT(upd0.get_idle_timeout() == 0x1112);
+    CPPUNIT_ASSERT(upd0.get_hard_timeout() == 0x2122);
+    CPPUNIT_ASSERT(upd0.get_priority() == 0x3132);
+    CPPUNIT_ASSERT(upd0.get_cookie() == 0x4142434445464748ULL);
+    CPPUNIT_ASSERT(upd0.get_match().get_eth_type() == 0x86dd);
+    CPPUNIT_ASSERT(
+        upd0.get_instructions().get_inst_goto_table().get_table_id() == 2);
+
+    const rofl::openflow::cofflow_update &upd1 =
+        msg2.get_flow_updates().get_flow_update(1);
+    CPPUNIT_ASSERT(upd1.get_event() == rofl::openflow14::OFPFME_REMOVED);
+    CPPUNIT_ASSERT(upd1.get_reason() == rofl::openflow14::OFPRR_HARD_TIMEOUT);
+    CPPUNIT_ASSERT(upd1.get_instructions().length() == 0);
+
+    CPPUNIT_ASSERT(msg2.get_flow_updates().get_flow_update(2).get_event() ==
+                   rofl::openflow14::OFPFME_ABBREV);
+    CPPUNIT_ASSERT(msg2.get_flow_updates().get_flow_update(2).get_xid() ==
+                   0x51525354);
+    CPPUNIT_ASSERT(msg2.get_flow_updates().get_flow_update(3).get_event() ==
+                   rofl::openflow14::OFPFME_PAUSED);
+
+    rofl::cmemory mem2(msg2.length());
+    msg2.pack(mem2.somem(), mem2.length());
+    CPPUNIT_ASSERT(mem == mem2);
+
+  } catch (...) {
+    std::cerr << ">>> reply <<<" << std::endl << msg1;
+    std::cerr << ">>> memory <<<" << std::endl << mem;
+    std::cerr << ">>> clone <<<" << std::endl << msg2;
+    throw;
+  }
+}
+
+void cofmsgflowmonitortest::testReplyBadLen14() {
+  uint8_t version = rofl::openflow14::OFP_VERSION;
+
+  rofl::openflow::cofflowupdatearray updates(version);
+  updates.add_flow_update(0)
+      .set_event(rofl::openflow14::OFPFME_ABBREV)
+      .set_xid(0x51525354);
+
+  rofl::openflow::cofmsg_flow_monitor_reply msg1(version, 0, 0, updates);
+  rofl::cmemory mem(msg1.length());
+  msg1.pack(mem.somem(), mem.length());
+
+  /* update claims to extend beyond the end of the message */
+  struct rofl::openflow14::ofp_flow_update_header *hdr =
+      (struct rofl::openflow14::ofp_flow_update_header
+           *)(mem.somem() +
+              sizeof(struct rofl::openflow13::ofp_multipart_reply));
+  hdr->length = htobe16(16);
+
+  try {
+    rofl::openflow::cofmsg_flow_monitor_reply msg2;
+    msg2.unpack(mem.somem(), mem.length());
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eInvalid &e) {
+  }
+}
@@ -0,0 +1,34 @@
+/*
+ * cofmsgflowmonitortest.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGFLOWMONITOR_TEST_HPP_
+#define TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGFLOWMONITOR_TEST_HPP_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/cmemory.h"
+#include "rofl/common/openflow/messages/cofmsg_flow_monitor.h"
+
+class cofmsgflowmonitortest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(cofmsgflowmonitortest);
+  CPPUNIT_TEST(testRequest14);
+  CPPUNIT_TEST(testReply14);
+  CPPUNIT_TEST(testReplyBadLen14);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void testRequest14();
+  void testReply14();
+  void testReplyBadLen14();
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGFLOWMONITOR_TEST_HPP_ */
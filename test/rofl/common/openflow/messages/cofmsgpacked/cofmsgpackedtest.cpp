@@ -0,0 +1,189 @@
+/*
+ * cofmsgpackedtest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#include <stdlib.h>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "cofmsgpackedtest.hpp"
+
+using namespace rofl::openflow;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(cofmsgpackedtest);
+
+void cofmsgpackedtest::setUp() {}
+
+void cofmsgpackedtest::tearDown() {}
+
+void cofmsgpackedtest::testPacked10() {
+  testPacked(rofl::openflow10::OFP_VERSION, rofl::openflow10::OFPT_FLOW_MOD,
+             0xa1a2a3a4);
+}
+
+void cofmsgpackedtest::testPacked13() {
+  testPacked(rofl::openflow13::OFP_VERSION, rofl::openflow13::OFPT_FLOW_MOD,
+             0xa1a2a3a4);
+}
+
+void cofmsgpackedtest::testPacked(uint8_t version, uint8_t type,
+                                  uint32_t xid) {
+  const unsigned int num = 8;
+  rofl::openflow::cofmsg_packed msg1(version, type, xid);
+  rofl::openflow::cofmsg_packed msg2;
+  rofl::cmemory expected((size_t)0);
+
+  /* pack a sequence of flow-mods into the block and into a reference
+   * buffer via the conventional cofmsg_flow_mod path */
+  for (unsigned int i = 0; i < num; i++) {
+    rofl::openflow::cofflowmod flowmod(version);
+    flowmod.set_priority(0x1000 + i);
+    flowmod.set_match().set_eth_type(0x0800);
+    if (version > rofl::openflow10::OFP_VERSION) {
+      flowmod.set_instructions().add_inst_goto_table().set_table_id(i);
+    }
+    rofl::openflow::cofmsg_flow_mod msg(version, xid + i, flowmod);
+
+    rofl::cmemory mem(msg.length());
+    msg.pack(mem.somem(), mem.length());
+    expected += mem;
+
+    msg.pack(msg1.append(msg.length()), msg.length());
+  }
+
+  CPPUNIT_ASSERT(msg1.get_msgs_num() == num);
+  CPPUNIT_ASSERT(msg1.length() == expected.length());
+
+  rofl::cmemory mem(msg1.length());
+
+  try {
+    msg1.pack(mem.somem(), mem.length());
+
+    CPPUNIT_ASSERT(mem == expected);
+    CPPUNIT_ASSERT(msg1.get_length() == expected.length());
+
+    msg2.unpack(mem.somem(), mem.length());
+
+    CPPUNIT_ASSERT(msg2.get_version() == version);
+    CPPUNIT_ASSERT(msg2.get_type() == type);
+    CPPUNIT_ASSERT(msg2.get_xid() == xid);
+    CPPUNIT_ASSERT(msg2.get_msgs_num() == num);
+    CPPUNIT_ASSERT(msg2.length() == msg1.length());
+
+    /* each contained message must be parseable on its own */
+    size_t offset = 0;
+    for (unsigned int i = 0; i < num; i++) {
+      struct rofl::openflow::ofp_header *hdr =
+          (struct rofl::openflow::ofp_header *)(mem.somem() + offset);
+      rofl::openflow::cofmsg_flow_mod msg;
+      msg.unpack(mem.somem() + offset, be16toh(hdr->length));
+      CPPUNIT_ASSERT(msg.get_xid() == xid + i);
+      CPPUNIT_ASSERT(msg.get_flowmod().get_priority() == 0x1000 + i);
+      offset += be16toh(hdr->length);
+    }
+    CPPUNIT_ASSERT(offset == mem.length());
+
+  } catch (...) {
+    std::cerr << ">>> request <<<" << std::endl << msg1;
+    std::cerr << ">>> memory <<<" << std::endl << mem;
+    std::cerr << ">>> clone <<<" << std::endl << msg2;
+    throw;
+  }
+}
+
+void cofmsgpackedtest::testPackedTailroom() {
+  rofl::openflow::cofmsg_packed msg(rofl::openflow13::OFP_VERSION,
+                                    rofl::openflow13::OFPT_FLOW_MOD, 0, 64);
+
+  CPPUNIT_ASSERT(msg.empty());
+  CPPUNIT_ASSERT(msg.tailroom() == 64);
+
+  msg.append(48);
+  CPPUNIT_ASSERT(msg.tailroom() == 16);
+  CPPUNIT_ASSERT(msg.get_msgs_num() == 1);
+
+  try {
+    msg.append(24);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eInvalid &e) {
+  }
+
+  try {
+    msg.append(4);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eInvalid &e) {
+  }
+
+  msg.append(16);
+  CPPUNIT_ASSERT(msg.tailroom() == 0);
+  CPPUNIT_ASSERT(msg.get_msgs_num() == 2);
+  CPPUNIT_ASSERT(msg.length() == 64);
+
+  rofl::openflow::cofmsg_packed big(rofl::openflow13::OFP_VERSION,
+                                    rofl::openflow13::OFPT_FLOW_MOD, 0,
+                                    1 << 20);
+  CPPUNIT_ASSERT(big.tailroom() == rofl::openflow::cofmsg_packed::MAX_LENGTH);
+}
+
+void cofmsgpackedtest::testPackedParser13() {
+  uint8_t version = rofl::openflow13::OFP_VERSION;
+  uint8_t type = rofl::openflow13::OFPT_BARRIER_REQUEST;
+  size_t hdrlen = sizeof(struct rofl::openflow::ofp_header);
+
+  rofl::cmemory mem(3 * hdrlen);
+  for (unsigned int i = 0; i < 3; i++) {
+    struct rofl::openflow::ofp_header *hdr =
+        (struct rofl::openflow::ofp_header *)(mem.somem() + i * hdrlen);
+    hdr->version = version;
+    hdr->type = type;
+    hdr->length = htobe16(hdrlen);
+    hdr->xid = htobe32(i);
+  }
+
+  {
+    rofl::openflow::cofmsg_packed msg;
+    msg.unpack(mem.somem(), mem.length());
+    CPPUNIT_ASSERT(msg.get_msgs_num() == 3);
+    CPPUNIT_ASSERT(msg.get_type() == type);
+  }
+
+  /* truncated trailing message */
+  for (unsigned int i = 1; i < hdrlen; i++) {
+    rofl::openflow::cofmsg_packed msg;
+    try {
+      msg.unpack(mem.somem(), 2 * hdrlen + i);
+      CPPUNIT_ASSERT(false);
+    } catch (rofl::eBadRequestBadLen &e) {
+    }
+  }
+
+  /* inner length field exceeding the buffer */
+  {
+    struct rofl::openflow::ofp_header *hdr =
+        (struct rofl::openflow::ofp_header *)(mem.somem() + hdrlen);
+    hdr->length = htobe16(3 * hdrlen);
+    rofl::openflow::cofmsg_packed msg;
+    try {
+      msg.unpack(mem.somem(), mem.length());
+      CPPUNIT_ASSERT(false);
+    } catch (rofl::eBadRequestBadLen &e) {
+    }
+  }
+
+  /* inner length field shorter than a header */
+  {
+    struct rofl::openflow::ofp_header *hdr =
+        (struct rofl::openflow::ofp_header *)(mem.somem() + hdrlen);
+    hdr->length = htobe16(hdrlen - 1);
+    rofl::openflow::cofmsg_packed msg;
+    try {
+      msg.unpack(mem.somem(), mem.length());
+      CPPUNIT_ASSERT(false);
+    } catch (rofl::eBadRequestBadLen &e) {
+    }
+  }
+}
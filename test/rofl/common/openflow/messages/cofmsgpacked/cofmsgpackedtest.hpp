@@ -0,0 +1,40 @@
+/*
+ * cofmsgpackedtest.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGPACKED_TEST_HPP_
+#define TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGPACKED_TEST_HPP_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/cmemory.h"
+#include "rofl/common/openflow/messages/cofmsg_flow_mod.h"
+#include "rofl/common/openflow/messages/cofmsg_packed.h"
+
+class cofmsgpackedtest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(cofmsgpackedtest);
+  CPPUNIT_TEST(testPacked10);
+  CPPUNIT_TEST(testPacked13);
+  CPPUNIT_TEST(testPackedTailroom);
+  CPPUNIT_TEST(testPackedParser13);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void testPacked10();
+  void testPacked13();
+  void testPackedTailroom();
+  void testPackedParser13();
+
+private:
+  void testPacked(uint8_t version, uint8_t type, uint32_t xid);
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGPACKED_TEST_HPP_ */
@@ -35,6 +35,11 @@ void cofmsgpacketintest::testPacketIn13() {
                0xa1a2a3a4);
 }
 
+void cofmsgpacketintest::testPacketIn14() {
+  testPacketIn(rofl::openflow14::OFP_VERSION, rofl::openflow14::OFPT_PACKET_IN,
+               0xa1a2a3a4);
+}
+
 void cofmsgpacketintest::testPacketIn(uint8_t version, uint8_t type,
                                       uint32_t xid) {
   uint32_t buffer_id = 0x31323334;
@@ -19,6 +19,7 @@ class cofmsgpacketintest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testPacketIn10);
   CPPUNIT_TEST(testPacketIn12);
   CPPUNIT_TEST(testPacketIn13);
+  CPPUNIT_TEST(testPacketIn14);
   CPPUNIT_TEST(testPacketInParser10);
   CPPUNIT_TEST(testPacketInParser12);
   CPPUNIT_TEST(testPacketInParser13);
@@ -32,6 +33,7 @@ public:
   void testPacketIn10();
   void testPacketIn12();
   void testPacketIn13();
+  void testPacketIn14();
   void testPacketInParser10();
   void testPacketInParser12();
   void testPacketInParser13();
@@ -242,3 +242,75 @@ void cofmsgportdescstatstest::testReplyParser13() {
     }
   }
 }
+
+void cofmsgportdescstatstest::testReplyPorts14() {
+  uint8_t version = rofl::openflow14::OFP_VERSION;
+  uint32_t advertised = 0xb1b2b3b4;
+
+  rofl::openflow::cofmsg_port_desc_stats_reply msg1(version, 0xa1a2a3a4,
+                                                    0xb1b2);
+  /* ports with different sets of properties and hence different lengths */
+  for (unsigned int i = 1; i <= 4; i++) {
+    cofport &port = msg1.set_ports().add_port(i);
+    port.set_hwaddr(rofl::caddress_ll("01:02:03:04:05:06"));
+    if (i > 1)
+      port.add_ethernet().set_advertised(advertised + i);
+    if (i > 2)
+      port.add_optical().set_tx_min_freq_lmda(i);
+  }
+
+  rofl::cmemory mem(msg1.length());
+  rofl::openflow::cofmsg_port_desc_stats_reply msg2;
+
+  try {
+    msg1.pack(mem.somem(), mem.length());
+
+    /* walk the packed entries by their length fields */
+    size_t offset = sizeof(struct rofl::openflow14::ofp_multipart_reply);
+    for (unsigned int i = 1; i <= 4; i++) {
+      struct rofl::openflow14::ofp_port *hdr =
+          (struct rofl::openflow14::ofp_port *)(mem.somem() + offset);
+      CPPUNIT_ASSERT(be32toh(hdr->port_no) == i);
+      CPPUNIT_ASSERT(be16toh(hdr->length) ==
+                     msg1.get_ports().get_port(i).length());
+      offset += be16toh(hdr->length);
+    }
+    CPPUNIT_ASSERT(offset == mem.length());
+
+    msg2.unpack(mem.somem(), mem.length());
+
+    CPPUNIT_ASSERT(msg2.get_length() == msg1.length());
+    CPPUNIT_ASSERT(msg2.get_ports().size() == 4);
+    for (unsigned int i = 1; i <= 4; i++) {
+      const cofport &port = msg2.get_ports().get_port(i);
+      CPPUNIT_ASSERT(port.get_port_no() == i);
+      CPPUNIT_ASSERT(port.get_hwaddr() ==
+                     rofl::caddress_ll("01:02:03:04:05:06"));
+      CPPUNIT_ASSERT(port.has_ethernet() == (i > 1));
+      CPPUNIT_ASSERT(port.has_optical() == (i > 2));
+      if (i > 1)
+        CPPUNIT_ASSERT(port.get_ethernet().get_advertised() ==
+                       advertised + i);
+      if (i > 2)
+        CPPUNIT_ASSERT(port.get_optical().get_tx_min_freq_lmda() == i);
+    }
+
+    /* a truncated length field must not be followed past the buffer */
+    struct rofl::openflow14::ofp_port *hdr =
+        (struct rofl::openflow14::ofp_port *)(
+            mem.somem() + sizeof(struct rofl::openflow14::ofp_multipart_reply));
+    hdr->length = htobe16(sizeof(struct rofl::openflow14::ofp_port) - 1);
+    try {
+      rofl::openflow::cofmsg_port_desc_stats_reply msg3;
+      msg3.unpack(mem.somem(), mem.length());
+      CPPUNIT_ASSERT(false);
+    } catch (rofl::exception &e) {
+    }
+
+  } catch (...) {
+    std::cerr << ">>> reply <<<" << std::endl << msg1;
+    std::cerr << ">>> memory <<<" << std::endl << mem;
+    std::cerr << ">>> clone <<<" << std::endl << msg2;
+    throw;
+  }
+}
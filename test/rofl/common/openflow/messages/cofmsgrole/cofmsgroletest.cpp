@@ -30,6 +30,11 @@ void cofmsgroletest::testRequest13() {
               rofl::openflow13::OFPT_ROLE_REQUEST, 0xa1a2a3a4);
 }
 
+void cofmsgroletest::testRequest14() {
+  testRequest(rofl::openflow14::OFP_VERSION,
+              rofl::openflow14::OFPT_ROLE_REQUEST, 0xa1a2a3a4);
+}
+
 void cofmsgroletest::testRequest(uint8_t version, uint8_t type, uint32_t xid) {
   rofl::openflow::cofrole ofrole(version);
   uint32_t role = 0x91929394;
@@ -70,6 +75,11 @@ void cofmsgroletest::testReply13() {
             0xa1a2a3a4);
 }
 
+void cofmsgroletest::testReply14() {
+  testReply(rofl::openflow14::OFP_VERSION, rofl::openflow14::OFPT_ROLE_REPLY,
+            0xa1a2a3a4);
+}
+
 void cofmsgroletest::testReply(uint8_t version, uint8_t type, uint32_t xid) {
   rofl::openflow::cofrole ofrole(version);
   uint32_t role = 0x91929394;
@@ -273,3 +283,50 @@ void cofmsgroletest::testReplyParser(uint8_t version, uint8_t type,
     }
   }
 }
+
+void cofmsgroletest::testRoleStatus14() {
+  uint8_t version = rofl::openflow14::OFP_VERSION;
+  uint32_t xid = 0xa1a2a3a4;
+  uint32_t role = rofl::openflow14::OFPCR_ROLE_SLAVE;
+  uint8_t reason = rofl::openflow14::OFPCRR_MASTER_REQUEST;
+  uint64_t generation_id = 0x8182838485868788;
+  rofl::cmemory props(8);
+  for (unsigned int i = 0; i < props.length(); i++) {
+    props[i] = 0x60 + i;
+  }
+
+  rofl::openflow::cofmsg_role_status msg1(version, xid, role, reason,
+                                          generation_id, props);
+  rofl::openflow::cofmsg_role_status msg2;
+  rofl::cmemory mem(msg1.length());
+
+  try {
+    msg1.pack(mem.somem(), mem.length());
+    msg2.unpack(mem.somem(), mem.length());
+
+    CPPUNIT_ASSERT(msg1.length() ==
+                   sizeof(struct rofl::openflow14::ofp_role_status) + 8);
+    CPPUNIT_ASSERT(msg2.get_version() == version);
+    CPPUNIT_ASSERT(msg2.get_type() == rofl::openflow14::OFPT_ROLE_STATUS);
+    CPPUNIT_ASSERT(msg2.get_length() == msg1.length());
+    CPPUNIT_ASSERT(msg2.get_xid() == xid);
+    CPPUNIT_ASSERT(msg2.get_role() == role);
+    CPPUNIT_ASSERT(msg2.get_reason() == reason);
+    CPPUNIT_ASSERT(msg2.get_generation_id() == generation_id);
+    CPPUNIT_ASSERT(msg2.get_properties() == props);
+
+  } catch (...) {
+    std::cerr << ">>> request <<<" << std::endl << msg1;
+    std::cerr << ">>> memory <<<" << std::endl << mem;
+    std::cerr << ">>> clone <<<" << std::endl << msg2;
+    throw;
+  }
+
+  /* no role-status before OpenFlow 1.4 */
+  try {
+    rofl::openflow::cofmsg_role_status msg(rofl::openflow13::OFP_VERSION);
+    msg.length();
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadVersion &e) {
+  }
+}
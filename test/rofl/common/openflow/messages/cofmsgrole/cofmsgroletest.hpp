@@ -13,17 +13,21 @@
 
 #include "rofl/common/cmemory.h"
 #include "rofl/common/openflow/messages/cofmsg_role.h"
+#include "rofl/common/openflow/messages/cofmsg_role_status.h"
 
 class cofmsgroletest : public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(cofmsgroletest);
   CPPUNIT_TEST(testRequest12);
   CPPUNIT_TEST(testRequest13);
+  CPPUNIT_TEST(testRequest14);
   CPPUNIT_TEST(testReply12);
   CPPUNIT_TEST(testReply13);
+  CPPUNIT_TEST(testReply14);
   CPPUNIT_TEST(testRequestParser12);
   CPPUNIT_TEST(testRequestParser13);
   CPPUNIT_TEST(testReplyParser12);
   CPPUNIT_TEST(testReplyParser13);
+  CPPUNIT_TEST(testRoleStatus14);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -33,12 +37,15 @@ public:
 public:
   void testRequest12();
   void testRequest13();
+  void testRequest14();
   void testReply12();
   void testReply13();
+  void testReply14();
   void testRequestParser12();
   void testRequestParser13();
   void testReplyParser12();
   void testReplyParser13();
+  void testRoleStatus14();
 
 private:
   void testRequest(uint8_t version, uint8_t type, uint32_t xid);
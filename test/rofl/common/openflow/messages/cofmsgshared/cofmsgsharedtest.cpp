@@ -0,0 +1,105 @@
+/*
+ * cofmsgsharedtest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#include <stdlib.h>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "cofmsgsharedtest.hpp"
+
+using namespace rofl::openflow;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(cofmsgsharedtest);
+
+void cofmsgsharedtest::setUp() {}
+
+void cofmsgsharedtest::tearDown() {}
+
+void cofmsgsharedtest::testShared10() {
+  testShared(rofl::openflow10::OFP_VERSION);
+}
+
+void cofmsgsharedtest::testShared13() {
+  testShared(rofl::openflow13::OFP_VERSION);
+}
+
+void cofmsgsharedtest::testShared(uint8_t version) {
+  uint8_t data[64];
+  memset(data, 0xa5, sizeof(data));
+
+  rofl::openflow::cofactions actions(version);
+  actions.add_action_output(rofl::cindex(0)).set_port_no(1);
+
+  rofl::openflow::cofmsg_packet_out msg(version, 0, 0xb1b2b3b4, 2, actions,
+                                        data, sizeof(data));
+
+  std::shared_ptr<rofl::cmemory> image =
+      std::make_shared<rofl::cmemory>(msg.length());
+  msg.pack(image->somem(), image->length());
+
+  rofl::openflow::cofmsg_shared msg1(image, 0xa1a2a3a4);
+  rofl::openflow::cofmsg_shared msg2(image, 0xc1c2c3c4);
+
+  /* both messages refer to the same image */
+  CPPUNIT_ASSERT(image.use_count() == 3);
+  CPPUNIT_ASSERT(msg1.get_image().get() == msg2.get_image().get());
+  CPPUNIT_ASSERT(msg1.get_version() == version);
+  CPPUNIT_ASSERT(msg1.get_type() == rofl::openflow::OFPT_PACKET_OUT);
+  CPPUNIT_ASSERT(msg1.length() == msg.length());
+
+  rofl::cmemory mem1(msg1.length());
+  rofl::cmemory mem2(msg2.length());
+  msg1.pack(mem1.somem(), mem1.length());
+  msg2.pack(mem2.somem(), mem2.length());
+
+  /* packing patches the transaction ID only, the image is unaltered */
+  rofl::openflow::cofmsg_packet_out clone1;
+  clone1.unpack(mem1.somem(), mem1.length());
+  rofl::openflow::cofmsg_packet_out clone2;
+  clone2.unpack(mem2.somem(), mem2.length());
+
+  CPPUNIT_ASSERT(clone1.get_xid() == 0xa1a2a3a4);
+  CPPUNIT_ASSERT(clone2.get_xid() == 0xc1c2c3c4);
+  CPPUNIT_ASSERT(clone1.get_buffer_id() == 0xb1b2b3b4);
+  CPPUNIT_ASSERT(clone1.get_in_port() == 2);
+  CPPUNIT_ASSERT(clone1.get_packet().length() == sizeof(data));
+  CPPUNIT_ASSERT(memcmp(clone1.get_packet().soframe(), data, sizeof(data)) ==
+                 0);
+  CPPUNIT_ASSERT(be32toh(((struct rofl::openflow::ofp_header *)image->somem())
+                             ->xid) == 0);
+
+  msg.set_xid(0xa1a2a3a4);
+  rofl::cmemory expected(msg.length());
+  msg.pack(expected.somem(), expected.length());
+  CPPUNIT_ASSERT(mem1 == expected);
+}
+
+void cofmsgsharedtest::testSharedBadLen() {
+  std::shared_ptr<rofl::cmemory> image = std::make_shared<rofl::cmemory>(
+      sizeof(struct rofl::openflow::ofp_header));
+  struct rofl::openflow::ofp_header *hdr =
+      (struct rofl::openflow::ofp_header *)image->somem();
+  hdr->version = rofl::openflow13::OFP_VERSION;
+  hdr->type = rofl::openflow::OFPT_PACKET_OUT;
+
+  /* header length exceeds image */
+  hdr->length = htobe16(sizeof(struct rofl::openflow::ofp_header) + 8);
+  try {
+    rofl::openflow::cofmsg_shared msg(image);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eInvalid &e) {
+  }
+
+  /* truncated image */
+  try {
+    rofl::openflow::cofmsg_shared msg(
+        std::make_shared<rofl::cmemory>((size_t)4));
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eInvalid &e) {
+  }
+}
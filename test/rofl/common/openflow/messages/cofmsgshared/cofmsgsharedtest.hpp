@@ -0,0 +1,38 @@
+/*
+ * cofmsgsharedtest.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: andreas
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGSHARED_TEST_HPP_
+#define TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGSHARED_TEST_HPP_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/cmemory.h"
+#include "rofl/common/openflow/messages/cofmsg_packet_out.h"
+#include "rofl/common/openflow/messages/cofmsg_shared.h"
+
+class cofmsgsharedtest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(cofmsgsharedtest);
+  CPPUNIT_TEST(testShared10);
+  CPPUNIT_TEST(testShared13);
+  CPPUNIT_TEST(testSharedBadLen);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void testShared10();
+  void testShared13();
+  void testSharedBadLen();
+
+private:
+  void testShared(uint8_t version);
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGSHARED_TEST_HPP_ */
@@ -30,6 +30,11 @@ void cofmsgtablemodtest::testTableMod13() {
                0xa1a2a3a4);
 }
 
+void cofmsgtablemodtest::testTableMod14() {
+  testTableMod(rofl::openflow14::OFP_VERSION, rofl::openflow14::OFPT_TABLE_MOD,
+               0xa1a2a3a4);
+}
+
 void cofmsgtablemodtest::testTableMod(uint8_t version, uint8_t type,
                                       uint32_t xid) {
   uint8_t table_id = 0x71;
@@ -216,3 +221,51 @@ void cofmsgtablemodtest::testTableModParser13() {
     }
   }
 }
+
+void cofmsgtablemodtest::testTableStatus14() {
+  uint8_t version = rofl::openflow14::OFP_VERSION;
+  uint32_t xid = 0xa1a2a3a4;
+  uint8_t reason = rofl::openflow14::OFPTR_VACANCY_DOWN;
+  uint8_t table_id = 0x71;
+  uint32_t config = rofl::openflow14::OFPTC_VACANCY_EVENTS;
+
+  rofl::openflow::cofmsg_table_status msg1(version, xid, reason, table_id,
+                                           config);
+  rofl::openflow::coftablemod_prop_vacancy &vacancy =
+      msg1.set_properties().add_table_mod_vacancy();
+  vacancy.set_vacancy_down(10);
+  vacancy.set_vacancy_up(90);
+  rofl::openflow::cofmsg_table_status msg2;
+  rofl::cmemory mem(msg1.length());
+
+  try {
+    msg1.pack(mem.somem(), mem.length());
+    msg2.unpack(mem.somem(), mem.length());
+
+    /* vacancy property occupies 8 bytes */
+    CPPUNIT_ASSERT(msg1.length() ==
+                   sizeof(struct rofl::openflow14::ofp_table_status) + 8);
+    CPPUNIT_ASSERT(msg2.get_version() == version);
+    CPPUNIT_ASSERT(msg2.get_type() == rofl::openflow14::OFPT_TABLE_STATUS);
+    CPPUNIT_ASSERT(msg2.get_length() == msg1.length());
+    CPPUNIT_ASSERT(msg2.get_xid() == xid);
+    CPPUNIT_ASSERT(msg2.get_reason() == reason);
+    CPPUNIT_ASSERT(msg2.get_table_id() == table_id);
+    CPPUNIT_ASSERT(msg2.get_config() == config);
+    CPPUNIT_ASSERT(msg2.get_properties().has_table_mod_vacancy());
+    CPPUNIT_ASSERT(
+        msg2.get_properties().get_table_mod_vacancy().get_vacancy_down() == 10);
+    CPPUNIT_ASSERT(
+        msg2.get_properties().get_table_mod_vacancy().get_vacancy_up() == 90);
+
+    rofl::cmemory mem2(msg2.length());
+    msg2.pack(mem2.somem(), mem2.length());
+    CPPUNIT_ASSERT(mem == mem2);
+
+  } catch (...) {
+    std::cerr << ">>> request <<<" << std::endl << msg1;
+    std::cerr << ">>> memory <<<" << std::endl << mem;
+    std::cerr << ">>> clone <<<" << std::endl << msg2;
+    throw;
+  }
+}
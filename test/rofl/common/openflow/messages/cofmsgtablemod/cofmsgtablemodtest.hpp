@@ -13,13 +13,16 @@
 
 #include "rofl/common/cmemory.h"
 #include "rofl/common/openflow/messages/cofmsg_table_mod.h"
+#include "rofl/common/openflow/messages/cofmsg_table_status.h"
 
 class cofmsgtablemodtest : public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(cofmsgtablemodtest);
   CPPUNIT_TEST(testTableMod12);
   CPPUNIT_TEST(testTableMod13);
+  CPPUNIT_TEST(testTableMod14);
   CPPUNIT_TEST(testTableModParser12);
   CPPUNIT_TEST(testTableModParser13);
+  CPPUNIT_TEST(testTableStatus14);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -29,8 +32,10 @@ public:
 public:
   void testTableMod12();
   void testTableMod13();
+  void testTableMod14();
   void testTableModParser12();
   void testTableModParser13();
+  void testTableStatus14();
 
 private:
   void testTableMod(uint8_t version, uint8_t type, uint32_t xid);